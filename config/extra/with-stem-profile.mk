@@ -0,0 +1,3 @@
+# Instrument every fd_stem tile callback with tickcount histograms
+# (tile_*_duration_seconds metrics).  See fd_stem.c.
+CPPFLAGS+=-DFD_STEM_PROFILE=1
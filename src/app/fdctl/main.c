@@ -16,6 +16,7 @@ extern fd_topo_obj_callbacks_t fd_obj_cb_dbl_buf;
 extern fd_topo_obj_callbacks_t fd_obj_cb_neigh4_hmap;
 extern fd_topo_obj_callbacks_t fd_obj_cb_fib4;
 extern fd_topo_obj_callbacks_t fd_obj_cb_keyswitch;
+extern fd_topo_obj_callbacks_t fd_obj_cb_log_ring;
 extern fd_topo_obj_callbacks_t fd_obj_cb_tile;
 
 fd_topo_obj_callbacks_t * CALLBACKS[] = {
@@ -29,6 +30,7 @@ fd_topo_obj_callbacks_t * CALLBACKS[] = {
   &fd_obj_cb_neigh4_hmap,
   &fd_obj_cb_fib4,
   &fd_obj_cb_keyswitch,
+  &fd_obj_cb_log_ring,
   &fd_obj_cb_tile,
   NULL,
 };
@@ -55,6 +57,7 @@ extern fd_topo_run_tile_t fd_tile_shred;
 extern fd_topo_run_tile_t fd_tile_sign;
 extern fd_topo_run_tile_t fd_tile_metric;
 extern fd_topo_run_tile_t fd_tile_cswtch;
+extern fd_topo_run_tile_t fd_tile_logd;
 extern fd_topo_run_tile_t fd_tile_gui;
 extern fd_topo_run_tile_t fd_tile_plugin;
 extern fd_topo_run_tile_t fd_tile_resolv;
@@ -75,6 +78,7 @@ fd_topo_run_tile_t * TILES[] = {
   &fd_tile_sign,
   &fd_tile_metric,
   &fd_tile_cswtch,
+  &fd_tile_logd,
   &fd_tile_gui,
   &fd_tile_plugin,
   &fd_tile_resolv,
@@ -10,6 +10,8 @@
 #include "../../util/net/fd_ip4.h"
 #include "../../util/tile/fd_tile_private.h"
 
+#include <sys/random.h>
+
 extern fd_topo_obj_callbacks_t * CALLBACKS[];
 
 void
@@ -17,6 +19,7 @@ fd_topo_initialize( config_t * config ) {
   ulong net_tile_cnt    = config->layout.net_tile_count;
   ulong quic_tile_cnt   = config->layout.quic_tile_count;
   ulong verify_tile_cnt = config->layout.verify_tile_count;
+  ulong dedup_tile_cnt  = config->layout.dedup_tile_count;
   ulong resolv_tile_cnt = config->layout.resolv_tile_count;
   ulong bank_tile_cnt   = config->layout.bank_tile_count;
   ulong shred_tile_cnt  = config->layout.shred_tile_count;
@@ -69,7 +72,7 @@ fd_topo_initialize( config_t * config ) {
   /**/                 fd_topob_link( topo, "gossip_dedup", "gossip_dedup", 2048UL,                                   FD_TPU_MTU,             1UL );
   /* dedup_pack is large currently because pack can encounter stalls when running at very high throughput rates that would
      otherwise cause drops. */
-  /**/                 fd_topob_link( topo, "dedup_resolv", "dedup_resolv", 65536UL,                                  FD_TPU_PARSED_MTU,      1UL );
+  FOR(dedup_tile_cnt)  fd_topob_link( topo, "dedup_resolv", "dedup_resolv", 65536UL,                                  FD_TPU_PARSED_MTU,      1UL );
   FOR(resolv_tile_cnt) fd_topob_link( topo, "resolv_pack",  "resolv_pack",  65536UL,                                  FD_TPU_RESOLVED_MTU,    1UL );
   /**/                 fd_topob_link( topo, "stake_out",    "stake_out",    128UL,                                    40UL + 40200UL * 40UL,  1UL );
   /* pack_bank is shared across all banks, so if one bank stalls due to complex transactions, the buffer neeeds to be large so that
@@ -123,7 +126,7 @@ fd_topo_initialize( config_t * config ) {
   /*                                  topo, tile_name, tile_wksp, metrics_wksp, cpu_idx,                       is_agave, uses_keyswitch */
   FOR(quic_tile_cnt)   fd_topob_tile( topo, "quic",    "quic",    "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
   FOR(verify_tile_cnt) fd_topob_tile( topo, "verify",  "verify",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
-  /**/                 fd_topob_tile( topo, "dedup",   "dedup",   "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
+  FOR(dedup_tile_cnt)  fd_topob_tile( topo, "dedup",   "dedup",   "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
   FOR(resolv_tile_cnt) fd_topob_tile( topo, "resolv",  "resolv",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 1,        0 );
   /**/                 fd_topob_tile( topo, "pack",    "pack",    "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        config->tiles.bundle.enabled );
   FOR(bank_tile_cnt)   fd_topob_tile( topo, "bank",    "bank",    "metric_in",  tile_to_cpu[ topo->tile_cnt ], 1,        0 );
@@ -149,10 +152,22 @@ fd_topo_initialize( config_t * config ) {
                        fd_topob_tile_in(  topo, "verify",  i,            "metric_in", "quic_verify",  j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers, verify tiles may be overrun */
   FOR(verify_tile_cnt) fd_topob_tile_out( topo, "verify",  i,                         "verify_dedup", i                                                  );
   /* Declare the single gossip link before the variable length verify-dedup links so we could have a compile-time index to the gossip link. */
-  /**/                 fd_topob_tile_in(  topo, "dedup",   0UL,          "metric_in", "gossip_dedup", 0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
-  FOR(verify_tile_cnt) fd_topob_tile_in(  topo, "dedup",   0UL,          "metric_in", "verify_dedup", i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
-  /**/                 fd_topob_tile_out( topo, "dedup",   0UL,                       "dedup_resolv", 0UL                                                );
-  FOR(resolv_tile_cnt) fd_topob_tile_in(  topo, "resolv",  i,            "metric_in", "dedup_resolv", 0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  /* Dedup tiles are sharded by signature.  All dedup tiles read from all
+     verify tiles and skip other shards' transactions, see
+     fd_dedup_tile.c. */
+  FOR(dedup_tile_cnt)  fd_topob_tile_in(  topo, "dedup",   i,            "metric_in", "gossip_dedup", 0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  FOR(dedup_tile_cnt)  for( ulong j=0UL; j<verify_tile_cnt; j++ )
+                       fd_topob_tile_in(  topo, "dedup",   i,            "metric_in", "verify_dedup", j,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  FOR(dedup_tile_cnt)  fd_topob_tile_out( topo, "dedup",   i,                         "dedup_resolv", i                                                  );
+
+  /* The dedup shard of a transaction is a keyed hash of its signature,
+     all verify and dedup tiles must agree on the key. */
+  ulong dedup_shard_seed;
+  FD_TEST( sizeof(ulong) == getrandom( &dedup_shard_seed, sizeof(ulong), 0 ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, dedup_shard_seed, "dedup_shard_seed" ) );
+
+  FOR(resolv_tile_cnt) for( ulong j=0UL; j<dedup_tile_cnt; j++ )
+                       fd_topob_tile_in(  topo, "resolv",  i,            "metric_in", "dedup_resolv", j,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   FOR(resolv_tile_cnt) fd_topob_tile_in(  topo, "resolv",  i,            "metric_in", "replay_resol", 0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
   FOR(resolv_tile_cnt) fd_topob_tile_out( topo, "resolv",  i,                         "resolv_pack",  i                                                  );
   /**/                 fd_topob_tile_in(  topo, "pack",    0UL,          "metric_in", "resolv_pack",  0UL,          FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
@@ -289,6 +304,21 @@ fd_topo_initialize( config_t * config ) {
     }
   }
 
+  if( FD_UNLIKELY( config->log.async_depth ) ) {
+    /* Must come after all other tiles, so they all get a log ring */
+    fd_topob_wksp( topo, "logd"         );
+    fd_topob_wksp( topo, "log_ring"     );
+    /**/                 fd_topob_tile( topo, "logd",    "logd",    "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0, 0 );
+    fd_topob_tile_log_rings( topo, "logd", "log_ring", config->log.async_depth );
+  }
+
+  for( ulong i=0UL; i<config->layout.idle_tiles_cnt; i++ ) {
+    fd_topob_tile_idle( topo, config->layout.idle_tiles[ i ], 1000L*(long)config->layout.idle_wake_micros, 0 );
+  }
+  for( ulong i=0UL; i<config->layout.idle_sleep_tiles_cnt; i++ ) {
+    fd_topob_tile_idle( topo, config->layout.idle_sleep_tiles[ i ], 1000L*(long)config->layout.idle_wake_micros, 1 );
+  }
+
   if( FD_LIKELY( !is_auto_affinity ) ) {
     if( FD_UNLIKELY( affinity_tile_cnt<topo->tile_cnt ) )
       FD_LOG_ERR(( "The topology you are using has %lu tiles, but the CPU affinity specified in the config tile as [layout.affinity] only provides for %lu cores. "
@@ -386,9 +416,11 @@ fd_topo_initialize( config_t * config ) {
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "verify" ) ) ) {
       tile->verify.tcache_depth = config->tiles.verify.signature_cache_size;
+      tile->verify.tcache_bkt   = config->tiles.verify.signature_cache_bucketized;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "dedup" ) ) ) {
       tile->dedup.tcache_depth = config->tiles.dedup.signature_cache_size;
+      tile->dedup.tcache_bkt   = config->tiles.dedup.signature_cache_bucketized;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "resolv" ) ) ) {
 
@@ -471,6 +503,10 @@ fd_topo_initialize( config_t * config ) {
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "cswtch" ) ) ) {
 
+    } else if( FD_UNLIKELY( !strcmp( tile->name, "logd" ) ) ) {
+      tile->logd.rate  = config->log.async_rate;
+      tile->logd.burst = config->log.async_burst;
+
     } else if( FD_UNLIKELY( !strcmp( tile->name, "gui" ) ) ) {
       if( FD_UNLIKELY( !fd_cstr_to_ip4_addr( config->tiles.gui.gui_listen_address, &tile->gui.listen_addr ) ) )
         FD_LOG_ERR(( "failed to parse gui listen address `%s`", config->tiles.gui.gui_listen_address ));
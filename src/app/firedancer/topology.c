@@ -201,6 +201,7 @@ fd_topo_initialize( config_t * config ) {
   ulong shred_tile_cnt  = config->layout.shred_tile_count;
   ulong quic_tile_cnt   = config->layout.quic_tile_count;
   ulong verify_tile_cnt = config->layout.verify_tile_count;
+  ulong dedup_tile_cnt  = config->layout.dedup_tile_count;
   ulong bank_tile_cnt   = config->layout.bank_tile_count;
   ulong exec_tile_cnt   = config->layout.exec_tile_count;
   ulong writer_tile_cnt = config->layout.writer_tile_count;
@@ -311,7 +312,7 @@ fd_topo_initialize( config_t * config ) {
   FOR(shred_tile_cnt)  fd_topob_link( topo, "shred_net",    "net_shred",    config->tiles.net.send_buffer_size,       FD_NET_MTU,                    1UL );
   FOR(quic_tile_cnt)   fd_topob_link( topo, "quic_verify",  "quic_verify",  config->tiles.verify.receive_buffer_size, FD_TPU_REASM_MTU,              config->tiles.quic.txn_reassembly_count );
   FOR(verify_tile_cnt) fd_topob_link( topo, "verify_dedup", "verify_dedup", config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             1UL );
-  /**/                 fd_topob_link( topo, "dedup_pack",   "dedup_pack",   config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             1UL );
+  FOR(dedup_tile_cnt)  fd_topob_link( topo, "dedup_pack",   "dedup_pack",   config->tiles.verify.receive_buffer_size, FD_TPU_PARSED_MTU,             1UL );
 
   /**/                 fd_topob_link( topo, "stake_out",    "stake_out",    128UL,                                    40UL + 40200UL * 40UL,         1UL );
   /* See long comment in fd_shred.c for an explanation about the size of this dcache. */
@@ -415,7 +416,7 @@ fd_topo_initialize( config_t * config ) {
   /*                                              topo, tile_name, tile_wksp, metrics_wksp, cpu_idx,                       is_agave, uses_keyswitch */
   FOR(quic_tile_cnt)               fd_topob_tile( topo, "quic",    "quic",    "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
   FOR(verify_tile_cnt)             fd_topob_tile( topo, "verify",  "verify",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
-  /**/                             fd_topob_tile( topo, "dedup",   "dedup",   "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
+  FOR(dedup_tile_cnt)              fd_topob_tile( topo, "dedup",   "dedup",   "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
   FOR(shred_tile_cnt)              fd_topob_tile( topo, "shred",   "shred",   "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        1 );
   /**/                             fd_topob_tile( topo, "storei",  "storei",  "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        0 );
   /**/                             fd_topob_tile( topo, "sign",    "sign",    "metric_in",  tile_to_cpu[ topo->tile_cnt ], 0,        1 );
@@ -543,6 +544,21 @@ fd_topo_initialize( config_t * config ) {
   fd_topob_tile_uses( topo, batch_tile,  constipated_obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
   FD_TEST( fd_pod_insertf_ulong( topo->props, constipated_obj->id, "constipate" ) );
 
+  if( FD_UNLIKELY( config->log.async_depth ) ) {
+    /* Must come after all other tiles, so they all get a log ring */
+    fd_topob_wksp( topo, "logd"     );
+    fd_topob_wksp( topo, "log_ring" );
+    fd_topob_tile( topo, "logd", "logd", "metric_in", tile_to_cpu[ topo->tile_cnt ], 0, 0 );
+    fd_topob_tile_log_rings( topo, "logd", "log_ring", config->log.async_depth );
+  }
+
+  for( ulong i=0UL; i<config->layout.idle_tiles_cnt; i++ ) {
+    fd_topob_tile_idle( topo, config->layout.idle_tiles[ i ], 1000L*(long)config->layout.idle_wake_micros, 0 );
+  }
+  for( ulong i=0UL; i<config->layout.idle_sleep_tiles_cnt; i++ ) {
+    fd_topob_tile_idle( topo, config->layout.idle_sleep_tiles[ i ], 1000L*(long)config->layout.idle_wake_micros, 1 );
+  }
+
   if( FD_LIKELY( !is_auto_affinity ) ) {
     if( FD_UNLIKELY( affinity_tile_cnt<topo->tile_cnt ) )
       FD_LOG_ERR(( "The topology you are using has %lu tiles, but the CPU affinity specified in the config tile as [layout.affinity] only provides for %lu cores. "
@@ -570,9 +586,20 @@ fd_topo_initialize( config_t * config ) {
                       fd_topob_tile_in(  topo, "verify",  i,            "metric_in", "quic_verify",  j,            FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers, verify tiles may be overrun */
   FOR(verify_tile_cnt) fd_topob_tile_out( topo, "verify",  i,                         "verify_dedup", i                                                  );
   FOR(verify_tile_cnt) fd_topob_tile_in(  topo, "verify",  i,            "metric_in", "gossip_verif", 0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
-  /**/                 fd_topob_tile_in(  topo, "dedup",   0UL,          "metric_in", "voter_dedup",  0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED );
-  FOR(verify_tile_cnt) fd_topob_tile_in(  topo, "dedup",   0UL,          "metric_in", "verify_dedup", i,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
-  /**/                 fd_topob_tile_out( topo, "dedup",   0UL,                       "dedup_pack",   0UL                                                );
+  /* Dedup tiles are sharded by signature.  All dedup tiles read from all
+     verify tiles and skip other shards' transactions, see
+     fd_dedup_tile.c. */
+  FOR(dedup_tile_cnt)  fd_topob_tile_in(  topo, "dedup",   i,            "metric_in", "voter_dedup",  0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED );
+  FOR(dedup_tile_cnt)  for( ulong j=0UL; j<verify_tile_cnt; j++ )
+                       fd_topob_tile_in(  topo, "dedup",   i,            "metric_in", "verify_dedup", j,            FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED );
+  FOR(dedup_tile_cnt)  fd_topob_tile_out( topo, "dedup",   i,                         "dedup_pack",   i                                                  );
+
+  /* The dedup shard of a transaction is a keyed hash of its signature,
+     all verify and dedup tiles must agree on the key. */
+  ulong dedup_shard_seed;
+  FD_TEST( sizeof(ulong) == getrandom( &dedup_shard_seed, sizeof(ulong), 0 ) );
+  FD_TEST( fd_pod_insertf_ulong( topo->props, dedup_shard_seed, "dedup_shard_seed" ) );
+
   /**/             fd_topos_tile_in_net(  topo,                          "metric_in", "gossip_net",   0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   /**/             fd_topos_tile_in_net(  topo,                          "metric_in", "repair_net",   0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED ); /* No reliable consumers of networking fragments, may be dropped or overrun */
 
@@ -661,7 +688,7 @@ fd_topo_initialize( config_t * config ) {
   /**/                 fd_topob_tile_out( topo, "sign",    0UL,                        "sign_voter",   0UL                                                  );
   /**/                 fd_topob_tile_in(  topo, "sender",  0UL,          "metric_in",  "sign_voter",   0UL,          FD_TOPOB_UNRELIABLE, FD_TOPOB_UNPOLLED );
 
-  /**/                 fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in",  "dedup_pack",    0UL,         FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
+  FOR(dedup_tile_cnt)  fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in",  "dedup_pack",    i,         FD_TOPOB_RELIABLE,   FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
   /**/                 fd_topob_tile_in(  topo, "pack",   0UL,           "metric_in",  "poh_pack",      0UL,         FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   );
   /**/                 fd_topob_tile_out( topo, "pack",   0UL,                         "pack_replay",   0UL                                                 );
   /**/                 fd_topob_tile_in(  topo, "bhole",  0UL,           "metric_in",  "replay_notif",  0UL,         FD_TOPOB_UNRELIABLE, FD_TOPOB_POLLED   ); /* No reliable consumers of networking fragments, may be dropped or overrun */
@@ -775,9 +802,11 @@ fd_topo_initialize( config_t * config ) {
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "verify" ) ) ) {
       tile->verify.tcache_depth = config->tiles.verify.signature_cache_size;
+      tile->verify.tcache_bkt   = config->tiles.verify.signature_cache_bucketized;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "dedup" ) ) ) {
       tile->dedup.tcache_depth = config->tiles.dedup.signature_cache_size;
+      tile->dedup.tcache_bkt   = config->tiles.dedup.signature_cache_bucketized;
 
     } else if( FD_UNLIKELY( !strcmp( tile->name, "shred" ) ) ) {
       strncpy( tile->shred.identity_key_path, config->consensus.identity_path, sizeof(tile->shred.identity_key_path) );
@@ -920,6 +949,9 @@ fd_topo_initialize( config_t * config ) {
       tile->gui.send_buffer_size_mb       = config->tiles.gui.send_buffer_size_mb;
     } else if( FD_UNLIKELY( !strcmp( tile->name, "plugin" ) ) ) {
 
+    } else if( FD_UNLIKELY( !strcmp( tile->name, "logd" ) ) ) {
+      tile->logd.rate  = config->log.async_rate;
+      tile->logd.burst = config->log.async_burst;
     } else if( FD_UNLIKELY( !strcmp( tile->name, "exec" ) ) ) {
       strncpy( tile->exec.funk_file, config->tiles.replay.funk_file, sizeof(tile->exec.funk_file) );
     } else if( FD_UNLIKELY( !strcmp( tile->name, "writer" ) ) ) {
@@ -589,10 +589,8 @@ runtime_replay( fd_ledger_args_t * ledger_args ) {
 
 #if FD_SPAD_TRACK_USAGE
   for( ulong i=0UL; i<ledger_args->exec_spad_cnt; i++ ) {
-    fd_spad_t * spad = ledger_args->exec_spads[ i ];
-    double pcnt_mem_wmark = (double)fd_spad_mem_wmark( spad ) / (double)fd_spad_mem_max( spad );
-    pcnt_mem_wmark *= 100;
-    FD_LOG_NOTICE(( "spad %2lu mem_wmark %10lu (%6.2f%%) mem_max %10lu", i, fd_spad_mem_wmark( spad ), pcnt_mem_wmark, fd_spad_mem_max( spad ) ));
+    char name[ 32 ];
+    fd_spad_usage_log( ledger_args->exec_spads[ i ], fd_cstr_printf( name, sizeof(name), NULL, "exec spad %2lu", i ) );
   }
 #endif
 
@@ -82,6 +82,11 @@ typedef struct {
   ulong fseq_diag_ovrnp_cnt;
   ulong fseq_diag_ovrnr_cnt;
   ulong fseq_diag_slow_cnt;
+
+  ulong hop_lat_cnt; /* Samples in the link's hop latency histogram */
+  ulong hop_lat_sum; /* Sum of those samples in ticks */
+  ulong lag;
+  ulong lag_max;
 } link_snap_t;
 
 static ulong
@@ -184,6 +189,11 @@ link_snap( link_snap_t *     snap_cur,
         snap->fseq_diag_filt_sz   = in_metrics[ FD_METRICS_COUNTER_LINK_FILTERED_SIZE_BYTES_OFF ];
         snap->fseq_diag_ovrnp_cnt = in_metrics[ FD_METRICS_COUNTER_LINK_OVERRUN_POLLING_COUNT_OFF ];
         snap->fseq_diag_ovrnr_cnt = in_metrics[ FD_METRICS_COUNTER_LINK_OVERRUN_READING_COUNT_OFF ];
+        snap->hop_lat_cnt = 0UL;
+        for( ulong i=0UL; i<FD_HISTF_BUCKET_CNT; i++ ) snap->hop_lat_cnt += in_metrics[ FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_OFF + i ];
+        snap->hop_lat_sum = in_metrics[ FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_OFF + FD_HISTF_BUCKET_CNT ];
+        snap->lag         = in_metrics[ FD_METRICS_GAUGE_LINK_LAG_OFF ];
+        snap->lag_max     = in_metrics[ FD_METRICS_GAUGE_LINK_LAG_MAX_OFF ];
       } else {
         snap->fseq_diag_tot_cnt   = 0UL;
         snap->fseq_diag_tot_sz    = 0UL;
@@ -191,6 +201,10 @@ link_snap( link_snap_t *     snap_cur,
         snap->fseq_diag_filt_sz   = 0UL;
         snap->fseq_diag_ovrnp_cnt = 0UL;
         snap->fseq_diag_ovrnr_cnt = 0UL;
+        snap->hop_lat_cnt         = 0UL;
+        snap->hop_lat_sum         = 0UL;
+        snap->lag                 = 0UL;
+        snap->lag_max             = 0UL;
       }
 
       if( FD_LIKELY( out_metrics ) )
@@ -396,8 +410,8 @@ run_monitor( config_t const * config,
         PRINT( TEXT_NEWLINE );
       }
     } else {
-      PRINT( "             link |  tot TPS |  tot bps | uniq TPS | uniq bps |   ha tr%% | uniq bw%% | filt tr%% | filt bw%% |           ovrnp cnt |           ovrnr cnt |            slow cnt |             tx seq" TEXT_NEWLINE );
-      PRINT( "------------------+----------+----------+----------+----------+----------+----------+----------+----------+---------------------+---------------------+---------------------+-------------------" TEXT_NEWLINE );
+      PRINT( "             link |  tot TPS |  tot bps | uniq TPS | uniq bps |   ha tr%% | uniq bw%% | filt tr%% | filt bw%% |           ovrnp cnt |           ovrnr cnt |            slow cnt |             tx seq |    hop lat |       lag(max)" TEXT_NEWLINE );
+      PRINT( "------------------+----------+----------+----------+----------+----------+----------+----------+----------+---------------------+---------------------+---------------------+--------------------+------------+---------------" TEXT_NEWLINE );
 
       ulong link_idx = 0UL;
       for( ulong tile_idx=0UL; tile_idx<topo->tile_cnt; tile_idx++ ) {
@@ -433,6 +447,16 @@ run_monitor( config_t const * config,
           PRINT( " | " ); printf_err_cnt( &buf, &buf_sz, cur->fseq_diag_ovrnr_cnt, prv->fseq_diag_ovrnr_cnt );
           PRINT( " | " ); printf_err_cnt( &buf, &buf_sz, cur->fseq_diag_slow_cnt,  prv->fseq_diag_slow_cnt  );
           PRINT( " | " ); printf_seq(     &buf, &buf_sz, cur->mcache_seq,          prv->mcache_seq  );
+
+          /* Mean latency of this hop over the interval */
+          PRINT( " | " );
+          if( FD_LIKELY( cur->hop_lat_cnt>prv->hop_lat_cnt ) ) {
+            double hop_lat_tic = (double)(cur->hop_lat_sum - prv->hop_lat_sum) / (double)(cur->hop_lat_cnt - prv->hop_lat_cnt);
+            printf_age( &buf, &buf_sz, (long)(0.5+ns_per_tic*hop_lat_tic) );
+          } else {
+            PRINT( TEXT_GREEN "         -" TEXT_NORMAL );
+          }
+          PRINT( " | %6lu(%6lu)", cur->lag, cur->lag_max );
           PRINT( TEXT_NEWLINE );
           link_idx++;
         }
@@ -466,12 +490,17 @@ run_monitor( config_t const * config,
         verify_sent += fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ verify->out_link_id[ 0 ] ].mcache ) );
       }
 
-      fd_topo_tile_t const * dedup = &topo->tiles[ fd_topo_find_tile( topo, "dedup", 0UL ) ];
+      /* Dedup tiles filter out other shards' transactions too, so count
+         the duplicates from the tile metrics rather than the links. */
       ulong dedup_failed = 0UL;
-      for( ulong i=0UL; i<config->layout.verify_tile_count; i++) {
-        dedup_failed += fd_metrics_link_in( dedup->metrics, i )[ FD_METRICS_COUNTER_LINK_FILTERED_COUNT_OFF ];
+      ulong dedup_sent   = 0UL;
+      for( ulong i=0UL; i<config->layout.dedup_tile_count; i++ ) {
+        fd_topo_tile_t const * dedup = &topo->tiles[ fd_topo_find_tile( topo, "dedup", i ) ];
+        volatile ulong const * dedup_metrics = fd_metrics_tile( dedup->metrics );
+        dedup_failed += dedup_metrics[ FD_METRICS_COUNTER_DEDUP_TRANSACTION_DEDUP_FAILURE_OFF ] +
+                        dedup_metrics[ FD_METRICS_COUNTER_DEDUP_TRANSACTION_BUNDLE_PEER_FAILURE_OFF ];
+        dedup_sent += fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ dedup->out_link_id[ 0 ] ].mcache ) );
       }
-      ulong dedup_sent = fd_mcache_seq_query( fd_mcache_seq_laddr( topo->links[ dedup->out_link_id[ 0 ] ].mcache ) );
 
       fd_topo_tile_t const * pack = &topo->tiles[ fd_topo_find_tile( topo, "pack", 0UL ) ];
       volatile ulong * pack_metrics = fd_metrics_tile( pack->metrics );
@@ -544,12 +544,16 @@ initialize_workspaces( config_t * config ) {
   if( FD_LIKELY( uid!=config->uid && -1==seteuid( config->uid ) ) )
     FD_LOG_ERR(( "seteuid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
 
+  long  init_dt = 0L;
+  ulong init_sz = 0UL;
   for( ulong i=0UL; i<config->topo.wksp_cnt; i++ ) {
     fd_topo_wksp_t * wksp = &config->topo.workspaces[ i ];
 
     char path[ PATH_MAX ];
     workspace_path( config, wksp, path );
 
+    long t0 = fd_log_wallclock();
+
     struct stat st;
     int result = stat( path, &st );
 
@@ -591,11 +595,27 @@ initialize_workspaces( config_t * config ) {
                    "the system is using pages from the same mount.",
                    wksp->name, path, wksp->page_cnt, fd_shmem_page_sz_to_cstr( wksp->page_sz ) ));
     }
+    long t1 = fd_log_wallclock();
     fd_topo_join_workspace( &config->topo, wksp, FD_SHMEM_JOIN_MODE_READ_WRITE );
     fd_topo_wksp_new( &config->topo, wksp, CALLBACKS );
     fd_topo_leave_workspace( &config->topo, wksp );
+    long t2 = fd_log_wallclock();
+
+    /* Startup timing report.  Creation is dominated by the kernel
+       zeroing the pages (see fd_shmem_prefault) and is near free when
+       an existing workspace file is reused. */
+
+    ulong sz = wksp->page_cnt*wksp->page_sz;
+    FD_LOG_INFO(( "workspace `%s`: %lu %s pages (%lu MiB) on numa %lu %s in %.3f ms (%.3f GiB/s), objects initialized in %.3f ms",
+                  wksp->name, wksp->page_cnt, fd_shmem_page_sz_to_cstr( wksp->page_sz ), sz>>20, wksp->numa_idx,
+                  update_existing ? "reused" : "created", (double)(t1-t0)*1e-6,
+                  (double)sz / (double)fd_long_max( t1-t0, 1L ) * (1e9/(double)(1UL<<30)), (double)(t2-t1)*1e-6 ));
+    init_dt += t2-t0;
+    init_sz += sz;
   }
 
+  FD_LOG_NOTICE(( "initialized %lu workspaces (%lu MiB) in %.3f ms", config->topo.wksp_cnt, init_sz>>20, (double)init_dt*1e-6 ));
+
   if( FD_UNLIKELY( seteuid( uid ) ) ) FD_LOG_ERR(( "seteuid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
   if( FD_UNLIKELY( setegid( gid ) ) ) FD_LOG_ERR(( "setegid() failed (%i-%s)", errno, fd_io_strerror( errno ) ));
 }
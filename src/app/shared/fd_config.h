@@ -131,6 +131,10 @@ struct fd_config {
     char level_flush[ 8 ];
     int  level_flush1;
 
+    ulong async_depth;
+    ulong async_rate;
+    ulong async_burst;
+
     /* File descriptor used for logging to the log file.  Stashed
        here for easy communication to child processes. */
     int  log_fd;
@@ -227,10 +231,18 @@ struct fd_config {
     uint quic_tile_count;
     uint resolv_tile_count;
     uint verify_tile_count;
+    uint dedup_tile_count;
     uint bank_tile_count;
     uint shred_tile_count;
     uint exec_tile_count; /* TODO: redundant ish with bank tile cnt */
     uint writer_tile_count;
+
+#   define FD_CONFIG_IDLE_TILES_MAX 16
+    ulong idle_tiles_cnt;
+    char  idle_tiles[ FD_CONFIG_IDLE_TILES_MAX ][ 16 ];
+    ulong idle_sleep_tiles_cnt;
+    char  idle_sleep_tiles[ FD_CONFIG_IDLE_TILES_MAX ][ 16 ];
+    uint  idle_wake_micros;
   } layout;
 
   struct {
@@ -342,12 +354,14 @@ struct fd_config {
 
     struct {
       uint signature_cache_size;
+      int  signature_cache_bucketized;
       uint receive_buffer_size;
       uint mtu;
     } verify;
 
     struct {
       uint signature_cache_size;
+      int  signature_cache_bucketized;
     } dedup;
 
     struct {
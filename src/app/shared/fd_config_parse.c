@@ -214,6 +214,9 @@ fdctl_pod_to_cfg( config_t * config,
   CFG_POP      ( cstr,   log.level_logfile                                );
   CFG_POP      ( cstr,   log.level_stderr                                 );
   CFG_POP      ( cstr,   log.level_flush                                  );
+  CFG_POP      ( ulong,  log.async_depth                                  );
+  CFG_POP      ( ulong,  log.async_rate                                   );
+  CFG_POP      ( ulong,  log.async_burst                                  );
 
   CFG_POP      ( cstr,   reporting.solana_metrics_config                  );
 
@@ -276,8 +279,12 @@ fdctl_pod_to_cfg( config_t * config,
   CFG_POP      ( uint,   layout.quic_tile_count                           );
   CFG_POP      ( uint,   layout.resolv_tile_count                         );
   CFG_POP      ( uint,   layout.verify_tile_count                         );
+  CFG_POP      ( uint,   layout.dedup_tile_count                          );
   CFG_POP      ( uint,   layout.bank_tile_count                           );
   CFG_POP      ( uint,   layout.shred_tile_count                          );
+  CFG_POP_ARRAY( cstr,   layout.idle_tiles                                );
+  CFG_POP_ARRAY( cstr,   layout.idle_sleep_tiles                          );
+  CFG_POP      ( uint,   layout.idle_wake_micros                          );
 
   CFG_POP      ( cstr,   hugetlbfs.mount_path                             );
   CFG_POP      ( cstr,   hugetlbfs.max_page_size                          );
@@ -305,10 +312,12 @@ fdctl_pod_to_cfg( config_t * config,
   CFG_POP      ( bool,   tiles.quic.retry                                 );
 
   CFG_POP      ( uint,   tiles.verify.signature_cache_size                );
+  CFG_POP      ( bool,   tiles.verify.signature_cache_bucketized          );
   CFG_POP      ( uint,   tiles.verify.receive_buffer_size                 );
   CFG_POP      ( uint,   tiles.verify.mtu                                 );
 
   CFG_POP      ( uint,   tiles.dedup.signature_cache_size                 );
+  CFG_POP      ( bool,   tiles.dedup.signature_cache_bucketized           );
 
   CFG_POP      ( bool,   tiles.bundle.enabled                             );
   CFG_POP      ( cstr,   tiles.bundle.url                                 );
@@ -479,6 +488,7 @@ fdctl_cfg_validate( config_t * cfg ) {
   CFG_HAS_NON_ZERO ( layout.quic_tile_count );
   CFG_HAS_NON_ZERO ( layout.resolv_tile_count );
   CFG_HAS_NON_ZERO ( layout.verify_tile_count );
+  CFG_HAS_NON_ZERO ( layout.dedup_tile_count );
   CFG_HAS_NON_ZERO ( layout.bank_tile_count );
   CFG_HAS_NON_ZERO ( layout.shred_tile_count );
 
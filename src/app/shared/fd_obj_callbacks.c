@@ -11,6 +11,7 @@
 #include "../../waltz/neigh/fd_neigh4_map.h"
 #include "../../waltz/ip/fd_fib4.h"
 #include "../../disco/keyguard/fd_keyswitch.h"
+#include "../../util/log/fd_log_ring.h"
 
 #define VAL(name) (__extension__({                                                             \
   ulong __x = fd_pod_queryf_ulong( topo->props, ULONG_MAX, "obj.%lu.%s", obj->id, name );      \
@@ -277,6 +278,31 @@ fd_topo_obj_callbacks_t fd_obj_cb_keyswitch = {
   .new       = keyswitch_new,
 };
 
+static ulong
+log_ring_footprint( fd_topo_t const *     topo,
+                    fd_topo_obj_t const * obj ) {
+  return fd_log_ring_footprint( VAL("depth") );
+}
+
+static ulong
+log_ring_align( fd_topo_t const *     topo FD_FN_UNUSED,
+                fd_topo_obj_t const * obj  FD_FN_UNUSED ) {
+  return fd_log_ring_align();
+}
+
+static void
+log_ring_new( fd_topo_t const *     topo,
+              fd_topo_obj_t const * obj ) {
+  FD_TEST( fd_log_ring_new( fd_topo_obj_laddr( topo, obj->id ), VAL("depth") ) );
+}
+
+fd_topo_obj_callbacks_t fd_obj_cb_log_ring = {
+  .name      = "log_ring",
+  .footprint = log_ring_footprint,
+  .align     = log_ring_align,
+  .new       = log_ring_new,
+};
+
 fd_topo_run_tile_t
 fdctl_tile_run( fd_topo_tile_t const * tile );
 
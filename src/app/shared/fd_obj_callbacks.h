@@ -13,5 +13,6 @@ fd_topo_obj_callbacks_t fd_obj_dbl_buf;
 fd_topo_obj_callbacks_t fd_obj_neigh4_hmap;
 fd_topo_obj_callbacks_t fd_obj_fib4;
 fd_topo_obj_callbacks_t fd_obj_keyswitch;
+fd_topo_obj_callbacks_t fd_obj_log_ring;
 
 #endif /* HEADER_fd_src_app_shared_fd_objects_h */
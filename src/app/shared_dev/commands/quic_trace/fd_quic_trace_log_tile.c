@@ -68,7 +68,7 @@ fd_quic_trace_log_tile( fd_frag_meta_t const * in_mcache ) {
   fd_rng_t rng[1];
   FD_TEST( fd_rng_join( fd_rng_new( rng, (uint)fd_tickcount(), 0UL ) ) );
 
-  uchar scratch[ sizeof(fd_stem_tile_in_t)+128 ] __attribute__((aligned(FD_STEM_SCRATCH_ALIGN)));
+  uchar scratch[ sizeof(fd_stem_tile_in_t)+2UL*sizeof(fd_histf_t)+128 ] __attribute__((aligned(FD_STEM_SCRATCH_ALIGN)));
 
   stem_run1( /* in_cnt     */ 1UL,
              /* in_mcache  */ in_mcache_tbl,
@@ -80,6 +80,8 @@ fd_quic_trace_log_tile( fd_frag_meta_t const * in_mcache ) {
              /* cons_fseq  */ NULL,
              /* stem_burst */ 1UL,
              /* stem_lazy  */ 0L,
+             /* idle_wake  */ 0L,
+             /* idle_sleep */ 0,
              /* rng        */ rng,
              /* scratch    */ scratch,
              /* ctx        */ NULL );
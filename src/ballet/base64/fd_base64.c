@@ -5,10 +5,8 @@ static const char base64_alphabet[] =
 
 /* Inverse lookup table of ASCII byte => Base64 code point.
 
-   Simple Base64 decode. Could do better here, but it's good
-   enough for now.  One obvious optimization is to provide
-   multiple LUTs for each limb of the encoded word, then AND
-   them together. */
+   Simple Base64 decode, used for the tail of the input on targets
+   with SIMD kernels (see below). */
 
 static uchar const invlut[ 0x100 ] = {
   /* 0x00 */ 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
@@ -46,9 +44,9 @@ static uchar const invlut[ 0x100 ] = {
 };
 
 long
-fd_base64_decode( uchar *      out,
-                  char const * in,
-                  ulong        in_len ) {
+fd_base64_decode_ref( uchar *      out,
+                      char const * in,
+                      ulong        in_len ) {
 
   uchar * const out_orig = out;
 
@@ -118,14 +116,14 @@ fd_base64_decode( uchar *      out,
 }
 
 ulong
-fd_base64_encode( char *       encoded,
-                  void const * _data,
-                  ulong        data_len ) {
+fd_base64_encode_ref( char *       encoded,
+                      void const * _data,
+                      ulong        data_len ) {
 
   uchar const * data = fd_type_pun_const( _data );
 
-  uint encoded_len = 0;
-  uint accumulator = 0;
+  ulong encoded_len = 0;
+  uint  accumulator = 0;
   int bits_collected = 0;
 
   while( data_len-- ) {
@@ -151,3 +149,189 @@ fd_base64_encode( char *       encoded,
 
   return encoded_len;
 }
+
+#if FD_HAS_AVX
+
+/* SIMD kernels.  These process the bulk of the input in blocks of 3
+   bytes <> 4 characters and leave the rest (including the padding) to
+   the scalar code above.  The algorithms are from:
+
+     Muła, Lemire. "Faster Base64 Encoding and Decoding using AVX2
+     Instructions" (2018), https://arxiv.org/abs/1704.00605
+
+     Muła, Lemire. "Base64 encoding and decoding at almost the speed of
+     a memory copy" (2019), https://arxiv.org/abs/1910.05109 */
+
+#include "../../util/simd/fd_avx.h"
+
+/* fd_base64_enc_avx encodes 24 bytes at in (reads 28) as 32
+   characters at out. */
+
+static inline void
+fd_base64_enc_avx( char *        out,
+                   uchar const * in ) {
+
+  /* Lane i holds bytes [12i,12i+12).  Spread each group of 3 bytes
+     (b0,b1,b2) into a 32-bit word (b1,b0,b2,b1) such that each 6-bit
+     index sits in a 16-bit half at a known offset. */
+
+  __m256i x = _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( (__m128i const *)in ) ),
+                                       _mm_loadu_si128( (__m128i const *)(in+12) ), 1 );
+  x = _mm256_shuffle_epi8( x, wb_bcast_hex( 1,0,2,1, 4,3,5,4, 7,6,8,7, 10,9,11,10 ) );
+
+  /* Shift the 4 indices of each word into the low 6 bits of each byte */
+
+  __m256i t0 = _mm256_mulhi_epu16( _mm256_and_si256( x, _mm256_set1_epi32( 0x0fc0fc00 ) ), _mm256_set1_epi32( 0x04000040 ) );
+  __m256i t1 = _mm256_mullo_epi16( _mm256_and_si256( x, _mm256_set1_epi32( 0x003f03f0 ) ), _mm256_set1_epi32( 0x01000010 ) );
+  __m256i idx = _mm256_or_si256( t0, t1 );
+
+  /* Map index ranges [0,26) [26,52) [52,62) 62 63 to the offset from
+     the index to its character and add */
+
+  __m256i r = _mm256_subs_epu8( idx, wb_bcast( 51 ) );
+  r = _mm256_or_si256( r, _mm256_and_si256( _mm256_cmpgt_epi8( wb_bcast( 26 ), idx ), wb_bcast( 13 ) ) );
+  __m256i off = wb_bcast_hex( (uchar)('a'-26), (uchar)('0'-52), (uchar)('0'-52), (uchar)('0'-52), (uchar)('0'-52),
+                              (uchar)('0'-52), (uchar)('0'-52), (uchar)('0'-52), (uchar)('0'-52), (uchar)('0'-52),
+                              (uchar)('0'-52), (uchar)('+'-62), (uchar)('/'-63), (uchar)'A', 0, 0 );
+  wb_stu( out, wb_add( _mm256_shuffle_epi8( off, r ), idx ) );
+}
+
+/* fd_base64_dec_avx decodes 32 characters at in as 24 bytes at out.
+   Returns 0 on success and -1 if in contains a char outside of the
+   Base64 alphabet (including '='). */
+
+static inline int
+fd_base64_dec_avx( uchar *      out,
+                   char const * in ) {
+  __m256i x  = wb_ldu( in );
+  __m256i hi = wb_shr( x, 4 );
+  __m256i lo = wb_and( x, wb_bcast( 0x0f ) );
+
+  /* Each high nibble is assigned a class bit, and lut_lo[lo] is the
+     set of classes in which (hi,lo) is not a valid char */
+
+  __m256i lut_lo = wb_bcast_hex( 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                 0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a );
+  __m256i lut_hi = wb_bcast_hex( 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                                 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10 );
+  if( FD_UNLIKELY( !_mm256_testz_si256( _mm256_shuffle_epi8( lut_lo, lo ), _mm256_shuffle_epi8( lut_hi, hi ) ) ) ) return -1;
+
+  /* Map chars to indices by adding an offset by high nibble ('/'
+     shares its high nibble with '+' and is moved to its own slot) */
+
+  __m256i roll = wb_bcast_hex( 0, 16, 19, 4, (uchar)-65, (uchar)-65, (uchar)-71, (uchar)-71,
+                               0,  0,  0, 0, 0,          0,          0,          0 );
+  x = wb_add( x, _mm256_shuffle_epi8( roll, wb_add( wb_eq( x, wb_bcast( '/' ) ), hi ) ) );
+
+  /* Pack 4 6-bit indices into 3 bytes (big endian) per 32-bit word */
+
+  x = _mm256_maddubs_epi16( x, _mm256_set1_epi32( 0x01400140 ) );
+  x = _mm256_madd_epi16   ( x, _mm256_set1_epi32( 0x00011000 ) );
+  x = _mm256_shuffle_epi8 ( x, wb_bcast_hex( 2,1,0, 6,5,4, 10,9,8, 14,13,12, 0xff,0xff,0xff,0xff ) );
+  x = _mm256_permutevar8x32_epi32( x, _mm256_setr_epi32( 0,1,2,4,5,6,3,7 ) );
+
+  _mm_storeu_si128( (__m128i *)out, _mm256_castsi256_si128( x ) );
+  _mm_storel_epi64( (__m128i *)(out+16), _mm256_extracti128_si256( x, 1 ) );
+  return 0;
+}
+
+#if FD_HAS_AVX512
+
+/* AVX-512 (VBMI) variants of the above, 48 bytes <> 64 characters */
+
+#include "../../util/simd/fd_avx512.h"
+
+static inline void
+fd_base64_enc_avx512( char *        out,
+                      uchar const * in ) {
+  __m512i x = _mm512_maskz_loadu_epi8( 0xffffffffffffUL, in );
+  x = _mm512_permutexvar_epi8( _mm512_set_epi8( 46,47,45,46, 43,44,42,43, 40,41,39,40, 37,38,36,37,
+                                                34,35,33,34, 31,32,30,31, 28,29,27,28, 25,26,24,25,
+                                                22,23,21,22, 19,20,18,19, 16,17,15,16, 13,14,12,13,
+                                                10,11, 9,10,  7, 8, 6, 7,  4, 5, 3, 4,  1, 2, 0, 1 ), x );
+  /* Bit offsets of the 4 indices in each (b1,b0,b2,b1) word */
+  x = _mm512_multishift_epi64_epi8( _mm512_set1_epi64( 0x3036242a1016040aL ), x );
+  __m512i alphabet = _mm512_loadu_si512( base64_alphabet );
+  _mm512_storeu_si512( out, _mm512_permutexvar_epi8( x, alphabet ) );
+}
+
+static uchar const fd_base64_dec_lut[ 128 ] __attribute__((aligned(64))) = {
+#define X 0x80
+  X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+  X, X, X, X, X, X, X, X, X, X, X, X, X, X, X, X,
+  X, X, X, X, X, X, X, X, X, X, X,62, X, X, X,63,
+ 52,53,54,55,56,57,58,59,60,61, X, X, X, X, X, X,
+  X, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,10,11,12,13,14,
+ 15,16,17,18,19,20,21,22,23,24,25, X, X, X, X, X,
+  X,26,27,28,29,30,31,32,33,34,35,36,37,38,39,40,
+ 41,42,43,44,45,46,47,48,49,50,51, X, X, X, X, X
+#undef X
+};
+
+static inline int
+fd_base64_dec_avx512( uchar *      out,
+                      char const * in ) {
+  __m512i x = _mm512_loadu_si512( in );
+
+  /* Chars >=0x80 alias valid chars in the table, but are caught by
+     their high bit */
+
+  __m512i t = _mm512_permutex2var_epi8( _mm512_load_si512( fd_base64_dec_lut    ), x,
+                                        _mm512_load_si512( fd_base64_dec_lut+64 ) );
+  if( FD_UNLIKELY( _mm512_movepi8_mask( _mm512_or_si512( t, x ) ) ) ) return -1;
+
+  t = _mm512_maddubs_epi16( t, _mm512_set1_epi32( 0x01400140 ) );
+  t = _mm512_madd_epi16   ( t, _mm512_set1_epi32( 0x00011000 ) );
+  t = _mm512_permutexvar_epi8( _mm512_set_epi8(  0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,  0, 0, 0, 0,
+                                                60,61,62,56, 57,58,52,53, 54,48,49,50, 44,45,46,40,
+                                                41,42,36,37, 38,32,33,34, 28,29,30,24, 25,26,20,21,
+                                                22,16,17,18, 12,13,14, 8,  9,10, 4, 5,  6, 0, 1, 2 ), t );
+  _mm512_mask_storeu_epi8( out, 0xffffffffffffUL, t );
+  return 0;
+}
+
+#endif /* FD_HAS_AVX512 */
+
+#endif /* FD_HAS_AVX */
+
+ulong
+fd_base64_encode( char *       out,
+                  void const * _in,
+                  ulong        in_sz ) {
+  uchar const * in = (uchar const *)_in;
+  ulong off = 0UL;
+  ulong enc = 0UL;
+# if FD_HAS_AVX512
+  for( ; in_sz-off>=48UL; off+=48UL, enc+=64UL ) fd_base64_enc_avx512( out+enc, in+off );
+# endif
+# if FD_HAS_AVX
+  for( ; in_sz-off>=28UL; off+=24UL, enc+=32UL ) fd_base64_enc_avx   ( out+enc, in+off );
+# endif
+  return enc + fd_base64_encode_ref( out+enc, in+off, in_sz-off );
+}
+
+long
+fd_base64_decode( uchar *      out,
+                  char const * in,
+                  ulong        in_sz ) {
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( in_sz, 4UL ) ) ) return -1L;
+
+  /* The last 4 chars (which might contain padding) are always left to
+     the scalar code */
+
+  ulong off = 0UL;
+  ulong dec = 0UL;
+# if FD_HAS_AVX512
+  for( ; in_sz-off>64UL; off+=64UL, dec+=48UL ) {
+    if( FD_UNLIKELY( fd_base64_dec_avx512( out+dec, in+off ) ) ) return -1L;
+  }
+# endif
+# if FD_HAS_AVX
+  for( ; in_sz-off>32UL; off+=32UL, dec+=24UL ) {
+    if( FD_UNLIKELY( fd_base64_dec_avx( out+dec, in+off ) ) ) return -1L;
+  }
+# endif
+  long rem = fd_base64_decode_ref( out+dec, in+off, in_sz-off );
+  if( FD_UNLIKELY( rem<0L ) ) return -1L;
+  return (long)dec + rem;
+}
@@ -59,6 +59,21 @@ fd_base64_decode( uchar *      out,
                   char const * in,
                   ulong        in_sz );
 
+/* fd_base64_{encode,decode}_ref are portable scalar implementations of
+   the above with identical semantics.  On targets with AVX,
+   fd_base64_{encode,decode} process the bulk of the input with SIMD
+   kernels and the remainder with these.  Exposed for testing. */
+
+ulong
+fd_base64_encode_ref( char *       out,
+                      void const * in,
+                      ulong        in_sz );
+
+long
+fd_base64_decode_ref( uchar *      out,
+                      char const * in,
+                      ulong        in_sz );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_base64_fd_base64_h */
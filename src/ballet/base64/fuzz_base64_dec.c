@@ -11,7 +11,7 @@
 #include "fd_base64.h"
 
 /* fuzz_base64_dec verifies that Base64 decoding is safe against
-   untrusted inputs. */
+   untrusted inputs, and that it matches the scalar reference. */
 
 int
 LLVMFuzzerInitialize( int  *   argc,
@@ -33,8 +33,12 @@ LLVMFuzzerTestOneInput( uchar const * data,
 
   uchar * dec = malloc( data_sz );
   assert( dec );
+  uchar * dec_ref = malloc( data_sz );
+  assert( dec_ref );
 
   long dec_res = fd_base64_decode( dec, (char const *)data, data_sz );
+  assert( dec_res==fd_base64_decode_ref( dec_ref, (char const *)data, data_sz ) );
+  if( dec_res>0L ) assert( 0==memcmp( dec, dec_ref, (ulong)dec_res ) );
   if ( dec_res>=0L ) {
     FD_FUZZ_MUST_BE_COVERED;
   } else if ( dec_res==-1L ) {
@@ -43,6 +47,7 @@ LLVMFuzzerTestOneInput( uchar const * data,
     abort();
   }
 
+  free( dec_ref );
   free( dec );
   FD_FUZZ_MUST_BE_COVERED;
   return 0;
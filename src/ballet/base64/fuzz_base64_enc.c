@@ -12,7 +12,7 @@
 #include "fd_base64.h"
 
 /* fuzz_base64_enc verifies that decode(encode(x)) is the identity
-   function. */
+   function, and that encoding matches the scalar reference. */
 
 int
 LLVMFuzzerInitialize( int  *   argc,
@@ -36,6 +36,12 @@ LLVMFuzzerTestOneInput( uchar const * data,
   ulong enc_res = fd_base64_encode( enc, data, data_sz );
   assert( enc_res==enc_sz );
 
+  char * enc_ref = malloc( enc_sz );
+  assert( enc_ref );
+  assert( fd_base64_encode_ref( enc_ref, data, data_sz )==enc_sz );
+  assert( 0==memcmp( enc, enc_ref, enc_sz ) );
+  free( enc_ref );
+
   ulong dec_sz = FD_BASE64_DEC_SZ( enc_sz );
   assert( dec_sz <= data_sz+3UL );
 
@@ -105,6 +105,35 @@ main( int     argc,
     if( FD_UNLIKELY( raw_sz>=0L ) ) FD_LOG_ERR(( "decode should have failed but didn't: \"%s\"", *corrupt ));
   }
 
+  /* SIMD kernels vs scalar reference (sizes span several blocks of
+     all kernels) */
+
+  for( ulong iter=0UL; iter<20000UL; iter++ ) {
+    static uchar raw [ 512UL ];
+    static char  enc [ FD_BASE64_ENC_SZ( 512UL ) ];
+    static char  enc2[ FD_BASE64_ENC_SZ( 512UL ) ];
+    static uchar dec [ FD_BASE64_DEC_SZ( FD_BASE64_ENC_SZ( 512UL ) ) ];
+    static uchar dec2[ FD_BASE64_DEC_SZ( FD_BASE64_ENC_SZ( 512UL ) ) ];
+
+    ulong raw_sz = fd_rng_ulong_roll( rng, 513UL );
+    for( ulong i=0UL; i<raw_sz; i++ ) raw[ i ] = fd_rng_uchar( rng );
+
+    ulong enc_sz = fd_base64_encode( enc, raw, raw_sz );
+    FD_TEST( enc_sz==FD_BASE64_ENC_SZ( raw_sz ) );
+    FD_TEST( fd_base64_encode_ref( enc2, raw, raw_sz )==enc_sz );
+    FD_TEST( 0==memcmp( enc, enc2, enc_sz ) );
+
+    FD_TEST( fd_base64_decode( dec, enc, enc_sz )==(long)raw_sz );
+    FD_TEST( 0==memcmp( dec, raw, raw_sz ) );
+
+    /* Corrupt a random char (maybe still valid) */
+    if( enc_sz ) enc[ fd_rng_ulong_roll( rng, enc_sz ) ] = (char)fd_rng_uchar( rng );
+    long dec_sz  = fd_base64_decode    ( dec,  enc, enc_sz );
+    long dec2_sz = fd_base64_decode_ref( dec2, enc, enc_sz );
+    FD_TEST( dec_sz==dec2_sz );
+    if( dec_sz>0L ) FD_TEST( 0==memcmp( dec, dec2, (ulong)dec_sz ) );
+  }
+
   /* Throughput test */
 
   static uchar raw[ 32768UL ];
@@ -128,6 +157,24 @@ main( int     argc,
   FD_LOG_NOTICE(( "decode: ~%6.3f Gbps  / core", gbps ));
   FD_LOG_NOTICE(( "decode: ~%6.3f ns / byte",    ns   ));
 
+  iter = 10000UL;
+  dt   = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) fd_base64_decode_ref( raw, enc, enc_sz );
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "decode (ref): ~%6.3f Gbps  / core", ((double)(8UL * (ulong)raw_sz * iter)) / ((double)dt) ));
+
+  iter = 100000UL;
+  dt   = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) { fd_base64_encode( enc, raw, (ulong)raw_sz ); FD_COMPILER_FORGET( enc[0] ); }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "encode: ~%6.3f Gbps  / core", ((double)(8UL * (ulong)raw_sz * iter)) / ((double)dt) ));
+
+  iter = 10000UL;
+  dt   = -fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) { fd_base64_encode_ref( enc, raw, (ulong)raw_sz ); FD_COMPILER_FORGET( enc[0] ); }
+  dt += fd_log_wallclock();
+  FD_LOG_NOTICE(( "encode (ref): ~%6.3f Gbps  / core", ((double)(8UL * (ulong)raw_sz * iter)) / ((double)dt) ));
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
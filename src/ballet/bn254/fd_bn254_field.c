@@ -192,6 +192,18 @@ fd_bn254_fp_sqr( fd_bn254_fp_t * r,
   return fd_bn254_fp_mul( r, a, a );
 }
 
+#if FD_BN254_FIELD_IMPL==1
+#include "./fd_bn254_field_avx512.c"
+#else
+void
+fd_bn254_fp_mul_batch( fd_bn254_fp_t * const       r[],
+                       fd_bn254_fp_t const * const a[],
+                       fd_bn254_fp_t const * const b[],
+                       ulong                       cnt ) {
+  for( ulong i=0UL; i<cnt; i++ ) fd_bn254_fp_mul( r[i], a[i], b[i] );
+}
+#endif
+
 fd_bn254_fp_t *
 fd_bn254_fp_pow( fd_bn254_fp_t * restrict r,
                  fd_bn254_fp_t const *    a,
@@ -0,0 +1,155 @@
+/* AVX-512 IFMA backend for batches of Fp Montgomery multiplications.
+   Included by fd_bn254_field.c when FD_BN254_FIELD_IMPL==1.
+
+   Each chunk of (up to) 8 products is computed lane-sliced: lane k of
+   the vectors holds product k.  Elements are converted from 4x64-bit
+   to 5x52-bit limbs and multiplied with a 52-bit digit CIOS (5 outer
+   iterations) using vpmadd52{lo,hi}uq.
+
+   The CIOS over 52-bit digits computes a*b/2^260 mod p, while the
+   64-bit code (and therefore every constant in Montgomery form in
+   this file) uses R=2^256.  We make up for the difference by
+   converting b as 16*b (the conversion shifts by 4 more bits).  As
+   a<p and 16*b<2^258, the CIOS result is < a*16*b/2^260 + p < 1.25 p,
+   and a single conditional subtraction makes the result canonical,
+   i.e. bit for bit identical to fd_bn254_fp_mul. */
+
+#include "../../util/simd/fd_avx512.h"
+#include "../../util/simd/fd_avx.h"
+
+#define FD_BN254_FP_AVX512_MASK52 ((1UL<<52)-1UL)
+
+/* p in 52-bit limbs and -p^-1 mod 2^52 */
+
+static const ulong fd_bn254_const_p52[5] = {
+  0x8c16d87cfd47UL, 0x916871ca8d3c2UL, 0x181585d97816aUL, 0xa029b85045b68UL, 0x30644e72e131UL,
+};
+
+static const ulong fd_bn254_const_p_inv52 = 0x20782e4866389UL;
+
+void
+fd_bn254_fp_mul_batch( fd_bn254_fp_t * const       r[],
+                       fd_bn254_fp_t const * const a[],
+                       fd_bn254_fp_t const * const b[],
+                       ulong                       cnt ) {
+  wwv_t zero = wwv_zero();
+  wwv_t M    = wwv_bcast( FD_BN254_FP_AVX512_MASK52 );
+  wwv_t pinv = wwv_bcast( fd_bn254_const_p_inv52 );
+  wwv_t p0   = wwv_bcast( fd_bn254_const_p52[0] );
+  wwv_t p1   = wwv_bcast( fd_bn254_const_p52[1] );
+  wwv_t p2   = wwv_bcast( fd_bn254_const_p52[2] );
+  wwv_t p3   = wwv_bcast( fd_bn254_const_p52[3] );
+  wwv_t p4   = wwv_bcast( fd_bn254_const_p52[4] );
+
+  for( ulong i=0UL; i<cnt; i+=8UL ) {
+    int lane = (1<<fd_ulong_min( cnt-i, 8UL )) - 1;
+
+    /* Load the 64-bit limbs of the inputs, transposed such that xj
+       (yj) holds limb j of a (b) of each lane.  A partial chunk uses
+       masked gathers (inactive lanes are zero). */
+
+    wwv_t x0; wwv_t x1; wwv_t x2; wwv_t x3;
+    wwv_t y0; wwv_t y1; wwv_t y2; wwv_t y3;
+    if( FD_LIKELY( lane==0xff ) ) {
+      wwv_t t4; wwv_t t5; wwv_t t6; wwv_t t7;
+#     define LD(x,k) _mm512_castsi256_si512( wv_ldu( (x)[i+(k)]->limbs ) )
+      wwv_transpose_8x8( LD(a,0), LD(a,1), LD(a,2), LD(a,3), LD(a,4), LD(a,5), LD(a,6), LD(a,7), x0,x1,x2,x3,t4,t5,t6,t7 );
+      wwv_transpose_8x8( LD(b,0), LD(b,1), LD(b,2), LD(b,3), LD(b,4), LD(b,5), LD(b,6), LD(b,7), y0,y1,y2,y3,t4,t5,t6,t7 );
+#     undef LD
+      (void)t4; (void)t5; (void)t6; (void)t7; /* always zero */
+    } else {
+      wwv_t pa = _mm512_maskz_loadu_epi64( (__mmask8)lane, a+i );
+      wwv_t pb = _mm512_maskz_loadu_epi64( (__mmask8)lane, b+i );
+#     define GATHER(ptr,j) _mm512_mask_i64gather_epi64( zero, (__mmask8)lane, wwv_add( (ptr), wwv_bcast( 8UL*(j) ) ), NULL, 1 )
+      x0 = GATHER( pa, 0 ); x1 = GATHER( pa, 1 ); x2 = GATHER( pa, 2 ); x3 = GATHER( pa, 3 );
+      y0 = GATHER( pb, 0 ); y1 = GATHER( pb, 1 ); y2 = GATHER( pb, 2 ); y3 = GATHER( pb, 3 );
+#     undef GATHER
+    }
+
+    /* Convert to 52-bit limbs (b is converted as 16*b, see above) */
+
+    wwv_t a0 = wwv_and( x0, M );
+    wwv_t a1 = wwv_and( wwv_or( wwv_shr( x0, 52 ), wwv_shl( x1, 12 ) ), M );
+    wwv_t a2 = wwv_and( wwv_or( wwv_shr( x1, 40 ), wwv_shl( x2, 24 ) ), M );
+    wwv_t a3 = wwv_and( wwv_or( wwv_shr( x2, 28 ), wwv_shl( x3, 36 ) ), M );
+    wwv_t a4 = wwv_shr( x3, 16 );
+
+    wwv_t bd[5];
+    bd[0] = wwv_and( wwv_shl( y0, 4 ), M );
+    bd[1] = wwv_and( wwv_or( wwv_shr( y0, 48 ), wwv_shl( y1, 16 ) ), M );
+    bd[2] = wwv_and( wwv_or( wwv_shr( y1, 36 ), wwv_shl( y2, 28 ) ), M );
+    bd[3] = wwv_and( wwv_or( wwv_shr( y2, 24 ), wwv_shl( y3, 40 ) ), M );
+    bd[4] = wwv_shr( y3, 12 );
+
+    /* CIOS.  The accumulators t are not normalized inside the loop.
+       Each outer iteration adds at most 4 terms <2^52 to a limb, such
+       that limbs stay well below 2^64. */
+
+    wwv_t t0 = zero; wwv_t t1 = zero; wwv_t t2 = zero; wwv_t t3 = zero; wwv_t t4 = zero; wwv_t t5 = zero;
+    for( ulong j=0UL; j<5UL; j++ ) {
+      wwv_t bj = bd[j];
+      t0 = wwv_madd52lo( t0, a0, bj ); t1 = wwv_madd52hi( t1, a0, bj );
+      t1 = wwv_madd52lo( t1, a1, bj ); t2 = wwv_madd52hi( t2, a1, bj );
+      t2 = wwv_madd52lo( t2, a2, bj ); t3 = wwv_madd52hi( t3, a2, bj );
+      t3 = wwv_madd52lo( t3, a3, bj ); t4 = wwv_madd52hi( t4, a3, bj );
+      t4 = wwv_madd52lo( t4, a4, bj ); t5 = wwv_madd52hi( t5, a4, bj );
+
+      wwv_t m = wwv_madd52lo( zero, t0, pinv );
+      t0 = wwv_madd52lo( t0, m, p0 ); t1 = wwv_madd52hi( t1, m, p0 );
+      t1 = wwv_madd52lo( t1, m, p1 ); t2 = wwv_madd52hi( t2, m, p1 );
+      t2 = wwv_madd52lo( t2, m, p2 ); t3 = wwv_madd52hi( t3, m, p2 );
+      t3 = wwv_madd52lo( t3, m, p3 ); t4 = wwv_madd52hi( t4, m, p3 );
+      t4 = wwv_madd52lo( t4, m, p4 ); t5 = wwv_madd52hi( t5, m, p4 );
+
+      /* The low 52 bits of t0 are now zero, shift down by a limb */
+      t0 = wwv_add( t1, wwv_shr( t0, 52 ) );
+      t1 = t2; t2 = t3; t3 = t4; t4 = t5; t5 = zero;
+    }
+
+    /* Normalize */
+
+    t1 = wwv_add( t1, wwv_shr( t0, 52 ) ); t0 = wwv_and( t0, M );
+    t2 = wwv_add( t2, wwv_shr( t1, 52 ) ); t1 = wwv_and( t1, M );
+    t3 = wwv_add( t3, wwv_shr( t2, 52 ) ); t2 = wwv_and( t2, M );
+    t4 = wwv_add( t4, wwv_shr( t3, 52 ) ); t3 = wwv_and( t3, M );
+
+    /* t -= p if t>=p (borrows propagate with arithmetic shifts) */
+
+    wwv_t u0 = wwv_sub( t0, p0 );
+    wwv_t u1 = wwv_add( wwv_sub( t1, p1 ), wwl_shr( u0, 52 ) ); u0 = wwv_and( u0, M );
+    wwv_t u2 = wwv_add( wwv_sub( t2, p2 ), wwl_shr( u1, 52 ) ); u1 = wwv_and( u1, M );
+    wwv_t u3 = wwv_add( wwv_sub( t3, p3 ), wwl_shr( u2, 52 ) ); u2 = wwv_and( u2, M );
+    wwv_t u4 = wwv_add( wwv_sub( t4, p4 ), wwl_shr( u3, 52 ) ); u3 = wwv_and( u3, M );
+    int ge = wwl_ge( u4, zero );
+    t0 = wwv_if( ge, u0, t0 ); t1 = wwv_if( ge, u1, t1 ); t2 = wwv_if( ge, u2, t2 );
+    t3 = wwv_if( ge, u3, t3 ); t4 = wwv_if( ge, u4, t4 );
+
+    /* Convert back to 64-bit limbs and store the results.  As above,
+       a partial chunk uses masked scatters. */
+
+    x0 = wwv_or( t0,                wwv_shl( t1, 52 ) );
+    x1 = wwv_or( wwv_shr( t1, 12 ), wwv_shl( t2, 40 ) );
+    x2 = wwv_or( wwv_shr( t2, 24 ), wwv_shl( t3, 28 ) );
+    x3 = wwv_or( wwv_shr( t3, 36 ), wwv_shl( t4, 16 ) );
+
+    if( FD_LIKELY( lane==0xff ) ) {
+      wwv_t h0; wwv_t h1; wwv_t h2; wwv_t h3; wwv_t h4; wwv_t h5; wwv_t h6; wwv_t h7;
+      wwv_transpose_8x8( x0,x1,x2,x3, zero,zero,zero,zero, h0,h1,h2,h3,h4,h5,h6,h7 );
+      wv_stu( r[i    ]->limbs, _mm512_castsi512_si256( h0 ) );
+      wv_stu( r[i+1UL]->limbs, _mm512_castsi512_si256( h1 ) );
+      wv_stu( r[i+2UL]->limbs, _mm512_castsi512_si256( h2 ) );
+      wv_stu( r[i+3UL]->limbs, _mm512_castsi512_si256( h3 ) );
+      wv_stu( r[i+4UL]->limbs, _mm512_castsi512_si256( h4 ) );
+      wv_stu( r[i+5UL]->limbs, _mm512_castsi512_si256( h5 ) );
+      wv_stu( r[i+6UL]->limbs, _mm512_castsi512_si256( h6 ) );
+      wv_stu( r[i+7UL]->limbs, _mm512_castsi512_si256( h7 ) );
+    } else {
+      wwv_t pr = _mm512_maskz_loadu_epi64( (__mmask8)lane, r+i );
+#     define SCATTER(ptr,j,x) _mm512_mask_i64scatter_epi64( NULL, (__mmask8)lane, wwv_add( (ptr), wwv_bcast( 8UL*(j) ) ), (x), 1 )
+      SCATTER( pr, 0, x0 ); SCATTER( pr, 1, x1 ); SCATTER( pr, 2, x2 ); SCATTER( pr, 3, x3 );
+#     undef SCATTER
+    }
+  }
+}
+
+#undef FD_BN254_FP_AVX512_MASK52
@@ -205,49 +205,97 @@ fd_bn254_fp2_conj( fd_bn254_fp2_t * r,
   return r;
 }
 
-/* fd_bn254_fp2_mul computes r = a * b in Fp2.
-   Karatsuba mul + reduction given that i^2 = -1.
+/* FD_BN254_FP2_BATCH_MAX is the max number of products computed by
+   a single fd_bn254_fp2_{mul,sqr}_batch call (the 18 sqr of a
+   cyclotomic sqr, or the 3x6 products of a Fp12 mul). */
+
+#define FD_BN254_FP2_BATCH_MAX (18UL)
+
+/* fd_bn254_fp2_mul_batch computes *r[i] = *a[i] * *b[i] in Fp2, for
+   i in [0,cnt), cnt<=FD_BN254_FP2_BATCH_MAX.
+   Karatsuba mul + reduction given that i^2 = -1.  The 3*cnt products
+   in Fp are independent and computed with a single
+   fd_bn254_fp_mul_batch.  Any output can alias any input (all products
+   are computed before any output is written).
    Note: this can probably be optimized, see for ideas:
    https://eprint.iacr.org/2010/354 */
+static inline void
+fd_bn254_fp2_mul_batch( fd_bn254_fp2_t * const       r[],
+                        fd_bn254_fp2_t const * const a[],
+                        fd_bn254_fp2_t const * const b[],
+                        ulong                        cnt ) {
+  fd_bn254_fp_t         sa[ FD_BN254_FP2_BATCH_MAX ], sb[ FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t         t [ 3UL*FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t *       tr[ 3UL*FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t const * ta[ 3UL*FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t const * tb[ 3UL*FD_BN254_FP2_BATCH_MAX ];
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_bn254_fp_add( &sa[i], &a[i]->el[0], &a[i]->el[1] );
+    fd_bn254_fp_add( &sb[i], &b[i]->el[0], &b[i]->el[1] );
+    tr[3UL*i    ] = &t[3UL*i    ]; ta[3UL*i    ] = &a[i]->el[0]; tb[3UL*i    ] = &b[i]->el[0]; /* a0*b0 */
+    tr[3UL*i+1UL] = &t[3UL*i+1UL]; ta[3UL*i+1UL] = &a[i]->el[1]; tb[3UL*i+1UL] = &b[i]->el[1]; /* a1*b1 */
+    tr[3UL*i+2UL] = &t[3UL*i+2UL]; ta[3UL*i+2UL] = &sa[i];       tb[3UL*i+2UL] = &sb[i];       /* (a0+a1)*(b0+b1) */
+  }
+
+  fd_bn254_fp_mul_batch( tr, ta, tb, 3UL*cnt );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_bn254_fp_t const * a0b0 = &t[3UL*i    ];
+    fd_bn254_fp_t const * a1b1 = &t[3UL*i+1UL];
+    fd_bn254_fp_t const * sasb = &t[3UL*i+2UL];
+    fd_bn254_fp_sub( &r[i]->el[0], a0b0, a1b1 ); /* i^2 = -1 */
+    fd_bn254_fp_sub( &r[i]->el[1], sasb, a0b0 );
+    fd_bn254_fp_sub( &r[i]->el[1], &r[i]->el[1], a1b1 );
+  }
+}
+
+/* fd_bn254_fp2_sqr_batch computes *r[i] = *a[i]^2 in Fp2, for i in
+   [0,cnt), cnt<=FD_BN254_FP2_BATCH_MAX.
+   https://eprint.iacr.org/2010/354, Alg. 3.
+   This is done with 2mul in Fp, instead of 2sqr+1mul.  As above, the
+   products are computed with a single fd_bn254_fp_mul_batch and any
+   output can alias any input. */
+static inline void
+fd_bn254_fp2_sqr_batch( fd_bn254_fp2_t * const       r[],
+                        fd_bn254_fp2_t const * const a[],
+                        ulong                        cnt ) {
+  fd_bn254_fp_t         p [ FD_BN254_FP2_BATCH_MAX ], m[ FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t         t [ 2UL*FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t *       tr[ 2UL*FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t const * ta[ 2UL*FD_BN254_FP2_BATCH_MAX ];
+  fd_bn254_fp_t const * tb[ 2UL*FD_BN254_FP2_BATCH_MAX ];
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_bn254_fp_add( &p[i], &a[i]->el[0], &a[i]->el[1] );
+    fd_bn254_fp_sub( &m[i], &a[i]->el[0], &a[i]->el[1] );
+    tr[2UL*i    ] = &t[2UL*i    ]; ta[2UL*i    ] = &a[i]->el[0]; tb[2UL*i    ] = &a[i]->el[1]; /* a0*a1 */
+    tr[2UL*i+1UL] = &t[2UL*i+1UL]; ta[2UL*i+1UL] = &p[i];        tb[2UL*i+1UL] = &m[i];        /* (a0+a1)*(a0-a1) */
+  }
+
+  fd_bn254_fp_mul_batch( tr, ta, tb, 2UL*cnt );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    /* r1 = 2 a0*a1, r0 = (a0-a1)*(a0+a1) */
+    fd_bn254_fp_add( &r[i]->el[1], &t[2UL*i], &t[2UL*i] );
+    fd_bn254_fp_set( &r[i]->el[0], &t[2UL*i+1UL] );
+  }
+}
+
+/* fd_bn254_fp2_mul computes r = a * b in Fp2. */
 static inline fd_bn254_fp2_t *
 fd_bn254_fp2_mul( fd_bn254_fp2_t * r,
                   fd_bn254_fp2_t const * a,
                   fd_bn254_fp2_t const * b ) {
-  fd_bn254_fp_t const * a0 = &a->el[0];
-  fd_bn254_fp_t const * a1 = &a->el[1];
-  fd_bn254_fp_t const * b0 = &b->el[0];
-  fd_bn254_fp_t const * b1 = &b->el[1];
-  fd_bn254_fp_t * r0 = &r->el[0];
-  fd_bn254_fp_t * r1 = &r->el[1];
-  fd_bn254_fp_t a0b0[1], a1b1[1], sa[1], sb[1];
-
-  fd_bn254_fp_add( sa, a0, a1 );
-  fd_bn254_fp_add( sb, b0, b1 );
-
-  fd_bn254_fp_mul( a0b0, a0, b0 );
-  fd_bn254_fp_mul( a1b1, a1, b1 );
-  fd_bn254_fp_mul( r1, sa, sb );
-
-  fd_bn254_fp_sub( r0, a0b0, a1b1 ); /* i^2 = -1 */
-  fd_bn254_fp_sub( r1, r1, a0b0 );
-  fd_bn254_fp_sub( r1, r1, a1b1 );
+  fd_bn254_fp2_mul_batch( &r, &a, &b, 1UL );
   return r;
 }
 
-/* fd_bn254_fp2_mul computes r = a^2 in Fp2.
-   https://eprint.iacr.org/2010/354, Alg. 3.
-   This is done with 2mul in Fp, instead of 2sqr+1mul. */
+/* fd_bn254_fp2_sqr computes r = a^2 in Fp2. */
 static inline fd_bn254_fp2_t *
 fd_bn254_fp2_sqr( fd_bn254_fp2_t * r,
                   fd_bn254_fp2_t const * a ) {
-  fd_bn254_fp_t p[1], m[1];
-  fd_bn254_fp_add( p, &a->el[0], &a->el[1] );
-  fd_bn254_fp_sub( m, &a->el[0], &a->el[1] );
-  /* r1 = 2 a0*a1 */
-  fd_bn254_fp_mul( &r->el[1], &a->el[0], &a->el[1] );
-  fd_bn254_fp_add( &r->el[1], &r->el[1], &r->el[1] );
-  /* r0 = (a0-a1)*(a0+a1) */
-  fd_bn254_fp_mul( &r->el[0], p, m );
+  fd_bn254_fp2_sqr_batch( &r, &a, 1UL );
   return r;
 }
 
@@ -411,51 +459,76 @@ fd_bn254_fp6_mul_by_gamma( fd_bn254_fp6_t * r,
   return r;
 }
 
+/* fd_bn254_fp6_mul_batch computes *r[i] = *a[i] * *b[i] in Fp6, for
+   i in [0,cnt), cnt<=3.  The 6*cnt products in Fp2 are computed with
+   a single fd_bn254_fp2_mul_batch.  Any output can alias any input. */
+static inline void
+fd_bn254_fp6_mul_batch( fd_bn254_fp6_t * const       r[],
+                        fd_bn254_fp6_t const * const a[],
+                        fd_bn254_fp6_t const * const b[],
+                        ulong                        cnt ) {
+  /* https://eprint.iacr.org/2010/354, Alg. 13 */
+  fd_bn254_fp2_t         s [ 6UL*3UL ];
+  fd_bn254_fp2_t         t [ 6UL*3UL ];
+  fd_bn254_fp2_t *       tr[ 6UL*3UL ];
+  fd_bn254_fp2_t const * ta[ 6UL*3UL ];
+  fd_bn254_fp2_t const * tb[ 6UL*3UL ];
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_bn254_fp2_t const * a0 = &a[i]->el[0];
+    fd_bn254_fp2_t const * a1 = &a[i]->el[1];
+    fd_bn254_fp2_t const * a2 = &a[i]->el[2];
+    fd_bn254_fp2_t const * b0 = &b[i]->el[0];
+    fd_bn254_fp2_t const * b1 = &b[i]->el[1];
+    fd_bn254_fp2_t const * b2 = &b[i]->el[2];
+    fd_bn254_fp2_t *       si = &s[6UL*i];
+    fd_bn254_fp2_add( &si[0], a1, a2 ); fd_bn254_fp2_add( &si[1], b1, b2 );
+    fd_bn254_fp2_add( &si[2], a0, a2 ); fd_bn254_fp2_add( &si[3], b0, b2 );
+    fd_bn254_fp2_add( &si[4], a0, a1 ); fd_bn254_fp2_add( &si[5], b0, b1 );
+    ta[6UL*i    ] = a0;     tb[6UL*i    ] = b0;     /* a0b0 */
+    ta[6UL*i+1UL] = a1;     tb[6UL*i+1UL] = b1;     /* a1b1 */
+    ta[6UL*i+2UL] = a2;     tb[6UL*i+2UL] = b2;     /* a2b2 */
+    ta[6UL*i+3UL] = &si[0]; tb[6UL*i+3UL] = &si[1]; /* (a1+a2)(b1+b2) */
+    ta[6UL*i+4UL] = &si[2]; tb[6UL*i+4UL] = &si[3]; /* (a0+a2)(b0+b2) */
+    ta[6UL*i+5UL] = &si[4]; tb[6UL*i+5UL] = &si[5]; /* (a0+a1)(b0+b1) */
+    for( ulong j=0UL; j<6UL; j++ ) tr[6UL*i+j] = &t[6UL*i+j];
+  }
+
+  fd_bn254_fp2_mul_batch( tr, ta, tb, 6UL*cnt );
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_bn254_fp2_t * a0b0 = &t[6UL*i    ];
+    fd_bn254_fp2_t * a1b1 = &t[6UL*i+1UL];
+    fd_bn254_fp2_t * a2b2 = &t[6UL*i+2UL];
+    fd_bn254_fp2_t * r0   = &t[6UL*i+3UL];
+    fd_bn254_fp2_t * r2   = &t[6UL*i+4UL];
+    fd_bn254_fp2_t * r1   = &t[6UL*i+5UL];
+
+    fd_bn254_fp2_sub( r0, r0, a1b1 );
+    fd_bn254_fp2_sub( r0, r0, a2b2 );
+    fd_bn254_fp2_mul_by_xi( r0, r0 );
+    fd_bn254_fp2_add( r0, r0, a0b0 );
+
+    fd_bn254_fp2_sub( r2, r2, a0b0 );
+    fd_bn254_fp2_sub( r2, r2, a2b2 );
+    fd_bn254_fp2_add( r2, r2, a1b1 );
+
+    fd_bn254_fp2_sub( r1, r1, a0b0 );
+    fd_bn254_fp2_sub( r1, r1, a1b1 );
+    fd_bn254_fp2_mul_by_xi( a2b2, a2b2 );
+    fd_bn254_fp2_add( r1, r1, a2b2 );
+
+    fd_bn254_fp2_set( &r[i]->el[0], r0 );
+    fd_bn254_fp2_set( &r[i]->el[1], r1 );
+    fd_bn254_fp2_set( &r[i]->el[2], r2 );
+  }
+}
+
 static inline fd_bn254_fp6_t *
 fd_bn254_fp6_mul( fd_bn254_fp6_t * r,
                   fd_bn254_fp6_t const * a,
                   fd_bn254_fp6_t const * b ) {
-  /* https://eprint.iacr.org/2010/354, Alg. 13 */
-  fd_bn254_fp2_t const * a0 = &a->el[0];
-  fd_bn254_fp2_t const * a1 = &a->el[1];
-  fd_bn254_fp2_t const * a2 = &a->el[2];
-  fd_bn254_fp2_t const * b0 = &b->el[0];
-  fd_bn254_fp2_t const * b1 = &b->el[1];
-  fd_bn254_fp2_t const * b2 = &b->el[2];
-  fd_bn254_fp2_t a0b0[1], a1b1[1], a2b2[1];
-  fd_bn254_fp2_t sa[1], sb[1];
-  fd_bn254_fp2_t r0[1], r1[1], r2[1];
-
-  fd_bn254_fp2_mul( a0b0, a0, b0 );
-  fd_bn254_fp2_mul( a1b1, a1, b1 );
-  fd_bn254_fp2_mul( a2b2, a2, b2 );
-
-  fd_bn254_fp2_add( sa, a1, a2 );
-  fd_bn254_fp2_add( sb, b1, b2 );
-  fd_bn254_fp2_mul( r0, sa, sb );
-  fd_bn254_fp2_sub( r0, r0, a1b1 );
-  fd_bn254_fp2_sub( r0, r0, a2b2 );
-  fd_bn254_fp2_mul_by_xi( r0, r0 );
-  fd_bn254_fp2_add( r0, r0, a0b0 );
-
-  fd_bn254_fp2_add( sa, a0, a2 );
-  fd_bn254_fp2_add( sb, b0, b2 );
-  fd_bn254_fp2_mul( r2, sa, sb );
-  fd_bn254_fp2_sub( r2, r2, a0b0 );
-  fd_bn254_fp2_sub( r2, r2, a2b2 );
-  fd_bn254_fp2_add( r2, r2, a1b1 );
-
-  fd_bn254_fp2_add( sa, a0, a1 );
-  fd_bn254_fp2_add( sb, b0, b1 );
-  fd_bn254_fp2_mul( r1, sa, sb );
-  fd_bn254_fp2_sub( r1, r1, a0b0 );
-  fd_bn254_fp2_sub( r1, r1, a1b1 );
-  fd_bn254_fp2_mul_by_xi( a2b2, a2b2 );
-  fd_bn254_fp2_add( r1, r1, a2b2 );
-
-  fd_bn254_fp2_set( &r->el[0], r0 );
-  fd_bn254_fp2_set( &r->el[1], r1 );
-  fd_bn254_fp2_set( &r->el[2], r2 );
+  fd_bn254_fp6_mul_batch( &r, &a, &b, 1UL );
   return r;
 }
 
@@ -581,9 +654,12 @@ fd_bn254_fp12_mul( fd_bn254_fp12_t * r,
   fd_bn254_fp6_add( sa, a0, a1 );
   fd_bn254_fp6_add( sb, b0, b1 );
 
-  fd_bn254_fp6_mul( a0b0, a0, b0 );
-  fd_bn254_fp6_mul( a1b1, a1, b1 );
-  fd_bn254_fp6_mul( r1, sa, sb );
+  /* a0*b0, a1*b1, (a0+a1)*(b0+b1) in a single batch (r1 is written
+     after a0 and a1 are consumed) */
+  fd_bn254_fp6_t *       mr[3] = { a0b0, a1b1, r1 };
+  fd_bn254_fp6_t const * ma[3] = { a0,   a1,   sa };
+  fd_bn254_fp6_t const * mb[3] = { b0,   b1,   sb };
+  fd_bn254_fp6_mul_batch( mr, ma, mb, 3UL );
 
   fd_bn254_fp6_sub( r1, r1, a0b0 );
   fd_bn254_fp6_sub( r1, r1, a1b1 );
@@ -601,8 +677,10 @@ fd_bn254_fp12_sqr( fd_bn254_fp12_t * r,
   fd_bn254_fp6_sub( c0, &a->el[0], &a->el[1] );
   fd_bn254_fp6_mul_by_gamma( c3, &a->el[1] );
   fd_bn254_fp6_sub( c3, &a->el[0], c3 );
-  fd_bn254_fp6_mul( c2, &a->el[0], &a->el[1] );
-  fd_bn254_fp6_mul( c0, c0, c3 );
+  fd_bn254_fp6_t *       mr[2] = { c2,        c0 };
+  fd_bn254_fp6_t const * ma[2] = { &a->el[0], c0 };
+  fd_bn254_fp6_t const * mb[2] = { &a->el[1], c3 };
+  fd_bn254_fp6_mul_batch( mr, ma, mb, 2UL ); /* c2 = a0*a1, c0 = c0*c3 */
   fd_bn254_fp6_add( c0, c0, c2 );
   fd_bn254_fp6_add( &r->el[1], c2, c2 );
   fd_bn254_fp6_mul_by_gamma( &r->el[0], c2 );
@@ -618,24 +696,21 @@ fd_bn254_fp12_sqr_fast( fd_bn254_fp12_t * r,
      This works when a^(p^6+1)=1, e.g. during pairing final exp. */
   fd_bn254_fp2_t t[9];
 
-  fd_bn254_fp2_sqr( &t[0], &a->el[1].el[1] );
-  fd_bn254_fp2_sqr( &t[1], &a->el[0].el[0] );
+  /* The 9 sqr in Fp2 are independent, compute them in a single batch */
   fd_bn254_fp2_add( &t[6], &a->el[1].el[1], &a->el[0].el[0] );
-  fd_bn254_fp2_sqr( &t[6], &t[6] );
+  fd_bn254_fp2_add( &t[7], &a->el[0].el[2], &a->el[1].el[0] );
+  fd_bn254_fp2_add( &t[8], &a->el[1].el[2], &a->el[0].el[1] );
+  fd_bn254_fp2_t *       sr[9] = { &t[0], &t[1], &t[2], &t[3], &t[4], &t[5], &t[6], &t[7], &t[8] };
+  fd_bn254_fp2_t const * sa[9] = {
+    &a->el[1].el[1], &a->el[0].el[0], &a->el[0].el[2], &a->el[1].el[0], &a->el[1].el[2], &a->el[0].el[1],
+    &t[6], &t[7], &t[8]
+  };
+  fd_bn254_fp2_sqr_batch( sr, sa, 9UL );
+
   fd_bn254_fp2_sub( &t[6], &t[6], &t[0] );
   fd_bn254_fp2_sub( &t[6], &t[6], &t[1] );
-
-  fd_bn254_fp2_sqr( &t[2], &a->el[0].el[2] );
-  fd_bn254_fp2_sqr( &t[3], &a->el[1].el[0] );
-  fd_bn254_fp2_add( &t[7], &a->el[0].el[2], &a->el[1].el[0] );
-  fd_bn254_fp2_sqr( &t[7], &t[7] );
   fd_bn254_fp2_sub( &t[7], &t[7], &t[2] );
   fd_bn254_fp2_sub( &t[7], &t[7], &t[3] );
-
-  fd_bn254_fp2_sqr( &t[4], &a->el[1].el[2] );
-  fd_bn254_fp2_sqr( &t[5], &a->el[0].el[1] );
-  fd_bn254_fp2_add( &t[8], &a->el[1].el[2], &a->el[0].el[1] );
-  fd_bn254_fp2_sqr( &t[8], &t[8] );
   fd_bn254_fp2_sub( &t[8], &t[8], &t[4] );
   fd_bn254_fp2_sub( &t[8], &t[8], &t[5] );
   fd_bn254_fp2_mul_by_xi( &t[8], &t[8] );
@@ -699,20 +774,15 @@ fd_bn254_fp12_frob( fd_bn254_fp12_t * r,
   fd_bn254_fp2_conj( &t[3], &a->el[1].el[1] );
   fd_bn254_fp2_conj( &t[4], &a->el[1].el[2] );
 
-  /* conj(g1) * gamma_1,2 */
-  fd_bn254_fp2_mul( &r->el[0].el[1], &t[0], &fd_bn254_const_frob_gamma1_mont[1] );
-
-  /* conj(g2) * gamma_1,4 */
-  fd_bn254_fp2_mul( &r->el[0].el[2], &t[1], &fd_bn254_const_frob_gamma1_mont[3] );
-
-  /* conj(h0) * gamma_1,1 */
-  fd_bn254_fp2_mul( &r->el[1].el[0], &t[2], &fd_bn254_const_frob_gamma1_mont[0] );
-
-  /* conj(h1) * gamma_1,3 */
-  fd_bn254_fp2_mul( &r->el[1].el[1], &t[3], &fd_bn254_const_frob_gamma1_mont[2] );
-
-  /* conj(h2) * gamma_1,5 */
-  fd_bn254_fp2_mul( &r->el[1].el[2], &t[4], &fd_bn254_const_frob_gamma1_mont[4] );
+  /* conj(g1) * gamma_1,2, conj(g2) * gamma_1,4,
+     conj(h0) * gamma_1,1, conj(h1) * gamma_1,3, conj(h2) * gamma_1,5 */
+  fd_bn254_fp2_t *       mr[5] = { &r->el[0].el[1], &r->el[0].el[2], &r->el[1].el[0], &r->el[1].el[1], &r->el[1].el[2] };
+  fd_bn254_fp2_t const * ma[5] = { &t[0], &t[1], &t[2], &t[3], &t[4] };
+  fd_bn254_fp2_t const * mb[5] = {
+    &fd_bn254_const_frob_gamma1_mont[1], &fd_bn254_const_frob_gamma1_mont[3], &fd_bn254_const_frob_gamma1_mont[0],
+    &fd_bn254_const_frob_gamma1_mont[2], &fd_bn254_const_frob_gamma1_mont[4]
+  };
+  fd_bn254_fp2_mul_batch( mr, ma, mb, 5UL );
   return r;
 }
 
@@ -724,24 +794,20 @@ fd_bn254_fp12_frob2( fd_bn254_fp12_t * r,
   /* g0 */
   fd_bn254_fp2_set( &r->el[0].el[0], &a->el[0].el[0] );
 
-  /* g1 * gamma_2,2 */
-  fd_bn254_fp_mul( &r->el[0].el[1].el[0], &a->el[0].el[1].el[0], &fd_bn254_const_frob_gamma2_mont[1] );
-  fd_bn254_fp_mul( &r->el[0].el[1].el[1], &a->el[0].el[1].el[1], &fd_bn254_const_frob_gamma2_mont[1] );
-
-  /* g2 * gamma_2,4 */
-  fd_bn254_fp_mul( &r->el[0].el[2].el[0], &a->el[0].el[2].el[0], &fd_bn254_const_frob_gamma2_mont[3] );
-  fd_bn254_fp_mul( &r->el[0].el[2].el[1], &a->el[0].el[2].el[1], &fd_bn254_const_frob_gamma2_mont[3] );
-
-  /* h0 * gamma_2,1 */
-  fd_bn254_fp_mul( &r->el[1].el[0].el[0], &a->el[1].el[0].el[0], &fd_bn254_const_frob_gamma2_mont[0] );
-  fd_bn254_fp_mul( &r->el[1].el[0].el[1], &a->el[1].el[0].el[1], &fd_bn254_const_frob_gamma2_mont[0] );
-
-  /* h1 * gamma_2,3 */
-  fd_bn254_fp_mul( &r->el[1].el[1].el[0], &a->el[1].el[1].el[0], &fd_bn254_const_frob_gamma2_mont[2] );
-  fd_bn254_fp_mul( &r->el[1].el[1].el[1], &a->el[1].el[1].el[1], &fd_bn254_const_frob_gamma2_mont[2] );
-
-  /* h2 * gamma_2,5 */
-  fd_bn254_fp_mul( &r->el[1].el[2].el[0], &a->el[1].el[2].el[0], &fd_bn254_const_frob_gamma2_mont[4] );
-  fd_bn254_fp_mul( &r->el[1].el[2].el[1], &a->el[1].el[2].el[1], &fd_bn254_const_frob_gamma2_mont[4] );
+  /* g1 * gamma_2,2, g2 * gamma_2,4, h0 * gamma_2,1, h1 * gamma_2,3,
+     h2 * gamma_2,5 */
+  static const ulong gamma_idx[5] = { 1UL, 3UL, 0UL, 2UL, 4UL };
+  fd_bn254_fp_t *       mr[10];
+  fd_bn254_fp_t const * ma[10];
+  fd_bn254_fp_t const * mb[10];
+  for( ulong i=0UL; i<5UL; i++ ) {
+    ulong j = i+1UL; /* g1, g2, h0, h1, h2 */
+    for( ulong k=0UL; k<2UL; k++ ) {
+      mr[2UL*i+k] = &r->el[j/3UL].el[j%3UL].el[k];
+      ma[2UL*i+k] = &a->el[j/3UL].el[j%3UL].el[k];
+      mb[2UL*i+k] = &fd_bn254_const_frob_gamma2_mont[ gamma_idx[i] ];
+    }
+  }
+  fd_bn254_fp_mul_batch( mr, ma, mb, 10UL );
   return r;
 }
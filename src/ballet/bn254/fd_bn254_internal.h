@@ -24,6 +24,24 @@ struct FD_ALIGNED fd_bn254_fp12 {
 };
 typedef struct fd_bn254_fp12 fd_bn254_fp12_t;
 
+/* FD_BN254_FIELD_IMPL selects the backend used for batches of
+   independent Fp multiplications (fd_bn254_fp_mul_batch), which is
+   how the extension field arithmetic does the bulk of its work:
+
+     0 - reference, one fiat-style 64-bit limb CIOS mul at a time
+     1 - AVX-512 IFMA, 8 muls at a time in 52-bit limbs
+
+   Both produce canonical results, so they are bit for bit identical.
+   Override at build time with -DFD_BN254_FIELD_IMPL=0. */
+
+#ifndef FD_BN254_FIELD_IMPL
+#if FD_HAS_AVX512
+#define FD_BN254_FIELD_IMPL 1
+#else
+#define FD_BN254_FIELD_IMPL 0
+#endif
+#endif
+
 /* Point on G1, Jacobian coordinates */
 struct FD_ALIGNED fd_bn254_g1 {
   fd_bn254_fp_t X;
@@ -168,6 +186,16 @@ fd_bn254_fp12_set_one( fd_bn254_fp12_t * r ) {
   return r;
 }
 
+/* fd_bn254_fp_mul_batch computes *r[i] = *a[i] * *b[i] in Fp
+   (Montgomery) for i in [0,cnt).  Inputs must be canonical.  r[i] can
+   alias a[i] and/or b[i], but not any input of another product. */
+
+void
+fd_bn254_fp_mul_batch( fd_bn254_fp_t * const       r[],
+                       fd_bn254_fp_t const * const a[],
+                       fd_bn254_fp_t const * const b[],
+                       ulong                       cnt );
+
 fd_bn254_fp12_t *
 fd_bn254_fp12_mul( fd_bn254_fp12_t * r,
                    fd_bn254_fp12_t const * a,
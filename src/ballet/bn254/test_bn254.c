@@ -12,10 +12,95 @@ log_bench( char const * descr,
   FD_LOG_NOTICE(( "%-31s %11.3fK/s/core %10.3f ns/call", descr, (double)khz, (double)tau ));
 }
 
+/* ref_fp_mul is an independent (and slow) reference for Montgomery
+   mul in Fp, textbook CIOS with 64-bit digits, R=2^256. */
+
+static void
+ref_fp_mul( ulong       r[4],
+            ulong const a[4],
+            ulong const b[4] ) {
+  static const ulong p[4] = { 0x3c208c16d87cfd47UL, 0x97816a916871ca8dUL, 0xb85045b68181585dUL, 0x30644e72e131a029UL };
+  ulong t[6] = { 0UL };
+  for( ulong i=0UL; i<4UL; i++ ) {
+    uint128 c = 0;
+    for( ulong j=0UL; j<4UL; j++ ) {
+      c = (uint128)a[j]*b[i] + t[j] + (ulong)(c>>64);
+      t[j] = (ulong)c;
+    }
+    c = (uint128)t[4] + (ulong)(c>>64);
+    t[4] = (ulong)c; t[5] = (ulong)(c>>64);
+
+    ulong m = t[0]*0x87D20782E4866389UL;
+    c = (uint128)m*p[0] + t[0];
+    for( ulong j=1UL; j<4UL; j++ ) {
+      c = (uint128)m*p[j] + t[j] + (ulong)(c>>64);
+      t[j-1UL] = (ulong)c;
+    }
+    c = (uint128)t[4] + (ulong)(c>>64);
+    t[3] = (ulong)c;
+    t[4] = t[5] + (ulong)(c>>64);
+  }
+  ulong u[4]; ulong borrow = 0UL;
+  for( ulong j=0UL; j<4UL; j++ ) {
+    uint128 d = (uint128)t[j] - p[j] - borrow;
+    u[j] = (ulong)d; borrow = (ulong)(d>>64) & 1UL;
+  }
+  int ge = t[4] || !borrow;
+  for( ulong j=0UL; j<4UL; j++ ) r[j] = ge ? u[j] : t[j];
+}
+
+static void
+test_fp_mul_batch( fd_rng_t * rng ) {
+  static const fd_bn254_fp_t p_minus_one = {{ 0x3c208c16d87cfd46UL, 0x97816a916871ca8dUL, 0xb85045b68181585dUL, 0x30644e72e131a029UL }};
+
+# define MAX (20UL)
+  fd_bn254_fp_t         x[ MAX ], y[ MAX ], z[ MAX ];
+  fd_bn254_fp_t *       r[ MAX ];
+  fd_bn254_fp_t const * a[ MAX ];
+  fd_bn254_fp_t const * b[ MAX ];
+  for( ulong iter=0UL; iter<100000UL; iter++ ) {
+    ulong cnt = fd_rng_ulong_roll( rng, MAX+1UL );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      for( ulong k=0UL; k<2UL; k++ ) {
+        fd_bn254_fp_t * e = k ? &y[i] : &x[i];
+        switch( fd_rng_uint_roll( rng, 8U ) ) {
+        case 0U: *e = p_minus_one;        break;
+        case 1U: fd_bn254_fp_set_zero( e ); break;
+        case 2U: fd_bn254_fp_set_one ( e ); break;
+        default:
+          do {
+            for( ulong j=0UL; j<4UL; j++ ) e->limbs[j] = fd_rng_ulong( rng );
+            e->limbs[3] >>= 2;
+          } while( fd_uint256_cmp( e, &p_minus_one )>0 );
+        }
+      }
+      ref_fp_mul( z[i].limbs, x[i].limbs, y[i].limbs );
+
+      /* Outputs either in place (aliasing a or b) or separate */
+      fd_bn254_fp_t * out = (i & 1UL) ? &x[i] : &y[i];
+      r[i] = out; a[i] = &x[i]; b[i] = &y[i];
+    }
+    fd_bn254_fp_mul_batch( r, a, b, cnt );
+    for( ulong i=0UL; i<cnt; i++ ) FD_TEST( fd_uint256_eq( r[i], &z[i] ) );
+  }
+
+  for( ulong i=0UL; i<MAX; i++ ) { x[i] = p_minus_one; r[i] = &z[i]; a[i] = &x[i]; b[i] = &x[i]; }
+  ulong iter = 100000UL;
+  long dt = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) fd_bn254_fp_mul_batch( r, a, b, 18UL );
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_bn254_fp_mul_batch (18)", iter, dt );
+# undef MAX
+}
+
 int main( int     argc,
           char ** argv ) {
   fd_boot( &argc, &argv );
 
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_fp_mul_batch( rng );
+
   {
     /* https://github.com/anza-xyz/agave/blob/v1.18.6/sdk/program/src/alt_bn128/mod.rs#L401 */
     const char * tests[] = {
@@ -403,6 +488,8 @@ int main( int     argc,
     }
   }
 
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
   return 0;
@@ -1,5 +1,5 @@
-$(call add-hdrs,fd_ed25519.h fd_x25519.h fd_f25519.h fd_curve25519.h fd_curve25519_scalar.h)
-$(call add-objs,fd_f25519 fd_curve25519 fd_curve25519_scalar fd_ed25519_user fd_x25519,fd_ballet)
+$(call add-hdrs,fd_ed25519.h fd_ed25519_pubkey_cache.h fd_x25519.h fd_f25519.h fd_curve25519.h fd_curve25519_scalar.h)
+$(call add-objs,fd_f25519 fd_curve25519 fd_curve25519_scalar fd_ed25519_user fd_ed25519_pubkey_cache fd_x25519,fd_ballet)
 $(call add-objs,fd_ristretto255,fd_ballet)
 $(call make-unit-test,test_ed25519,test_ed25519,fd_ballet fd_util)
 $(call make-unit-test,test_ed25519_signature_malleability,test_ed25519_signature_malleability,fd_ballet fd_util)
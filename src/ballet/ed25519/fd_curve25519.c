@@ -206,12 +206,107 @@ fd_ed25519_multi_scalar_mul_with_opts( fd_ed25519_point_t *     r,
   return r;
 }
 
+/* fd_curve25519_msm_digit returns the k-th digit of the signed radix
+   2^w (Booth) recoding of the 256-bit scalar n, i.e.
+     n = sum_k digit_k 2^(w k),   k in [0,ceil(257/w)),
+   with digits in [-2^(w-1),2^(w-1)].  Digit k only depends on bits
+   [w k-1,w k+w) of n, so digits can be computed in any order and
+   without scratch space. */
+
+static inline long
+fd_curve25519_msm_digit( uchar const n[ 32 ],
+                         ulong       k,
+                         ulong       w ) {
+  ulong lo = w*k; /* first bit of the window */
+  ulong v  = 0UL;
+  ulong b0 = lo>>3;
+  ulong b1 = fd_ulong_min( (lo+w-1UL)>>3, 31UL );
+  for( ulong b=b0; b<=b1; b++ ) v |= ((ulong)n[ b ])<<(8UL*(b-b0));
+  ulong win   = (v>>(lo&7UL)) & ((1UL<<w)-1UL);
+  ulong carry = lo ? ((ulong)n[ (lo-1UL)>>3 ]>>((lo-1UL)&7UL)) & 1UL : 0UL;
+  return (long)(win+carry) - (long)((win>>(w-1UL))<<w);
+}
+
+/* fd_ed25519_multi_scalar_mul_pippenger computes the MSM with the
+   bucket method.  For each window (top to bottom), each point is added
+   to the bucket of its digit (subtracted for negative digits), and the
+   buckets are combined as sum_b b*bucket_b with 2 running sums.  The
+   cost is ~ceil(257/w)*(sz+2^w) point adds + 256 dbl, i.e. ~257/w adds
+   per point for large sz, vs ~60 adds+dbl per point for Straus/wNAF
+   (which has to process points in batches to bound its tables).  The
+   window size w is chosen from sz to minimize the number of adds.  The
+   buckets live on the stack, so w is capped at
+   FD_CURVE25519_MSM_WINDOW_MAX (64 buckets, 12 KiB with the AVX-512
+   point layout), which is the best window up to ~1000 points. */
+
+#define FD_CURVE25519_MSM_WINDOW_MAX (7UL)
+
+static fd_ed25519_point_t *
+fd_ed25519_multi_scalar_mul_pippenger( fd_ed25519_point_t *     r,
+                                       uchar const              n[], /* sz * 32 */
+                                       fd_ed25519_point_t const a[], /* sz */
+                                       ulong const              sz ) {
+  ulong w    = 4UL;
+  ulong cost = ULONG_MAX;
+  for( ulong c=4UL; c<=FD_CURVE25519_MSM_WINDOW_MAX; c++ ) {
+    ulong c_cost = ((257UL+c-1UL)/c)*(sz + (1UL<<c));
+    if( c_cost<cost ) { cost = c_cost; w = c; }
+  }
+  ulong win_cnt    = (257UL+w-1UL)/w;
+  ulong bucket_cnt = 1UL<<(w-1UL);
+
+  fd_ed25519_point_t bucket     [ 1UL<<(FD_CURVE25519_MSM_WINDOW_MAX-1UL) ];
+  uchar              bucket_used[ 1UL<<(FD_CURVE25519_MSM_WINDOW_MAX-1UL) ];
+  fd_ed25519_point_t sum[1];
+  fd_ed25519_point_t acc[1];
+
+  fd_ed25519_point_set_zero( r );
+  for( ulong k=win_cnt; k; k-- ) {
+    if( k<win_cnt ) fd_ed25519_point_dbln( r, r, (int)w );
+
+    /* Accumulate the points into the buckets (an unused bucket is set
+       instead of added to, saving an add) */
+    fd_memset( bucket_used, 0, bucket_cnt );
+    for( ulong j=0UL; j<sz; j++ ) {
+      long d = fd_curve25519_msm_digit( &n[ 32*j ], k-1UL, w );
+      if( !d ) continue;
+      ulong b = fd_long_abs( d ) - 1UL;
+      if( FD_UNLIKELY( !bucket_used[ b ] ) ) {
+        if( d>0 ) fd_ed25519_point_set( &bucket[ b ], &a[ j ] );
+        else      fd_ed25519_point_neg( &bucket[ b ], &a[ j ] );
+        bucket_used[ b ] = 1;
+      } else {
+        if( d>0 ) fd_ed25519_point_add( &bucket[ b ], &bucket[ b ], &a[ j ] );
+        else      fd_ed25519_point_sub( &bucket[ b ], &bucket[ b ], &a[ j ] );
+      }
+    }
+
+    /* r += sum_b (b+1) bucket[b], computed top down with a running sum
+       of the buckets (skipping leading unused buckets) */
+    ulong b = bucket_cnt;
+    while( b && !bucket_used[ b-1UL ] ) b--;
+    if( FD_UNLIKELY( !b ) ) continue;
+    fd_ed25519_point_set( sum, &bucket[ b-1UL ] );
+    fd_ed25519_point_set( acc, sum );
+    for( b--; b; b-- ) {
+      if( bucket_used[ b-1UL ] ) fd_ed25519_point_add( sum, sum, &bucket[ b-1UL ] );
+      fd_ed25519_point_add( acc, acc, sum );
+    }
+    fd_ed25519_point_add( r, r, acc );
+  }
+  return r;
+}
+
 fd_ed25519_point_t *
 fd_ed25519_multi_scalar_mul( fd_ed25519_point_t *     r,
                              uchar const              n[], /* sz * 32 */
                              fd_ed25519_point_t const a[], /* sz */
                              ulong const              sz ) {
 
+  if( sz>=FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN ) {
+    return fd_ed25519_multi_scalar_mul_pippenger( r, n, a, sz );
+  }
+
   fd_ed25519_point_t h[1];
   fd_ed25519_point_set_zero( r );
 
@@ -18,6 +18,10 @@
 /* Max batch size for MSM. */
 #define FD_BALLET_CURVE25519_MSM_BATCH_SZ 32
 
+/* Min number of points for which fd_ed25519_multi_scalar_mul switches
+   from batches of Straus/wNAF to the Pippenger bucket method. */
+#define FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN 64
+
 /* curve constants. these are imported from table/fd_curve25519_table_{arch}.c.
    they are (re)defined here to avoid breaking compilation when the table needs
    to be rebuilt. */
@@ -19,6 +19,9 @@
 /* An Ed25519 signature. */
 typedef uchar fd_ed25519_sig_t[ FD_ED25519_SIG_SZ ];
 
+/* A cache of decompressed public keys (see fd_ed25519_pubkey_cache.h). */
+typedef struct fd_ed25519_pubkey_cache_private fd_ed25519_pubkey_cache_t;
+
 FD_PROTOTYPES_BEGIN
 
 /* fd_ed25519_public_from_private computes the public_key corresponding
@@ -72,6 +75,36 @@ fd_ed25519_sign( uchar         sig[ 64 ],
                  uchar const   private_key[ 32 ],
                  fd_sha512_t * sha );
 
+/* FD_ED25519_SIGN_BATCH_GROUP is the number of signatures
+   fd_ed25519_sign_batch works on at a time. */
+
+#define FD_ED25519_SIGN_BATCH_GROUP (16UL)
+
+/* fd_ed25519_sign_batch signs batch_cnt messages with the same key,
+   storing the signature of message msg[i] (msg_sz[i] bytes) at sig[i]
+   (64 bytes).  The signatures are exactly those fd_ed25519_sign would
+   produce.  The messages are processed in groups of
+   FD_ED25519_SIGN_BATCH_GROUP.  Compared to calling fd_ed25519_sign
+   batch_cnt times, the private key is expanded once for the whole
+   batch, the hashes H(prefix||M) and H(R||A||M) of a group are computed
+   together with fd_sha512_batch (SIMD lanes on AVX targets) and the
+   encodings of the points R of a group share a single field inversion.
+
+   sha is a handle of a local join to a sha512 calculator, used to
+   expand the private key and for messages too large to be hashed
+   batched (more than 1232 bytes).  batch_cnt==0 is fine.  Otherwise the
+   same as fd_ed25519_sign (no input argument checking, sanitizes the
+   sha and stack before return). */
+
+void FD_FN_SENSITIVE
+fd_ed25519_sign_batch( ulong               batch_cnt,
+                       uchar * const       sig[],        /* batch_cnt, 64 bytes each */
+                       uchar const * const msg[],        /* batch_cnt */
+                       ulong const         msg_sz[],     /* batch_cnt */
+                       uchar const         public_key [ 32 ],
+                       uchar const         private_key[ 32 ],
+                       fd_sha512_t *       sha );
+
 /* fd_ed25519_verify verifies message according to the ED25519 standard.
 
    msg is assumed to point to the first byte of a sz byte memory region
@@ -100,6 +133,20 @@ fd_ed25519_verify( uchar const   msg[], /* msg_sz */
                    uchar const   public_key[ 32 ],
                    fd_sha512_t * sha );
 
+/* fd_ed25519_verify_cached is fd_ed25519_verify, looking up the
+   decompressed public key in cache (a local join to a
+   fd_ed25519_pubkey_cache_t) first and inserting it there on a miss
+   (if the key is valid).  The result is always the same as
+   fd_ed25519_verify.  cache==NULL is fine (no caching). */
+
+int
+fd_ed25519_verify_cached( uchar const                 msg[], /* msg_sz */
+                          ulong                       msg_sz,
+                          uchar const                 sig[ 64 ],
+                          uchar const                 public_key[ 32 ],
+                          fd_sha512_t *               sha,
+                          fd_ed25519_pubkey_cache_t * cache );
+
 /* fd_ed25519_verify_batch_single_msg verifies a batch of signatures
    over a single message, according to the ED25519 standard.
 
@@ -129,6 +176,46 @@ fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
                                     fd_sha512_t * shas[ 1 ],               /* batch_sz */
                                     uchar const   batch_sz );
 
+/* FD_ED25519_VERIFY_BATCH_GROUP is the number of signatures
+   fd_ed25519_verify_batch works on at a time. */
+
+#define FD_ED25519_VERIFY_BATCH_GROUP (16UL)
+
+/* fd_ed25519_verify_batch verifies batch_cnt independent signatures,
+   the i-th one being signature sig[i] of message msg[i] (msg_sz[i]
+   bytes) by public key public_key[i], according to the ED25519
+   standard.  Unlike fd_ed25519_verify_batch_single_msg, the messages
+   (and keys) can all be different, e.g. the signatures of many
+   transactions.
+
+   Each signature is verified exactly as fd_ed25519_verify would (same
+   acceptance rules, no random linear combination) and err[i] is set to
+   the result fd_ed25519_verify would return for it.  The signatures
+   are processed in groups of FD_ED25519_VERIFY_BATCH_GROUP: first the
+   checks and point decompression of the whole group, then the hashes
+   H(R||A||M) of the survivors together with fd_sha512_batch (SIMD lanes
+   on AVX targets), then their curve equation checks.  The curve
+   equation checks (most of the cost) are still done one signature at a
+   time, so this is not meaningfully faster than calling
+   fd_ed25519_verify for each signature.
+
+   sha is a handle of a local join to a sha512 calculator, used for
+   messages too large to be hashed batched (more than 1232 bytes, the
+   transaction MTU).  cache, if
+   non-NULL, is used for public keys as in fd_ed25519_verify_cached.
+   batch_cnt==0 is fine.  Returns FD_ED25519_SUCCESS if every signature
+   verified and otherwise the error code of the first one that did not. */
+
+int
+fd_ed25519_verify_batch( ulong                       batch_cnt,
+                         uchar const * const         msg[],        /* batch_cnt */
+                         ulong const                 msg_sz[],     /* batch_cnt */
+                         uchar const * const         sig[],        /* batch_cnt, 64 bytes each */
+                         uchar const * const         public_key[], /* batch_cnt, 32 bytes each */
+                         fd_sha512_t *               sha,
+                         fd_ed25519_pubkey_cache_t * cache,
+                         int                         err[] );      /* batch_cnt */
+
 /* fd_ed25519_strerror converts an FD_ED25519_SUCCESS / FD_ED25519_ERR_*
    code into a human readable cstr.  The lifetime of the returned
    pointer is infinite.  The returned pointer is always to a non-NULL
@@ -0,0 +1,108 @@
+#include "fd_ed25519_pubkey_cache.h"
+
+ulong
+fd_ed25519_pubkey_cache_align( void ) {
+  return FD_ED25519_PUBKEY_CACHE_ALIGN;
+}
+
+ulong
+fd_ed25519_pubkey_cache_footprint( ulong set_cnt ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( set_cnt ) ) ) return 0UL;
+  if( FD_UNLIKELY( set_cnt>(1UL<<40) ) ) return 0UL; /* overflow */
+  return FD_ED25519_PUBKEY_CACHE_FOOTPRINT( set_cnt );
+}
+
+void *
+fd_ed25519_pubkey_cache_new( void * shmem,
+                             ulong  set_cnt,
+                             ulong  seed ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_ed25519_pubkey_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_ed25519_pubkey_cache_footprint( set_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad set_cnt (%lu)", set_cnt ));
+    return NULL;
+  }
+
+  /* All zero keys mark the entries empty */
+  fd_memset( shmem, 0, footprint );
+
+  fd_ed25519_pubkey_cache_t * cache = (fd_ed25519_pubkey_cache_t *)shmem;
+
+  cache->set_cnt = set_cnt;
+  cache->seed    = seed;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = FD_ED25519_PUBKEY_CACHE_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_ed25519_pubkey_cache_t *
+fd_ed25519_pubkey_cache_join( void * shcache ) {
+
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shcache, fd_ed25519_pubkey_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  fd_ed25519_pubkey_cache_t * cache = (fd_ed25519_pubkey_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_ED25519_PUBKEY_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return cache;
+}
+
+void *
+fd_ed25519_pubkey_cache_leave( fd_ed25519_pubkey_cache_t * cache ) {
+
+  if( FD_UNLIKELY( !cache ) ) {
+    FD_LOG_WARNING(( "NULL cache" ));
+    return NULL;
+  }
+
+  return (void *)cache;
+}
+
+void *
+fd_ed25519_pubkey_cache_delete( void * shcache ) {
+
+  if( FD_UNLIKELY( !shcache ) ) {
+    FD_LOG_WARNING(( "NULL shcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shcache, fd_ed25519_pubkey_cache_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shcache" ));
+    return NULL;
+  }
+
+  fd_ed25519_pubkey_cache_t * cache = (fd_ed25519_pubkey_cache_t *)shcache;
+  if( FD_UNLIKELY( cache->magic!=FD_ED25519_PUBKEY_CACHE_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( cache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shcache;
+}
@@ -0,0 +1,163 @@
+#ifndef HEADER_fd_src_ballet_ed25519_fd_ed25519_pubkey_cache_h
+#define HEADER_fd_src_ballet_ed25519_fd_ed25519_pubkey_cache_h
+
+/* A fd_ed25519_pubkey_cache_t remembers the decompressed and validated
+   points of recently used ED25519 public keys, so that verifying
+   another signature by the same key skips the point decompression (a
+   field exponentiation) and small order check of the public key.  See
+   fd_ed25519_verify_cached and fd_ed25519_verify_batch in fd_ed25519.h.
+
+   The cache is set associative.  A public key maps to one set of
+   FD_ED25519_PUBKEY_CACHE_WAYS entries, kept in least recently used
+   order, by a hash of all 32 bytes of the key keyed with the cache's
+   seed (so an attacker can't pick keys that all land in the same set
+   without knowing it).  A query or insert only touches that set.  Only
+   public keys that are valid for signature verification (decompress
+   successfully and are not small order) are ever inserted, which also
+   makes the all zero key (small order) usable as the empty entry
+   marker (a query for it always misses).  Each entry stores the
+   negated point -A (what the verifier needs), not A.
+
+   A cache is not thread safe.  It is meant to be owned by a single
+   thread, e.g. a fd_gossip_t. */
+
+#include "fd_ed25519.h"
+#include "fd_curve25519.h"
+
+/* FD_ED25519_PUBKEY_CACHE_WAYS is the number of entries in a set. */
+
+#define FD_ED25519_PUBKEY_CACHE_WAYS (4UL)
+
+#define FD_ED25519_PUBKEY_CACHE_MAGIC (0xf17eda2ce55bca40UL) /* firedancer ed5 pubkey cache ver 0 */
+
+struct fd_ed25519_pubkey_cache_ele {
+  fd_ed25519_point_t neg_a[1]; /* -A, A the decompressed key */
+  ulong              key[4];   /* the compressed key, all zero if the entry is empty */
+};
+
+typedef struct fd_ed25519_pubkey_cache_ele fd_ed25519_pubkey_cache_ele_t;
+
+struct __attribute__((aligned(128UL))) fd_ed25519_pubkey_cache_private {
+  ulong magic;   /* ==FD_ED25519_PUBKEY_CACHE_MAGIC */
+  ulong set_cnt; /* power of 2 */
+  ulong seed;
+  ulong hit_cnt;
+  ulong miss_cnt;
+
+  /* Padding to 128 byte alignment */
+
+  /* set_cnt*FD_ED25519_PUBKEY_CACHE_WAYS fd_ed25519_pubkey_cache_ele_t
+     follow here.  Set s is entries [s*WAYS,(s+1)*WAYS), most recently
+     used first. */
+};
+
+/* fd_ed25519_pubkey_cache_t is forward declared in fd_ed25519.h */
+
+/* FD_ED25519_PUBKEY_CACHE_{ALIGN,FOOTPRINT} specify the alignment and
+   footprint needed for a cache with set_cnt sets.  set_cnt is assumed
+   to be valid (a positive integer power of 2 that won't overflow the
+   footprint).  These are provided to facilitate compile time
+   declarations. */
+
+#define FD_ED25519_PUBKEY_CACHE_ALIGN (128UL)
+#define FD_ED25519_PUBKEY_CACHE_FOOTPRINT( set_cnt )                                                \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                               \
+    FD_ED25519_PUBKEY_CACHE_ALIGN, sizeof(fd_ed25519_pubkey_cache_t) ),                            \
+    alignof(fd_ed25519_pubkey_cache_ele_t),                                                         \
+    (set_cnt)*FD_ED25519_PUBKEY_CACHE_WAYS*sizeof(fd_ed25519_pubkey_cache_ele_t) ),                 \
+    FD_ED25519_PUBKEY_CACHE_ALIGN )
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_ed25519_pubkey_cache_{align,footprint,new,join,leave,delete} have
+   the usual semantics.  footprint returns 0 if set_cnt is not a
+   positive integer power of 2 or is too large.  A new cache is empty
+   and uses seed to pick the set of a key (should be random, e.g. from
+   fd_rng_secure). */
+
+FD_FN_CONST ulong
+fd_ed25519_pubkey_cache_align( void );
+
+FD_FN_CONST ulong
+fd_ed25519_pubkey_cache_footprint( ulong set_cnt );
+
+void *
+fd_ed25519_pubkey_cache_new( void * shmem,
+                             ulong  set_cnt,
+                             ulong  seed );
+
+fd_ed25519_pubkey_cache_t *
+fd_ed25519_pubkey_cache_join( void * shcache );
+
+void *
+fd_ed25519_pubkey_cache_leave( fd_ed25519_pubkey_cache_t * cache );
+
+void *
+fd_ed25519_pubkey_cache_delete( void * shcache );
+
+/* fd_ed25519_pubkey_cache_{hit_cnt,miss_cnt} return the number of
+   queries that found / didn't find their key since creation. */
+
+FD_FN_PURE static inline ulong fd_ed25519_pubkey_cache_hit_cnt ( fd_ed25519_pubkey_cache_t const * cache ) { return cache->hit_cnt;  }
+FD_FN_PURE static inline ulong fd_ed25519_pubkey_cache_miss_cnt( fd_ed25519_pubkey_cache_t const * cache ) { return cache->miss_cnt; }
+
+/* fd_ed25519_pubkey_cache_set returns the first entry of the set of the
+   given public key. */
+
+FD_FN_PURE static inline fd_ed25519_pubkey_cache_ele_t *
+fd_ed25519_pubkey_cache_set( fd_ed25519_pubkey_cache_t * cache,
+                             uchar const                 public_key[ 32 ] ) {
+  fd_ed25519_pubkey_cache_ele_t * ele = (fd_ed25519_pubkey_cache_ele_t *)
+    fd_ulong_align_up( (ulong)cache + sizeof(fd_ed25519_pubkey_cache_t), alignof(fd_ed25519_pubkey_cache_ele_t) );
+  ulong set = fd_hash( cache->seed, public_key, 32UL ) & (cache->set_cnt-1UL);
+  return ele + set*FD_ED25519_PUBKEY_CACHE_WAYS;
+}
+
+/* fd_ed25519_pubkey_cache_query looks up public_key.  If found, stores
+   the negated decompressed point in neg_a, makes it the most recently
+   used entry of its set and returns 1.  Otherwise, returns 0 (neg_a is
+   untouched).  fd_ed25519_pubkey_cache_insert inserts public_key with
+   negated decompressed point neg_a as the most recently used entry of
+   its set, evicting the least recently used one.  public_key is assumed
+   not in the cache and valid (decompresses, not small order). */
+
+static inline int
+fd_ed25519_pubkey_cache_query( fd_ed25519_pubkey_cache_t * cache,
+                               uchar const                 public_key[ 32 ],
+                               fd_ed25519_point_t *        neg_a ) {
+  fd_ed25519_pubkey_cache_ele_t * set = fd_ed25519_pubkey_cache_set( cache, public_key );
+  ulong k0 = fd_ulong_load_8( public_key     ); ulong k1 = fd_ulong_load_8( public_key+ 8 );
+  ulong k2 = fd_ulong_load_8( public_key+16 ); ulong k3 = fd_ulong_load_8( public_key+24 );
+  if( FD_UNLIKELY( !(k0|k1|k2|k3) ) ) { cache->miss_cnt++; return 0; } /* Would match empty entries */
+  for( ulong way=0UL; way<FD_ED25519_PUBKEY_CACHE_WAYS; way++ ) {
+    fd_ed25519_pubkey_cache_ele_t * ele = set + way;
+    if( ((ele->key[0]^k0) | (ele->key[1]^k1) | (ele->key[2]^k2) | (ele->key[3]^k3)) ) continue;
+    fd_ed25519_point_set( neg_a, ele->neg_a );
+    if( FD_UNLIKELY( way ) ) { /* Move to front */
+      fd_ed25519_pubkey_cache_ele_t hit = *ele;
+      for( ; way; way-- ) set[ way ] = set[ way-1UL ];
+      set[ 0 ] = hit;
+    }
+    cache->hit_cnt++;
+    return 1;
+  }
+  cache->miss_cnt++;
+  return 0;
+}
+
+static inline void
+fd_ed25519_pubkey_cache_insert( fd_ed25519_pubkey_cache_t * cache,
+                                uchar const                 public_key[ 32 ],
+                                fd_ed25519_point_t const *  neg_a ) {
+  fd_ed25519_pubkey_cache_ele_t * set = fd_ed25519_pubkey_cache_set( cache, public_key );
+  for( ulong way=FD_ED25519_PUBKEY_CACHE_WAYS-1UL; way; way-- ) set[ way ] = set[ way-1UL ];
+  fd_ed25519_point_set( set[ 0 ].neg_a, neg_a );
+  set[ 0 ].key[ 0 ] = fd_ulong_load_8( public_key     );
+  set[ 0 ].key[ 1 ] = fd_ulong_load_8( public_key+ 8 );
+  set[ 0 ].key[ 2 ] = fd_ulong_load_8( public_key+16 );
+  set[ 0 ].key[ 3 ] = fd_ulong_load_8( public_key+24 );
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_ballet_ed25519_fd_ed25519_pubkey_cache_h */
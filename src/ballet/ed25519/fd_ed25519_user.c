@@ -1,5 +1,5 @@
 #include "fd_ed25519.h"
-#include "fd_curve25519.h"
+#include "fd_ed25519_pubkey_cache.h"
 
 uchar * FD_FN_SENSITIVE
 fd_ed25519_public_from_private( uchar         public_key [ static 32 ],
@@ -132,37 +132,179 @@ fd_ed25519_sign( uchar         sig[ static 64 ],
   return sig;
 }
 
-int
-fd_ed25519_verify( uchar const   msg[], /* msg_sz */
-                   ulong         msg_sz,
-                   uchar const   sig[ static 64 ],
-                   uchar const   public_key[ static 32 ],
-                   fd_sha512_t * sha ) {
+/* FD_ED25519_BATCH_HASH_MSG_MAX is the largest message
+   fd_ed25519_sign_batch and fd_ed25519_verify_batch hash with the
+   batched SHA-512 (a transaction fits).  The hashes are over non
+   contiguous data (e.g. R||A||M), so the data is copied to a scratch
+   buffer first.  Larger messages are hashed in place with the caller's
+   sha. */
+
+#define FD_ED25519_BATCH_HASH_MSG_MAX (1232UL)
+
+/* fd_ed25519_point_tobytes_batch is fd_ed25519_point_tobytes for the
+   cnt points a, storing the i-th encoding at out[i].  The inversions of
+   the Z coordinates are done together (Montgomery's trick), trading
+   cnt-1 inversions for 3(cnt-1) multiplications.  cnt is in
+   [1,FD_ED25519_SIGN_BATCH_GROUP].  Constant time. */
+
+static void FD_FN_SENSITIVE
+fd_ed25519_point_tobytes_batch( uchar * const              out[],
+                                fd_ed25519_point_t const * a,
+                                ulong                      cnt ) {
+  fd_f25519_t x[ FD_ED25519_SIGN_BATCH_GROUP ], y[ FD_ED25519_SIGN_BATCH_GROUP ], z[ FD_ED25519_SIGN_BATCH_GROUP ];
+  fd_f25519_t acc[ FD_ED25519_SIGN_BATCH_GROUP ]; /* acc[i] = z[0]*...*z[i] */
+  fd_f25519_t t[1], inv[1], zi[1];
+
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_ed25519_point_to( &x[ i ], &y[ i ], &z[ i ], t, &a[ i ] );
+    if( i ) fd_f25519_mul( &acc[ i ], &acc[ i-1UL ], &z[ i ] );
+    else    fd_f25519_set( &acc[ 0 ], &z[ 0 ] );
+  }
 
-  //  RFC 8032 - Edwards-Curve Digital Signature Algorithm (EdDSA)
-  //
-  //  5.1.7.  Verify
-  //
-  //  1.  To verify a signature on a message M using public key A, with F
-  //      being 0 for Ed25519ctx, 1 for Ed25519ph, and if Ed25519ctx or
-  //      Ed25519ph is being used, C being the context, first split the
-  //      signature into two 32-octet halves.  Decode the first half as a
-  //      point R, and the second half as an integer S, in the range
-  //      0 <= s < L.  Decode the public key A as point A'.  If any of the
-  //      decodings fail (including S being out of range), the signature is
-  //      invalid.
+  fd_f25519_inv( inv, &acc[ cnt-1UL ] ); /* inv = 1/(z[0]*...*z[cnt-1]) */
+  for( ulong i=cnt; i; ) {
+    i--;
+    if( i ) {
+      fd_f25519_mul( zi,  inv, &acc[ i-1UL ] ); /* 1/z[i] */
+      fd_f25519_mul( inv, inv, &z[ i ]       ); /* 1/(z[0]*...*z[i-1]) */
+    } else {
+      fd_f25519_set( zi, inv );
+    }
+    fd_f25519_mul2( &x[ i ], &x[ i ], zi,
+                    &y[ i ], &y[ i ], zi );
+    fd_f25519_tobytes( out[ i ], &y[ i ] );
+    out[ i ][ 31 ] ^= (uchar)(fd_f25519_sgn( &x[ i ] ) << 7);
+  }
 
-  uchar const * r = sig;
-  uchar const * S = sig + 32;
+  fd_memset_explicit( x,   0, sizeof(x)   );
+  fd_memset_explicit( y,   0, sizeof(y)   );
+  fd_memset_explicit( z,   0, sizeof(z)   );
+  fd_memset_explicit( acc, 0, sizeof(acc) );
+}
 
-  /* Check scalar s */
-  if( FD_UNLIKELY( !fd_curve25519_scalar_validate( S ) )) {
-    return FD_ED25519_ERR_SIG;
+void FD_FN_SENSITIVE
+fd_ed25519_sign_batch( ulong               batch_cnt,
+                       uchar * const       sig[],
+                       uchar const * const msg[],
+                       ulong const         msg_sz[],
+                       uchar const         public_key [ static 32 ],
+                       uchar const         private_key[ static 32 ],
+                       fd_sha512_t *       sha ) {
+#define GROUP_MAX FD_ED25519_SIGN_BATCH_GROUP
+
+  /* Step 1 of fd_ed25519_sign, once for the whole batch */
+
+  uchar s[ FD_SHA512_HASH_SZ ];
+  fd_sha512_fini( fd_sha512_append( fd_sha512_init( sha ), private_key, 32UL ), s );
+  s[ 0] &= (uchar)0xF8;
+  s[31] &= (uchar)0x7F;
+  s[31] |= (uchar)0x40;
+  uchar * h = s + 32;
+
+  fd_ed25519_point_t R[ GROUP_MAX ];
+  uchar              r[ GROUP_MAX ][ FD_SHA512_HASH_SZ ];
+  uchar              k[ GROUP_MAX ][ FD_SHA512_HASH_SZ ];
+
+  /* hash_buf[j] holds prefix||M at offset 32 for step 2, then the
+     prefix is overwritten with A and R is stored in front of it for
+     step 4 (so R||A||M) */
+
+  uchar hash_buf[ GROUP_MAX ][ 64UL+FD_ED25519_BATCH_HASH_MSG_MAX ];
+  uchar _batch[ FD_SHA512_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+
+  for( ulong group0=0UL; group0<batch_cnt; group0+=GROUP_MAX ) {
+    ulong group_cnt = fd_ulong_min( batch_cnt-group0, GROUP_MAX );
+
+    /* Step 2, r = H(prefix||M), for the whole group, together */
+
+    fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+    for( ulong j=0UL; j<group_cnt; j++ ) {
+      ulong idx = group0+j;
+      if( FD_LIKELY( msg_sz[ idx ]<=FD_ED25519_BATCH_HASH_MSG_MAX ) ) {
+        uchar * buf = hash_buf[ j ];
+        memcpy( buf+32, h, 32UL );
+        fd_memcpy( buf+64, msg[ idx ], msg_sz[ idx ] );
+        fd_sha512_batch_add( batch, buf+32, 32UL+msg_sz[ idx ], r[ j ] );
+      } else {
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ), h, 32UL ), msg[ idx ], msg_sz[ idx ] ), r[ j ] );
+      }
+    }
+    fd_sha512_batch_fini( batch );
+
+    /* Step 3, R = [r]B, encoding the whole group together */
+
+    for( ulong j=0UL; j<group_cnt; j++ ) {
+      fd_curve25519_scalar_reduce( r[ j ], r[ j ] );
+      fd_ed25519_scalar_mul_base_const_time( &R[ j ], r[ j ] );
+    }
+    fd_ed25519_point_tobytes_batch( sig+group0, R, group_cnt );
+
+    /* Step 4, k = H(R||A||M), for the whole group, together */
+
+    batch = fd_sha512_batch_init( _batch );
+    for( ulong j=0UL; j<group_cnt; j++ ) {
+      ulong idx = group0+j;
+      if( FD_LIKELY( msg_sz[ idx ]<=FD_ED25519_BATCH_HASH_MSG_MAX ) ) {
+        uchar * buf = hash_buf[ j ];
+        memcpy( buf,    sig[ idx ],  32UL );
+        memcpy( buf+32, public_key, 32UL );
+        fd_sha512_batch_add( batch, buf, 64UL+msg_sz[ idx ], k[ j ] );
+      } else {
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                        sig[ idx ], 32UL ), public_key, 32UL ), msg[ idx ], msg_sz[ idx ] ), k[ j ] );
+      }
+    }
+    fd_sha512_batch_fini( batch );
+
+    /* Steps 5 and 6, S = (r + k * s) mod L */
+
+    for( ulong j=0UL; j<group_cnt; j++ ) {
+      fd_curve25519_scalar_reduce( k[ j ], k[ j ] );
+      fd_curve25519_scalar_muladd( sig[ group0+j ]+32, k[ j ], s, r[ j ] );
+    }
+  }
+
+  /* Sanitize.  hash_buf held the secret prefix of every lane and
+     _batch is the batched SHA-512 state used to hash it. */
+
+  fd_memset_explicit( s,        0, sizeof(s)        );
+  fd_memset_explicit( r,        0, sizeof(r)        );
+  fd_memset_explicit( R,        0, sizeof(R)        );
+  fd_memset_explicit( hash_buf, 0, sizeof(hash_buf) );
+  fd_memset_explicit( _batch,   0, sizeof(_batch)   );
+  fd_sha512_clear( sha );
+
+#undef GROUP_MAX
+}
+
+/* fd_ed25519_verify_decode decompresses public_key into -A' (neg_a)
+   and point r into R and does the checks fd_ed25519_verify does on them
+   (see below).  Returns FD_ED25519_SUCCESS or the FD_ED25519_ERR_* code
+   of fd_ed25519_verify.
+
+   If cache is non-NULL, -A' is taken from the cache when present (the
+   cache only has keys that passed these checks, so only r is left to
+   decode) and inserted into it otherwise.  On a hit, r is decoded on
+   its own with fd_ed25519_point_frombytes.  The only encodings it
+   accepts that fd_ed25519_point_frombytes_2x rejects are x==0 with the
+   sign bit set, i.e. y==+/-1, which are small order and rejected right
+   after, so the results are the same with or without the cache. */
+
+static inline int
+fd_ed25519_verify_decode( fd_ed25519_point_t *        neg_a,
+                          fd_ed25519_point_t *        R,
+                          uchar const                 public_key[ 32 ],
+                          uchar const                 r[ 32 ],
+                          fd_ed25519_pubkey_cache_t * cache ) {
+
+  if( cache && fd_ed25519_pubkey_cache_query( cache, public_key, neg_a ) ) {
+    if( FD_UNLIKELY( !fd_ed25519_point_frombytes( R, r ) ) ) return FD_ED25519_ERR_SIG;
+    if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( R ) ) ) return FD_ED25519_ERR_SIG;
+    return FD_ED25519_SUCCESS;
   }
 
   /* Decompress public_key and point r, concurrently */
-  fd_ed25519_point_t Aprime[1], R[1];
-  int res = fd_ed25519_point_frombytes_2x( Aprime, public_key,   R, r );
+  int res = fd_ed25519_point_frombytes_2x( neg_a, public_key, R, r );
 
   /* Check public key and point r:
      1. both public key and point r decompress successfully (RFC)
@@ -191,13 +333,63 @@ fd_ed25519_verify( uchar const   msg[], /* msg_sz */
   if( FD_UNLIKELY( res ) ) {
     return res == 1 ? FD_ED25519_ERR_PUBKEY : FD_ED25519_ERR_SIG;
   }
-  if( FD_UNLIKELY( fd_ed25519_affine_is_small_order(Aprime) ) ) {
+  if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( neg_a ) ) ) {
     return FD_ED25519_ERR_PUBKEY;
   }
-  if( FD_UNLIKELY( fd_ed25519_affine_is_small_order(R) ) ) {
+
+  /* The verifier needs -A' (see below) */
+  fd_ed25519_point_neg( neg_a, neg_a );
+  if( cache ) fd_ed25519_pubkey_cache_insert( cache, public_key, neg_a );
+
+  if( FD_UNLIKELY( fd_ed25519_affine_is_small_order( R ) ) ) {
+    return FD_ED25519_ERR_SIG;
+  }
+  return FD_ED25519_SUCCESS;
+}
+
+int
+fd_ed25519_verify( uchar const   msg[], /* msg_sz */
+                   ulong         msg_sz,
+                   uchar const   sig[ static 64 ],
+                   uchar const   public_key[ static 32 ],
+                   fd_sha512_t * sha ) {
+  return fd_ed25519_verify_cached( msg, msg_sz, sig, public_key, sha, NULL );
+}
+
+int
+fd_ed25519_verify_cached( uchar const                 msg[], /* msg_sz */
+                          ulong                       msg_sz,
+                          uchar const                 sig[ static 64 ],
+                          uchar const                 public_key[ static 32 ],
+                          fd_sha512_t *               sha,
+                          fd_ed25519_pubkey_cache_t * cache ) {
+
+  //  RFC 8032 - Edwards-Curve Digital Signature Algorithm (EdDSA)
+  //
+  //  5.1.7.  Verify
+  //
+  //  1.  To verify a signature on a message M using public key A, with F
+  //      being 0 for Ed25519ctx, 1 for Ed25519ph, and if Ed25519ctx or
+  //      Ed25519ph is being used, C being the context, first split the
+  //      signature into two 32-octet halves.  Decode the first half as a
+  //      point R, and the second half as an integer S, in the range
+  //      0 <= s < L.  Decode the public key A as point A'.  If any of the
+  //      decodings fail (including S being out of range), the signature is
+  //      invalid.
+
+  uchar const * r = sig;
+  uchar const * S = sig + 32;
+
+  /* Check scalar s */
+  if( FD_UNLIKELY( !fd_curve25519_scalar_validate( S ) )) {
     return FD_ED25519_ERR_SIG;
   }
 
+  /* Decompress and check public_key (as -A') and point r */
+  fd_ed25519_point_t neg_a[1], R[1];
+  int res = fd_ed25519_verify_decode( neg_a, R, public_key, r, cache );
+  if( FD_UNLIKELY( res ) ) return res;
+
   //  2.  Compute SHA512(dom2(F, C) || R || A || PH(M)), and interpret the
   //      64-octet digest as a little-endian integer k.
 
@@ -213,8 +405,7 @@ fd_ed25519_verify( uchar const   msg[], /* msg_sz */
      Note: this is not the same as R = [-k]A' + [S]B, because the order
      of A' is 8l (computing -k mod 8l would work). */
   fd_ed25519_point_t Rcmp[1];
-  fd_ed25519_point_neg( Aprime, Aprime );
-  fd_ed25519_double_scalar_mul_base( Rcmp, k, Aprime, S );
+  fd_ed25519_double_scalar_mul_base( Rcmp, k, neg_a, S );
 
   /* Compare R (computed) and R from signature.
      Note: many implementations do this comparison by compressing Rcmd,
@@ -309,6 +500,83 @@ int fd_ed25519_verify_batch_single_msg( uchar const   msg[], /* msg_sz */
 #undef MAX
 }
 
+int
+fd_ed25519_verify_batch( ulong                       batch_cnt,
+                         uchar const * const         msg[],
+                         ulong const                 msg_sz[],
+                         uchar const * const         sig[],
+                         uchar const * const         public_key[],
+                         fd_sha512_t *               sha,
+                         fd_ed25519_pubkey_cache_t * cache,
+                         int                         err[] ) {
+#define GROUP_MAX FD_ED25519_VERIFY_BATCH_GROUP
+
+  fd_ed25519_point_t R     [ GROUP_MAX ];
+  fd_ed25519_point_t neg_a [ GROUP_MAX ];
+  uchar              h     [ GROUP_MAX ][ 64 ];
+  ulong              live  [ GROUP_MAX ];
+
+  uchar hash_buf[ GROUP_MAX ][ 64UL+FD_ED25519_BATCH_HASH_MSG_MAX ];
+  uchar _batch[ FD_SHA512_BATCH_FOOTPRINT ] __attribute__((aligned(FD_SHA512_BATCH_ALIGN)));
+
+  int first_err = FD_ED25519_SUCCESS;
+
+  for( ulong group0=0UL; group0<batch_cnt; group0+=GROUP_MAX ) {
+    ulong group_cnt = fd_ulong_min( batch_cnt-group0, GROUP_MAX );
+
+    /* Step 1 of fd_ed25519_verify for every signature of the group,
+       remembering the ones that still need the curve equation
+       checked. */
+
+    ulong live_cnt = 0UL;
+    for( ulong j=0UL; j<group_cnt; j++ ) {
+      ulong idx = group0+j;
+      int res = FD_ED25519_ERR_SIG;
+      if( FD_LIKELY( fd_curve25519_scalar_validate( sig[ idx ]+32 ) ) ) {
+        res = fd_ed25519_verify_decode( &neg_a[ live_cnt ], &R[ live_cnt ], public_key[ idx ], sig[ idx ], cache );
+      }
+      err[ idx ] = res;
+      if( FD_LIKELY( res==FD_ED25519_SUCCESS ) ) live[ live_cnt++ ] = idx;
+    }
+
+    /* Step 2, k = H(R||A||M), for the survivors, together. */
+
+    fd_sha512_batch_t * batch = fd_sha512_batch_init( _batch );
+    for( ulong j=0UL; j<live_cnt; j++ ) {
+      ulong idx = live[ j ];
+      if( FD_LIKELY( msg_sz[ idx ]<=FD_ED25519_BATCH_HASH_MSG_MAX ) ) {
+        uchar * buf = hash_buf[ j ];
+        memcpy( buf,     sig       [ idx ], 32UL );
+        memcpy( buf+32,  public_key[ idx ], 32UL );
+        fd_memcpy( buf+64, msg[ idx ], msg_sz[ idx ] );
+        fd_sha512_batch_add( batch, buf, 64UL+msg_sz[ idx ], h[ j ] );
+      } else {
+        fd_sha512_fini( fd_sha512_append( fd_sha512_append( fd_sha512_append( fd_sha512_init( sha ),
+                        sig[ idx ], 32UL ), public_key[ idx ], 32UL ), msg[ idx ], msg_sz[ idx ] ), h[ j ] );
+      }
+    }
+    fd_sha512_batch_fini( batch );
+
+    /* Step 3, check [S]B = R + [k]A'. */
+
+    for( ulong j=0UL; j<live_cnt; j++ ) {
+      fd_ed25519_point_t Rcmp[1];
+      fd_curve25519_scalar_reduce( h[ j ], h[ j ] );
+      fd_ed25519_double_scalar_mul_base( Rcmp, h[ j ], &neg_a[ j ], sig[ live[ j ] ]+32 );
+      if( FD_UNLIKELY( !fd_ed25519_point_eq_z1( Rcmp, &R[ j ] ) ) ) err[ live[ j ] ] = FD_ED25519_ERR_MSG;
+    }
+
+    if( FD_LIKELY( first_err==FD_ED25519_SUCCESS ) ) {
+      for( ulong j=0UL; j<group_cnt; j++ ) {
+        if( FD_UNLIKELY( err[ group0+j ] ) ) { first_err = err[ group0+j ]; break; }
+      }
+    }
+  }
+
+  return first_err;
+#undef GROUP_MAX
+}
+
 char const *
 fd_ed25519_strerror( int err ) {
   switch( err ) {
@@ -1,6 +1,7 @@
 #include "../fd_ballet.h"
 #include "fd_ed25519.h"
 #include "fd_curve25519.h"
+#include "fd_ed25519_pubkey_cache.h"
 #include "../hex/fd_hex.h"
 #include "test_ed25519_wycheproof.c"
 #include "test_ed25519_cctv.c"
@@ -902,6 +903,58 @@ test_sign( fd_rng_t *    rng,
   }
 }
 
+void
+test_sign_batch( fd_rng_t *    rng,
+                 fd_sha512_t * sha ) {
+# define BATCH_MAX (40UL)
+  static uchar msgs[ BATCH_MAX ][ 2048 ];
+  static uchar sigs[ BATCH_MAX ][   64 ];
+  uchar const * msg_ptr[ BATCH_MAX ]; ulong msg_sz[ BATCH_MAX ];
+  uchar *       sig_ptr[ BATCH_MAX ];
+  uchar         pub[ 32 ];
+  uchar         prv[ 32 ];
+  uchar         exp[ 64 ];
+
+  /* Every batch size (including more than one group) must match
+     fd_ed25519_sign signature by signature.  Some messages are too large
+     to be hashed batched. */
+
+  for( ulong iter=0UL; iter<64UL; iter++ ) {
+    ulong batch_cnt = (ulong)fd_rng_uint_roll( rng, (uint)BATCH_MAX+1U );
+    fd_ed25519_public_from_private( pub, fd_rng_b256( rng, prv ), sha );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      msg_sz[ j ] = (ulong)fd_rng_uint_roll( rng, fd_rng_uint_roll( rng, 8U ) ? 257U : 2049U );
+      for( ulong b=0UL; b<msg_sz[ j ]; b++ ) msgs[ j ][ b ] = fd_rng_uchar( rng );
+      msg_ptr[ j ] = msgs[ j ]; sig_ptr[ j ] = sigs[ j ];
+    }
+    fd_ed25519_sign_batch( batch_cnt, sig_ptr, msg_ptr, msg_sz, pub, prv, sha );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      FD_TEST( fd_memeq( sigs[ j ], fd_ed25519_sign( exp, msgs[ j ], msg_sz[ j ], pub, prv, sha ), 64UL ) );
+      FD_TEST( fd_ed25519_verify( msgs[ j ], msg_sz[ j ], sigs[ j ], pub, sha )==FD_ED25519_SUCCESS );
+    }
+  }
+
+  /* bench */
+
+  for( ulong j=0UL; j<16UL; j++ ) {
+    msg_sz[ j ] = 128UL;
+    for( ulong b=0UL; b<msg_sz[ j ]; b++ ) msgs[ j ][ b ] = fd_rng_uchar( rng );
+    msg_ptr[ j ] = msgs[ j ]; sig_ptr[ j ] = sigs[ j ];
+  }
+  ulong iter = 10000UL;
+  for( ulong batch_cnt=1UL; batch_cnt<=16UL; batch_cnt<<=1 ) {
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter/batch_cnt; rem; rem-- ) {
+      FD_COMPILER_FORGET( sha ); FD_COMPILER_FORGET( batch_cnt );
+      fd_ed25519_sign_batch( batch_cnt, sig_ptr, msg_ptr, msg_sz, pub, prv, sha );
+    }
+    dt = fd_log_wallclock() - dt;
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_sign_batch(128 x %lu)", batch_cnt ), (iter/batch_cnt)*batch_cnt, dt );
+  }
+# undef BATCH_MAX
+}
+
 void
 test_verify( fd_rng_t *    rng,
              fd_sha512_t * sha ) {
@@ -1069,6 +1122,172 @@ test_verify( fd_rng_t *    rng,
   }
 }
 
+void
+test_verify_batch( fd_rng_t *    rng,
+                   fd_sha512_t * sha ) {
+# define BATCH_MAX (40UL)
+  static uchar msgs[ BATCH_MAX ][ 2048 ];
+  static uchar pubs[ BATCH_MAX ][   32 ];
+  static uchar sigs[ BATCH_MAX ][   64 ];
+  uchar const * msg_ptr[ BATCH_MAX ]; ulong msg_sz[ BATCH_MAX ];
+  uchar const * sig_ptr[ BATCH_MAX ]; uchar const * pub_ptr[ BATCH_MAX ];
+  int           err    [ BATCH_MAX ];
+  uchar         prv[ 32 ];
+
+  /* Independent messages and keys, some corrupted, every batch size
+     (including more than one group and an odd number of survivors)
+     must match fd_ed25519_verify signature by signature.  Some
+     messages are too large to be hashed batched. */
+
+  for( ulong iter=0UL; iter<64UL; iter++ ) {
+    ulong batch_cnt = (ulong)fd_rng_uint_roll( rng, (uint)BATCH_MAX+1U );
+    int   expected  = FD_ED25519_SUCCESS;
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      msg_sz[ j ] = (ulong)fd_rng_uint_roll( rng, fd_rng_uint_roll( rng, 8U ) ? 257U : 2049U );
+      for( ulong b=0UL; b<msg_sz[ j ]; b++ ) msgs[ j ][ b ] = fd_rng_uchar( rng );
+      fd_ed25519_public_from_private( pubs[ j ], fd_rng_b256( rng, prv ), sha );
+      fd_ed25519_sign( sigs[ j ], msgs[ j ], msg_sz[ j ], pubs[ j ], prv, sha );
+
+      uint r = fd_rng_uint( rng );
+      if( !(r & 7U) ) { r >>= 3; sigs[ j ][ (r>>3) & 63U ] ^= (uchar)(1U<<(r&7U)); }
+      else if( !(r & 56U) && msg_sz[ j ] ) { r >>= 6; msgs[ j ][ (r>>3) % msg_sz[ j ] ] ^= (uchar)(1U<<(r&7U)); }
+      else if( !(r & 448U) ) { r >>= 9; pubs[ j ][ (r>>3) & 31U ] ^= (uchar)(1U<<(r&7U)); }
+
+      msg_ptr[ j ] = msgs[ j ]; sig_ptr[ j ] = sigs[ j ]; pub_ptr[ j ] = pubs[ j ];
+      err[ j ] = 1;
+
+      int ref = fd_ed25519_verify( msg_ptr[ j ], msg_sz[ j ], sig_ptr[ j ], pub_ptr[ j ], sha );
+      if( expected==FD_ED25519_SUCCESS ) expected = ref;
+    }
+    FD_TEST( fd_ed25519_verify_batch( batch_cnt, msg_ptr, msg_sz, sig_ptr, pub_ptr, sha, NULL, err )==expected );
+    for( ulong j=0UL; j<batch_cnt; j++ ) {
+      FD_TEST( err[ j ]==fd_ed25519_verify( msg_ptr[ j ], msg_sz[ j ], sig_ptr[ j ], pub_ptr[ j ], sha ) );
+    }
+  }
+
+  /* bench, all good */
+
+  for( ulong j=0UL; j<16UL; j++ ) {
+    msg_sz[ j ] = 256UL;
+    for( ulong b=0UL; b<msg_sz[ j ]; b++ ) msgs[ j ][ b ] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( pubs[ j ], fd_rng_b256( rng, prv ), sha );
+    fd_ed25519_sign( sigs[ j ], msgs[ j ], msg_sz[ j ], pubs[ j ], prv, sha );
+    msg_ptr[ j ] = msgs[ j ]; sig_ptr[ j ] = sigs[ j ]; pub_ptr[ j ] = pubs[ j ];
+  }
+  ulong iter = 10000UL;
+  for( ulong batch_cnt=1UL; batch_cnt<=16UL; batch_cnt<<=1 ) {
+    FD_TEST( fd_ed25519_verify_batch( batch_cnt, msg_ptr, msg_sz, sig_ptr, pub_ptr, sha, NULL, err )==FD_ED25519_SUCCESS );
+    long dt = fd_log_wallclock();
+    for( ulong rem=iter/batch_cnt; rem; rem-- ) {
+      FD_COMPILER_FORGET( sha ); FD_COMPILER_FORGET( batch_cnt );
+      fd_ed25519_verify_batch( batch_cnt, msg_ptr, msg_sz, sig_ptr, pub_ptr, sha, NULL, err );
+    }
+    dt = fd_log_wallclock() - dt;
+    char cstr[128];
+    log_bench( fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_batch(256 x %lu)", batch_cnt ), (iter/batch_cnt)*batch_cnt, dt );
+  }
+# undef BATCH_MAX
+}
+
+void
+test_verify_cached( fd_rng_t *    rng,
+                    fd_sha512_t * sha ) {
+  FD_TEST( fd_ed25519_pubkey_cache_align()==FD_ED25519_PUBKEY_CACHE_ALIGN );
+  FD_TEST( !fd_ed25519_pubkey_cache_footprint( 0UL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_footprint( 3UL ) );
+  FD_TEST( fd_ed25519_pubkey_cache_footprint( 16UL )==FD_ED25519_PUBKEY_CACHE_FOOTPRINT( 16UL ) );
+
+  static uchar cache_mem[ FD_ED25519_PUBKEY_CACHE_FOOTPRINT( 16UL ) ] __attribute__((aligned(FD_ED25519_PUBKEY_CACHE_ALIGN)));
+  FD_TEST( !fd_ed25519_pubkey_cache_new( NULL,        16UL, 1234UL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_new( cache_mem+1, 16UL, 1234UL ) );
+  FD_TEST( !fd_ed25519_pubkey_cache_new( cache_mem,    3UL, 1234UL ) );
+  fd_ed25519_pubkey_cache_t * cache = fd_ed25519_pubkey_cache_join( fd_ed25519_pubkey_cache_new( cache_mem, 16UL, 1234UL ) );
+  FD_TEST( cache );
+
+  /* Test vectors, with the edge case keys and points, verify the same
+     with the cache cold and warm */
+
+  char cstr[128];
+  for( ulong pass=0UL; pass<2UL; pass++ ) {
+    for( fd_ed25519_verify_cctv_t const * proof = ed25519_verify_cctvs; proof->msg; proof++ ) {
+      int expected = fd_ed25519_verify       ( proof->msg, proof->msg_sz, proof->sig, proof->pub, sha );
+      int actual   = fd_ed25519_verify_cached( proof->msg, proof->msg_sz, proof->sig, proof->pub, sha, cache );
+      FD_TEST_CUSTOM( actual==expected, fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_cached cctv id=%u", proof->tc_id ) );
+    }
+    for( fd_ed25519_verify_wycheproof_t const * proof = ed25519_verify_wycheproofs; proof->msg; proof++ ) {
+      int expected = fd_ed25519_verify       ( proof->msg, proof->msg_sz, proof->sig, proof->pub, sha );
+      int actual   = fd_ed25519_verify_cached( proof->msg, proof->msg_sz, proof->sig, proof->pub, sha, cache );
+      FD_TEST_CUSTOM( actual==expected, fd_cstr_printf( cstr, 128UL, NULL, "fd_ed25519_verify_cached wycheproof id=%u", proof->tc_id ) );
+    }
+  }
+
+  /* A few signers signing many messages (more signers than the cache
+     holds, so there are evictions), some corrupted, singly and
+     batched */
+
+# define SIGNER_CNT (96UL)
+# define BATCH_MAX  (24UL)
+  static uchar prvs[ SIGNER_CNT ][ 32 ];
+  static uchar keys[ SIGNER_CNT ][ 32 ];
+  for( ulong i=0UL; i<SIGNER_CNT; i++ ) fd_ed25519_public_from_private( keys[ i ], fd_rng_b256( rng, prvs[ i ] ), sha );
+
+  static uchar msgs[ BATCH_MAX ][ 64 ];
+  static uchar pubs[ BATCH_MAX ][ 32 ];
+  static uchar sigs[ BATCH_MAX ][ 64 ];
+  uchar const * msg_ptr[ BATCH_MAX ]; ulong msg_sz[ BATCH_MAX ];
+  uchar const * sig_ptr[ BATCH_MAX ]; uchar const * pub_ptr[ BATCH_MAX ];
+  int           err    [ BATCH_MAX ];
+
+  ulong hit_cnt0 = fd_ed25519_pubkey_cache_hit_cnt( cache );
+  for( ulong iter=0UL; iter<256UL; iter++ ) {
+    for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+      ulong signer = fd_rng_uint_roll( rng, 4U ) ? fd_rng_ulong_roll( rng, 8UL ) : fd_rng_ulong_roll( rng, SIGNER_CNT );
+      msg_sz[ j ] = 64UL;
+      for( ulong b=0UL; b<64UL; b++ ) msgs[ j ][ b ] = fd_rng_uchar( rng );
+      memcpy( pubs[ j ], keys[ signer ], 32UL );
+      fd_ed25519_sign( sigs[ j ], msgs[ j ], msg_sz[ j ], pubs[ j ], prvs[ signer ], sha );
+
+      uint r = fd_rng_uint( rng );
+      if(      !(r &   7U) ) { r >>= 3; sigs[ j ][ (r>>3) & 63U ] ^= (uchar)(1U<<(r&7U)); }
+      else if( !(r &  56U) ) { r >>= 6; pubs[ j ][ (r>>3) & 31U ] ^= (uchar)(1U<<(r&7U)); }
+      else if( !(r & 448U) ) { memset( pubs[ j ], 0, 32UL ); } /* small order */
+
+      msg_ptr[ j ] = msgs[ j ]; sig_ptr[ j ] = sigs[ j ]; pub_ptr[ j ] = pubs[ j ];
+
+      int expected = fd_ed25519_verify( msg_ptr[ j ], msg_sz[ j ], sig_ptr[ j ], pub_ptr[ j ], sha );
+      FD_TEST( fd_ed25519_verify_cached( msg_ptr[ j ], msg_sz[ j ], sig_ptr[ j ], pub_ptr[ j ], sha, cache )==expected );
+    }
+    fd_ed25519_verify_batch( BATCH_MAX, msg_ptr, msg_sz, sig_ptr, pub_ptr, sha, cache, err );
+    for( ulong j=0UL; j<BATCH_MAX; j++ ) {
+      FD_TEST( err[ j ]==fd_ed25519_verify( msg_ptr[ j ], msg_sz[ j ], sig_ptr[ j ], pub_ptr[ j ], sha ) );
+    }
+  }
+  FD_TEST( fd_ed25519_pubkey_cache_hit_cnt( cache )>hit_cnt0 );
+  FD_TEST( fd_ed25519_pubkey_cache_miss_cnt( cache ) );
+# undef BATCH_MAX
+# undef SIGNER_CNT
+
+  /* bench, same signer, all hits (after the first) */
+
+  uchar msg[ 256 ]; for( ulong b=0UL; b<256UL; b++ ) msg[ b ] = fd_rng_uchar( rng );
+  uchar sig[ 64 ];
+  fd_ed25519_sign( sig, msg, 256UL, keys[ 0 ], prvs[ 0 ], sha );
+  FD_TEST( fd_ed25519_verify_cached( msg, 256UL, sig, keys[ 0 ], sha, cache )==FD_ED25519_SUCCESS );
+
+  ulong iter = 10000UL;
+  long  dt   = fd_log_wallclock();
+  for( ulong rem=iter; rem; rem-- ) {
+    FD_COMPILER_FORGET( sha ); FD_COMPILER_FORGET( cache );
+    fd_ed25519_verify_cached( msg, 256UL, sig, keys[ 0 ], sha, cache );
+  }
+  dt = fd_log_wallclock() - dt;
+  log_bench( "fd_ed25519_verify_cached(256, hit)", iter, dt );
+
+  FD_TEST( fd_ed25519_pubkey_cache_leave ( cache     )==cache_mem );
+  FD_TEST( fd_ed25519_pubkey_cache_delete( cache_mem )==cache_mem );
+  FD_TEST( !fd_ed25519_pubkey_cache_join ( cache_mem ) );
+}
+
 void
 test_wycheproofs( fd_sha512_t * sha ) {
   char cstr[128];
@@ -1175,7 +1394,10 @@ main( int     argc,
 
   test_public_from_private( rng, sha );
   test_sign               ( rng, sha );
+  test_sign_batch         ( rng, sha );
   test_verify             ( rng, sha );
+  test_verify_batch       ( rng, sha );
+  test_verify_cached      ( rng, sha );
 
   test_wycheproofs( sha );
   test_cctv       ( sha );
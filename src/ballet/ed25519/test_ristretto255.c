@@ -464,6 +464,41 @@ test_multiscalar_mul( fd_rng_t * rng ) {
     FD_TEST( fd_ristretto255_point_eq( h, t ) );
   }
 
+  {
+    /* Random MSMs of sizes around the Straus/wNAF -> Pippenger switch
+       and across window sizes, vs. a sum of scalar muls */
+#   define RND_N 600
+    static fd_ristretto255_point_t f[ RND_N ];
+    static uchar                   a[ RND_N*32 ];
+    fd_ristretto255_point_t _t[1]; fd_ristretto255_point_t * t = _t;
+    fd_ristretto255_point_t _e[1]; fd_ristretto255_point_t * e = _e;
+    ulong szs[] = { 0UL, 1UL, 31UL, 63UL, 64UL, 65UL, 127UL, 200UL, 333UL, RND_N };
+    for( ulong i=0UL; i<RND_N; i++ ) {
+      uchar s[32];
+      fd_ristretto255_point_decompress( &f[i], base_point_multiples[ 1UL+i%15UL ] );
+      fd_ristretto255_scalar_mul( &f[i], fd_rng_b256( rng, s ), &f[i] );
+      fd_ristretto255_point_compress( s, &f[i] ); /* MSM points are assumed decompressed */
+      fd_ristretto255_point_decompress( &f[i], s );
+      fd_rng_b256( rng, &a[ i*32 ] );
+      switch( i%3UL ) {
+      case 0UL: a[ i*32+31 ] &= 0x0f; break;          /* random (MSM scalars are assumed valid) */
+      case 1UL: memset( &a[ i*32 ], 0, 32UL ); break; /* zero */
+      default:  fd_hex_decode( &a[ i*32 ], "ECD3F55C1A631258D69CF7A2DEF9DE1400000000000000000000000000000010", 32 ); break; /* -1 */
+      }
+    }
+    for( ulong k=0UL; k<sizeof(szs)/sizeof(szs[0]); k++ ) {
+      ulong sz = szs[k];
+      fd_ristretto255_point_set_zero( e );
+      for( ulong i=0UL; i<sz; i++ ) {
+        fd_ristretto255_scalar_mul( t, &a[ i*32 ], &f[i] );
+        fd_ristretto255_point_add( e, e, t );
+      }
+      FD_TEST( fd_ristretto255_multi_scalar_mul( h, a, f, sz )==h );
+      FD_TEST( fd_ristretto255_point_eq( h, e ) );
+    }
+#   undef RND_N
+  }
+
   /* Benchmarks */
   ulong iter = 10000UL;
 
@@ -1,5 +1,11 @@
 $(call add-hdrs,fd_keccak256.h)
 $(call add-objs,fd_keccak256,fd_ballet)
+ifdef FD_HAS_AVX
+$(call add-objs,fd_keccak256_batch_avx,fd_ballet)
+endif
+ifdef FD_HAS_AVX512
+$(call add-objs,fd_keccak256_batch_avx512,fd_ballet)
+endif
 
 $(call make-unit-test,test_keccak256,test_keccak256,fd_ballet fd_util)
 $(call run-unit-test,test_keccak256)
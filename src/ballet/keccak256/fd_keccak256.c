@@ -123,16 +123,35 @@ fd_keccak256_append( fd_keccak256_t * sha,
 
   uchar const * data = (uchar const *)_data;
 
+  /* Complete any partially absorbed block */
+
   ulong state_idx = padding_start;
-  for( ulong i = 0; i < sz; i++ ) {
-    state_bytes[state_idx] ^= data[i];
-    state_idx++;
-    if( state_idx >= FD_KECCAK256_RATE ) {
-      fd_keccak256_core(state);
-      state_idx = 0;
+  if( FD_UNLIKELY( state_idx ) ) {
+    ulong cpy_sz = fd_ulong_min( sz, FD_KECCAK256_RATE-state_idx );
+    for( ulong i=0UL; i<cpy_sz; i++ ) state_bytes[ state_idx+i ] ^= data[ i ];
+    state_idx += cpy_sz;
+    data      += cpy_sz;
+    sz        -= cpy_sz;
+    if( FD_LIKELY( state_idx==FD_KECCAK256_RATE ) ) {
+      fd_keccak256_core( state );
+      state_idx = 0UL;
     }
   }
 
+  /* Absorb whole blocks a word at a time */
+
+  while( sz>=FD_KECCAK256_RATE ) {
+    for( ulong i=0UL; i<FD_KECCAK256_RATE/sizeof(ulong); i++ ) state[ i ] ^= FD_LOAD( ulong, data+i*sizeof(ulong) );
+    fd_keccak256_core( state );
+    data += FD_KECCAK256_RATE;
+    sz   -= FD_KECCAK256_RATE;
+  }
+
+  /* Absorb the remaining bytes (if any, state_idx is zero here) */
+
+  for( ulong i=0UL; i<sz; i++ ) state_bytes[ state_idx+i ] ^= data[ i ];
+  state_idx += sz;
+
   sha->padding_start = state_idx;
 
   return sha;
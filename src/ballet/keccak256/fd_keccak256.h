@@ -128,4 +128,200 @@ fd_keccak256_hash( void const * data,
 
 FD_PROTOTYPES_END
 
+/* fd_keccak256_batch_{align,footprint,init,add,fini,abort} hash several
+   independent messages at once.  The usage is identical to that of the
+   fd_sha256 batching API (see ../sha256/fd_sha256.h for details).  On
+   targets with AVX (AVX-512) support, up to 4 (8) messages are hashed in
+   parallel with one Keccak-f[1600] state per SIMD lane.  This is much
+   faster than hashing the messages one at a time when there are many
+   messages of similar size to hash (e.g. Merkle trees, address
+   derivation, many small sol_keccak256 calls). */
+
+#ifndef FD_KECCAK256_BATCH_IMPL
+#if FD_HAS_AVX512
+#define FD_KECCAK256_BATCH_IMPL 2
+#elif FD_HAS_AVX
+#define FD_KECCAK256_BATCH_IMPL 1
+#else
+#define FD_KECCAK256_BATCH_IMPL 0
+#endif
+#endif
+
+#if FD_KECCAK256_BATCH_IMPL==0 /* Reference batching implementation */
+
+#define FD_KECCAK256_BATCH_ALIGN     (1UL)
+#define FD_KECCAK256_BATCH_FOOTPRINT (1UL)
+#define FD_KECCAK256_BATCH_MAX       (1UL)
+
+typedef uchar fd_keccak256_batch_t;
+
+FD_PROTOTYPES_BEGIN
+
+FD_FN_CONST static inline ulong fd_keccak256_batch_align    ( void ) { return alignof(fd_keccak256_batch_t); }
+FD_FN_CONST static inline ulong fd_keccak256_batch_footprint( void ) { return sizeof (fd_keccak256_batch_t); }
+
+static inline fd_keccak256_batch_t * fd_keccak256_batch_init( void * mem ) { return (fd_keccak256_batch_t *)mem; }
+
+static inline fd_keccak256_batch_t *
+fd_keccak256_batch_add( fd_keccak256_batch_t * batch,
+                        void const *           data,
+                        ulong                  sz,
+                        void *                 hash ) {
+  fd_keccak256_hash( data, sz, hash );
+  return batch;
+}
+
+static inline void * fd_keccak256_batch_fini ( fd_keccak256_batch_t * batch ) { return (void *)batch; }
+static inline void * fd_keccak256_batch_abort( fd_keccak256_batch_t * batch ) { return (void *)batch; }
+
+FD_PROTOTYPES_END
+
+#elif FD_KECCAK256_BATCH_IMPL==1 /* AVX accelerated batching implementation */
+
+#define FD_KECCAK256_BATCH_ALIGN     (128UL)
+#define FD_KECCAK256_BATCH_FOOTPRINT (128UL)
+#define FD_KECCAK256_BATCH_MAX       (4UL)
+
+/* This is exposed here to facilitate inlining various operations */
+
+struct __attribute__((aligned(FD_KECCAK256_BATCH_ALIGN))) fd_keccak256_private_batch {
+  void const * data[ FD_KECCAK256_BATCH_MAX ]; /* AVX aligned */
+  ulong        sz  [ FD_KECCAK256_BATCH_MAX ]; /* AVX aligned */
+  void *       hash[ FD_KECCAK256_BATCH_MAX ]; /* AVX aligned */
+  ulong        cnt;
+};
+
+typedef struct fd_keccak256_private_batch fd_keccak256_batch_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* Internal use only */
+
+void
+fd_keccak256_private_batch_avx( ulong          batch_cnt,    /* In [1,FD_KECCAK256_BATCH_MAX] */
+                                void const *   batch_data,   /* Indexed [0,FD_KECCAK256_BATCH_MAX), aligned 32,
+                                                                only [0,batch_cnt) used, essentially a msg_t const * const * */
+                                ulong const *  batch_sz,     /* Indexed [0,FD_KECCAK256_BATCH_MAX), aligned 32,
+                                                                only [0,batch_cnt) used */
+                                void * const * batch_hash ); /* Indexed [0,FD_KECCAK256_BATCH_MAX), aligned 32,
+                                                                only [0,batch_cnt) used */
+
+FD_FN_CONST static inline ulong fd_keccak256_batch_align    ( void ) { return alignof(fd_keccak256_batch_t); }
+FD_FN_CONST static inline ulong fd_keccak256_batch_footprint( void ) { return sizeof (fd_keccak256_batch_t); }
+
+static inline fd_keccak256_batch_t *
+fd_keccak256_batch_init( void * mem ) {
+  fd_keccak256_batch_t * batch = (fd_keccak256_batch_t *)mem;
+  batch->cnt = 0UL;
+  return batch;
+}
+
+static inline fd_keccak256_batch_t *
+fd_keccak256_batch_add( fd_keccak256_batch_t * batch,
+                        void const *           data,
+                        ulong                  sz,
+                        void *                 hash ) {
+  ulong batch_cnt = batch->cnt;
+  batch->data[ batch_cnt ] = data;
+  batch->sz  [ batch_cnt ] = sz;
+  batch->hash[ batch_cnt ] = hash;
+  batch_cnt++;
+  if( FD_UNLIKELY( batch_cnt==FD_KECCAK256_BATCH_MAX ) ) {
+    fd_keccak256_private_batch_avx( batch_cnt, batch->data, batch->sz, batch->hash );
+    batch_cnt = 0UL;
+  }
+  batch->cnt = batch_cnt;
+  return batch;
+}
+
+static inline void *
+fd_keccak256_batch_fini( fd_keccak256_batch_t * batch ) {
+  ulong batch_cnt = batch->cnt;
+  if( FD_LIKELY( batch_cnt ) ) fd_keccak256_private_batch_avx( batch_cnt, batch->data, batch->sz, batch->hash );
+  return (void *)batch;
+}
+
+static inline void *
+fd_keccak256_batch_abort( fd_keccak256_batch_t * batch ) {
+  return (void *)batch;
+}
+
+FD_PROTOTYPES_END
+
+#elif FD_KECCAK256_BATCH_IMPL==2 /* AVX-512 accelerated batching implementation */
+
+#define FD_KECCAK256_BATCH_ALIGN     (128UL)
+#define FD_KECCAK256_BATCH_FOOTPRINT (256UL)
+#define FD_KECCAK256_BATCH_MAX       (8UL)
+
+/* This is exposed here to facilitate inlining various operations */
+
+struct __attribute__((aligned(FD_KECCAK256_BATCH_ALIGN))) fd_keccak256_private_batch {
+  void const * data[ FD_KECCAK256_BATCH_MAX ]; /* AVX-512 aligned */
+  ulong        sz  [ FD_KECCAK256_BATCH_MAX ]; /* AVX-512 aligned */
+  void *       hash[ FD_KECCAK256_BATCH_MAX ]; /* AVX-512 aligned */
+  ulong        cnt;
+};
+
+typedef struct fd_keccak256_private_batch fd_keccak256_batch_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* Internal use only */
+
+void
+fd_keccak256_private_batch_avx512( ulong          batch_cnt,    /* In [1,FD_KECCAK256_BATCH_MAX] */
+                                   void const *   batch_data,   /* Indexed [0,FD_KECCAK256_BATCH_MAX), aligned 64,
+                                                                   only [0,batch_cnt) used, essentially a msg_t const * const * */
+                                   ulong const *  batch_sz,     /* Indexed [0,FD_KECCAK256_BATCH_MAX), aligned 64,
+                                                                   only [0,batch_cnt) used */
+                                   void * const * batch_hash ); /* Indexed [0,FD_KECCAK256_BATCH_MAX), aligned 64,
+                                                                   only [0,batch_cnt) used */
+
+FD_FN_CONST static inline ulong fd_keccak256_batch_align    ( void ) { return alignof(fd_keccak256_batch_t); }
+FD_FN_CONST static inline ulong fd_keccak256_batch_footprint( void ) { return sizeof (fd_keccak256_batch_t); }
+
+static inline fd_keccak256_batch_t *
+fd_keccak256_batch_init( void * mem ) {
+  fd_keccak256_batch_t * batch = (fd_keccak256_batch_t *)mem;
+  batch->cnt = 0UL;
+  return batch;
+}
+
+static inline fd_keccak256_batch_t *
+fd_keccak256_batch_add( fd_keccak256_batch_t * batch,
+                        void const *           data,
+                        ulong                  sz,
+                        void *                 hash ) {
+  ulong batch_cnt = batch->cnt;
+  batch->data[ batch_cnt ] = data;
+  batch->sz  [ batch_cnt ] = sz;
+  batch->hash[ batch_cnt ] = hash;
+  batch_cnt++;
+  if( FD_UNLIKELY( batch_cnt==FD_KECCAK256_BATCH_MAX ) ) {
+    fd_keccak256_private_batch_avx512( batch_cnt, batch->data, batch->sz, batch->hash );
+    batch_cnt = 0UL;
+  }
+  batch->cnt = batch_cnt;
+  return batch;
+}
+
+static inline void *
+fd_keccak256_batch_fini( fd_keccak256_batch_t * batch ) {
+  ulong batch_cnt = batch->cnt;
+  if( FD_LIKELY( batch_cnt ) ) fd_keccak256_private_batch_avx512( batch_cnt, batch->data, batch->sz, batch->hash );
+  return (void *)batch;
+}
+
+static inline void *
+fd_keccak256_batch_abort( fd_keccak256_batch_t * batch ) {
+  return (void *)batch;
+}
+
+FD_PROTOTYPES_END
+
+#else
+#error "Unsupported FD_KECCAK256_BATCH_IMPL"
+#endif
+
 #endif /* HEADER_fd_src_ballet_keccak256_fd_keccak256_h */
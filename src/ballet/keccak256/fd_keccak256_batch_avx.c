@@ -0,0 +1,126 @@
+#define FD_KECCAK256_BATCH_IMPL 1
+
+#include "fd_keccak256.h"
+#include "fd_keccak256_private.h"
+#include "../../util/simd/fd_avx.h"
+
+FD_STATIC_ASSERT( FD_KECCAK256_BATCH_MAX==4UL, compat );
+
+#define FD_KECCAK256_PRIVATE_CHI(a,b,c) wv_xor( (a), wv_andnot( (b), (c) ) )
+
+void
+fd_keccak256_private_batch_avx( ulong          batch_cnt,
+                                void const *   _batch_data,
+                                ulong const *  batch_sz,
+                                void * const * _batch_hash ) {
+
+  if( FD_UNLIKELY( batch_cnt<2UL ) ) {
+    void const * const * batch_data = (void const * const *)_batch_data;
+    for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ )
+      fd_keccak256_hash( batch_data[ batch_idx ], batch_sz[ batch_idx ], _batch_hash[ batch_idx ] );
+    return;
+  }
+
+  /* Keccak256 appends to the end of each message a 0x01 terminator
+     byte, zero padding and a final 0x80 byte (the two share a byte when
+     the terminator lands on the last byte of a block) such that the
+     message is an integer number of FD_KECCAK256_RATE byte blocks long.
+     As the padding is at least 1 byte, each message has exactly one
+     tail block.  We compute the tail block of each message here.  We
+     then absorb complete blocks of the original messages in place,
+     switching to these tail blocks in the same pass toward the end. */
+
+  ulong const * batch_data = (ulong const *)_batch_data;
+
+  ulong batch_tail_data[ FD_KECCAK256_BATCH_MAX ] __attribute__((aligned(32)));
+  ulong batch_block_cnt[ FD_KECCAK256_BATCH_MAX ] __attribute__((aligned(32)));
+
+  uchar scratch[ FD_KECCAK256_BATCH_MAX*FD_KECCAK256_RATE ] __attribute__((aligned(128)));
+  for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+    uchar const * data = (uchar const *)batch_data[ batch_idx ];
+    ulong         sz   = batch_sz[ batch_idx ];
+
+    uchar * tail_data    = scratch + batch_idx*FD_KECCAK256_RATE;
+    ulong   tail_data_sz = sz % FD_KECCAK256_RATE;
+
+    fd_memset( tail_data, 0, FD_KECCAK256_RATE );
+    fd_memcpy( tail_data, data + sz - tail_data_sz, tail_data_sz );
+    tail_data[ tail_data_sz          ]  = (uchar)0x01;
+    tail_data[ FD_KECCAK256_RATE-1UL ] |= (uchar)0x80;
+
+    batch_tail_data[ batch_idx ] = (ulong)tail_data;
+    batch_block_cnt[ batch_idx ] = sz/FD_KECCAK256_RATE + 1UL;
+  }
+
+  wv_t s[25];
+  for( ulong i=0UL; i<25UL; i++ ) s[i] = wv_zero();
+
+  wv_t one        = wv_one();
+  wv_t wv_rate    = wv_bcast( FD_KECCAK256_RATE );
+  wv_t W_sentinel = wv_bcast( (ulong)scratch );
+  wc_t batch_lane = wc_unpack( (1<<(2*batch_cnt))-1 );
+  wv_t tail       = wv_ld( batch_tail_data );
+  wv_t W          = wv_ld( batch_data      );
+  wv_t block_rem  = wv_notczero( batch_lane, wv_ld( batch_block_cnt ) );
+  for(;;) {
+    wc_t active_lane = wv_to_wc( block_rem );
+    if( FD_UNLIKELY( !wc_any( active_lane ) ) ) break;
+
+    /* Switch lanes that are at their last block to their tail block */
+
+    W = wv_if( wv_eq( block_rem, one ), tail, W );
+
+    /* Load the next block of each active lane.  Inactive lanes load
+       garbage from a sentinel location (and the state updates of
+       inactive lanes are discarded below). */
+
+    wv_t W03 = wv_if( active_lane, W, W_sentinel );
+    ulong const * W0 = (ulong const *)wv_extract( W03, 0 );
+    ulong const * W1 = (ulong const *)wv_extract( W03, 1 );
+    ulong const * W2 = (ulong const *)wv_extract( W03, 2 );
+    ulong const * W3 = (ulong const *)wv_extract( W03, 3 );
+
+    wv_t t[25];
+    for( ulong i=0UL; i<16UL; i+=4UL ) {
+      wv_t x0; wv_t x1; wv_t x2; wv_t x3;
+      wv_transpose_4x4( wv_ldu( W0+i ), wv_ldu( W1+i ), wv_ldu( W2+i ), wv_ldu( W3+i ), x0, x1, x2, x3 );
+      t[i    ] = wv_xor( s[i    ], x0 );
+      t[i+1UL] = wv_xor( s[i+1UL], x1 );
+      t[i+2UL] = wv_xor( s[i+2UL], x2 );
+      t[i+3UL] = wv_xor( s[i+3UL], x3 );
+    }
+    t[16] = wv_xor( s[16], wv( FD_LOAD( ulong, W0+16 ), FD_LOAD( ulong, W1+16 ), FD_LOAD( ulong, W2+16 ), FD_LOAD( ulong, W3+16 ) ) );
+    for( ulong i=17UL; i<25UL; i++ ) t[i] = s[i];
+
+    FD_KECCAK256_PRIVATE_F1600( wv_t, wv_xor, wv_rol, FD_KECCAK256_PRIVATE_CHI, wv_bcast, t );
+
+    /* Apply the state updates to the active lanes */
+
+    for( ulong i=0UL; i<25UL; i++ ) s[i] = wv_if( active_lane, t[i], s[i] );
+
+    /* Advance to the next blocks.  In pseudo code:
+
+         W += RATE; if( block_rem ) block_rem--;
+
+       As above, W of inactive lanes is never loaded. */
+
+    W = wv_add( W, wv_rate );
+
+    block_rem = wv_add( block_rem, wc_to_wv_raw( active_lane ) );
+  }
+
+  /* The hash is the first 4 words of the state */
+
+  wv_transpose_4x4( s[0],s[1],s[2],s[3], s[0],s[1],s[2],s[3] );
+
+  ulong * const * batch_hash = (ulong * const *)_batch_hash;
+  switch( batch_cnt ) { /* application dependent prob */
+  case 4UL: wv_stu( batch_hash[3], s[3] ); __attribute__((fallthrough));
+  case 3UL: wv_stu( batch_hash[2], s[2] ); __attribute__((fallthrough));
+  case 2UL: wv_stu( batch_hash[1], s[1] ); __attribute__((fallthrough));
+  case 1UL: wv_stu( batch_hash[0], s[0] ); __attribute__((fallthrough));
+  default: break;
+  }
+}
+
+#undef FD_KECCAK256_PRIVATE_CHI
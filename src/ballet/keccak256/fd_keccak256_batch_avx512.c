@@ -0,0 +1,135 @@
+#define FD_KECCAK256_BATCH_IMPL 2
+
+#include "fd_keccak256.h"
+#include "fd_keccak256_private.h"
+#include "../../util/simd/fd_avx512.h"
+
+FD_STATIC_ASSERT( FD_KECCAK256_BATCH_MAX==8UL, compat );
+
+/* chi in a single ternary logic op (0xd2 is the truth table of
+   a^(~b&c)) */
+
+#define FD_KECCAK256_PRIVATE_CHI(a,b,c) _mm512_ternarylogic_epi64( (a), (b), (c), 0xd2 )
+
+void
+fd_keccak256_private_batch_avx( ulong          batch_cnt,
+                                void const *   batch_data,
+                                ulong const *  batch_sz,
+                                void * const * batch_hash );
+
+void
+fd_keccak256_private_batch_avx512( ulong          batch_cnt,
+                                   void const *   _batch_data,
+                                   ulong const *  batch_sz,
+                                   void * const * _batch_hash ) {
+
+  if( FD_UNLIKELY( batch_cnt<5UL ) ) {
+    fd_keccak256_private_batch_avx( batch_cnt, _batch_data, batch_sz, _batch_hash );
+    return;
+  }
+
+  /* See fd_keccak256_batch_avx.c for details on the tail blocks */
+
+  ulong const * batch_data = (ulong const *)_batch_data;
+
+  ulong batch_tail_data[ FD_KECCAK256_BATCH_MAX ] __attribute__((aligned(64)));
+  ulong batch_block_cnt[ FD_KECCAK256_BATCH_MAX ] __attribute__((aligned(64)));
+
+  uchar scratch[ FD_KECCAK256_BATCH_MAX*FD_KECCAK256_RATE ] __attribute__((aligned(128)));
+  for( ulong batch_idx=0UL; batch_idx<batch_cnt; batch_idx++ ) {
+    uchar const * data = (uchar const *)batch_data[ batch_idx ];
+    ulong         sz   = batch_sz[ batch_idx ];
+
+    uchar * tail_data    = scratch + batch_idx*FD_KECCAK256_RATE;
+    ulong   tail_data_sz = sz % FD_KECCAK256_RATE;
+
+    fd_memset( tail_data, 0, FD_KECCAK256_RATE );
+    fd_memcpy( tail_data, data + sz - tail_data_sz, tail_data_sz );
+    tail_data[ tail_data_sz          ]  = (uchar)0x01;
+    tail_data[ FD_KECCAK256_RATE-1UL ] |= (uchar)0x80;
+
+    batch_tail_data[ batch_idx ] = (ulong)tail_data;
+    batch_block_cnt[ batch_idx ] = sz/FD_KECCAK256_RATE + 1UL;
+  }
+
+  wwv_t s[25];
+  for( ulong i=0UL; i<25UL; i++ ) s[i] = wwv_zero();
+
+  wwv_t zero       = wwv_zero();
+  wwv_t one        = wwv_one();
+  wwv_t wwv_rate   = wwv_bcast( FD_KECCAK256_RATE );
+  wwv_t W_sentinel = wwv_bcast( (ulong)scratch );
+
+  wwv_t tail       = wwv_ld( batch_tail_data );
+  wwv_t W          = wwv_ld( batch_data      );
+  wwv_t block_rem  = wwv_if( (1<<batch_cnt)-1, wwv_ld( batch_block_cnt ), zero );
+  for(;;) {
+    int active_lane = wwv_ne( block_rem, zero );
+    if( FD_UNLIKELY( !active_lane ) ) break;
+
+    /* Switch lanes that are at their last block to their tail block */
+
+    W = wwv_if( wwv_eq( block_rem, one ), tail, W );
+
+    /* Load the next block of each active lane.  Inactive lanes load
+       garbage from a sentinel location (and the state updates of
+       inactive lanes are discarded below). */
+
+    ulong _W0; ulong _W1; ulong _W2; ulong _W3; ulong _W4; ulong _W5; ulong _W6; ulong _W7;
+    wwv_unpack( wwv_if( active_lane, W, W_sentinel ), _W0,_W1,_W2,_W3,_W4,_W5,_W6,_W7 );
+    ulong const * W0 = (ulong const *)_W0; ulong const * W1 = (ulong const *)_W1;
+    ulong const * W2 = (ulong const *)_W2; ulong const * W3 = (ulong const *)_W3;
+    ulong const * W4 = (ulong const *)_W4; ulong const * W5 = (ulong const *)_W5;
+    ulong const * W6 = (ulong const *)_W6; ulong const * W7 = (ulong const *)_W7;
+
+    wwv_t t[25];
+    for( ulong i=0UL; i<16UL; i+=8UL ) {
+      wwv_t x0; wwv_t x1; wwv_t x2; wwv_t x3; wwv_t x4; wwv_t x5; wwv_t x6; wwv_t x7;
+      wwv_transpose_8x8( wwv_ldu( W0+i ), wwv_ldu( W1+i ), wwv_ldu( W2+i ), wwv_ldu( W3+i ),
+                         wwv_ldu( W4+i ), wwv_ldu( W5+i ), wwv_ldu( W6+i ), wwv_ldu( W7+i ), x0, x1, x2, x3, x4, x5, x6, x7 );
+      t[i    ] = wwv_xor( s[i    ], x0 );
+      t[i+1UL] = wwv_xor( s[i+1UL], x1 );
+      t[i+2UL] = wwv_xor( s[i+2UL], x2 );
+      t[i+3UL] = wwv_xor( s[i+3UL], x3 );
+      t[i+4UL] = wwv_xor( s[i+4UL], x4 );
+      t[i+5UL] = wwv_xor( s[i+5UL], x5 );
+      t[i+6UL] = wwv_xor( s[i+6UL], x6 );
+      t[i+7UL] = wwv_xor( s[i+7UL], x7 );
+    }
+    t[16] = wwv_xor( s[16], wwv( FD_LOAD( ulong, W0+16 ), FD_LOAD( ulong, W1+16 ), FD_LOAD( ulong, W2+16 ), FD_LOAD( ulong, W3+16 ),
+                                 FD_LOAD( ulong, W4+16 ), FD_LOAD( ulong, W5+16 ), FD_LOAD( ulong, W6+16 ), FD_LOAD( ulong, W7+16 ) ) );
+    for( ulong i=17UL; i<25UL; i++ ) t[i] = s[i];
+
+    FD_KECCAK256_PRIVATE_F1600( wwv_t, wwv_xor, wwv_rol, FD_KECCAK256_PRIVATE_CHI, wwv_bcast, t );
+
+    /* Apply the state updates to the active lanes */
+
+    for( ulong i=0UL; i<25UL; i++ ) s[i] = wwv_if( active_lane, t[i], s[i] );
+
+    /* Advance to the next blocks (W of inactive lanes is never loaded) */
+
+    W = wwv_add( W, wwv_rate );
+    block_rem = wwv_sub_if( active_lane, block_rem, one, block_rem );
+  }
+
+  /* The hash is the first 4 words of the state.  After the transpose,
+     the low 256 bits of row i hold the hash of message i. */
+
+  wwv_t h0; wwv_t h1; wwv_t h2; wwv_t h3; wwv_t h4; wwv_t h5; wwv_t h6; wwv_t h7;
+  wwv_transpose_8x8( s[0],s[1],s[2],s[3], zero,zero,zero,zero, h0,h1,h2,h3,h4,h5,h6,h7 );
+
+  ulong * const * batch_hash = (ulong * const *)_batch_hash;
+  switch( batch_cnt ) { /* application dependent prob */
+  case 8UL: wv_stu( batch_hash[7], _mm512_castsi512_si256( h7 ) ); __attribute__((fallthrough));
+  case 7UL: wv_stu( batch_hash[6], _mm512_castsi512_si256( h6 ) ); __attribute__((fallthrough));
+  case 6UL: wv_stu( batch_hash[5], _mm512_castsi512_si256( h5 ) ); __attribute__((fallthrough));
+  case 5UL: wv_stu( batch_hash[4], _mm512_castsi512_si256( h4 ) ); __attribute__((fallthrough));
+  case 4UL: wv_stu( batch_hash[3], _mm512_castsi512_si256( h3 ) ); __attribute__((fallthrough));
+  case 3UL: wv_stu( batch_hash[2], _mm512_castsi512_si256( h2 ) ); __attribute__((fallthrough));
+  case 2UL: wv_stu( batch_hash[1], _mm512_castsi512_si256( h1 ) ); __attribute__((fallthrough));
+  case 1UL: wv_stu( batch_hash[0], _mm512_castsi512_si256( h0 ) ); __attribute__((fallthrough));
+  default: break;
+  }
+}
+
+#undef FD_KECCAK256_PRIVATE_CHI
@@ -10,87 +10,109 @@ FD_PROTOTYPES_BEGIN
 
    https://keccak.team/keccak_specs_summary.html
 
-   It is straightforward to replace these implementations with HPC
-   implementations that target specific machine capabilities without
-   requiring any changes to caller code. */
+   FD_KECCAK256_PRIVATE_F1600 applies the Keccak-f[1600] permutation to
+   the state s, an array of 25 T indexed x+5*y.  T is either ulong (one
+   state) or a SIMD vector of ulong (one independent state per vector
+   lane, as used by the batch implementations).  XOR(a,b) returns a^b,
+   ROL(a,n) returns a rotated left by the compile time constant n in
+   [1,63], CHI(a,b,c) returns a^(~b&c) and BCAST(x) returns a T with x
+   in every lane.  Each round is fully unrolled with theta, rho and pi
+   fused into a single pass over the state (roughly twice as fast as
+   the loop based version in the spec). */
+
+#define FD_KECCAK256_PRIVATE_F1600( T, XOR, ROL, CHI, BCAST, s ) do {                           \
+    static ulong const _fd_keccak256_rc[24] = {                                                 \
+      0x0000000000000001UL, 0x0000000000008082UL, 0x800000000000808AUL, 0x8000000080008000UL,   \
+      0x000000000000808BUL, 0x0000000080000001UL, 0x8000000080008081UL, 0x8000000000008009UL,   \
+      0x000000000000008AUL, 0x0000000000000088UL, 0x0000000080008009UL, 0x000000008000000AUL,   \
+      0x000000008000808BUL, 0x800000000000008BUL, 0x8000000000008089UL, 0x8000000000008003UL,   \
+      0x8000000000008002UL, 0x8000000000000080UL, 0x000000000000800AUL, 0x800000008000000AUL,   \
+      0x8000000080008081UL, 0x8000000000008080UL, 0x0000000080000001UL, 0x8000000080008008UL    \
+    };                                                                                          \
+    for( ulong _round=0UL; _round<24UL; _round++ ) {                                            \
+      T c0 = XOR( XOR( XOR( s[ 0], s[ 5] ), XOR( s[10], s[15] ) ), s[20] );                     \
+      T c1 = XOR( XOR( XOR( s[ 1], s[ 6] ), XOR( s[11], s[16] ) ), s[21] );                     \
+      T c2 = XOR( XOR( XOR( s[ 2], s[ 7] ), XOR( s[12], s[17] ) ), s[22] );                     \
+      T c3 = XOR( XOR( XOR( s[ 3], s[ 8] ), XOR( s[13], s[18] ) ), s[23] );                     \
+      T c4 = XOR( XOR( XOR( s[ 4], s[ 9] ), XOR( s[14], s[19] ) ), s[24] );                     \
+      T d0 = XOR( c4, ROL( c1, 1 ) );                                                           \
+      T d1 = XOR( c0, ROL( c2, 1 ) );                                                           \
+      T d2 = XOR( c1, ROL( c3, 1 ) );                                                           \
+      T d3 = XOR( c2, ROL( c4, 1 ) );                                                           \
+      T d4 = XOR( c3, ROL( c0, 1 ) );                                                           \
+      T b0  = XOR( s[ 0], d0 );                                                                 \
+      T b1  = ROL( XOR( s[ 6], d1 ), 44 );                                                      \
+      T b2  = ROL( XOR( s[12], d2 ), 43 );                                                      \
+      T b3  = ROL( XOR( s[18], d3 ), 21 );                                                      \
+      T b4  = ROL( XOR( s[24], d4 ), 14 );                                                      \
+      T b5  = ROL( XOR( s[ 3], d3 ), 28 );                                                      \
+      T b6  = ROL( XOR( s[ 9], d4 ), 20 );                                                      \
+      T b7  = ROL( XOR( s[10], d0 ),  3 );                                                      \
+      T b8  = ROL( XOR( s[16], d1 ), 45 );                                                      \
+      T b9  = ROL( XOR( s[22], d2 ), 61 );                                                      \
+      T b10 = ROL( XOR( s[ 1], d1 ),  1 );                                                      \
+      T b11 = ROL( XOR( s[ 7], d2 ),  6 );                                                      \
+      T b12 = ROL( XOR( s[13], d3 ), 25 );                                                      \
+      T b13 = ROL( XOR( s[19], d4 ),  8 );                                                      \
+      T b14 = ROL( XOR( s[20], d0 ), 18 );                                                      \
+      T b15 = ROL( XOR( s[ 4], d4 ), 27 );                                                      \
+      T b16 = ROL( XOR( s[ 5], d0 ), 36 );                                                      \
+      T b17 = ROL( XOR( s[11], d1 ), 10 );                                                      \
+      T b18 = ROL( XOR( s[17], d2 ), 15 );                                                      \
+      T b19 = ROL( XOR( s[23], d3 ), 56 );                                                      \
+      T b20 = ROL( XOR( s[ 2], d2 ), 62 );                                                      \
+      T b21 = ROL( XOR( s[ 8], d3 ), 55 );                                                      \
+      T b22 = ROL( XOR( s[14], d4 ), 39 );                                                      \
+      T b23 = ROL( XOR( s[15], d0 ), 41 );                                                      \
+      T b24 = ROL( XOR( s[21], d1 ),  2 );                                                      \
+      s[ 0] = CHI( b0 , b1 , b2  );                                                             \
+      s[ 1] = CHI( b1 , b2 , b3  );                                                             \
+      s[ 2] = CHI( b2 , b3 , b4  );                                                             \
+      s[ 3] = CHI( b3 , b4 , b0  );                                                             \
+      s[ 4] = CHI( b4 , b0 , b1  );                                                             \
+      s[ 5] = CHI( b5 , b6 , b7  );                                                             \
+      s[ 6] = CHI( b6 , b7 , b8  );                                                             \
+      s[ 7] = CHI( b7 , b8 , b9  );                                                             \
+      s[ 8] = CHI( b8 , b9 , b5  );                                                             \
+      s[ 9] = CHI( b9 , b5 , b6  );                                                             \
+      s[10] = CHI( b10, b11, b12 );                                                             \
+      s[11] = CHI( b11, b12, b13 );                                                             \
+      s[12] = CHI( b12, b13, b14 );                                                             \
+      s[13] = CHI( b13, b14, b10 );                                                             \
+      s[14] = CHI( b14, b10, b11 );                                                             \
+      s[15] = CHI( b15, b16, b17 );                                                             \
+      s[16] = CHI( b16, b17, b18 );                                                             \
+      s[17] = CHI( b17, b18, b19 );                                                             \
+      s[18] = CHI( b18, b19, b15 );                                                             \
+      s[19] = CHI( b19, b15, b16 );                                                             \
+      s[20] = CHI( b20, b21, b22 );                                                             \
+      s[21] = CHI( b21, b22, b23 );                                                             \
+      s[22] = CHI( b22, b23, b24 );                                                             \
+      s[23] = CHI( b23, b24, b20 );                                                             \
+      s[24] = CHI( b24, b20, b21 );                                                             \
+      s[ 0] = XOR( s[0], BCAST( _fd_keccak256_rc[ _round ] ) );                                 \
+    }                                                                                           \
+  } while(0)
+
+#define FD_KECCAK256_PRIVATE_XOR(a,b)   ((a)^(b))
+#define FD_KECCAK256_PRIVATE_ROL(a,n)   fd_ulong_rotate_left( (a), (n) )
+#define FD_KECCAK256_PRIVATE_CHI(a,b,c) ((a)^((~(b))&(c)))
+#define FD_KECCAK256_PRIVATE_BCAST(x)   (x)
 
 static inline void
 fd_keccak256_core( ulong * state ) {
- ulong const round_consts[24] = {
-    0x0000000000000001UL, 0x0000000000008082UL, 0x800000000000808AUL, 0x8000000080008000UL,
-    0x000000000000808BUL, 0x0000000080000001UL, 0x8000000080008081UL, 0x8000000000008009UL,
-    0x000000000000008AUL, 0x0000000000000088UL, 0x0000000080008009UL, 0x000000008000000AUL,
-    0x000000008000808BUL, 0x800000000000008BUL, 0x8000000000008089UL, 0x8000000000008003UL,
-    0x8000000000008002UL, 0x8000000000000080UL, 0x000000000000800AUL, 0x800000008000000AUL,
-    0x8000000080008081UL, 0x8000000000008080UL, 0x0000000080000001UL, 0x8000000080008008UL
-  };
-
-  static uchar const rho_consts[24] = {
-    1,  3,   6, 10,
-    15, 21, 28, 36,
-    45, 55,  2, 14,
-    27, 41, 56,  8,
-    25, 43, 62, 18,
-    39, 61, 20, 44
-  };
-
-  static uchar const pi_consts[24] = {
-    10,  7, 11, 17,
-    18,  3,  5, 16,
-     8, 21, 24,  4,
-    15, 23, 19, 13,
-    12,  2, 20, 14,
-    22,  9,  6,  1
-  };
-
-# define NUM_ROUNDS (24)
-# define ROTATE     fd_ulong_rotate_left
-
-  ulong b[5];
-  ulong t;
-
-  for( ulong round = 0; round < NUM_ROUNDS; round++ ) {
-    // Theta step
-    for( ulong i = 0; i < 5; i++ ) {
-      b[i] = (state[i] ^ state[i+5] ^ state[i+10] ^ state[i+15] ^ state[i+20]);
-    }
-
-    for( ulong i = 0; i < 5; i++ ) {
-      t = b[(i+4) % 5] ^ ROTATE(b[(i+1) % 5], 1);
-
-      for( ulong j = 0; j < 25; j += 5 ) {
-        state[i+j] ^= t;
-      }
-    }
-
-    // Rho and pi steps
-    t = state[1];
-    for( ulong i = 0; i < 24; i++ ) {
-      ulong pi_val = pi_consts[i];
-      int rho_val = rho_consts[i];
-      b[0] = state[pi_val];
-      state[pi_val] = ROTATE(t, rho_val);
-      t = b[0];
-    }
-
-    // Chi step
-    for( ulong i = 0; i < 25; i += 5 ) {
-      for( ulong j = 0; j < 5; j++ ) {
-        b[j] = state[i+j];
-      }
-      for( ulong j = 0; j < 5; j++ ) {
-        state[i+j] ^= (~b[(j+1) % 5]) & (b[(j+2) % 5]);
-      }
-    }
-
-    // Iota step
-    state[0] ^= round_consts[round];
-  }
-
-# undef NUM_ROUNDS
-# undef ROTATE
+  ulong s[25];
+  for( ulong i=0UL; i<25UL; i++ ) s[i] = state[i];
+  FD_KECCAK256_PRIVATE_F1600( ulong, FD_KECCAK256_PRIVATE_XOR, FD_KECCAK256_PRIVATE_ROL,
+                              FD_KECCAK256_PRIVATE_CHI, FD_KECCAK256_PRIVATE_BCAST, s );
+  for( ulong i=0UL; i<25UL; i++ ) state[i] = s[i];
 }
 
+#undef FD_KECCAK256_PRIVATE_XOR
+#undef FD_KECCAK256_PRIVATE_ROL
+#undef FD_KECCAK256_PRIVATE_CHI
+#undef FD_KECCAK256_PRIVATE_BCAST
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_keccak256_fd_keccak256_private_h */
@@ -2,8 +2,6 @@
 
 /* Basic UTF-8 validator imported from Rust's core/src/str/validations.rs */
 
-/* FIXME: Add high-performance AVX version */
-
 static uchar const fd_utf8_char_width[ 256 ] = {
   // 1  2  3  4  5  6  7  8  9  A  B  C  D  E  F
   1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0
@@ -25,8 +23,8 @@ static uchar const fd_utf8_char_width[ 256 ] = {
 };
 
 FD_FN_PURE int
-fd_utf8_verify( char const * str,
-                ulong        sz ) {
+fd_utf8_verify_ref( char const * str,
+                    ulong        sz ) {
 
   uchar const *       cur = (uchar const *)str;
   if( FD_UNLIKELY( cur==NULL ) ) {
@@ -84,3 +82,224 @@ fd_utf8_verify( char const * str,
 
   return 1;
 }
+
+#if FD_HAS_AVX
+
+/* SIMD validator, see:
+
+     Keiser, Lemire. "Validating UTF-8 In Less Than One Instruction Per
+     Byte" (2020), https://arxiv.org/abs/2010.03090
+
+   Every error in a UTF-8 string can be detected by looking at each
+   pair of adjacent bytes (via 3 nibble lookup tables, one per nibble
+   of the pair), except for missing/excess continuation bytes of 3 and
+   4 byte sequences, which are detected by the bytes 2 and 3 positions
+   back.  A truncated sequence at the end of the input is detected by
+   appending zero bytes (a zero byte is a valid code point, and cannot
+   be a continuation byte). */
+
+#include "../../util/simd/fd_avx.h"
+
+/* Error classes of a pair of adjacent bytes */
+
+#define TOO_SHORT      (1<<0) /* 11______ 0_______, 11______ 11______ */
+#define TOO_LONG       (1<<1) /* 0_______ 10______ */
+#define OVERLONG_3     (1<<2) /* 11100000 100_____ */
+#define TOO_LARGE      (1<<3) /* 11110100 1001____, 11110100 101_____, 11110101+ 1001____, 11110101+ 101_____ */
+#define SURROGATE      (1<<4) /* 11101101 101_____ */
+#define OVERLONG_2     (1<<5) /* 1100000_ 10______ */
+#define TOO_LARGE_1000 (1<<6) /* 11110101+ 1000____ */
+#define OVERLONG_4     (1<<6) /* 11110000 1000____ */
+#define TWO_CONTS      (1<<7) /* 10______ 10______ (an error unless part of a 3 or 4 byte sequence) */
+#define CARRY          (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+/* Lookup tables from the high nibble of the first byte, the low nibble
+   of the first byte and the high nibble of the second byte of a pair
+   to the error classes the pair can be in */
+
+#define FD_UTF8_LUT_BYTE_1_HIGH                                      \
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,                            \
+  TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,                            \
+  TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,                        \
+  TOO_SHORT | OVERLONG_2,                                            \
+  TOO_SHORT,                                                         \
+  TOO_SHORT | OVERLONG_3 | SURROGATE,                                \
+  TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+
+#define FD_UTF8_LUT_BYTE_1_LOW                                       \
+  CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,                      \
+  CARRY | OVERLONG_2,                                                \
+  CARRY,                                                             \
+  CARRY,                                                             \
+  CARRY | TOO_LARGE,                                                 \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,                    \
+  CARRY | TOO_LARGE | TOO_LARGE_1000,                                \
+  CARRY | TOO_LARGE | TOO_LARGE_1000
+
+#define FD_UTF8_LUT_BYTE_2_HIGH                                      \
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,                        \
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,                        \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4, \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,        \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,        \
+  TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE  | TOO_LARGE,        \
+  TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+
+/* fd_utf8_check_avx returns a non-zero vector if the 32 bytes x
+   (preceded by the 32 bytes prev) contain an error */
+
+static inline wb_t
+fd_utf8_check_avx( wb_t x,
+                   wb_t prev ) {
+  wb_t t     = _mm256_permute2x128_si256( prev, x, 0x21 );
+  wb_t prev1 = _mm256_alignr_epi8( x, t, 15 );
+  wb_t prev2 = _mm256_alignr_epi8( x, t, 14 );
+  wb_t prev3 = _mm256_alignr_epi8( x, t, 13 );
+
+  wb_t special = wb_and( wb_and( _mm256_shuffle_epi8( wb_bcast_hex( FD_UTF8_LUT_BYTE_1_HIGH ), wb_shr( prev1, 4 ) ),
+                                 _mm256_shuffle_epi8( wb_bcast_hex( FD_UTF8_LUT_BYTE_1_LOW  ), wb_and( prev1, wb_bcast( 0x0f ) ) ) ),
+                                 _mm256_shuffle_epi8( wb_bcast_hex( FD_UTF8_LUT_BYTE_2_HIGH ), wb_shr( x, 4 ) ) );
+
+  /* Bytes 2 and 3 positions after a 3 and 4 byte lead resp. must be
+     continuations (i.e. exactly the pairs flagged TWO_CONTS) */
+
+  wb_t must23 = wb_and( wb_or( _mm256_subs_epu8( prev2, wb_bcast( 0xe0-0x80 ) ),
+                               _mm256_subs_epu8( prev3, wb_bcast( 0xf0-0x80 ) ) ), wb_bcast( 0x80 ) );
+  return wb_xor( must23, special );
+}
+
+/* fd_utf8_incomplete_avx returns a non-zero vector if the 32 bytes x
+   end with an incomplete sequence */
+
+static inline wb_t
+fd_utf8_incomplete_avx( wb_t x ) {
+  return _mm256_subs_epu8( x, _mm256_setr_epi8( -1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1,-1,-1,-1,
+                                                -1,-1,-1,-1,-1,-1,-1,-1, -1,-1,-1,-1,-1, (char)(0xf0-1), (char)(0xe0-1), (char)(0xc0-1) ) );
+}
+
+#if FD_HAS_AVX512
+
+#include "../../util/simd/fd_avx512.h"
+
+/* AVX-512 variants of the above, 64 bytes at a time */
+
+static inline __m512i
+fd_utf8_check_avx512( __m512i x,
+                      __m512i prev ) {
+  __m512i idx   = _mm512_set_epi8( 126,125,124,123,122,121,120,119,118,117,116,115,114,113,112,111,
+                                   110,109,108,107,106,105,104,103,102,101,100, 99, 98, 97, 96, 95,
+                                    94, 93, 92, 91, 90, 89, 88, 87, 86, 85, 84, 83, 82, 81, 80, 79,
+                                    78, 77, 76, 75, 74, 73, 72, 71, 70, 69, 68, 67, 66, 65, 64, 63 );
+  __m512i one   = _mm512_set1_epi8( 1 );
+  __m512i prev1 = _mm512_permutex2var_epi8( prev, idx, x ); idx = _mm512_sub_epi8( idx, one );
+  __m512i prev2 = _mm512_permutex2var_epi8( prev, idx, x ); idx = _mm512_sub_epi8( idx, one );
+  __m512i prev3 = _mm512_permutex2var_epi8( prev, idx, x );
+
+  __m512i lo = _mm512_set1_epi8( 0x0f );
+  __m512i special =
+    _mm512_and_si512( _mm512_and_si512(
+      _mm512_shuffle_epi8( _mm512_broadcast_i64x4( wb_bcast_hex( FD_UTF8_LUT_BYTE_1_HIGH ) ), _mm512_and_si512( _mm512_srli_epi16( prev1, 4 ), lo ) ),
+      _mm512_shuffle_epi8( _mm512_broadcast_i64x4( wb_bcast_hex( FD_UTF8_LUT_BYTE_1_LOW  ) ), _mm512_and_si512( prev1, lo ) ) ),
+      _mm512_shuffle_epi8( _mm512_broadcast_i64x4( wb_bcast_hex( FD_UTF8_LUT_BYTE_2_HIGH ) ), _mm512_and_si512( _mm512_srli_epi16( x, 4 ), lo ) ) );
+
+  __m512i must23 = _mm512_and_si512( _mm512_or_si512( _mm512_subs_epu8( prev2, _mm512_set1_epi8( 0xe0-0x80 ) ),
+                                                      _mm512_subs_epu8( prev3, _mm512_set1_epi8( 0xf0-0x80 ) ) ),
+                                     _mm512_set1_epi8( (char)0x80 ) );
+  return _mm512_xor_si512( must23, special );
+}
+
+static int
+fd_utf8_verify_avx512( uchar const * cur,
+                       ulong         sz ) {
+  __m512i max  = _mm512_mask_blend_epi64( 0x80, _mm512_set1_epi8( -1 ),
+                                          _mm512_set1_epi64( (long)0xbfdfefffffffffffUL ) );
+  __m512i prev = _mm512_setzero_si512();
+  __m512i err  = _mm512_setzero_si512();
+  __m512i inc  = _mm512_setzero_si512();
+  for( ulong off=0UL; off<sz; off+=64UL ) {
+    /* The tail block is zero padded */
+    __m512i x = _mm512_maskz_loadu_epi8( fd_ulong_mask_lsb( (int)fd_ulong_min( sz-off, 64UL ) ), cur+off );
+    if( FD_LIKELY( !_mm512_movepi8_mask( x ) ) ) {
+      /* ASCII block: only a sequence incomplete at the end of the
+         previous block could be an error */
+      err = _mm512_or_si512( err, inc );
+      inc = _mm512_setzero_si512();
+    } else {
+      err = _mm512_or_si512( err, fd_utf8_check_avx512( x, prev ) );
+      inc = _mm512_subs_epu8( x, max );
+    }
+    prev = x;
+  }
+  err = _mm512_or_si512( err, inc );
+  return !_mm512_test_epi8_mask( err, err );
+}
+
+#endif /* FD_HAS_AVX512 */
+
+static int
+fd_utf8_verify_avx( uchar const * cur,
+                    ulong         sz ) {
+  wb_t prev = wb_zero();
+  wb_t err  = wb_zero();
+  wb_t inc  = wb_zero();
+  for( ulong off=0UL; off<sz; off+=32UL ) {
+    wb_t x;
+    if( FD_LIKELY( sz-off>=32UL ) ) {
+      x = wb_ldu( cur+off );
+    } else { /* The tail block is zero padded */
+      uchar tail[ 32 ] __attribute__((aligned(32)));
+      wb_st( tail, wb_zero() );
+      fd_memcpy( tail, cur+off, sz-off );
+      x = wb_ld( tail );
+    }
+    if( FD_LIKELY( !_mm256_movemask_epi8( x ) ) ) {
+      /* ASCII block: only a sequence incomplete at the end of the
+         previous block could be an error */
+      err = wb_or( err, inc );
+      inc = wb_zero();
+    } else {
+      err = wb_or( err, fd_utf8_check_avx( x, prev ) );
+      inc = fd_utf8_incomplete_avx( x );
+    }
+    prev = x;
+  }
+  err = wb_or( err, inc );
+  return _mm256_testz_si256( err, err );
+}
+
+#undef FD_UTF8_LUT_BYTE_2_HIGH
+#undef FD_UTF8_LUT_BYTE_1_LOW
+#undef FD_UTF8_LUT_BYTE_1_HIGH
+#undef CARRY
+#undef TWO_CONTS
+#undef OVERLONG_4
+#undef TOO_LARGE_1000
+#undef OVERLONG_2
+#undef SURROGATE
+#undef TOO_LARGE
+#undef OVERLONG_3
+#undef TOO_LONG
+#undef TOO_SHORT
+
+#endif /* FD_HAS_AVX */
+
+FD_FN_PURE int
+fd_utf8_verify( char const * str,
+                ulong        sz ) {
+  if( FD_UNLIKELY( !str ) ) return 1;
+# if FD_HAS_AVX512
+  if( sz>=64UL ) return fd_utf8_verify_avx512( (uchar const *)str, sz );
+# endif
+# if FD_HAS_AVX
+  if( sz>=32UL ) return fd_utf8_verify_avx   ( (uchar const *)str, sz );
+# endif
+  return fd_utf8_verify_ref( str, sz );
+}
@@ -40,6 +40,14 @@ FD_FN_PURE int
 fd_utf8_verify( char const * str,
                 ulong        sz );
 
+/* fd_utf8_verify_ref is a portable scalar implementation of the above
+   with identical semantics.  On targets with AVX, fd_utf8_verify uses
+   SIMD kernels for all but short strings.  Exposed for testing. */
+
+FD_FN_PURE int
+fd_utf8_verify_ref( char const * str,
+                    ulong        sz );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_ballet_utf8_fd_utf8_h */
@@ -0,0 +1,41 @@
+#if !FD_HAS_HOSTED
+#error "This target requires FD_HAS_HOSTED"
+#endif
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../../util/fd_util.h"
+#include "../../util/sanitize/fd_fuzz.h"
+#include "fd_utf8.h"
+
+/* fuzz_utf8 verifies that UTF-8 validation matches the scalar
+   reference. */
+
+int
+LLVMFuzzerInitialize( int  *   argc,
+                      char *** argv ) {
+  /* Set up shell without signal handlers */
+  putenv( "FD_LOG_BACKTRACE=0" );
+  fd_boot( argc, argv );
+  atexit( fd_halt );
+  fd_log_level_core_set(3); /* crash on warning log */
+  return 0;
+}
+
+int
+LLVMFuzzerTestOneInput( uchar const * data,
+                        ulong         data_sz ) {
+
+  int res = fd_utf8_verify( (char const *)data, data_sz );
+  assert( res==fd_utf8_verify_ref( (char const *)data, data_sz ) );
+  if( res ) {
+    FD_FUZZ_MUST_BE_COVERED;
+  } else {
+    FD_FUZZ_MUST_BE_COVERED;
+  }
+
+  FD_FUZZ_MUST_BE_COVERED;
+  return 0;
+}
@@ -94,6 +94,60 @@ main( int     argc,
   uchar oob4[3] = { (uchar)0xf0, (uchar)0x90, (uchar)0x80 };
   FD_TEST( !fd_utf8_verify( (char const *)oob4, 3 ) );
 
+  /* SIMD kernels vs scalar reference.  All 3 byte sequences, placed
+     across a block boundary, and at the end of the input. */
+
+  static uchar buf[ 512 ];
+  fd_memset( buf, 'a', sizeof(buf) );
+  for( uint j=0U; j<(1U<<24); j++ ) {
+    buf[ 62 ] = (uchar)j; buf[ 63 ] = (uchar)(j>>8); buf[ 64 ] = (uchar)(j>>16);
+    FD_TEST( fd_utf8_verify( (char const *)buf, 96UL )==fd_utf8_verify_ref( (char const *)buf, 96UL ) );
+    FD_TEST( fd_utf8_verify( (char const *)buf, 65UL )==fd_utf8_verify_ref( (char const *)buf, 65UL ) );
+  }
+
+  /* Random strings of random code points (and a few random bytes) */
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  ulong valid_cnt = 0UL;
+  for( ulong iter=0UL; iter<200000UL; iter++ ) {
+    ulong sz = fd_rng_ulong_roll( rng, sizeof(buf)+1UL );
+    ulong i  = 0UL;
+    while( i<sz ) {
+      uint  cp = fd_rng_uint_roll( rng, 0x110000U );
+      if( fd_rng_uint_roll( rng, 2U ) ) cp &= 0x7fU; /* Mostly ASCII */
+      if( cp>=0xd800U && cp<0xe000U ) cp = 'b';
+      uchar c[4]; ulong c_sz;
+      if(      cp<0x80U    ) { c[0] = (uchar)cp; c_sz = 1UL; }
+      else if( cp<0x800U   ) { c[0] = (uchar)(0xc0U|(cp>>6));  c[1] = (uchar)(0x80U|(cp&0x3fU)); c_sz = 2UL; }
+      else if( cp<0x10000U ) { c[0] = (uchar)(0xe0U|(cp>>12)); c[1] = (uchar)(0x80U|((cp>>6)&0x3fU)); c[2] = (uchar)(0x80U|(cp&0x3fU)); c_sz = 3UL; }
+      else                   { c[0] = (uchar)(0xf0U|(cp>>18)); c[1] = (uchar)(0x80U|((cp>>12)&0x3fU)); c[2] = (uchar)(0x80U|((cp>>6)&0x3fU)); c[3] = (uchar)(0x80U|(cp&0x3fU)); c_sz = 4UL; }
+      for( ulong k=0UL; k<c_sz && i<sz; k++ ) buf[ i++ ] = c[k];
+    }
+    ulong err_cnt = fd_rng_ulong_roll( rng, 3UL );
+    for( ulong k=0UL; k<err_cnt && sz; k++ ) buf[ fd_rng_ulong_roll( rng, sz ) ] = fd_rng_uchar( rng );
+    int res = fd_utf8_verify_ref( (char const *)buf, sz );
+    FD_TEST( fd_utf8_verify( (char const *)buf, sz )==res );
+    valid_cnt += (ulong)res;
+  }
+  FD_TEST( valid_cnt>20000UL && valid_cnt<180000UL ); /* Both outcomes are covered */
+
+  /* Benchmarks */
+
+  for( ulong i=0UL; i<sizeof(buf); i++ ) buf[ i ] = (uchar)fd_rng_uint_roll( rng, 0x80U );
+  buf[ 100 ] = 0xc3; buf[ 101 ] = 0xbc;
+  for( int ref=0; ref<2; ref++ ) {
+    ulong iter = 1000000UL;
+    long  dt   = -fd_log_wallclock();
+    for( ulong rem=iter; rem; rem-- ) {
+      char const * str = (char const *)buf; FD_COMPILER_FORGET( str );
+      FD_TEST( ref ? fd_utf8_verify_ref( str, sizeof(buf) ) : fd_utf8_verify( str, sizeof(buf) ) );
+    }
+    dt += fd_log_wallclock();
+    FD_LOG_NOTICE(( "fd_utf8_verify%s: ~%6.3f Gbps / core", ref ? "_ref" : "", (double)(8UL*sizeof(buf)*iter) / (double)dt ));
+  }
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
   FD_LOG_NOTICE(( "pass" ));
   fd_halt();
   return 0;
@@ -14,7 +14,19 @@
 
    The dedup tile is simply a wrapper around the mux tile, that also
    checks the transaction signature field for duplicates and filters
-   them out. */
+   them out.
+
+   There can be multiple dedup tiles, in which case each one handles a
+   shard of the transactions (selected by a keyed hash of the first
+   signature, see fd_verify_dedup_sig and fd_verify_dedup_shard) with
+   its own tcache and output link.  All copies of a transaction land in
+   the same shard so they are still deduplicated against each other.  Every dedup tile reads every
+   verify link but skips other shards' frags in before_frag without
+   touching their payloads.  Verify publishes all bundle transactions
+   with a sig that maps to shard 0, so bundles stay in order on a single
+   stream.  Gossip and voter inputs are not published by verify, so
+   every dedup tile reads and parses them and keeps only its shard's
+   (these are low rate). */
 
 #define IN_KIND_GOSSIP (0UL)
 #define IN_KIND_VOTER  (1UL)
@@ -39,6 +51,9 @@ typedef struct {
   ulong * tcache_ring;
   ulong * tcache_map;
 
+  ulong * tcache_bkt;     /* == fd_tcache_bkt_bkt_laddr( tcache ) if a bucketized tcache is used instead (NULL if not) */
+  ulong   tcache_bkt_cnt;
+
   ulong             in_kind[ 64UL ];
   fd_dedup_in_ctx_t in[ 64UL ];
 
@@ -54,6 +69,10 @@ typedef struct {
 
   ulong       hashmap_seed;
 
+  ulong       shard_idx;  /* This tile handles the transactions with fd_verify_dedup_shard( ., shard_cnt )==shard_idx */
+  ulong       shard_cnt;  /* Number of dedup tiles */
+  ulong       shard_seed; /* Key of fd_verify_dedup_sig, shared with the verify tiles */
+
   struct {
     ulong bundle_peer_failure_cnt;
     ulong dedup_fail_cnt;
@@ -69,7 +88,8 @@ FD_FN_PURE static inline ulong
 scratch_footprint( fd_topo_tile_t const * tile ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
-  l = FD_LAYOUT_APPEND( l, fd_tcache_align(), fd_tcache_footprint( tile->dedup.tcache_depth, 0UL ) );
+  if( FD_UNLIKELY( tile->dedup.tcache_bkt ) ) l = FD_LAYOUT_APPEND( l, fd_tcache_bkt_align(), fd_tcache_bkt_footprint( tile->dedup.tcache_depth, 0UL ) );
+  else                                       l = FD_LAYOUT_APPEND( l, fd_tcache_align(),     fd_tcache_footprint    ( tile->dedup.tcache_depth, 0UL ) );
   return FD_LAYOUT_FINI( l, scratch_align() );
 }
 
@@ -79,6 +99,15 @@ metrics_write( fd_dedup_ctx_t * ctx ) {
   FD_MCNT_SET( DEDUP, TRANSACTION_DEDUP_FAILURE,       ctx->metrics.dedup_fail_cnt );
 }
 
+static inline int
+before_frag( fd_dedup_ctx_t * ctx,
+             ulong            in_idx,
+             ulong            seq,
+             ulong            sig ) {
+  (void)seq;
+  return (ctx->in_kind[ in_idx ]==IN_KIND_VERIFY) & (fd_verify_dedup_shard( sig, ctx->shard_cnt )!=ctx->shard_idx);
+}
+
 /* during_frag is called between pairs for sequence number checks, as
    we are reading incoming frags.  We don't actually need to copy the
    fragment here, flow control prevents it getting overrun, and
@@ -170,6 +199,9 @@ after_frag( fd_dedup_ctx_t *    ctx,
     txnm->txn_t_sz = (ushort)fd_txn_parse( fd_txn_m_payload( txnm ), txnm->payload_sz, txn, NULL );
     if( FD_UNLIKELY( !txnm->txn_t_sz ) ) FD_LOG_ERR(( "fd_txn_parse failed for vote transactions that should have been sigverified" ));
 
+    ulong shard_sig = fd_verify_dedup_sig( ctx->shard_seed, fd_txn_m_payload( txnm )+txn->signature_off );
+    if( FD_UNLIKELY( fd_verify_dedup_shard( shard_sig, ctx->shard_cnt )!=ctx->shard_idx ) ) return; /* Another dedup tile's */
+
     if( FD_UNLIKELY( ctx->in_kind[ in_idx ]==IN_KIND_GOSSIP ) ) FD_MCNT_INC( DEDUP, GOSSIPED_VOTES_RECEIVED, 1UL );
   }
 
@@ -178,7 +210,8 @@ after_frag( fd_dedup_ctx_t *    ctx,
     /* Compute fd_hash(signature) for dedup. */
     ulong ha_dedup_tag = fd_hash( ctx->hashmap_seed, fd_txn_m_payload( txnm )+txn->signature_off, 64UL );
 
-    FD_TCACHE_INSERT( is_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+    if( FD_UNLIKELY( ctx->tcache_bkt ) ) is_dup = fd_tcache_bkt_insert( ctx->tcache_bkt, ctx->tcache_bkt_cnt, ha_dedup_tag );
+    else FD_TCACHE_INSERT( is_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
   } else {
     /* Make sure bundles don't contain a duplicate transaction inside
        the bundle, which would not be valid. */
@@ -225,20 +258,44 @@ unprivileged_init( fd_topo_t *      topo,
 
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_dedup_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_dedup_ctx_t ), sizeof( fd_dedup_ctx_t ) );
-  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, fd_tcache_align(), fd_tcache_footprint( tile->dedup.tcache_depth, 0) ), tile->dedup.tcache_depth, 0 ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_new failed" ));
+  fd_tcache_t *     tcache     = NULL;
+  fd_tcache_bkt_t * tcache_bkt = NULL;
+  if( FD_UNLIKELY( tile->dedup.tcache_bkt ) ) {
+    tcache_bkt = fd_tcache_bkt_join( fd_tcache_bkt_new( FD_SCRATCH_ALLOC_APPEND( l, fd_tcache_bkt_align(), fd_tcache_bkt_footprint( tile->dedup.tcache_depth, 0UL ) ), tile->dedup.tcache_depth, 0UL ) );
+    if( FD_UNLIKELY( !tcache_bkt ) ) FD_LOG_ERR(( "fd_tcache_bkt_new failed" ));
+  } else {
+    tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, fd_tcache_align(), fd_tcache_footprint( tile->dedup.tcache_depth, 0) ), tile->dedup.tcache_depth, 0 ) );
+    if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_new failed" ));
+  }
 
   ctx->bundle_failed = 0;
   ctx->bundle_id     = 0UL;
   ctx->bundle_idx    = 0UL;
 
+  ctx->shard_cnt  = fd_topo_tile_name_cnt( topo, tile->name );
+  ctx->shard_idx  = tile->kind_id;
+  ctx->shard_seed = fd_pod_query_ulong( topo->props, "dedup_shard_seed", ULONG_MAX );
+  FD_TEST( ctx->shard_seed!=ULONG_MAX );
+
   memset( &ctx->metrics, 0, sizeof( ctx->metrics ) );
 
-  ctx->tcache_depth   = fd_tcache_depth       ( tcache );
-  ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
-  ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
-  ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+  if( FD_UNLIKELY( tcache_bkt ) ) {
+    ctx->tcache_depth   = 0UL;
+    ctx->tcache_map_cnt = 0UL;
+    ctx->tcache_sync    = NULL;
+    ctx->tcache_ring    = NULL;
+    ctx->tcache_map     = NULL;
+    ctx->tcache_bkt     = fd_tcache_bkt_bkt_laddr( tcache_bkt );
+    ctx->tcache_bkt_cnt = fd_tcache_bkt_bkt_cnt  ( tcache_bkt );
+  } else {
+    ctx->tcache_depth   = fd_tcache_depth       ( tcache );
+    ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
+    ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
+    ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
+    ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+    ctx->tcache_bkt     = NULL;
+    ctx->tcache_bkt_cnt = 0UL;
+  }
 
   FD_TEST( tile->in_cnt<=sizeof( ctx->in )/sizeof( ctx->in[ 0 ] ) );
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
@@ -305,6 +362,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 #define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_dedup_ctx_t)
 
 #define STEM_CALLBACK_METRICS_WRITE metrics_write
+#define STEM_CALLBACK_BEFORE_FRAG   before_frag
 #define STEM_CALLBACK_DURING_FRAG   during_frag
 #define STEM_CALLBACK_AFTER_FRAG    after_frag
 
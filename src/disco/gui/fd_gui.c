@@ -81,6 +81,7 @@ fd_gui_new( void *             shmem,
   gui->summary.net_tile_cnt    = fd_topo_tile_name_cnt( gui->topo, "net"    );
   gui->summary.quic_tile_cnt   = fd_topo_tile_name_cnt( gui->topo, "quic"   );
   gui->summary.verify_tile_cnt = fd_topo_tile_name_cnt( gui->topo, "verify" );
+  gui->summary.dedup_tile_cnt  = fd_topo_tile_name_cnt( gui->topo, "dedup"  );
   gui->summary.resolv_tile_cnt = fd_topo_tile_name_cnt( gui->topo, "resolv" );
   gui->summary.bank_tile_cnt   = fd_topo_tile_name_cnt( gui->topo, "bank"   );
   gui->summary.shred_tile_cnt  = fd_topo_tile_name_cnt( gui->topo, "shred"  );
@@ -337,11 +338,16 @@ fd_gui_txn_waterfall_snap( fd_gui_t *               gui,
   }
 
 
-  fd_topo_tile_t const * dedup = &topo->tiles[ fd_topo_find_tile( topo, "dedup", 0UL ) ];
-  volatile ulong const * dedup_metrics = fd_metrics_tile( dedup->metrics );
+  cur->out.dedup_duplicate = 0UL;
+  cur->in.gossip           = 0UL;
+  for( ulong i=0UL; i<gui->summary.dedup_tile_cnt; i++ ) {
+    fd_topo_tile_t const * dedup = &topo->tiles[ fd_topo_find_tile( topo, "dedup", i ) ];
+    volatile ulong const * dedup_metrics = fd_metrics_tile( dedup->metrics );
 
-  cur->out.dedup_duplicate = dedup_metrics[ MIDX( COUNTER, DEDUP, TRANSACTION_DEDUP_FAILURE ) ]
-                           + dedup_metrics[ MIDX( COUNTER, DEDUP, TRANSACTION_BUNDLE_PEER_FAILURE ) ];
+    cur->out.dedup_duplicate += dedup_metrics[ MIDX( COUNTER, DEDUP, TRANSACTION_DEDUP_FAILURE ) ]
+                              + dedup_metrics[ MIDX( COUNTER, DEDUP, TRANSACTION_BUNDLE_PEER_FAILURE ) ];
+    cur->in.gossip           += dedup_metrics[ MIDX( COUNTER, DEDUP, GOSSIPED_VOTES_RECEIVED ) ];
+  }
 
 
   cur->out.verify_overrun   = 0UL;
@@ -415,7 +421,6 @@ fd_gui_txn_waterfall_snap( fd_gui_t *               gui,
   }
 
   cur->in.pack_cranked = pack_metrics[ MIDX( COUNTER, PACK, BUNDLE_CRANK_STATUS_INSERTED ) ];
-  cur->in.gossip   = dedup_metrics[ MIDX( COUNTER, DEDUP, GOSSIPED_VOTES_RECEIVED ) ];
   cur->in.quic     = cur->out.tpu_quic_invalid +
                      cur->out.quic_overrun +
                      cur->out.quic_frag_drop +
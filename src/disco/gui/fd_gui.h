@@ -323,6 +323,7 @@ struct fd_gui {
     ulong net_tile_cnt;
     ulong quic_tile_cnt;
     ulong verify_tile_cnt;
+    ulong dedup_tile_cnt;
     ulong resolv_tile_cnt;
     ulong bank_tile_cnt;
     ulong shred_tile_cnt;
@@ -10,6 +10,7 @@
 #define DIST_COMPRESSION_LEVEL (19)
 
 #include <sys/socket.h> /* SOCK_CLOEXEC, SOCK_NONBLOCK needed for seccomp filter */
+#include <time.h> /* CLOCK_REALTIME needed for seccomp filter */
 #if defined(__aarch64__)
 #include "generated/fd_gui_tile.arm64_seccomp.h"
 #else
@@ -586,6 +587,7 @@ rlimit_file_cnt( fd_topo_t const *      topo FD_PARAM_UNUSED,
 
 fd_topo_run_tile_t fd_tile_gui = {
   .name                     = "gui",
+  .allow_idle_sleep         = 1,
   .rlimit_file_cnt_fn       = rlimit_file_cnt,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
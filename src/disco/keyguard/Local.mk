@@ -5,6 +5,8 @@ $(call add-objs,fd_keyguard_authorize fd_keyguard_match,fd_disco)
 
 $(call add-hdrs,fd_keyguard_client.h)
 $(call add-objs,fd_keyguard_client,fd_disco)
+$(call make-unit-test,test_keyguard_client,test_keyguard_client,fd_disco fd_tango fd_ballet fd_util)
+$(call run-unit-test,test_keyguard_client)
 
 ifdef FD_HAS_INT128
 $(call add-hdrs,fd_keyswitch.h)
@@ -6,11 +6,22 @@ fd_keyguard_client_new( void *         shmem,
                         uchar *          request_data,
                         fd_frag_meta_t * response_mcache,
                         uchar *          response_data ) {
+  ulong request_stride = fd_ulong_align_dn( fd_dcache_data_sz( request_data )/FD_KEYGUARD_CLIENT_INFLIGHT_MAX, FD_CHUNK_SZ );
+  if( FD_UNLIKELY( !request_stride ) ) {
+    FD_LOG_WARNING(( "request dcache too small (%lu bytes)", fd_dcache_data_sz( request_data ) ));
+    return NULL;
+  }
+  if( FD_UNLIKELY( fd_dcache_data_sz( response_data )<FD_KEYGUARD_CLIENT_INFLIGHT_MAX*64UL ) ) {
+    FD_LOG_WARNING(( "response dcache too small (%lu bytes)", fd_dcache_data_sz( response_data ) ));
+    return NULL;
+  }
+
   fd_keyguard_client_t * client = (fd_keyguard_client_t*)shmem;
-  client->request       = request_mcache;
-  client->request_depth = fd_mcache_depth( request_mcache );
-  client->request_seq   = 0UL;
-  client->request_data  = request_data;
+  client->request        = request_mcache;
+  client->request_depth  = fd_mcache_depth( request_mcache );
+  client->request_seq    = 0UL;
+  client->request_data   = request_data;
+  client->request_stride = request_stride;
 
   client->response       = response_mcache;
   client->response_depth = fd_mcache_depth( response_mcache );
@@ -19,31 +30,58 @@ fd_keyguard_client_new( void *         shmem,
   return shmem;
 }
 
-void
-fd_keyguard_client_sign( fd_keyguard_client_t * client,
-                         uchar *                signature,
-                         uchar const *          sign_data,
-                         ulong                  sign_data_len,
-                         int                    sign_type ) {
+ulong
+fd_keyguard_client_sign_submit( fd_keyguard_client_t * client,
+                                uchar const *          sign_data,
+                                ulong                  sign_data_len,
+                                int                    sign_type ) {
+  if( FD_UNLIKELY( fd_keyguard_client_inflight_cnt( client )>=FD_KEYGUARD_CLIENT_INFLIGHT_MAX ) ) {
+    FD_LOG_CRIT(( "too many sign requests in flight" ));
+  }
+  if( FD_UNLIKELY( sign_data_len>client->request_stride ) ) {
+    FD_LOG_CRIT(( "oversz sign request (%lu bytes, max %lu)", sign_data_len, client->request_stride ));
+  }
 
-  fd_memcpy( client->request_data, sign_data, sign_data_len );
+  ulong seq = client->request_seq;
+  ulong off = (seq & (FD_KEYGUARD_CLIENT_INFLIGHT_MAX-1UL))*client->request_stride;
+  fd_memcpy( client->request_data+off, sign_data, sign_data_len );
 
   ulong sig = (ulong)(uint)sign_type;
-  fd_mcache_publish( client->request, client->request_depth, client->request_seq, sig, 0UL, sign_data_len, 0UL, 0UL, 0UL );
-  client->request_seq = fd_seq_inc( client->request_seq, 1UL );
-
-  fd_frag_meta_t meta;
-  fd_frag_meta_t const * mline;
-  ulong seq_found;
-  long seq_diff;
-  ulong poll_max = ULONG_MAX;
-  FD_MCACHE_WAIT( &meta, mline, seq_found, seq_diff, poll_max, client->response, client->response_depth, client->response_seq );
-  if( FD_UNLIKELY( !poll_max ) ) FD_LOG_ERR(( "sign request timed out while polling" ));
+  fd_mcache_publish( client->request, client->request_depth, seq, sig, off>>FD_CHUNK_LG_SZ, sign_data_len, 0UL, 0UL, 0UL );
+  client->request_seq = fd_seq_inc( seq, 1UL );
+  return seq;
+}
+
+int
+fd_keyguard_client_sign_poll( fd_keyguard_client_t * client,
+                              uchar *                signature ) {
+  ulong seq = client->response_seq;
+  if( FD_UNLIKELY( seq==client->request_seq ) ) return 0; /* Nothing in flight */
+
+  fd_frag_meta_t const * mline = client->response + fd_mcache_line_idx( seq, client->response_depth );
+
+  ulong seq_found = fd_frag_meta_seq_query( mline );
+  long  seq_diff  = fd_seq_diff( seq_found, seq );
+  if( FD_LIKELY( seq_diff<0L ) ) return 0; /* Not answered yet */
   if( FD_UNLIKELY( seq_diff ) ) FD_LOG_ERR(( "sign request was overrun while polling" ));
 
-  fd_memcpy( signature, client->response_data, 64UL );
+  FD_COMPILER_MFENCE();
+  fd_memcpy( signature, client->response_data + (seq & (FD_KEYGUARD_CLIENT_INFLIGHT_MAX-1UL))*64UL, 64UL );
+  FD_COMPILER_MFENCE();
 
   seq_found = fd_frag_meta_seq_query( mline );
-  if( FD_UNLIKELY( fd_seq_ne( seq_found, client->response_seq ) ) ) FD_LOG_ERR(( "sign request was overrun while reading" ));
-  client->response_seq = fd_seq_inc( client->response_seq, 1UL );
+  if( FD_UNLIKELY( fd_seq_ne( seq_found, seq ) ) ) FD_LOG_ERR(( "sign request was overrun while reading" ));
+  client->response_seq = fd_seq_inc( seq, 1UL );
+  return 1;
+}
+
+void
+fd_keyguard_client_sign( fd_keyguard_client_t * client,
+                         uchar *                signature,
+                         uchar const *          sign_data,
+                         ulong                  sign_data_len,
+                         int                    sign_type ) {
+  if( FD_UNLIKELY( fd_keyguard_client_inflight_cnt( client ) ) ) FD_LOG_CRIT(( "sign requests in flight" ));
+  fd_keyguard_client_sign_submit( client, sign_data, sign_data_len, sign_type );
+  while( !fd_keyguard_client_sign_poll( client, signature ) ) FD_SPIN_PAUSE();
 }
@@ -1,8 +1,19 @@
 #ifndef HEADER_fd_src_disco_keyguard_fd_keyguard_client_h
 #define HEADER_fd_src_disco_keyguard_fd_keyguard_client_h
 
-/* A simple blocking client to a remote signing server, based on a pair
-   of (input, output) mcaches and data regions.
+/* A client to a remote signing server, based on a pair of (input,
+   output) mcaches and dcaches.  Requests can be made either blocking
+   (fd_keyguard_client_sign) or asynchronously, with up to
+   FD_KEYGUARD_CLIENT_INFLIGHT_MAX requests in flight at a time
+   (fd_keyguard_client_sign_{submit,poll}).
+
+   Request i is stored in slot i%FD_KEYGUARD_CLIENT_INFLIGHT_MAX of the
+   request dcache (the request frag's chunk is relative to the start of
+   the dcache data region) and its 64 byte signature is returned in slot
+   i%FD_KEYGUARD_CLIENT_INFLIGHT_MAX of the response dcache (slots of 64
+   bytes, the response frag's chunk is the slot index).  The server
+   answers the requests of a client in order, so a slot is never reused
+   while the request that last used it is still in flight.
 
    For maximum security, the caller should ensure a few things before
    using,
@@ -29,11 +40,19 @@
 #define FD_KEYGUARD_CLIENT_ALIGN (128UL)
 #define FD_KEYGUARD_CLIENT_FOOTPRINT (128UL)
 
+/* FD_KEYGUARD_CLIENT_INFLIGHT_MAX is the maximum number of requests a
+   client can have in flight.  A power of 2.  The request and response
+   dcaches of a client must have room for this many slots (links with a
+   depth of at least this many frags do). */
+
+#define FD_KEYGUARD_CLIENT_INFLIGHT_MAX (16UL)
+
 struct __attribute__((aligned(FD_KEYGUARD_CLIENT_ALIGN))) fd_keyguard_client {
   fd_frag_meta_t * request;
   ulong            request_seq;
   ulong            request_depth;
   uchar          * request_data;
+  ulong            request_stride; /* Bytes between request slots, a multiple of FD_CHUNK_SZ */
 
   fd_frag_meta_t * response;
   ulong            response_seq;
@@ -44,6 +63,13 @@ typedef struct fd_keyguard_client fd_keyguard_client_t;
 
 FD_PROTOTYPES_BEGIN
 
+/* fd_keyguard_client_new formats shmem as a client of the server
+   reading requests from request_mcache / request_data and answering on
+   response_mcache / response_data (request_data and response_data are
+   local joins to the dcaches).  Returns shmem on success and NULL if a
+   dcache is too small to hold FD_KEYGUARD_CLIENT_INFLIGHT_MAX slots
+   (logs details). */
+
 void *
 fd_keyguard_client_new( void *           shmem,
                         fd_frag_meta_t * request_mcache,
@@ -60,8 +86,17 @@ fd_keyguard_client_leave( fd_keyguard_client_t * client ) { return (void*)client
 static inline void *
 fd_keyguard_client_delete( void * shclient ) { return shclient; }
 
+/* fd_keyguard_client_inflight_cnt returns the number of requests
+   submitted whose response has not been polled yet. */
+
+FD_FN_PURE static inline ulong
+fd_keyguard_client_inflight_cnt( fd_keyguard_client_t const * client ) {
+  return (ulong)fd_seq_diff( client->request_seq, client->response_seq );
+}
+
 /* fd_keyguard_client_sign sends a remote signing request to the signing
-    server, and blocks (spins) until the response is received.
+    server, and blocks (spins) until the response is received.  There
+    should be no asynchronous requests in flight.
 
     Signing is treated as infallible, and there are no error codes or
     results. If the remote signer is stuck or not running, this function
@@ -87,6 +122,30 @@ fd_keyguard_client_sign( fd_keyguard_client_t * client,
                          ulong                  sign_data_len,
                          int                    sign_type );
 
+/* fd_keyguard_client_sign_submit sends a remote signing request like
+   fd_keyguard_client_sign but returns immediately.  sign_data is copied
+   out before return.  Returns the sequence number of the request (the
+   first request of a client is 0).  There must be fewer than
+   FD_KEYGUARD_CLIENT_INFLIGHT_MAX requests in flight (and sign_data_len
+   must fit a request slot), it is a critical error otherwise.
+
+   fd_keyguard_client_sign_poll checks if the oldest request in flight
+   has been answered.  If so, copies its signature to signature (64
+   bytes), removes it from the requests in flight and returns 1.
+   Returns 0 otherwise (including when nothing is in flight).  Responses
+   are thus obtained in the order the requests were submitted.  Does not
+   block. */
+
+ulong
+fd_keyguard_client_sign_submit( fd_keyguard_client_t * client,
+                                uchar const *          sign_data,
+                                ulong                  sign_data_len,
+                                int                    sign_type );
+
+int
+fd_keyguard_client_sign_poll( fd_keyguard_client_t * client,
+                              uchar *                signature );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_disco_keyguard_fd_keyguard_client_h */
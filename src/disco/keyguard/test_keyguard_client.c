@@ -0,0 +1,106 @@
+#include "fd_keyguard_client.h"
+#include "fd_keyguard.h"
+#include "../../ballet/ed25519/fd_ed25519.h"
+
+#define DEPTH   (128UL)
+#define REQ_MTU (2048UL)
+
+static uchar req_mcache_mem[ FD_MCACHE_FOOTPRINT( DEPTH, 0UL ) ] __attribute__((aligned(FD_MCACHE_ALIGN)));
+static uchar rsp_mcache_mem[ FD_MCACHE_FOOTPRINT( DEPTH, 0UL ) ] __attribute__((aligned(FD_MCACHE_ALIGN)));
+static uchar req_dcache_mem[ FD_DCACHE_FOOTPRINT( FD_DCACHE_REQ_DATA_SZ( REQ_MTU, DEPTH, 1UL, 1 ), 0UL ) ] __attribute__((aligned(FD_DCACHE_ALIGN)));
+static uchar rsp_dcache_mem[ FD_DCACHE_FOOTPRINT( FD_DCACHE_REQ_DATA_SZ( 64UL,    DEPTH, 1UL, 1 ), 0UL ) ] __attribute__((aligned(FD_DCACHE_ALIGN)));
+static uchar small_dcache_mem[ FD_DCACHE_FOOTPRINT( 512UL, 0UL ) ] __attribute__((aligned(FD_DCACHE_ALIGN)));
+
+/* A minimal signing server: answers the request with sequence number
+   seq, the way the sign tile does. */
+
+static void
+serve( fd_frag_meta_t *  req_mcache,
+       uchar const *     req_data,
+       fd_frag_meta_t *  rsp_mcache,
+       uchar *           rsp_data,
+       ulong             seq,
+       uchar const *     public_key,
+       uchar const *     private_key,
+       fd_sha512_t *     sha ) {
+  fd_frag_meta_t const * mline = req_mcache + fd_mcache_line_idx( seq, DEPTH );
+  FD_TEST( mline->seq==seq );
+  FD_TEST( (int)mline->sig==FD_KEYGUARD_SIGN_TYPE_ED25519 );
+  uchar * sig = rsp_data + (seq & (FD_KEYGUARD_CLIENT_INFLIGHT_MAX-1UL))*64UL;
+  fd_ed25519_sign( sig, fd_chunk_to_laddr_const( req_data, mline->chunk ), mline->sz, public_key, private_key, sha );
+  fd_mcache_publish( rsp_mcache, DEPTH, seq, 0UL, seq & (FD_KEYGUARD_CLIENT_INFLIGHT_MAX-1UL), 64UL, 0UL, 0UL, 0UL );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+
+  fd_frag_meta_t * req_mcache = fd_mcache_join( fd_mcache_new( req_mcache_mem, DEPTH, 0UL, 0UL ) );
+  fd_frag_meta_t * rsp_mcache = fd_mcache_join( fd_mcache_new( rsp_mcache_mem, DEPTH, 0UL, 0UL ) );
+  uchar *          req_data   = fd_dcache_join( fd_dcache_new( req_dcache_mem, FD_DCACHE_REQ_DATA_SZ( REQ_MTU, DEPTH, 1UL, 1 ), 0UL ) );
+  uchar *          rsp_data   = fd_dcache_join( fd_dcache_new( rsp_dcache_mem, FD_DCACHE_REQ_DATA_SZ( 64UL,    DEPTH, 1UL, 1 ), 0UL ) );
+  uchar *          small_data = fd_dcache_join( fd_dcache_new( small_dcache_mem, 512UL, 0UL ) );
+  FD_TEST( req_mcache && rsp_mcache && req_data && rsp_data && small_data );
+
+  fd_keyguard_client_t _client[1];
+  FD_TEST( !fd_keyguard_client_new( _client, req_mcache, req_data, rsp_mcache, small_data ) );
+  fd_keyguard_client_t * client = fd_keyguard_client_join( fd_keyguard_client_new( _client, req_mcache, req_data, rsp_mcache, rsp_data ) );
+  FD_TEST( client );
+  FD_TEST( client->request_stride>=REQ_MTU );
+
+  uchar private_key[ 32 ];
+  uchar public_key [ 32 ];
+  for( ulong b=0UL; b<32UL; b++ ) private_key[ b ] = fd_rng_uchar( rng );
+  fd_ed25519_public_from_private( public_key, private_key, sha );
+
+  /* Random bursts of requests, answered out of step with the
+     submissions, must complete in order with the right signatures */
+
+  static uchar msg[ 2*FD_KEYGUARD_CLIENT_INFLIGHT_MAX ][ REQ_MTU ];
+  ulong msg_sz[ 2*FD_KEYGUARD_CLIENT_INFLIGHT_MAX ];
+
+  ulong submit_seq = 0UL; /* Next request to submit */
+  ulong serve_seq  = 0UL; /* Next request the server answers */
+  ulong poll_seq   = 0UL; /* Next request to complete */
+  for( ulong iter=0UL; iter<4096UL; iter++ ) {
+    FD_TEST( fd_keyguard_client_inflight_cnt( client )==submit_seq-poll_seq );
+
+    uint r = fd_rng_uint_roll( rng, 3U );
+    if( r==0U && submit_seq-poll_seq<FD_KEYGUARD_CLIENT_INFLIGHT_MAX ) {
+      ulong   slot = submit_seq % (2*FD_KEYGUARD_CLIENT_INFLIGHT_MAX);
+      msg_sz[ slot ] = fd_rng_ulong_roll( rng, REQ_MTU+1UL );
+      for( ulong b=0UL; b<msg_sz[ slot ]; b++ ) msg[ slot ][ b ] = fd_rng_uchar( rng );
+      FD_TEST( fd_keyguard_client_sign_submit( client, msg[ slot ], msg_sz[ slot ], FD_KEYGUARD_SIGN_TYPE_ED25519 )==submit_seq );
+      submit_seq++;
+    } else if( r==1U && serve_seq<submit_seq ) {
+      serve( req_mcache, req_data, rsp_mcache, rsp_data, serve_seq, public_key, private_key, sha );
+      serve_seq++;
+    } else {
+      uchar sig[ 64 ];
+      int done = fd_keyguard_client_sign_poll( client, sig );
+      FD_TEST( done==(poll_seq<serve_seq) );
+      if( done ) {
+        ulong slot = poll_seq % (2*FD_KEYGUARD_CLIENT_INFLIGHT_MAX);
+        FD_TEST( fd_ed25519_verify( msg[ slot ], msg_sz[ slot ], sig, public_key, sha )==FD_ED25519_SUCCESS );
+        poll_seq++;
+      }
+    }
+  }
+  FD_TEST( poll_seq>DEPTH ); /* Wrapped around the mcaches */
+
+  fd_dcache_delete( fd_dcache_leave( small_data ) );
+  fd_dcache_delete( fd_dcache_leave( rsp_data ) );
+  fd_dcache_delete( fd_dcache_leave( req_data ) );
+  fd_mcache_delete( fd_mcache_leave( rsp_mcache ) );
+  fd_mcache_delete( fd_mcache_leave( req_mcache ) );
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
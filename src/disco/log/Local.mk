@@ -0,0 +1,3 @@
+ifdef FD_HAS_SSE
+$(call add-objs,fd_log_tile,fd_disco)
+endif
@@ -0,0 +1,138 @@
+/* The log tile ("logd") drains the async log rings of the other tiles
+   (see fd_log_ring.h and fd_topob_tile_log_rings) and writes their
+   messages to the log file and stderr on their behalf, so that tiles
+   never stall on log write / fsync system calls for non-fatal
+   messages.  Each ring is deduplicated and rate limited independently.
+   Messages from different tiles can be written slightly out of
+   timestamp order. */
+
+#include "../stem/fd_stem.h"
+#include "../topo/fd_topo.h"
+#include "../../util/log/fd_log_ring.h"
+
+#include <time.h>
+
+#include "generated/fd_log_tile_seccomp.h"
+
+/* DRAIN_BURST is the max number of messages drained from a ring before
+   moving on to the next one, so one chatty tile can't starve the rest.
+   IDLE_SLEEP_NANOS is how long to sleep when all the rings are
+   empty. */
+
+#define DRAIN_BURST      (64UL)
+#define IDLE_SLEEP_NANOS (1000000L) /* 1ms */
+
+typedef struct {
+  ulong               ring_cnt;
+  fd_log_ring_t *     ring [ FD_TOPO_MAX_TILES ];
+  fd_log_ring_drain_t drain[ FD_TOPO_MAX_TILES ];
+} fd_log_tile_ctx_t;
+
+FD_FN_CONST static inline ulong
+scratch_align( void ) {
+  return 128UL;
+}
+
+FD_FN_PURE static inline ulong
+scratch_footprint( fd_topo_tile_t const * tile ) {
+  (void)tile;
+  ulong l = FD_LAYOUT_INIT;
+  l = FD_LAYOUT_APPEND( l, alignof( fd_log_tile_ctx_t ), sizeof( fd_log_tile_ctx_t ) );
+  return FD_LAYOUT_FINI( l, scratch_align() );
+}
+
+static void
+before_credit( fd_log_tile_ctx_t * ctx,
+               fd_stem_context_t * stem,
+               int *               charge_busy ) {
+  (void)stem;
+
+  long  now = fd_log_wallclock();
+  ulong cnt = 0UL;
+  for( ulong i=0UL; i<ctx->ring_cnt; i++ ) cnt += fd_log_ring_drain( ctx->ring[ i ], ctx->drain+i, now, DRAIN_BURST );
+
+  if( FD_LIKELY( !cnt ) ) {
+    struct timespec const ts = { .tv_sec = 0L, .tv_nsec = IDLE_SLEEP_NANOS };
+    clock_nanosleep( CLOCK_REALTIME, 0, &ts, NULL );
+    return;
+  }
+
+  *charge_busy = 1;
+}
+
+static void
+unprivileged_init( fd_topo_t *      topo,
+                   fd_topo_tile_t * tile ) {
+  void * scratch = fd_topo_obj_laddr( topo, tile->tile_obj_id );
+
+  FD_SCRATCH_ALLOC_INIT( l, scratch );
+  fd_log_tile_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_log_tile_ctx_t ), sizeof( fd_log_tile_ctx_t ) );
+
+  ctx->ring_cnt = 0UL;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t const * producer = &topo->tiles[ i ];
+    if( FD_UNLIKELY( producer->log_ring_obj_id==ULONG_MAX ) ) continue;
+
+    fd_log_ring_t * ring = fd_log_ring_join( fd_topo_obj_laddr( topo, producer->log_ring_obj_id ) );
+    if( FD_UNLIKELY( !ring ) ) FD_LOG_ERR(( "fd_log_ring_join failed for tile %s:%lu", producer->name, producer->kind_id ));
+
+    ctx->ring[ ctx->ring_cnt ] = ring;
+    fd_log_ring_drain_init( ctx->drain+ctx->ring_cnt, tile->logd.rate, tile->logd.burst );
+    ctx->ring_cnt++;
+  }
+
+  FD_LOG_INFO(( "draining %lu log rings", ctx->ring_cnt ));
+
+  ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, 1UL );
+  if( FD_UNLIKELY( scratch_top > (ulong)scratch + scratch_footprint( tile ) ) )
+    FD_LOG_ERR(( "scratch overflow %lu %lu %lu", scratch_top - (ulong)scratch - scratch_footprint( tile ), scratch_top, (ulong)scratch + scratch_footprint( tile ) ));
+}
+
+static ulong
+populate_allowed_seccomp( fd_topo_t const *      topo,
+                          fd_topo_tile_t const * tile,
+                          ulong                  out_cnt,
+                          struct sock_filter *   out ) {
+  (void)topo;
+  (void)tile;
+
+  populate_sock_filter_policy_fd_log_tile( out_cnt, out, (uint)fd_log_private_logfile_fd() );
+  return sock_filter_policy_fd_log_tile_instr_cnt;
+}
+
+static ulong
+populate_allowed_fds( fd_topo_t const *      topo,
+                      fd_topo_tile_t const * tile,
+                      ulong                  out_fds_cnt,
+                      int *                  out_fds ) {
+  (void)topo;
+  (void)tile;
+
+  if( FD_UNLIKELY( out_fds_cnt<2UL ) ) FD_LOG_ERR(( "out_fds_cnt %lu", out_fds_cnt ));
+
+  ulong out_cnt = 0UL;
+  out_fds[ out_cnt++ ] = 2; /* stderr */
+  if( FD_LIKELY( -1!=fd_log_private_logfile_fd() ) )
+    out_fds[ out_cnt++ ] = fd_log_private_logfile_fd(); /* logfile */
+  return out_cnt;
+}
+
+#define STEM_BURST (1UL)
+#define STEM_LAZY  ((long)10e6) /* 10ms */
+
+#define STEM_CALLBACK_CONTEXT_TYPE  fd_log_tile_ctx_t
+#define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_log_tile_ctx_t)
+
+#define STEM_CALLBACK_BEFORE_CREDIT before_credit
+
+#include "../../disco/stem/fd_stem.c"
+
+fd_topo_run_tile_t fd_tile_logd = {
+  .name                     = "logd",
+  .populate_allowed_seccomp = populate_allowed_seccomp,
+  .populate_allowed_fds     = populate_allowed_fds,
+  .scratch_align            = scratch_align,
+  .scratch_footprint        = scratch_footprint,
+  .unprivileged_init        = unprivileged_init,
+  .run                      = stem_run,
+};
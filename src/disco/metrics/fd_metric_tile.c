@@ -4,6 +4,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h> /* SOCK_CLOEXEC, SOCK_NONBLOCK needed for seccomp filter */
+#include <time.h> /* CLOCK_REALTIME needed for seccomp filter */
 #include <unistd.h>
 #include <string.h>
 
@@ -164,6 +165,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 
 fd_topo_run_tile_t fd_tile_metric = {
   .name                     = "metric",
+  .allow_idle_sleep         = 1,
   .rlimit_file_cnt          = FD_HTTP_SERVER_METRICS_MAX_CONNS+5UL, /* pipefd, socket, stderr, logfile, and one spare for new accept() connections */
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
@@ -56,7 +56,9 @@ render_link( fd_prom_render_t *        r,
 static void
 render_histogram( fd_prom_render_t *        r,
                   fd_metrics_meta_t const * metric,
-                  fd_topo_tile_t const *    tile ) {
+                  fd_topo_tile_t const *    tile,
+                  fd_topo_link_t const *    link,     /* NULL for a tile histogram */
+                  ulong const *             values ) { /* The metric area the histogram's offset is relative to */
   render_header( r, metric );
 
   fd_histf_t hist[1];
@@ -66,10 +68,14 @@ render_histogram( fd_prom_render_t *        r,
     FD_TEST( fd_histf_new( hist, metric->histogram.none.min, metric->histogram.none.max ) );
   else FD_LOG_ERR(( "unknown converter %i", metric->converter ));
 
+  char labels[ 256 ];
+  if( FD_LIKELY( !link ) ) FD_TEST( fd_cstr_printf_check( labels, sizeof( labels ), NULL, "kind=\"%s\",kind_id=\"%lu\"", tile->name, tile->kind_id ) );
+  else                     FD_TEST( fd_cstr_printf_check( labels, sizeof( labels ), NULL, "kind=\"%s\",kind_id=\"%lu\",link_kind=\"%s\",link_kind_id=\"%lu\"", tile->name, tile->kind_id, link->name, link->kind_id ) );
+
   ulong value = 0;
   char value_str[ 64 ];
   for( ulong k=0; k<FD_HISTF_BUCKET_CNT; k++ ) {
-    value += *(fd_metrics_tile( tile->metrics ) + metric->offset + k);
+    value += *(values + metric->offset + k);
 
     char * le;
     char le_str[ 64 ];
@@ -86,19 +92,19 @@ render_histogram( fd_prom_render_t *        r,
     }
 
     FD_TEST( fd_cstr_printf_check( value_str, sizeof( value_str ), NULL, "%lu", value ));
-    fd_http_server_printf( r->http, "%s_bucket{kind=\"%s\",kind_id=\"%lu\",le=\"%s\"} %s\n", metric->name, tile->name, tile->kind_id, le, value_str );
+    fd_http_server_printf( r->http, "%s_bucket{%s,le=\"%s\"} %s\n", metric->name, labels, le, value_str );
   }
 
   char sum_str[ 64 ];
   if( FD_LIKELY( metric->converter==FD_METRICS_CONVERTER_SECONDS ) ) {
-    double sumf = fd_metrics_convert_ticks_to_seconds( *(fd_metrics_tile( tile->metrics ) + metric->offset + FD_HISTF_BUCKET_CNT) );
+    double sumf = fd_metrics_convert_ticks_to_seconds( *(values + metric->offset + FD_HISTF_BUCKET_CNT) );
     FD_TEST( fd_cstr_printf_check( sum_str, sizeof( sum_str ), NULL, "%.17g", sumf ) );
   } else {
-    FD_TEST( fd_cstr_printf_check( sum_str, sizeof( sum_str ), NULL, "%lu", *(fd_metrics_tile( tile->metrics ) + metric->offset + FD_HISTF_BUCKET_CNT) ));
+    FD_TEST( fd_cstr_printf_check( sum_str, sizeof( sum_str ), NULL, "%lu", *(values + metric->offset + FD_HISTF_BUCKET_CNT) ));
   }
 
-  fd_http_server_printf( r->http, "%s_sum{kind=\"%s\",kind_id=\"%lu\"} %s\n", metric->name, tile->name, tile->kind_id, sum_str );
-  fd_http_server_printf( r->http, "%s_count{kind=\"%s\",kind_id=\"%lu\"} %s\n", metric->name, tile->name, tile->kind_id, value_str );
+  fd_http_server_printf( r->http, "%s_sum{%s} %s\n", metric->name, labels, sum_str );
+  fd_http_server_printf( r->http, "%s_count{%s} %s\n", metric->name, labels, value_str );
 }
 
 static void
@@ -127,8 +133,9 @@ render_links_in( fd_prom_render_t *        r,
       for( ulong k=0UL; k<tile->in_cnt; k++ ) {
         if( FD_UNLIKELY( !tile->in_link_poll[ k ] ) ) continue;
         fd_topo_link_t const * link = &topo->links[ tile->in_link_id[ k ] ];
-        ulong value = *(fd_metrics_link_in( tile->metrics, polled_in_idx ) + metric->offset );
-        render_link( r, metric, tile, link, value );
+        ulong const * values = (ulong const *)fd_metrics_link_in( tile->metrics, polled_in_idx );
+        if( FD_UNLIKELY( metric->type==FD_METRICS_TYPE_HISTOGRAM ) ) render_histogram( r, metric, tile, link, values );
+        else                                                        render_link( r, metric, tile, link, *(values + metric->offset) );
         polled_in_idx++;
       }
     }
@@ -151,8 +158,9 @@ render_links_out( fd_prom_render_t *        r,
           for( ulong m=0UL; m<tile->out_cnt; m++ ) {
             if( FD_UNLIKELY( consumer_tile->in_link_id[ l ]==tile->out_link_id[ m ] && consumer_tile->in_link_reliable[ l ] ) ) {
               fd_topo_link_t const * link = &topo->links[ consumer_tile->in_link_id[ l ] ];
-              ulong value = *(fd_metrics_link_out( tile->metrics, reliable_conns_idx ) + metric->offset );
-              render_link( r, metric, tile, link, value );
+              ulong const * values = (ulong const *)fd_metrics_link_out( tile->metrics, reliable_conns_idx );
+              if( FD_UNLIKELY( metric->type==FD_METRICS_TYPE_HISTOGRAM ) ) render_histogram( r, metric, tile, link, values );
+              else                                                        render_link( r, metric, tile, link, *(values + metric->offset) );
               reliable_conns_idx++;
             }
           }
@@ -169,7 +177,7 @@ render_tile_metric( fd_prom_render_t *        r,
   if( FD_LIKELY( metric->type==FD_METRICS_TYPE_COUNTER || metric->type==FD_METRICS_TYPE_GAUGE ) ) {
     render_counter( r, metric, tile );
   } else if( FD_LIKELY( metric->type==FD_METRICS_TYPE_HISTOGRAM ) ) {
-    render_histogram( r, metric, tile );
+    render_histogram( r, metric, tile, NULL, (ulong const *)fd_metrics_tile( tile->metrics ) );
   }
 }
 
@@ -203,9 +211,9 @@ void
 fd_prometheus_render_all( fd_topo_t const *  topo,
                           fd_http_server_t * http ) {
   fd_prom_render_t r = fd_prom_render_create( http );
-  render_tile( &r, topo, NULL, FD_METRICS_ALL_TOTAL, FD_METRICS_ALL );
-  render_links_in( &r, topo, FD_METRICS_ALL_LINK_IN_TOTAL, FD_METRICS_ALL_LINK_IN );
-  render_links_out( &r, topo, FD_METRICS_ALL_LINK_OUT_TOTAL, FD_METRICS_ALL_LINK_OUT );
+  render_tile( &r, topo, NULL, FD_METRICS_ALL_CNT, FD_METRICS_ALL );
+  render_links_in( &r, topo, FD_METRICS_ALL_LINK_IN_CNT, FD_METRICS_ALL_LINK_IN );
+  render_links_out( &r, topo, FD_METRICS_ALL_LINK_OUT_CNT, FD_METRICS_ALL_LINK_OUT );
   for( ulong i=0UL; i<FD_METRICS_TILE_KIND_CNT; i++ ) {
     render_tile( &r, topo, FD_METRICS_TILE_KIND_NAMES[ i ], FD_METRICS_TILE_KIND_SIZES[ i ], FD_METRICS_TILE_KIND_METRICS[ i ] );
   }
@@ -55,6 +55,10 @@ class Metric:
         self.description = description
         self.clickhouse_exclude = clickhouse_exclude
         self.offset = 0
+        # Preprocessor condition under which the metric is declared (and
+        # so exported), None if always.  Its slot is always reserved so
+        # the layout does not depend on build flags.
+        self.cond: Optional[str] = None
 
     def footprint(self) -> int:
         return 8
@@ -142,6 +146,12 @@ class Metrics:
                 tile_offset += int(metric.footprint() / 8)
 
 def parse_metric(tile: Optional[Tile], metric: ET.Element, enums: Dict[str, MetricEnum]) -> Metric:
+    parsed = _parse_metric(tile, metric, enums)
+    if 'cond' in metric.attrib:
+        parsed.cond = metric.attrib['cond']
+    return parsed
+
+def _parse_metric(tile: Optional[Tile], metric: ET.Element, enums: Dict[str, MetricEnum]) -> Metric:
     name = metric.attrib['name']
     description = ""
 
@@ -200,6 +210,9 @@ def parse_metrics(xml_data: str) -> Metrics:
     common = root.find('common')
     assert common is not None
     common = [parse_metric(None, metric, enums) for metric in common]
+    for metric in common:
+        if metric.cond is not None and not isinstance(metric, HistogramMetric):
+            raise Exception(f'Conditional metric {metric.name} must be a histogram')
 
     tiles = {
         Tile[tile.attrib['name'].upper()]: [
@@ -217,4 +230,8 @@ def parse_metrics(xml_data: str) -> Metrics:
     assert link_out is not None
     link_out = [parse_metric(None, metric, enums) for metric in link_out]
 
+    for metric in link_in + link_out + [metric for tile_metrics in tiles.values() for metric in tile_metrics]:
+        if metric.cond is not None:
+            raise Exception(f'Conditional metric {metric.name} is only supported for common tile metrics')
+
     return Metrics(common=common, tiles=tiles, link_in=link_in, link_out=link_out, enums=enums)
@@ -39,6 +39,13 @@ def _write_metric(f: TextIO, metric: Metric, prefix: str):
     f.write('\n')
 
 def _write_metric_descriptor(f, full_name, metric: Metric):
+    if metric.cond is not None:
+        f.write(f'#if {metric.cond}\n')
+    _write_metric_descriptor_body(f, full_name, metric)
+    if metric.cond is not None:
+        f.write(f'#endif\n')
+
+def _write_metric_descriptor_body(f, full_name, metric: Metric):
     if isinstance(metric, CounterMetric):
         f.write(f'    DECLARE_METRIC( {full_name}, COUNTER ),\n')
     elif isinstance(metric, GaugeMetric):
@@ -79,13 +86,36 @@ def _write_common(metrics: Metrics):
         for metric in metrics.common:
             _write_metric(f, metric, "tile")
 
+        # Like for links, the size of the common area (_TOTAL, in ulongs)
+        # can differ from the number of metric descriptors (_CNT).  Some
+        # descriptors are only present in builds where their condition
+        # holds.
         offset = sum([int(metric.footprint()/8) for metric in metrics.common])
         f.write(f'\n#define FD_METRICS_ALL_TOTAL ({offset}UL)\n')
-        f.write(f'extern const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_TOTAL];\n')
-        f.write(f'\n#define FD_METRICS_ALL_LINK_IN_TOTAL ({len(metrics.link_in)}UL)\n')
-        f.write(f'extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_TOTAL];\n')
-        f.write(f'\n#define FD_METRICS_ALL_LINK_OUT_TOTAL ({len(metrics.link_out)}UL)\n')
-        f.write(f'extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_TOTAL];\n')
+        conds = []
+        for metric in metrics.common:
+            if metric.cond is not None and metric.cond not in conds:
+                conds.append(metric.cond)
+        cnt_terms = [f'{sum([metric.count() for metric in metrics.common if metric.cond is None])}UL']
+        for cond in conds:
+            cond_name = re.sub(r'[^A-Za-z0-9_]', '_', cond)
+            cond_cnt = sum([metric.count() for metric in metrics.common if metric.cond == cond])
+            f.write(f'#if {cond}\n#define FD_METRICS_ALL_CNT_IF_{cond_name} ({cond_cnt}UL)\n#else\n#define FD_METRICS_ALL_CNT_IF_{cond_name} (0UL)\n#endif\n')
+            cnt_terms.append(f'FD_METRICS_ALL_CNT_IF_{cond_name}')
+        f.write(f'#define FD_METRICS_ALL_CNT ({"+".join(cnt_terms)})\n')
+        f.write(f'extern const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_CNT];\n')
+
+        # Link metric areas can hold histograms, so the size of a link's
+        # area (_TOTAL, in ulongs) can differ from the number of metric
+        # descriptors (_CNT).
+        link_in_total  = sum([int(metric.footprint()/8) for metric in metrics.link_in])
+        link_out_total = sum([int(metric.footprint()/8) for metric in metrics.link_out])
+        f.write(f'\n#define FD_METRICS_ALL_LINK_IN_TOTAL ({link_in_total}UL)\n')
+        f.write(f'#define FD_METRICS_ALL_LINK_IN_CNT ({sum([metric.count() for metric in metrics.link_in])}UL)\n')
+        f.write(f'extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_CNT];\n')
+        f.write(f'\n#define FD_METRICS_ALL_LINK_OUT_TOTAL ({link_out_total}UL)\n')
+        f.write(f'#define FD_METRICS_ALL_LINK_OUT_CNT ({sum([metric.count() for metric in metrics.link_out])}UL)\n')
+        f.write(f'extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_CNT];\n')
 
         # Max size of any particular tiles metrics
         max_offset = 0
@@ -105,19 +135,19 @@ def _write_common(metrics: Metrics):
         f.write('/* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */\n')
         f.write('#include "fd_metrics_all.h"\n\n')
 
-        f.write('const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_TOTAL] = {\n')
+        f.write('const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_CNT] = {\n')
         for metric in metrics.common:
             full_name = f'TILE_{camel2snake(metric.name)}'
             _write_metric_descriptor(f, full_name, metric)
         f.write('};\n\n')
 
-        f.write('const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_TOTAL] = {\n')
+        f.write('const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_CNT] = {\n')
         for metric in metrics.link_in:
             full_name = f'LINK_{camel2snake(metric.name)}'
             _write_metric_descriptor(f, full_name, metric)
         f.write('};\n\n')
 
-        f.write(f'const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_TOTAL] = {{\n')
+        f.write(f'const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_CNT] = {{\n')
         for metric in metrics.link_out:
             full_name = f'LINK_{camel2snake(metric.name)}'
             _write_metric_descriptor(f, full_name, metric)
@@ -1,7 +1,7 @@
 /* THIS FILE IS GENERATED BY gen_metrics.py. DO NOT HAND EDIT. */
 #include "fd_metrics_all.h"
 
-const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_TOTAL] = {
+const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_CNT] = {
     DECLARE_METRIC( TILE_PID, GAUGE ),
     DECLARE_METRIC( TILE_TID, GAUGE ),
     DECLARE_METRIC( TILE_CONTEXT_SWITCH_INVOLUNTARY_COUNT, COUNTER ),
@@ -18,9 +18,24 @@ const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_TOTAL] = {
     DECLARE_METRIC_ENUM( TILE_REGIME_DURATION_NANOS, COUNTER, TILE_REGIME, BACKPRESSURE_PREFRAG ),
     DECLARE_METRIC_ENUM( TILE_REGIME_DURATION_NANOS, COUNTER, TILE_REGIME, CAUGHT_UP_POSTFRAG ),
     DECLARE_METRIC_ENUM( TILE_REGIME_DURATION_NANOS, COUNTER, TILE_REGIME, PROCESSING_POSTFRAG ),
+#if FD_STEM_PROFILE
+    DECLARE_METRIC_HISTOGRAM_SECONDS( TILE_BEFORE_FRAG_DURATION_SECONDS ),
+#endif
+#if FD_STEM_PROFILE
+    DECLARE_METRIC_HISTOGRAM_SECONDS( TILE_DURING_FRAG_DURATION_SECONDS ),
+#endif
+#if FD_STEM_PROFILE
+    DECLARE_METRIC_HISTOGRAM_SECONDS( TILE_AFTER_FRAG_DURATION_SECONDS ),
+#endif
+#if FD_STEM_PROFILE
+    DECLARE_METRIC_HISTOGRAM_SECONDS( TILE_AFTER_CREDIT_DURATION_SECONDS ),
+#endif
+#if FD_STEM_PROFILE
+    DECLARE_METRIC_HISTOGRAM_SECONDS( TILE_DURING_HOUSEKEEPING_DURATION_SECONDS ),
+#endif
 };
 
-const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_TOTAL] = {
+const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_CNT] = {
     DECLARE_METRIC( LINK_CONSUMED_COUNT, COUNTER ),
     DECLARE_METRIC( LINK_CONSUMED_SIZE_BYTES, COUNTER ),
     DECLARE_METRIC( LINK_FILTERED_COUNT, COUNTER ),
@@ -29,10 +44,16 @@ const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_TOTAL] = {
     DECLARE_METRIC( LINK_OVERRUN_POLLING_FRAG_COUNT, COUNTER ),
     DECLARE_METRIC( LINK_OVERRUN_READING_COUNT, COUNTER ),
     DECLARE_METRIC( LINK_OVERRUN_READING_FRAG_COUNT, COUNTER ),
+    DECLARE_METRIC( LINK_LAG, GAUGE ),
+    DECLARE_METRIC( LINK_LAG_MAX, GAUGE ),
+    DECLARE_METRIC_HISTOGRAM_SECONDS( LINK_HOP_LATENCY_SECONDS ),
+    DECLARE_METRIC_HISTOGRAM_SECONDS( LINK_ORIGIN_LATENCY_SECONDS ),
 };
 
-const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_TOTAL] = {
+const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_CNT] = {
     DECLARE_METRIC( LINK_SLOW_COUNT, COUNTER ),
+    DECLARE_METRIC( LINK_OCCUPANCY, GAUGE ),
+    DECLARE_METRIC( LINK_OCCUPANCY_MAX, GAUGE ),
 };
 
 const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT] = {
@@ -27,6 +27,18 @@
 #define FD_METRICS_COUNTER_LINK_SLOW_COUNT_DESC "The number of times the consumer was detected as rate limiting consumer by the producer."
 #define FD_METRICS_COUNTER_LINK_SLOW_COUNT_CVT  (FD_METRICS_CONVERTER_NONE)
 
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_OFF  (1UL)
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_NAME "link_occupancy"
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_DESC "The number of fragments published to the link that the consumer had not yet returned flow control credits for, as of the last credit refresh."
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_OFF  (2UL)
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_NAME "link_occupancy_max"
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_DESC "The largest occupancy observed at any credit refresh since the producer started."
+#define FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_CVT  (FD_METRICS_CONVERTER_NONE)
+
 /* Start of LINK IN metrics */
 
 #define FD_METRICS_COUNTER_LINK_CONSUMED_COUNT_OFF  (0UL)
@@ -77,6 +89,34 @@
 #define FD_METRICS_COUNTER_LINK_OVERRUN_READING_FRAG_COUNT_DESC "The number of fragments the link has not processed because it was overrun while reading."
 #define FD_METRICS_COUNTER_LINK_OVERRUN_READING_FRAG_COUNT_CVT  (FD_METRICS_CONVERTER_NONE)
 
+#define FD_METRICS_GAUGE_LINK_LAG_OFF  (8UL)
+#define FD_METRICS_GAUGE_LINK_LAG_NAME "link_lag"
+#define FD_METRICS_GAUGE_LINK_LAG_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_LINK_LAG_DESC "The number of fragments the producer had published to the link that the consumer had not yet processed, as of the last housekeeping sample."
+#define FD_METRICS_GAUGE_LINK_LAG_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_LINK_LAG_MAX_OFF  (9UL)
+#define FD_METRICS_GAUGE_LINK_LAG_MAX_NAME "link_lag_max"
+#define FD_METRICS_GAUGE_LINK_LAG_MAX_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_LINK_LAG_MAX_DESC "The largest lag observed at any housekeeping sample since the consumer started."
+#define FD_METRICS_GAUGE_LINK_LAG_MAX_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_OFF  (10UL)
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_NAME "link_hop_latency_seconds"
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_DESC "Time from the producer publishing a fragment (its tspub) to the consumer processing it. Fragments published without a tspub are not sampled."
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_MIN  (1e-07)
+#define FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_MAX  (0.1)
+
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_OFF  (27UL)
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_NAME "link_origin_latency_seconds"
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_DESC "Time from a fragment's origin (its tsorig, e.g. when the transaction it carries was first received) to the consumer processing it. Fragments published without a tsorig are not sampled."
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_MIN  (1e-06)
+#define FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_MAX  (0.5)
+
 /* Start of TILE metrics */
 
 #define FD_METRICS_GAUGE_TILE_PID_OFF  (0UL)
@@ -143,17 +183,65 @@
 #define FD_METRICS_COUNTER_TILE_REGIME_DURATION_NANOS_CAUGHT_UP_POSTFRAG_OFF (14UL)
 #define FD_METRICS_COUNTER_TILE_REGIME_DURATION_NANOS_PROCESSING_POSTFRAG_OFF (15UL)
 
-
-#define FD_METRICS_ALL_TOTAL (16UL)
-extern const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_TOTAL];
-
-#define FD_METRICS_ALL_LINK_IN_TOTAL (8UL)
-extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_TOTAL];
-
-#define FD_METRICS_ALL_LINK_OUT_TOTAL (1UL)
-extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_TOTAL];
-
-#define FD_METRICS_TOTAL_SZ (8UL*246UL)
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_OFF  (16UL)
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_NAME "tile_before_frag_duration_seconds"
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_DESC "Duration of each call to the tile's before_frag callback. Only available in builds with FD_STEM_PROFILE."
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_MIN  (1e-08)
+#define FD_METRICS_HISTOGRAM_TILE_BEFORE_FRAG_DURATION_SECONDS_MAX  (0.001)
+
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_OFF  (33UL)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_NAME "tile_during_frag_duration_seconds"
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_DESC "Duration of each call to the tile's during_frag callback. Only available in builds with FD_STEM_PROFILE."
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_MIN  (1e-08)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_FRAG_DURATION_SECONDS_MAX  (0.001)
+
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_OFF  (50UL)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_NAME "tile_after_frag_duration_seconds"
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_DESC "Duration of each call to the tile's after_frag callback. Only available in builds with FD_STEM_PROFILE."
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_MIN  (1e-08)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_FRAG_DURATION_SECONDS_MAX  (0.001)
+
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_OFF  (67UL)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_NAME "tile_after_credit_duration_seconds"
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_DESC "Duration of each call to the tile's after_credit callback. Only available in builds with FD_STEM_PROFILE."
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_MIN  (1e-08)
+#define FD_METRICS_HISTOGRAM_TILE_AFTER_CREDIT_DURATION_SECONDS_MAX  (0.001)
+
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_OFF  (84UL)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_NAME "tile_during_housekeeping_duration_seconds"
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_DESC "Duration of each call to the tile's during_housekeeping callback. Only available in builds with FD_STEM_PROFILE."
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_CVT  (FD_METRICS_CONVERTER_SECONDS)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_MIN  (1e-08)
+#define FD_METRICS_HISTOGRAM_TILE_DURING_HOUSEKEEPING_DURATION_SECONDS_MAX  (0.001)
+
+
+#define FD_METRICS_ALL_TOTAL (101UL)
+#if FD_STEM_PROFILE
+#define FD_METRICS_ALL_CNT_IF_FD_STEM_PROFILE (5UL)
+#else
+#define FD_METRICS_ALL_CNT_IF_FD_STEM_PROFILE (0UL)
+#endif
+#define FD_METRICS_ALL_CNT (16UL+FD_METRICS_ALL_CNT_IF_FD_STEM_PROFILE)
+extern const fd_metrics_meta_t FD_METRICS_ALL[FD_METRICS_ALL_CNT];
+
+#define FD_METRICS_ALL_LINK_IN_TOTAL (44UL)
+#define FD_METRICS_ALL_LINK_IN_CNT (12UL)
+extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_IN[FD_METRICS_ALL_LINK_IN_CNT];
+
+#define FD_METRICS_ALL_LINK_OUT_TOTAL (3UL)
+#define FD_METRICS_ALL_LINK_OUT_CNT (3UL)
+extern const fd_metrics_meta_t FD_METRICS_ALL_LINK_OUT[FD_METRICS_ALL_LINK_OUT_CNT];
+
+#define FD_METRICS_TOTAL_SZ (8UL*331UL)
 
 #define FD_METRICS_TILE_KIND_CNT 17
 extern const char * FD_METRICS_TILE_KIND_NAMES[FD_METRICS_TILE_KIND_CNT];
@@ -3,19 +3,19 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_COUNTER_BUNDLE_TRANSACTION_RECEIVED_OFF  (16UL)
+#define FD_METRICS_COUNTER_BUNDLE_TRANSACTION_RECEIVED_OFF  (101UL)
 #define FD_METRICS_COUNTER_BUNDLE_TRANSACTION_RECEIVED_NAME "bundle_transaction_received"
 #define FD_METRICS_COUNTER_BUNDLE_TRANSACTION_RECEIVED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BUNDLE_TRANSACTION_RECEIVED_DESC "Total count of transactions received, including transactions within bundles"
 #define FD_METRICS_COUNTER_BUNDLE_TRANSACTION_RECEIVED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_BUNDLE_PACKET_RECEIVED_OFF  (17UL)
+#define FD_METRICS_COUNTER_BUNDLE_PACKET_RECEIVED_OFF  (102UL)
 #define FD_METRICS_COUNTER_BUNDLE_PACKET_RECEIVED_NAME "bundle_packet_received"
 #define FD_METRICS_COUNTER_BUNDLE_PACKET_RECEIVED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BUNDLE_PACKET_RECEIVED_DESC "Total count of packets received"
 #define FD_METRICS_COUNTER_BUNDLE_PACKET_RECEIVED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_BUNDLE_BUNDLE_RECEIVED_OFF  (18UL)
+#define FD_METRICS_COUNTER_BUNDLE_BUNDLE_RECEIVED_OFF  (103UL)
 #define FD_METRICS_COUNTER_BUNDLE_BUNDLE_RECEIVED_NAME "bundle_bundle_received"
 #define FD_METRICS_COUNTER_BUNDLE_BUNDLE_RECEIVED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_BUNDLE_BUNDLE_RECEIVED_DESC "Total count of bundles received"
@@ -3,7 +3,7 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_OFF  (16UL)
+#define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_OFF  (101UL)
 #define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_NAME "poh_begin_leader_delay_seconds"
 #define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_DESC "Delay between when we become leader in a slot and when we receive the bank."
@@ -11,7 +11,7 @@
 #define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_MIN  (1e-08)
 #define FD_METRICS_HISTOGRAM_POH_BEGIN_LEADER_DELAY_SECONDS_MAX  (0.01)
 
-#define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_OFF  (33UL)
+#define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_OFF  (118UL)
 #define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_NAME "poh_first_microblock_delay_seconds"
 #define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_DESC "Delay between when we become leader in a slot and when we receive the first microblock."
@@ -19,7 +19,7 @@
 #define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_MIN  (1e-08)
 #define FD_METRICS_HISTOGRAM_POH_FIRST_MICROBLOCK_DELAY_SECONDS_MAX  (0.01)
 
-#define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_OFF  (50UL)
+#define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_OFF  (135UL)
 #define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_NAME "poh_slot_done_delay_seconds"
 #define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_DESC "Delay between when we become leader in a slot and when we finish the slot."
@@ -27,7 +27,7 @@
 #define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_MIN  (0.001)
 #define FD_METRICS_HISTOGRAM_POH_SLOT_DONE_DELAY_SECONDS_MAX  (0.6)
 
-#define FD_METRICS_HISTOGRAM_POH_BUNDLE_INITIALIZE_DELAY_SECONDS_OFF  (67UL)
+#define FD_METRICS_HISTOGRAM_POH_BUNDLE_INITIALIZE_DELAY_SECONDS_OFF  (152UL)
 #define FD_METRICS_HISTOGRAM_POH_BUNDLE_INITIALIZE_DELAY_SECONDS_NAME "poh_bundle_initialize_delay_seconds"
 #define FD_METRICS_HISTOGRAM_POH_BUNDLE_INITIALIZE_DELAY_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_POH_BUNDLE_INITIALIZE_DELAY_SECONDS_DESC "Delay in starting the slot caused by loading the information needed to generate the bundle crank transactions"
@@ -3,241 +3,241 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_COUNTER_QUIC_TXNS_OVERRUN_OFF  (16UL)
+#define FD_METRICS_COUNTER_QUIC_TXNS_OVERRUN_OFF  (101UL)
 #define FD_METRICS_COUNTER_QUIC_TXNS_OVERRUN_NAME "quic_txns_overrun"
 #define FD_METRICS_COUNTER_QUIC_TXNS_OVERRUN_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_TXNS_OVERRUN_DESC "Count of txns overrun before reassembled (too small txn_reassembly_count)."
 #define FD_METRICS_COUNTER_QUIC_TXNS_OVERRUN_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_TXN_REASMS_STARTED_OFF  (17UL)
+#define FD_METRICS_COUNTER_QUIC_TXN_REASMS_STARTED_OFF  (102UL)
 #define FD_METRICS_COUNTER_QUIC_TXN_REASMS_STARTED_NAME "quic_txn_reasms_started"
 #define FD_METRICS_COUNTER_QUIC_TXN_REASMS_STARTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_TXN_REASMS_STARTED_DESC "Count of fragmented txn receive ops started."
 #define FD_METRICS_COUNTER_QUIC_TXN_REASMS_STARTED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_GAUGE_QUIC_TXN_REASMS_ACTIVE_OFF  (18UL)
+#define FD_METRICS_GAUGE_QUIC_TXN_REASMS_ACTIVE_OFF  (103UL)
 #define FD_METRICS_GAUGE_QUIC_TXN_REASMS_ACTIVE_NAME "quic_txn_reasms_active"
 #define FD_METRICS_GAUGE_QUIC_TXN_REASMS_ACTIVE_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_QUIC_TXN_REASMS_ACTIVE_DESC "Number of fragmented txn receive ops currently active."
 #define FD_METRICS_GAUGE_QUIC_TXN_REASMS_ACTIVE_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_FRAGS_OK_OFF  (19UL)
+#define FD_METRICS_COUNTER_QUIC_FRAGS_OK_OFF  (104UL)
 #define FD_METRICS_COUNTER_QUIC_FRAGS_OK_NAME "quic_frags_ok"
 #define FD_METRICS_COUNTER_QUIC_FRAGS_OK_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_FRAGS_OK_DESC "Count of txn frags received"
 #define FD_METRICS_COUNTER_QUIC_FRAGS_OK_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_FRAGS_GAP_OFF  (20UL)
+#define FD_METRICS_COUNTER_QUIC_FRAGS_GAP_OFF  (105UL)
 #define FD_METRICS_COUNTER_QUIC_FRAGS_GAP_NAME "quic_frags_gap"
 #define FD_METRICS_COUNTER_QUIC_FRAGS_GAP_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_FRAGS_GAP_DESC "Count of txn frags dropped due to data gap"
 #define FD_METRICS_COUNTER_QUIC_FRAGS_GAP_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_FRAGS_DUP_OFF  (21UL)
+#define FD_METRICS_COUNTER_QUIC_FRAGS_DUP_OFF  (106UL)
 #define FD_METRICS_COUNTER_QUIC_FRAGS_DUP_NAME "quic_frags_dup"
 #define FD_METRICS_COUNTER_QUIC_FRAGS_DUP_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_FRAGS_DUP_DESC "Count of txn frags dropped due to dup (stream already completed)"
 #define FD_METRICS_COUNTER_QUIC_FRAGS_DUP_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_OFF  (22UL)
+#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_OFF  (107UL)
 #define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_NAME "quic_txns_received"
 #define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_DESC "Count of txns received via TPU."
 #define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_CVT  (FD_METRICS_CONVERTER_NONE)
 #define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_CNT  (3UL)
 
-#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_UDP_OFF (22UL)
-#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_QUIC_FAST_OFF (23UL)
-#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_QUIC_FRAG_OFF (24UL)
+#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_UDP_OFF (107UL)
+#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_QUIC_FAST_OFF (108UL)
+#define FD_METRICS_COUNTER_QUIC_TXNS_RECEIVED_QUIC_FRAG_OFF (109UL)
 
-#define FD_METRICS_COUNTER_QUIC_TXNS_ABANDONED_OFF  (25UL)
+#define FD_METRICS_COUNTER_QUIC_TXNS_ABANDONED_OFF  (110UL)
 #define FD_METRICS_COUNTER_QUIC_TXNS_ABANDONED_NAME "quic_txns_abandoned"
 #define FD_METRICS_COUNTER_QUIC_TXNS_ABANDONED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_TXNS_ABANDONED_DESC "Count of txns abandoned because a conn was lost."
 #define FD_METRICS_COUNTER_QUIC_TXNS_ABANDONED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_TXN_UNDERSZ_OFF  (26UL)
+#define FD_METRICS_COUNTER_QUIC_TXN_UNDERSZ_OFF  (111UL)
 #define FD_METRICS_COUNTER_QUIC_TXN_UNDERSZ_NAME "quic_txn_undersz"
 #define FD_METRICS_COUNTER_QUIC_TXN_UNDERSZ_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_TXN_UNDERSZ_DESC "Count of txns received via QUIC dropped because they were too small."
 #define FD_METRICS_COUNTER_QUIC_TXN_UNDERSZ_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_TXN_OVERSZ_OFF  (27UL)
+#define FD_METRICS_COUNTER_QUIC_TXN_OVERSZ_OFF  (112UL)
 #define FD_METRICS_COUNTER_QUIC_TXN_OVERSZ_NAME "quic_txn_oversz"
 #define FD_METRICS_COUNTER_QUIC_TXN_OVERSZ_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_TXN_OVERSZ_DESC "Count of txns received via QUIC dropped because they were too large."
 #define FD_METRICS_COUNTER_QUIC_TXN_OVERSZ_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_UNDERSZ_OFF  (28UL)
+#define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_UNDERSZ_OFF  (113UL)
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_UNDERSZ_NAME "quic_legacy_txn_undersz"
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_UNDERSZ_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_UNDERSZ_DESC "Count of packets received on the non-QUIC port that were too small to be a valid IP packet."
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_UNDERSZ_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_OVERSZ_OFF  (29UL)
+#define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_OVERSZ_OFF  (114UL)
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_OVERSZ_NAME "quic_legacy_txn_oversz"
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_OVERSZ_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_OVERSZ_DESC "Count of packets received on the non-QUIC port that were too large to be a valid transaction."
 #define FD_METRICS_COUNTER_QUIC_LEGACY_TXN_OVERSZ_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_PACKETS_OFF  (30UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_PACKETS_OFF  (115UL)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_PACKETS_NAME "quic_received_packets"
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_PACKETS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_PACKETS_DESC "Number of IP packets received."
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_PACKETS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_BYTES_OFF  (31UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_BYTES_OFF  (116UL)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_BYTES_NAME "quic_received_bytes"
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_BYTES_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_BYTES_DESC "Total bytes received (including IP, UDP, QUIC headers)."
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_BYTES_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_SENT_PACKETS_OFF  (32UL)
+#define FD_METRICS_COUNTER_QUIC_SENT_PACKETS_OFF  (117UL)
 #define FD_METRICS_COUNTER_QUIC_SENT_PACKETS_NAME "quic_sent_packets"
 #define FD_METRICS_COUNTER_QUIC_SENT_PACKETS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_SENT_PACKETS_DESC "Number of IP packets sent."
 #define FD_METRICS_COUNTER_QUIC_SENT_PACKETS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_SENT_BYTES_OFF  (33UL)
+#define FD_METRICS_COUNTER_QUIC_SENT_BYTES_OFF  (118UL)
 #define FD_METRICS_COUNTER_QUIC_SENT_BYTES_NAME "quic_sent_bytes"
 #define FD_METRICS_COUNTER_QUIC_SENT_BYTES_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_SENT_BYTES_DESC "Total bytes sent (including IP, UDP, QUIC headers)."
 #define FD_METRICS_COUNTER_QUIC_SENT_BYTES_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_GAUGE_QUIC_CONNECTIONS_ACTIVE_OFF  (34UL)
+#define FD_METRICS_GAUGE_QUIC_CONNECTIONS_ACTIVE_OFF  (119UL)
 #define FD_METRICS_GAUGE_QUIC_CONNECTIONS_ACTIVE_NAME "quic_connections_active"
 #define FD_METRICS_GAUGE_QUIC_CONNECTIONS_ACTIVE_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_QUIC_CONNECTIONS_ACTIVE_DESC "The number of currently active QUIC connections."
 #define FD_METRICS_GAUGE_QUIC_CONNECTIONS_ACTIVE_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CREATED_OFF  (35UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CREATED_OFF  (120UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CREATED_NAME "quic_connections_created"
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CREATED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CREATED_DESC "The total number of connections that have been created."
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CREATED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CLOSED_OFF  (36UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CLOSED_OFF  (121UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CLOSED_NAME "quic_connections_closed"
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CLOSED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CLOSED_DESC "Number of connections gracefully closed."
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_CLOSED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_ABORTED_OFF  (37UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_ABORTED_OFF  (122UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_ABORTED_NAME "quic_connections_aborted"
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_ABORTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_ABORTED_DESC "Number of connections aborted."
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_ABORTED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_TIMED_OUT_OFF  (38UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_TIMED_OUT_OFF  (123UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_TIMED_OUT_NAME "quic_connections_timed_out"
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_TIMED_OUT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_TIMED_OUT_DESC "Number of connections timed out."
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_TIMED_OUT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_RETRIED_OFF  (39UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTIONS_RETRIED_OFF  (124UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_RETRIED_NAME "quic_connections_retried"
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_RETRIED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_RETRIED_DESC "Number of connections established with retry."
 #define FD_METRICS_COUNTER_QUIC_CONNECTIONS_RETRIED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_NO_SLOTS_OFF  (40UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_NO_SLOTS_OFF  (125UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_NO_SLOTS_NAME "quic_connection_error_no_slots"
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_NO_SLOTS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_NO_SLOTS_DESC "Number of connections that failed to create due to lack of slots."
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_NO_SLOTS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_RETRY_FAIL_OFF  (41UL)
+#define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_RETRY_FAIL_OFF  (126UL)
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_RETRY_FAIL_NAME "quic_connection_error_retry_fail"
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_RETRY_FAIL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_RETRY_FAIL_DESC "Number of connections that failed during retry (e.g. invalid token)."
 #define FD_METRICS_COUNTER_QUIC_CONNECTION_ERROR_RETRY_FAIL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_NO_CONN_OFF  (42UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NO_CONN_OFF  (127UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_CONN_NAME "quic_pkt_no_conn"
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_CONN_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_CONN_DESC "Number of packets with an unknown connection ID."
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_CONN_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_TX_ALLOC_FAIL_OFF  (43UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_TX_ALLOC_FAIL_OFF  (128UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_TX_ALLOC_FAIL_NAME "quic_pkt_tx_alloc_fail"
 #define FD_METRICS_COUNTER_QUIC_PKT_TX_ALLOC_FAIL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_TX_ALLOC_FAIL_DESC "Number of packets failed to send because of metadata alloc fail."
 #define FD_METRICS_COUNTER_QUIC_PKT_TX_ALLOC_FAIL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_HANDSHAKES_CREATED_OFF  (44UL)
+#define FD_METRICS_COUNTER_QUIC_HANDSHAKES_CREATED_OFF  (129UL)
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKES_CREATED_NAME "quic_handshakes_created"
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKES_CREATED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKES_CREATED_DESC "Number of handshake flows created."
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKES_CREATED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_HANDSHAKE_ERROR_ALLOC_FAIL_OFF  (45UL)
+#define FD_METRICS_COUNTER_QUIC_HANDSHAKE_ERROR_ALLOC_FAIL_OFF  (130UL)
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_ERROR_ALLOC_FAIL_NAME "quic_handshake_error_alloc_fail"
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_ERROR_ALLOC_FAIL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_ERROR_ALLOC_FAIL_DESC "Number of handshakes dropped due to alloc fail."
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_ERROR_ALLOC_FAIL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_HANDSHAKE_EVICTED_OFF  (46UL)
+#define FD_METRICS_COUNTER_QUIC_HANDSHAKE_EVICTED_OFF  (131UL)
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_EVICTED_NAME "quic_handshake_evicted"
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_EVICTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_EVICTED_DESC "Number of handshakes dropped due to eviction."
 #define FD_METRICS_COUNTER_QUIC_HANDSHAKE_EVICTED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_EVENTS_OFF  (47UL)
+#define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_EVENTS_OFF  (132UL)
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_EVENTS_NAME "quic_stream_received_events"
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_EVENTS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_EVENTS_DESC "Number of stream RX events."
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_EVENTS_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_BYTES_OFF  (48UL)
+#define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_BYTES_OFF  (133UL)
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_BYTES_NAME "quic_stream_received_bytes"
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_BYTES_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_BYTES_DESC "Total stream payload bytes received."
 #define FD_METRICS_COUNTER_QUIC_STREAM_RECEIVED_BYTES_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_OFF  (49UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_OFF  (134UL)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_NAME "quic_received_frames"
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_DESC "Number of QUIC frames received."
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CVT  (FD_METRICS_CONVERTER_NONE)
 #define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CNT  (22UL)
 
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_UNKNOWN_OFF (49UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_ACK_OFF (50UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_RESET_STREAM_OFF (51UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STOP_SENDING_OFF (52UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CRYPTO_OFF (53UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_NEW_TOKEN_OFF (54UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STREAM_OFF (55UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_MAX_DATA_OFF (56UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_MAX_STREAM_DATA_OFF (57UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_MAX_STREAMS_OFF (58UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_DATA_BLOCKED_OFF (59UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STREAM_DATA_BLOCKED_OFF (60UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STREAMS_BLOCKED_OFF (61UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_NEW_CONN_ID_OFF (62UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_RETIRE_CONN_ID_OFF (63UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PATH_CHALLENGE_OFF (64UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PATH_RESPONSE_OFF (65UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CONN_CLOSE_QUIC_OFF (66UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CONN_CLOSE_APP_OFF (67UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_HANDSHAKE_DONE_OFF (68UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PING_OFF (69UL)
-#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PADDING_OFF (70UL)
-
-#define FD_METRICS_COUNTER_QUIC_ACK_TX_OFF  (71UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_UNKNOWN_OFF (134UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_ACK_OFF (135UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_RESET_STREAM_OFF (136UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STOP_SENDING_OFF (137UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CRYPTO_OFF (138UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_NEW_TOKEN_OFF (139UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STREAM_OFF (140UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_MAX_DATA_OFF (141UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_MAX_STREAM_DATA_OFF (142UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_MAX_STREAMS_OFF (143UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_DATA_BLOCKED_OFF (144UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STREAM_DATA_BLOCKED_OFF (145UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_STREAMS_BLOCKED_OFF (146UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_NEW_CONN_ID_OFF (147UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_RETIRE_CONN_ID_OFF (148UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PATH_CHALLENGE_OFF (149UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PATH_RESPONSE_OFF (150UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CONN_CLOSE_QUIC_OFF (151UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_CONN_CLOSE_APP_OFF (152UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_HANDSHAKE_DONE_OFF (153UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PING_OFF (154UL)
+#define FD_METRICS_COUNTER_QUIC_RECEIVED_FRAMES_PADDING_OFF (155UL)
+
+#define FD_METRICS_COUNTER_QUIC_ACK_TX_OFF  (156UL)
 #define FD_METRICS_COUNTER_QUIC_ACK_TX_NAME "quic_ack_tx"
 #define FD_METRICS_COUNTER_QUIC_ACK_TX_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_ACK_TX_DESC "ACK events"
 #define FD_METRICS_COUNTER_QUIC_ACK_TX_CVT  (FD_METRICS_CONVERTER_NONE)
 #define FD_METRICS_COUNTER_QUIC_ACK_TX_CNT  (5UL)
 
-#define FD_METRICS_COUNTER_QUIC_ACK_TX_NOOP_OFF (71UL)
-#define FD_METRICS_COUNTER_QUIC_ACK_TX_NEW_OFF (72UL)
-#define FD_METRICS_COUNTER_QUIC_ACK_TX_MERGED_OFF (73UL)
-#define FD_METRICS_COUNTER_QUIC_ACK_TX_DROP_OFF (74UL)
-#define FD_METRICS_COUNTER_QUIC_ACK_TX_CANCEL_OFF (75UL)
+#define FD_METRICS_COUNTER_QUIC_ACK_TX_NOOP_OFF (156UL)
+#define FD_METRICS_COUNTER_QUIC_ACK_TX_NEW_OFF (157UL)
+#define FD_METRICS_COUNTER_QUIC_ACK_TX_MERGED_OFF (158UL)
+#define FD_METRICS_COUNTER_QUIC_ACK_TX_DROP_OFF (159UL)
+#define FD_METRICS_COUNTER_QUIC_ACK_TX_CANCEL_OFF (160UL)
 
-#define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_OFF  (76UL)
+#define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_OFF  (161UL)
 #define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_NAME "quic_service_duration_seconds"
 #define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_DESC "Duration spent in service"
@@ -245,7 +245,7 @@
 #define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_MIN  (1e-08)
 #define FD_METRICS_HISTOGRAM_QUIC_SERVICE_DURATION_SECONDS_MAX  (0.1)
 
-#define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_OFF  (93UL)
+#define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_OFF  (178UL)
 #define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_NAME "quic_receive_duration_seconds"
 #define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_DESC "Duration spent receiving packets"
@@ -253,67 +253,67 @@
 #define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_MIN  (1e-08)
 #define FD_METRICS_HISTOGRAM_QUIC_RECEIVE_DURATION_SECONDS_MAX  (0.1)
 
-#define FD_METRICS_COUNTER_QUIC_FRAME_FAIL_PARSE_OFF  (110UL)
+#define FD_METRICS_COUNTER_QUIC_FRAME_FAIL_PARSE_OFF  (195UL)
 #define FD_METRICS_COUNTER_QUIC_FRAME_FAIL_PARSE_NAME "quic_frame_fail_parse"
 #define FD_METRICS_COUNTER_QUIC_FRAME_FAIL_PARSE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_FRAME_FAIL_PARSE_DESC "Number of QUIC frames failed to parse."
 #define FD_METRICS_COUNTER_QUIC_FRAME_FAIL_PARSE_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_OFF  (111UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_OFF  (196UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_NAME "quic_pkt_crypto_failed"
 #define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_DESC "Number of packets that failed decryption."
 #define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_CVT  (FD_METRICS_CONVERTER_NONE)
 #define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_CNT  (4UL)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_INITIAL_OFF (111UL)
-#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_EARLY_OFF (112UL)
-#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_HANDSHAKE_OFF (113UL)
-#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_APP_OFF (114UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_INITIAL_OFF (196UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_EARLY_OFF (197UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_HANDSHAKE_OFF (198UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_CRYPTO_FAILED_APP_OFF (199UL)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_OFF  (115UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_OFF  (200UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_NAME "quic_pkt_no_key"
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_DESC "Number of packets that failed decryption due to missing key."
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_CVT  (FD_METRICS_CONVERTER_NONE)
 #define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_CNT  (4UL)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_INITIAL_OFF (115UL)
-#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_EARLY_OFF (116UL)
-#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_HANDSHAKE_OFF (117UL)
-#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_APP_OFF (118UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_INITIAL_OFF (200UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_EARLY_OFF (201UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_HANDSHAKE_OFF (202UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NO_KEY_APP_OFF (203UL)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_NET_HEADER_INVALID_OFF  (119UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_NET_HEADER_INVALID_OFF  (204UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_NET_HEADER_INVALID_NAME "quic_pkt_net_header_invalid"
 #define FD_METRICS_COUNTER_QUIC_PKT_NET_HEADER_INVALID_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_NET_HEADER_INVALID_DESC "Number of packets dropped due to weird IP or UDP header."
 #define FD_METRICS_COUNTER_QUIC_PKT_NET_HEADER_INVALID_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_QUIC_HEADER_INVALID_OFF  (120UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_QUIC_HEADER_INVALID_OFF  (205UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_QUIC_HEADER_INVALID_NAME "quic_pkt_quic_header_invalid"
 #define FD_METRICS_COUNTER_QUIC_PKT_QUIC_HEADER_INVALID_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_QUIC_HEADER_INVALID_DESC "Number of packets dropped due to weird QUIC header."
 #define FD_METRICS_COUNTER_QUIC_PKT_QUIC_HEADER_INVALID_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_UNDERSZ_OFF  (121UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_UNDERSZ_OFF  (206UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_UNDERSZ_NAME "quic_pkt_undersz"
 #define FD_METRICS_COUNTER_QUIC_PKT_UNDERSZ_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_UNDERSZ_DESC "Number of QUIC packets dropped due to being too small."
 #define FD_METRICS_COUNTER_QUIC_PKT_UNDERSZ_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_OVERSZ_OFF  (122UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_OVERSZ_OFF  (207UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_OVERSZ_NAME "quic_pkt_oversz"
 #define FD_METRICS_COUNTER_QUIC_PKT_OVERSZ_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_OVERSZ_DESC "Number of QUIC packets dropped due to being too large."
 #define FD_METRICS_COUNTER_QUIC_PKT_OVERSZ_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_PKT_VERNEG_OFF  (123UL)
+#define FD_METRICS_COUNTER_QUIC_PKT_VERNEG_OFF  (208UL)
 #define FD_METRICS_COUNTER_QUIC_PKT_VERNEG_NAME "quic_pkt_verneg"
 #define FD_METRICS_COUNTER_QUIC_PKT_VERNEG_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_PKT_VERNEG_DESC "Number of QUIC version negotiation packets received."
 #define FD_METRICS_COUNTER_QUIC_PKT_VERNEG_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_QUIC_RETRY_SENT_OFF  (124UL)
+#define FD_METRICS_COUNTER_QUIC_RETRY_SENT_OFF  (209UL)
 #define FD_METRICS_COUNTER_QUIC_RETRY_SENT_NAME "quic_retry_sent"
 #define FD_METRICS_COUNTER_QUIC_RETRY_SENT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_QUIC_RETRY_SENT_DESC "Number of QUIC Retry packets sent."
@@ -4,4 +4,7 @@
 const fd_metrics_meta_t FD_METRICS_REPLAY[FD_METRICS_REPLAY_TOTAL] = {
     DECLARE_METRIC( REPLAY_SLOT, GAUGE ),
     DECLARE_METRIC( REPLAY_LAST_VOTED_SLOT, GAUGE ),
+    DECLARE_METRIC( REPLAY_EXEC_SPAD_MEM_MAX, GAUGE ),
+    DECLARE_METRIC( REPLAY_EXEC_SPAD_MEM_WMARK, GAUGE ),
+    DECLARE_METRIC( REPLAY_EXEC_SPAD_ALLOC_CNT, GAUGE ),
 };
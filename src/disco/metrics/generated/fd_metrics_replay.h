@@ -3,17 +3,35 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_GAUGE_REPLAY_SLOT_OFF  (16UL)
+#define FD_METRICS_GAUGE_REPLAY_SLOT_OFF  (101UL)
 #define FD_METRICS_GAUGE_REPLAY_SLOT_NAME "replay_slot"
 #define FD_METRICS_GAUGE_REPLAY_SLOT_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_REPLAY_SLOT_DESC ""
 #define FD_METRICS_GAUGE_REPLAY_SLOT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_OFF  (17UL)
+#define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_OFF  (102UL)
 #define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_NAME "replay_last_voted_slot"
 #define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_TYPE (FD_METRICS_TYPE_GAUGE)
 #define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_DESC ""
 #define FD_METRICS_GAUGE_REPLAY_LAST_VOTED_SLOT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_REPLAY_TOTAL (2UL)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_MAX_OFF  (103UL)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_MAX_NAME "replay_exec_spad_mem_max"
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_MAX_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_MAX_DESC ""
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_MAX_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_WMARK_OFF  (104UL)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_WMARK_NAME "replay_exec_spad_mem_wmark"
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_WMARK_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_WMARK_DESC ""
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_MEM_WMARK_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_ALLOC_CNT_OFF  (105UL)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_ALLOC_CNT_NAME "replay_exec_spad_alloc_cnt"
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_ALLOC_CNT_TYPE (FD_METRICS_TYPE_GAUGE)
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_ALLOC_CNT_DESC ""
+#define FD_METRICS_GAUGE_REPLAY_EXEC_SPAD_ALLOC_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
+
+#define FD_METRICS_REPLAY_TOTAL (5UL)
 extern const fd_metrics_meta_t FD_METRICS_REPLAY[FD_METRICS_REPLAY_TOTAL];
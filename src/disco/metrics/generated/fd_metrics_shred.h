@@ -3,7 +3,7 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_OFF  (16UL)
+#define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_OFF  (101UL)
 #define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_NAME "shred_cluster_contact_info_cnt"
 #define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_DESC "Number of contact infos in the cluster contact info message"
@@ -11,19 +11,19 @@
 #define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_MIN  (0UL)
 #define FD_METRICS_HISTOGRAM_SHRED_CLUSTER_CONTACT_INFO_CNT_MAX  (40200UL)
 
-#define FD_METRICS_COUNTER_SHRED_MICROBLOCKS_ABANDONED_OFF  (33UL)
+#define FD_METRICS_COUNTER_SHRED_MICROBLOCKS_ABANDONED_OFF  (118UL)
 #define FD_METRICS_COUNTER_SHRED_MICROBLOCKS_ABANDONED_NAME "shred_microblocks_abandoned"
 #define FD_METRICS_COUNTER_SHRED_MICROBLOCKS_ABANDONED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_MICROBLOCKS_ABANDONED_DESC "The number of microblocks that were abandoned because we switched slots without finishing the current slot"
 #define FD_METRICS_COUNTER_SHRED_MICROBLOCKS_ABANDONED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_INVALID_BLOCK_ID_OFF  (34UL)
+#define FD_METRICS_COUNTER_SHRED_INVALID_BLOCK_ID_OFF  (119UL)
 #define FD_METRICS_COUNTER_SHRED_INVALID_BLOCK_ID_NAME "shred_invalid_block_id"
 #define FD_METRICS_COUNTER_SHRED_INVALID_BLOCK_ID_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_INVALID_BLOCK_ID_DESC "The number of times a block was created with unknown parent block_id"
 #define FD_METRICS_COUNTER_SHRED_INVALID_BLOCK_ID_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_OFF  (35UL)
+#define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_OFF  (120UL)
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_NAME "shred_batch_sz"
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_DESC "The size (in bytes) of each microblock batch that is shredded"
@@ -31,7 +31,7 @@
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_MIN  (1024UL)
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_SZ_MAX  (65536UL)
 
-#define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_OFF  (52UL)
+#define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_OFF  (137UL)
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_NAME "shred_batch_microblock_cnt"
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_DESC "The number of microblocks in each microblock batch that is shredded"
@@ -39,7 +39,7 @@
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_MIN  (2UL)
 #define FD_METRICS_HISTOGRAM_SHRED_BATCH_MICROBLOCK_CNT_MAX  (256UL)
 
-#define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_OFF  (69UL)
+#define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_OFF  (154UL)
 #define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_NAME "shred_shredding_duration_seconds"
 #define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_DESC "Duration of producing one FEC set from the shredder"
@@ -47,7 +47,7 @@
 #define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_MIN  (1e-05)
 #define FD_METRICS_HISTOGRAM_SHRED_SHREDDING_DURATION_SECONDS_MAX  (0.01)
 
-#define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_OFF  (86UL)
+#define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_OFF  (171UL)
 #define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_NAME "shred_add_shred_duration_seconds"
 #define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_TYPE (FD_METRICS_TYPE_HISTOGRAM)
 #define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_DESC "Duration of verifying and processing one shred received from the network"
@@ -55,51 +55,51 @@
 #define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_MIN  (1e-08)
 #define FD_METRICS_HISTOGRAM_SHRED_ADD_SHRED_DURATION_SECONDS_MAX  (0.001)
 
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_OFF  (103UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_OFF  (188UL)
 #define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_NAME "shred_shred_processed"
 #define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_DESC "The result of processing a thread from the network"
 #define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_CVT  (FD_METRICS_CONVERTER_NONE)
 #define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_CNT  (6UL)
 
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_BAD_SLOT_OFF (103UL)
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_PARSE_FAILED_OFF (104UL)
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_REJECTED_OFF (105UL)
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_IGNORED_OFF (106UL)
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_OKAY_OFF (107UL)
-#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_COMPLETES_OFF (108UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_BAD_SLOT_OFF (188UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_PARSE_FAILED_OFF (189UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_REJECTED_OFF (190UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_IGNORED_OFF (191UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_OKAY_OFF (192UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_PROCESSED_COMPLETES_OFF (193UL)
 
-#define FD_METRICS_COUNTER_SHRED_FEC_SET_SPILLED_OFF  (109UL)
+#define FD_METRICS_COUNTER_SHRED_FEC_SET_SPILLED_OFF  (194UL)
 #define FD_METRICS_COUNTER_SHRED_FEC_SET_SPILLED_NAME "shred_fec_set_spilled"
 #define FD_METRICS_COUNTER_SHRED_FEC_SET_SPILLED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FEC_SET_SPILLED_DESC "The number of FEC sets that were spilled because they didn't complete in time and we needed space"
 #define FD_METRICS_COUNTER_SHRED_FEC_SET_SPILLED_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_SHRED_REJECTED_INITIAL_OFF  (110UL)
+#define FD_METRICS_COUNTER_SHRED_SHRED_REJECTED_INITIAL_OFF  (195UL)
 #define FD_METRICS_COUNTER_SHRED_SHRED_REJECTED_INITIAL_NAME "shred_shred_rejected_initial"
 #define FD_METRICS_COUNTER_SHRED_SHRED_REJECTED_INITIAL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_SHRED_REJECTED_INITIAL_DESC "The number shreds that were rejected before any resources were allocated for the FEC set"
 #define FD_METRICS_COUNTER_SHRED_SHRED_REJECTED_INITIAL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_OFF  (111UL)
+#define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_OFF  (196UL)
 #define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_NAME "shred_fec_rejected_fatal"
 #define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_DESC "The number of FEC sets that were rejected for reasons that cause the whole FEC set to become invalid"
 #define FD_METRICS_COUNTER_SHRED_FEC_REJECTED_FATAL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_OFF  (112UL)
+#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_OFF  (197UL)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_NAME "shred_force_complete_request"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_DESC "The number of times we recieved a FEC force complete message"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_REQUEST_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_OFF  (113UL)
+#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_OFF  (198UL)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_NAME "shred_force_complete_failure"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_DESC "The number of times we failed to force complete a FEC set on request"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_FAILURE_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_OFF  (114UL)
+#define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_OFF  (199UL)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_NAME "shred_force_complete_success"
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SHRED_FORCE_COMPLETE_SUCCESS_DESC "The number of times we successfully forced completed a FEC set on request"
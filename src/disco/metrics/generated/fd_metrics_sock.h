@@ -3,43 +3,43 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_COUNTER_SOCK_SYSCALLS_SENDMMSG_OFF  (16UL)
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_SENDMMSG_OFF  (101UL)
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_SENDMMSG_NAME "sock_syscalls_sendmmsg"
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_SENDMMSG_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_SENDMMSG_DESC "Number of sendmmsg syscalls dispatched"
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_SENDMMSG_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SOCK_SYSCALLS_RECVMMSG_OFF  (17UL)
+#define FD_METRICS_COUNTER_SOCK_SYSCALLS_RECVMMSG_OFF  (102UL)
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_RECVMMSG_NAME "sock_syscalls_recvmmsg"
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_RECVMMSG_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_RECVMMSG_DESC "Number of recvmsg syscalls dispatched"
 #define FD_METRICS_COUNTER_SOCK_SYSCALLS_RECVMMSG_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SOCK_RX_PKT_CNT_OFF  (18UL)
+#define FD_METRICS_COUNTER_SOCK_RX_PKT_CNT_OFF  (103UL)
 #define FD_METRICS_COUNTER_SOCK_RX_PKT_CNT_NAME "sock_rx_pkt_cnt"
 #define FD_METRICS_COUNTER_SOCK_RX_PKT_CNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_RX_PKT_CNT_DESC "Number of packets received"
 #define FD_METRICS_COUNTER_SOCK_RX_PKT_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SOCK_TX_PKT_CNT_OFF  (19UL)
+#define FD_METRICS_COUNTER_SOCK_TX_PKT_CNT_OFF  (104UL)
 #define FD_METRICS_COUNTER_SOCK_TX_PKT_CNT_NAME "sock_tx_pkt_cnt"
 #define FD_METRICS_COUNTER_SOCK_TX_PKT_CNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_TX_PKT_CNT_DESC "Number of packets sent"
 #define FD_METRICS_COUNTER_SOCK_TX_PKT_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SOCK_TX_DROP_CNT_OFF  (20UL)
+#define FD_METRICS_COUNTER_SOCK_TX_DROP_CNT_OFF  (105UL)
 #define FD_METRICS_COUNTER_SOCK_TX_DROP_CNT_NAME "sock_tx_drop_cnt"
 #define FD_METRICS_COUNTER_SOCK_TX_DROP_CNT_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_TX_DROP_CNT_DESC "Number of packets failed to send"
 #define FD_METRICS_COUNTER_SOCK_TX_DROP_CNT_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SOCK_TX_BYTES_TOTAL_OFF  (21UL)
+#define FD_METRICS_COUNTER_SOCK_TX_BYTES_TOTAL_OFF  (106UL)
 #define FD_METRICS_COUNTER_SOCK_TX_BYTES_TOTAL_NAME "sock_tx_bytes_total"
 #define FD_METRICS_COUNTER_SOCK_TX_BYTES_TOTAL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_TX_BYTES_TOTAL_DESC "Total number of bytes transmitted (including Ethernet header)."
 #define FD_METRICS_COUNTER_SOCK_TX_BYTES_TOTAL_CVT  (FD_METRICS_CONVERTER_NONE)
 
-#define FD_METRICS_COUNTER_SOCK_RX_BYTES_TOTAL_OFF  (22UL)
+#define FD_METRICS_COUNTER_SOCK_RX_BYTES_TOTAL_OFF  (107UL)
 #define FD_METRICS_COUNTER_SOCK_RX_BYTES_TOTAL_NAME "sock_rx_bytes_total"
 #define FD_METRICS_COUNTER_SOCK_RX_BYTES_TOTAL_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_SOCK_RX_BYTES_TOTAL_DESC "Total number of bytes received (including Ethernet header)."
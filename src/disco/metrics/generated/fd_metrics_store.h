@@ -3,7 +3,7 @@
 #include "../fd_metrics_base.h"
 #include "fd_metrics_enums.h"
 
-#define FD_METRICS_COUNTER_STORE_TRANSACTIONS_INSERTED_OFF  (16UL)
+#define FD_METRICS_COUNTER_STORE_TRANSACTIONS_INSERTED_OFF  (101UL)
 #define FD_METRICS_COUNTER_STORE_TRANSACTIONS_INSERTED_NAME "store_transactions_inserted"
 #define FD_METRICS_COUNTER_STORE_TRANSACTIONS_INSERTED_TYPE (FD_METRICS_TYPE_COUNTER)
 #define FD_METRICS_COUNTER_STORE_TRANSACTIONS_INSERTED_DESC "Count of transactions produced while we were leader in the shreds that have been inserted so far"
@@ -1,9 +1,12 @@
 #define _GNU_SOURCE
 #include "../tiles.h"
 
+#include <time.h> /* CLOCK_REALTIME needed for seccomp filter */
+
 #include "generated/fd_sign_tile_seccomp.h"
 
 #include "../keyguard/fd_keyguard.h"
+#include "../keyguard/fd_keyguard_client.h"
 #include "../keyguard/fd_keyload.h"
 #include "../keyguard/fd_keyswitch.h"
 #include "../../ballet/base58/fd_base58.h"
@@ -22,8 +25,30 @@ typedef struct {
   uchar *          data;
 } fd_sign_out_ctx_t;
 
+/* fd_sign_req_t is an authorized signing request waiting to be signed
+   with the rest of its batch.  data is the request as received and
+   msg_sz bytes at msg the message to sign (data itself or, for the
+   request types that sign something derived from it, aux). */
+
+typedef struct {
+  ulong         in_idx;
+  ulong         out_seq; /* Sequence number of the response */
+  uchar const * msg;
+  ulong         msg_sz;
+  uchar         aux [ 64UL ];
+  uchar         data[ FD_KEYGUARD_SIGN_REQ_MTU ];
+} fd_sign_req_t;
+
+FD_STATIC_ASSERT( FD_BASE58_ENCODED_32_SZ+1UL+9UL<=64UL && 18UL+32UL<=64UL, fd_sign_req_aux );
+
 typedef struct {
-  uchar             _data[ FD_KEYGUARD_SIGN_REQ_MTU ];
+  /* Requests are accumulated over about one pass of the stem over the
+     ins (or until FD_ED25519_SIGN_BATCH_GROUP are pending) and signed
+     together with fd_ed25519_sign_batch. */
+  ulong             in_cnt;
+  ulong             req_cnt;
+  ulong             poll_cnt; /* stem loop iterations since the first pending request */
+  fd_sign_req_t     req[ FD_ED25519_SIGN_BATCH_GROUP ];
 
   /* Pre-staged with the public key base58 encoded, followed by "-" in the first bytes */
   ulong public_key_base58_sz;
@@ -31,9 +56,10 @@ typedef struct {
 
   uchar event_concat[ 18UL+32UL ];
 
-  int               in_role[ MAX_IN ];
-  uchar *           in_data[ MAX_IN ];
-  ushort            in_mtu [ MAX_IN ];
+  int               in_role   [ MAX_IN ];
+  uchar *           in_data   [ MAX_IN ];
+  ulong             in_data_sz[ MAX_IN ];
+  ushort            in_mtu    [ MAX_IN ];
 
   fd_sign_out_ctx_t out[ MAX_IN ];
 
@@ -72,9 +98,45 @@ derive_fields( fd_sign_ctx_t * ctx ) {
   memcpy( ctx->event_concat, "FD_METRICS_REPORT-", 18UL );
 }
 
+/* sign_pending signs all pending requests together and publishes the
+   responses. */
+
+static void FD_FN_SENSITIVE
+sign_pending( fd_sign_ctx_t * ctx ) {
+  uchar *       sig   [ FD_ED25519_SIGN_BATCH_GROUP ] = {0};
+  uchar const * msg   [ FD_ED25519_SIGN_BATCH_GROUP ] = {0};
+  ulong         msg_sz[ FD_ED25519_SIGN_BATCH_GROUP ] = {0};
+
+  /* A client can have several requests pending, each is answered in
+     the response slot of its sequence number (see
+     fd_keyguard_client.h) */
+
+  ulong req_cnt = ctx->req_cnt;
+  for( ulong i=0UL; i<req_cnt; i++ ) {
+    fd_sign_req_t *     req = &ctx->req[ i ];
+    fd_sign_out_ctx_t * out = &ctx->out[ req->in_idx ];
+    req->out_seq = out->seq;
+    out->seq     = fd_seq_inc( out->seq, 1UL );
+    sig   [ i ] = out->data + (req->out_seq & (FD_KEYGUARD_CLIENT_INFLIGHT_MAX-1UL))*64UL;
+    msg   [ i ] = req->msg;
+    msg_sz[ i ] = req->msg_sz;
+  }
+  fd_ed25519_sign_batch( req_cnt, sig, msg, msg_sz, ctx->public_key, ctx->private_key, ctx->sha512 );
+
+  for( ulong i=0UL; i<req_cnt; i++ ) {
+    fd_sign_req_t const * req = &ctx->req[ i ];
+    ulong chunk = req->out_seq & (FD_KEYGUARD_CLIENT_INFLIGHT_MAX-1UL);
+    fd_mcache_publish( ctx->out[ req->in_idx ].mcache, 128UL, req->out_seq, 0UL, chunk, 64UL, 0UL, 0UL, 0UL );
+  }
+  ctx->req_cnt = 0UL;
+}
+
 static void FD_FN_SENSITIVE
 during_housekeeping_sensitive( fd_sign_ctx_t * ctx ) {
   if( FD_UNLIKELY( fd_keyswitch_state_query( ctx->keyswitch )==FD_KEYSWITCH_STATE_SWITCH_PENDING ) ) {
+    /* Pending requests were authorized for the current identity */
+    if( FD_UNLIKELY( ctx->req_cnt ) ) sign_pending( ctx );
+
     memcpy( ctx->private_key, ctx->keyswitch->bytes, 32UL );
     explicit_bzero( ctx->keyswitch->bytes, 32UL );
     FD_COMPILER_MFENCE();
@@ -90,6 +152,25 @@ during_housekeeping( fd_sign_ctx_t * ctx ) {
   during_housekeeping_sensitive( ctx );
 }
 
+static void FD_FN_SENSITIVE
+before_credit_sensitive( fd_sign_ctx_t * ctx,
+                         int *           charge_busy ) {
+  /* Once every in has (about) been polled since the first pending
+     request arrived, nothing else is coming soon */
+  if( FD_LIKELY( !ctx->req_cnt ) ) return;
+  if( FD_LIKELY( ++ctx->poll_cnt<ctx->in_cnt ) ) return;
+  sign_pending( ctx );
+  *charge_busy = 1;
+}
+
+static inline void
+before_credit( fd_sign_ctx_t *     ctx,
+               fd_stem_context_t * stem,
+               int *               charge_busy ) {
+  (void)stem;
+  before_credit_sensitive( ctx, charge_busy );
+}
+
 /* during_frag is called between pairs for sequence number checks, as
    we are reading incoming frags.  We don't actually need to copy the
    fragment here, see fd_dedup.c for why we do this.*/
@@ -103,7 +184,6 @@ during_frag_sensitive( void * _ctx,
                        ulong  sz ) {
   (void)seq;
   (void)sig;
-  (void)chunk;
 
   fd_sign_ctx_t * ctx = (fd_sign_ctx_t *)_ctx;
   FD_TEST( in_idx<MAX_IN );
@@ -114,7 +194,11 @@ during_frag_sensitive( void * _ctx,
   if( sz>mtu ) {
     FD_LOG_EMERG(( "oversz signing request (role=%d sz=%lu mtu=%u)", role, sz, mtu ));
   }
-  fd_memcpy( ctx->_data, ctx->in_data[ in_idx ], sz );
+  /* chunk is relative to the start of the in's dcache */
+  if( FD_UNLIKELY( (chunk<<FD_CHUNK_LG_SZ)+sz>ctx->in_data_sz[ in_idx ] ) ) {
+    FD_LOG_EMERG(( "corrupt signing request (role=%d chunk=%lu sz=%lu)", role, chunk, sz ));
+  }
+  fd_memcpy( ctx->req[ ctx->req_cnt ].data, fd_chunk_to_laddr_const( ctx->in_data[ in_idx ], chunk ), sz );
 }
 
 
@@ -154,37 +238,45 @@ after_frag_sensitive( void *              _ctx,
   fd_keyguard_authority_t authority = {0};
   memcpy( authority.identity_pubkey, ctx->public_key, 32 );
 
-  if( FD_UNLIKELY( !fd_keyguard_payload_authorize( &authority, ctx->_data, sz, role, sign_type ) ) ) {
+  fd_sign_req_t * req = &ctx->req[ ctx->req_cnt ];
+
+  if( FD_UNLIKELY( !fd_keyguard_payload_authorize( &authority, req->data, sz, role, sign_type ) ) ) {
     FD_LOG_EMERG(( "fd_keyguard_payload_authorize failed (role=%d sign_type=%d)", role, sign_type ));
   }
 
   switch( sign_type ) {
   case FD_KEYGUARD_SIGN_TYPE_ED25519: {
-    fd_ed25519_sign( ctx->out[ in_idx ].data, ctx->_data, sz, ctx->public_key, ctx->private_key, ctx->sha512 );
+    req->msg    = req->data;
+    req->msg_sz = sz;
     break;
   }
   case FD_KEYGUARD_SIGN_TYPE_SHA256_ED25519: {
-    uchar hash[ 32 ];
-    fd_sha256_hash( ctx->_data, sz, hash );
-    fd_ed25519_sign( ctx->out[ in_idx ].data, hash, 32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+    fd_sha256_hash( req->data, sz, req->aux );
+    req->msg    = req->aux;
+    req->msg_sz = 32UL;
     break;
   }
   case FD_KEYGUARD_SIGN_TYPE_PUBKEY_CONCAT_ED25519: {
-    memcpy( ctx->concat+ctx->public_key_base58_sz+1UL, ctx->_data, 9UL );
-    fd_ed25519_sign( ctx->out[ in_idx ].data, ctx->concat, ctx->public_key_base58_sz+1UL+9UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+    memcpy( ctx->concat+ctx->public_key_base58_sz+1UL, req->data, 9UL );
+    memcpy( req->aux, ctx->concat, ctx->public_key_base58_sz+1UL+9UL );
+    req->msg    = req->aux;
+    req->msg_sz = ctx->public_key_base58_sz+1UL+9UL;
     break;
   }
   case FD_KEYGUARD_SIGN_TYPE_FD_METRICS_REPORT_CONCAT_ED25519: {
-    memcpy( ctx->event_concat+18UL, ctx->_data, 32UL );
-    fd_ed25519_sign( ctx->out[ in_idx ].data, ctx->event_concat, 18UL+32UL, ctx->public_key, ctx->private_key, ctx->sha512 );
+    memcpy( ctx->event_concat+18UL, req->data, 32UL );
+    memcpy( req->aux, ctx->event_concat, 18UL+32UL );
+    req->msg    = req->aux;
+    req->msg_sz = 18UL+32UL;
     break;
   }
   default:
     FD_LOG_EMERG(( "invalid sign type: %d", sign_type ));
   }
 
-  fd_mcache_publish( ctx->out[ in_idx ].mcache, 128UL, ctx->out[ in_idx ].seq, 0UL, 0UL, 0UL, 0UL, 0UL, 0UL );
-  ctx->out[ in_idx ].seq = fd_seq_inc( ctx->out[ in_idx ].seq, 1UL );
+  req->in_idx = in_idx;
+  if( FD_LIKELY( !ctx->req_cnt ) ) ctx->poll_cnt = 0UL;
+  if( FD_UNLIKELY( ++ctx->req_cnt==FD_ED25519_SIGN_BATCH_GROUP ) ) sign_pending( ctx );
 }
 
 static void
@@ -252,17 +344,22 @@ unprivileged_init_sensitive( fd_topo_t *      topo,
 
   for( ulong i=0UL; i<MAX_IN; i++ ) ctx->in_role[ i ] = -1;
 
+  ctx->in_cnt  = tile->in_cnt;
+  ctx->req_cnt = 0UL;
+
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * in_link = &topo->links[ tile->in_link_id[ i ] ];
     fd_topo_link_t * out_link = &topo->links[ tile->out_link_id[ i ] ];
 
     if( in_link->mtu > FD_KEYGUARD_SIGN_REQ_MTU ) FD_LOG_CRIT(( "oversz link[%lu].mtu=%lu", i, in_link->mtu ));
-    ctx->in_data[ i ] = in_link->dcache;
-    ctx->in_mtu [ i ] = (ushort)in_link->mtu;
+    ctx->in_data   [ i ] = in_link->dcache;
+    ctx->in_data_sz[ i ] = fd_dcache_data_sz( in_link->dcache );
+    ctx->in_mtu    [ i ] = (ushort)in_link->mtu;
 
     ctx->out[ i ].mcache = out_link->mcache;
     ctx->out[ i ].data   = out_link->dcache;
     ctx->out[ i ].seq    = 0UL;
+    FD_TEST( fd_dcache_data_sz( out_link->dcache )>=FD_KEYGUARD_CLIENT_INFLIGHT_MAX*64UL );
 
     if( !strcmp( in_link->name, "shred_sign" ) ) {
       ctx->in_role[ i ] = FD_KEYGUARD_ROLE_LEADER;
@@ -353,6 +450,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 #define STEM_CALLBACK_CONTEXT_ALIGN alignof(fd_sign_ctx_t)
 
 #define STEM_CALLBACK_DURING_HOUSEKEEPING during_housekeeping
+#define STEM_CALLBACK_BEFORE_CREDIT       before_credit
 #define STEM_CALLBACK_DURING_FRAG         during_frag
 #define STEM_CALLBACK_AFTER_FRAG          after_frag
 
@@ -360,6 +458,7 @@ populate_allowed_fds( fd_topo_t const *      topo,
 
 fd_topo_run_tile_t fd_tile_sign = {
   .name                     = "sign",
+  .allow_idle_sleep         = 1,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
   .scratch_align            = scratch_align,
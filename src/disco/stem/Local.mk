@@ -0,0 +1,4 @@
+ifdef FD_HAS_SSE
+$(call make-unit-test,test_stem,test_stem,fd_disco fd_tango fd_util)
+$(call run-unit-test,test_stem)
+endif
@@ -131,7 +131,68 @@
       AFTER_POLL_OVERRUN
    Is called when an overrun is detected while polling for new frags.
    This callback is not called when an overrun is detected in
-   during_frag. */
+   during_frag.
+
+      DURING_FRAG_BATCH
+   Is an alternative to DURING_FRAG for tiles that process frags in
+   bulk (e.g. with SIMD across frags).  When a new frag is detected on an
+   in, the stem gathers up to STEM_BATCH_MAX (default 16) consecutive
+   ready frags from that in (calling BEFORE_FRAG on each, filtered frags
+   are skipped as usual) and hands them to this callback in a single
+   call as an array of fd_stem_frag_t, in sequence order.  The same
+   caveats as DURING_FRAG apply: the frags may be overrun by the
+   producer while the callback is running.  Once the callback returns,
+   the stem checks each frag for overrun in order.  The frags before the
+   first overrun one are then passed, one at a time, to AFTER_FRAG and
+   the rest are abandoned (as for DURING_FRAG, the stem recovers and
+   continues with new frags).  Since AFTER_FRAG may be called for a
+   whole batch before credits are checked again, a tile that publishes
+   per frag should set STEM_BURST to cover a full batch (see also
+   fd_stem_publish_batch).  DURING_FRAG and DURING_FRAG_BATCH cannot both
+   be defined.  When profiling (below), a batch is one DURING_FRAG
+   sample.
+
+   If FD_STEM_PROFILE is enabled (building with EXTRAS=stem-profile),
+   the duration in ticks of every BEFORE_FRAG, DURING_FRAG, AFTER_FRAG,
+   AFTER_CREDIT and DURING_HOUSEKEEPING call is accumulated into a
+   histogram and published with the other tile metrics during
+   housekeeping (tile_*_duration_seconds).  This costs two tickcount
+   reads per callback, so it is disabled by default, in which case the
+   instrumentation compiles out completely and the histograms are not
+   exported.  The flag must be set for the whole build (not per tile) as
+   it also gates the metric declarations in fd_metrics_all.c.
+
+   A tile can opt in to backing off when it is idle (see fd_tempo_idle_t
+   in fd_tempo.h) by setting idle_wake_ns in its topology tile (e.g. the
+   layout.idle_tiles config option).  After STEM_IDLE_SPIN_MAX
+   consecutive loop iterations with no frag to process and no callback
+   charging busy, each further idle iteration waits up to idle_wake_ns
+   before polling again, monitoring the mcache line of the next frag
+   with UMWAIT where supported.  This bounds the added latency to pick
+   up new work to roughly idle_wake_ns while letting light tiles (e.g.
+   gossip, metric, gui, sign) stop burning their core.  If the topology
+   tile also sets idle_sleep (the layout.idle_sleep_tiles config
+   option), the tile sleeps in the kernel once fully backed off when
+   UMWAIT is not available (e.g. on AMD), which is what actually frees
+   the core for other tiles.  Only tiles whose seccomp policy allows
+   clock_nanosleep (and so set allow_idle_sleep in their
+   fd_topo_run_tile_t) can be configured to sleep.
+
+   The stem also keeps per link telemetry, so that when something is
+   late it is possible to tell which hop in the pipeline added the
+   delay.  For each in, the age of every consumed frag is sampled into
+   two histograms: the time since it was published (from tspub, i.e.
+   the latency of this hop) and the time since its origin (from
+   tsorig, i.e. the latency of the pipeline so far).  Frags with a zero
+   timestamp are not sampled.  Timestamps are compressed tickcounts
+   (see fd_frag_meta_ts_comp), so ages beyond roughly a second alias.
+   Also sampled at housekeeping are each in's lag (how many frags the
+   producer is ahead of this consumer, and its high water mark) and,
+   for each reliable consumer of an out, the occupancy of the out's
+   mcache (how many frags are published but not yet credited back by
+   that consumer, and its high water mark).  These are published with
+   the link metrics (link_hop_latency_seconds, link_lag, link_occupancy,
+   etc). */
 
 #if !FD_HAS_SSE
 #error "fd_stem requires SSE"
@@ -162,12 +223,81 @@
 #define STEM_LAZY (0L)
 #endif
 
+#ifndef FD_STEM_PROFILE
+#define FD_STEM_PROFILE 0
+#endif
+
+#ifndef STEM_IDLE_SPIN_MAX
+#define STEM_IDLE_SPIN_MAX (1024UL)
+#endif
+
+#ifdef STEM_CALLBACK_DURING_FRAG_BATCH
+#ifdef STEM_CALLBACK_DURING_FRAG
+#error "STEM_CALLBACK_DURING_FRAG and STEM_CALLBACK_DURING_FRAG_BATCH are mutually exclusive"
+#endif
+#ifndef STEM_BATCH_MAX
+#define STEM_BATCH_MAX (16UL)
+#endif
+#endif
+
+/* STEM_PROFILE_CALL( hist_idx, stmt ) runs stmt (a callback
+   invocation), sampling its duration into histogram hist_idx of
+   prof_hist if profiling is enabled. */
+
+#define STEM_PROFILE_BEFORE_FRAG         (0UL)
+#define STEM_PROFILE_DURING_FRAG         (1UL)
+#define STEM_PROFILE_AFTER_FRAG          (2UL)
+#define STEM_PROFILE_AFTER_CREDIT        (3UL)
+#define STEM_PROFILE_DURING_HOUSEKEEPING (4UL)
+#define STEM_PROFILE_CNT                 (5UL)
+
+/* STEM_IN_HIST_{HOP,ORIGIN} index the frag age histograms of an in,
+   in_hist[ 2*in_idx + STEM_IN_HIST_* ] (see above). */
+
+#define STEM_IN_HIST_HOP    (0UL)
+#define STEM_IN_HIST_ORIGIN (1UL)
+#define STEM_IN_HIST_CNT    (2UL)
+
+#if FD_STEM_PROFILE
+#define STEM_PROFILE_CALL( hist_idx, stmt ) do {                              \
+    long _stem_prof_t0 = fd_tickcount();                                      \
+    stmt;                                                                     \
+    fd_histf_sample( prof_hist+(hist_idx), (ulong)(fd_tickcount()-_stem_prof_t0) ); \
+  } while(0)
+#else
+#define STEM_PROFILE_CALL( hist_idx, stmt ) do { stmt; } while(0)
+#endif
+
+/* STEM_(in_sample_age) samples the age at tick now of a frag with the
+   given compressed timestamps into the in's histograms hist. */
+
 static inline void
-STEM_(in_update)( fd_stem_tile_in_t * in ) {
+STEM_(in_sample_age)( fd_histf_t * hist,
+                      ulong        tsorig,
+                      ulong        tspub,
+                      long         now ) {
+  if( FD_LIKELY( tspub  ) ) fd_histf_sample( hist+STEM_IN_HIST_HOP,    (ulong)fd_long_max( now - fd_frag_meta_ts_decomp( tspub,  now ), 0L ) );
+  if( FD_LIKELY( tsorig ) ) fd_histf_sample( hist+STEM_IN_HIST_ORIGIN, (ulong)fd_long_max( now - fd_frag_meta_ts_decomp( tsorig, now ), 0L ) );
+}
+
+static inline void
+STEM_(hist_copy)( volatile ulong *   metrics,
+                  fd_histf_t const * hist ) {
+  for( ulong i=0UL; i<FD_HISTF_BUCKET_CNT; i++ ) metrics[ i ] = hist->counts[ i ];
+  metrics[ FD_HISTF_BUCKET_CNT ] = hist->sum;
+}
+
+static inline void
+STEM_(in_update)( fd_stem_tile_in_t * in,
+                  fd_histf_t const *  hist ) {
   fd_fseq_update( in->fseq, in->seq );
 
   volatile ulong * metrics = fd_metrics_link_in( fd_metrics_base_tl, in->idx );
 
+  /* The producer only updates the mcache's seq lazily (and not at all
+     for a multi producer mcache), so this is a lower bound */
+  ulong lag = (ulong)fd_long_max( fd_seq_diff( fd_mcache_seq_query( fd_mcache_seq_laddr_const( in->mcache ) ), in->seq ), 0L );
+
   uint *  accum = in->accum;
   ulong a0 = (ulong)accum[0]; ulong a1 = (ulong)accum[1]; ulong a2 = (ulong)accum[2];
   ulong a3 = (ulong)accum[3]; ulong a4 = (ulong)accum[4]; ulong a5 = (ulong)accum[5];
@@ -175,6 +305,11 @@ STEM_(in_update)( fd_stem_tile_in_t * in ) {
   metrics[0] += a0;           metrics[1] += a1;           metrics[2] += a2;
   metrics[3] += a3;           metrics[4] += a4;           metrics[5] += a5;
   FD_COMPILER_MFENCE();
+  metrics[ FD_METRICS_GAUGE_LINK_LAG_OFF     ] = lag;
+  metrics[ FD_METRICS_GAUGE_LINK_LAG_MAX_OFF ] = fd_ulong_max( metrics[ FD_METRICS_GAUGE_LINK_LAG_MAX_OFF ], lag );
+  STEM_(hist_copy)( metrics + FD_METRICS_HISTOGRAM_LINK_HOP_LATENCY_SECONDS_OFF,    hist+STEM_IN_HIST_HOP    );
+  STEM_(hist_copy)( metrics + FD_METRICS_HISTOGRAM_LINK_ORIGIN_LATENCY_SECONDS_OFF, hist+STEM_IN_HIST_ORIGIN );
+  FD_COMPILER_MFENCE();
   accum[0] = 0U;              accum[1] = 0U;              accum[2] = 0U;
   accum[3] = 0U;              accum[4] = 0U;              accum[5] = 0U;
 }
@@ -190,6 +325,7 @@ STEM_(scratch_footprint)( ulong in_cnt,
                           ulong cons_cnt ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof(fd_stem_tile_in_t), in_cnt*sizeof(fd_stem_tile_in_t)     );  /* in */
+  l = FD_LAYOUT_APPEND( l, FD_HISTF_ALIGN,             in_cnt*STEM_IN_HIST_CNT*sizeof(fd_histf_t) ); /* in_hist */
   l = FD_LAYOUT_APPEND( l, alignof(ulong),             out_cnt*sizeof(ulong)                ); /* out_depth */
   l = FD_LAYOUT_APPEND( l, alignof(ulong),             out_cnt*sizeof(ulong)                ); /* out_seq */
   l = FD_LAYOUT_APPEND( l, alignof(ulong const *),     cons_cnt*sizeof(ulong const *)       ); /* cons_fseq */
@@ -212,6 +348,8 @@ STEM_(run1)( ulong                        in_cnt,
              ulong **                     _cons_fseq,
              ulong                        burst,
              long                         lazy,
+             long                         idle_wake_ns,
+             int                          idle_sleep,
              fd_rng_t *                   rng,
              void *                       scratch,
              STEM_CALLBACK_CONTEXT_TYPE * ctx ) {
@@ -220,6 +358,8 @@ STEM_(run1)( ulong                        in_cnt,
   fd_stem_tile_in_t * in;     /* in[in_seq] for in_seq in [0,in_cnt) has information about input fragment stream currently at
                                  position in_seq in the in_idx polling sequence.  The ordering of this array is continuously
                                  shuffled to avoid lighthousing effects in the output fragment stream at extreme fan-in and load */
+  fd_histf_t *        in_hist; /* in_hist[ STEM_IN_HIST_CNT*in_idx + STEM_IN_HIST_* ] are the frag age histograms in ticks of
+                                  in in_idx (indexed by the in's idx, not its position in the polling sequence) */
 
   /* out frag stream state */
   ulong *        out_depth; /* ==fd_mcache_depth( out_mcache[out_idx] ) for out_idx in [0, out_cnt) */
@@ -244,6 +384,20 @@ STEM_(run1)( ulong                        in_cnt,
 
   ulong metric_regime_ticks[9];    /* How many ticks the tile has spent in each regime */
 
+  fd_tempo_idle_t idle[1];         /* Backoff state when the tile has nothing to do */
+
+#ifdef STEM_CALLBACK_DURING_FRAG_BATCH
+  fd_stem_frag_t batch[ STEM_BATCH_MAX ]; /* Frags gathered for the current DURING_FRAG_BATCH call */
+#endif
+
+#if FD_STEM_PROFILE
+  fd_histf_t prof_hist[ STEM_PROFILE_CNT ]; /* Callback duration histograms in ticks, indexed by STEM_PROFILE_* */
+  for( ulong i=0UL; i<STEM_PROFILE_CNT; i++ ) {
+    FD_TEST( fd_histf_join( fd_histf_new( prof_hist+i, FD_MHIST_SECONDS_MIN( TILE, BEFORE_FRAG_DURATION_SECONDS ),
+                                                       FD_MHIST_SECONDS_MAX( TILE, BEFORE_FRAG_DURATION_SECONDS ) ) ) );
+  }
+#endif
+
   if( FD_UNLIKELY( !scratch ) ) FD_LOG_ERR(( "NULL scratch" ));
   if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)scratch, STEM_(scratch_align)() ) ) ) FD_LOG_ERR(( "misaligned scratch" ));
 
@@ -258,7 +412,8 @@ STEM_(run1)( ulong                        in_cnt,
   in_seq = 0UL; /* First in to poll */
 
   FD_SCRATCH_ALLOC_INIT( l, scratch );
-  in = (fd_stem_tile_in_t *)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_stem_tile_in_t), in_cnt*sizeof(fd_stem_tile_in_t) );
+  in      = (fd_stem_tile_in_t *)FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_stem_tile_in_t), in_cnt*sizeof(fd_stem_tile_in_t) );
+  in_hist = (fd_histf_t *)       FD_SCRATCH_ALLOC_APPEND( l, FD_HISTF_ALIGN,             in_cnt*STEM_IN_HIST_CNT*sizeof(fd_histf_t) );
 
   ulong min_in_depth = (ulong)LONG_MAX;
 
@@ -284,6 +439,12 @@ STEM_(run1)( ulong                        in_cnt,
 
     this_in->accum[0] = 0U; this_in->accum[1] = 0U; this_in->accum[2] = 0U;
     this_in->accum[3] = 0U; this_in->accum[4] = 0U; this_in->accum[5] = 0U;
+
+    fd_histf_t * hist = in_hist + STEM_IN_HIST_CNT*in_idx;
+    FD_TEST( fd_histf_join( fd_histf_new( hist+STEM_IN_HIST_HOP,    FD_MHIST_SECONDS_MIN( LINK, HOP_LATENCY_SECONDS    ),
+                                                                    FD_MHIST_SECONDS_MAX( LINK, HOP_LATENCY_SECONDS    ) ) ) );
+    FD_TEST( fd_histf_join( fd_histf_new( hist+STEM_IN_HIST_ORIGIN, FD_MHIST_SECONDS_MIN( LINK, ORIGIN_LATENCY_SECONDS ),
+                                                                    FD_MHIST_SECONDS_MAX( LINK, ORIGIN_LATENCY_SECONDS ) ) ) );
   }
 
   /* out frag stream init */
@@ -338,6 +499,14 @@ STEM_(run1)( ulong                        in_cnt,
   async_min = fd_tempo_async_min( lazy, event_cnt, (float)fd_tempo_tick_per_ns( NULL ) );
   if( FD_UNLIKELY( !async_min ) ) FD_LOG_ERR(( "bad lazy %lu %lu", (ulong)lazy, event_cnt ));
 
+  /* idle backoff init */
+
+  if( FD_UNLIKELY( !fd_tempo_idle_init( idle, STEM_IDLE_SPIN_MAX, idle_wake_ns, idle_sleep ? FD_TEMPO_IDLE_FLAG_SLEEP : 0 ) ) )
+    FD_LOG_ERR(( "bad idle_wake_ns %li", idle_wake_ns ));
+  if( FD_UNLIKELY( idle_wake_ns ) )
+    FD_LOG_INFO(( "Configuring idle backoff (wake %li ns, %s)", idle_wake_ns,
+                  idle->waitpkg ? "umwait" : ( idle->sleep ? "sleep" : "pause" ) ));
+
   FD_LOG_INFO(( "Running stem" ));
   FD_MGAUGE_SET( TILE, STATUS, 1UL );
   long then = fd_tickcount();
@@ -363,13 +532,22 @@ STEM_(run1)( ulong                        in_cnt,
         /* Receive flow control credits from this out. */
         cons_seq[ cons_idx ] = fd_fseq_query( cons_fseq[ cons_idx ] );
 
+        /* Sample how full the out's mcache is from this consumer's
+           point of view. */
+        volatile ulong * cons_metrics = fd_metrics_link_out( fd_metrics_base_tl, cons_idx );
+        ulong occupancy = (ulong)fd_long_max( fd_seq_diff( out_seq[ cons_out[ cons_idx ] ], cons_seq[ cons_idx ] ), 0L );
+        FD_COMPILER_MFENCE();
+        cons_metrics[ FD_METRICS_GAUGE_LINK_OCCUPANCY_OFF     ] = occupancy;
+        cons_metrics[ FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_OFF ] = fd_ulong_max( cons_metrics[ FD_METRICS_GAUGE_LINK_OCCUPANCY_MAX_OFF ], occupancy );
+        FD_COMPILER_MFENCE();
+
       } else if( FD_LIKELY( event_idx>cons_cnt ) ) { /* in fctl for in in_idx */
         ulong in_idx = event_idx - cons_cnt - 1UL;
 
         /* Send flow control credits and drain flow control diagnostics
            for in_idx. */
 
-        STEM_(in_update)( &in[ in_idx ] );
+        STEM_(in_update)( &in[ in_idx ], in_hist + STEM_IN_HIST_CNT*in[ in_idx ].idx );
 
       } else { /* event_idx==cons_cnt, housekeeping event */
 
@@ -379,6 +557,13 @@ STEM_(run1)( ulong                        in_cnt,
         FD_MGAUGE_SET( TILE, IN_BACKPRESSURE,           metric_in_backp );
         FD_MCNT_INC  ( TILE, BACKPRESSURE_COUNT,        metric_backp_cnt );
         FD_MCNT_ENUM_COPY( TILE, REGIME_DURATION_NANOS, metric_regime_ticks );
+#if FD_STEM_PROFILE
+        FD_MHIST_COPY( TILE, BEFORE_FRAG_DURATION_SECONDS,         ( prof_hist+STEM_PROFILE_BEFORE_FRAG         ) );
+        FD_MHIST_COPY( TILE, DURING_FRAG_DURATION_SECONDS,         ( prof_hist+STEM_PROFILE_DURING_FRAG         ) );
+        FD_MHIST_COPY( TILE, AFTER_FRAG_DURATION_SECONDS,          ( prof_hist+STEM_PROFILE_AFTER_FRAG          ) );
+        FD_MHIST_COPY( TILE, AFTER_CREDIT_DURATION_SECONDS,        ( prof_hist+STEM_PROFILE_AFTER_CREDIT        ) );
+        FD_MHIST_COPY( TILE, DURING_HOUSEKEEPING_DURATION_SECONDS, ( prof_hist+STEM_PROFILE_DURING_HOUSEKEEPING ) );
+#endif
 #ifdef STEM_CALLBACK_METRICS_WRITE
         STEM_CALLBACK_METRICS_WRITE( ctx );
 #endif
@@ -404,7 +589,7 @@ STEM_(run1)( ulong                        in_cnt,
         }
 
 #ifdef STEM_CALLBACK_DURING_HOUSEKEEPING
-        STEM_CALLBACK_DURING_HOUSEKEEPING( ctx );
+        STEM_PROFILE_CALL( STEM_PROFILE_DURING_HOUSEKEEPING, STEM_CALLBACK_DURING_HOUSEKEEPING( ctx ) );
 #else
         (void)ctx;
 #endif
@@ -486,7 +671,7 @@ STEM_(run1)( ulong                        in_cnt,
 #ifdef STEM_CALLBACK_AFTER_CREDIT
     int poll_in = 1;
     int charge_busy_after = 0;
-    STEM_CALLBACK_AFTER_CREDIT( ctx, &stem, &poll_in, &charge_busy_after );
+    STEM_PROFILE_CALL( STEM_PROFILE_AFTER_CREDIT, STEM_CALLBACK_AFTER_CREDIT( ctx, &stem, &poll_in, &charge_busy_after ) );
     if( FD_UNLIKELY( !poll_in ) ) {
       metric_regime_ticks[1] += housekeeping_ticks;
       long next = fd_tickcount();
@@ -496,9 +681,19 @@ STEM_(run1)( ulong                        in_cnt,
     }
 #endif
 
+    int idle_busy = 0;
+#ifdef STEM_CALLBACK_BEFORE_CREDIT
+    idle_busy |= charge_busy_before;
+#endif
+#ifdef STEM_CALLBACK_AFTER_CREDIT
+    idle_busy |= charge_busy_after;
+#endif
+
     /* Select which in to poll next (randomized round robin) */
 
     if( FD_UNLIKELY( !in_cnt ) ) {
+      if( FD_UNLIKELY( idle_busy ) ) fd_tempo_idle_busy( idle );
+      else                           fd_tempo_idle_empty( idle, NULL );
       metric_regime_ticks[0] += housekeeping_ticks;
       long next = fd_tickcount();
       metric_regime_ticks[3] += (ulong)(next - now);
@@ -562,6 +757,9 @@ STEM_(run1)( ulong                        in_cnt,
 #ifdef STEM_CALLBACK_AFTER_POLL_OVERRUN
         STEM_CALLBACK_AFTER_POLL_OVERRUN( ctx );
 #endif
+      } else { /* Caught up, back off if the tile is idle */
+        if( FD_UNLIKELY( idle_busy ) ) fd_tempo_idle_busy( idle );
+        else                           fd_tempo_idle_empty( idle, this_in_mline );
       }
 
       /* Don't bother with spin as polling multiple locations */
@@ -573,9 +771,11 @@ STEM_(run1)( ulong                        in_cnt,
       continue;
     }
 
+#ifndef STEM_CALLBACK_DURING_FRAG_BATCH
     ulong sig = fd_frag_meta_sse0_sig( seq_sig ); (void)sig;
 #ifdef STEM_CALLBACK_BEFORE_FRAG
-    int filter = STEM_CALLBACK_BEFORE_FRAG( ctx, (ulong)this_in->idx, seq_found, sig );
+    int filter;
+    STEM_PROFILE_CALL( STEM_PROFILE_BEFORE_FRAG, filter = STEM_CALLBACK_BEFORE_FRAG( ctx, (ulong)this_in->idx, seq_found, sig ) );
     if( FD_UNLIKELY( filter<0 ) ) {
       metric_regime_ticks[1] += housekeeping_ticks;
       metric_regime_ticks[4] += prefrag_ticks;
@@ -591,6 +791,8 @@ STEM_(run1)( ulong                        in_cnt,
       this_in->seq   = this_in_seq;
       this_in->mline = this_in->mcache + fd_mcache_line_idx( this_in_seq, this_in->depth );
 
+      fd_tempo_idle_busy( idle );
+
       metric_regime_ticks[1] += housekeeping_ticks;
       metric_regime_ticks[4] += prefrag_ticks;
       long next = fd_tickcount();
@@ -616,7 +818,7 @@ STEM_(run1)( ulong                        in_cnt,
     ulong tspub    = (ulong)this_in_mline->tspub;  (void)tspub;
 
 #ifdef STEM_CALLBACK_DURING_FRAG
-    STEM_CALLBACK_DURING_FRAG( ctx, (ulong)this_in->idx, seq_found, sig, chunk, sz, ctl );
+    STEM_PROFILE_CALL( STEM_PROFILE_DURING_FRAG, STEM_CALLBACK_DURING_FRAG( ctx, (ulong)this_in->idx, seq_found, sig, chunk, sz, ctl ) );
 #endif
 
     FD_COMPILER_MFENCE();
@@ -636,8 +838,10 @@ STEM_(run1)( ulong                        in_cnt,
       continue;
     }
 
+    STEM_(in_sample_age)( in_hist + STEM_IN_HIST_CNT*this_in->idx, tsorig, tspub, now );
+
 #ifdef STEM_CALLBACK_AFTER_FRAG
-    STEM_CALLBACK_AFTER_FRAG( ctx, (ulong)this_in->idx, seq_found, sig, sz, tsorig, tspub, &stem );
+    STEM_PROFILE_CALL( STEM_PROFILE_AFTER_FRAG, STEM_CALLBACK_AFTER_FRAG( ctx, (ulong)this_in->idx, seq_found, sig, sz, tsorig, tspub, &stem ) );
 #endif
 
     /* Windup for the next in poll and accumulate diagnostics */
@@ -649,10 +853,99 @@ STEM_(run1)( ulong                        in_cnt,
     this_in->accum[ FD_METRICS_COUNTER_LINK_CONSUMED_COUNT_OFF ]++;
     this_in->accum[ FD_METRICS_COUNTER_LINK_CONSUMED_SIZE_BYTES_OFF ] += (uint)sz;
 
+    fd_tempo_idle_busy( idle );
+
     metric_regime_ticks[1] += housekeeping_ticks;
     metric_regime_ticks[4] += prefrag_ticks;
     long next = fd_tickcount();
     metric_regime_ticks[7] += (ulong)(next - now);
+#else
+    /* Gather up to STEM_BATCH_MAX consecutive ready frags from this in,
+       starting with the one just found.  Stop early when caught up (or
+       overrun, which the next poll of this in will handle) or when
+       before_frag asks to retry a frag later. */
+
+    ulong batch_cnt = 0UL;
+    for(;;) {
+      ulong sig = fd_frag_meta_sse0_sig( seq_sig );
+#ifdef STEM_CALLBACK_BEFORE_FRAG
+      int filter;
+      STEM_PROFILE_CALL( STEM_PROFILE_BEFORE_FRAG, filter = STEM_CALLBACK_BEFORE_FRAG( ctx, (ulong)this_in->idx, seq_found, sig ) );
+      if( FD_UNLIKELY( filter<0 ) ) break;
+      if( FD_UNLIKELY( filter>0 ) ) {
+        this_in->accum[ FD_METRICS_COUNTER_LINK_FILTERED_COUNT_OFF ]++;
+        this_in->accum[ FD_METRICS_COUNTER_LINK_FILTERED_SIZE_BYTES_OFF ] += (uint)this_in_mline->sz;
+      } else
+#endif
+      {
+        FD_COMPILER_MFENCE();
+        fd_stem_frag_t * frag = batch + batch_cnt++;
+        frag->seq    = seq_found;
+        frag->sig    = sig;
+        frag->chunk  = (ulong)this_in_mline->chunk;
+        frag->sz     = (ulong)this_in_mline->sz;
+        frag->ctl    = (ulong)this_in_mline->ctl;
+        frag->tsorig = (ulong)this_in_mline->tsorig;
+        frag->tspub  = (ulong)this_in_mline->tspub;
+      }
+
+      this_in_seq    = fd_seq_inc( this_in_seq, 1UL );
+      this_in->seq   = this_in_seq;
+      this_in->mline = this_in->mcache + fd_mcache_line_idx( this_in_seq, this_in->depth );
+      this_in_mline  = this_in->mline;
+
+      if( FD_UNLIKELY( batch_cnt>=STEM_BATCH_MAX ) ) break;
+
+      seq_sig = fd_frag_meta_seq_sig_query( this_in_mline );
+#if FD_USING_CLANG
+      __asm__( "" : "+x"(seq_sig) ); /* See note above */
+#endif
+      seq_found = fd_frag_meta_sse0_seq( seq_sig );
+      if( FD_UNLIKELY( fd_seq_ne( seq_found, this_in_seq ) ) ) break;
+    }
+
+    if( FD_LIKELY( batch_cnt ) ) {
+      STEM_PROFILE_CALL( STEM_PROFILE_DURING_FRAG, STEM_CALLBACK_DURING_FRAG_BATCH( ctx, (ulong)this_in->idx, batch, batch_cnt ) );
+
+      /* Find the frags that were not overrun while the callback was
+         reading them (all of them if in producers are honoring our flow
+         control).  If one was, resume from there. */
+
+      ulong ok_cnt = 0UL;
+      FD_COMPILER_MFENCE();
+      for( ; ok_cnt<batch_cnt; ok_cnt++ ) {
+        ulong seq_expect = batch[ ok_cnt ].seq;
+        fd_frag_meta_t const * mline = this_in->mcache + fd_mcache_line_idx( seq_expect, this_in->depth );
+        ulong seq_test = mline->seq;
+        if( FD_UNLIKELY( fd_seq_ne( seq_test, seq_expect ) ) ) { /* Overrun while reading (impossible if this_in honoring our fctl) */
+          this_in->seq   = seq_test; /* Resume from here (same line, so probably reasonably current) */
+          this_in->mline = mline;
+          fd_metrics_link_in( fd_metrics_base_tl, this_in->idx )[ FD_METRICS_COUNTER_LINK_OVERRUN_READING_COUNT_OFF ]++;
+          fd_metrics_link_in( fd_metrics_base_tl, this_in->idx )[ FD_METRICS_COUNTER_LINK_OVERRUN_READING_FRAG_COUNT_OFF ] += (uint)fd_seq_diff( seq_test, seq_expect );
+          break;
+        }
+      }
+      FD_COMPILER_MFENCE();
+
+      fd_histf_t * hist = in_hist + STEM_IN_HIST_CNT*this_in->idx;
+      for( ulong i=0UL; i<ok_cnt; i++ ) {
+        fd_stem_frag_t const * frag = batch + i;
+        STEM_(in_sample_age)( hist, frag->tsorig, frag->tspub, now );
+#ifdef STEM_CALLBACK_AFTER_FRAG
+        STEM_PROFILE_CALL( STEM_PROFILE_AFTER_FRAG, STEM_CALLBACK_AFTER_FRAG( ctx, (ulong)this_in->idx, frag->seq, frag->sig, frag->sz, frag->tsorig, frag->tspub, &stem ) );
+#endif
+        this_in->accum[ FD_METRICS_COUNTER_LINK_CONSUMED_COUNT_OFF ]++;
+        this_in->accum[ FD_METRICS_COUNTER_LINK_CONSUMED_SIZE_BYTES_OFF ] += (uint)frag->sz;
+      }
+    }
+
+    fd_tempo_idle_busy( idle );
+
+    metric_regime_ticks[1] += housekeeping_ticks;
+    metric_regime_ticks[4] += prefrag_ticks;
+    long next = fd_tickcount();
+    metric_regime_ticks[7] += (ulong)(next - now);
+#endif
     now = next;
   }
 }
@@ -716,6 +1009,8 @@ STEM_(run)( fd_topo_t *      topo,
                cons_fseq,
                STEM_BURST,
                STEM_LAZY,
+               tile->idle_wake_ns,
+               tile->idle_sleep,
                rng,
                fd_alloca( FD_STEM_SCRATCH_ALIGN, STEM_(scratch_footprint)( polled_in_cnt, tile->out_cnt, reliable_cons_cnt ) ),
                ctx );
@@ -733,3 +1028,16 @@ STEM_(run)( fd_topo_t *      topo,
 #undef STEM_CALLBACK_BEFORE_FRAG
 #undef STEM_CALLBACK_DURING_FRAG
 #undef STEM_CALLBACK_AFTER_FRAG
+#undef STEM_PROFILE_CALL
+#undef STEM_PROFILE_BEFORE_FRAG
+#undef STEM_PROFILE_DURING_FRAG
+#undef STEM_PROFILE_AFTER_FRAG
+#undef STEM_PROFILE_AFTER_CREDIT
+#undef STEM_PROFILE_DURING_HOUSEKEEPING
+#undef STEM_PROFILE_CNT
+#undef STEM_IN_HIST_HOP
+#undef STEM_IN_HIST_ORIGIN
+#undef STEM_IN_HIST_CNT
+#undef STEM_CALLBACK_DURING_FRAG_BATCH
+#undef STEM_BATCH_MAX
+#undef STEM_IDLE_SPIN_MAX
@@ -30,6 +30,23 @@ struct __attribute__((aligned(64))) fd_stem_tile_in {
 
 typedef struct fd_stem_tile_in fd_stem_tile_in_t;
 
+/* fd_stem_frag_t describes a frag, as handed to a tile's
+   STEM_CALLBACK_DURING_FRAG_BATCH callback (see fd_stem.c) or
+   published with fd_stem_publish_batch.  The fields are those of the
+   frag's fd_frag_meta_t. */
+
+struct fd_stem_frag {
+  ulong seq;
+  ulong sig;
+  ulong chunk;
+  ulong sz;
+  ulong ctl;
+  ulong tsorig;
+  ulong tspub;
+};
+
+typedef struct fd_stem_frag fd_stem_frag_t;
+
 static inline void
 fd_stem_publish( fd_stem_context_t * stem,
                  ulong               out_idx,
@@ -46,6 +63,32 @@ fd_stem_publish( fd_stem_context_t * stem,
   *seqp = fd_seq_inc( seq, 1UL );
 }
 
+/* fd_stem_publish_batch publishes frag[i] for i in [0,cnt) to out
+   out_idx, in order, with consecutive sequence numbers (frag[i].seq is
+   ignored).  This is equivalent to cnt calls to fd_stem_publish but
+   updates the out's sequence number and the credits once.  The caller
+   must have at least cnt credits available, i.e. a tile publishing in
+   batches should set STEM_BURST to its largest batch. */
+
+static inline void
+fd_stem_publish_batch( fd_stem_context_t *    stem,
+                       ulong                  out_idx,
+                       fd_stem_frag_t const * frag,
+                       ulong                  cnt ) {
+  fd_frag_meta_t * mcache = stem->mcaches[ out_idx ];
+  ulong            depth  = stem->depths [ out_idx ];
+  ulong            seq    = stem->seqs   [ out_idx ];
+  for( ulong i=0UL; i<cnt; i++ ) {
+#if FD_HAS_SSE
+    fd_mcache_publish_sse( mcache, depth, fd_seq_inc( seq, i ), frag[i].sig, frag[i].chunk, frag[i].sz, frag[i].ctl, frag[i].tsorig, frag[i].tspub );
+#else
+    fd_mcache_publish    ( mcache, depth, fd_seq_inc( seq, i ), frag[i].sig, frag[i].chunk, frag[i].sz, frag[i].ctl, frag[i].tsorig, frag[i].tspub );
+#endif
+  }
+  *stem->cr_avail -= cnt*stem->cr_decrement_amount;
+  stem->seqs[ out_idx ] = fd_seq_inc( seq, cnt );
+}
+
 static inline ulong
 fd_stem_advance( fd_stem_context_t * stem,
                  ulong               out_idx ) {
@@ -0,0 +1,252 @@
+#include "../topo/fd_topo.h"
+#include "../metrics/fd_metrics.h"
+
+#include <setjmp.h>
+
+/* Exercises the DURING_FRAG_BATCH path of the stem run loop with a
+   single in and no outs.  The run loop never returns, so the test
+   context leaves it with longjmp from AFTER_CREDIT once all the
+   expected AFTER_FRAG calls were made. */
+
+#define TEST_DEPTH     (128UL)
+#define TEST_BATCH_MAX (4UL)
+#define TEST_FRAG_MAX  (16UL)
+
+struct test_ctx {
+  ulong filter_seq;    /* before_frag filters the frag with this seq (ULONG_MAX for none) */
+  ulong overrun_idx;   /* the first during_frag_batch call overruns batch[ overrun_idx ] (ULONG_MAX for none) */
+
+  fd_frag_meta_t * mcache;
+
+  ulong batch_call_cnt;
+  ulong batch_cnt[ TEST_FRAG_MAX ];
+  ulong batch_seq[ TEST_FRAG_MAX ][ TEST_BATCH_MAX ];
+
+  ulong after_cnt;
+  ulong after_seq[ TEST_FRAG_MAX ];
+  ulong after_expect;
+
+  ulong iter_cnt;
+  jmp_buf exit;
+};
+
+typedef struct test_ctx test_ctx_t;
+
+static inline int
+before_frag( test_ctx_t * ctx,
+             ulong        in_idx,
+             ulong        seq,
+             ulong        sig ) {
+  FD_TEST( !in_idx );
+  FD_TEST( sig==seq );
+  return seq==ctx->filter_seq;
+}
+
+static inline void
+during_frag_batch( test_ctx_t *           ctx,
+                   ulong                  in_idx,
+                   fd_stem_frag_t const * frag,
+                   ulong                  cnt ) {
+  FD_TEST( !in_idx );
+  FD_TEST( cnt && cnt<=TEST_BATCH_MAX );
+  FD_TEST( ctx->batch_call_cnt<TEST_FRAG_MAX );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    FD_TEST( frag[ i ].sig==frag[ i ].seq );
+    FD_TEST( frag[ i ].sz ==( frag[ i ].seq & 0xffffUL ) );
+    ctx->batch_seq[ ctx->batch_call_cnt ][ i ] = frag[ i ].seq;
+  }
+  ctx->batch_cnt[ ctx->batch_call_cnt ] = cnt;
+
+  /* Simulate the producer lapping the frag at overrun_idx while the
+     batch is being read. */
+  if( FD_UNLIKELY( !ctx->batch_call_cnt && ctx->overrun_idx<cnt ) ) {
+    ulong seq = frag[ ctx->overrun_idx ].seq + TEST_DEPTH;
+    fd_mcache_publish( ctx->mcache, TEST_DEPTH, seq, seq, 0UL, seq & 0xffffUL, 0UL, 0UL, 0UL );
+  }
+
+  ctx->batch_call_cnt++;
+}
+
+static inline void
+after_frag( test_ctx_t *        ctx,
+            ulong               in_idx,
+            ulong               seq,
+            ulong               sig,
+            ulong               sz,
+            ulong               tsorig,
+            ulong               tspub,
+            fd_stem_context_t * stem ) {
+  (void)sz; (void)tsorig; (void)tspub; (void)stem;
+  FD_TEST( !in_idx );
+  FD_TEST( sig==seq );
+  FD_TEST( ctx->after_cnt<TEST_FRAG_MAX );
+  ctx->after_seq[ ctx->after_cnt++ ] = seq;
+}
+
+static inline void
+after_credit( test_ctx_t *        ctx,
+              fd_stem_context_t * stem,
+              int *               opt_poll_in,
+              int *               charge_busy ) {
+  (void)stem; (void)opt_poll_in; (void)charge_busy;
+  if( FD_UNLIKELY( ctx->after_cnt>=ctx->after_expect ) ) longjmp( ctx->exit, 1 );
+  if( FD_UNLIKELY( ++ctx->iter_cnt>(1UL<<24) ) ) FD_LOG_ERR(( "stem did not deliver the expected frags" ));
+}
+
+#define STEM_NAME                       test
+#define STEM_BURST                      (1UL)
+#define STEM_BATCH_MAX                  TEST_BATCH_MAX
+#define STEM_CALLBACK_CONTEXT_TYPE      test_ctx_t
+#define STEM_CALLBACK_CONTEXT_ALIGN     alignof(test_ctx_t)
+#define STEM_CALLBACK_BEFORE_FRAG       before_frag
+#define STEM_CALLBACK_DURING_FRAG_BATCH during_frag_batch
+#define STEM_CALLBACK_AFTER_FRAG        after_frag
+#define STEM_CALLBACK_AFTER_CREDIT      after_credit
+
+#include "fd_stem.c"
+
+static uchar mcache_mem [ FD_MCACHE_FOOTPRINT( TEST_DEPTH, 0UL ) ] __attribute__((aligned(FD_MCACHE_ALIGN)));
+static uchar fseq_mem   [ FD_FSEQ_FOOTPRINT ]                      __attribute__((aligned(FD_FSEQ_ALIGN)));
+static uchar metrics_mem[ FD_METRICS_FOOTPRINT( 1UL, 0UL ) ]       __attribute__((aligned(FD_METRICS_ALIGN)));
+static uchar scratch_mem[ 65536UL ]                                __attribute__((aligned(FD_STEM_SCRATCH_ALIGN)));
+
+static test_ctx_t ctx[1];
+
+/* run_stem publishes frags [0,frag_cnt) to a fresh in mcache (sig is
+   the seq) and runs the stem until after_expect frags were handed to
+   after_frag. */
+
+static void
+run_stem( ulong      frag_cnt,
+          ulong      filter_seq,
+          ulong      overrun_idx,
+          ulong      after_expect,
+          fd_rng_t * rng ) {
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_mcache_new( mcache_mem, TEST_DEPTH, 0UL, 0UL ) ); FD_TEST( mcache );
+  ulong *          fseq   = fd_fseq_join  ( fd_fseq_new  ( fseq_mem,   0UL                ) ); FD_TEST( fseq   );
+  fd_metrics_register( (ulong *)fd_metrics_new( metrics_mem, 1UL, 0UL ) );
+
+  for( ulong seq=0UL; seq<frag_cnt; seq++ ) fd_mcache_publish( mcache, TEST_DEPTH, seq, seq, 0UL, seq, 0UL, 0UL, 0UL );
+
+  memset( ctx, 0, sizeof(test_ctx_t) );
+  ctx->filter_seq   = filter_seq;
+  ctx->overrun_idx  = overrun_idx;
+  ctx->mcache       = mcache;
+  ctx->after_expect = after_expect;
+
+  FD_TEST( test_scratch_footprint( 1UL, 0UL, 0UL )<=sizeof(scratch_mem) );
+
+  fd_frag_meta_t const * in_mcache[1] = { mcache };
+  ulong *                in_fseq  [1] = { fseq   };
+  if( !setjmp( ctx->exit ) ) {
+    test_run1( 1UL, in_mcache, in_fseq, 0UL, NULL, 0UL, NULL, NULL, 1UL, 0L, 0L, 0, rng, scratch_mem, ctx );
+    FD_LOG_ERR(( "unreachable" ));
+  }
+
+  FD_TEST( fd_fseq_leave( fseq ) );
+  FD_TEST( fd_mcache_delete( fd_mcache_leave( mcache ) ) );
+}
+
+/* Frags are handed to during_frag_batch in batches of up to
+   STEM_BATCH_MAX, filtered frags are skipped and every frag reaches
+   after_frag, in order. */
+
+static void
+test_batch( fd_rng_t * rng ) {
+  run_stem( 6UL, 2UL, ULONG_MAX, 5UL, rng );
+
+  FD_TEST( ctx->batch_call_cnt==2UL );
+  FD_TEST( ctx->batch_cnt[0]==4UL );
+  FD_TEST( ctx->batch_seq[0][0]==0UL && ctx->batch_seq[0][1]==1UL && ctx->batch_seq[0][2]==3UL && ctx->batch_seq[0][3]==4UL );
+  FD_TEST( ctx->batch_cnt[1]==1UL );
+  FD_TEST( ctx->batch_seq[1][0]==5UL );
+
+  FD_TEST( ctx->after_cnt==5UL );
+  FD_TEST( ctx->after_seq[0]==0UL && ctx->after_seq[1]==1UL && ctx->after_seq[2]==3UL && ctx->after_seq[3]==4UL && ctx->after_seq[4]==5UL );
+
+  volatile ulong * link = fd_metrics_link_in( fd_metrics_base_tl, 0UL );
+  FD_TEST( !link[ FD_METRICS_COUNTER_LINK_OVERRUN_READING_COUNT_OFF ] );
+}
+
+/* When a frag of a batch is overrun while the batch is being read, only
+   the frags before it reach after_frag, and the stem resumes from the
+   frag that overran it. */
+
+static void
+test_batch_overrun( fd_rng_t * rng ) {
+  run_stem( 6UL, ULONG_MAX, 2UL, 3UL, rng );
+
+  FD_TEST( ctx->batch_call_cnt==2UL );
+  FD_TEST( ctx->batch_cnt[0]==4UL );
+  FD_TEST( ctx->batch_seq[0][0]==0UL && ctx->batch_seq[0][1]==1UL && ctx->batch_seq[0][2]==2UL && ctx->batch_seq[0][3]==3UL );
+  FD_TEST( ctx->batch_cnt[1]==1UL );
+  FD_TEST( ctx->batch_seq[1][0]==2UL+TEST_DEPTH );
+
+  /* Only the ok prefix {0,1} of the first batch, then the frag that
+     overran seq 2.  Seqs 2 and 3 never reach after_frag. */
+  FD_TEST( ctx->after_cnt==3UL );
+  FD_TEST( ctx->after_seq[0]==0UL && ctx->after_seq[1]==1UL && ctx->after_seq[2]==2UL+TEST_DEPTH );
+
+  volatile ulong * link = fd_metrics_link_in( fd_metrics_base_tl, 0UL );
+  FD_TEST( link[ FD_METRICS_COUNTER_LINK_OVERRUN_READING_COUNT_OFF      ]==1UL        );
+  FD_TEST( link[ FD_METRICS_COUNTER_LINK_OVERRUN_READING_FRAG_COUNT_OFF ]==TEST_DEPTH );
+}
+
+/* fd_stem_publish_batch is equivalent to publishing the frags one at a
+   time with fd_stem_publish. */
+
+static void
+test_publish_batch( void ) {
+  fd_frag_meta_t * mcache = fd_mcache_join( fd_mcache_new( mcache_mem, TEST_DEPTH, 0UL, 0UL ) ); FD_TEST( mcache );
+
+  fd_frag_meta_t * mcaches[1] = { mcache };
+  ulong            depths [1] = { TEST_DEPTH };
+  ulong            seqs   [1] = { TEST_DEPTH-2UL }; /* Wrap around the end of the mcache */
+  ulong            cr_avail   = 8UL;
+  fd_stem_context_t stem = {
+    .mcaches             = mcaches,
+    .seqs                = seqs,
+    .depths              = depths,
+    .cr_avail            = &cr_avail,
+    .cr_decrement_amount = 1UL
+  };
+
+  fd_stem_frag_t frag[4];
+  for( ulong i=0UL; i<4UL; i++ ) {
+    frag[i] = (fd_stem_frag_t){ .seq = ULONG_MAX, .sig = 100UL+i, .chunk = 10UL*i, .sz = i, .ctl = 0UL, .tsorig = 1UL, .tspub = 2UL };
+  }
+  fd_stem_publish_batch( &stem, 0UL, frag, 4UL );
+
+  FD_TEST( seqs[0]==TEST_DEPTH+2UL );
+  FD_TEST( cr_avail==4UL );
+  for( ulong i=0UL; i<4UL; i++ ) {
+    ulong                  seq  = TEST_DEPTH-2UL+i;
+    fd_frag_meta_t const * meta = mcache + fd_mcache_line_idx( seq, TEST_DEPTH );
+    FD_TEST( meta->seq==seq            );
+    FD_TEST( meta->sig==100UL+i        );
+    FD_TEST( meta->chunk==(uint)(10UL*i) );
+    FD_TEST( meta->sz==(ushort)i       );
+    FD_TEST( meta->tsorig==1U          );
+    FD_TEST( meta->tspub==2U           );
+  }
+
+  FD_TEST( fd_mcache_delete( fd_mcache_leave( mcache ) ) );
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  test_batch( rng );
+  test_batch_overrun( rng );
+  test_publish_batch();
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -107,6 +107,9 @@ typedef struct {
   ulong tile_obj_id;
   ulong metrics_obj_id;
   ulong keyswitch_obj_id;
+  ulong log_ring_obj_id;   /* ULONG_MAX if the tile logs synchronously */
+  long  idle_wake_ns;      /* Max ns the stem waits per poll when the tile is idle, 0 if the tile always busy spins (see fd_stem.c) */
+  int   idle_sleep;        /* 1 if the stem may sleep in the kernel when fully backed off, requires allow_idle_sleep */
   ulong in_link_fseq_obj_id[ FD_TOPO_MAX_TILE_IN_LINKS ];
 
   ulong uses_obj_cnt;
@@ -181,10 +184,12 @@ typedef struct {
 
     struct {
       ulong tcache_depth;
+      int   tcache_bkt; /* Use a bucketized tcache (fd_tcache_bkt) */
     } verify;
 
     struct {
       ulong tcache_depth;
+      int   tcache_bkt; /* Use a bucketized tcache (fd_tcache_bkt) */
     } dedup;
 
     struct {
@@ -264,6 +269,11 @@ typedef struct {
       ushort prometheus_listen_port;
     } metric;
 
+    struct {
+      ulong rate;
+      ulong burst;
+    } logd;
+
     struct {
       ulong fec_max;
       ulong slice_max;
@@ -469,6 +479,7 @@ typedef struct {
 
   int          keep_host_networking;
   int          allow_connect;
+  int          allow_idle_sleep; /* seccomp policy allows the stem idle sleep (see fd_stem.c) */
   ulong        rlimit_file_cnt;
   ulong        rlimit_address_space;
   ulong        rlimit_data;
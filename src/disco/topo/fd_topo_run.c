@@ -2,6 +2,7 @@
 #include "fd_topo.h"
 
 #include "../metrics/fd_metrics.h"
+#include "../../util/log/fd_log_ring.h"
 #include "../../waltz/xdp/fd_xdp1.h"
 #include "../../util/tile/fd_tile_private.h"
 
@@ -70,6 +71,9 @@ fd_topo_run_tile( fd_topo_t *          topo,
   check_wait_debugger( pid, wait, debugger );
   initialize_logging( tile->name, tile->kind_id, pid, tid );
 
+  if( FD_UNLIKELY( tile->idle_sleep && !tile_run->allow_idle_sleep ) )
+    FD_LOG_ERR(( "tile %s does not support sleeping when idle, remove it from [layout.idle_sleep_tiles]", tile->name ));
+
   /* preload shared memory before sandboxing, so it is already mapped */
   fd_topo_join_tile_workspaces( topo, tile );
 
@@ -129,6 +133,15 @@ fd_topo_run_tile( fd_topo_t *          topo,
   FD_TEST( tile->metrics );
   fd_metrics_register( tile->metrics );
 
+  /* From here on, hand off non-fatal log messages to the log tile if
+     asynchronous logging is enabled */
+
+  if( FD_UNLIKELY( tile->log_ring_obj_id!=ULONG_MAX ) ) {
+    fd_log_ring_t * log_ring = fd_log_ring_join( fd_topo_obj_laddr( topo, tile->log_ring_obj_id ) );
+    FD_TEST( log_ring );
+    fd_log_ring_attach( log_ring );
+  }
+
   FD_MGAUGE_SET( TILE, PID, pid );
   FD_MGAUGE_SET( TILE, TID, tid );
 
@@ -159,6 +159,10 @@ fd_topob_tile( fd_topo_t *    topo,
     tile->keyswitch_obj_id = ULONG_MAX;
   }
 
+  tile->log_ring_obj_id = ULONG_MAX;
+  tile->idle_wake_ns    = 0L;
+  tile->idle_sleep      = 0;
+
   topo->tile_cnt++;
   return tile;
 }
@@ -221,6 +225,46 @@ fd_topob_tile_out( fd_topo_t *  topo,
   }
 }
 
+void
+fd_topob_tile_log_rings( fd_topo_t *  topo,
+                         char const * log_tile_name,
+                         char const * wksp_name,
+                         ulong        depth ) {
+  ulong log_tile_id = fd_topo_find_tile( topo, log_tile_name, 0UL );
+  if( FD_UNLIKELY( log_tile_id==ULONG_MAX ) ) FD_LOG_ERR(( "tile not found: %s:0", log_tile_name ));
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( depth ) ) ) FD_LOG_ERR(( "log ring depth %lu must be a power of two", depth ));
+  fd_topo_tile_t * log_tile = &topo->tiles[ log_tile_id ];
+
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t * tile = &topo->tiles[ i ];
+    if( FD_UNLIKELY( !strcmp( tile->name, log_tile_name ) ) ) continue;
+
+    fd_topo_obj_t * obj = fd_topob_obj( topo, "log_ring", wksp_name );
+    FD_TEST( fd_pod_insertf_ulong( topo->props, depth, "obj.%lu.depth", obj->id ) );
+    tile->log_ring_obj_id = obj->id;
+    fd_topob_tile_uses( topo, tile,     obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+    fd_topob_tile_uses( topo, log_tile, obj, FD_SHMEM_JOIN_MODE_READ_WRITE );
+  }
+}
+
+void
+fd_topob_tile_idle( fd_topo_t *  topo,
+                    char const * tile_name,
+                    long         wake_ns,
+                    int          sleep ) {
+  if( FD_UNLIKELY( wake_ns<0L ) ) FD_LOG_ERR(( "idle wake %li ns must be non-negative", wake_ns ));
+
+  ulong found = 0UL;
+  for( ulong i=0UL; i<topo->tile_cnt; i++ ) {
+    fd_topo_tile_t * tile = &topo->tiles[ i ];
+    if( FD_UNLIKELY( strcmp( tile->name, tile_name ) ) ) continue;
+    tile->idle_wake_ns = wake_ns;
+    tile->idle_sleep   = !!wake_ns && sleep;
+    found++;
+  }
+  if( FD_UNLIKELY( !found ) ) FD_LOG_ERR(( "tile not found: %s", tile_name ));
+}
+
 static void
 validate( fd_topo_t const * topo ) {
   /* Objects have valid wksp_ids */
@@ -338,6 +382,7 @@ fd_topob_auto_layout( fd_topo_t * topo ) {
     "netlnk",
     "metric",
     "cswtch",
+    "logd",
     "bencho",
     "bhole",  /* FIREDANCER only */
     "rstart", /* FIREDANCER only */
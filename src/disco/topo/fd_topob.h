@@ -128,6 +128,32 @@ fd_topob_tile_out( fd_topo_t *  topo,
                    char const * link_name,
                    ulong        link_kind_id );
 
+/* Give every tile in the topology (other than the log tile itself) an
+   async log ring of depth messages in the given workspace, and have the
+   log tile, which must already have been added, map all of them.  The
+   tiles will then hand off their DEBUG through WARNING log messages to
+   the log tile (see fd_log_ring.h).  Tiles added after this call log
+   synchronously. */
+
+void
+fd_topob_tile_log_rings( fd_topo_t *  topo,
+                         char const * log_tile_name,
+                         char const * wksp_name,
+                         ulong        depth );
+
+/* Let every tile named tile_name back off when idle, waiting at most
+   wake_ns per poll once it has been idle for a while (see fd_stem.c).
+   If sleep is non-zero, the tile may also sleep in the kernel once
+   fully backed off (the tile's seccomp policy must allow it, which is
+   checked when the tile is run).  wake_ns==0 restores busy spinning.
+   Errors if there is no such tile. */
+
+void
+fd_topob_tile_idle( fd_topo_t *  topo,
+                    char const * tile_name,
+                    long         wake_ns,
+                    int          sleep );
+
 /* Automatically layout the tiles onto CPUs in the topology for a
    best effort. */
 
@@ -21,7 +21,8 @@ FD_FN_PURE static inline ulong
 scratch_footprint( fd_topo_tile_t const * tile ) {
   ulong l = FD_LAYOUT_INIT;
   l = FD_LAYOUT_APPEND( l, alignof( fd_verify_ctx_t ), sizeof( fd_verify_ctx_t ) );
-  l = FD_LAYOUT_APPEND( l, fd_tcache_align(), fd_tcache_footprint( tile->verify.tcache_depth, 0UL ) );
+  if( FD_UNLIKELY( tile->verify.tcache_bkt ) ) l = FD_LAYOUT_APPEND( l, fd_tcache_bkt_align(), fd_tcache_bkt_footprint( tile->verify.tcache_depth, 0UL ) );
+  else                                        l = FD_LAYOUT_APPEND( l, fd_tcache_align(),     fd_tcache_footprint    ( tile->verify.tcache_depth, 0UL ) );
   for( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
     l = FD_LAYOUT_APPEND( l, fd_sha512_align(), fd_sha512_footprint() );
   }
@@ -149,8 +150,9 @@ after_frag( fd_verify_ctx_t *   ctx,
   }
 
   ulong realized_sz = fd_txn_m_realized_footprint( txnm, 1, 0 );
+  ulong dedup_sig   = is_bundle ? 0UL : fd_verify_dedup_sig( ctx->dedup_shard_seed, fd_txn_m_payload( txnm )+txnt->signature_off );
   ulong tspub = (ulong)fd_frag_meta_ts_comp( fd_tickcount() );
-  fd_stem_publish( stem, 0UL, 0UL, ctx->out_chunk, realized_sz, 0UL, tsorig, tspub );
+  fd_stem_publish( stem, 0UL, dedup_sig, ctx->out_chunk, realized_sz, 0UL, tsorig, tspub );
   ctx->out_chunk = fd_dcache_compact_next( ctx->out_chunk, realized_sz, ctx->out_chunk0, ctx->out_wmark );
 }
 
@@ -171,12 +173,22 @@ unprivileged_init( fd_topo_t *      topo,
 
   FD_SCRATCH_ALLOC_INIT( l, scratch );
   fd_verify_ctx_t * ctx = FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_verify_ctx_t ), sizeof( fd_verify_ctx_t ) );
-  fd_tcache_t * tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, FD_TCACHE_ALIGN, FD_TCACHE_FOOTPRINT( tile->verify.tcache_depth, 0UL ) ), tile->verify.tcache_depth, 0UL ) );
-  if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
+  fd_tcache_t *     tcache     = NULL;
+  fd_tcache_bkt_t * tcache_bkt = NULL;
+  if( FD_UNLIKELY( tile->verify.tcache_bkt ) ) {
+    tcache_bkt = fd_tcache_bkt_join( fd_tcache_bkt_new( FD_SCRATCH_ALLOC_APPEND( l, fd_tcache_bkt_align(), fd_tcache_bkt_footprint( tile->verify.tcache_depth, 0UL ) ), tile->verify.tcache_depth, 0UL ) );
+    if( FD_UNLIKELY( !tcache_bkt ) ) FD_LOG_ERR(( "fd_tcache_bkt_join failed" ));
+  } else {
+    tcache = fd_tcache_join( fd_tcache_new( FD_SCRATCH_ALLOC_APPEND( l, FD_TCACHE_ALIGN, FD_TCACHE_FOOTPRINT( tile->verify.tcache_depth, 0UL ) ), tile->verify.tcache_depth, 0UL ) );
+    if( FD_UNLIKELY( !tcache ) ) FD_LOG_ERR(( "fd_tcache_join failed" ));
+  }
 
   ctx->round_robin_cnt = fd_topo_tile_name_cnt( topo, tile->name );
   ctx->round_robin_idx = tile->kind_id;
 
+  ctx->dedup_shard_seed = fd_pod_query_ulong( topo->props, "dedup_shard_seed", ULONG_MAX );
+  FD_TEST( ctx->dedup_shard_seed!=ULONG_MAX );
+
   for ( ulong i=0; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
     fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( FD_SCRATCH_ALLOC_APPEND( l, alignof( fd_sha512_t ), sizeof( fd_sha512_t ) ) ) );
     if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
@@ -188,11 +200,23 @@ unprivileged_init( fd_topo_t *      topo,
 
   memset( &ctx->metrics, 0, sizeof( ctx->metrics ) );
 
-  ctx->tcache_depth   = fd_tcache_depth       ( tcache );
-  ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
-  ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
-  ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
-  ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+  if( FD_UNLIKELY( tcache_bkt ) ) {
+    ctx->tcache_depth   = 0UL;
+    ctx->tcache_map_cnt = 0UL;
+    ctx->tcache_sync    = NULL;
+    ctx->tcache_ring    = NULL;
+    ctx->tcache_map     = NULL;
+    ctx->tcache_bkt     = fd_tcache_bkt_bkt_laddr( tcache_bkt );
+    ctx->tcache_bkt_cnt = fd_tcache_bkt_bkt_cnt  ( tcache_bkt );
+  } else {
+    ctx->tcache_depth   = fd_tcache_depth       ( tcache );
+    ctx->tcache_map_cnt = fd_tcache_map_cnt     ( tcache );
+    ctx->tcache_sync    = fd_tcache_oldest_laddr( tcache );
+    ctx->tcache_ring    = fd_tcache_ring_laddr  ( tcache );
+    ctx->tcache_map     = fd_tcache_map_laddr   ( tcache );
+    ctx->tcache_bkt     = NULL;
+    ctx->tcache_bkt_cnt = 0UL;
+  }
 
   for( ulong i=0UL; i<tile->in_cnt; i++ ) {
     fd_topo_link_t * link = &topo->links[ tile->in_link_id[ i ] ];
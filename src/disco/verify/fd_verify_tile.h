@@ -9,6 +9,30 @@
 
 extern fd_topo_run_tile_t fd_tile_verify;
 
+/* fd_verify_dedup_sig returns the sig the verify tile publishes a
+   (non-bundle) transaction with on its dedup link, given the
+   transaction's first signature.  This is a hash of the whole signature
+   keyed with seed, which is shared by all verify and dedup tiles (the
+   dedup_shard_seed topology prop), so all copies of a transaction have
+   the same sig but senders cannot grind signatures that all land on
+   the same dedup shard.  Bundle transactions are published with sig 0.
+
+   fd_verify_dedup_shard returns which of shard_cnt dedup tiles handles
+   frags published with sig (see fd_dedup_tile.c).  Bundles (sig 0)
+   always go to shard 0. */
+
+FD_FN_PURE static inline ulong
+fd_verify_dedup_sig( ulong         seed,
+                     uchar const * signature ) {
+  return fd_hash( seed, signature, 64UL );
+}
+
+FD_FN_CONST static inline ulong
+fd_verify_dedup_shard( ulong sig,
+                       ulong shard_cnt ) {
+  return ((sig & 0xffffffffUL)*shard_cnt)>>32;
+}
+
 /* fd_verify_in_ctx_t is a context object for each in (producer) mcache
    connected to the verify tile. */
 
@@ -34,6 +58,9 @@ typedef struct {
   ulong * tcache_ring;
   ulong * tcache_map;
 
+  ulong * tcache_bkt; /* Bucketized tcache used instead of the above if non-NULL */
+  ulong   tcache_bkt_cnt;
+
   ulong              in_kind[ 32 ];
   fd_verify_in_ctx_t in[ 32 ];
 
@@ -43,6 +70,7 @@ typedef struct {
   ulong       out_chunk;
 
   ulong       hashmap_seed;
+  ulong       dedup_shard_seed; /* See fd_verify_dedup_sig */
 
   struct {
     ulong parse_fail_cnt;
@@ -52,6 +80,32 @@ typedef struct {
   } metrics;
 } fd_verify_ctx_t;
 
+/* fd_txn_verify_dedup_{query,insert} query / insert the ha dedup tag of
+   a transaction into the verify tile's tcache.  Both return 1 if the
+   tag was already there. */
+
+static inline int
+fd_txn_verify_dedup_query( fd_verify_ctx_t * ctx,
+                           ulong             ha_dedup_tag ) {
+  int ha_dup;
+  if( FD_UNLIKELY( ctx->tcache_bkt ) ) {
+    ha_dup = fd_tcache_bkt_query( ctx->tcache_bkt, ctx->tcache_bkt_cnt, ha_dedup_tag );
+  } else {
+    FD_FN_UNUSED ulong tcache_map_idx = 0; /* ignored */
+    FD_TCACHE_QUERY( ha_dup, tcache_map_idx, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+  }
+  return ha_dup;
+}
+
+static inline int
+fd_txn_verify_dedup_insert( fd_verify_ctx_t * ctx,
+                            ulong             ha_dedup_tag ) {
+  int ha_dup;
+  if( FD_UNLIKELY( ctx->tcache_bkt ) ) ha_dup = fd_tcache_bkt_insert( ctx->tcache_bkt, ctx->tcache_bkt_cnt, ha_dedup_tag );
+  else FD_TCACHE_INSERT( ha_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+  return ha_dup;
+}
+
 static inline int
 fd_txn_verify( fd_verify_ctx_t * ctx,
                uchar const *     udp_payload,
@@ -77,8 +131,7 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
   ulong ha_dedup_tag = fd_hash( ctx->hashmap_seed, signatures, 64UL );
   int ha_dup = 0;
   if( FD_LIKELY( dedup ) ) {
-    FD_FN_UNUSED ulong tcache_map_idx = 0; /* ignored */
-    FD_TCACHE_QUERY( ha_dup, tcache_map_idx, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+    ha_dup = fd_txn_verify_dedup_query( ctx, ha_dedup_tag );
     if( FD_UNLIKELY( ha_dup ) ) {
       return FD_TXN_VERIFY_DEDUP;
     }
@@ -93,7 +146,7 @@ fd_txn_verify( fd_verify_ctx_t * ctx,
   /* Insert into the tcache to dedup ha traffic.
      The dedup check is repeated to guard against duped txs verifying signatures at the same time */
   if( FD_LIKELY( dedup ) ) {
-    FD_TCACHE_INSERT( ha_dup, *ctx->tcache_sync, ctx->tcache_ring, ctx->tcache_depth, ctx->tcache_map, ctx->tcache_map_cnt, ha_dedup_tag );
+    ha_dup = fd_txn_verify_dedup_insert( ctx, ha_dedup_tag );
     if( FD_UNLIKELY( ha_dup ) ) {
       return FD_TXN_VERIFY_DEDUP;
     }
@@ -129,6 +129,7 @@ struct fd_exec_tile_ctx {
      setup when the exec tile is booted; its members are refreshed on
      the slot/epoch boundary. */
   fd_txn_p_t            txn;
+  ulong                 precompile_ok; /* Sent along with txn, see fd_exec_txn_ctx_t */
   fd_exec_txn_ctx_t *   txn_ctx;
   int                   exec_res;
 
@@ -207,7 +208,7 @@ prepare_new_epoch_execution( fd_exec_tile_ctx_t *            ctx,
   }
 
   // FIXME account for this in exec spad footprint
-  uchar *       stakes_mem = fd_spad_alloc( ctx->exec_spad, fd_stakes_align(), total_sz );
+  uchar *       stakes_mem = FD_SPAD_ALLOC_TRACKED( ctx->exec_spad, fd_stakes_align(), total_sz );
   fd_stakes_t * stakes     = fd_stakes_decode( stakes_mem, &decode );
   if( FD_UNLIKELY( !stakes ) ) {
     FD_LOG_ERR(( "Could not decode stakes" ));
@@ -281,7 +282,7 @@ prepare_new_slot_execution( fd_exec_tile_ctx_t *           ctx,
   }
 
   // FIXME account for this in exec spad footprint
-  uchar *                 block_hash_queue_mem = fd_spad_alloc( ctx->exec_spad, fd_block_hash_queue_align(), total_sz );
+  uchar *                 block_hash_queue_mem = FD_SPAD_ALLOC_TRACKED( ctx->exec_spad, fd_block_hash_queue_align(), total_sz );
   fd_block_hash_queue_t * block_hash_queue     = fd_block_hash_queue_decode( block_hash_queue_mem, &decode );
   if( FD_UNLIKELY( !block_hash_queue ) ) {
     FD_LOG_ERR(( "Could not decode block hash queue" ));
@@ -314,6 +315,7 @@ execute_txn( fd_exec_tile_ctx_t * ctx ) {
   task_info.txn->flags = FD_TXN_P_FLAGS_SANITIZE_SUCCESS;
 
   fd_exec_txn_ctx_setup( ctx->txn_ctx, txn_descriptor, &raw_txn );
+  ctx->txn_ctx->precompile_ok = ctx->precompile_ok;
 
   int err = fd_executor_setup_accessed_accounts_for_txn( ctx->txn_ctx );
   if( FD_UNLIKELY( err ) ) {
@@ -445,6 +447,7 @@ during_frag( fd_exec_tile_ctx_t * ctx,
     if( FD_LIKELY( sig==EXEC_NEW_TXN_SIG ) ) {
       fd_runtime_public_txn_msg_t * txn = (fd_runtime_public_txn_msg_t *)fd_chunk_to_laddr( ctx->replay_in_mem, chunk );
       fd_memcpy( &ctx->txn, &txn->txn, sizeof(fd_txn_p_t) );
+      ctx->precompile_ok = txn->precompile_ok;
       execute_txn( ctx );
       return;
     } else if( sig==EXEC_NEW_SLOT_SIG ) {
@@ -691,7 +694,7 @@ unprivileged_init( fd_topo_t *      topo,
 
   fd_spad_push( ctx->exec_spad );
   // FIXME account for this in exec spad footprint
-  uchar * txn_ctx_mem   = fd_spad_alloc( ctx->exec_spad, FD_EXEC_TXN_CTX_ALIGN, FD_EXEC_TXN_CTX_FOOTPRINT );
+  uchar * txn_ctx_mem   = FD_SPAD_ALLOC_TRACKED( ctx->exec_spad, FD_EXEC_TXN_CTX_ALIGN, FD_EXEC_TXN_CTX_FOOTPRINT );
   ctx->txn_ctx          = fd_exec_txn_ctx_join( fd_exec_txn_ctx_new( txn_ctx_mem ), ctx->exec_spad, ctx->exec_spad_wksp );
   ctx->txn_ctx->funk    = ctx->funk;
 
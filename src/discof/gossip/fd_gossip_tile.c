@@ -2,6 +2,7 @@
 #define _GNU_SOURCE
 
 #include "../../disco/topo/fd_topo.h"
+#include <time.h> /* CLOCK_REALTIME needed for seccomp filter */
 #include "generated/fd_gossip_tile_seccomp.h"
 
 #include "../store/util.h"
@@ -1129,6 +1130,7 @@ metrics_write( fd_gossip_tile_ctx_t * ctx ) {
 
 fd_topo_run_tile_t fd_tile_gossip = {
   .name                     = "gossip",
+  .allow_idle_sleep         = 1,
   .loose_footprint          = loose_footprint,
   .populate_allowed_seccomp = populate_allowed_seccomp,
   .populate_allowed_fds     = populate_allowed_fds,
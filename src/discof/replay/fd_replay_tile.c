@@ -13,6 +13,7 @@
 #include "../../flamenco/runtime/context/fd_exec_epoch_ctx.h"
 #include "../../flamenco/runtime/context/fd_exec_slot_ctx.h"
 #include "../../flamenco/runtime/program/fd_bpf_program_util.h"
+#include "../../flamenco/runtime/program/fd_precompiles.h"
 #include "../../flamenco/runtime/sysvar/fd_sysvar_epoch_schedule.h"
 #include "../../flamenco/runtime/sysvar/fd_sysvar_slot_history.h"
 #include "../../flamenco/runtime/fd_hashes.h"
@@ -74,6 +75,12 @@
 #define VOTE_ACC_MAX   (2000000UL)
 
 #define BANK_HASH_CMP_LG_MAX (16UL)
+
+/* PRECOMPILE_TXN_MAX is the max number of transactions at the start of
+   a microblock whose precompiles are verified ahead of dispatch (see
+   verify_mblk_precompiles).  The executor verifies the precompiles of
+   the others itself. */
+#define PRECOMPILE_TXN_MAX (64UL)
 struct fd_shred_replay_in_ctx {
   fd_wksp_t * mem;
   ulong       chunk0;
@@ -112,6 +119,9 @@ struct fd_slice_exec_ctx {
 
   ulong last_mblk_off; /* offset to the last microblock hdr seen */
   int   last_batch;    /* signifies last batch execution for stopping condition */
+
+  ulong mblk_txn_idx;                       /* index in the current microblock of the next txn to dispatch */
+  ulong precompile_ok[ PRECOMPILE_TXN_MAX ]; /* fd_precompile_verify_txns results of the current microblock's first txns */
 };
 typedef struct fd_slice_exec_ctx fd_slice_exec_ctx_t;
 
@@ -222,6 +232,7 @@ struct fd_replay_tile_ctx {
 
   uchar * mbatch; /* TODO move mbatch to slice_exec_ctx or replay */
   fd_slice_exec_ctx_t slice_exec_ctx;
+  fd_txn_p_t * precompile_txns; /* PRECOMPILE_TXN_MAX scratch txns for verify_mblk_precompiles */
 
   /* Depends on store_int and is polled in after_credit */
 
@@ -371,6 +382,7 @@ scratch_footprint( fd_topo_tile_t const * tile FD_PARAM_UNUSED ) {
     l = FD_LAYOUT_APPEND( l, FD_BMTREE_COMMIT_ALIGN, FD_BMTREE_COMMIT_FOOTPRINT(0) );
   }
   l = FD_LAYOUT_APPEND( l, 128UL, FD_SLICE_MAX );
+  l = FD_LAYOUT_APPEND( l, alignof(fd_txn_p_t), PRECOMPILE_TXN_MAX*sizeof(fd_txn_p_t) );
   l = FD_LAYOUT_FINI  ( l, scratch_align() );
   return l;
 }
@@ -1717,6 +1729,43 @@ prepare_first_batch_execution( fd_replay_tile_ctx_t * ctx, fd_stem_context_t * s
 
 }
 
+/* verify_mblk_precompiles verifies the precompile instructions of
+   (up to PRECOMPILE_TXN_MAX of) the transactions of the microblock
+   starting at the slice_exec_ctx wmark ahead of their dispatch, with
+   fd_precompile_verify_txns (which batches the ed25519 signatures of
+   all of them).  This runs while the exec tiles are still busy with
+   the previous microblock.  The results go to the exec tiles with each
+   transaction and end up in fd_exec_txn_ctx_t precompile_ok. */
+
+static void
+verify_mblk_precompiles( fd_replay_tile_ctx_t * ctx ) {
+  fd_slice_exec_ctx_t * slice = &ctx->slice_exec_ctx;
+  slice->mblk_txn_idx = 0UL;
+
+  ulong txn_cnt = fd_ulong_min( slice->txns_rem, PRECOMPILE_TXN_MAX );
+  ulong off     = slice->wmark;
+  for( ulong i=0UL; i<txn_cnt; i++ ) {
+    fd_txn_p_t * txn_p  = ctx->precompile_txns + i;
+    ulong        pay_sz = 0UL;
+    ulong        txn_sz = fd_txn_parse_core( ctx->mbatch + off,
+                                             fd_ulong_min( FD_TXN_MTU, slice->sz - off ),
+                                             TXN( txn_p ),
+                                             NULL,
+                                             &pay_sz );
+    if( FD_UNLIKELY( !pay_sz || !txn_sz || txn_sz > FD_TXN_MTU ) ) {
+      /* exec_slice fails on it when it gets there */
+      txn_cnt = i;
+      break;
+    }
+    fd_memcpy( txn_p->payload, ctx->mbatch + off, pay_sz );
+    txn_p->payload_sz = pay_sz;
+    off += pay_sz;
+  }
+
+  fd_precompile_verify_txns( ctx->precompile_txns, txn_cnt, slice->precompile_ok );
+  for( ulong i=txn_cnt; i<PRECOMPILE_TXN_MAX; i++ ) slice->precompile_ok[ i ] = 0UL;
+}
+
 static void
 exec_slice( fd_replay_tile_ctx_t * ctx,
              fd_stem_context_t *   stem,
@@ -1786,6 +1835,8 @@ exec_slice( fd_replay_tile_ctx_t * ctx,
 
       fd_runtime_public_txn_msg_t * exec_msg = (fd_runtime_public_txn_msg_t *)fd_chunk_to_laddr( exec_out->mem, exec_out->chunk );
       memcpy( &exec_msg->txn, &txn_p, sizeof(fd_txn_p_t) );
+      ulong mblk_txn_idx = ctx->slice_exec_ctx.mblk_txn_idx++;
+      exec_msg->precompile_ok = mblk_txn_idx<PRECOMPILE_TXN_MAX ? ctx->slice_exec_ctx.precompile_ok[ mblk_txn_idx ] : 0UL;
 
       fd_fork_t * fork = fd_fork_frontier_ele_query( ctx->forks->frontier,
                                                      &slot,
@@ -1820,6 +1871,7 @@ exec_slice( fd_replay_tile_ctx_t * ctx,
       ctx->slice_exec_ctx.last_mblk_off = ctx->slice_exec_ctx.wmark;
       ctx->slice_exec_ctx.wmark        += sizeof(fd_microblock_hdr_t);
       ctx->slice_exec_ctx.mblks_rem--;
+      verify_mblk_precompiles( ctx );
       break; /* have to synchronize & wait for exec tiles to finish the prev microblock */
     }
 
@@ -3029,6 +3081,7 @@ unprivileged_init( fd_topo_t *      topo,
     ctx->bmtree[i]           = FD_SCRATCH_ALLOC_APPEND( l, FD_BMTREE_COMMIT_ALIGN, FD_BMTREE_COMMIT_FOOTPRINT(0) );
   }
   void * mbatch_mem          = FD_SCRATCH_ALLOC_APPEND( l, 128UL, FD_SLICE_MAX );
+  ctx->precompile_txns       = FD_SCRATCH_ALLOC_APPEND( l, alignof(fd_txn_p_t), PRECOMPILE_TXN_MAX*sizeof(fd_txn_p_t) );
   ulong  scratch_alloc_mem   = FD_SCRATCH_ALLOC_FINI  ( l, scratch_align() );
 
   if( FD_UNLIKELY( scratch_alloc_mem != ( (ulong)scratch + scratch_footprint( tile ) ) ) ) {
@@ -3515,6 +3568,19 @@ static inline void
 metrics_write( fd_replay_tile_ctx_t * ctx ) {
   FD_MGAUGE_SET( REPLAY, LAST_VOTED_SLOT, ctx->metrics.last_voted_slot );
   FD_MGAUGE_SET( REPLAY, SLOT, ctx->metrics.slot );
+
+  ulong spad_mem_max   = 0UL;
+  ulong spad_mem_wmark = 0UL;
+  ulong spad_alloc_cnt = 0UL;
+  for( ulong i=0UL; i<ctx->exec_spad_cnt; i++ ) {
+    fd_spad_t const * spad = ctx->exec_spads[ i ];
+    spad_mem_max    = fd_ulong_max( spad_mem_max,   fd_spad_mem_max  ( spad ) );
+    spad_mem_wmark  = fd_ulong_max( spad_mem_wmark, fd_spad_mem_wmark( spad ) );
+    spad_alloc_cnt += fd_spad_alloc_cnt( spad );
+  }
+  FD_MGAUGE_SET( REPLAY, EXEC_SPAD_MEM_MAX,   spad_mem_max   );
+  FD_MGAUGE_SET( REPLAY, EXEC_SPAD_MEM_WMARK, spad_mem_wmark );
+  FD_MGAUGE_SET( REPLAY, EXEC_SPAD_ALLOC_CNT, spad_alloc_cnt );
 }
 
 /* TODO: This needs to get sized out correctly. */
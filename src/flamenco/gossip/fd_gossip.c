@@ -1,6 +1,7 @@
 #include "fd_gossip.h"
 #include "../../ballet/base58/fd_base58.h"
 #include "../../disco/keyguard/fd_keyguard.h"
+#include "../../ballet/ed25519/fd_ed25519_pubkey_cache.h"
 
 /* Maximum size of a network packet */
 #define PACKET_DATA_SIZE 1232
@@ -44,6 +45,9 @@
 #define FD_NEED_PUSH_MAX (1<<12)
 /* Max size of receive statistics table */
 #define FD_STATS_KEY_MAX (1<<8)
+/* Number of sets (of 4 keys) of the cache of decompressed origin
+   public keys used for signature verification */
+#define FD_PUBKEY_CACHE_SET_CNT (1UL<<10)
 /* Sha256 pre-image size for pings/pongs */
 #define FD_PING_PRE_IMAGE_SZ (48UL)
 /* Number of recognized CRDS enum members */
@@ -398,6 +402,9 @@ struct fd_gossip {
     /* Stake weights */
     fd_weights_elem_t * weights;
 
+    /* Decompressed public keys of recent signers (e.g. CRDS origins) */
+    fd_ed25519_pubkey_cache_t * pubkey_cache;
+
     /* List of added entrypoints at startup */
     ulong entrypoints_cnt;
     fd_gossip_peer_addr_t entrypoints[16];
@@ -427,6 +434,7 @@ fd_gossip_footprint( void ) {
   l = FD_LAYOUT_APPEND( l, fd_stats_table_align(), fd_stats_table_footprint(FD_STATS_KEY_MAX) );
   l = FD_LAYOUT_APPEND( l, fd_weights_table_align(), fd_weights_table_footprint(MAX_STAKE_WEIGHTS) );
   l = FD_LAYOUT_APPEND( l, fd_push_states_pool_align(), fd_push_states_pool_footprint(FD_PUSH_LIST_MAX) );
+  l = FD_LAYOUT_APPEND( l, fd_ed25519_pubkey_cache_align(), fd_ed25519_pubkey_cache_footprint(FD_PUBKEY_CACHE_SET_CNT) );
   l = FD_LAYOUT_FINI( l, fd_gossip_align() );
   return l;
 }
@@ -468,6 +476,9 @@ fd_gossip_new ( void * shmem, ulong seed ) {
   shm = FD_SCRATCH_ALLOC_APPEND(l, fd_push_states_pool_align(), fd_push_states_pool_footprint(FD_PUSH_LIST_MAX));
   glob->push_states_pool = fd_push_states_pool_join( fd_push_states_pool_new( shm, FD_PUSH_LIST_MAX ) );
 
+  shm = FD_SCRATCH_ALLOC_APPEND(l, fd_ed25519_pubkey_cache_align(), fd_ed25519_pubkey_cache_footprint(FD_PUBKEY_CACHE_SET_CNT));
+  glob->pubkey_cache = fd_ed25519_pubkey_cache_join( fd_ed25519_pubkey_cache_new( shm, FD_PUBKEY_CACHE_SET_CNT, seed ) );
+
   ulong scratch_top = FD_SCRATCH_ALLOC_FINI( l, fd_gossip_align() );
   if ( scratch_top > (ulong)shmem + fd_gossip_footprint() ) {
     FD_LOG_ERR(("Not enough space allocated for gossip"));
@@ -492,6 +503,7 @@ fd_gossip_delete ( void * shmap ) {
   fd_stats_table_delete( fd_stats_table_leave( glob->stats ) );
   fd_weights_table_delete( fd_weights_table_leave( glob->weights ) );
   fd_push_states_pool_delete( fd_push_states_pool_leave( glob->push_states_pool ) );
+  fd_ed25519_pubkey_cache_delete( fd_ed25519_pubkey_cache_leave( glob->pubkey_cache ) );
 
   return glob;
 }
@@ -926,11 +938,12 @@ static void
 fd_gossip_handle_ping( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, fd_gossip_ping_t const * ping ) {
   /* Verify the signature */
   fd_sha512_t sha2[1];
-  if (fd_ed25519_verify( /* msg */ ping->token.uc,
-                         /* sz */ 32UL,
-                         /* sig */ ping->signature.uc,
-                         /* public_key */ ping->from.uc,
-                         sha2 )) {
+  if (fd_ed25519_verify_cached( /* msg */ ping->token.uc,
+                                /* sz */ 32UL,
+                                /* sig */ ping->signature.uc,
+                                /* public_key */ ping->from.uc,
+                                sha2,
+                                glob->pubkey_cache )) {
     glob->metrics.recv_ping_invalid_signature += 1UL;
     FD_LOG_WARNING(("received ping with invalid signature"));
     return;
@@ -1288,11 +1301,12 @@ fd_gossip_handle_pong( fd_gossip_t * glob, const fd_gossip_peer_addr_t * from, f
 
   /* Verify the signature */
   fd_sha512_t sha2[1];
-  if (fd_ed25519_verify( /* msg */ pong->token.uc,
-                         /* sz */ 32UL,
-                         /* sig */ pong->signature.uc,
-                         /* public_key */ pong->from.uc,
-                         sha2 )) {
+  if (fd_ed25519_verify_cached( /* msg */ pong->token.uc,
+                                /* sz */ 32UL,
+                                /* sig */ pong->signature.uc,
+                                /* public_key */ pong->from.uc,
+                                sha2,
+                                glob->pubkey_cache )) {
     INC_RECV_PONG_EVENT_CNT( INVALID_SIGNATURE );
     FD_LOG_WARNING(("received pong with invalid signature"));
     return;
@@ -1422,18 +1436,19 @@ fd_crds_dup_check( fd_gossip_t * glob, fd_hash_t * key, const fd_gossip_peer_add
       uchar* data;
     } */
 static int
-fd_crds_sigverify( uchar * crds_encoded_val, ulong crds_encoded_len, fd_pubkey_t * pubkey ) {
+fd_crds_sigverify( fd_gossip_t * glob, uchar * crds_encoded_val, ulong crds_encoded_len, fd_pubkey_t * pubkey ) {
 
   fd_signature_t * sig = (fd_signature_t *)crds_encoded_val;
   uchar * data = (crds_encoded_val + sizeof(fd_signature_t));
   ulong datalen = crds_encoded_len - sizeof(fd_signature_t);
 
   static fd_sha512_t sha[1]; /* static is ok since ed25519_verify calls sha512_init */
-  return fd_ed25519_verify( data,
-                         datalen,
-                         sig->uc,
-                         pubkey->uc,
-                         sha );
+  return fd_ed25519_verify_cached( data,
+                                   datalen,
+                                   sig->uc,
+                                   pubkey->uc,
+                                   sha,
+                                   glob->pubkey_cache );
 }
 
 
@@ -1594,7 +1609,7 @@ fd_gossip_recv_crds_array( fd_gossip_t * glob, const fd_gossip_peer_addr_t * fro
           traffic (~90%)
         - will be deprecated soon */
     if( tmp->crd->data.discriminant != fd_crds_data_enum_epoch_slots &&
-        fd_crds_sigverify( tmp->encoded_val, tmp->encoded_len, tmp->pubkey ) ) {
+        fd_crds_sigverify( glob, tmp->encoded_val, tmp->encoded_len, tmp->pubkey ) ) {
       INC_RECV_CRDS_DROP_METRIC( INVALID_SIGNATURE );
       /* drop full packet on bad signature
           https://github.com/anza-xyz/agave/commit/d68b5de6c0fc07d60cf9749ae82c2651a549e81b */
@@ -180,6 +180,7 @@ fd_exec_txn_ctx_setup_basic( fd_exec_txn_ctx_t * ctx ) {
   ctx->compute_meter      = 200000;
   ctx->prioritization_fee_type = FD_COMPUTE_BUDGET_PRIORITIZATION_FEE_TYPE_DEPRECATED;
   ctx->custom_err         = UINT_MAX;
+  ctx->precompile_ok      = 0UL;
 
   ctx->instr_stack_sz                  = 0;
   ctx->accounts_cnt                    = 0UL;
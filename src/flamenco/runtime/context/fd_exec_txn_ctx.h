@@ -101,6 +101,7 @@ struct __attribute__((aligned(8UL))) fd_exec_txn_ctx {
   fd_txn_t const *                txn_descriptor;                              /* Descriptor of the transaction. */
   fd_rawtxn_b_t                   _txn_raw[1];                                 /* Raw bytes of the transaction. */
   uint                            custom_err;                                  /* When a custom error is returned, this is where the numeric value gets stashed */
+  ulong                           precompile_ok;                               /* Bit i set if instruction i is a precompile already verified successfully, see fd_precompile_verify_txns */
   uchar                           instr_stack_sz;                              /* Current depth of the instruction execution stack. */
   fd_exec_instr_ctx_t             instr_stack[FD_MAX_INSTRUCTION_STACK_DEPTH]; /* Instruction execution stack. */
   fd_exec_instr_ctx_t *           failed_instr;
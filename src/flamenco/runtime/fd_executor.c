@@ -182,7 +182,7 @@ fd_executor_is_system_nonce_account( fd_txn_account_t * account, fd_spad_t * exe
         return -1;
       }
 
-      uchar * mem = fd_spad_alloc( exec_spad, fd_nonce_state_versions_align(), total_sz );
+      uchar * mem = FD_SPAD_ALLOC_TRACKED( exec_spad, fd_nonce_state_versions_align(), total_sz );
       if( FD_UNLIKELY( !mem ) ) {
         FD_LOG_ERR(( "Unable to allocate memory" ));
       }
@@ -1217,7 +1217,7 @@ fd_executor_setup_txn_account( fd_exec_txn_ctx_t * txn_ctx,
   memcpy( txn_account->pubkey->key, acc, sizeof(fd_pubkey_t) );
 
   if( fd_exec_txn_ctx_account_is_writable_idx( txn_ctx, idx ) || idx==FD_FEE_PAYER_TXN_IDX ) {
-    void * txn_account_data = fd_spad_alloc( txn_ctx->spad, FD_ACCOUNT_REC_ALIGN, FD_ACC_TOT_SZ_MAX );
+    void * txn_account_data = FD_SPAD_ALLOC_TRACKED( txn_ctx->spad, FD_ACCOUNT_REC_ALIGN, FD_ACC_TOT_SZ_MAX );
 
     /* promote the account to mutable, which requires a memcpy*/
     fd_txn_account_make_mutable( txn_account, txn_account_data, txn_ctx->spad_wksp );
@@ -1324,7 +1324,7 @@ int
 fd_executor_txn_verify( fd_exec_txn_ctx_t * txn_ctx ) {
   fd_sha512_t * shas[ FD_TXN_ACTUAL_SIG_MAX ];
   for ( ulong i=0UL; i<FD_TXN_ACTUAL_SIG_MAX; i++ ) {
-    fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( fd_spad_alloc( txn_ctx->spad, alignof(fd_sha512_t), sizeof(fd_sha512_t) ) ) );
+    fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( FD_SPAD_ALLOC_TRACKED( txn_ctx->spad, alignof(fd_sha512_t), sizeof(fd_sha512_t) ) ) );
     if( FD_UNLIKELY( !sha ) ) FD_LOG_ERR(( "fd_sha512_join failed" ));
     shas[i] = sha;
   }
@@ -36,6 +36,7 @@
 #include "program/fd_bpf_loader_program.h"
 #include "program/fd_compute_budget_program.h"
 #include "program/fd_address_lookup_table_program.h"
+#include "program/fd_precompiles.h"
 
 #include "sysvar/fd_sysvar_clock.h"
 #include "sysvar/fd_sysvar_fees.h"
@@ -2008,7 +2009,8 @@ fd_runtime_prepare_and_execute_txn( fd_exec_slot_ctx_t const *   slot_ctx,
     return -1;
   }
 
-  task_info->txn_ctx->capture_ctx = capture_ctx;
+  task_info->txn_ctx->capture_ctx   = capture_ctx;
+  task_info->txn_ctx->precompile_ok = task_info->precompile_ok;
 
   if( FD_UNLIKELY( fd_executor_txn_verify( txn_ctx )!=0 ) ) {
     FD_LOG_WARNING(( "sigverify failed: %s", FD_BASE58_ENC_64_ALLOCA( (uchar *)txn_ctx->_txn_raw->raw+txn_ctx->txn_descriptor->signature_off ) ));
@@ -2105,6 +2107,7 @@ fd_runtime_process_txns_in_microblock_stream( fd_exec_slot_ctx_t * slot_ctx,
                                               fd_capture_ctx_t *   capture_ctx,
                                               fd_txn_p_t *         txns,
                                               ulong                txn_cnt,
+                                              ulong const *        precompile_ok_opt,
                                               fd_tpool_t *         tpool,
                                               fd_spad_t * *        exec_spads,
                                               ulong                exec_spad_cnt,
@@ -2139,8 +2142,9 @@ fd_runtime_process_txns_in_microblock_stream( fd_exec_slot_ctx_t * slot_ctx,
         continue;
       }
 
-      task_infos[ curr_exec_idx ].spad    = exec_spads[ worker_idx ];
-      task_infos[ curr_exec_idx ].txn     = &txns[ curr_exec_idx ];
+      task_infos[ curr_exec_idx ].spad          = exec_spads[ worker_idx ];
+      task_infos[ curr_exec_idx ].txn           = &txns[ curr_exec_idx ];
+      task_infos[ curr_exec_idx ].precompile_ok = precompile_ok_opt ? precompile_ok_opt[ curr_exec_idx ] : 0UL;
       task_infos[ curr_exec_idx ].txn_ctx = fd_spad_alloc( task_infos[ curr_exec_idx ].spad,
                                                            FD_EXEC_TXN_CTX_ALIGN,
                                                            FD_EXEC_TXN_CTX_FOOTPRINT );
@@ -4081,6 +4085,13 @@ fd_runtime_block_execute_tpool( fd_exec_slot_ctx_t *    slot_ctx,
 
   fd_runtime_block_collect_txns( block_info, txn_ptrs );
 
+  /* Verify the precompile instructions of the whole block up front,
+     batched and across all workers, instead of one signature at a time
+     while executing (precompile heavy blocks otherwise serialize on
+     them). */
+  ulong * precompile_ok = fd_spad_alloc( runtime_spad, alignof(ulong), txn_cnt * sizeof(ulong) );
+  fd_precompile_verify_txns_tpool( txn_ptrs, txn_cnt, precompile_ok, tpool );
+
   /* Initialize the cost tracker when the feature is active */
   fd_cost_tracker_t * cost_tracker = fd_spad_alloc( runtime_spad, FD_COST_TRACKER_ALIGN, FD_COST_TRACKER_FOOTPRINT );
   if( FD_FEATURE_ACTIVE( slot_ctx->slot_bank.slot, slot_ctx->epoch_ctx->features, apply_cost_tracker_during_replay ) ) {
@@ -4092,8 +4103,9 @@ fd_runtime_block_execute_tpool( fd_exec_slot_ctx_t *    slot_ctx,
   for( ulong i=0UL; i<block_info->microblock_batch_cnt; i++ ) {
     for( ulong j=0UL; j<block_info->microblock_batch_infos[i].microblock_cnt; j++ ) {
       ulong txn_cnt = block_info->microblock_batch_infos[i].microblock_infos[j].microblock.hdr->txn_cnt;
-      fd_txn_p_t * mblock_txn_ptrs = &txn_ptrs[ to_exec_idx ];
-      ulong        mblock_txn_cnt  = txn_cnt;
+      fd_txn_p_t *  mblock_txn_ptrs      = &txn_ptrs[ to_exec_idx ];
+      ulong         mblock_txn_cnt       = txn_cnt;
+      ulong const * mblock_precompile_ok = &precompile_ok[ to_exec_idx ];
       to_exec_idx += txn_cnt;
 
       if( !mblock_txn_cnt ) continue;
@@ -4102,6 +4114,7 @@ fd_runtime_block_execute_tpool( fd_exec_slot_ctx_t *    slot_ctx,
                                                           capture_ctx,
                                                           mblock_txn_ptrs,
                                                           mblock_txn_cnt,
+                                                          mblock_precompile_ok,
                                                           tpool,
                                                           exec_spads,
                                                           exec_spad_cnt,
@@ -78,6 +78,7 @@ struct fd_execute_txn_task_info {
   fd_exec_txn_ctx_t * txn_ctx;
   fd_txn_p_t *        txn;
   int                 exec_res;
+  ulong               precompile_ok; /* See fd_exec_txn_ctx_t */
 };
 typedef struct fd_execute_txn_task_info fd_execute_txn_task_info_t;
 
@@ -572,13 +573,15 @@ fd_runtime_process_txns( fd_exec_slot_ctx_t * slot_ctx,
 
 /* fd_runtime_execute_txns_in_microblock_stream is responsible for end-to-end
    preparing, executing and finalizng a list of transactions. It assumes that
-   all transactions are conflict-free. */
+   all transactions are conflict-free. precompile_ok_opt, if non-NULL, holds
+   the fd_precompile_verify_txns results of the transactions. */
 
 int
 fd_runtime_process_txns_in_microblock_stream( fd_exec_slot_ctx_t * slot_ctx,
                                               fd_capture_ctx_t *   capture_ctx,
                                               fd_txn_p_t *         all_txns,
                                               ulong                total_txn_cnt,
+                                              ulong const *        precompile_ok_opt,
                                               fd_tpool_t *         tpool,
                                               fd_spad_t * *        exec_spads,
                                               ulong                exec_spad_cnt,
@@ -224,6 +224,7 @@ typedef struct fd_runtime_public_slot_msg fd_runtime_public_slot_msg_t;
 
 struct fd_runtime_public_txn_msg {
   fd_txn_p_t txn;
+  ulong      precompile_ok; /* See fd_exec_txn_ctx_t */
 };
 typedef struct fd_runtime_public_txn_msg fd_runtime_public_txn_msg_t;
 
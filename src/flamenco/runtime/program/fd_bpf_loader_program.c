@@ -120,7 +120,7 @@ read_bpf_upgradeable_loader_state_for_program( fd_exec_txn_ctx_t *
     return NULL;
   }
 
-  uchar * mem = fd_spad_alloc( txn_ctx->spad, FD_BPF_UPGRADEABLE_LOADER_STATE_ALIGN, total_sz );
+  uchar * mem = FD_SPAD_ALLOC_TRACKED( txn_ctx->spad, FD_BPF_UPGRADEABLE_LOADER_STATE_ALIGN, total_sz );
   if( FD_UNLIKELY( !mem ) ) {
     FD_LOG_ERR(( "Unable to allocate memory for bpf upgradeable loader state" ));
   }
@@ -177,9 +177,9 @@ fd_deploy_program( fd_exec_instr_ctx_t * instr_ctx,
                    fd_spad_t *           spad ) {
   int deploy_mode    = 1;
   int direct_mapping = FD_FEATURE_ACTIVE( instr_ctx->txn_ctx->slot, instr_ctx->txn_ctx->features, bpf_account_data_direct_mapping );
-  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( fd_spad_alloc( spad,
-                                                                       fd_sbpf_syscalls_align(),
-                                                                       fd_sbpf_syscalls_footprint() ) );
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( FD_SPAD_ALLOC_TRACKED( spad,
+                                                                               fd_sbpf_syscalls_align(),
+                                                                               fd_sbpf_syscalls_footprint() ) );
   if( FD_UNLIKELY( !syscalls ) ) {
     //TODO: full log including err
     fd_log_collector_msg_literal( instr_ctx, "Failed to register syscalls" );
@@ -206,7 +206,7 @@ fd_deploy_program( fd_exec_instr_ctx_t * instr_ctx,
   }
 
   /* Allocate rodata segment */
-  void * rodata = fd_spad_alloc( spad, FD_SBPF_PROG_RODATA_ALIGN, elf_info->rodata_footprint );
+  void * rodata = FD_SPAD_ALLOC_TRACKED( spad, FD_SBPF_PROG_RODATA_ALIGN, elf_info->rodata_footprint );
   if( FD_UNLIKELY( !rodata ) ) {
     return FD_EXECUTOR_INSTR_ERR_INVALID_ACC_DATA;
   }
@@ -214,7 +214,7 @@ fd_deploy_program( fd_exec_instr_ctx_t * instr_ctx,
   /* Allocate program buffer */
   ulong  prog_align        = fd_sbpf_program_align();
   ulong  prog_footprint    = fd_sbpf_program_footprint( elf_info );
-  fd_sbpf_program_t * prog = fd_sbpf_program_new( fd_spad_alloc( spad, prog_align, prog_footprint ), elf_info, rodata );
+  fd_sbpf_program_t * prog = fd_sbpf_program_new( FD_SPAD_ALLOC_TRACKED( spad, prog_align, prog_footprint ), elf_info, rodata );
   if( FD_UNLIKELY( !prog ) ) {
     FD_LOG_ERR(( "fd_sbpf_program_new() failed: %s", fd_sbpf_strerror() ));
   }
@@ -319,7 +319,7 @@ fd_bpf_loader_program_get_state( fd_txn_account_t const * acct,
       return NULL;
     }
 
-    uchar * mem = fd_spad_alloc( spad, FD_BPF_UPGRADEABLE_LOADER_STATE_ALIGN, total_sz );
+    uchar * mem = FD_SPAD_ALLOC_TRACKED( spad, FD_BPF_UPGRADEABLE_LOADER_STATE_ALIGN, total_sz );
     if( FD_UNLIKELY( !mem ) ) {
       FD_LOG_ERR(( "Unable to allocate memory for bpf upgradeable loader state" ));
     }
@@ -423,9 +423,9 @@ int
 fd_bpf_execute( fd_exec_instr_ctx_t * instr_ctx, fd_sbpf_validated_program_t * prog, uchar is_deprecated ) {
 
   int err                       = FD_EXECUTOR_INSTR_SUCCESS;
-  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( fd_spad_alloc( instr_ctx->txn_ctx->spad,
-                                                                       fd_sbpf_syscalls_align(),
-                                                                       fd_sbpf_syscalls_footprint() ) );
+  fd_sbpf_syscalls_t * syscalls = fd_sbpf_syscalls_new( FD_SPAD_ALLOC_TRACKED( instr_ctx->txn_ctx->spad,
+                                                                               fd_sbpf_syscalls_align(),
+                                                                               fd_sbpf_syscalls_footprint() ) );
   FD_TEST( syscalls );
 
   /* TODO do we really need to re-do this on every instruction? */
@@ -505,7 +505,7 @@ fd_bpf_execute( fd_exec_instr_ctx_t * instr_ctx, fd_sbpf_validated_program_t * p
   if( FD_UNLIKELY( !memcmp( signature, sig, 64UL ) ) ) {
     ulong event_max = FD_RUNTIME_VM_TRACE_EVENT_MAX;
     ulong event_data_max = FD_RUNTIME_VM_TRACE_EVENT_DATA_MAX;
-    vm->trace = fd_vm_trace_join( fd_vm_trace_new( fd_spad_alloc(
+    vm->trace = fd_vm_trace_join( fd_vm_trace_new( FD_SPAD_ALLOC_TRACKED(
     instr_ctx->txn_ctx->spad, fd_vm_trace_align(), fd_vm_trace_footprint( event_max, event_data_max ) ), event_max, event_data_max ) );
     if( FD_UNLIKELY( !vm->trace ) ) FD_LOG_ERR(( "unable to create trace; make sure you've compiled with sufficient spad size " ));
   }
@@ -647,9 +647,9 @@ process_loader_upgradeable_instruction( fd_exec_instr_ctx_t * instr_ctx ) {
     return FD_EXECUTOR_INSTR_ERR_INVALID_INSTR_DATA;
   }
 
-  uchar * mem = fd_spad_alloc( spad,
-                               fd_bpf_upgradeable_loader_program_instruction_footprint(),
-                               total_sz );
+  uchar * mem = FD_SPAD_ALLOC_TRACKED( spad,
+                                       fd_bpf_upgradeable_loader_program_instruction_footprint(),
+                                       total_sz );
   if( FD_UNLIKELY( !mem ) ) {
     FD_LOG_ERR(( "Unable to allocate memory for bpf upgradeable loader instruction" ));
   }
@@ -983,9 +983,9 @@ process_loader_upgradeable_instruction( fd_exec_instr_ctx_t * instr_ctx ) {
       }
 
       fd_vm_rust_account_meta_t * acct_metas = (fd_vm_rust_account_meta_t*)
-                                                fd_spad_alloc( instr_ctx->txn_ctx->spad,
-                                                               FD_VM_RUST_ACCOUNT_META_ALIGN,
-                                                               3UL * sizeof(fd_vm_rust_account_meta_t) );
+                                                FD_SPAD_ALLOC_TRACKED( instr_ctx->txn_ctx->spad,
+                                                                       FD_VM_RUST_ACCOUNT_META_ALIGN,
+                                                                       3UL * sizeof(fd_vm_rust_account_meta_t) );
       fd_native_cpi_create_account_meta( payer_key,       1U, 1U, &acct_metas[ 0UL ] );
       fd_native_cpi_create_account_meta( programdata_key, 1U, 1U, &acct_metas[ 1UL ] );
       fd_native_cpi_create_account_meta( buffer_key,      0U, 1U, &acct_metas[ 2UL ] );
@@ -1866,9 +1866,9 @@ process_loader_upgradeable_instruction( fd_exec_instr_ctx_t * instr_ctx ) {
         }
 
         fd_vm_rust_account_meta_t * acct_metas = (fd_vm_rust_account_meta_t *)
-                                                  fd_spad_alloc( instr_ctx->txn_ctx->spad,
-                                                                    FD_VM_RUST_ACCOUNT_META_ALIGN,
-                                                                    2UL * sizeof(fd_vm_rust_account_meta_t) );
+                                                  FD_SPAD_ALLOC_TRACKED( instr_ctx->txn_ctx->spad,
+                                                                            FD_VM_RUST_ACCOUNT_META_ALIGN,
+                                                                            2UL * sizeof(fd_vm_rust_account_meta_t) );
         fd_native_cpi_create_account_meta( payer_key,       1UL, 1UL, &acct_metas[ 0UL ] );
         fd_native_cpi_create_account_meta( programdata_key, 0UL, 1UL, &acct_metas[ 1UL ] );
 
@@ -2100,9 +2100,9 @@ process_loader_upgradeable_instruction( fd_exec_instr_ctx_t * instr_ctx ) {
         uchar                              instr_data[FD_TXN_MTU];
         fd_loader_v4_program_instruction_t instr      = {0};
         fd_bincode_encode_ctx_t            encode_ctx = {0};
-        fd_vm_rust_account_meta_t *        acct_metas = fd_spad_alloc( instr_ctx->txn_ctx->spad,
-                                                                       FD_VM_RUST_ACCOUNT_META_ALIGN,
-                                                                       3UL * sizeof(fd_vm_rust_account_meta_t) );
+        fd_vm_rust_account_meta_t *        acct_metas = FD_SPAD_ALLOC_TRACKED( instr_ctx->txn_ctx->spad,
+                                                                               FD_VM_RUST_ACCOUNT_META_ALIGN,
+                                                                               3UL * sizeof(fd_vm_rust_account_meta_t) );
 
         /* https://github.com/anza-xyz/agave/blob/v2.2.6/programs/bpf_loader/src/lib.rs#L1441-L1484 */
         if( FD_LIKELY( program_len>0UL ) ) {
@@ -2524,7 +2524,7 @@ fd_directly_invoke_loader_v3_deploy( fd_exec_slot_ctx_t * slot_ctx,
                                      ulong                elf_sz,
                                      fd_spad_t *          runtime_spad ) {
   /* Set up a dummy instr and txn context */
-  fd_exec_txn_ctx_t * txn_ctx            = fd_exec_txn_ctx_join( fd_exec_txn_ctx_new( fd_spad_alloc( runtime_spad, FD_EXEC_TXN_CTX_ALIGN, FD_EXEC_TXN_CTX_FOOTPRINT ) ), runtime_spad, fd_wksp_containing( runtime_spad ) );
+  fd_exec_txn_ctx_t * txn_ctx            = fd_exec_txn_ctx_join( fd_exec_txn_ctx_new( FD_SPAD_ALLOC_TRACKED( runtime_spad, FD_EXEC_TXN_CTX_ALIGN, FD_EXEC_TXN_CTX_FOOTPRINT ) ), runtime_spad, fd_wksp_containing( runtime_spad ) );
   fd_funk_t *         funk               = slot_ctx->funk;
   fd_wksp_t *         funk_wksp          = fd_funk_wksp( funk );
   fd_wksp_t *         runtime_wksp       = fd_wksp_containing( slot_ctx );
@@ -1,5 +1,6 @@
 #include "fd_precompiles.h"
 #include "../fd_executor_err.h"
+#include "../fd_system_ids.h"
 #include "../../../ballet/keccak256/fd_keccak256.h"
 #include "../../../ballet/ed25519/fd_ed25519.h"
 #include "../../../ballet/secp256k1/fd_secp256k1.h"
@@ -64,6 +65,50 @@ FD_STATIC_ASSERT( sizeof( fd_secp256k1_signature_offsets_t )==SECP256K1_SIGNATUR
   Common code
 */
 
+/* fd_precompile_instrs_t is what verifying a precompile instruction
+   reads: the data of the instruction itself and of the other
+   instructions of its transaction.  In the executor, these come from
+   the instr infos of the txn ctx.  In fd_precompile_verify_txns, there
+   is no txn ctx yet and they come from the parsed transaction. */
+
+struct fd_precompile_instrs {
+  uchar const *           data;        /* Current instruction data */
+  ulong                   data_sz;
+  ulong                   instr_cnt;
+  fd_instr_info_t const * instr_infos; /* Indexed [0,instr_cnt), NULL if from txn */
+  fd_txn_t const *        txn;
+  uchar const *           payload;
+};
+
+typedef struct fd_precompile_instrs fd_precompile_instrs_t;
+
+static inline fd_precompile_instrs_t *
+fd_precompile_instrs_from_ctx( fd_precompile_instrs_t *    instrs,
+                               fd_exec_instr_ctx_t const * ctx ) {
+  instrs->data        = ctx->instr->data;
+  instrs->data_sz     = ctx->instr->data_sz;
+  instrs->instr_cnt   = ctx->txn_ctx->instr_info_cnt;
+  instrs->instr_infos = ctx->txn_ctx->instr_infos;
+  instrs->txn         = NULL;
+  instrs->payload     = NULL;
+  return instrs;
+}
+
+/* fd_precompile_verified returns 1 if the instruction of ctx was
+   already verified successfully by fd_precompile_verify_txns (see
+   fd_exec_txn_ctx_t precompile_ok) and 0 otherwise (the instruction
+   must be verified now).  Instructions that are not top level (CPI)
+   never are. */
+
+static inline int
+fd_precompile_verified( fd_exec_instr_ctx_t const * ctx ) {
+  fd_exec_txn_ctx_t const * txn_ctx = ctx->txn_ctx;
+  if( FD_LIKELY( !txn_ctx->precompile_ok ) ) return 0;
+  ulong off = (ulong)ctx->instr - (ulong)txn_ctx->instr_infos; /* wraps if ctx->instr is before */
+  if( FD_UNLIKELY( (off>=FD_TXN_INSTR_MAX*sizeof(fd_instr_info_t)) | (off%sizeof(fd_instr_info_t)!=0UL) ) ) return 0;
+  return fd_ulong_extract_bit( txn_ctx->precompile_ok, (int)(off/sizeof(fd_instr_info_t)) );
+}
+
 /* fd_precompile_get_instr_data fetches data across instructions.
    In Agave, the 2 precompiles have slightly different behavior:
    1. Ed25519 has 16-bit instr index vs Secp256k1 has 8-bit
@@ -75,11 +120,11 @@ FD_STATIC_ASSERT( sizeof( fd_secp256k1_signature_offsets_t )==SECP256K1_SIGNATUR
    We handle the special case of index==0xFFFF as in Ed25519.
    We handle errors as in Secp256k1. */
 static inline int
-fd_precompile_get_instr_data( fd_exec_instr_ctx_t * ctx,
-                              ushort                index,
-                              ushort                offset,
-                              ushort                sz,
-                              uchar const **        res ) {
+fd_precompile_get_instr_data( fd_precompile_instrs_t const * instrs,
+                              ushort                         index,
+                              ushort                         offset,
+                              ushort                         sz,
+                              uchar const **                 res ) {
   uchar const * data;
   ulong         data_sz;
   /* The special value index==USHORT_MAX means current instruction.
@@ -91,17 +136,23 @@ fd_precompile_get_instr_data( fd_exec_instr_ctx_t * ctx,
   if( index==USHORT_MAX ) {
 
     /* Use current instruction data */
-    data    = ctx->instr->data;
-    data_sz = ctx->instr->data_sz;
+    data    = instrs->data;
+    data_sz = instrs->data_sz;
 
   } else {
 
-    if( FD_UNLIKELY( index>=ctx->txn_ctx->instr_info_cnt ) )
+    if( FD_UNLIKELY( index>=instrs->instr_cnt ) )
       return FD_EXECUTOR_PRECOMPILE_ERR_DATA_OFFSET;
 
-    fd_instr_info_t const * instr = &ctx->txn_ctx->instr_infos[ index ];
-    data    = instr->data;
-    data_sz = instr->data_sz;
+    if( FD_LIKELY( instrs->instr_infos ) ) {
+      fd_instr_info_t const * instr = &instrs->instr_infos[ index ];
+      data    = instr->data;
+      data_sz = instr->data_sz;
+    } else {
+      fd_txn_instr_t const * instr = &instrs->txn->instr[ index ];
+      data    = fd_txn_get_instr_data( instr, instrs->payload );
+      data_sz = instr->data_sz;
+    }
 
   }
 
@@ -112,15 +163,73 @@ fd_precompile_get_instr_data( fd_exec_instr_ctx_t * ctx,
   return 0;
 }
 
+/* fd_precompile_ed25519_batch_t accumulates the ed25519 precompile
+   signatures found by fd_precompile_verify_txns, to verify them with
+   fd_ed25519_verify_batch.  Each signature remembers the instruction
+   it belongs to (owner, an index into ok bits), so that a failure
+   clears the instruction's ok bit. */
+
+#define FD_PRECOMPILE_ED25519_BATCH_MAX (64UL)
+
+struct fd_precompile_ed25519_batch {
+  ulong *       ok;
+  ulong         owner;  /* Bit of ok of the instruction being parsed */
+  ulong         cnt;
+  uchar const * msg   [ FD_PRECOMPILE_ED25519_BATCH_MAX ];
+  ulong         msg_sz[ FD_PRECOMPILE_ED25519_BATCH_MAX ];
+  uchar const * sig   [ FD_PRECOMPILE_ED25519_BATCH_MAX ];
+  uchar const * pubkey[ FD_PRECOMPILE_ED25519_BATCH_MAX ];
+  ulong         owners[ FD_PRECOMPILE_ED25519_BATCH_MAX ];
+  int           err   [ FD_PRECOMPILE_ED25519_BATCH_MAX ];
+};
+
+typedef struct fd_precompile_ed25519_batch fd_precompile_ed25519_batch_t;
+
+static void
+fd_precompile_ed25519_batch_flush( fd_precompile_ed25519_batch_t * batch ) {
+  fd_sha512_t sha[1];
+  fd_ed25519_verify_batch( batch->cnt, batch->msg, batch->msg_sz, batch->sig, batch->pubkey,
+                           sha, NULL, batch->err );
+  for( ulong i=0UL; i<batch->cnt; i++ ) {
+    ulong owner = batch->owners[ i ];
+    if( FD_UNLIKELY( batch->err[ i ]!=FD_ED25519_SUCCESS ) ) batch->ok[ owner/FD_TXN_INSTR_MAX ] &= ~(1UL<<(owner%FD_TXN_INSTR_MAX));
+  }
+  batch->cnt = 0UL;
+}
+
+static inline void
+fd_precompile_ed25519_batch_add( fd_precompile_ed25519_batch_t * batch,
+                                 uchar const *                   msg,
+                                 ulong                           msg_sz,
+                                 uchar const *                   sig,
+                                 uchar const *                   pubkey ) {
+  ulong i = batch->cnt;
+  batch->msg   [ i ] = msg;
+  batch->msg_sz[ i ] = msg_sz;
+  batch->sig   [ i ] = sig;
+  batch->pubkey[ i ] = pubkey;
+  batch->owners[ i ] = batch->owner;
+  batch->cnt = i+1UL;
+  if( FD_UNLIKELY( batch->cnt==FD_PRECOMPILE_ED25519_BATCH_MAX ) ) fd_precompile_ed25519_batch_flush( batch );
+}
+
 /*
   Ed25519
 */
 
-int
-fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
+/* fd_precompile_ed25519_instr verifies an ed25519 precompile
+   instruction.  Returns FD_EXECUTOR_INSTR_SUCCESS or an instruction
+   error (with the custom error in *custom_err).  If batch is non-NULL,
+   the signatures are added to batch instead of verified now (the
+   return value then only covers parsing). */
 
-  uchar const * data    = ctx->instr->data;
-  ulong         data_sz = ctx->instr->data_sz;
+static int
+fd_precompile_ed25519_instr( fd_precompile_instrs_t const *  instrs,
+                             fd_precompile_ed25519_batch_t * batch,
+                             uint *                          custom_err ) {
+
+  uchar const * data    = instrs->data;
+  ulong         data_sz = instrs->data_sz;
 
   /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/ed25519_instruction.rs#L90-L96
      note: this part is really silly and in fact in leaves out the edge case [0, 0].
@@ -135,20 +244,20 @@ fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
     if( FD_UNLIKELY( data_sz == 2 && data[0] == 0 ) ) {
       return FD_EXECUTOR_INSTR_SUCCESS;
     }
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
   ulong sig_cnt = data[0];
   if( FD_UNLIKELY( sig_cnt==0 ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
   /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/ed25519_instruction.rs#L97-L103 */
   ulong expected_data_size = sig_cnt * SIGNATURE_OFFSETS_SERIALIZED_SIZE + SIGNATURE_OFFSETS_START;
   if( FD_UNLIKELY( data_sz < expected_data_size ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
@@ -162,13 +271,13 @@ fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
 
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/ed25519_instruction.rs#L114-L121 */
     uchar const * sig = NULL;
-    int err = fd_precompile_get_instr_data( ctx,
+    int err = fd_precompile_get_instr_data( instrs,
                                             sigoffs->sig_instr_idx,
                                             sigoffs->sig_offset,
                                             SIGNATURE_SERIALIZED_SIZE,
                                             &sig );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
@@ -178,13 +287,13 @@ fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
 
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/ed25519_instruction.rs#L126-L133 */
     uchar const * pubkey = NULL;
-    err = fd_precompile_get_instr_data( ctx,
+    err = fd_precompile_get_instr_data( instrs,
                                         sigoffs->pubkey_instr_idx,
                                         sigoffs->pubkey_offset,
                                         ED25519_PUBKEY_SERIALIZED_SIZE,
                                         &pubkey );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
@@ -195,20 +304,24 @@ fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/ed25519_instruction.rs#L138-L145 */
     uchar const * msg = NULL;
     ushort msg_sz = sigoffs->msg_data_sz;
-    err = fd_precompile_get_instr_data( ctx,
+    err = fd_precompile_get_instr_data( instrs,
                                         sigoffs->msg_instr_idx,
                                         sigoffs->msg_offset,
                                         msg_sz,
                                         &msg );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/ed25519_instruction.rs#L147-L149 */
+    if( batch ) {
+      fd_precompile_ed25519_batch_add( batch, msg, msg_sz, sig, pubkey );
+      continue;
+    }
     fd_sha512_t sha[1];
     if( FD_UNLIKELY( fd_ed25519_verify( msg, msg_sz, sig, pubkey, sha )!=FD_ED25519_SUCCESS ) ) {
-      ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
+      *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
   }
@@ -220,11 +333,16 @@ fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
   Secp256K1
 */
 
-int
-fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
+/* fd_precompile_secp256k1_instr verifies a secp256k1 precompile
+   instruction.  Returns as fd_precompile_ed25519_instr.  There is no
+   batched public key recovery, signatures are always verified now. */
 
-  uchar const * data    = ctx->instr->data;
-  ulong         data_sz = ctx->instr->data_sz;
+static int
+fd_precompile_secp256k1_instr( fd_precompile_instrs_t const * instrs,
+                               uint *                         custom_err ) {
+
+  uchar const * data    = instrs->data;
+  ulong         data_sz = instrs->data_sz;
 
   /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/secp256k1_instruction.rs#L934-L947
      see comment in ed25519, here the special case is [0] instead of [0, 0] */
@@ -232,21 +350,21 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
     if( FD_UNLIKELY( data_sz == 1 && data[0] == 0 ) ) {
       return FD_EXECUTOR_INSTR_SUCCESS;
     }
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
   /* https://github.com/anza-xyz/agave/blob/574bae8fefc0ed256b55340b9d87b7689bcdf222/sdk/src/secp256k1_instruction.rs#L938-L947 */
   ulong sig_cnt = data[0];
   if( FD_UNLIKELY( sig_cnt==0 && data_sz>1 ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
   /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/secp256k1_instruction.rs#L948-L953 */
   ulong expected_data_size = sig_cnt * SECP256K1_SIGNATURE_OFFSETS_SERIALIZED_SIZE + SECP256K1_SIGNATURE_OFFSETS_START;
   if( FD_UNLIKELY( data_sz < expected_data_size ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
@@ -262,13 +380,13 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
        Note: for whatever reason, Agave returns InvalidInstructionDataSize instead of InvalidDataOffsets.
        We just return the err as is. */
     uchar const * sig = NULL;
-    int err = fd_precompile_get_instr_data( ctx,
+    int err = fd_precompile_get_instr_data( instrs,
                                             sigoffs->sig_instr_idx,
                                             sigoffs->sig_offset,
                                             SIGNATURE_SERIALIZED_SIZE + 1, /* extra byte is recovery id */
                                             &sig );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
@@ -279,26 +397,26 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
 
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/secp256k1_instruction.rs#L983-L989 */
     uchar const * eth_address = NULL;
-    err = fd_precompile_get_instr_data( ctx,
+    err = fd_precompile_get_instr_data( instrs,
                                         sigoffs->pubkey_instr_idx,
                                         sigoffs->pubkey_offset,
                                         SECP256K1_PUBKEY_SERIALIZED_SIZE,
                                         &eth_address );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/secp256k1_instruction.rs#L991-L997 */
     uchar const * msg = NULL;
     ushort msg_sz = sigoffs->msg_data_sz;
-    err = fd_precompile_get_instr_data( ctx,
+    err = fd_precompile_get_instr_data( instrs,
                                         sigoffs->msg_instr_idx,
                                         sigoffs->msg_offset,
                                         msg_sz,
                                         &msg );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
@@ -309,7 +427,7 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
     /* https://github.com/anza-xyz/agave/blob/v1.18.12/sdk/src/secp256k1_instruction.rs#L1003-L1008 */
     uchar pubkey[64];
     if ( FD_UNLIKELY( fd_secp256k1_recover( pubkey, msg_hash, sig, recovery_id ) == NULL ) ) {
-      ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
+      *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
@@ -318,7 +436,7 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
     fd_keccak256_hash( pubkey, 64, pubkey_hash );
 
     if( FD_UNLIKELY( memcmp( eth_address, pubkey_hash+(FD_KECCAK256_HASH_SZ-SECP256K1_PUBKEY_SERIALIZED_SIZE), SECP256K1_PUBKEY_SERIALIZED_SIZE ) ) ) {
-      ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
+      *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
   }
@@ -331,28 +449,32 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
 */
 
 #ifdef FD_HAS_S2NBIGNUM
-int
-fd_precompile_secp256r1_verify( fd_exec_instr_ctx_t * ctx ) {
+/* fd_precompile_secp256r1_instr verifies a secp256r1 precompile
+   instruction.  Returns as fd_precompile_secp256k1_instr. */
+
+static int
+fd_precompile_secp256r1_instr( fd_precompile_instrs_t const * instrs,
+                               uint *                         custom_err ) {
 
-  uchar const * data    = ctx->instr->data;
-  ulong         data_sz = ctx->instr->data_sz;
+  uchar const * data    = instrs->data;
+  ulong         data_sz = instrs->data_sz;
 
   /* ... */
   if( FD_UNLIKELY( data_sz < DATA_START ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
   ulong sig_cnt = data[0];
   if( FD_UNLIKELY( sig_cnt==0 ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
   /* ... */
   ulong expected_data_size = sig_cnt * SIGNATURE_OFFSETS_SERIALIZED_SIZE + SIGNATURE_OFFSETS_START;
   if( FD_UNLIKELY( data_sz < expected_data_size ) ) {
-    ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
+    *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_INSTR_DATA_SIZE;
     return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
   }
 
@@ -363,54 +485,173 @@ fd_precompile_secp256r1_verify( fd_exec_instr_ctx_t * ctx ) {
 
     /* ... */
     uchar const * sig = NULL;
-    int err = fd_precompile_get_instr_data( ctx,
+    int err = fd_precompile_get_instr_data( instrs,
                                             sigoffs->sig_instr_idx,
                                             sigoffs->sig_offset,
                                             SIGNATURE_SERIALIZED_SIZE,
                                             &sig );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
     /* ... */
     uchar const * pubkey = NULL;
-    err = fd_precompile_get_instr_data( ctx,
+    err = fd_precompile_get_instr_data( instrs,
                                         sigoffs->pubkey_instr_idx,
                                         sigoffs->pubkey_offset,
                                         SECP256R1_PUBKEY_SERIALIZED_SIZE,
                                         &pubkey );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
     /* ... */
     uchar const * msg = NULL;
     ushort msg_sz = sigoffs->msg_data_sz;
-    err = fd_precompile_get_instr_data( ctx,
+    err = fd_precompile_get_instr_data( instrs,
                                         sigoffs->msg_instr_idx,
                                         sigoffs->msg_offset,
                                         msg_sz,
                                         &msg );
     if( FD_UNLIKELY( err ) ) {
-      ctx->txn_ctx->custom_err = (uint)err;
+      *custom_err = (uint)err;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
 
     /* ... */
     fd_sha256_t sha[1];
     if( FD_UNLIKELY( fd_secp256r1_verify( msg, msg_sz, sig, pubkey, sha )!=FD_SECP256R1_SUCCESS ) ) {
-      ctx->txn_ctx->custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
+      *custom_err = FD_EXECUTOR_PRECOMPILE_ERR_SIGNATURE;
       return FD_EXECUTOR_INSTR_ERR_CUSTOM_ERR;
     }
   }
 
   return FD_EXECUTOR_INSTR_SUCCESS;
 }
+#endif
+
+/*
+  Entrypoints
+*/
+
+int
+fd_precompile_ed25519_verify( fd_exec_instr_ctx_t * ctx ) {
+  if( fd_precompile_verified( ctx ) ) return FD_EXECUTOR_INSTR_SUCCESS;
+  fd_precompile_instrs_t instrs[1];
+  return fd_precompile_ed25519_instr( fd_precompile_instrs_from_ctx( instrs, ctx ), NULL, &ctx->txn_ctx->custom_err );
+}
+
+int
+fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx ) {
+  if( fd_precompile_verified( ctx ) ) return FD_EXECUTOR_INSTR_SUCCESS;
+  fd_precompile_instrs_t instrs[1];
+  return fd_precompile_secp256k1_instr( fd_precompile_instrs_from_ctx( instrs, ctx ), &ctx->txn_ctx->custom_err );
+}
+
+#ifdef FD_HAS_S2NBIGNUM
+int
+fd_precompile_secp256r1_verify( fd_exec_instr_ctx_t * ctx ) {
+  if( fd_precompile_verified( ctx ) ) return FD_EXECUTOR_INSTR_SUCCESS;
+  fd_precompile_instrs_t instrs[1];
+  return fd_precompile_secp256r1_instr( fd_precompile_instrs_from_ctx( instrs, ctx ), &ctx->txn_ctx->custom_err );
+}
 #else
 int
 fd_precompile_secp256r1_verify( FD_PARAM_UNUSED fd_exec_instr_ctx_t * ctx ) {
   return FD_EXECUTOR_INSTR_ERR_FATAL;
 }
 #endif
+
+/*
+  Ahead of execution
+*/
+
+FD_STATIC_ASSERT( FD_TXN_INSTR_MAX<=64UL, precompile_ok );
+
+/* fd_precompile_verify_txn does fd_precompile_verify_txns for
+   transaction txn_idx of ok. */
+
+static void
+fd_precompile_verify_txn( fd_txn_p_t const *              txn_p,
+                          ulong                           txn_idx,
+                          fd_precompile_ed25519_batch_t * batch ) {
+  fd_txn_t const *       txn   = (fd_txn_t const *)txn_p->_;
+  fd_acct_addr_t const * addrs = fd_txn_get_acct_addrs( txn, txn_p->payload );
+  ulong *                ok    = batch->ok + txn_idx;
+
+  fd_precompile_instrs_t instrs[1] = {{
+    .instr_cnt   = txn->instr_cnt,
+    .instr_infos = NULL,
+    .txn         = txn,
+    .payload     = txn_p->payload
+  }};
+
+  *ok = 0UL;
+  for( ulong i=0UL; i<txn->instr_cnt; i++ ) {
+    fd_txn_instr_t const * instr = &txn->instr[ i ];
+
+    /* Precompiles can't be loaded from an address lookup table */
+    if( FD_UNLIKELY( instr->program_id>=txn->acct_addr_cnt ) ) continue;
+    uchar const * program_id = addrs[ instr->program_id ].b;
+
+    instrs->data    = fd_txn_get_instr_data( instr, txn_p->payload );
+    instrs->data_sz = instr->data_sz;
+
+    ulong bit = 1UL<<i;
+    uint  custom_err;
+    if( !memcmp( program_id, fd_solana_ed25519_sig_verify_program_id.key, sizeof(fd_pubkey_t) ) ) {
+      /* Set first, failed signatures clear it when flushed (possibly
+         while the instruction is still being parsed) */
+      *ok |= bit;
+      batch->owner = txn_idx*FD_TXN_INSTR_MAX + i;
+      if( FD_UNLIKELY( fd_precompile_ed25519_instr( instrs, batch, &custom_err ) ) ) *ok &= ~bit;
+    } else if( !memcmp( program_id, fd_solana_keccak_secp_256k_program_id.key, sizeof(fd_pubkey_t) ) ) {
+      if( FD_LIKELY( !fd_precompile_secp256k1_instr( instrs, &custom_err ) ) ) *ok |= bit;
+    }
+#ifdef FD_HAS_S2NBIGNUM
+    else if( !memcmp( program_id, fd_solana_secp256r1_program_id.key, sizeof(fd_pubkey_t) ) ) {
+      if( FD_LIKELY( !fd_precompile_secp256r1_instr( instrs, &custom_err ) ) ) *ok |= bit;
+    }
+#endif
+  }
+}
+
+void
+fd_precompile_verify_txns( fd_txn_p_t const * txns,
+                           ulong              txn_cnt,
+                           ulong              ok[] ) {
+  fd_precompile_ed25519_batch_t batch[1];
+  batch->ok  = ok;
+  batch->cnt = 0UL;
+  for( ulong txn_idx=0UL; txn_idx<txn_cnt; txn_idx++ ) fd_precompile_verify_txn( &txns[ txn_idx ], txn_idx, batch );
+  if( batch->cnt ) fd_precompile_ed25519_batch_flush( batch );
+}
+
+static void
+fd_precompile_verify_txns_task( void * tpool,
+                                ulong  t0     FD_PARAM_UNUSED,
+                                ulong  t1     FD_PARAM_UNUSED,
+                                void * args,
+                                void * reduce FD_PARAM_UNUSED,
+                                ulong  stride FD_PARAM_UNUSED,
+                                ulong  l0     FD_PARAM_UNUSED,
+                                ulong  l1     FD_PARAM_UNUSED,
+                                ulong  m0,
+                                ulong  m1,
+                                ulong  n0     FD_PARAM_UNUSED,
+                                ulong  n1     FD_PARAM_UNUSED ) {
+  fd_txn_p_t const * txns = (fd_txn_p_t const *)tpool;
+  ulong *            ok   = (ulong *)args;
+  fd_precompile_verify_txns( txns+m0, m1-m0, ok+m0 );
+}
+
+void
+fd_precompile_verify_txns_tpool( fd_txn_p_t const * txns,
+                                 ulong              txn_cnt,
+                                 ulong              ok[],
+                                 fd_tpool_t *       tpool ) {
+  fd_tpool_exec_all_batch( tpool, 0UL, fd_tpool_worker_cnt( tpool ), fd_precompile_verify_txns_task,
+                           (void *)txns, ok, NULL, 1UL, 0UL, txn_cnt );
+}
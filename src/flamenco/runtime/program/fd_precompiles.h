@@ -24,6 +24,35 @@ fd_precompile_secp256k1_verify( fd_exec_instr_ctx_t * ctx );
 int
 fd_precompile_secp256r1_verify( fd_exec_instr_ctx_t * ctx );
 
+/* fd_precompile_verify_txns verifies the precompile instructions of
+   txns[i] for i in [0,txn_cnt) ahead of execution, e.g. for a whole
+   block before any of it is executed, with batched signature
+   verification.  On return, bit j of ok[i] is set if instruction j of
+   txns[i] is a precompile instruction that will succeed and clear
+   otherwise (not a precompile, or verification failed).  Failed
+   instructions are not recorded in more detail: the executor just
+   verifies them again to get the exact error.  The result only depends
+   on the transaction, so it is safe to use regardless of features and
+   of what executes before it.
+
+   The executor uses the result through fd_exec_txn_ctx_t
+   precompile_ok: the precompile entrypoints above return success
+   without verifying anything for an instruction whose bit is set.
+
+   fd_precompile_verify_txns_tpool does the same spread over all the
+   worker threads of tpool (which must be idle). */
+
+void
+fd_precompile_verify_txns( fd_txn_p_t const * txns,
+                           ulong              txn_cnt,
+                           ulong              ok[] );
+
+void
+fd_precompile_verify_txns_tpool( fd_txn_p_t const * txns,
+                                 ulong              txn_cnt,
+                                 ulong              ok[],
+                                 fd_tpool_t *       tpool );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_flamenco_runtime_program_fd_precompiles_h */
@@ -0,0 +1,176 @@
+#include "fd_precompiles.h"
+#include "../fd_system_ids.h"
+
+static uchar *
+fd_rng_b256( fd_rng_t * rng,
+             uchar *    r ) {
+  for( ulong i=0UL; i<32UL; i++ ) r[ i ] = fd_rng_uchar( rng );
+  return r;
+}
+
+/* build_ed25519_instr appends to payload (at *off) the data of an
+   ed25519 precompile instruction with sig_cnt signatures (by random
+   keys, over random messages of up to 32 bytes), all referencing the
+   instruction itself.  If corrupt, one signature is corrupted.  If
+   bad_off, the last message doesn't fit the instruction.  Returns 1 if
+   the instruction should verify successfully. */
+
+static int
+build_ed25519_instr( fd_rng_t *       rng,
+                     fd_sha512_t *    sha,
+                     uchar *          payload,
+                     ulong *          off,
+                     fd_txn_instr_t * instr,
+                     ulong            sig_cnt,
+                     int              corrupt,
+                     int              bad_off ) {
+  uchar * data = payload + *off;
+  data[0] = (uchar)sig_cnt;
+  data[1] = 0;
+  ulong data_sz = 2UL + 14UL*sig_cnt;
+  int   ok      = !bad_off || !sig_cnt;
+  ulong bad_idx = corrupt ? fd_rng_ulong_roll( rng, fd_ulong_max( sig_cnt, 1UL ) ) : ULONG_MAX;
+  for( ulong i=0UL; i<sig_cnt; i++ ) {
+    uchar prv[ 32 ];
+    uchar * sig    = data + data_sz;
+    uchar * pubkey = sig + 64;
+    uchar * msg    = pubkey + 32;
+    ulong   msg_sz = fd_rng_ulong_roll( rng, 33UL );
+    for( ulong b=0UL; b<msg_sz; b++ ) msg[ b ] = fd_rng_uchar( rng );
+    fd_ed25519_public_from_private( pubkey, fd_rng_b256( rng, prv ), sha );
+    fd_ed25519_sign( sig, msg, msg_sz, pubkey, prv, sha );
+    if( i==bad_idx ) { sig[ fd_rng_ulong_roll( rng, 64UL ) ] ^= (uchar)(1U<<fd_rng_uint_roll( rng, 8U )); ok = 0; }
+
+    ushort offsets[ 7 ] = {
+      (ushort)data_sz,        USHORT_MAX,
+      (ushort)(data_sz+64UL), USHORT_MAX,
+      (ushort)(data_sz+96UL), (ushort)msg_sz, USHORT_MAX
+    };
+    if( bad_off && i==sig_cnt-1UL ) offsets[ 5 ] = (ushort)(msg_sz+1UL);
+    memcpy( data + 2UL + 14UL*i, offsets, 14UL );
+    data_sz += 96UL + msg_sz;
+  }
+  instr->data_off = (ushort)*off;
+  instr->data_sz  = (ushort)data_sz;
+  *off += data_sz;
+  return ok;
+}
+
+static void
+test_verify_txns( fd_rng_t *    rng,
+                  fd_sha512_t * sha,
+                  fd_tpool_t *  tpool ) {
+# define TXN_CNT (64UL)
+  static fd_txn_p_t txns[ TXN_CNT ];
+  ulong expected[ TXN_CNT ];
+  ulong ok      [ TXN_CNT ];
+
+  for( ulong iter=0UL; iter<16UL; iter++ ) {
+    for( ulong t=0UL; t<TXN_CNT; t++ ) {
+      fd_txn_p_t * txn_p = &txns[ t ];
+      fd_txn_t *   txn   = TXN( txn_p );
+      uchar *      payload = txn_p->payload;
+
+      /* Accounts: a payer, the ed25519 precompile and another program */
+      txn->acct_addr_off = 0;
+      txn->acct_addr_cnt = 3;
+      fd_rng_b256( rng, payload );
+      memcpy( payload+32, fd_solana_ed25519_sig_verify_program_id.key, 32UL );
+      memcpy( payload+64, fd_solana_system_program_id.key,             32UL );
+      ulong off = 96UL;
+
+      txn->instr_cnt = (uchar)(1UL + fd_rng_ulong_roll( rng, 2UL ));
+      expected[ t ] = 0UL;
+      for( ulong i=0UL; i<txn->instr_cnt; i++ ) {
+        fd_txn_instr_t * instr = &txn->instr[ i ];
+        if( !fd_rng_uint_roll( rng, 4U ) ) {
+          instr->program_id = 2;
+          instr->data_off   = (ushort)off;
+          instr->data_sz    = 0;
+          continue;
+        }
+        instr->program_id = 1;
+        int corrupt = !fd_rng_uint_roll( rng, 6U );
+        int bad_off = !fd_rng_uint_roll( rng, 12U );
+        if( build_ed25519_instr( rng, sha, payload, &off, instr, fd_rng_ulong_roll( rng, 4UL ), corrupt, bad_off ) ) {
+          expected[ t ] |= 1UL<<i;
+        }
+      }
+      FD_TEST( off<=FD_TXN_MTU );
+      txn_p->payload_sz = off;
+    }
+
+    for( ulong t=0UL; t<TXN_CNT; t++ ) ok[ t ] = ULONG_MAX;
+    if( iter & 1UL ) fd_precompile_verify_txns_tpool( txns, TXN_CNT, ok, tpool );
+    else             fd_precompile_verify_txns      ( txns, TXN_CNT, ok        );
+    for( ulong t=0UL; t<TXN_CNT; t++ ) {
+      if( FD_UNLIKELY( ok[ t ]!=expected[ t ] ) ) FD_LOG_ERR(( "txn %lu: ok %lx, expected %lx", t, ok[ t ], expected[ t ] ));
+    }
+  }
+
+  /* A message in another instruction of the transaction and the [0,0]
+     edge case (no signatures) */
+
+  fd_txn_p_t * txn_p   = &txns[ 0 ];
+  fd_txn_t *   txn     = TXN( txn_p );
+  uchar *      payload = txn_p->payload;
+  ulong        off     = 96UL;
+  txn->instr_cnt = 3;
+  FD_TEST( build_ed25519_instr( rng, sha, payload, &off, &txn->instr[ 0 ], 1UL, 0, 0 ) );
+
+  ushort msg_off = (ushort)(2UL+14UL+96UL);
+  ushort msg_sz  = fd_ushort_load_2( payload + txn->instr[ 0 ].data_off + 2UL + 10UL );
+  uchar * data = payload + off;
+  uchar   prv[ 32 ];
+  data[0] = 1; data[1] = 0;
+  fd_ed25519_public_from_private( data+16UL+64UL, fd_rng_b256( rng, prv ), sha );
+  fd_ed25519_sign( data+16UL, payload + txn->instr[ 0 ].data_off + msg_off, msg_sz, data+16UL+64UL, prv, sha );
+  ushort offsets[ 7 ] = { 16, USHORT_MAX, 16+64, USHORT_MAX, msg_off, msg_sz, 0 };
+  memcpy( data+2UL, offsets, 14UL );
+  txn->instr[ 1 ].program_id = 1;
+  txn->instr[ 1 ].data_off   = (ushort)off;
+  txn->instr[ 1 ].data_sz    = 16+96;
+  off += 16UL+96UL;
+
+  payload[ off ] = 0; payload[ off+1UL ] = 0;
+  txn->instr[ 2 ].program_id = 1;
+  txn->instr[ 2 ].data_off   = (ushort)off;
+  txn->instr[ 2 ].data_sz    = 2;
+  off += 2UL;
+  txn_p->payload_sz = off;
+
+  fd_precompile_verify_txns( txns, 1UL, ok );
+  FD_TEST( ok[ 0 ]==7UL );
+
+  /* Pointing at an instruction that doesn't exist fails */
+
+  offsets[ 6 ] = 3;
+  memcpy( data+2UL, offsets, 14UL );
+  fd_precompile_verify_txns( txns, 1UL, ok );
+  FD_TEST( ok[ 0 ]==5UL );
+# undef TXN_CNT
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+  fd_sha512_t _sha[1]; fd_sha512_t * sha = fd_sha512_join( fd_sha512_new( _sha ) );
+
+  static uchar tpool_mem[ FD_TPOOL_FOOTPRINT( FD_TILE_MAX ) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  fd_tpool_t * tpool = fd_tpool_init( tpool_mem, fd_tile_cnt() );
+  FD_TEST( tpool );
+  for( ulong idx=1UL; idx<fd_tile_cnt(); idx++ ) FD_TEST( fd_tpool_worker_push( tpool, idx, NULL, 0UL ) );
+
+  test_verify_txns( rng, sha, tpool );
+
+  fd_tpool_fini( tpool );
+  fd_sha512_delete( fd_sha512_leave( sha ) );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -257,7 +257,19 @@ invalid_error:
    Specifically it takes as input byte arrays and takes care of scalars
    validation and points decompression.  It then invokes ballet MSM
    function fd_ed25519_multi_scalar_mul.  To avoid dynamic allocation,
-   the full MSM is done in batches of FD_BALLET_CURVE25519_MSM_BATCH_SZ. */
+   the full MSM is done in batches of BATCH_MAX points, decompressed
+   into an array on the stack.  BATCH_MAX is large enough for large
+   MSMs (e.g. range proofs) to benefit from the Pippenger method of
+   fd_ed25519_multi_scalar_mul (at least
+   FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN points per batch), but a
+   quarter of the max number of points accepted by the syscall (512),
+   to bound stack usage: the array is 24 KiB with the AVX-512 point
+   layout (20 KiB otherwise).  fd_ed25519_multi_scalar_mul adds at most
+   12 KiB of Pippenger buckets (or, for a last batch of less than
+   FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN points, its Straus tables). */
+
+#define BATCH_MAX (128UL)
+FD_STATIC_ASSERT( BATCH_MAX>=FD_BALLET_CURVE25519_MSM_PIPPENGER_MIN, batch_max );
 
 static fd_ed25519_point_t *
 multi_scalar_mul_edwards( fd_ed25519_point_t * r,
@@ -273,11 +285,11 @@ multi_scalar_mul_edwards( fd_ed25519_point_t * r,
 
   /* Static allocation of a batch of decompressed points */
   fd_ed25519_point_t tmp[1];
-  fd_ed25519_point_t A[ FD_BALLET_CURVE25519_MSM_BATCH_SZ ];
+  fd_ed25519_point_t A[ BATCH_MAX ];
 
   fd_ed25519_point_set_zero( r );
-  for( ulong i=0UL; i<cnt; i+=FD_BALLET_CURVE25519_MSM_BATCH_SZ ) {
-    ulong batch_cnt = fd_ulong_min( cnt-i, FD_BALLET_CURVE25519_MSM_BATCH_SZ );
+  for( ulong i=0UL; i<cnt; i+=BATCH_MAX ) {
+    ulong batch_cnt = fd_ulong_min( cnt-i, BATCH_MAX );
 
     /* Decompress (and validate) points */
     for( ulong j=0UL; j<batch_cnt; j++ ) {
@@ -313,11 +325,11 @@ multi_scalar_mul_ristretto( fd_ristretto255_point_t * r,
 
   /* Static allocation of a batch of decompressed points */
   fd_ristretto255_point_t tmp[1];
-  fd_ristretto255_point_t A[ FD_BALLET_CURVE25519_MSM_BATCH_SZ ];
+  fd_ristretto255_point_t A[ BATCH_MAX ];
 
   fd_ristretto255_point_set_zero( r );
-  for( ulong i=0UL; i<cnt; i+=FD_BALLET_CURVE25519_MSM_BATCH_SZ ) {
-    ulong batch_cnt = fd_ulong_min( cnt-i, FD_BALLET_CURVE25519_MSM_BATCH_SZ );
+  for( ulong i=0UL; i<cnt; i+=BATCH_MAX ) {
+    ulong batch_cnt = fd_ulong_min( cnt-i, BATCH_MAX );
 
     /* Decompress (and validate) points */
     for( ulong j=0UL; j<batch_cnt; j++ ) {
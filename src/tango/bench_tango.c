@@ -0,0 +1,470 @@
+#include "fd_tango.h"
+
+#if FD_HAS_HOSTED && FD_HAS_ATOMIC
+
+/* bench_tango measures a tango link (one mcache + dcache, one producer
+   and a configurable mix of reliable and unreliable consumers) under a
+   sweep of frag sizes, producer burst sizes, consumer counts and core
+   placements.  For each combination it reports producer throughput,
+   consumer side publish-to-read latency (p50 / p99) and the overrun
+   rate of unreliable consumers as one row of a table.
+
+   Core placements are given in terms of tile indices (so the cpus are
+   whatever --tile-cpus assigned to those tiles) as a comma separated
+   list of tx/rx0/rx1/... tuples.  E.g. on a machine where cpus 0 and
+   32 are HT siblings, 0-7 share an L3 and 64 is on another NUMA node:
+
+     bench_tango --tile-cpus 0,1,32,2,8,64 --placements 1/2,1/3,1/4,1/5
+
+   measures a producer on cpu 1 against consumers on its HT sibling, on
+   the same CCX, on another CCX and on another NUMA node (the placement
+   class of each row is derived from sysfs and printed with it).  Trials
+   that need more consumers than a placement provides are skipped. */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#define SORT_NAME        sort_lat
+#define SORT_KEY_T       long
+#define SORT_BEFORE(a,b) (a)<(b)
+#include "../util/tmpl/fd_sort.c"
+
+#define RX_MAX        (16UL)    /* Max consumers per trial (reliable+unreliable) */
+#define LIST_MAX      (16UL)    /* Max entries in a sweep list */
+#define PLACEMENT_MAX (16UL)    /* Max placements */
+#define LAT_MAX       (16384UL) /* Latency samples kept per consumer (most recent), power of 2 */
+#define WKSP_TAG      (1234UL)
+
+/* A trial's shared state.  Set up by tile 0 before the tx and rx tiles
+   are launched and read back after they are done. */
+
+static struct {
+  fd_frag_meta_t * mcache;
+  ulong            depth;
+  uchar *          dcache;
+  void *           base;
+  ulong            sz;
+  ulong            burst;
+  ulong            rel_cnt;
+  ulong            rx_cnt;
+  ulong *          fseq[ RX_MAX ];
+  long             duration; /* in ticks */
+  ulong            seq0;
+
+  /* Written by the tx tile */
+  ulong            tx_done;  /* 0 while running, 1 once tx_seq is final */
+  ulong            tx_seq;   /* One past the last published seq */
+  ulong            tx_backp; /* Number of times the tx waited for credits */
+  long             tx_ticks;
+} trial;
+
+static uchar fctl_mem[ FD_FCTL_FOOTPRINT( RX_MAX ) ] __attribute__((aligned(FD_FCTL_ALIGN)));
+
+typedef struct {
+  ulong rx_cnt;   /* Frags consumed */
+  ulong ovrn_cnt; /* Frags lost to overruns (polling + reading) */
+  ulong lat_cnt;
+  long  lat[ LAT_MAX ]; /* Publish to read latency in ticks, lat[ i & (LAT_MAX-1) ] for i in [0,lat_cnt) */
+} rx_result_t;
+
+static rx_result_t rx_result[ RX_MAX ];
+
+static int
+tx_main( int     argc,
+         char ** argv ) {
+  (void)argc; (void)argv;
+
+  fd_frag_meta_t * mcache = trial.mcache;
+  ulong            depth  = trial.depth;
+  ulong *          sync   = fd_mcache_seq_laddr( mcache );
+  ulong            sz     = trial.sz;
+  ulong            burst  = trial.burst;
+
+  ulong chunk0 = fd_dcache_compact_chunk0( trial.base, trial.dcache );
+  ulong wmark  = fd_dcache_compact_wmark ( trial.base, trial.dcache, sz );
+  ulong chunk  = chunk0;
+
+  ulong slow[ RX_MAX ];
+  fd_fctl_t * fctl = fd_fctl_join( fd_fctl_new( fctl_mem, trial.rel_cnt ) ); FD_TEST( fctl );
+  for( ulong rx_idx=0UL; rx_idx<trial.rel_cnt; rx_idx++ )
+    FD_TEST( fd_fctl_cfg_rx_add( fctl, depth, trial.fseq[ rx_idx ], slow+rx_idx ) );
+  FD_TEST( fd_fctl_cfg_done( fctl, burst, 0UL, 0UL, 0UL ) );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, (uint)fd_tile_id(), 0UL ) );
+  ulong async_min = 1UL<<7;
+  ulong async_rem = 0UL;
+
+  ulong seq      = trial.seq0;
+  ulong cr_avail = 0UL;
+  ulong backp    = 0UL;
+  long  t0       = fd_tickcount();
+  long  stop     = t0 + trial.duration;
+  for(;;) {
+
+    if( FD_UNLIKELY( !async_rem ) ) {
+      fd_mcache_seq_update( sync, seq );
+      cr_avail  = trial.rel_cnt ? fd_fctl_tx_cr_update( fctl, cr_avail, seq ) : ULONG_MAX;
+      if( FD_UNLIKELY( (fd_tickcount()-stop)>=0L ) ) break;
+      async_rem = fd_tempo_async_reload( rng, async_min );
+    }
+    async_rem--;
+
+    if( FD_UNLIKELY( cr_avail<burst ) ) {
+      backp++;
+      FD_SPIN_PAUSE();
+      continue;
+    }
+
+    for( ulong b=0UL; b<burst; b++ ) {
+      ulong * p   = (ulong *)fd_chunk_to_laddr( trial.base, chunk );
+      for( ulong off=8UL; off<sz; off+=64UL ) p[ off/8UL ] = seq; /* Touch every line of the payload */
+      long  now   = fd_tickcount();
+      p[0] = (ulong)now;
+      ulong ctl   = fd_frag_meta_ctl( 0UL, b==0UL, b==burst-1UL, 0 );
+      fd_mcache_publish( mcache, depth, seq, seq, chunk, sz, ctl, 0UL, fd_frag_meta_ts_comp( now ) );
+      chunk = fd_dcache_compact_next( chunk, sz, chunk0, wmark );
+      seq   = fd_seq_inc( seq, 1UL );
+    }
+    cr_avail -= fd_ulong_if( trial.rel_cnt>0UL, burst, 0UL );
+  }
+
+  long t1 = fd_tickcount();
+  fd_mcache_seq_update( sync, seq );
+
+  trial.tx_seq   = seq;
+  trial.tx_backp = backp;
+  trial.tx_ticks = t1 - t0;
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( trial.tx_done ) = 1UL;
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_fctl_delete( fd_fctl_leave( fctl ) );
+  return 0;
+}
+
+static int
+rx_main( int     argc,
+         char ** argv ) {
+  (void)argv;
+  ulong         rx_idx = (ulong)argc;
+  rx_result_t * res    = rx_result + rx_idx;
+  ulong *       fseq   = rx_idx<trial.rel_cnt ? trial.fseq[ rx_idx ] : NULL;
+
+  fd_frag_meta_t const * mcache = trial.mcache;
+  ulong                  depth  = trial.depth;
+
+  ulong rx_cnt   = 0UL;
+  ulong ovrn_cnt = 0UL;
+  ulong lat_cnt  = 0UL;
+  ulong seq      = trial.seq0;
+  for(;;) {
+    fd_frag_meta_t const * mline = mcache + fd_mcache_line_idx( seq, depth );
+
+    ulong seq_found = fd_frag_meta_seq_query( mline );
+    long  diff      = fd_seq_diff( seq_found, seq );
+    if( FD_UNLIKELY( diff<0L ) ) { /* Caught up */
+      if( fseq ) fd_fseq_update( fseq, seq );
+      if( FD_UNLIKELY( FD_VOLATILE_CONST( trial.tx_done ) ) ) {
+        FD_COMPILER_MFENCE();
+        if( fd_seq_ge( seq, trial.tx_seq ) ) break;
+        continue;
+      }
+      FD_SPIN_PAUSE();
+      continue;
+    }
+    if( FD_UNLIKELY( diff>0L ) ) { /* Overrun while polling */
+      ovrn_cnt += (ulong)diff;
+      seq       = seq_found;
+      continue;
+    }
+
+    FD_COMPILER_MFENCE();
+    ulong chunk = (ulong)mline->chunk;
+    ulong sz    = (ulong)mline->sz;
+    FD_COMPILER_MFENCE();
+    ulong const * p  = (ulong const *)fd_chunk_to_laddr_const( trial.base, chunk );
+    long          ts = (long)p[0];
+    ulong         x  = 0UL;
+    for( ulong off=64UL; off<sz; off+=64UL ) x ^= p[ off/8UL ];
+    FD_COMPILER_FORGET( x );
+    long now = fd_tickcount();
+    FD_COMPILER_MFENCE();
+    ulong seq_test = mline->seq;
+    FD_COMPILER_MFENCE();
+    if( FD_UNLIKELY( fd_seq_ne( seq_test, seq_found ) ) ) { /* Overrun while reading */
+      ovrn_cnt += fd_ulong_max( (ulong)fd_seq_diff( seq_test, seq ), 1UL );
+      seq       = seq_test;
+      continue;
+    }
+
+    res->lat[ lat_cnt & (LAT_MAX-1UL) ] = now - ts;
+    lat_cnt++;
+    rx_cnt++;
+    seq = fd_seq_inc( seq, 1UL );
+    if( fseq && FD_UNLIKELY( !(seq & 63UL) ) ) fd_fseq_update( fseq, seq );
+  }
+
+  res->rx_cnt   = rx_cnt;
+  res->ovrn_cnt = ovrn_cnt;
+  res->lat_cnt  = lat_cnt;
+  return 0;
+}
+
+/* placement_class returns how close cpu b is to cpu a (one of the
+   PLACEMENT_*, farther is larger), based on the cpu topology reported
+   by sysfs. */
+
+#define PLACEMENT_SAME_CPU   (0)
+#define PLACEMENT_HT_SIBLING (1)
+#define PLACEMENT_SAME_CCX   (2)
+#define PLACEMENT_CROSS_CCX  (3)
+#define PLACEMENT_CROSS_NUMA (4)
+#define PLACEMENT_FLOATING   (5)
+
+static char const * placement_class_cstr[] = { "same-cpu", "ht-sibling", "same-ccx", "cross-ccx", "cross-numa", "floating" };
+
+static int
+cpu_attr( ulong        cpu,
+          char const * attr,
+          char *       buf,
+          ulong        buf_sz ) {
+  char path[ 128 ];
+  if( FD_UNLIKELY( !fd_cstr_printf_check( path, sizeof(path), NULL, "/sys/devices/system/cpu/cpu%lu/%s", cpu, attr ) ) ) return 0;
+  FILE * file = fopen( path, "r" );
+  if( FD_UNLIKELY( !file ) ) return 0;
+  int ok = !!fgets( buf, (int)buf_sz, file );
+  fclose( file );
+  return ok;
+}
+
+static int
+cpu_attr_eq( ulong        a,
+             ulong        b,
+             char const * attr ) {
+  char buf_a[ 256 ]; char buf_b[ 256 ];
+  return cpu_attr( a, attr, buf_a, sizeof(buf_a) ) && cpu_attr( b, attr, buf_b, sizeof(buf_b) ) && !strcmp( buf_a, buf_b );
+}
+
+static int
+placement_class( ulong a,
+                 ulong b ) {
+  if( a>=fd_shmem_cpu_cnt() || b>=fd_shmem_cpu_cnt()       ) return PLACEMENT_FLOATING;
+  if( a==b                                                 ) return PLACEMENT_SAME_CPU;
+  if( fd_shmem_numa_idx( a )!=fd_shmem_numa_idx( b )       ) return PLACEMENT_CROSS_NUMA;
+  if( cpu_attr_eq( a, b, "topology/thread_siblings_list" ) ) return PLACEMENT_HT_SIBLING;
+  if( cpu_attr_eq( a, b, "cache/index3/shared_cpu_list"  ) ) return PLACEMENT_SAME_CCX;
+  return PLACEMENT_CROSS_CCX;
+}
+
+static ulong
+parse_list( char const * cstr,
+            char const * opt,
+            ulong *      out ) {
+  char buf[ 256 ];
+  if( FD_UNLIKELY( strlen( cstr )>=sizeof(buf) ) ) FD_LOG_ERR(( "%s too long", opt ));
+  strcpy( buf, cstr );
+  char * tok[ LIST_MAX ];
+  ulong cnt = fd_cstr_tokenize( tok, LIST_MAX, buf, ',' );
+  if( FD_UNLIKELY( !cnt || cnt>LIST_MAX ) ) FD_LOG_ERR(( "bad %s", opt ));
+  for( ulong i=0UL; i<cnt; i++ ) out[i] = fd_cstr_to_ulong( tok[i] );
+  return cnt;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _sz         = fd_env_strip_cmdline_cstr ( &argc, &argv, "--sz",         NULL, "64,512,1232,4096" );
+  char const * _burst      = fd_env_strip_cmdline_cstr ( &argc, &argv, "--burst",      NULL, "1,16"             );
+  char const * _rel_cnt    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--rel-cnt",    NULL, "1,2"              );
+  char const * _unrel_cnt  = fd_env_strip_cmdline_cstr ( &argc, &argv, "--unrel-cnt",  NULL, "0,1"              );
+  char const * _placements = fd_env_strip_cmdline_cstr ( &argc, &argv, "--placements", NULL, NULL               );
+  ulong        depth       = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",      NULL, 4096UL             );
+  float        duration_s  = fd_env_strip_cmdline_float( &argc, &argv, "--duration",   NULL, 0.1f               );
+  char const * _page_sz    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",    NULL, "gigantic"         );
+  ulong        page_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",   NULL, 1UL                );
+  ulong        near_cpu    = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",   NULL, fd_log_cpu_id()    );
+
+  ulong tile_cnt = fd_tile_cnt();
+  if( FD_UNLIKELY( tile_cnt<3UL ) ) {
+    FD_LOG_WARNING(( "skip: bench requires at least 3 tiles (e.g. --tile-cpus 0,1,2)" ));
+    fd_halt();
+    return 0;
+  }
+
+  ulong sz_list   [ LIST_MAX ]; ulong sz_cnt        = parse_list( _sz,        "--sz",        sz_list        );
+  ulong burst_list[ LIST_MAX ]; ulong burst_cnt     = parse_list( _burst,     "--burst",     burst_list     );
+  ulong rel_list  [ LIST_MAX ]; ulong rel_list_cnt  = parse_list( _rel_cnt,   "--rel-cnt",   rel_list       );
+  ulong unrel_list[ LIST_MAX ]; ulong unrel_list_cnt= parse_list( _unrel_cnt, "--unrel-cnt", unrel_list     );
+
+  /* Placements, default is a single one using all the tiles */
+
+  ulong placement_cnt = 0UL;
+  ulong placement_tile_cnt[ PLACEMENT_MAX ];
+  ulong placement_tile    [ PLACEMENT_MAX ][ 1UL+RX_MAX ];
+  if( !_placements ) {
+    placement_tile_cnt[0] = fd_ulong_min( tile_cnt-1UL, 1UL+RX_MAX );
+    for( ulong i=0UL; i<placement_tile_cnt[0]; i++ ) placement_tile[0][i] = 1UL+i;
+    placement_cnt = 1UL;
+  } else {
+    char buf[ 256 ];
+    if( FD_UNLIKELY( strlen( _placements )>=sizeof(buf) ) ) FD_LOG_ERR(( "--placements too long" ));
+    strcpy( buf, _placements );
+    char * tok[ PLACEMENT_MAX ];
+    placement_cnt = fd_cstr_tokenize( tok, PLACEMENT_MAX, buf, ',' );
+    if( FD_UNLIKELY( !placement_cnt || placement_cnt>PLACEMENT_MAX ) ) FD_LOG_ERR(( "bad --placements" ));
+    for( ulong p=0UL; p<placement_cnt; p++ ) {
+      char * sub[ 1UL+RX_MAX ];
+      ulong cnt = fd_cstr_tokenize( sub, 1UL+RX_MAX, tok[p], '/' );
+      if( FD_UNLIKELY( cnt<2UL || cnt>1UL+RX_MAX ) ) FD_LOG_ERR(( "bad --placements entry %lu", p ));
+      for( ulong i=0UL; i<cnt; i++ ) {
+        ulong tile_idx = fd_cstr_to_ulong( sub[i] );
+        if( FD_UNLIKELY( !tile_idx || tile_idx>=tile_cnt ) ) FD_LOG_ERR(( "--placements tile %lu not in [1,%lu)", tile_idx, tile_cnt ));
+        for( ulong j=0UL; j<i; j++ )
+          if( FD_UNLIKELY( placement_tile[p][j]==tile_idx ) ) FD_LOG_ERR(( "--placements entry %lu uses tile %lu twice", p, tile_idx ));
+        placement_tile[p][i] = tile_idx;
+      }
+      placement_tile_cnt[p] = cnt;
+    }
+  }
+
+  ulong mtu = 0UL;
+  for( ulong i=0UL; i<sz_cnt; i++ ) {
+    if( FD_UNLIKELY( sz_list[i]<8UL || sz_list[i]>(ulong)USHORT_MAX ) ) FD_LOG_ERR(( "--sz %lu not in [8,%lu]", sz_list[i], (ulong)USHORT_MAX ));
+    mtu = fd_ulong_max( mtu, sz_list[i] );
+  }
+  ulong burst_max = 0UL;
+  for( ulong i=0UL; i<burst_cnt; i++ ) {
+    if( FD_UNLIKELY( !burst_list[i] || burst_list[i]>depth ) ) FD_LOG_ERR(( "--burst %lu not in [1,%lu]", burst_list[i], depth ));
+    burst_max = fd_ulong_max( burst_max, burst_list[i] );
+  }
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-sz %s --page-cnt %lu --near-cpu %lu)", _page_sz, page_cnt, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong data_sz = fd_dcache_req_data_sz( mtu, depth, burst_max, 1 );
+  FD_TEST( data_sz );
+  void * mcache_mem = fd_wksp_alloc_laddr( wksp, fd_mcache_align(), fd_mcache_footprint( depth, 0UL ), WKSP_TAG );
+  void * dcache_mem = fd_wksp_alloc_laddr( wksp, fd_dcache_align(), fd_dcache_footprint( data_sz, 0UL ), WKSP_TAG );
+  void * fseq_mem   = fd_wksp_alloc_laddr( wksp, fd_fseq_align(), RX_MAX*fd_ulong_align_up( fd_fseq_footprint(), fd_fseq_align() ), WKSP_TAG );
+  if( FD_UNLIKELY( !mcache_mem || !dcache_mem || !fseq_mem ) ) FD_LOG_ERR(( "workspace too small for --depth %lu and --sz, increase --page-cnt", depth ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  double tick_per_ns = fd_tempo_tick_per_ns( NULL );
+  trial.depth    = depth;
+  trial.duration = (long)((double)duration_s*1e9*tick_per_ns);
+  trial.base     = wksp;
+
+  FD_LOG_NOTICE(( "depth %lu, %.3f s per trial, tx tile first in each placement", depth, (double)duration_s ));
+  FD_LOG_NOTICE(( "%-24s %-10s %6s %5s %3s %5s | %9s %9s %9s %9s %7s %7s",
+                  "placement", "class", "sz", "burst", "rel", "unrel",
+                  "Mfrag/s", "Gbps", "p50 ns", "p99 ns", "ovrn%", "backp" ));
+
+  for( ulong p=0UL; p<placement_cnt; p++ ) {
+    char label[ 128 ];
+    char * cur = fd_cstr_init( label );
+    for( ulong i=0UL; i<placement_tile_cnt[p]; i++ ) {
+      ulong cpu = fd_tile_cpu_id( placement_tile[p][i] );
+      if( i ) cur = fd_cstr_append_char( cur, '/' );
+      if( cpu<fd_shmem_cpu_cnt() ) cur = fd_cstr_append_ulong_as_text( cur, ' ', '\0', cpu, fd_ulong_base10_dig_cnt( cpu ) );
+      else                         cur = fd_cstr_append_char( cur, 'f' );
+      if( (ulong)(cur-label)>sizeof(label)-24UL ) { cur = fd_cstr_append_cstr( cur, "/..." ); break; }
+    }
+    fd_cstr_fini( cur );
+
+    ulong tx_cpu = fd_tile_cpu_id( placement_tile[p][0] );
+
+    for( ulong si=0UL; si<sz_cnt;         si++ ) {
+    for( ulong bi=0UL; bi<burst_cnt;      bi++ ) {
+    for( ulong ri=0UL; ri<rel_list_cnt;   ri++ ) {
+    for( ulong ui=0UL; ui<unrel_list_cnt; ui++ ) {
+      ulong rel_cnt = rel_list[ri];
+      ulong rx_cnt  = rel_cnt + unrel_list[ui];
+      if( FD_UNLIKELY( !rx_cnt || rx_cnt>RX_MAX || rx_cnt>placement_tile_cnt[p]-1UL ) ) continue;
+
+      /* The trial's class is that of its farthest consumer */
+      int cls = PLACEMENT_SAME_CPU;
+      for( ulong r=0UL; r<rx_cnt; r++ ) cls = fd_int_max( cls, placement_class( tx_cpu, fd_tile_cpu_id( placement_tile[p][1UL+r] ) ) );
+
+      /* Set up the link */
+
+      trial.seq0    = fd_rng_ulong( rng );
+      trial.mcache  = fd_mcache_join( fd_mcache_new( mcache_mem, depth, 0UL, trial.seq0 ) ); FD_TEST( trial.mcache );
+      trial.dcache  = fd_dcache_join( fd_dcache_new( dcache_mem, data_sz, 0UL ) );          FD_TEST( trial.dcache );
+      trial.sz      = sz_list[si];
+      trial.burst   = burst_list[bi];
+      trial.rel_cnt = rel_cnt;
+      trial.rx_cnt  = rx_cnt;
+      trial.tx_done = 0UL;
+      for( ulong r=0UL; r<rel_cnt; r++ ) {
+        void * mem = (uchar *)fseq_mem + r*fd_ulong_align_up( fd_fseq_footprint(), fd_fseq_align() );
+        trial.fseq[r] = fd_fseq_join( fd_fseq_new( mem, trial.seq0 ) ); FD_TEST( trial.fseq[r] );
+      }
+      memset( rx_result, 0, sizeof(rx_result) );
+      FD_COMPILER_MFENCE();
+
+      /* Run it */
+
+      fd_tile_exec_t * rx_exec[ RX_MAX ];
+      for( ulong r=0UL; r<rx_cnt; r++ ) rx_exec[r] = fd_tile_exec_new( placement_tile[p][1UL+r], rx_main, (int)r, NULL );
+      fd_tile_exec_t * tx_exec = fd_tile_exec_new( placement_tile[p][0], tx_main, 0, NULL );
+      FD_TEST( tx_exec );
+      FD_TEST( !fd_tile_exec_delete( tx_exec, NULL ) );
+      for( ulong r=0UL; r<rx_cnt; r++ ) { FD_TEST( rx_exec[r] ); FD_TEST( !fd_tile_exec_delete( rx_exec[r], NULL ) ); }
+
+      /* Summarize.  Latency percentiles are the worst over the
+         consumers, the overrun rate is over the unreliable ones. */
+
+      ulong tx_cnt = fd_seq_diff( trial.tx_seq, trial.seq0 )>0L ? (ulong)fd_seq_diff( trial.tx_seq, trial.seq0 ) : 0UL;
+      double dt_ns = (double)trial.tx_ticks / tick_per_ns;
+      double p50 = 0.; double p99 = 0.;
+      ulong unrel_rx = 0UL; ulong unrel_ovrn = 0UL;
+      for( ulong r=0UL; r<rx_cnt; r++ ) {
+        rx_result_t * res = rx_result + r;
+        if( r<rel_cnt ) FD_TEST( res->rx_cnt==tx_cnt && !res->ovrn_cnt ); /* Reliable consumers see everything */
+        else { unrel_rx += res->rx_cnt; unrel_ovrn += res->ovrn_cnt; }
+        ulong cnt = fd_ulong_min( res->lat_cnt, LAT_MAX );
+        if( !cnt ) continue;
+        p50 = fmax( p50, (double)sort_lat_select( res->lat, cnt, cnt/2UL         )[ cnt/2UL         ] / tick_per_ns );
+        p99 = fmax( p99, (double)sort_lat_select( res->lat, cnt, (cnt*99UL)/100UL )[ (cnt*99UL)/100UL ] / tick_per_ns );
+      }
+      double ovrn_pct = (unrel_rx+unrel_ovrn) ? 100.*(double)unrel_ovrn/(double)(unrel_rx+unrel_ovrn) : 0.;
+
+      FD_LOG_NOTICE(( "%-24s %-10s %6lu %5lu %3lu %5lu | %9.3f %9.3f %9.0f %9.0f %7.3f %7lu",
+                      label, placement_class_cstr[ cls ], trial.sz, trial.burst, rel_cnt, rx_cnt-rel_cnt,
+                      1e3*(double)tx_cnt/dt_ns, 8.*(double)tx_cnt*(double)trial.sz/dt_ns,
+                      p50, p99, ovrn_pct, trial.tx_backp ));
+
+      for( ulong r=0UL; r<rel_cnt; r++ ) fd_fseq_delete( fd_fseq_leave( trial.fseq[r] ) );
+      fd_dcache_delete( fd_dcache_leave( trial.dcache ) );
+      fd_mcache_delete( fd_mcache_leave( trial.mcache ) );
+    }}}}
+  }
+
+  fd_wksp_free_laddr( fseq_mem   );
+  fd_wksp_free_laddr( dcache_mem );
+  fd_wksp_free_laddr( mcache_mem );
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED and FD_HAS_ATOMIC capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
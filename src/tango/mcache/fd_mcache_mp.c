@@ -0,0 +1,97 @@
+#include "fd_mcache_mp.h"
+
+#if FD_HAS_ATOMIC
+
+ulong
+fd_mcache_mp_dcache_req_data_sz( ulong mtu,
+                                 ulong depth,
+                                 ulong burst,
+                                 ulong prod_cnt ) {
+
+  if( FD_UNLIKELY( !prod_cnt ) ) {
+    FD_LOG_WARNING(( "zero prod_cnt" ));
+    return 0UL;
+  }
+
+  /* Each producer could have all depth sequence numbers in flight */
+
+  ulong part_sz = fd_dcache_req_data_sz( mtu, depth, burst, 1 );
+  if( FD_UNLIKELY( !part_sz ) ) {
+    FD_LOG_WARNING(( "bad mtu %lu, depth %lu or burst %lu", mtu, depth, burst ));
+    return 0UL;
+  }
+
+  if( FD_UNLIKELY( part_sz>(ULONG_MAX/prod_cnt) ) ) {
+    FD_LOG_WARNING(( "too large" ));
+    return 0UL;
+  }
+
+  return part_sz*prod_cnt;
+}
+
+fd_mcache_mp_tx_t *
+fd_mcache_mp_tx_init( fd_mcache_mp_tx_t * tx,
+                      fd_frag_meta_t *    mcache,
+                      fd_fctl_t *         fctl,
+                      void const *        base,
+                      uchar const *       dcache,
+                      ulong               mtu,
+                      ulong               prod_cnt,
+                      ulong               prod_idx ) {
+
+  if( FD_UNLIKELY( !tx ) ) {
+    FD_LOG_WARNING(( "NULL tx" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !mcache ) ) {
+    FD_LOG_WARNING(( "NULL mcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( prod_idx>=prod_cnt ) ) {
+    FD_LOG_WARNING(( "bad prod_idx %lu (prod_cnt %lu)", prod_idx, prod_cnt ));
+    return NULL;
+  }
+
+  tx->mcache = mcache;
+  tx->depth  = fd_mcache_depth( mcache );
+  tx->rsv    = fd_mcache_seq_laddr( mcache ) + FD_MCACHE_MP_SEQ_RSV;
+  tx->fctl   = fctl;
+  tx->cr_seq = FD_VOLATILE_CONST( *tx->rsv ); /* No credits known yet */
+  tx->chunk0 = 0UL;
+  tx->wmark  = 0UL;
+  tx->chunk  = 0UL;
+
+  if( dcache ) {
+    if( FD_UNLIKELY( !base || !fd_ulong_is_aligned( (ulong)base, 2UL*FD_CHUNK_SZ ) || (ulong)dcache<(ulong)base ) ) {
+      FD_LOG_WARNING(( "bad base" ));
+      return NULL;
+    }
+
+    /* Split the data region into prod_cnt partitions of a whole number
+       of chunk pairs */
+
+    ulong chunk0    = fd_dcache_compact_chunk0( base, dcache );
+    ulong part_cnt  = ((fd_dcache_data_sz( dcache ) / prod_cnt) >> FD_CHUNK_LG_SZ) & ~1UL;
+    ulong chunk_mtu = ((mtu + 2UL*FD_CHUNK_SZ-1UL) >> (1+FD_CHUNK_LG_SZ)) << 1;
+
+    if( FD_UNLIKELY( part_cnt<chunk_mtu ) ) {
+      FD_LOG_WARNING(( "dcache data region too small for %lu producers with mtu %lu", prod_cnt, mtu ));
+      return NULL;
+    }
+
+    if( FD_UNLIKELY( chunk0 + prod_cnt*part_cnt > (ulong)UINT_MAX ) ) {
+      FD_LOG_WARNING(( "dcache too far from base" ));
+      return NULL;
+    }
+
+    tx->chunk0 = chunk0 + prod_idx*part_cnt;
+    tx->wmark  = tx->chunk0 + part_cnt - chunk_mtu;
+    tx->chunk  = tx->chunk0;
+  }
+
+  return tx;
+}
+
+#endif /* FD_HAS_ATOMIC */
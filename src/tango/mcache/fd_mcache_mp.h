@@ -0,0 +1,174 @@
+#ifndef HEADER_fd_src_tango_mcache_fd_mcache_mp_h
+#define HEADER_fd_src_tango_mcache_fd_mcache_mp_h
+
+/* fd_mcache_mp provides APIs for multiple producers to publish into a
+   single mcache (and share a single dcache), so that fan-in patterns
+   (e.g. many verify tiles into one dedup tile) don't need one link per
+   producer and the consumer doesn't need to scan dozens of mostly
+   empty links.  Consumers are unchanged: they see an ordinary mcache
+   with frags in sequence order.
+
+   Producers claim sequence numbers from a counter shared through the
+   mcache's seq array (seq[FD_MCACHE_MP_SEQ_RSV]) with an atomic
+   compare-and-swap and then publish the frag's metadata with the usual
+   torn-read-safe protocol (fd_mcache_publish).  A producer only claims
+   sequence numbers that cannot overrun any reliable consumer according
+   to an fd_fctl configured with the consumers' fseqs, so the total
+   number of frags in flight across all producers is flow controlled
+   exactly as for a single producer.
+
+   Since sequence numbers are claimed before they are published, a
+   consumer waiting on seq will not see seq+1 (even if already
+   published by another producer) until seq's producer publishes.  That
+   is, a producer that stalls between claiming and publishing stalls the
+   link.  Producers should claim immediately before publishing (i.e.
+   after the frag payload is ready).
+
+   The dcache data region is split into equal partitions, one per
+   producer, and each producer uses fd_dcache_compact_next style
+   allocation within its own partition.  Each partition must be able to
+   hold the frags of all the sequence numbers a single producer could
+   have in flight, see fd_mcache_mp_dcache_req_data_sz.
+
+   seq[0] is not updated by the producers (none of them knows a lower
+   bound of what all the producers have published).  It stays at the
+   value it had when fd_mcache_mp_init was called. */
+
+#include "fd_mcache.h"
+#include "../dcache/fd_dcache.h"
+#include "../fctl/fd_fctl.h"
+
+#if FD_HAS_ATOMIC
+
+/* FD_MCACHE_MP_SEQ_RSV is the index in the mcache's seq array of the
+   shared sequence number reservation counter. */
+
+#define FD_MCACHE_MP_SEQ_RSV (1UL)
+
+/* fd_mcache_mp_tx_t is the local state of one producer of a multi
+   producer mcache. */
+
+struct fd_mcache_mp_tx {
+  fd_frag_meta_t * mcache;  /* local join to the mcache */
+  ulong            depth;   /* ==fd_mcache_depth( mcache ) */
+  ulong *          rsv;     /* ==fd_mcache_seq_laddr( mcache ) + FD_MCACHE_MP_SEQ_RSV */
+  fd_fctl_t *      fctl;    /* flow control for reliable consumers, NULL if none */
+  ulong            cr_seq;  /* claiming sequence numbers strictly before cr_seq (cyclic) cannot overrun a reliable consumer */
+  ulong            chunk0;  /* this producer's dcache partition, chunks [chunk0,wmark] relative to base (0 if no dcache) */
+  ulong            wmark;
+  ulong            chunk;   /* next chunk this producer will write, in [chunk0,wmark] */
+};
+
+typedef struct fd_mcache_mp_tx fd_mcache_mp_tx_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_mcache_mp_init prepares a newly created mcache for use by multiple
+   producers.  This should be called exactly once (e.g. by whatever
+   created the mcache) before any producer uses it.  Returns mcache. */
+
+static inline fd_frag_meta_t *
+fd_mcache_mp_init( fd_frag_meta_t * mcache ) {
+  ulong * seq = fd_mcache_seq_laddr( mcache );
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( seq[ FD_MCACHE_MP_SEQ_RSV ] ) = fd_mcache_seq_query( seq );
+  FD_COMPILER_MFENCE();
+  return mcache;
+}
+
+/* fd_mcache_mp_dcache_req_data_sz returns the size of a dcache data
+   region that can be shared by prod_cnt producers of an mcache with
+   the given depth, each publishing frags up to mtu bytes in size in
+   bursts of up to burst frags.  Returns 0 on failure (logs details,
+   e.g. zero prod_cnt or too large). */
+
+ulong
+fd_mcache_mp_dcache_req_data_sz( ulong mtu,
+                                 ulong depth,
+                                 ulong burst,
+                                 ulong prod_cnt );
+
+/* fd_mcache_mp_tx_init initializes the local state of producer prod_idx
+   in [0,prod_cnt) of mcache.  fctl is the flow control for the
+   mcache's reliable consumers (NULL if there are none).  If dcache is
+   non-NULL, the producer gets its own partition of dcache's data region
+   (relative to base, as for fd_dcache_compact_chunk0) for frags up to
+   mtu bytes in size.  Returns tx on success and NULL on failure (logs
+   details).  Reasons for failure include bad prod_idx / prod_cnt and a
+   dcache partition too small to hold a frag. */
+
+fd_mcache_mp_tx_t *
+fd_mcache_mp_tx_init( fd_mcache_mp_tx_t * tx,
+                      fd_frag_meta_t *    mcache,
+                      fd_fctl_t *         fctl,
+                      void const *        base,
+                      uchar const *       dcache,
+                      ulong               mtu,
+                      ulong               prod_cnt,
+                      ulong               prod_idx );
+
+/* fd_mcache_mp_reserve claims cnt consecutive sequence numbers for the
+   caller to publish.  On success, returns 1 and the first claimed
+   sequence number is stored at *_seq.  The caller must publish all of
+   [*_seq,*_seq+cnt) cyclic promptly (see above).  Returns 0 if the
+   claim would overrun a reliable consumer (i.e. the link is
+   backpressured), in which case nothing is claimed and the caller
+   should retry later. */
+
+static inline int
+fd_mcache_mp_reserve( fd_mcache_mp_tx_t * tx,
+                      ulong               cnt,
+                      ulong *             _seq ) {
+  ulong seq = FD_VOLATILE_CONST( *tx->rsv );
+  for(;;) {
+    ulong seq_end = fd_seq_inc( seq, cnt );
+    if( FD_LIKELY( tx->fctl ) && FD_UNLIKELY( fd_seq_gt( seq_end, tx->cr_seq ) ) ) {
+      ulong rx_idx_slow;
+      tx->cr_seq = fd_seq_inc( seq, fd_fctl_cr_query( tx->fctl, seq, &rx_idx_slow ) );
+      if( FD_UNLIKELY( fd_seq_gt( seq_end, tx->cr_seq ) ) ) return 0;
+    }
+    ulong seq_old = FD_ATOMIC_CAS( tx->rsv, seq, seq_end );
+    if( FD_LIKELY( seq_old==seq ) ) break;
+    seq = seq_old; /* Another producer claimed first, try again from there */
+  }
+  *_seq = seq;
+  return 1;
+}
+
+/* fd_mcache_mp_publish publishes the metadata of claimed sequence
+   number seq.  Same as fd_mcache_publish otherwise. */
+
+static inline void
+fd_mcache_mp_publish( fd_mcache_mp_tx_t * tx,
+                      ulong               seq,
+                      ulong               sig,
+                      ulong               chunk,
+                      ulong               sz,
+                      ulong               ctl,
+                      ulong               tsorig,
+                      ulong               tspub ) {
+#if FD_HAS_SSE
+  fd_mcache_publish_sse( tx->mcache, tx->depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+#else
+  fd_mcache_publish    ( tx->mcache, tx->depth, seq, sig, chunk, sz, ctl, tsorig, tspub );
+#endif
+}
+
+/* fd_mcache_mp_chunk returns the chunk the producer should write its
+   next frag payload to.  fd_mcache_mp_chunk_advance moves to the next
+   chunk after a frag of sz bytes has been written (and published) at
+   the current one. */
+
+FD_FN_PURE static inline ulong fd_mcache_mp_chunk( fd_mcache_mp_tx_t const * tx ) { return tx->chunk; }
+
+static inline void
+fd_mcache_mp_chunk_advance( fd_mcache_mp_tx_t * tx,
+                            ulong               sz ) {
+  tx->chunk = fd_dcache_compact_next( tx->chunk, sz, tx->chunk0, tx->wmark );
+}
+
+FD_PROTOTYPES_END
+
+#endif /* FD_HAS_ATOMIC */
+
+#endif /* HEADER_fd_src_tango_mcache_fd_mcache_mp_h */
@@ -0,0 +1,212 @@
+#include "../fd_tango.h"
+#include "fd_mcache_mp.h"
+
+#if FD_HAS_HOSTED && FD_HAS_ATOMIC
+
+#define DEPTH    (128UL)
+#define MTU      (256UL)
+#define PROD_MAX (8UL)
+
+static uchar __attribute__((aligned(FD_MCACHE_ALIGN))) mcache_mem[ FD_MCACHE_FOOTPRINT( DEPTH, 0UL ) ];
+static uchar __attribute__((aligned(FD_DCACHE_ALIGN))) dcache_mem[ FD_DCACHE_FOOTPRINT( PROD_MAX*(DEPTH+2UL)*MTU, 0UL ) ];
+static uchar __attribute__((aligned(FD_FCTL_ALIGN)))   fctl_mem  [ FD_FCTL_FOOTPRINT( 1UL ) ];
+
+static fd_frag_meta_t * mcache;
+static uchar *          dcache;
+static fd_fctl_t *      fctl;
+static ulong            prod_cnt;
+static ulong            frag_cnt;
+static ulong            rx_seq[1];
+static ulong            rx_slow[1];
+
+/* Each producer publishes frag_cnt frags, frag i of producer p has sig
+   (p<<32)|i and its payload is sig repeated. */
+
+static int
+prod_main( int     argc,
+           char ** argv ) {
+  (void)argv;
+  ulong prod_idx = (ulong)argc;
+
+  fd_mcache_mp_tx_t tx[1];
+  FD_TEST( fd_mcache_mp_tx_init( tx, mcache, fctl, dcache, dcache, MTU, prod_cnt, prod_idx )==tx );
+
+  for( ulong i=0UL; i<frag_cnt; i++ ) {
+    ulong sig   = (prod_idx<<32) | i;
+    ulong sz    = 8UL*(1UL + (i % (MTU/8UL)));
+    ulong chunk = fd_mcache_mp_chunk( tx );
+    ulong * p   = (ulong *)fd_chunk_to_laddr( dcache, chunk );
+    for( ulong j=0UL; j<sz/8UL; j++ ) p[j] = sig;
+
+    ulong seq;
+    while( !fd_mcache_mp_reserve( tx, 1UL, &seq ) ) FD_SPIN_PAUSE();
+    fd_mcache_mp_publish( tx, seq, sig, chunk, sz, fd_frag_meta_ctl( prod_idx, 1, 1, 0 ), 0UL, 0UL );
+    fd_mcache_mp_chunk_advance( tx, sz );
+  }
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  ulong seq0 = fd_env_strip_cmdline_ulong( &argc, &argv, "--seq0",     NULL, 1234567890UL );
+  frag_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--frag-cnt", NULL,     100000UL );
+
+  mcache = fd_mcache_join( fd_mcache_new( mcache_mem, DEPTH, 0UL, seq0 ) ); FD_TEST( mcache );
+  FD_TEST( fd_mcache_mp_init( mcache )==mcache );
+  FD_TEST( fd_mcache_seq_laddr( mcache )[ FD_MCACHE_MP_SEQ_RSV ]==seq0 );
+
+  FD_TEST( !fd_mcache_mp_dcache_req_data_sz( MTU, DEPTH, 1UL, 0UL ) );
+  FD_TEST( !fd_mcache_mp_dcache_req_data_sz( 0UL, DEPTH, 1UL, 1UL ) );
+  ulong data_sz = fd_mcache_mp_dcache_req_data_sz( MTU, DEPTH, 1UL, 2UL );
+  FD_TEST( data_sz==2UL*fd_dcache_req_data_sz( MTU, DEPTH, 1UL, 1 ) );
+  FD_TEST( data_sz<=PROD_MAX*(DEPTH+2UL)*MTU );
+
+  dcache = fd_dcache_join( fd_dcache_new( dcache_mem, data_sz, 0UL ) ); FD_TEST( dcache );
+
+  fctl = fd_fctl_join( fd_fctl_new( fctl_mem, 1UL ) ); FD_TEST( fctl );
+  rx_seq[0] = seq0;
+  FD_TEST( fd_fctl_cfg_rx_add( fctl, DEPTH, rx_seq, rx_slow ) );
+  FD_TEST( fd_fctl_cfg_done( fctl, 1UL, 0UL, 0UL, 0UL ) );
+
+  /* Bad init */
+
+  fd_mcache_mp_tx_t tx[2];
+  FD_TEST( !fd_mcache_mp_tx_init( NULL, mcache, fctl, dcache, dcache, MTU, 2UL, 0UL ) );
+  FD_TEST( !fd_mcache_mp_tx_init( tx,   NULL,   fctl, dcache, dcache, MTU, 2UL, 0UL ) );
+  FD_TEST( !fd_mcache_mp_tx_init( tx,   mcache, fctl, dcache, dcache, MTU, 2UL, 2UL ) );
+  FD_TEST( !fd_mcache_mp_tx_init( tx,   mcache, fctl, dcache, dcache, data_sz, 4UL, 0UL ) ); /* partition too small */
+
+  /* Partitions are disjoint and inside the data region */
+
+  FD_TEST( fd_mcache_mp_tx_init( tx+0, mcache, fctl, dcache, dcache, MTU, 2UL, 0UL )==tx+0 );
+  FD_TEST( fd_mcache_mp_tx_init( tx+1, mcache, fctl, dcache, dcache, MTU, 2UL, 1UL )==tx+1 );
+  ulong chunk0 = fd_dcache_compact_chunk0( dcache, dcache );
+  ulong chunk1 = fd_dcache_compact_chunk1( dcache, dcache );
+  ulong chunk_mtu = MTU/FD_CHUNK_SZ;
+  FD_TEST( tx[0].chunk0==chunk0 );
+  FD_TEST( tx[0].wmark+chunk_mtu<=tx[1].chunk0 );
+  FD_TEST( tx[1].wmark+chunk_mtu<=chunk1 );
+
+  /* Claims from different producers interleave and a consumer sees the
+     frags in sequence order, even if published out of order */
+
+  ulong seq_a; FD_TEST( fd_mcache_mp_reserve( tx+0, 1UL, &seq_a ) ); FD_TEST( seq_a==seq0 );
+  ulong seq_b; FD_TEST( fd_mcache_mp_reserve( tx+1, 2UL, &seq_b ) ); FD_TEST( seq_b==fd_seq_inc( seq0, 1UL ) );
+
+  fd_mcache_mp_publish( tx+1, seq_b,                  2UL, tx[1].chunk0, 0UL, 0UL, 0UL, 0UL );
+  fd_mcache_mp_publish( tx+1, fd_seq_inc( seq_b, 1 ), 3UL, tx[1].chunk0, 0UL, 0UL, 0UL, 0UL );
+
+  fd_frag_meta_t const * mline = mcache + fd_mcache_line_idx( seq0, DEPTH );
+  FD_TEST( fd_seq_lt( mline->seq, seq0 ) ); /* seq0 not yet published, consumer waits */
+
+  fd_mcache_mp_publish( tx+0, seq_a, 1UL, tx[0].chunk0, 0UL, 0UL, 0UL, 0UL );
+  for( ulong i=0UL; i<3UL; i++ ) {
+    ulong seq = fd_seq_inc( seq0, i );
+    mline = mcache + fd_mcache_line_idx( seq, DEPTH );
+    FD_TEST( mline->seq==seq );
+    FD_TEST( mline->sig==i+1UL );
+  }
+
+  /* Claims are flow controlled against the reliable consumer */
+
+  ulong seq;
+  FD_TEST( fd_mcache_mp_reserve( tx+0, DEPTH-3UL, &seq ) ); FD_TEST( seq==fd_seq_inc( seq0, 3UL ) );
+  FD_TEST( !fd_mcache_mp_reserve( tx+1, 1UL, &seq ) );
+  FD_TEST( !fd_mcache_mp_reserve( tx+0, 1UL, &seq ) );
+  fd_fctl_rx_cr_return( rx_seq, fd_seq_inc( seq0, 2UL ) );
+  FD_TEST( !fd_mcache_mp_reserve( tx+1, 3UL, &seq ) );
+  FD_TEST(  fd_mcache_mp_reserve( tx+1, 2UL, &seq ) ); FD_TEST( seq==fd_seq_inc( seq0, DEPTH ) );
+  FD_TEST( !fd_mcache_mp_reserve( tx+0, 1UL, &seq ) );
+
+  /* Without reliable consumers, claims are never backpressured */
+
+  fd_mcache_mp_tx_t tx_unreliable[1];
+  FD_TEST( fd_mcache_mp_tx_init( tx_unreliable, mcache, NULL, NULL, NULL, 0UL, 1UL, 0UL )==tx_unreliable );
+  FD_TEST( fd_mcache_mp_reserve( tx_unreliable, 2UL*DEPTH, &seq ) ); FD_TEST( seq==fd_seq_inc( seq0, DEPTH+2UL ) );
+
+  /* Concurrent producers */
+
+  ulong tile_cnt = fd_tile_cnt();
+  if( FD_UNLIKELY( tile_cnt<2UL ) ) {
+    FD_LOG_WARNING(( "skip: concurrent producer test requires at least 2 tiles" ));
+  } else {
+
+    prod_cnt = fd_ulong_min( tile_cnt-1UL, PROD_MAX );
+    FD_LOG_NOTICE(( "Testing %lu concurrent producers", prod_cnt ));
+
+    fd_mcache_delete( fd_mcache_leave( mcache ) );
+    mcache = fd_mcache_join( fd_mcache_new( mcache_mem, DEPTH, 0UL, seq0 ) ); FD_TEST( mcache );
+    FD_TEST( fd_mcache_mp_init( mcache )==mcache );
+    fd_fctl_rx_cr_return( rx_seq, seq0 );
+
+    fd_dcache_delete( fd_dcache_leave( dcache ) );
+    data_sz = fd_mcache_mp_dcache_req_data_sz( MTU, DEPTH, 1UL, prod_cnt ); FD_TEST( data_sz );
+    dcache  = fd_dcache_join( fd_dcache_new( dcache_mem, data_sz, 0UL ) ); FD_TEST( dcache );
+
+    fd_tile_exec_t * exec[ PROD_MAX ];
+    for( ulong p=0UL; p<prod_cnt; p++ ) exec[p] = fd_tile_exec_new( p+1UL, prod_main, (int)p, NULL );
+
+    ulong next[ PROD_MAX ] = {0};
+    seq = seq0;
+    for( ulong rem=prod_cnt*frag_cnt; rem; rem-- ) {
+      mline = mcache + fd_mcache_line_idx( seq, DEPTH );
+      fd_frag_meta_t meta[1];
+      for(;;) {
+        FD_COMPILER_MFENCE();
+        ulong seq_found = mline->seq;
+        FD_COMPILER_MFENCE();
+        *meta = *mline;
+        FD_COMPILER_MFENCE();
+        ulong seq_test = mline->seq;
+        FD_COMPILER_MFENCE();
+        FD_TEST( !fd_seq_gt( seq_found, seq ) ); /* Never overrun */
+        if( FD_LIKELY( seq_found==seq && seq_test==seq ) ) break;
+        FD_SPIN_PAUSE();
+      }
+
+      ulong p = meta->sig >> 32;
+      ulong i = meta->sig & 0xffffffffUL;
+      FD_TEST( p<prod_cnt );
+      FD_TEST( fd_frag_meta_ctl_orig( meta->ctl )==p );
+      FD_TEST( i==next[p] ); /* Each producer's frags are in order */
+      next[p]++;
+
+      ulong const * payload = (ulong const *)fd_chunk_to_laddr_const( dcache, meta->chunk );
+      for( ulong j=0UL; j<(ulong)meta->sz/8UL; j++ ) FD_TEST( payload[j]==meta->sig );
+
+      seq = fd_seq_inc( seq, 1UL );
+      fd_fctl_rx_cr_return( rx_seq, seq );
+    }
+
+    for( ulong p=0UL; p<prod_cnt; p++ ) {
+      int ret;
+      FD_TEST( !fd_tile_exec_delete( exec[p], &ret ) );
+      FD_TEST( !ret );
+      FD_TEST( next[p]==frag_cnt );
+    }
+  }
+
+  fd_fctl_delete( fd_fctl_leave( fctl ) );
+  fd_dcache_delete( fd_dcache_leave( dcache ) );
+  fd_mcache_delete( fd_mcache_leave( mcache ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED and FD_HAS_ATOMIC capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
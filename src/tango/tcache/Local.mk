@@ -1,4 +1,6 @@
-$(call add-hdrs,fd_tcache.h)
-$(call add-objs,fd_tcache,fd_tango)
+$(call add-hdrs,fd_tcache.h fd_tcache_bkt.h)
+$(call add-objs,fd_tcache fd_tcache_bkt,fd_tango)
 $(call make-unit-test,test_tcache,test_tcache,fd_tango fd_util)
 $(call run-unit-test,test_tcache)
+$(call make-unit-test,test_tcache_bkt,test_tcache_bkt,fd_tango fd_util)
+$(call run-unit-test,test_tcache_bkt)
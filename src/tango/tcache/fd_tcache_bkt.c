@@ -0,0 +1,115 @@
+#include "fd_tcache_bkt.h"
+
+ulong
+fd_tcache_bkt_align( void ) {
+  return FD_TCACHE_BKT_ALIGN;
+}
+
+ulong
+fd_tcache_bkt_footprint( ulong depth,
+                         ulong bkt_cnt ) {
+  if( !bkt_cnt ) bkt_cnt = fd_tcache_bkt_bkt_cnt_default( depth ); /* use default */
+
+  if( FD_UNLIKELY( (!depth) | (!fd_ulong_is_pow2( bkt_cnt )) ) ) return 0UL; /* Invalid depth / bkt_cnt */
+
+  if( FD_UNLIKELY( bkt_cnt>((ULONG_MAX/sizeof(ulong) - 16UL)/FD_TCACHE_BKT_WIDTH) ) ) return 0UL; /* overflow */
+  ulong cnt = (16UL + FD_TCACHE_BKT_WIDTH*bkt_cnt)*sizeof(ulong); /* no overflow */
+  ulong footprint = fd_ulong_align_up( cnt, FD_TCACHE_BKT_ALIGN ); if( FD_UNLIKELY( footprint<cnt ) ) return 0UL; /* overflow */
+  return footprint;
+}
+
+void *
+fd_tcache_bkt_new( void * shmem,
+                   ulong  depth,
+                   ulong  bkt_cnt ) {
+  if( !bkt_cnt ) bkt_cnt = fd_tcache_bkt_bkt_cnt_default( depth ); /* use default */
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_tcache_bkt_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_tcache_bkt_footprint( depth, bkt_cnt );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad depth (%lu) and/or bkt_cnt (%lu)", depth, bkt_cnt ));
+    return NULL;
+  }
+
+  fd_memset( shmem, 0, footprint );
+
+  fd_tcache_bkt_t * tcache = (fd_tcache_bkt_t *)shmem;
+
+  tcache->depth   = depth;
+  tcache->bkt_cnt = bkt_cnt;
+  fd_tcache_bkt_reset( fd_tcache_bkt_bkt_laddr( tcache ), bkt_cnt );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tcache->magic ) = FD_TCACHE_BKT_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_tcache_bkt_t *
+fd_tcache_bkt_join( void * _tcache ) {
+
+  if( FD_UNLIKELY( !_tcache ) ) {
+    FD_LOG_WARNING(( "NULL _tcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_tcache, fd_tcache_bkt_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _tcache" ));
+    return NULL;
+  }
+
+  fd_tcache_bkt_t * tcache = (fd_tcache_bkt_t *)_tcache;
+  if( FD_UNLIKELY( tcache->magic!=FD_TCACHE_BKT_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return tcache;
+}
+
+void *
+fd_tcache_bkt_leave( fd_tcache_bkt_t * tcache ) {
+
+  if( FD_UNLIKELY( !tcache ) ) {
+    FD_LOG_WARNING(( "NULL tcache" ));
+    return NULL;
+  }
+
+  return (void *)tcache;
+}
+
+void *
+fd_tcache_bkt_delete( void * _tcache ) {
+
+  if( FD_UNLIKELY( !_tcache ) ) {
+    FD_LOG_WARNING(( "NULL _tcache" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)_tcache, fd_tcache_bkt_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned _tcache" ));
+    return NULL;
+  }
+
+  fd_tcache_bkt_t * tcache = (fd_tcache_bkt_t *)_tcache;
+  if( FD_UNLIKELY( tcache->magic != FD_TCACHE_BKT_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( tcache->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return _tcache;
+}
@@ -0,0 +1,228 @@
+#ifndef HEADER_fd_src_tango_tcache_fd_tcache_bkt_h
+#define HEADER_fd_src_tango_tcache_fd_tcache_bkt_h
+
+/* A fd_tcache_bkt_t is a bucketized variant of fd_tcache_t (see
+   fd_tcache.h) for deduplication in performance critical contexts that
+   see heavy duplicate floods (e.g. the dedup tile during spam).
+
+   Tags are hashed to a bucket by their low bits.  A bucket is a single
+   64 byte cache line holding the FD_TCACHE_BKT_WIDTH (8) most recently
+   inserted unique tags that hashed to it, newest first.  A query or
+   insert touches exactly one cache line (a query is two 256-bit loads
+   and compares on AVX targets) and an insert of a unique tag shifts the
+   bucket by one slot (evicting the bucket's oldest tag) and writes the
+   new tag at the front.  There is no separate ring or probe sequence,
+   so there are no cache misses on eviction and no data dependent
+   probe lengths under adversarial fill.
+
+   The difference from fd_tcache is how history is retained.  fd_tcache
+   remembers exactly the most recent depth unique tags.  fd_tcache_bkt
+   remembers, for every bucket, the most recent 8 unique tags that
+   hashed to that bucket.  So a tag is remembered until 8 newer unique
+   tags hash to its bucket, which for IID random tags takes ~8 bkt_cnt
+   unique inserts on average.  With the default bkt_cnt (a power of 2
+   of at least depth/2), the probability a tag inserted depth unique
+   tags ago has been forgotten is at most P(Poisson(2)>=8) ~ 1e-3 (and
+   is negligible for the young duplicates that dominate in practice).
+   Like fd_tcache, this is suitable for deduplication where an
+   occasional missed duplicate only costs downstream work.
+
+   INSERT semantics are otherwise the same as FD_TCACHE_INSERT: a
+   duplicate tag is reported and leaves the cache unchanged (not LRU),
+   and a unique tag is inserted.
+
+   As with fd_tcache, the tcache should be backed by a single NUMA
+   (gigantic) page if used in performance critical contexts. */
+
+#include "fd_tcache.h"
+
+#if FD_HAS_AVX
+#include "../../util/simd/fd_avx.h"
+#endif
+
+/* FD_TCACHE_BKT_WIDTH is the number of tags in a bucket.  A bucket is
+   exactly one 64 byte cache line. */
+
+#define FD_TCACHE_BKT_WIDTH (8UL)
+
+/* FD_TCACHE_BKT_{ALIGN,FOOTPRINT} specify the alignment and footprint
+   needed for a tcache_bkt with bkt_cnt buckets.  bkt_cnt is assumed to
+   be valid (i.e. a positive integer power of 2 that will not require a
+   footprint larger than ULONG_MAX).  These are provided to facilitate
+   compile time declarations. */
+
+#define FD_TCACHE_BKT_ALIGN (128UL)
+#define FD_TCACHE_BKT_FOOTPRINT( bkt_cnt )                                    \
+  FD_LAYOUT_FINI( FD_LAYOUT_APPEND( FD_LAYOUT_INIT,                           \
+    FD_TCACHE_BKT_ALIGN, (16UL + FD_TCACHE_BKT_WIDTH*(bkt_cnt))*sizeof(ulong) ), \
+    FD_TCACHE_BKT_ALIGN )
+
+/* FD_TCACHE_BKT_SPARSE_DEFAULT specifies how sparse a default bkt_cnt
+   tcache_bkt should be: the default bkt_cnt is the smallest power of 2
+   such that the most recent depth tags occupy on average at most
+   FD_TCACHE_BKT_WIDTH/2^SPARSE_DEFAULT slots per bucket (2 for a
+   SPARSE_DEFAULT of 2).  Larger values forget less history early at
+   exponentially increasing memory footprint. */
+
+#define FD_TCACHE_BKT_SPARSE_DEFAULT (2)
+
+#define FD_TCACHE_BKT_MAGIC (0xf17eda2c377cb4b0UL) /* firedancer tcash bkt ver 0 */
+
+struct __attribute((aligned(FD_TCACHE_BKT_ALIGN))) fd_tcache_bkt_private {
+  ulong magic;   /* ==FD_TCACHE_BKT_MAGIC */
+  ulong depth;   /* Nominal history, as given at creation */
+  ulong bkt_cnt;
+
+  /* Padding to FD_TCACHE_BKT_ALIGN */
+
+  /* bkt_cnt*FD_TCACHE_BKT_WIDTH ulong (bkt), starting at byte 128:
+
+     Bucket b is bkt[ b*FD_TCACHE_BKT_WIDTH + i ] for i in [0,WIDTH)
+     with i==0 the newest tag.  Unused slots hold FD_TCACHE_TAG_NULL. */
+};
+
+typedef struct fd_tcache_bkt_private fd_tcache_bkt_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_tcache_bkt_bkt_cnt_default returns the default bkt_cnt to use for
+   the given depth.  Returns 0 if the depth is invalid / results in a
+   footprint larger than ULONG_MAX. */
+
+FD_FN_CONST static inline ulong
+fd_tcache_bkt_bkt_cnt_default( ulong depth ) {
+  if( FD_UNLIKELY( !depth ) ) return 0UL; /* depth must be positive */
+  ulong min_cnt = (depth + (FD_TCACHE_BKT_WIDTH>>FD_TCACHE_BKT_SPARSE_DEFAULT) - 1UL) / (FD_TCACHE_BKT_WIDTH>>FD_TCACHE_BKT_SPARSE_DEFAULT);
+  if( FD_UNLIKELY( min_cnt>(1UL<<56) ) ) return 0UL; /* depth too large */
+  return fd_ulong_pow2_up( min_cnt );
+}
+
+/* fd_tcache_bkt_{align,footprint,new,join,leave,delete} are the same as
+   their fd_tcache counterparts.  A bkt_cnt of 0 indicates to use
+   fd_tcache_bkt_bkt_cnt_default above.  footprint returns 0 if depth
+   is not positive, bkt_cnt is not a power of 2 or the footprint would
+   be larger than ULONG_MAX.  A new tcache_bkt is empty. */
+
+FD_FN_CONST ulong
+fd_tcache_bkt_align( void );
+
+FD_FN_CONST ulong
+fd_tcache_bkt_footprint( ulong depth,
+                         ulong bkt_cnt );
+
+void *
+fd_tcache_bkt_new( void * shmem,
+                   ulong  depth,
+                   ulong  bkt_cnt );
+
+fd_tcache_bkt_t *
+fd_tcache_bkt_join( void * _tcache );
+
+void *
+fd_tcache_bkt_leave( fd_tcache_bkt_t * tcache );
+
+void *
+fd_tcache_bkt_delete( void * _tcache );
+
+/* fd_tcache_bkt_{depth,bkt_cnt,bkt_laddr} return various properties of
+   the tcache_bkt.  These assume tcache is a valid local join.  Typical
+   usage unpacks bkt and bkt_cnt into registers. */
+
+FD_FN_PURE  static inline ulong   fd_tcache_bkt_depth    ( fd_tcache_bkt_t const * tcache ) { return tcache->depth;   }
+FD_FN_PURE  static inline ulong   fd_tcache_bkt_bkt_cnt  ( fd_tcache_bkt_t const * tcache ) { return tcache->bkt_cnt; }
+FD_FN_CONST static inline ulong * fd_tcache_bkt_bkt_laddr( fd_tcache_bkt_t *       tcache ) { return ((ulong *)tcache)+16UL; }
+
+/* fd_tcache_bkt_reset resets a tcache_bkt to empty, the same state the
+   tcache_bkt was in at creation.  Does no input argument checking and
+   uses the unpacked fields. */
+
+static inline void
+fd_tcache_bkt_reset( ulong * bkt,
+                     ulong   bkt_cnt ) {
+  for( ulong idx=0UL; idx<bkt_cnt*FD_TCACHE_BKT_WIDTH; idx++ ) bkt[ idx ] = FD_TCACHE_TAG_NULL;
+}
+
+/* fd_tcache_bkt_line returns the bucket for tag.  Assumes bkt_cnt is a
+   positive integer power of 2.  Like fd_tcache_map_start, optimized
+   for the case where tags are randomized. */
+
+FD_FN_CONST static inline ulong *
+fd_tcache_bkt_line( ulong * bkt,
+                    ulong   bkt_cnt,
+                    ulong   tag ) {
+  return bkt + FD_TCACHE_BKT_WIDTH*(tag & (bkt_cnt-1UL));
+}
+
+/* fd_tcache_bkt_query returns 1 if tag is in the tcache_bkt and 0
+   otherwise.  fd_tcache_bkt_insert inserts tag into the tcache_bkt.
+   Returns 1 if tag was already in the tcache_bkt (which is unchanged)
+   and 0 if tag was inserted (evicting the oldest tag of its bucket if
+   the bucket was full).  Both are a fast O(1) that touch one cache line
+   and do no input argument checking.  Assumes bkt is non-NULL and
+   indexed [0,bkt_cnt*FD_TCACHE_BKT_WIDTH), bkt_cnt is a positive
+   integer power of 2 and tag is not null. */
+
+#if FD_HAS_AVX
+
+FD_FN_PURE static inline int
+fd_tcache_bkt_query( ulong const * bkt,
+                     ulong         bkt_cnt,
+                     ulong         tag ) {
+  long const * line = (long const *)fd_tcache_bkt_line( (ulong *)bkt, bkt_cnt, tag );
+  wl_t t = wl_bcast( (long)tag );
+  return wc_any( wc_or( wl_eq( wl_ld( line ), t ), wl_eq( wl_ld( line+4 ), t ) ) );
+}
+
+static inline int
+fd_tcache_bkt_insert( ulong * bkt,
+                      ulong   bkt_cnt,
+                      ulong   tag ) {
+  long * line = (long *)fd_tcache_bkt_line( bkt, bkt_cnt, tag );
+  wl_t t  = wl_bcast( (long)tag );
+  wl_t lo = wl_ld( line   );
+  wl_t hi = wl_ld( line+4 );
+  int dup = wc_any( wc_or( wl_eq( lo, t ), wl_eq( hi, t ) ) );
+  if( !dup ) { /* application dependent branch probability */
+
+    /* Rotate each half right by one slot and carry slot 3 into slot 4,
+       evicting slot 7 (the bucket's oldest) and freeing slot 0. */
+
+    wl_t first = wl( -1L, 0L, 0L, 0L );
+    wl_t lo_r  = wl_permute( lo, 3, 0, 1, 2 );
+    wl_t hi_r  = wl_permute( hi, 3, 0, 1, 2 );
+    wl_st( line,   wl_if( first, t,    lo_r ) );
+    wl_st( line+4, wl_if( first, lo_r, hi_r ) );
+  }
+  return dup;
+}
+
+#else
+
+FD_FN_PURE static inline int
+fd_tcache_bkt_query( ulong const * bkt,
+                     ulong         bkt_cnt,
+                     ulong         tag ) {
+  ulong const * line = fd_tcache_bkt_line( (ulong *)bkt, bkt_cnt, tag );
+  int found = 0;
+  for( ulong i=0UL; i<FD_TCACHE_BKT_WIDTH; i++ ) found |= (line[ i ]==tag);
+  return found;
+}
+
+static inline int
+fd_tcache_bkt_insert( ulong * bkt,
+                      ulong   bkt_cnt,
+                      ulong   tag ) {
+  int dup = fd_tcache_bkt_query( bkt, bkt_cnt, tag );
+  if( !dup ) { /* application dependent branch probability */
+    ulong * line = fd_tcache_bkt_line( bkt, bkt_cnt, tag );
+    for( ulong i=FD_TCACHE_BKT_WIDTH-1UL; i; i-- ) line[ i ] = line[ i-1UL ];
+    line[ 0 ] = tag;
+  }
+  return dup;
+}
+
+#endif
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_tango_tcache_fd_tcache_bkt_h */
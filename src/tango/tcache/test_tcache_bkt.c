@@ -0,0 +1,215 @@
+#include "../fd_tango.h"
+
+#if FD_HAS_HOSTED
+
+FD_STATIC_ASSERT( FD_TCACHE_BKT_ALIGN==128UL,               unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_BKT_WIDTH==8UL,                 unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_BKT_FOOTPRINT(1UL)==256UL,      unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_BKT_FOOTPRINT(4UL)==384UL,      unit_test );
+FD_STATIC_ASSERT( FD_TCACHE_BKT_SPARSE_DEFAULT==2,          unit_test );
+
+#define BKT_CNT (64UL)
+
+static uchar tcache_mem[ FD_TCACHE_BKT_FOOTPRINT( BKT_CNT ) ] __attribute__((aligned(FD_TCACHE_BKT_ALIGN)));
+
+/* ref is a reference model of the buckets: ref[b][i] is the i-th
+   newest tag of bucket b */
+
+static ulong ref[ BKT_CNT ][ FD_TCACHE_BKT_WIDTH ];
+
+static int
+ref_insert( ulong tag ) {
+  ulong * line = ref[ tag & (BKT_CNT-1UL) ];
+  for( ulong i=0UL; i<FD_TCACHE_BKT_WIDTH; i++ ) if( line[i]==tag ) return 1;
+  for( ulong i=FD_TCACHE_BKT_WIDTH-1UL; i; i-- ) line[i] = line[i-1UL];
+  line[0] = tag;
+  return 0;
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_TEST( fd_tcache_bkt_align()==FD_TCACHE_BKT_ALIGN );
+  FD_TEST( !fd_tcache_bkt_footprint( 0UL, 4UL ) );
+  FD_TEST( !fd_tcache_bkt_footprint( 1UL, 3UL ) );
+  FD_TEST( !fd_tcache_bkt_footprint( 1UL, 1UL<<62 ) );
+  FD_TEST( fd_tcache_bkt_bkt_cnt_default( 0UL )==0UL );
+  FD_TEST( fd_tcache_bkt_bkt_cnt_default( 1UL )==1UL );
+  FD_TEST( fd_tcache_bkt_bkt_cnt_default( 2UL )==1UL );
+  FD_TEST( fd_tcache_bkt_bkt_cnt_default( 3UL )==2UL );
+  FD_TEST( fd_tcache_bkt_bkt_cnt_default( 5UL )==4UL );
+  FD_TEST( fd_tcache_bkt_bkt_cnt_default( (1UL<<25)-2UL )==(1UL<<24) );
+  FD_TEST( !fd_tcache_bkt_bkt_cnt_default( ULONG_MAX ) );
+  FD_TEST( fd_tcache_bkt_footprint( 2UL*BKT_CNT, 0UL )==FD_TCACHE_BKT_FOOTPRINT( BKT_CNT ) );
+  FD_TEST( fd_tcache_bkt_footprint( 1UL, BKT_CNT )==sizeof(tcache_mem) );
+
+  FD_TEST( !fd_tcache_bkt_new( NULL,         1UL, BKT_CNT ) );
+  FD_TEST( !fd_tcache_bkt_new( tcache_mem+1, 1UL, BKT_CNT ) );
+  FD_TEST( !fd_tcache_bkt_new( tcache_mem,   0UL, BKT_CNT ) );
+  FD_TEST( !fd_tcache_bkt_join( tcache_mem ) ); /* bad magic */
+
+  void *            _tcache = fd_tcache_bkt_new( tcache_mem, 2UL*BKT_CNT, BKT_CNT ); FD_TEST( _tcache==tcache_mem );
+  fd_tcache_bkt_t * tcache  = fd_tcache_bkt_join( _tcache );                          FD_TEST( tcache );
+
+  FD_TEST( fd_tcache_bkt_depth  ( tcache )==2UL*BKT_CNT );
+  FD_TEST( fd_tcache_bkt_bkt_cnt( tcache )==BKT_CNT     );
+  ulong * bkt = fd_tcache_bkt_bkt_laddr( tcache );
+  FD_TEST( fd_ulong_is_aligned( (ulong)bkt, 64UL ) );
+  for( ulong i=0UL; i<BKT_CNT*FD_TCACHE_BKT_WIDTH; i++ ) FD_TEST( fd_tcache_tag_is_null( bkt[i] ) );
+
+  FD_LOG_NOTICE(( "Testing insert / query" ));
+
+  for( ulong seq=0UL; seq<2UL*BKT_CNT; seq++ ) {
+    ulong tag = fd_ulong_hash( seq + 1UL ); /* Assumes FD_TCACHE_TAG_NULL is zero, hash is perm and hash(0) is 0 */
+    FD_TEST( !fd_tcache_bkt_query ( bkt, BKT_CNT, tag ) );
+    FD_TEST( !fd_tcache_bkt_insert( bkt, BKT_CNT, tag ) );
+    FD_TEST(  fd_tcache_bkt_query ( bkt, BKT_CNT, tag ) );
+    FD_TEST(  fd_tcache_bkt_insert( bkt, BKT_CNT, tag ) );
+    FD_TEST( fd_tcache_bkt_line( bkt, BKT_CNT, tag )[0]==tag );
+  }
+
+  FD_LOG_NOTICE(( "Testing eviction" ));
+
+  /* Tags in the same bucket are evicted oldest first, other buckets
+     are unaffected */
+
+  fd_tcache_bkt_reset( bkt, BKT_CNT );
+  FD_TEST( !fd_tcache_bkt_insert( bkt, BKT_CNT, BKT_CNT+1UL ) );
+  for( ulong i=1UL; i<=FD_TCACHE_BKT_WIDTH+3UL; i++ ) {
+    FD_TEST( !fd_tcache_bkt_insert( bkt, BKT_CNT, i*BKT_CNT ) );
+    for( ulong j=1UL; j<=i; j++ ) FD_TEST( fd_tcache_bkt_query( bkt, BKT_CNT, j*BKT_CNT )==(i-j<FD_TCACHE_BKT_WIDTH) );
+    FD_TEST( fd_tcache_bkt_query( bkt, BKT_CNT, BKT_CNT+1UL ) );
+  }
+
+  FD_LOG_NOTICE(( "Testing reset" ));
+
+  fd_tcache_bkt_reset( bkt, BKT_CNT );
+  for( ulong seq=0UL; seq<2UL*BKT_CNT; seq++ ) FD_TEST( !fd_tcache_bkt_query( bkt, BKT_CNT, fd_ulong_hash( seq + 1UL ) ) );
+
+  FD_LOG_NOTICE(( "Testing against reference" ));
+
+  for( ulong iter=0UL; iter<1000000UL; iter++ ) {
+    ulong tag;
+    if( (fd_rng_uint( rng ) & 1U) ) { /* Recent tag (possibly evicted) */
+      ulong b = fd_rng_ulong_roll( rng, BKT_CNT );
+      tag = ref[ b ][ fd_rng_ulong_roll( rng, FD_TCACHE_BKT_WIDTH ) ];
+      if( fd_tcache_tag_is_null( tag ) ) tag = BKT_CNT + b;
+      tag += (ulong)(fd_rng_uint( rng ) & 1U)*BKT_CNT*FD_TCACHE_BKT_WIDTH; /* Sometimes a bucket conflict */
+    } else {
+      do tag = fd_rng_ulong( rng ); while( FD_UNLIKELY( fd_tcache_tag_is_null( tag ) ) );
+    }
+    int dup = ref_insert( tag );
+    FD_TEST( fd_tcache_bkt_query ( bkt, BKT_CNT, tag )==dup );
+    FD_TEST( fd_tcache_bkt_insert( bkt, BKT_CNT, tag )==dup );
+  }
+  FD_TEST( !memcmp( bkt, ref, sizeof(ref) ) );
+
+  FD_TEST( !fd_tcache_bkt_leave( NULL ) );
+  FD_TEST( fd_tcache_bkt_leave( tcache )==_tcache );
+  FD_TEST( !fd_tcache_bkt_delete( NULL ) );
+  FD_TEST( fd_tcache_bkt_delete( _tcache )==tcache_mem );
+  FD_TEST( !fd_tcache_bkt_join( tcache_mem ) );
+
+  /* Benchmark against fd_tcache with the same depth.  Duplicates are
+     drawn like test_tcache. */
+
+  ulong cpu_idx = fd_tile_cpu_id( fd_tile_idx() );
+  if( cpu_idx>fd_shmem_cpu_cnt() ) cpu_idx = 0UL;
+
+  char const * _page_sz    = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",     NULL, "gigantic"                   );
+  ulong        page_cnt    = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",    NULL, 1UL                          );
+  ulong        numa_idx    = fd_env_strip_cmdline_ulong( &argc, &argv, "--numa-idx",    NULL, fd_shmem_numa_idx( cpu_idx ) );
+  ulong        depth       = fd_env_strip_cmdline_ulong( &argc, &argv, "--depth",       NULL, (1UL<<22)-2UL );
+  float        dup_frac    = fd_env_strip_cmdline_float( &argc, &argv, "--dup-frac",    NULL, 0.5f          );
+  float        dup_avg_age = fd_env_strip_cmdline_float( &argc, &argv, "--dup-avg-age", NULL, 1.f           );
+
+  FD_LOG_NOTICE(( "Creating workspace (--page-cnt %lu, --page-sz %s, --numa-idx %lu)", page_cnt, _page_sz, numa_idx ));
+  fd_wksp_t * wksp =
+    fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, fd_shmem_cpu_idx( numa_idx ), "wksp", 0UL );
+  FD_TEST( wksp );
+
+  ulong   bkt_cnt   = fd_tcache_bkt_bkt_cnt_default( depth );
+  ulong   map_cnt   = fd_tcache_map_cnt_default( depth );
+  ulong   bench_cnt = 1UL<<20;
+  void *  mem_bkt   = fd_wksp_alloc_laddr( wksp, fd_tcache_bkt_align(), fd_tcache_bkt_footprint( depth, 0UL ), 1UL );
+  void *  mem_map   = fd_wksp_alloc_laddr( wksp, fd_tcache_align(),     fd_tcache_footprint    ( depth, 0UL ), 1UL );
+  ulong * bench_tag = (ulong *)fd_wksp_alloc_laddr( wksp, 0UL, bench_cnt*sizeof(ulong), 1UL );
+  if( FD_UNLIKELY( !mem_bkt || !mem_map || !bench_tag ) ) FD_LOG_ERR(( "workspace too small for --depth %lu", depth ));
+
+  FD_LOG_NOTICE(( "Benchmarking (--depth %lu, bkt_cnt %lu, map_cnt %lu, --dup-frac %e, --dup-avg-age %e)",
+                  depth, bkt_cnt, map_cnt, (double)dup_frac, (double)dup_avg_age ));
+
+  fd_tcache_bkt_t * tb = fd_tcache_bkt_join( fd_tcache_bkt_new( mem_bkt, depth, 0UL ) ); FD_TEST( tb );
+  fd_tcache_t *     tm = fd_tcache_join    ( fd_tcache_new    ( mem_map, depth, 0UL ) ); FD_TEST( tm );
+  ulong * bb     = fd_tcache_bkt_bkt_laddr( tb );
+  ulong * ring   = fd_tcache_ring_laddr( tm );
+  ulong * map    = fd_tcache_map_laddr ( tm );
+  ulong   oldest = fd_tcache_oldest_laddr( tm )[0];
+
+  uint dup_thresh = (uint)(0.5f + dup_frac*(float)(1UL<<32));
+  for( ulong iter=0UL; iter<10UL; iter++ ) {
+
+    for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
+      ulong tag;
+      int is_dup = (fd_rng_uint( rng ) < dup_thresh);
+      if( is_dup ) {
+        ulong age = (ulong)(uint)(int)(1.0f + dup_avg_age*fd_rng_float_exp( rng ));
+        if( FD_UNLIKELY( age>=bench_idx ) ) is_dup = 0;
+        else                                tag = bench_tag[ bench_idx - age ];
+      }
+      if( !is_dup ) do tag = fd_rng_ulong( rng ); while( FD_UNLIKELY( fd_tcache_tag_is_null( tag ) ) );
+      bench_tag[ bench_idx ] = tag;
+    }
+
+    ulong dup_bkt = 0UL;
+    long  tic     = fd_log_wallclock();
+    for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) dup_bkt += (ulong)fd_tcache_bkt_insert( bb, bkt_cnt, bench_tag[ bench_idx ] );
+    long  toc     = fd_log_wallclock();
+    float avg_bkt = ((float)(toc-tic))/((float)bench_cnt);
+
+    ulong dup_map = 0UL;
+    tic = fd_log_wallclock();
+    for( ulong bench_idx=0UL; bench_idx<bench_cnt; bench_idx++ ) {
+      int dup;
+      FD_TCACHE_INSERT( dup, oldest, ring, depth, map, map_cnt, bench_tag[ bench_idx ] );
+      dup_map += (ulong)dup;
+    }
+    toc = fd_log_wallclock();
+    float avg_map = ((float)(toc-tic))/((float)bench_cnt);
+
+    FD_LOG_NOTICE(( "iter %lu: bkt %.3f ns/dedup (%lu dup), map %.3f ns/dedup (%lu dup)",
+                    iter, (double)avg_bkt, dup_bkt, (double)avg_map, dup_map ));
+  }
+
+  FD_LOG_NOTICE(( "Cleaning up" ));
+
+  FD_TEST( fd_tcache_delete    ( fd_tcache_leave    ( tm ) )==mem_map );
+  FD_TEST( fd_tcache_bkt_delete( fd_tcache_bkt_leave( tb ) )==mem_bkt );
+  fd_wksp_free_laddr( bench_tag );
+  fd_wksp_free_laddr( mem_map   );
+  fd_wksp_free_laddr( mem_bkt   );
+  fd_wksp_delete_anonymous( wksp );
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif
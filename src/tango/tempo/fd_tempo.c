@@ -1,5 +1,11 @@
 #include "../fd_tango.h"
 
+#include <time.h>
+
+#if FD_HAS_X86
+#include <cpuid.h>
+#endif
+
 #if FD_HAS_DOUBLE
 
 double
@@ -163,6 +169,32 @@ fd_tempo_tick_per_ns( double * opt_sigma ) {
   return mu;
 }
 
+
+fd_tempo_idle_t *
+fd_tempo_idle_init( fd_tempo_idle_t * idle,
+                    ulong             spin_max,
+                    long              wake_ns,
+                    int               flags ) {
+
+  if( FD_UNLIKELY( !idle ) ) {
+    FD_LOG_WARNING(( "NULL idle" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( wake_ns<0L ) ) {
+    FD_LOG_WARNING(( "bad wake_ns %li", wake_ns ));
+    return NULL;
+  }
+
+  idle->wake_ns  = wake_ns;
+  idle->wake_max = wake_ns ? fd_long_max( (long)(fd_tempo_tick_per_ns( NULL )*(double)wake_ns), 1L ) : 0L;
+  idle->spin_max = wake_ns ? spin_max : ULONG_MAX;
+  idle->waitpkg  = !(flags & FD_TEMPO_IDLE_FLAG_NO_WAITPKG) && fd_tempo_idle_waitpkg();
+  idle->sleep    = !!(flags & FD_TEMPO_IDLE_FLAG_SLEEP);
+  fd_tempo_idle_busy( idle );
+  return idle;
+}
+
 #endif
 
 long
@@ -288,3 +320,70 @@ fd_tempo_async_min( long  lazy,
   return 1UL << fd_ulong_find_msb( async_target ); /* guaranteed power of 2 in [1,2^31] */
 }
 
+FD_FN_PURE int
+fd_tempo_idle_waitpkg( void ) {
+#if FD_HAS_X86
+  uint eax, ebx, ecx, edx;
+  if( FD_UNLIKELY( !__get_cpuid_count( 7U, 0U, &eax, &ebx, &ecx, &edx ) ) ) return 0;
+  return (int)((ecx>>5) & 1U); /* CPUID.(EAX=07H,ECX=0):ECX[bit 5] */
+#else
+  return 0;
+#endif
+}
+
+#if FD_HAS_X86
+
+/* The WAITPKG instructions are emitted as raw bytes so this builds with
+   assemblers and target flags that don't know about them.  The
+   deadline is a TSC value in edx:eax.  ecx==0 requests the C0.2
+   sub-state (lower power, slightly slower wake than C0.1). */
+
+static inline void
+fd_tempo_idle_private_umwait( void const * mline,
+                              ulong        deadline ) {
+  __asm__ __volatile__( ".byte 0xf3, 0x0f, 0xae, 0xf0" /* umonitor %rax */
+                        :: "a"(mline) : "memory" );
+  __asm__ __volatile__( ".byte 0xf2, 0x0f, 0xae, 0xf1" /* umwait %ecx */
+                        :: "c"(0U), "a"((uint)deadline), "d"((uint)(deadline>>32)) : "cc", "memory" );
+}
+
+static inline void
+fd_tempo_idle_private_tpause( ulong deadline ) {
+  __asm__ __volatile__( ".byte 0x66, 0x0f, 0xae, 0xf1" /* tpause %ecx */
+                        :: "c"(0U), "a"((uint)deadline), "d"((uint)(deadline>>32)) : "cc", "memory" );
+}
+
+#endif
+
+void
+fd_tempo_idle_private_wait( fd_tempo_idle_t * idle,
+                            void const *      mline ) {
+  long wait = idle->wait;
+  idle->wait = fd_long_min( wait<<1, idle->wake_max );
+
+  long deadline = fd_tickcount() + wait;
+
+#if FD_HAS_X86
+  if( FD_LIKELY( idle->waitpkg ) ) {
+    /* UMWAIT can return early (the monitored line was written, an
+       interrupt, or the OS limit on the wait).  That is fine, the
+       caller polls again. */
+    if( FD_LIKELY( mline ) ) fd_tempo_idle_private_umwait( mline, (ulong)deadline );
+    else                     fd_tempo_idle_private_tpause( (ulong)deadline );
+    return;
+  }
+#else
+  (void)mline;
+#endif
+
+  if( FD_UNLIKELY( idle->sleep && wait>=idle->wake_max ) ) {
+    /* Called directly with these exact arguments (rather than through
+       fd_log_sleep / nanosleep) so it matches the clock_nanosleep rule
+       in the tile seccomp policies. */
+    struct timespec ts = { .tv_sec = idle->wake_ns / (long)1e9, .tv_nsec = idle->wake_ns % (long)1e9 };
+    clock_nanosleep( CLOCK_REALTIME, 0, &ts, NULL );
+    return;
+  }
+
+  while( fd_tickcount()<deadline ) FD_SPIN_PAUSE();
+}
@@ -5,6 +5,53 @@
 
 #include "../fd_tango_base.h"
 
+/* fd_tempo_idle_t is an adaptive idle policy for a polling run loop
+   (e.g. a stem tile that is usually caught up on its ins).  The loop
+   reports every poll that found nothing to do with fd_tempo_idle_empty
+   and every poll that did work with fd_tempo_idle_busy.  For the first
+   spin_max consecutive empty polls, fd_tempo_idle_empty returns
+   immediately (i.e. the loop busy spins as usual so a burst of traffic
+   is picked up with no added latency).  After that, each empty poll
+   waits for an exponentially increasing interval capped at wake_max
+   ticks before returning, so an idle loop backs off to roughly one poll
+   per wake_max ticks.  The wait is, in order of preference:
+
+   - UMONITOR/UMWAIT on the cache line the caller expects the next
+     producer write to (typically the mcache line of the next frag), if
+     the CPU supports WAITPKG.  This wakes as soon as the line is
+     written (or at the deadline, or earlier if the kernel's
+     IA32_UMWAIT_CONTROL limit is hit).  TPAUSE is used if there is no
+     line to monitor.  Both put the core in a light C0 sub-state that
+     frees resources for the hyperthread sibling.
+
+   - If the caller allowed sleeping (FD_TEMPO_IDLE_FLAG_SLEEP) and the
+     backoff has reached wake_max, the thread sleeps in the kernel for
+     wake_ns (the wake latency then also includes the kernel wakeup and
+     the thread's timer slack, typically tens of microseconds).  The
+     caller's sandbox must allow
+     clock_nanosleep( CLOCK_REALTIME, 0, ts, NULL ).
+
+   - Otherwise, FD_SPIN_PAUSE until the deadline.
+
+   wake_ns==0 disables the policy (fd_tempo_idle_empty never waits). */
+
+#define FD_TEMPO_IDLE_FLAG_SLEEP       (1) /* allowed to sleep in the kernel once fully backed off */
+#define FD_TEMPO_IDLE_FLAG_NO_WAITPKG  (2) /* don't use UMWAIT/TPAUSE even if supported */
+
+#define FD_TEMPO_IDLE_WAIT_MIN (256L) /* initial backoff wait in ticks */
+
+struct fd_tempo_idle {
+  ulong empty_cnt; /* number of consecutive empty polls */
+  ulong spin_max;  /* number of consecutive empty polls to busy spin for before backing off, ULONG_MAX if disabled */
+  long  wait;      /* current backoff wait in ticks, in [FD_TEMPO_IDLE_WAIT_MIN,wake_max] (or wake_max if smaller) */
+  long  wake_max;  /* max backoff wait in ticks (wake_ns converted to ticks) */
+  long  wake_ns;   /* max backoff wait in ns */
+  int   waitpkg;   /* use UMONITOR/UMWAIT/TPAUSE */
+  int   sleep;     /* allowed to sleep in the kernel */
+};
+
+typedef struct fd_tempo_idle fd_tempo_idle_t;
+
 FD_PROTOTYPES_BEGIN
 
 /* fd_tempo_wallclock_model returns an estimate of t0, the minimum cost
@@ -203,6 +250,52 @@ fd_tempo_async_reload( fd_rng_t * rng,
   return async_min + (((ulong)fd_rng_uint( rng )) & (async_min-1UL));
 }
 
+/* fd_tempo_idle_waitpkg returns 1 if the CPU supports the WAITPKG
+   instructions (UMONITOR, UMWAIT, TPAUSE) and 0 otherwise. */
+
+FD_FN_PURE int
+fd_tempo_idle_waitpkg( void );
+
+/* fd_tempo_idle_init initializes idle to spin for spin_max consecutive
+   empty polls and then back off with a wait of at most wake_ns ns per
+   empty poll (wake_ns==0 disables backing off).  flags is a bit-or of
+   FD_TEMPO_IDLE_FLAG_*.  Returns idle on success and NULL on failure
+   (logs details).  Reasons for failure include NULL idle and negative
+   wake_ns. */
+
+fd_tempo_idle_t *
+fd_tempo_idle_init( fd_tempo_idle_t * idle,
+                    ulong             spin_max,
+                    long              wake_ns,
+                    int               flags );
+
+/* fd_tempo_idle_busy notes that the last poll did work.  This resets
+   the backoff. */
+
+static inline void
+fd_tempo_idle_busy( fd_tempo_idle_t * idle ) {
+  idle->empty_cnt = 0UL;
+  idle->wait      = fd_long_min( FD_TEMPO_IDLE_WAIT_MIN, idle->wake_max );
+}
+
+/* fd_tempo_idle_empty notes that the last poll found nothing to do and
+   waits as described above.  mline is the address whose write should
+   end the wait early (NULL if none).  fd_tempo_idle_private_wait is the
+   slow path. */
+
+void
+fd_tempo_idle_private_wait( fd_tempo_idle_t * idle,
+                            void const *      mline );
+
+static inline void
+fd_tempo_idle_empty( fd_tempo_idle_t * idle,
+                     void const *      mline ) {
+  ulong empty_cnt = idle->empty_cnt + 1UL;
+  idle->empty_cnt = empty_cnt;
+  if( FD_LIKELY( empty_cnt<=idle->spin_max ) ) return;
+  fd_tempo_idle_private_wait( idle, mline );
+}
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_tango_tempo_fd_tempo_h */
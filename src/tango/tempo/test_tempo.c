@@ -1,5 +1,7 @@
 #include "../fd_tango.h"
 
+#include <sys/resource.h>
+
 int
 main( int     argc,
       char ** argv ) {
@@ -99,6 +101,69 @@ main( int     argc,
     FD_TEST( async_rem< 2UL*async_min );
   }
 
+  /* Idle backoff */
+
+  fd_tempo_idle_t idle[1];
+  FD_TEST( !fd_tempo_idle_init( NULL, 0UL,  1000L, 0 ) );
+  FD_TEST( !fd_tempo_idle_init( idle, 0UL, -1L,    0 ) );
+
+  FD_TEST( fd_tempo_idle_init( idle, 3UL, 0L, 0 )==idle ); /* disabled */
+  FD_TEST( idle->spin_max==ULONG_MAX );
+  for( ulong iter=0UL; iter<1000UL; iter++ ) fd_tempo_idle_empty( idle, NULL );
+  FD_TEST( idle->empty_cnt==1000UL );
+
+  FD_LOG_NOTICE(( "waitpkg %i", fd_tempo_idle_waitpkg() ));
+
+  static ulong mline[ 8 ] __attribute__((aligned(64)));
+  for( int flags=0; flags<4; flags++ ) {
+    FD_TEST( fd_tempo_idle_init( idle, 3UL, 20000L, flags )==idle );
+    FD_TEST( idle->spin_max==3UL );
+    FD_TEST( idle->wake_max>0L   );
+    FD_TEST( idle->sleep  ==(flags & FD_TEMPO_IDLE_FLAG_SLEEP) );
+    FD_TEST( idle->waitpkg==( (flags & FD_TEMPO_IDLE_FLAG_NO_WAITPKG) ? 0 : fd_tempo_idle_waitpkg() ) );
+
+    /* spin_max empty polls return immediately, then the wait doubles
+       up to wake_max */
+
+    for( ulong iter=0UL; iter<3UL; iter++ ) fd_tempo_idle_empty( idle, mline );
+    FD_TEST( idle->wait==fd_long_min( FD_TEMPO_IDLE_WAIT_MIN, idle->wake_max ) );
+    long wait = idle->wait;
+    for( ulong iter=0UL; iter<64UL; iter++ ) {
+      fd_tempo_idle_empty( idle, (iter & 1UL) ? mline : NULL );
+      wait = fd_long_min( wait<<1, idle->wake_max );
+      FD_TEST( idle->wait==wait );
+    }
+    FD_TEST( idle->wait==idle->wake_max );
+    FD_TEST( idle->empty_cnt==67UL );
+
+    /* Fully backed off wait is bounded by wake_ns (plus slop for
+       sleep / scheduling) */
+
+    if( !idle->waitpkg && !idle->sleep ) {
+      long tic = fd_log_wallclock();
+      fd_tempo_idle_empty( idle, mline );
+      long toc = fd_log_wallclock();
+      FD_TEST( toc-tic>=10000L ); /* at least ~wake_ns, allowing for tick_per_ns estimation error */
+    }
+
+    /* Without WAITPKG, a sleeping idle gives up the core (voluntary
+       context switch) for wake_ns once fully backed off */
+
+    if( !idle->waitpkg && idle->sleep ) {
+      struct rusage ru0[1]; FD_TEST( !getrusage( RUSAGE_SELF, ru0 ) );
+      long tic = fd_log_wallclock();
+      for( ulong iter=0UL; iter<4UL; iter++ ) fd_tempo_idle_empty( idle, mline );
+      long toc = fd_log_wallclock();
+      struct rusage ru1[1]; FD_TEST( !getrusage( RUSAGE_SELF, ru1 ) );
+      FD_TEST( toc-tic>=4L*20000L );
+      FD_TEST( ru1->ru_nvcsw-ru0->ru_nvcsw>=4L );
+    }
+
+    fd_tempo_idle_busy( idle );
+    FD_TEST( !idle->empty_cnt );
+    FD_TEST( idle->wait==fd_long_min( FD_TEMPO_IDLE_WAIT_MIN, idle->wake_max ) );
+  }
+
   fd_rng_delete( fd_rng_leave( rng ) );
 
   FD_LOG_NOTICE(( "pass" ));
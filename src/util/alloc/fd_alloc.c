@@ -192,8 +192,19 @@ struct __attribute__((aligned(FD_ALLOC_ALIGN))) fd_alloc {
   /* Padding to 128 byte alignment here */
 
   fd_alloc_vgaddr_t inactive_stack[ FD_ALLOC_SIZECLASS_CNT ] __attribute__((aligned(128UL)));
+
+  /* cas_retry_cnt[ sizeclass ] is the number of times an inactive
+     stack operation for sizeclass had to retry due to contention.  This
+     lives in what was previously zero padding at the end of the alloc
+     (fd_alloc_new clears the whole footprint) so allocs created before
+     this field existed read as having no retries and the layout (and
+     thus FD_ALLOC_MAGIC) is unchanged. */
+
+  ulong cas_retry_cnt[ FD_ALLOC_SIZECLASS_CNT ] __attribute__((aligned(128UL)));
 };
 
+FD_STATIC_ASSERT( sizeof(fd_alloc_t)==FD_ALLOC_FOOTPRINT, layout );
+
 /* fd_alloc_private_wksp returns the wksp backing alloc.  Assumes alloc
    is a non-NULL pointer in the caller's address space to the fd_alloc
    (not a join handle). */
@@ -223,15 +234,34 @@ fd_alloc_private_active_slot_replace( ulong * active_slot,
   return old_superblock_gaddr;
 }
 
+/* fd_alloc_private_retry_cnt_inc increments the contention counter
+   pointed to by retry_cnt.  This is only called on CAS failure (which
+   implies the inactive stack is contended) and thus is off the fast
+   path.  The increment is atomic if FD_HAS_ATOMIC as other threads can
+   be simultaneously retrying on the same sizeclass. */
+
+static inline void
+fd_alloc_private_retry_cnt_inc( ulong * retry_cnt ) {
+# if FD_HAS_ATOMIC
+  FD_ATOMIC_FETCH_AND_ADD( retry_cnt, 1UL );
+# else
+  FD_VOLATILE( *retry_cnt ) = FD_VOLATILE_CONST( *retry_cnt ) + 1UL;
+# endif
+}
+
 /* fd_alloc_private_inactive_stack_push pushes superblock at the
    workspace global address superblock_gaddr in workspace wksp onto the
    stack inactive stack.  This is a compiler fence.  If FD_HAS_ATOMIC,
-   this will be done atomically. */
+   this will be done atomically.  Each failed CAS attempt due to
+   contention is counted in *retry_cnt (this is only touched in the
+   contended case to keep the uncontended fast path free of additional
+   atomics). */
 
 static inline void
 fd_alloc_private_inactive_stack_push( fd_alloc_vgaddr_t * inactive_stack,
                                       fd_wksp_t *         wksp,
-                                      ulong               superblock_gaddr ) {
+                                      ulong               superblock_gaddr,
+                                      ulong *             retry_cnt ) {
   fd_alloc_superblock_t * superblock = (fd_alloc_superblock_t *)fd_wksp_laddr_fast( wksp, superblock_gaddr );
 
   for(;;) {
@@ -262,6 +292,7 @@ fd_alloc_private_inactive_stack_push( fd_alloc_vgaddr_t * inactive_stack,
 
     /* Hmmm ... that failed ... try again */
 
+    fd_alloc_private_retry_cnt_inc( retry_cnt );
     FD_SPIN_PAUSE();
   }
 
@@ -272,11 +303,13 @@ fd_alloc_private_inactive_stack_push( fd_alloc_vgaddr_t * inactive_stack,
    the inactive stack.  Returns the non-zero wksp superblock gaddr of
    the popped stack top on success or 0 on failure (i.e. inactive stack
    is empty).  This is a compiler fence.  If FD_HAS_ATOMIC, this will be
-   done atomically. */
+   done atomically.  Contention retries are counted in *retry_cnt as
+   described in push above. */
 
 static inline ulong
 fd_alloc_private_inactive_stack_pop( fd_alloc_vgaddr_t * inactive_stack,
-                                     fd_wksp_t *         wksp ) {
+                                     fd_wksp_t *         wksp,
+                                     ulong *             retry_cnt ) {
   ulong top_gaddr;
 
   for(;;) {
@@ -312,6 +345,7 @@ fd_alloc_private_inactive_stack_pop( fd_alloc_vgaddr_t * inactive_stack,
 
     /* Hmmm ... that failed ... try again */
 
+    fd_alloc_private_retry_cnt_inc( retry_cnt );
     FD_SPIN_PAUSE();
   }
 
@@ -577,7 +611,7 @@ fd_alloc_delete( void * shalloc ) {
 
     fd_alloc_vgaddr_t * inactive_stack = alloc->inactive_stack + sizeclass;
     for(;;) {
-      ulong superblock_gaddr = fd_alloc_private_inactive_stack_pop( inactive_stack, wksp );
+      ulong superblock_gaddr = fd_alloc_private_inactive_stack_pop( inactive_stack, wksp, alloc->cas_retry_cnt + sizeclass );
       if( FD_LIKELY( !superblock_gaddr ) ) break;
       fd_alloc_free( alloc, (fd_alloc_superblock_t *)fd_wksp_laddr_fast( wksp, superblock_gaddr ) );
     }
@@ -704,7 +738,7 @@ fd_alloc_malloc_at_least( fd_alloc_t * join,
 
   if( FD_UNLIKELY( !superblock_gaddr ) ) {
 
-    superblock_gaddr = fd_alloc_private_inactive_stack_pop( alloc->inactive_stack + sizeclass, wksp );
+    superblock_gaddr = fd_alloc_private_inactive_stack_pop( alloc->inactive_stack + sizeclass, wksp, alloc->cas_retry_cnt + sizeclass );
 
     if( FD_UNLIKELY( !superblock_gaddr ) ) {
 
@@ -818,7 +852,7 @@ fd_alloc_malloc_at_least( fd_alloc_t * join,
        block. */
 
     if( FD_UNLIKELY( displaced_superblock_gaddr ) )
-      fd_alloc_private_inactive_stack_push( alloc->inactive_stack + sizeclass, wksp, displaced_superblock_gaddr );
+      fd_alloc_private_inactive_stack_push( alloc->inactive_stack + sizeclass, wksp, displaced_superblock_gaddr, alloc->cas_retry_cnt + sizeclass );
 
   } //else {
 
@@ -1007,7 +1041,7 @@ fd_alloc_free( fd_alloc_t * join,
        because the superblock was not in circulation before). */
 
     if( FD_UNLIKELY( displaced_superblock_gaddr ) )
-      fd_alloc_private_inactive_stack_push( alloc->inactive_stack + sizeclass, wksp, displaced_superblock_gaddr );
+      fd_alloc_private_inactive_stack_push( alloc->inactive_stack + sizeclass, wksp, displaced_superblock_gaddr, alloc->cas_retry_cnt + sizeclass );
     return;
   }
 
@@ -1070,7 +1104,7 @@ fd_alloc_free( fd_alloc_t * join,
        timescale.) */
 
     fd_wksp_t * wksp                     = fd_alloc_private_wksp( alloc );
-    ulong       deletion_candidate_gaddr = fd_alloc_private_inactive_stack_pop( alloc->inactive_stack + sizeclass, wksp );
+    ulong       deletion_candidate_gaddr = fd_alloc_private_inactive_stack_pop( alloc->inactive_stack + sizeclass, wksp, alloc->cas_retry_cnt + sizeclass );
 
     if( FD_UNLIKELY( !deletion_candidate_gaddr ) ) return; /* No deletion_candidate, unclear branch prob */
 
@@ -1084,7 +1118,7 @@ fd_alloc_free( fd_alloc_t * join,
     if( FD_UNLIKELY( fd_alloc_block_set_cnt( deletion_candidate_free_blocks )==block_cnt ) ) /* Candidate empty -> delete it */
       fd_alloc_free( join, deletion_candidate );
     else /* Candidate not empty -> return it to circulation */
-      fd_alloc_private_inactive_stack_push( alloc->inactive_stack + sizeclass, wksp, deletion_candidate_gaddr );
+      fd_alloc_private_inactive_stack_push( alloc->inactive_stack + sizeclass, wksp, deletion_candidate_gaddr, alloc->cas_retry_cnt + sizeclass );
 
     return;
   }
@@ -1112,6 +1146,7 @@ fd_alloc_compact( fd_alloc_t * join ) {
     ulong               block_cnt      = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].block_cnt;
     ulong               cgroup_cnt     = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].cgroup_mask + 1UL;
     fd_alloc_vgaddr_t * inactive_stack = alloc->inactive_stack + sizeclass;
+    ulong *             retry_cnt      = alloc->cas_retry_cnt  + sizeclass;
 
     /* For each active superblock in this sizeclass */
 
@@ -1143,7 +1178,7 @@ fd_alloc_compact( fd_alloc_t * join ) {
       else {
         ulong displaced_superblock_gaddr = fd_alloc_private_active_slot_replace( active_slot, superblock_gaddr );
         if( FD_UNLIKELY( displaced_superblock_gaddr ) )
-          fd_alloc_private_inactive_stack_push( inactive_stack, wksp, displaced_superblock_gaddr );
+          fd_alloc_private_inactive_stack_push( inactive_stack, wksp, displaced_superblock_gaddr, retry_cnt );
       }
     }
 
@@ -1160,23 +1195,25 @@ fd_alloc_compact( fd_alloc_t * join ) {
        this mostly diagnostic / teardown oriented use case. */
 
     fd_alloc_vgaddr_t local_stack[1];
+    ulong             local_retry_cnt[1];
 
-    local_stack[0] = fd_alloc_vgaddr( 0UL, 0UL );
+    local_stack[0]     = fd_alloc_vgaddr( 0UL, 0UL );
+    local_retry_cnt[0] = 0UL;
 
     for(;;) {
-      ulong superblock_gaddr = fd_alloc_private_inactive_stack_pop( inactive_stack, wksp );
+      ulong superblock_gaddr = fd_alloc_private_inactive_stack_pop( inactive_stack, wksp, retry_cnt );
       if( !superblock_gaddr ) break; /* application dependent branch prob */
       fd_alloc_superblock_t * superblock = (fd_alloc_superblock_t *)fd_wksp_laddr_fast( wksp, superblock_gaddr );
 
       if( fd_alloc_block_set_cnt( superblock->free_blocks )==block_cnt ) fd_alloc_free( join, superblock );
-      else fd_alloc_private_inactive_stack_push( local_stack, wksp, superblock_gaddr );
+      else fd_alloc_private_inactive_stack_push( local_stack, wksp, superblock_gaddr, local_retry_cnt );
     }
 
     for(;;) {
-      ulong superblock_gaddr = fd_alloc_private_inactive_stack_pop( local_stack, wksp );
+      ulong superblock_gaddr = fd_alloc_private_inactive_stack_pop( local_stack, wksp, local_retry_cnt );
       if( !superblock_gaddr ) break; /* application dependent branch prob */
 
-      fd_alloc_private_inactive_stack_push( inactive_stack, wksp, superblock_gaddr );
+      fd_alloc_private_inactive_stack_push( inactive_stack, wksp, superblock_gaddr, retry_cnt );
     }
   }
 }
@@ -1220,6 +1257,334 @@ fd_alloc_is_empty( fd_alloc_t * join ) {
   return i==part_max;
 }
 
+ulong
+fd_alloc_sizeclass_cnt( void ) {
+  return FD_ALLOC_SIZECLASS_CNT;
+}
+
+fd_alloc_sizeclass_stat_t *
+fd_alloc_sizeclass_query( fd_alloc_t *                join,
+                          ulong                       sizeclass,
+                          fd_alloc_sizeclass_stat_t * stat ) {
+  fd_alloc_t * alloc = fd_alloc_private_join_alloc( join );
+  if( FD_UNLIKELY( (!alloc) | (!stat) | (sizeclass>=FD_ALLOC_SIZECLASS_CNT) ) ) return NULL;
+
+  fd_wksp_t * wksp = fd_alloc_private_wksp( alloc );
+
+  ulong block_cnt            = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].block_cnt;
+  ulong superblock_footprint = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].superblock_footprint;
+  ulong cgroup_cnt           = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].cgroup_mask + 1UL;
+
+  ulong superblock_cnt = 0UL;
+  ulong free_block_cnt = 0UL;
+
+  /* Active superblocks */
+
+  for( ulong cgroup_idx=0UL; cgroup_idx<cgroup_cnt; cgroup_idx++ ) {
+    ulong superblock_gaddr = FD_VOLATILE_CONST( alloc->active_slot[ sizeclass + FD_ALLOC_SIZECLASS_CNT*cgroup_idx ] );
+    if( !superblock_gaddr ) continue;
+    fd_alloc_superblock_t * superblock = (fd_alloc_superblock_t *)fd_wksp_laddr_fast( wksp, superblock_gaddr );
+    superblock_cnt++;
+    free_block_cnt += fd_alloc_block_set_cnt( FD_VOLATILE_CONST( superblock->free_blocks ) );
+  }
+
+  /* Inactive superblocks.  The walk is bounded by the number of
+     superblocks that could possibly fit in the wksp so that a
+     concurrent modification cannot trap us in a cycle. */
+
+  ulong superblock_max   = wksp->data_max / superblock_footprint + 1UL;
+  ulong superblock_gaddr = (ulong)fd_alloc_vgaddr_off( FD_VOLATILE_CONST( alloc->inactive_stack[ sizeclass ] ) );
+  for( ulong rem=superblock_max; superblock_gaddr && rem; rem-- ) {
+    fd_alloc_superblock_t * superblock = (fd_alloc_superblock_t *)fd_wksp_laddr_fast( wksp, superblock_gaddr );
+    superblock_cnt++;
+    free_block_cnt  += fd_alloc_block_set_cnt( FD_VOLATILE_CONST( superblock->free_blocks ) );
+    superblock_gaddr = FD_VOLATILE_CONST( superblock->next_gaddr );
+  }
+
+  stat->block_footprint      = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].block_footprint;
+  stat->superblock_footprint = superblock_footprint;
+  stat->superblock_cnt       = superblock_cnt;
+  stat->block_cnt            = superblock_cnt*block_cnt;
+  stat->free_block_cnt       = fd_ulong_min( free_block_cnt, superblock_cnt*block_cnt );
+  stat->cas_retry_cnt        = FD_VOLATILE_CONST( alloc->cas_retry_cnt[ sizeclass ] );
+  return stat;
+}
+
+/* fd_alloc_mag *******************************************************/
+
+#define FD_ALLOC_MAG_MAGIC (0xF17EDA2C37A11A90UL) /* FIRE DANCER ALLOC MAG version 0 */
+
+struct fd_alloc_mag_private_cache {
+  ulong  cnt;                         /* Number of cached blocks, in [0,FD_ALLOC_MAG_DEPTH] */
+  void * laddr[ FD_ALLOC_MAG_DEPTH ]; /* laddr[i] for i in [0,cnt) is the laddr of a malloc that was freed into the mag */
+};
+
+typedef struct fd_alloc_mag_private_cache fd_alloc_mag_private_cache_t;
+
+struct __attribute__((aligned(FD_ALLOC_MAG_ALIGN))) fd_alloc_mag {
+  ulong        magic; /* ==FD_ALLOC_MAG_MAGIC */
+  fd_alloc_t * alloc; /* Local join used for pass through operations, NULL if not joined */
+
+  /* cache[ sizeclass ] holds the blocks cached for sizeclass.  A cached
+     block is still marked allocated in its superblock and retains the
+     fd_alloc_hdr_t of its most recent malloc (the laddr stored is the
+     laddr of that malloc). */
+
+  fd_alloc_mag_private_cache_t cache[ FD_ALLOC_SIZECLASS_CNT ] __attribute__((aligned(128UL)));
+
+  /* stat[ sizeclass ] for sizeclass in [0,FD_ALLOC_SIZECLASS_CNT) are
+     the stats for that sizeclass and stat[ FD_ALLOC_SIZECLASS_CNT ]
+     are the stats for large allocations. */
+
+  fd_alloc_mag_stat_t stat[ FD_ALLOC_SIZECLASS_CNT+1UL ] __attribute__((aligned(128UL)));
+};
+
+FD_STATIC_ASSERT( alignof(fd_alloc_mag_t)==FD_ALLOC_MAG_ALIGN,     layout );
+FD_STATIC_ASSERT( sizeof (fd_alloc_mag_t)==FD_ALLOC_MAG_FOOTPRINT, layout );
+
+/* fd_alloc_mag_private_block_max returns the number of bytes available
+   at laddr for a small malloc in sizeclass described by hdr (i.e. the
+   max returned by the malloc_at_least that produced laddr). */
+
+FD_FN_PURE static inline ulong
+fd_alloc_mag_private_block_max( fd_alloc_hdr_t hdr,
+                                void *         laddr,
+                                ulong          sizeclass ) {
+  ulong block_footprint = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].block_footprint;
+  ulong block_laddr     = (ulong)fd_alloc_hdr_superblock( hdr, laddr ) + sizeof(fd_alloc_superblock_t)
+                        + fd_alloc_hdr_block_idx( hdr )*block_footprint;
+  return block_footprint - (((ulong)laddr) - block_laddr);
+}
+
+ulong
+fd_alloc_mag_align( void ) {
+  return alignof(fd_alloc_mag_t);
+}
+
+ulong
+fd_alloc_mag_footprint( void ) {
+  return sizeof(fd_alloc_mag_t);
+}
+
+void *
+fd_alloc_mag_new( void * shmag ) {
+
+  if( FD_UNLIKELY( !shmag ) ) {
+    FD_LOG_WARNING(( "NULL shmag" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmag, alignof(fd_alloc_mag_t) ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmag" ));
+    return NULL;
+  }
+
+  fd_alloc_mag_t * mag = (fd_alloc_mag_t *)shmag;
+  fd_memset( mag, 0, sizeof(fd_alloc_mag_t) );
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( mag->magic ) = FD_ALLOC_MAG_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmag;
+}
+
+fd_alloc_mag_t *
+fd_alloc_mag_join( void *       shmag,
+                   fd_alloc_t * alloc ) {
+
+  if( FD_UNLIKELY( !shmag ) ) {
+    FD_LOG_WARNING(( "NULL shmag" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmag, alignof(fd_alloc_mag_t) ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmag" ));
+    return NULL;
+  }
+
+  fd_alloc_mag_t * mag = (fd_alloc_mag_t *)shmag;
+
+  if( FD_UNLIKELY( mag->magic!=FD_ALLOC_MAG_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !alloc ) ) {
+    FD_LOG_WARNING(( "NULL alloc" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( mag->alloc ) ) {
+    FD_LOG_WARNING(( "mag already joined" ));
+    return NULL;
+  }
+
+  mag->alloc = alloc;
+  return mag;
+}
+
+void *
+fd_alloc_mag_leave( fd_alloc_mag_t * mag ) {
+
+  if( FD_UNLIKELY( !mag ) ) {
+    FD_LOG_WARNING(( "NULL mag" ));
+    return NULL;
+  }
+
+  fd_alloc_mag_flush( mag );
+  mag->alloc = NULL;
+  return (void *)mag;
+}
+
+void *
+fd_alloc_mag_delete( void * shmag ) {
+
+  if( FD_UNLIKELY( !shmag ) ) {
+    FD_LOG_WARNING(( "NULL shmag" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmag, alignof(fd_alloc_mag_t) ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmag" ));
+    return NULL;
+  }
+
+  fd_alloc_mag_t * mag = (fd_alloc_mag_t *)shmag;
+
+  if( FD_UNLIKELY( mag->magic!=FD_ALLOC_MAG_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( mag->alloc ) ) {
+    FD_LOG_WARNING(( "mag still joined" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( mag->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shmag;
+}
+
+fd_alloc_t *
+fd_alloc_mag_alloc( fd_alloc_mag_t const * mag ) {
+  return mag->alloc;
+}
+
+void *
+fd_alloc_mag_malloc_at_least( fd_alloc_mag_t * mag,
+                              ulong            align,
+                              ulong            sz,
+                              ulong *          max ) {
+
+  if( FD_UNLIKELY( !max ) ) return NULL;
+  if( FD_UNLIKELY( !mag ) ) {
+    *max = 0UL;
+    return NULL;
+  }
+
+# if !FD_HAS_DEEPASAN /* Cached blocks are poisoned under DEEPASAN, so always pass through */
+
+  /* Compute the sizeclass exactly as fd_alloc_malloc_at_least would.
+     If there is a cached block in it, re-carve the block for the
+     requested alignment.  This is safe because the tightest fitting
+     sizeclass for footprint has a block_footprint of at least
+     footprint. */
+
+  ulong _align    = fd_ulong_if( !align, FD_ALLOC_MALLOC_ALIGN_DEFAULT, align );
+  ulong footprint = sz + sizeof(fd_alloc_hdr_t) + _align - 1UL;
+
+  if( FD_LIKELY( fd_ulong_is_pow2( _align ) & (!!sz) & (footprint>sz) & (footprint<=FD_ALLOC_FOOTPRINT_SMALL_THRESH) ) ) {
+    ulong                          sizeclass = fd_alloc_preferred_sizeclass( footprint );
+    fd_alloc_mag_private_cache_t * cache     = mag->cache + sizeclass;
+    ulong                          cnt       = cache->cnt;
+    if( FD_LIKELY( cnt ) ) {
+      void *                  laddr       = cache->laddr[ cnt-1UL ];
+      fd_alloc_hdr_t          hdr         = fd_alloc_hdr_load( laddr );
+      fd_alloc_superblock_t * superblock  = fd_alloc_hdr_superblock( hdr, laddr );
+      ulong                   block_idx   = fd_alloc_hdr_block_idx( hdr );
+      ulong                   block_fp    = (ulong)fd_alloc_sizeclass_cfg[ sizeclass ].block_footprint;
+      ulong                   block_laddr = (ulong)superblock + sizeof(fd_alloc_superblock_t) + block_idx*block_fp;
+      ulong                   alloc_laddr = fd_ulong_align_up( block_laddr + sizeof(fd_alloc_hdr_t), _align );
+
+      cache->cnt = cnt-1UL;
+
+      ulong _max = block_fp - (alloc_laddr - block_laddr);
+      *max = _max;
+
+      fd_alloc_mag_stat_t * stat = mag->stat + sizeclass;
+      stat->malloc_cnt++;
+      stat->hit_cnt++;
+      stat->live_bytes += _max;
+
+      return fd_alloc_hdr_store( (void *)alloc_laddr, superblock, block_idx, sizeclass );
+    }
+  }
+
+# endif
+
+  void * laddr = fd_alloc_malloc_at_least( mag->alloc, align, sz, max );
+  if( FD_LIKELY( laddr ) ) {
+    ulong                 sizeclass = fd_alloc_hdr_sizeclass( fd_alloc_hdr_load( laddr ) );
+    fd_alloc_mag_stat_t * stat      = mag->stat + fd_ulong_min( sizeclass, FD_ALLOC_SIZECLASS_CNT );
+    stat->malloc_cnt++;
+    stat->live_bytes += fd_ulong_if( sizeclass==FD_ALLOC_SIZECLASS_LARGE, 0UL, *max );
+  }
+  return laddr;
+}
+
+void
+fd_alloc_mag_free( fd_alloc_mag_t * mag,
+                   void *           laddr ) {
+
+  if( FD_UNLIKELY( (!mag) | (!laddr) ) ) return;
+
+  fd_alloc_hdr_t hdr       = fd_alloc_hdr_load( laddr );
+  ulong          sizeclass = fd_alloc_hdr_sizeclass( hdr );
+
+  if( FD_UNLIKELY( sizeclass==FD_ALLOC_SIZECLASS_LARGE ) ) {
+    mag->stat[ FD_ALLOC_SIZECLASS_CNT ].free_cnt++;
+    fd_alloc_free( mag->alloc, laddr );
+    return;
+  }
+
+  fd_alloc_mag_stat_t * stat = mag->stat + sizeclass;
+  stat->free_cnt++;
+  stat->live_bytes -= fd_alloc_mag_private_block_max( hdr, laddr, sizeclass );
+
+# if !FD_HAS_DEEPASAN
+  fd_alloc_mag_private_cache_t * cache = mag->cache + sizeclass;
+  ulong                          cnt   = cache->cnt;
+  if( FD_LIKELY( cnt<FD_ALLOC_MAG_DEPTH ) ) {
+    cache->laddr[ cnt ] = laddr;
+    cache->cnt          = cnt+1UL;
+    return;
+  }
+# endif
+
+  fd_alloc_free( mag->alloc, laddr );
+}
+
+void
+fd_alloc_mag_flush( fd_alloc_mag_t * mag ) {
+  fd_alloc_t * alloc = mag->alloc;
+  for( ulong sizeclass=0UL; sizeclass<FD_ALLOC_SIZECLASS_CNT; sizeclass++ ) {
+    fd_alloc_mag_private_cache_t * cache = mag->cache + sizeclass;
+    ulong                          cnt   = cache->cnt;
+    while( cnt ) fd_alloc_free( alloc, cache->laddr[ --cnt ] );
+    cache->cnt = 0UL;
+  }
+}
+
+fd_alloc_mag_stat_t const *
+fd_alloc_mag_stat( fd_alloc_mag_t const * mag,
+                   ulong                  sizeclass ) {
+  return FD_LIKELY( sizeclass<=FD_ALLOC_SIZECLASS_CNT ) ? mag->stat + sizeclass : NULL;
+}
+
 /**********************************************************************/
 
 #include <stdio.h>
@@ -1385,8 +1750,9 @@ fd_alloc_fprintf( fd_alloc_t * join,
       /* Print size class header */
 
       TRAP( fprintf( stream,
-                     "\tsizeclass %lu: superblock_footprint %lu, block_footprint %lu-%lu, block_cnt %lu, cgroup_cnt %lu\n",
-                     sizeclass, superblock_footprint, block_footprint_prev+1UL, block_footprint, block_cnt, cgroup_cnt ) );
+                     "\tsizeclass %lu: superblock_footprint %lu, block_footprint %lu-%lu, block_cnt %lu, cgroup_cnt %lu, cas_retry_cnt %lu\n",
+                     sizeclass, superblock_footprint, block_footprint_prev+1UL, block_footprint, block_cnt, cgroup_cnt,
+                     alloc->cas_retry_cnt[ sizeclass ] ) );
 
       /* Print inactive stack top */
 
@@ -1543,4 +1909,23 @@ fd_alloc_vtable = {
   .free   = fd_alloc_free_virtual
 };
 
+static void *
+fd_alloc_mag_malloc_virtual( void * self,
+                             ulong  align,
+                             ulong  sz ) {
+  return fd_alloc_mag_malloc( (fd_alloc_mag_t *)self, align, sz );
+}
+
+static void
+fd_alloc_mag_free_virtual( void * self,
+                           void * addr ) {
+  fd_alloc_mag_free( (fd_alloc_mag_t *)self, addr );
+}
+
+const fd_valloc_vtable_t
+fd_alloc_mag_vtable = {
+  .malloc = fd_alloc_mag_malloc_virtual,
+  .free   = fd_alloc_mag_free_virtual
+};
+
 #undef TRAP
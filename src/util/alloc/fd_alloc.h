@@ -616,6 +616,178 @@ fd_alloc_max_expand( ulong max,
   return fd_ulong_max( fd_ulong_max( t0, t1 ), needed );
 }
 
+/* fd_alloc_sizeclass_cnt returns the number of small allocation
+   sizeclasses supported by the implementation.  Sizeclasses are indexed
+   [0,fd_alloc_sizeclass_cnt()) in order of increasing block footprint.
+
+   fd_alloc_sizeclass_query populates *stat with a snapshot of the
+   utilization of the given sizeclass of the fd_alloc with the current
+   local join and returns stat.  On failure (NULL join, NULL stat or
+   sizeclass not in [0,fd_alloc_sizeclass_cnt())), returns NULL and *stat
+   is untouched.  The snapshot covers the superblocks currently in
+   circulation for the sizeclass (i.e. the active superblocks and the
+   inactive stack).  Superblocks that are completely allocated are not
+   tracked by fd_alloc and thus are not included.
+
+   Like fd_alloc_fprintf, this is a diagnostic that walks the inactive
+   stack non-atomically.  Concurrent use will not corrupt the alloc but
+   the snapshot might be inaccurate (e.g. blocks could be counted
+   twice).  cas_retry_cnt is accumulated over the lifetime of the alloc
+   and is exact.
+
+   Free blocks in circulation are memory reserved from the wksp by this
+   sizeclass but not used by any outstanding malloc; the ratio
+   free_block_cnt / block_cnt is thus a measure of the sizeclass's
+   internal fragmentation. */
+
+struct fd_alloc_sizeclass_stat {
+  ulong block_footprint;      /* Footprint of a block in this sizeclass */
+  ulong superblock_footprint; /* Footprint of a superblock in this sizeclass */
+  ulong superblock_cnt;       /* Number of superblocks in circulation */
+  ulong block_cnt;            /* Number of blocks in superblocks in circulation */
+  ulong free_block_cnt;       /* Number of free blocks in superblocks in circulation, in [0,block_cnt] */
+  ulong cas_retry_cnt;        /* Number of inactive stack CAS retries due to contention */
+};
+
+typedef struct fd_alloc_sizeclass_stat fd_alloc_sizeclass_stat_t;
+
+FD_FN_CONST ulong
+fd_alloc_sizeclass_cnt( void );
+
+fd_alloc_sizeclass_stat_t *
+fd_alloc_sizeclass_query( fd_alloc_t *                join,
+                          ulong                       sizeclass,
+                          fd_alloc_sizeclass_stat_t * stat );
+
+/* fd_alloc_mag is an optional thread local caching layer ("magazine")
+   in front of a fd_alloc join.  A fd_alloc_mag caches up to
+   FD_ALLOC_MAG_DEPTH recently freed small blocks for each sizeclass.
+   A malloc that maps to a sizeclass with cached blocks is served from
+   the cache without touching any shared alloc state (no atomics).  A
+   free of a small allocation is pushed into the cache if there is room
+   (again no atomics).  Everything else passes through to the underlying
+   join.  Blocks cached by a mag are still allocated from the point of
+   view of the fd_alloc (e.g. fd_alloc_is_empty will report non-empty
+   and fd_alloc_compact will not reclaim their superblocks) until the
+   mag is flushed.
+
+   A fd_alloc_mag also tracks per sizeclass usage statistics for the
+   mallocs and frees done through it (see fd_alloc_mag_stat_t).
+
+   A fd_alloc_mag's state lives in caller provided local memory (it
+   holds local addresses and thus is not meaningful to other processes)
+   and should only be used by a single thread at a time.  Typical usage:
+
+     fd_alloc_mag_t * mag = fd_alloc_mag_join( fd_alloc_mag_new( _mag ), alloc );
+     ...
+     void * p = fd_alloc_mag_malloc( mag, align, sz );
+     ...
+     fd_alloc_mag_free( mag, p );
+     ...
+     fd_alloc_mag_delete( fd_alloc_mag_leave( mag ) ); // flushes
+
+   Memory malloc'd through a mag can be freed through fd_alloc_free
+   (or through a different mag of the same alloc) and vice versa. */
+
+#define FD_ALLOC_MAG_DEPTH     (8UL)
+#define FD_ALLOC_MAG_ALIGN     (128UL)
+#define FD_ALLOC_MAG_FOOTPRINT (13312UL)
+
+struct fd_alloc_mag;
+typedef struct fd_alloc_mag fd_alloc_mag_t;
+
+/* fd_alloc_mag_stat_t gives usage statistics of a sizeclass (or of
+   large allocations) for the mallocs and frees done through a mag.
+   live_bytes is the number of bytes (as reported by max for
+   malloc_at_least) malloc'd minus the number of bytes freed through
+   this mag.  It wraps (i.e. should be interpreted as a long) if
+   allocations are freed through a different mag or join than they were
+   malloc'd from; summing over all the mags used with an alloc gives
+   the alloc's total live bytes.  Large allocation live_bytes are not
+   tracked (it would require querying the wksp on free). */
+
+struct fd_alloc_mag_stat {
+  ulong malloc_cnt; /* Number of successful mallocs */
+  ulong free_cnt;   /* Number of frees */
+  ulong hit_cnt;    /* Number of mallocs served from the cache, in [0,malloc_cnt] */
+  ulong live_bytes; /* See above */
+};
+
+typedef struct fd_alloc_mag_stat fd_alloc_mag_stat_t;
+
+FD_FN_CONST ulong fd_alloc_mag_align    ( void ); /* Returns FD_ALLOC_MAG_ALIGN */
+FD_FN_CONST ulong fd_alloc_mag_footprint( void ); /* Returns FD_ALLOC_MAG_FOOTPRINT */
+
+/* fd_alloc_mag_new formats a memory region with suitable alignment and
+   footprint for use as a fd_alloc_mag.  Returns shmag on success and
+   NULL on failure (logs details).  fd_alloc_mag_join joins the caller
+   to the mag, attaching it to the local alloc join alloc (the mag
+   retains alloc for the lifetime of the join).  Returns a handle on
+   success and NULL on failure (logs details).  fd_alloc_mag_leave
+   flushes the mag (see fd_alloc_mag_flush) and leaves it.  Returns
+   shmag on success and NULL on failure (logs details).
+   fd_alloc_mag_delete unformats the mag.  Returns shmag on success and
+   NULL on failure (logs details).  The mag statistics are reset by new
+   and preserved across leave / join. */
+
+void *           fd_alloc_mag_new   ( void * shmag );
+fd_alloc_mag_t * fd_alloc_mag_join  ( void * shmag, fd_alloc_t * alloc );
+void *           fd_alloc_mag_leave ( fd_alloc_mag_t * mag );
+void *           fd_alloc_mag_delete( void * shmag );
+
+/* fd_alloc_mag_alloc returns the alloc join used by mag.  Assumes mag
+   is a current local join. */
+
+FD_FN_PURE fd_alloc_t * fd_alloc_mag_alloc( fd_alloc_mag_t const * mag );
+
+/* fd_alloc_mag_malloc_at_least and fd_alloc_mag_malloc have the same
+   semantics as fd_alloc_malloc_at_least and fd_alloc_malloc but are
+   served from the mag's cache when possible.  Assumes mag is a current
+   local join or NULL (NULL mag is treated as a failure). */
+
+void *
+fd_alloc_mag_malloc_at_least( fd_alloc_mag_t * mag,
+                              ulong            align,
+                              ulong            sz,
+                              ulong *          max );
+
+static inline void *
+fd_alloc_mag_malloc( fd_alloc_mag_t * mag,
+                     ulong            align,
+                     ulong            sz ) {
+  ulong max[1];
+  return fd_alloc_mag_malloc_at_least( mag, align, sz, max );
+}
+
+/* fd_alloc_mag_free has the same semantics as fd_alloc_free but will
+   cache small blocks in the mag if there is room.  NULL mag and NULL
+   laddr are a no-op. */
+
+void
+fd_alloc_mag_free( fd_alloc_mag_t * mag,
+                   void *           laddr );
+
+/* fd_alloc_mag_flush returns all blocks cached by mag to the underlying
+   alloc.  This should be done periodically (e.g. in housekeeping) by
+   long running users whose allocation patterns shift between
+   sizeclasses and before checking the alloc for leaks.  Assumes mag is
+   a current local join. */
+
+void
+fd_alloc_mag_flush( fd_alloc_mag_t * mag );
+
+/* fd_alloc_mag_stat returns the usage statistics for the given
+   sizeclass in [0,fd_alloc_sizeclass_cnt()) of the mallocs and frees
+   done through mag.  If sizeclass is fd_alloc_sizeclass_cnt(), returns
+   the statistics for large allocations.  Assumes mag is a current local
+   join.  Returns NULL if sizeclass is out of range.  Lifetime of the
+   returned pointer is the lifetime of the mag's local join; the value
+   is updated live. */
+
+FD_FN_PURE fd_alloc_mag_stat_t const *
+fd_alloc_mag_stat( fd_alloc_mag_t const * mag,
+                   ulong                  sizeclass );
+
 /* fd_alloc_vtable is the virtual function table implementing fd_valloc
    for fd_alloc. */
 
@@ -630,6 +802,17 @@ fd_alloc_virtual( fd_alloc_t * alloc ) {
   return valloc;
 }
 
+/* fd_alloc_mag_vtable / fd_alloc_mag_virtual are the fd_valloc
+   equivalents for a fd_alloc_mag. */
+
+extern const fd_valloc_vtable_t fd_alloc_mag_vtable;
+
+FD_FN_CONST static inline fd_valloc_t
+fd_alloc_mag_virtual( fd_alloc_mag_t * mag ) {
+  fd_valloc_t valloc = { mag, &fd_alloc_mag_vtable };
+  return valloc;
+}
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_util_alloc_fd_alloc_h */
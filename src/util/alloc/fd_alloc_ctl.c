@@ -192,6 +192,18 @@ main( int     argc,
       else if( !strcmp( what, "tag"  ) ) printf( "%lu\n", FD_UNLIKELY( err ) ? 0UL : fd_alloc_tag( alloc ) );
       else if( !strcmp( what, "leak" ) ) printf( "%i\n",  FD_UNLIKELY( err ) ? -1  : !fd_alloc_is_empty( alloc ) );
       else if( !strcmp( what, "full" ) ) fd_alloc_fprintf( alloc, stdout );
+      else if( !strcmp( what, "sizeclass" ) ) {
+        if( FD_LIKELY( !err ) ) {
+          printf( "sizeclass block_footprint superblock_cnt block_cnt free_block_cnt cas_retry_cnt\n" );
+          for( ulong sizeclass=0UL; sizeclass<fd_alloc_sizeclass_cnt(); sizeclass++ ) {
+            fd_alloc_sizeclass_stat_t stat[1];
+            if( FD_UNLIKELY( !fd_alloc_sizeclass_query( alloc, sizeclass, stat ) ) ) continue;
+            if( !(stat->superblock_cnt | stat->cas_retry_cnt) ) continue; /* omit unused sizeclasses */
+            printf( "%9lu %15lu %14lu %9lu %14lu %13lu\n", sizeclass, stat->block_footprint, stat->superblock_cnt,
+                    stat->block_cnt, stat->free_block_cnt, stat->cas_retry_cnt );
+          }
+        }
+      }
       else                               FD_LOG_ERR(( "unknown query %s", what ));
 
       if( FD_LIKELY( alloc ) ) fd_alloc_leave( alloc );
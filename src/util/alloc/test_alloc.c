@@ -376,6 +376,129 @@ main( int     argc,
     FD_TEST( fd_alloc_is_empty( alloc ) );
   } while(0);
 
+  FD_LOG_NOTICE(( "Testing sizeclass query" ));
+
+  do {
+    ulong sizeclass_cnt = fd_alloc_sizeclass_cnt();
+    FD_TEST( sizeclass_cnt>0UL );
+
+    fd_alloc_sizeclass_stat_t stat[1];
+    FD_TEST( !fd_alloc_sizeclass_query( NULL,  0UL,           stat ) ); /* NULL join */
+    FD_TEST( !fd_alloc_sizeclass_query( alloc, 0UL,           NULL ) ); /* NULL stat */
+    FD_TEST( !fd_alloc_sizeclass_query( alloc, sizeclass_cnt, stat ) ); /* bad sizeclass */
+
+    ulong block_footprint = 0UL;
+    for( ulong sizeclass=0UL; sizeclass<sizeclass_cnt; sizeclass++ ) {
+      FD_TEST( fd_alloc_sizeclass_query( alloc, sizeclass, stat )==stat );
+      FD_TEST( stat->block_footprint>block_footprint );
+      FD_TEST( stat->superblock_cnt==0UL ); /* alloc is empty and compacted */
+      FD_TEST( stat->block_cnt     ==0UL );
+      FD_TEST( stat->free_block_cnt==0UL );
+      block_footprint = stat->block_footprint;
+    }
+
+    void * mem = fd_alloc_malloc( alloc, 1UL, 1UL ); FD_TEST( mem );
+    ulong in_use = 0UL;
+    for( ulong sizeclass=0UL; sizeclass<sizeclass_cnt; sizeclass++ ) {
+      FD_TEST( fd_alloc_sizeclass_query( alloc, sizeclass, stat )==stat );
+      FD_TEST( stat->free_block_cnt<=stat->block_cnt );
+      in_use += stat->block_cnt - stat->free_block_cnt;
+    }
+    FD_TEST( in_use>=1UL ); /* the malloc (and the superblocks holding it) */
+    fd_alloc_free( alloc, mem );
+    fd_alloc_compact( alloc );
+    FD_TEST( fd_alloc_is_empty( alloc ) );
+  } while(0);
+
+  FD_LOG_NOTICE(( "Testing mag" ));
+
+  do {
+    FD_TEST( fd_alloc_mag_align    ()==FD_ALLOC_MAG_ALIGN     );
+    FD_TEST( fd_alloc_mag_footprint()==FD_ALLOC_MAG_FOOTPRINT );
+
+    static uchar _mag[ FD_ALLOC_MAG_FOOTPRINT ] __attribute__((aligned(FD_ALLOC_MAG_ALIGN)));
+
+    FD_TEST( !fd_alloc_mag_new( NULL        ) ); /* NULL shmag */
+    FD_TEST( !fd_alloc_mag_new( (void *)1UL ) ); /* misaligned shmag */
+    void * shmag = fd_alloc_mag_new( _mag ); FD_TEST( shmag==_mag );
+
+    FD_TEST( !fd_alloc_mag_join( NULL,        alloc ) ); /* NULL shmag */
+    FD_TEST( !fd_alloc_mag_join( (void *)1UL, alloc ) ); /* misaligned shmag */
+    FD_TEST( !fd_alloc_mag_join( dummy_mem,   alloc ) ); /* bad magic */
+    FD_TEST( !fd_alloc_mag_join( shmag,       NULL  ) ); /* NULL alloc */
+    fd_alloc_mag_t * mag = fd_alloc_mag_join( shmag, alloc ); FD_TEST( mag );
+    FD_TEST( !fd_alloc_mag_join( shmag, alloc ) );       /* already joined */
+    FD_TEST( fd_alloc_mag_alloc( mag )==alloc );
+    FD_TEST( !fd_alloc_mag_delete( shmag ) );            /* still joined */
+
+    FD_TEST( !fd_alloc_mag_malloc( NULL, 1UL, 1UL ) );   /* NULL mag */
+    FD_TEST( !fd_alloc_mag_malloc( mag,  1UL, 0UL ) );   /* zero sz */
+    FD_TEST( !fd_alloc_mag_malloc( mag,  3UL, 1UL ) );   /* bad align */
+    fd_alloc_mag_free( NULL, NULL );
+    fd_alloc_mag_free( mag,  NULL );
+
+    FD_TEST( !fd_alloc_mag_stat( mag, fd_alloc_sizeclass_cnt()+1UL ) );
+
+    /* Repeated malloc / free of the same size should be served from the
+       cache after the first round.  Reallocating a cached block with a
+       different alignment must honor the new alignment. */
+
+    ulong sz = 100UL;
+    void * mem[ FD_ALLOC_MAG_DEPTH ];
+    for( ulong iter=0UL; iter<4UL; iter++ ) {
+      for( ulong idx=0UL; idx<FD_ALLOC_MAG_DEPTH; idx++ ) {
+        ulong align = 1UL<<(idx & 3UL);
+        ulong max;
+        mem[idx] = fd_alloc_mag_malloc_at_least( mag, align, sz, &max );
+        FD_TEST( mem[idx] );
+        FD_TEST( fd_ulong_is_aligned( (ulong)mem[idx], align ) );
+        FD_TEST( max>=sz );
+        fd_memset( mem[idx], (int)idx, sz );
+      }
+      for( ulong idx=0UL; idx<FD_ALLOC_MAG_DEPTH; idx++ ) {
+        for( ulong b=0UL; b<sz; b++ ) FD_TEST( ((uchar *)mem[idx])[b]==(uchar)idx );
+        fd_alloc_mag_free( mag, mem[idx] );
+      }
+    }
+
+    ulong malloc_cnt = 0UL; ulong free_cnt = 0UL; ulong hit_cnt = 0UL; ulong live_bytes = 0UL;
+    for( ulong sizeclass=0UL; sizeclass<=fd_alloc_sizeclass_cnt(); sizeclass++ ) {
+      fd_alloc_mag_stat_t const * stat = fd_alloc_mag_stat( mag, sizeclass ); FD_TEST( stat );
+      malloc_cnt += stat->malloc_cnt; free_cnt += stat->free_cnt; hit_cnt += stat->hit_cnt; live_bytes += stat->live_bytes;
+    }
+    FD_TEST( malloc_cnt==4UL*FD_ALLOC_MAG_DEPTH );
+    FD_TEST( free_cnt  ==4UL*FD_ALLOC_MAG_DEPTH );
+#   if !FD_HAS_DEEPASAN
+    FD_TEST( hit_cnt   ==3UL*FD_ALLOC_MAG_DEPTH );
+#   endif
+    FD_TEST( live_bytes==0UL );
+
+    /* Cached blocks are still allocated from the alloc's POV until
+       flushed.  Frees and mallocs between mag and non-mag paths should
+       interoperate. */
+
+#   if !FD_HAS_DEEPASAN
+    FD_TEST( !fd_alloc_is_empty( alloc ) );
+#   endif
+    fd_alloc_mag_flush( mag );
+    FD_TEST( fd_alloc_is_empty( alloc ) );
+
+    void * a = fd_alloc_mag_malloc( mag, 0UL, 1000UL   ); FD_TEST( a );
+    void * b = fd_alloc_malloc    ( alloc, 0UL, 1000UL ); FD_TEST( b );
+    void * c = fd_alloc_mag_malloc( mag, 0UL, 100000UL ); FD_TEST( c ); /* large */
+    fd_alloc_free    ( alloc, a );
+    fd_alloc_mag_free( mag,   b );
+    fd_alloc_mag_free( mag,   c );
+    FD_TEST( fd_alloc_mag_stat( mag, fd_alloc_sizeclass_cnt() )->malloc_cnt==1UL );
+    FD_TEST( fd_alloc_mag_stat( mag, fd_alloc_sizeclass_cnt() )->free_cnt  ==1UL );
+
+    FD_TEST( fd_alloc_mag_leave( mag )==shmag ); /* flushes */
+    FD_TEST( fd_alloc_is_empty( alloc ) );
+    FD_TEST( !fd_alloc_mag_delete( NULL      ) );
+    FD_TEST( !fd_alloc_mag_delete( dummy_mem ) ); /* bad magic */
+    FD_TEST( fd_alloc_mag_delete( shmag )==_mag );
+  } while(0);
+
   FD_LOG_NOTICE(( "Testing max_expand" ));
   do {
 
@@ -5,7 +5,9 @@
 #include <string.h>
 #include <errno.h>
 
-fd_fibre_t * fd_fibre_current = NULL;
+FD_TL fd_fibre_t * fd_fibre_current = NULL;
+
+#if FD_FIBRE_USE_UCONTEXT
 
 /* top level function
    simply calls the user function then sets the done flag */
@@ -20,6 +22,160 @@ fd_fibre_run_fn( void * vp ) {
   fibre->done = 1;
 }
 
+#else
+
+/* fd_fibre_private_switch saves the callee saved registers of the
+   calling fibre on its stack, stores its stack pointer at *save_sp,
+   and resumes the fibre whose stack pointer is load_sp.  It returns
+   when another fibre switches back to the caller.  Everything else
+   (caller saved registers, flags) is already dead across a call per
+   the ABI, so this is all the state a cooperative switch needs.
+
+   A new fibre's stack is populated with a frame that looks as if the
+   fibre had called fd_fibre_private_switch from
+   fd_fibre_private_trampoline, with the fibre pointer in a callee
+   saved register.  The trampoline calls fd_fibre_private_entry which
+   never returns. */
+
+void
+fd_fibre_private_switch( void ** save_sp, void * load_sp );
+
+void
+fd_fibre_private_trampoline( void );
+
+__attribute__((used,noreturn,visibility("hidden"))) void
+fd_fibre_private_entry( fd_fibre_t * fibre );
+
+#if defined(__x86_64__)
+
+/* frame: mxcsr/x87 cw, r15, r14, r13, r12, rbx, rbp, return address */
+
+__asm__(
+  ".text\n"
+  ".p2align 4\n"
+  ".globl fd_fibre_private_switch\n"
+  ".hidden fd_fibre_private_switch\n"
+  ".type fd_fibre_private_switch,@function\n"
+  "fd_fibre_private_switch:\n"
+  "  pushq %rbp\n"
+  "  pushq %rbx\n"
+  "  pushq %r12\n"
+  "  pushq %r13\n"
+  "  pushq %r14\n"
+  "  pushq %r15\n"
+  "  subq $8, %rsp\n"
+  "  stmxcsr (%rsp)\n"
+  "  fnstcw 4(%rsp)\n"
+  "  movq %rsp, (%rdi)\n"
+  "  movq %rsi, %rsp\n"
+  "  ldmxcsr (%rsp)\n"
+  "  fldcw 4(%rsp)\n"
+  "  addq $8, %rsp\n"
+  "  popq %r15\n"
+  "  popq %r14\n"
+  "  popq %r13\n"
+  "  popq %r12\n"
+  "  popq %rbx\n"
+  "  popq %rbp\n"
+  "  ret\n"
+  ".size fd_fibre_private_switch,.-fd_fibre_private_switch\n"
+  "\n"
+  ".p2align 4\n"
+  ".globl fd_fibre_private_trampoline\n"
+  ".hidden fd_fibre_private_trampoline\n"
+  ".type fd_fibre_private_trampoline,@function\n"
+  "fd_fibre_private_trampoline:\n"
+  "  movq %r12, %rdi\n"
+  "  andq $-16, %rsp\n"
+  "  call fd_fibre_private_entry\n"
+  "  ud2\n"
+  ".size fd_fibre_private_trampoline,.-fd_fibre_private_trampoline\n"
+);
+
+#define FD_FIBRE_PRIVATE_FRAME_CNT   (9UL)
+#define FD_FIBRE_PRIVATE_FRAME_ARG   (4UL) /* r12 */
+#define FD_FIBRE_PRIVATE_FRAME_RET   (7UL)
+#define FD_FIBRE_PRIVATE_FRAME_CSR   (0UL)
+#define FD_FIBRE_PRIVATE_CSR_INIT    (0x0000037f00001f80UL) /* x87 cw 0x37f, mxcsr 0x1f80 (the ABI defaults) */
+
+#elif defined(__aarch64__)
+
+/* frame: x19-x28, x29 (fp), x30 (lr), d8-d15 */
+
+__asm__(
+  ".text\n"
+  ".p2align 4\n"
+  ".globl fd_fibre_private_switch\n"
+  ".hidden fd_fibre_private_switch\n"
+  ".type fd_fibre_private_switch,%function\n"
+  "fd_fibre_private_switch:\n"
+  "  sub sp, sp, #160\n"
+  "  stp x19, x20, [sp, #0]\n"
+  "  stp x21, x22, [sp, #16]\n"
+  "  stp x23, x24, [sp, #32]\n"
+  "  stp x25, x26, [sp, #48]\n"
+  "  stp x27, x28, [sp, #64]\n"
+  "  stp x29, x30, [sp, #80]\n"
+  "  stp d8,  d9,  [sp, #96]\n"
+  "  stp d10, d11, [sp, #112]\n"
+  "  stp d12, d13, [sp, #128]\n"
+  "  stp d14, d15, [sp, #144]\n"
+  "  mov x2, sp\n"
+  "  str x2, [x0]\n"
+  "  mov sp, x1\n"
+  "  ldp x19, x20, [sp, #0]\n"
+  "  ldp x21, x22, [sp, #16]\n"
+  "  ldp x23, x24, [sp, #32]\n"
+  "  ldp x25, x26, [sp, #48]\n"
+  "  ldp x27, x28, [sp, #64]\n"
+  "  ldp x29, x30, [sp, #80]\n"
+  "  ldp d8,  d9,  [sp, #96]\n"
+  "  ldp d10, d11, [sp, #112]\n"
+  "  ldp d12, d13, [sp, #128]\n"
+  "  ldp d14, d15, [sp, #144]\n"
+  "  add sp, sp, #160\n"
+  "  ret\n"
+  ".size fd_fibre_private_switch,.-fd_fibre_private_switch\n"
+  "\n"
+  ".p2align 4\n"
+  ".globl fd_fibre_private_trampoline\n"
+  ".hidden fd_fibre_private_trampoline\n"
+  ".type fd_fibre_private_trampoline,%function\n"
+  "fd_fibre_private_trampoline:\n"
+  "  mov x0, x19\n"
+  "  bl fd_fibre_private_entry\n"
+  "  brk #0\n"
+  ".size fd_fibre_private_trampoline,.-fd_fibre_private_trampoline\n"
+);
+
+#define FD_FIBRE_PRIVATE_FRAME_CNT   (20UL)
+#define FD_FIBRE_PRIVATE_FRAME_ARG   (0UL)  /* x19 */
+#define FD_FIBRE_PRIVATE_FRAME_RET   (11UL) /* x30 */
+
+#else
+#error "Unsupported FD_FIBRE_USE_UCONTEXT==0 target"
+#endif
+
+/* top level function of a fibre
+   calls the user function, sets the done flag, and resumes the fibre
+   that last switched to this one */
+void
+fd_fibre_private_entry( fd_fibre_t * fibre ) {
+  /* call user function */
+  fibre->fn( fibre->arg );
+
+  /* set done flag */
+  fibre->done = 1;
+
+  /* the fibre's stack is no longer needed, so the save is a dummy */
+  fd_fibre_private_switch( &fibre->sp, fibre->link->sp );
+
+  /* a done fibre is never switched to */
+  fd_fibre_abort();
+}
+
+#endif /* FD_FIBRE_USE_UCONTEXT */
+
 /* footprint and alignment required for fd_fibre_init */
 ulong
 fd_fibre_init_footprint( void ) {
@@ -42,6 +198,7 @@ fd_fibre_init( void * mem ) {
   fibre->stack    = NULL;
   fibre->stack_sz = 0;
 
+# if FD_FIBRE_USE_UCONTEXT
   ucontext_t * ctx = &fibre->ctx;
 
   if( getcontext( ctx ) == -1 ) {
@@ -49,6 +206,9 @@ fd_fibre_init( void * mem ) {
     fflush( stderr );
     fd_fibre_abort();
   }
+# endif
+
+  /* the main fibre's stack pointer is saved by its first switch */
 
   fd_fibre_current = fibre;
 
@@ -68,7 +228,7 @@ ulong fd_fibre_start_align( void ) {
 
 /* start a fibre */
 
-/* this uses get/setcontext to start a new fibre
+/* this creates a new fibre with its own stack
    the current fibre will continue running, and the new one will be
    inactive, and ready to switch to
    this is cooperative threading
@@ -97,6 +257,7 @@ fd_fibre_start( void * mem, ulong stack_sz, fd_fibre_fn_t fn, void * arg ) {
   fibre->fn       = fn;
   fibre->arg      = arg;
 
+# if FD_FIBRE_USE_UCONTEXT
   /* start with the current fibre */
   memcpy( &fibre->ctx, &fd_fibre_current->ctx, sizeof( fibre->ctx ) );
 
@@ -109,17 +270,64 @@ fd_fibre_start( void * mem, ulong stack_sz, fd_fibre_fn_t fn, void * arg ) {
 
   /* make a new context */
   makecontext( &fibre->ctx, (void(*)(void))fd_fibre_run_fn, 1, fibre );
+# else
+  /* build the initial switch frame at the (16 byte aligned) top of the
+     stack such that the first switch to the fibre "returns" into the
+     trampoline with the fibre in the argument register */
+  ulong   top   = fd_ulong_align_dn( (ulong)stack + stack_sz, 16UL );
+  ulong * frame = (ulong *)top - FD_FIBRE_PRIVATE_FRAME_CNT;
+
+  memset( frame, 0, FD_FIBRE_PRIVATE_FRAME_CNT * sizeof(ulong) );
+  frame[ FD_FIBRE_PRIVATE_FRAME_ARG ] = (ulong)fibre;
+  frame[ FD_FIBRE_PRIVATE_FRAME_RET ] = (ulong)fd_fibre_private_trampoline;
+# if defined(__x86_64__)
+  frame[ FD_FIBRE_PRIVATE_FRAME_CSR ] = FD_FIBRE_PRIVATE_CSR_INIT;
+# endif
+
+  fibre->sp   = frame;
+  fibre->link = fd_fibre_current;
+# endif
 
   return fibre;
 }
 
+/* per thread run queue
+
+   doubly linked list sorted by sched_time, with a sentinel
+   the sentinel is initialized on first use, since thread local
+   initializers can't refer to their own address */
+static FD_TL fd_fibre_t fd_fibre_schedule_queue[1];
+
+static inline fd_fibre_t *
+fd_fibre_schedule_queue_get( void ) {
+  fd_fibre_t * queue = fd_fibre_schedule_queue;
+  if( FD_UNLIKELY( !queue->next ) ) {
+    queue->sentinel = 1;
+    queue->next     = queue;
+    queue->prev     = queue;
+  }
+  return queue;
+}
+
+/* remove a fibre from the schedule, if it's in the schedule */
+static inline void
+fd_fibre_unschedule( fd_fibre_t * fibre ) {
+  if( !fibre->prev ) return;
+
+  fibre->prev->next = fibre->next;
+  fibre->next->prev = fibre->prev;
+  fibre->prev       = NULL;
+  fibre->next       = NULL;
+}
+
 /* free a fibre
 
    this frees up the resources of a fibre */
 void
 fd_fibre_free( fd_fibre_t * fibre ) {
-  /* nothing to do, as caller owns memory */
-  (void)fibre;
+  /* caller owns memory, so just make sure the schedule doesn't
+     refer to it */
+  fd_fibre_unschedule( fibre );
 }
 
 /* switch execution to a fibre
@@ -134,21 +342,27 @@ fd_fibre_swap( fd_fibre_t * swap_to ) {
 
   if( swap_to->done ) return;
 
-  /* set the context to return to as the current context */
-  swap_to->ctx.uc_link = &fd_fibre_current->ctx;
-
   /* store current fibre for popping */
   fd_fibre_t * fibre_pop = fd_fibre_current;
 
+  /* set the fibre to return to if swap_to terminates */
+  swap_to->link = fibre_pop;
+
   /* set fd_fibre_current for next execution context */
   fd_fibre_current = swap_to;
 
   /* switch to new fibre */
+# if FD_FIBRE_USE_UCONTEXT
+  swap_to->ctx.uc_link = &fibre_pop->ctx;
+
   if( swapcontext( &fibre_pop->ctx, &swap_to->ctx ) == -1 ) {
     fprintf( stderr, "swapcontext failed with %d %s\n", errno, fd_io_strerror( errno ) );
     fflush( stdout );
     fd_fibre_abort();
   }
+# else
+  fd_fibre_private_switch( &fibre_pop->sp, swap_to->sp );
+# endif
 
   /* return value of fibre to its previous value */
   fd_fibre_current = fibre_pop;
@@ -158,7 +372,7 @@ fd_fibre_swap( fd_fibre_t * swap_to ) {
 long (*fd_fibre_clock)(void);
 
 /* fibre for scheduler */
-fd_fibre_t * fd_fibre_scheduler = NULL;
+FD_TL fd_fibre_t * fd_fibre_scheduler = NULL;
 
 void
 fd_fibre_set_clock( long (*clock)(void) ) {
@@ -220,39 +434,31 @@ fd_fibre_wake( fd_fibre_t * fibre ) {
   fd_fibre_schedule( fibre );
 }
 
-/* sentinel for run queue */
-fd_fibre_t fd_fibre_schedule_queue[1] = {{ .sentinel = 1, .next = fd_fibre_schedule_queue }};
-
 /* add a fibre to the schedule */
 void
 fd_fibre_schedule( fd_fibre_t * fibre ) {
   if( fd_fibre_clock == NULL ) fd_fibre_abort();
 
-  fd_fibre_t * cur_fibre = fd_fibre_schedule_queue;
+  fd_fibre_t * queue = fd_fibre_schedule_queue_get();
 
   /* remove from schedule */
-  while(1) {
-    if( cur_fibre->next == fibre ) {
-      cur_fibre->next = fibre->next;
-    }
-
-    cur_fibre = cur_fibre->next;
-    if( cur_fibre->sentinel ) break;
-  }
-
-  /* add into schedule at appropriate place for wake time */
-  fd_fibre_t * prior = fd_fibre_schedule_queue;
-  long wake = fibre->sched_time;
-
-  cur_fibre = prior->next;
-  while( !cur_fibre->sentinel && wake > cur_fibre->sched_time ) {
-    prior     = cur_fibre;
-    cur_fibre = cur_fibre->next;
+  fd_fibre_unschedule( fibre );
+
+  /* add into schedule at appropriate place for wake time, ahead of
+     any fibres with the same wake time
+     search from the back, as most fibres are scheduled after the
+     latest time in the schedule */
+  long         wake  = fibre->sched_time;
+  fd_fibre_t * prior = queue->prev;
+  while( !prior->sentinel && prior->sched_time >= wake ) {
+    prior = prior->prev;
   }
 
   /* insert into schedule */
-  fibre->next = cur_fibre;
-  prior->next = fibre;
+  fibre->prev       = prior;
+  fibre->next       = prior->next;
+  prior->next->prev = fibre;
+  prior->next       = fibre;
 }
 
 /* run the current schedule
@@ -264,8 +470,10 @@ fd_fibre_schedule_run( void ) {
   /* set the currently running fibre as the scheduler */
   fd_fibre_scheduler = fd_fibre_current;
 
+  fd_fibre_t * queue = fd_fibre_schedule_queue_get();
+
   while(1) {
-    fd_fibre_t * cur_fibre = fd_fibre_schedule_queue->next;
+    fd_fibre_t * cur_fibre = queue->next;
     if( cur_fibre->sentinel ) return -1;
 
     long      now       = fd_fibre_clock();
@@ -275,7 +483,7 @@ fd_fibre_schedule_run( void ) {
     }
 
     /* remove from schedule */
-    fd_fibre_schedule_queue->next = cur_fibre->next;
+    fd_fibre_unschedule( cur_fibre );
 
     /* if fibre done, skip execution */
     if( !cur_fibre->done ) {
@@ -286,6 +494,49 @@ fd_fibre_schedule_run( void ) {
   return -1;
 }
 
+/* wait until ready( ctx ) */
+int
+fd_fibre_poll( int (*ready)( void * ctx ), void * ctx, long poll_ns, long timeout ) {
+  if( fd_fibre_clock == NULL ) fd_fibre_abort();
+
+  long deadline = fd_fibre_clock() + timeout;
+
+  while(1) {
+    if( ready( ctx ) ) return 0;
+
+    long now = fd_fibre_clock();
+    if( now >= deadline ) return 1;
+
+    /* outside a running schedule (or on the scheduler itself) there is
+       nothing else to run, so spin */
+    if( fd_fibre_scheduler == NULL || fd_fibre_scheduler == fd_fibre_current ) {
+      FD_SPIN_PAUSE();
+      continue;
+    }
+
+    fd_fibre_wait_until( fd_long_min( now + fd_long_max( poll_ns, 1L ), deadline ) );
+  }
+}
+
+struct fd_fibre_seq_ge_ctx {
+  ulong const * seq;
+  ulong         seq_min;
+};
+typedef struct fd_fibre_seq_ge_ctx fd_fibre_seq_ge_ctx_t;
+
+static int
+fd_fibre_seq_ge_ready( void * vp ) {
+  fd_fibre_seq_ge_ctx_t * ctx = (fd_fibre_seq_ge_ctx_t *)vp;
+  /* same as fd_seq_ge */
+  return ((long)( FD_VOLATILE_CONST( *ctx->seq ) - ctx->seq_min ))>=0L;
+}
+
+int
+fd_fibre_wait_seq_ge( ulong const * seq, ulong seq_min, long poll_ns, long timeout ) {
+  fd_fibre_seq_ge_ctx_t ctx[1] = {{ .seq = seq, .seq_min = seq_min }};
+  return fd_fibre_poll( fd_fibre_seq_ge_ready, ctx, poll_ns, timeout );
+}
+
 ulong
 fd_fibre_pipe_align( void ) {
   return alignof( fd_fibre_pipe_t );
@@ -1,17 +1,39 @@
 #ifndef HEADER_fd_src_util_fibre_fd_fibre_h
 #define HEADER_fd_src_util_fibre_fd_fibre_h
 
-#include <ucontext.h>
-
 #include "../fd_util.h"
 
+/* FD_FIBRE_USE_UCONTEXT selects the context switch implementation.  On
+   x86_64 and aarch64, fibres switch with a few instructions that only
+   save and restore the callee saved registers (no syscalls, no signal
+   mask manipulation).  Elsewhere (and under sanitizers that need to be
+   told about stack switches), fibres fall back to ucontext_t whose
+   swapcontext does a sigprocmask syscall on every switch. */
+
+#ifndef FD_FIBRE_USE_UCONTEXT
+#if (defined(__x86_64__) || defined(__aarch64__)) && !FD_HAS_ASAN && !FD_HAS_MSAN
+#define FD_FIBRE_USE_UCONTEXT 0
+#else
+#define FD_FIBRE_USE_UCONTEXT 1
+#endif
+#endif
+
+#if FD_FIBRE_USE_UCONTEXT
+#include <ucontext.h>
+#endif
+
 #define FD_FIBRE_ALIGN 128UL
 
 /* definition of the function to be called when starting a new fibre */
 typedef void (*fd_fibre_fn_t)( void * );
 
 struct fd_fibre {
+# if FD_FIBRE_USE_UCONTEXT
   ucontext_t    ctx;
+# else
+  void *        sp;       /* saved stack pointer while the fibre is not running */
+# endif
+  struct fd_fibre * link; /* fibre to resume when fn returns (the last fibre to swap to this one) */
   void *        stack;
   size_t        stack_sz;
   fd_fibre_fn_t fn;
@@ -21,6 +43,7 @@ struct fd_fibre {
   /* schedule parameters */
   long              sched_time;
   struct fd_fibre * next;
+  struct fd_fibre * prev; /* NULL if not in the schedule */
   int               sentinel;
 };
 typedef struct fd_fibre fd_fibre_t;
@@ -39,8 +62,8 @@ struct fd_fibre_pipe {
 typedef struct fd_fibre_pipe fd_fibre_pipe_t;
 
 
-/* TODO make thread local */
-extern fd_fibre_t * fd_fibre_current;
+/* the currently running fibre on the calling thread */
+extern FD_TL fd_fibre_t * fd_fibre_current;
 
 
 FD_PROTOTYPES_BEGIN
@@ -58,7 +81,8 @@ ulong fd_fibre_init_align( void );
    creates a new fibre from the current thread, and returns it
    caller should keep the fibre for later freeing
 
-   probably shouldn't run this twice on the same thread
+   fibres and their schedule are per thread, so each thread using
+   fibres should call this once
 
    mem is the memory allocated for this object. Use fd_fibre_init{_align,_footprint} to
      obtain the appropriate size and alignment requirements */
@@ -74,7 +98,7 @@ ulong fd_fibre_start_align( void );
 
 /* Start a fibre
 
-   This uses get/setcontext to create a new fibre
+   This creates a new fibre with its own stack
 
    fd_fibre_init must be called once before calling this
 
@@ -96,7 +120,8 @@ fd_fibre_start( void * mem, ulong stack_sz, fd_fibre_fn_t fn, void * arg );
 
 /* Free a fibre
 
-   This frees up the resources of a fibre
+   This frees up the resources of a fibre (and removes it from the
+   schedule if it is in the schedule)
 
    Only call on a fibre that is not currently running */
 void
@@ -145,7 +170,13 @@ void
 fd_fibre_wake( fd_fibre_t * fibre );
 
 
-/* add a fibre to the schedule */
+/* add a fibre to the schedule
+
+   the schedule is ordered by fibre->sched_time, fibres with the same
+   sched_time run most recently scheduled first
+
+   O(1) to (re)schedule a fibre after the latest time in the schedule
+   (e.g. a yield or a timeout) and O(fibres in the schedule) worst case */
 void
 fd_fibre_schedule( fd_fibre_t * fibre );
 
@@ -159,6 +190,33 @@ long
 fd_fibre_schedule_run( void );
 
 
+/* fibre aware waits
+
+   These let a fibre wait on something another thread (e.g. another
+   tile) updates in shared memory without blocking the other fibres on
+   its thread.  The waiting fibre checks the condition, and if not
+   satisfied, sleeps for poll_ns (in fd_fibre_clock units) letting the
+   other fibres run before checking again.  If called outside of a
+   running schedule, they spin.
+
+   fd_fibre_poll waits until ready( ctx ) returns non-zero.
+
+   fd_fibre_wait_seq_ge waits until the sequence number at seq is at or
+   after seq_min (with the usual sequence number wrap around handling,
+   see fd_seq_ge).  This is suitable for waiting on a tango fseq (e.g.
+   a consumer's progress, seq is the fseq) or on a frag being published
+   to a mcache (seq is &mcache[ fd_mcache_line_idx( seq_min, depth ) ].seq).
+
+   returns     0 the condition was satisfied
+               1 timed out waiting */
+
+int
+fd_fibre_poll( int (*ready)( void * ctx ), void * ctx, long poll_ns, long timeout );
+
+int
+fd_fibre_wait_seq_ge( ulong const * seq, ulong seq_min, long poll_ns, long timeout );
+
+
 /* fibre data structures */
 
 /* pipe
@@ -409,6 +409,223 @@ run_test_pipe_filter( void ) {
 }
 
 
+/* fibres ping pong between each other, checking the values in
+   callee saved and floating point registers survive the switches */
+
+struct swap_args {
+  fd_fibre_t * peer;
+  ulong        iter_cnt;
+  double       acc;
+};
+typedef struct swap_args swap_args_t;
+
+
+void
+swap_main( void * vp ) {
+  swap_args_t * args = (swap_args_t*)vp;
+
+  double acc = 1.0;
+  ulong  sum = 0UL;
+  for( ulong iter=0UL; iter<args->iter_cnt; iter++ ) {
+    acc *= 1.0000001;
+    sum += iter;
+    fd_fibre_swap( args->peer );
+  }
+
+  if( sum != args->iter_cnt*(args->iter_cnt-1UL)/2UL ) {
+    printf( "swap_main: integer state corrupted\n" );
+    exit(1);
+  }
+
+  args->acc = acc;
+}
+
+
+void
+run_swap_test( void ) {
+  ulong stack_sz = 1<<16;
+  ulong iter_cnt = 1UL<<20;
+
+  swap_args_t args = { .peer = fd_fibre_current, .iter_cnt = iter_cnt, .acc = 0.0 };
+
+  void *       fibre_mem = aligned_alloc( fd_fibre_start_align(), fd_fibre_start_footprint( stack_sz ) );
+  fd_fibre_t * fibre     = fd_fibre_start( fibre_mem, stack_sz, swap_main, &args );
+
+  double acc = 1.0;
+  long   t0  = fd_log_wallclock();
+  ulong  cnt = 0UL;
+  while( !fibre->done ) {
+    fd_fibre_swap( fibre );
+    cnt++;
+    if( !fibre->done ) acc *= 1.0000001;
+  }
+  long   t1  = fd_log_wallclock();
+
+  if( cnt != iter_cnt+1UL || args.acc != acc ) {
+    printf( "swap test: floating point state corrupted (%lu %f %f)\n", cnt, args.acc, acc );
+    exit(1);
+  }
+
+  printf( "swap test: %.1f ns per swap\n", (double)(t1-t0) / (double)(2UL*cnt) ); fflush( stdout );
+
+  fd_fibre_free( fibre );
+  free( fibre_mem );
+}
+
+
+/* fibres run in time order, most recently scheduled first for the
+   same time */
+
+ulong order_seq = 0UL;
+
+void
+order_main( void * vp ) {
+  ulong idx = (ulong)vp;
+  if( order_seq != idx ) {
+    printf( "order test: fibre %lu ran at position %lu\n", idx, order_seq );
+    exit(1);
+  }
+  order_seq++;
+}
+
+
+void
+run_order_test( void ) {
+  ulong stack_sz = 1<<16;
+
+  now       = 0;
+  order_seq = 0UL;
+
+  void *       mem  [4];
+  fd_fibre_t * fibre[4];
+  for( ulong j=0UL; j<4UL; j++ ) {
+    mem  [j] = aligned_alloc( fd_fibre_start_align(), fd_fibre_start_footprint( stack_sz ) );
+    fibre[j] = fd_fibre_start( mem[j], stack_sz, order_main, (void*)j );
+  }
+
+  /* schedule out of order, rescheduling some */
+  fibre[1]->sched_time = 10; fd_fibre_schedule( fibre[1] );
+  fibre[3]->sched_time =  5; fd_fibre_schedule( fibre[3] );
+  fibre[0]->sched_time =  5; fd_fibre_schedule( fibre[0] );
+  fibre[2]->sched_time =  5; fd_fibre_schedule( fibre[2] );
+  fibre[0]->sched_time =  0; fd_fibre_schedule( fibre[0] );
+  fibre[1]->sched_time =  5; fd_fibre_schedule( fibre[1] );
+
+  while( 1 ) {
+    long timeout = fd_fibre_schedule_run();
+    if( timeout == -1 ) break;
+    now = timeout;
+  }
+
+  if( order_seq != 4UL ) {
+    printf( "order test: only %lu fibres ran\n", order_seq );
+    exit(1);
+  }
+
+  for( ulong j=0UL; j<4UL; j++ ) {
+    fd_fibre_free( fibre[j] );
+    free( mem[j] );
+  }
+
+  printf( "order test complete\n" ); fflush( stdout );
+}
+
+
+/* test of fd_fibre_wait_seq_ge
+
+   a producer advances a sequence number every period, as another tile
+   would update a fseq, and a consumer waits on it */
+
+ulong seq_shared = 0UL;
+
+struct seq_args {
+  ulong seq_min;
+  long  poll;
+  long  timeout;
+  int   rtn;
+  long  time;
+};
+typedef struct seq_args seq_args_t;
+
+
+void
+seq_producer_main( void * vp ) {
+  long period = *(long*)vp;
+  for( ulong j=0UL; j<10UL; j++ ) {
+    fd_fibre_wait( period );
+    seq_shared++;
+  }
+}
+
+
+void
+seq_consumer_main( void * vp ) {
+  seq_args_t * args = (seq_args_t*)vp;
+  args->rtn  = fd_fibre_wait_seq_ge( &seq_shared, args->seq_min, args->poll, args->timeout );
+  args->time = now;
+}
+
+
+void
+run_seq_test( void ) {
+  ulong stack_sz = 1<<16;
+
+  now        = 0;
+  seq_shared = (ulong)-5L; /* wraps around during the test */
+
+  long       period = (long)1e6;
+  seq_args_t arg0   = { .seq_min = 2UL,  .poll = (long)1e5, .timeout = (long)1e9, .rtn = -1, .time = -1 };
+  seq_args_t arg1   = { .seq_min = 20UL, .poll = (long)1e5, .timeout = (long)3e6, .rtn = -1, .time = -1 };
+
+  void * mem0 = aligned_alloc( fd_fibre_start_align(), fd_fibre_start_footprint( stack_sz ) );
+  void * mem1 = aligned_alloc( fd_fibre_start_align(), fd_fibre_start_footprint( stack_sz ) );
+  void * mem2 = aligned_alloc( fd_fibre_start_align(), fd_fibre_start_footprint( stack_sz ) );
+
+  fd_fibre_t * producer  = fd_fibre_start( mem0, stack_sz, seq_producer_main, &period );
+  fd_fibre_t * consumer0 = fd_fibre_start( mem1, stack_sz, seq_consumer_main, &arg0   );
+  fd_fibre_t * consumer1 = fd_fibre_start( mem2, stack_sz, seq_consumer_main, &arg1   );
+
+  fd_fibre_schedule( producer  );
+  fd_fibre_schedule( consumer0 );
+  fd_fibre_schedule( consumer1 );
+
+  while( 1 ) {
+    long timeout = fd_fibre_schedule_run();
+    if( timeout == -1 ) break;
+    now = timeout;
+  }
+
+  /* seq reaches 2 after 7 periods, observed at the next poll */
+  if( arg0.rtn != 0 || arg0.time < 7L*period || arg0.time > 7L*period + (long)1e5 ) {
+    printf( "seq test: wait failed rtn %d time %ld\n", arg0.rtn, arg0.time );
+    exit(1);
+  }
+
+  /* seq never reaches 20 */
+  if( arg1.rtn != 1 || arg1.time != (long)3e6 ) {
+    printf( "seq test: timeout failed rtn %d time %ld\n", arg1.rtn, arg1.time );
+    exit(1);
+  }
+
+  /* outside of a schedule, a satisfied wait returns immediately */
+  if( fd_fibre_wait_seq_ge( &seq_shared, 5UL, 1L, 0L ) != 0 ||
+      fd_fibre_wait_seq_ge( &seq_shared, 6UL, 1L, 0L ) != 1 ) {
+    printf( "seq test: unscheduled wait failed\n" );
+    exit(1);
+  }
+
+  fd_fibre_free( producer  );
+  fd_fibre_free( consumer0 );
+  fd_fibre_free( consumer1 );
+
+  free( mem0 );
+  free( mem1 );
+  free( mem2 );
+
+  printf( "seq test complete\n" ); fflush( stdout );
+}
+
+
 int
 main( int argc, char ** argv ) {
   (void)argc;
@@ -495,6 +712,12 @@ main( int argc, char ** argv ) {
 
   run_test_pipe_filter();
 
+  run_order_test();
+
+  run_seq_test();
+
+  run_swap_test();
+
   fd_fibre_free( main_fibre );
   free( main_fibre_mem );
 
@@ -2,3 +2,9 @@ $(call add-hdrs,fd_io.h)
 $(call add-objs,fd_io,fd_util)
 $(call make-unit-test,test_io,test_io,fd_util)
 $(call run-unit-test,test_io,)
+ifdef FD_HAS_LINUX
+$(call add-hdrs,fd_io_uring.h)
+$(call add-objs,fd_io_uring,fd_util)
+$(call make-unit-test,test_io_uring,test_io_uring,fd_util)
+$(call run-unit-test,test_io_uring,)
+endif
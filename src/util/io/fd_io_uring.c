@@ -0,0 +1,258 @@
+#define _GNU_SOURCE
+#include "fd_io_uring.h"
+#include "../log/fd_log.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/* FD_IO_URING_SQPOLL_IDLE_MS is how long the kernel SQPOLL thread
+   spins without new submissions before going to sleep. */
+
+#define FD_IO_URING_SQPOLL_IDLE_MS (1000U)
+
+static void
+fd_io_uring_private_unmap( fd_io_uring_t * ring ) {
+  if( ring->sqe_map ) munmap( ring->sqe_map, ring->sqe_map_sz );
+  if( ring->cq_map && ring->cq_map!=ring->sq_map ) munmap( ring->cq_map, ring->cq_map_sz );
+  if( ring->sq_map ) munmap( ring->sq_map, ring->sq_map_sz );
+  ring->sqe_map = NULL;
+  ring->cq_map  = NULL;
+  ring->sq_map  = NULL;
+}
+
+fd_io_uring_t *
+fd_io_uring_init( fd_io_uring_t * ring,
+                  uint            depth,
+                  uint            flags ) {
+
+  if( FD_UNLIKELY( !ring ) ) {
+    FD_LOG_WARNING(( "NULL ring" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( (!depth) | (depth>FD_IO_URING_DEPTH_MAX) ) ) {
+    FD_LOG_WARNING(( "bad depth %u", depth ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( flags & ~FD_IO_URING_FLAG_SQPOLL ) ) {
+    FD_LOG_WARNING(( "unsupported flags %x", flags ));
+    return NULL;
+  }
+
+  memset( ring, 0, sizeof(fd_io_uring_t) );
+  ring->fd    = -1;
+  ring->flags = flags;
+
+  struct io_uring_params params;
+  memset( &params, 0, sizeof(params) );
+  params.flags      = IORING_SETUP_CQSIZE;
+  params.cq_entries = 2U*depth;
+  if( flags & FD_IO_URING_FLAG_SQPOLL ) {
+    params.flags         |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = FD_IO_URING_SQPOLL_IDLE_MS;
+  }
+
+  int fd = (int)syscall( SYS_io_uring_setup, depth, &params );
+  if( FD_UNLIKELY( fd<0 ) ) {
+    FD_LOG_WARNING(( "io_uring_setup(%u,%s) failed (%i-%s)", depth, (flags & FD_IO_URING_FLAG_SQPOLL) ? "sqpoll" : "-",
+                     errno, fd_io_strerror( errno ) ));
+    return NULL;
+  }
+  ring->fd       = fd;
+  ring->features = params.features;
+
+  /* Map the rings.  With IORING_FEAT_SINGLE_MMAP, the submission and
+     completion rings share one mapping. */
+
+  ulong sq_map_sz = (ulong)params.sq_off.array + (ulong)params.sq_entries*sizeof(uint);
+  ulong cq_map_sz = (ulong)params.cq_off.cqes  + (ulong)params.cq_entries*sizeof(struct io_uring_cqe);
+  int   single    = !!(params.features & IORING_FEAT_SINGLE_MMAP);
+  if( single ) sq_map_sz = cq_map_sz = fd_ulong_max( sq_map_sz, cq_map_sz );
+
+  void * sq_map = mmap( NULL, sq_map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, (long)IORING_OFF_SQ_RING );
+  if( FD_UNLIKELY( sq_map==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(sq ring,%lu KiB) failed (%i-%s)", sq_map_sz>>10, errno, fd_io_strerror( errno ) ));
+    goto fail;
+  }
+  ring->sq_map    = sq_map;
+  ring->sq_map_sz = sq_map_sz;
+
+  void * cq_map = sq_map;
+  if( !single ) {
+    cq_map = mmap( NULL, cq_map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, (long)IORING_OFF_CQ_RING );
+    if( FD_UNLIKELY( cq_map==MAP_FAILED ) ) {
+      FD_LOG_WARNING(( "mmap(cq ring,%lu KiB) failed (%i-%s)", cq_map_sz>>10, errno, fd_io_strerror( errno ) ));
+      goto fail;
+    }
+  }
+  ring->cq_map    = cq_map;
+  ring->cq_map_sz = cq_map_sz;
+
+  ulong  sqe_map_sz = (ulong)params.sq_entries*sizeof(struct io_uring_sqe);
+  void * sqe_map    = mmap( NULL, sqe_map_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, (long)IORING_OFF_SQES );
+  if( FD_UNLIKELY( sqe_map==MAP_FAILED ) ) {
+    FD_LOG_WARNING(( "mmap(sqes,%lu KiB) failed (%i-%s)", sqe_map_sz>>10, errno, fd_io_strerror( errno ) ));
+    goto fail;
+  }
+  ring->sqe_map    = sqe_map;
+  ring->sqe_map_sz = sqe_map_sz;
+
+  uchar * sq = (uchar *)sq_map;
+  uchar * cq = (uchar *)cq_map;
+
+  ring->sq_khead  = (uint *)(sq + params.sq_off.head );
+  ring->sq_ktail  = (uint *)(sq + params.sq_off.tail );
+  ring->sq_kflags = (uint *)(sq + params.sq_off.flags);
+  ring->sqe       = (struct io_uring_sqe *)sqe_map;
+  ring->sq_mask   = *(uint *)(sq + params.sq_off.ring_mask);
+  ring->sq_depth  = params.sq_entries;
+  ring->sq_tail   = *ring->sq_ktail;
+
+  ring->cq_khead  = (uint *)(cq + params.cq_off.head);
+  ring->cq_ktail  = (uint *)(cq + params.cq_off.tail);
+  ring->cqe       = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+  ring->cq_mask   = *(uint *)(cq + params.cq_off.ring_mask);
+  ring->cq_depth  = params.cq_entries;
+
+  /* sqes are always submitted in ring order, so the submission index
+     array is the identity */
+
+  uint * sq_array = (uint *)(sq + params.sq_off.array);
+  for( uint i=0U; i<params.sq_entries; i++ ) sq_array[i] = i;
+
+  return ring;
+
+fail:
+  fd_io_uring_private_unmap( ring );
+  close( fd );
+  ring->fd = -1;
+  return NULL;
+}
+
+void *
+fd_io_uring_fini( fd_io_uring_t * ring ) {
+
+  if( FD_UNLIKELY( !ring ) ) {
+    FD_LOG_WARNING(( "NULL ring" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( ring->fd<0 ) ) {
+    FD_LOG_WARNING(( "ring not initialized" ));
+    return NULL;
+  }
+
+  fd_io_uring_private_unmap( ring );
+
+  if( FD_UNLIKELY( close( ring->fd ) ) )
+    FD_LOG_WARNING(( "close(io_uring) failed (%i-%s); attempting to continue", errno, fd_io_strerror( errno ) ));
+
+  ring->fd = -1;
+  return ring;
+}
+
+static int
+fd_io_uring_private_register( fd_io_uring_t * ring,
+                              uint            opcode,
+                              void const *    arg,
+                              uint            arg_cnt,
+                              char const *    what ) {
+  if( FD_UNLIKELY( syscall( SYS_io_uring_register, ring->fd, opcode, arg, arg_cnt ) ) ) {
+    int err = errno;
+    FD_LOG_WARNING(( "io_uring_register(%s,%u) failed (%i-%s)", what, arg_cnt, err, fd_io_strerror( err ) ));
+    return err;
+  }
+  return 0;
+}
+
+int
+fd_io_uring_register_buffers( fd_io_uring_t *      ring,
+                              struct iovec const * iov,
+                              uint                 iov_cnt ) {
+  if( FD_UNLIKELY( (!iov) | (!iov_cnt) ) ) {
+    FD_LOG_WARNING(( "no buffers to register" ));
+    return EINVAL;
+  }
+  return fd_io_uring_private_register( ring, IORING_REGISTER_BUFFERS, iov, iov_cnt, "buffers" );
+}
+
+int
+fd_io_uring_register_files( fd_io_uring_t * ring,
+                            int const *     fd,
+                            uint            fd_cnt ) {
+  if( FD_UNLIKELY( (!fd) | (!fd_cnt) ) ) {
+    FD_LOG_WARNING(( "no files to register" ));
+    return EINVAL;
+  }
+  return fd_io_uring_private_register( ring, IORING_REGISTER_FILES, fd, fd_cnt, "files" );
+}
+
+int
+fd_io_uring_unregister_buffers( fd_io_uring_t * ring ) {
+  return fd_io_uring_private_register( ring, IORING_UNREGISTER_BUFFERS, NULL, 0U, "unregister buffers" );
+}
+
+int
+fd_io_uring_unregister_files( fd_io_uring_t * ring ) {
+  return fd_io_uring_private_register( ring, IORING_UNREGISTER_FILES, NULL, 0U, "unregister files" );
+}
+
+int
+fd_io_uring_submit( fd_io_uring_t * ring,
+                    uint            wait_cnt,
+                    uint *          _submit_cnt ) {
+
+  /* Publish the prepared sqes.  The sqe writes must be visible before
+     the tail update. */
+
+  uint publish_cnt = ring->sq_tail - *ring->sq_ktail;
+  if( FD_LIKELY( publish_cnt ) ) {
+    FD_COMPILER_MFENCE();
+    __atomic_store_n( ring->sq_ktail, ring->sq_tail, __ATOMIC_RELEASE );
+  }
+
+  uint enter_flags = wait_cnt ? IORING_ENTER_GETEVENTS : 0U;
+  uint to_submit;
+  int  need_enter;
+
+  if( ring->flags & FD_IO_URING_FLAG_SQPOLL ) {
+
+    /* The kernel thread consumes the published sqes asynchronously.
+       Only enter the kernel if it went to sleep (the tail store must
+       be ordered before the flags load, hence the full fence) or the
+       caller wants to wait for completions. */
+
+    __atomic_thread_fence( __ATOMIC_SEQ_CST );
+    if( FD_UNLIKELY( FD_VOLATILE_CONST( *ring->sq_kflags ) & IORING_SQ_NEED_WAKEUP ) ) enter_flags |= IORING_ENTER_SQ_WAKEUP;
+    to_submit  = publish_cnt;
+    need_enter = !!enter_flags;
+
+  } else {
+
+    /* Submit everything the kernel hasn't consumed yet (including any
+       sqes left over from a previous partial submit). */
+
+    to_submit  = ring->sq_tail - FD_VOLATILE_CONST( *ring->sq_khead );
+    need_enter = (!!to_submit) | (!!wait_cnt);
+
+  }
+
+  if( _submit_cnt ) *_submit_cnt = (ring->flags & FD_IO_URING_FLAG_SQPOLL) ? publish_cnt : 0U;
+
+  if( !need_enter ) return 0;
+
+  long rc = syscall( SYS_io_uring_enter, ring->fd, to_submit, wait_cnt, enter_flags, NULL, 0UL );
+  if( FD_UNLIKELY( rc<0L ) ) {
+    int err = errno;
+    if( FD_UNLIKELY( (err!=EINTR) & (err!=EAGAIN) & (err!=EBUSY) ) )
+      FD_LOG_WARNING(( "io_uring_enter(%u,%u,%x) failed (%i-%s)", to_submit, wait_cnt, enter_flags, err, fd_io_strerror( err ) ));
+    return err;
+  }
+
+  if( _submit_cnt && !(ring->flags & FD_IO_URING_FLAG_SQPOLL) ) *_submit_cnt = (uint)rc;
+  return 0;
+}
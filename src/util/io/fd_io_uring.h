@@ -0,0 +1,313 @@
+#ifndef HEADER_fd_src_util_io_fd_io_uring_h
+#define HEADER_fd_src_util_io_fd_io_uring_h
+
+/* fd_io_uring is a thin wrapper around Linux io_uring for deep queue
+   asynchronous file I/O (e.g. snapshot loads, blockstore archive reads
+   and checkpoint writes to NVMe) without blocking the calling tile.
+   It talks to the kernel directly (no liburing dependency).  Summary:
+
+     fd_io_uring_t ring[1];
+     if( FD_UNLIKELY( !fd_io_uring_init( ring, depth, 0U ) ) ) ... io_uring unavailable, fall back to fd_io_read / etc
+
+     ... optionally register buffers and files up front (registered
+     ... buffers skip the per I/O page pinning, registered files skip
+     ... the per I/O file table lookup)
+
+     fd_io_uring_register_buffers( ring, iov, iov_cnt );
+     fd_io_uring_register_files  ( ring, fds, fd_cnt  );
+
+     ... queue up a batch of I/O
+
+     for(...) {
+       struct io_uring_sqe * sqe = fd_io_uring_sqe_next( ring );
+       if( FD_UNLIKELY( !sqe ) ) break; ... submission queue full
+       fd_io_uring_prep_read_fixed( sqe, file_idx, buf, sz, off, buf_idx, user_data );
+       fd_io_uring_sqe_fixed_file ( sqe );
+     }
+
+     ... submit the batch with one syscall (zero syscalls in the
+     ... common case with FD_IO_URING_FLAG_SQPOLL), optionally waiting
+     ... for some completions
+
+     uint submit_cnt; int err = fd_io_uring_submit( ring, wait_cnt, &submit_cnt );
+
+     ... reap completions in batches
+
+     fd_io_uring_cqe_t cqe[ 64 ];
+     ulong cqe_cnt = fd_io_uring_reap( ring, cqe, 64UL );
+     for( ulong i=0UL; i<cqe_cnt; i++ ) ... cqe[i].user_data, cqe[i].res (bytes or -errno)
+
+     fd_io_uring_fini( ring );
+
+   A fd_io_uring_t is a local handle (like fd_io_buffered_istream_t) and
+   is not meant to be persistent or shared IPC.  A ring should be
+   driven by a single thread.
+
+   Sandboxing: create the ring and register buffers / files before
+   entering the sandbox (fd_io_uring_fd should be in the tile's allowed
+   file descriptors).  In steady state the ring only needs:
+
+     # io_uring: submit I/O and wait for completions
+     #
+     # arg 0 is the ring file descriptor.
+     io_uring_enter: (eq (arg 0) ring_fd)
+
+   in the tile's seccomp policy.  Note that I/O submitted through a ring
+   is not itself filtered by seccomp, so only the files a tile is meant
+   to access should be registered with (or opened before sandboxing
+   for) the ring.
+
+   No tile uses fd_io_uring yet and so no tile seccomp policy allows
+   io_uring_enter.  A tile adopting it must add the above to its
+   policy (and the ring fd to its allowed file descriptors) as part of
+   the change that does so. */
+
+#include "../bits/fd_bits.h"
+
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+
+/* FD_IO_URING_FLAG_* are flags for fd_io_uring_init.
+
+   SQPOLL has the kernel poll the submission queue from a kernel thread
+   such that submission usually doesn't need a syscall.  The kernel
+   thread sleeps after being idle for a while (and is woken by
+   fd_io_uring_submit as needed).  This trades a core's worth of kernel
+   polling for lower I/O latency. */
+
+#define FD_IO_URING_FLAG_SQPOLL (1U<<0)
+
+/* FD_IO_URING_DEPTH_MAX is the max supported queue depth (the kernel
+   limits the submission queue to 32768 entries). */
+
+#define FD_IO_URING_DEPTH_MAX (32768U)
+
+struct fd_io_uring_private {
+  int                   fd;         /* io_uring file descriptor, -1 if not initialized */
+  uint                  flags;      /* FD_IO_URING_FLAG_* used to init */
+  uint                  features;   /* IORING_FEAT_* supported by the kernel */
+
+  /* submission queue */
+
+  uint *                sq_khead;   /* kernel consumer index */
+  uint *                sq_ktail;   /* user producer index (published) */
+  uint *                sq_kflags;  /* IORING_SQ_* */
+  struct io_uring_sqe * sqe;        /* indexed [0,sq_depth) */
+  uint                  sq_mask;    /* sq_depth-1 */
+  uint                  sq_depth;   /* submission queue depth, power of 2 */
+  uint                  sq_tail;    /* local producer index, sqes [*sq_ktail,sq_tail) are prepared but unpublished */
+
+  /* completion queue */
+
+  uint *                cq_khead;   /* user consumer index */
+  uint *                cq_ktail;   /* kernel producer index */
+  struct io_uring_cqe * cqe;        /* indexed [0,cq_depth) */
+  uint                  cq_mask;    /* cq_depth-1 */
+  uint                  cq_depth;   /* completion queue depth, power of 2 */
+
+  /* kernel shared mappings */
+
+  void *                sq_map;
+  ulong                 sq_map_sz;
+  void *                cq_map;     /* ==sq_map if IORING_FEAT_SINGLE_MMAP */
+  ulong                 cq_map_sz;
+  void *                sqe_map;
+  ulong                 sqe_map_sz;
+};
+
+typedef struct fd_io_uring_private fd_io_uring_t;
+
+/* fd_io_uring_cqe_t is a reaped completion.  (struct io_uring_cqe has
+   a flexible array member and so can't be used in arrays.) */
+
+struct fd_io_uring_cqe {
+  ulong user_data; /* user_data given at prep time */
+  int   res;       /* operation result (e.g. bytes transferred or a negative errno) */
+  uint  flags;     /* IORING_CQE_F_* */
+};
+
+typedef struct fd_io_uring_cqe fd_io_uring_cqe_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* fd_io_uring_init creates an io_uring with a submission queue of at
+   least depth entries (rounded up to a power of 2 by the kernel,
+   depth in [1,FD_IO_URING_DEPTH_MAX]) and a completion queue of twice
+   that.  flags is a bit-or of FD_IO_URING_FLAG_*.  Returns ring on
+   success and NULL on failure (logs details, e.g. the kernel doesn't
+   support io_uring or it was disabled by kernel.io_uring_disabled).  On
+   success, the caller has a ring and should fini it when done. */
+
+fd_io_uring_t *
+fd_io_uring_init( fd_io_uring_t * ring,
+                  uint            depth,
+                  uint            flags );
+
+/* fd_io_uring_fini destroys a ring.  Any I/O still in flight is
+   canceled by the kernel (the memory referenced by it should not be
+   freed until fini returns).  Registered buffers and files are
+   unregistered.  Returns ring on success (ring will no longer be
+   initialized) and NULL on failure (logs details). */
+
+void *
+fd_io_uring_fini( fd_io_uring_t * ring );
+
+/* fd_io_uring_{fd,depth} return the ring's file descriptor and
+   submission queue depth.  Assumes ring is initialized. */
+
+FD_FN_PURE static inline int  fd_io_uring_fd   ( fd_io_uring_t const * ring ) { return ring->fd;       }
+FD_FN_PURE static inline uint fd_io_uring_depth( fd_io_uring_t const * ring ) { return ring->sq_depth; }
+
+/* fd_io_uring_register_buffers registers iov_cnt buffers described by
+   iov with the ring for use with fd_io_uring_prep_{read,write}_fixed
+   (buf_idx indexes iov).  fd_io_uring_register_files registers fd_cnt
+   open files for use by index with fd_io_uring_sqe_fixed_file (the
+   caller can close its copy of the files afterward).  Only one set of
+   each can be registered at a time.  fd_io_uring_unregister_{buffers,
+   files} undoes the corresponding registration.  These return 0 on
+   success and a strerror compatible error code on failure (logs
+   details, e.g. ENOMEM if the buffers exceed RLIMIT_MEMLOCK). */
+
+int fd_io_uring_register_buffers  ( fd_io_uring_t * ring, struct iovec const * iov, uint iov_cnt );
+int fd_io_uring_register_files    ( fd_io_uring_t * ring, int const *          fd,  uint fd_cnt  );
+int fd_io_uring_unregister_buffers( fd_io_uring_t * ring );
+int fd_io_uring_unregister_files  ( fd_io_uring_t * ring );
+
+/* fd_io_uring_sq_free returns the number of sqes that can currently be
+   acquired.  fd_io_uring_sqe_next acquires the next sqe of the
+   submission queue and returns a pointer to it (zero initialized) or
+   NULL if the submission queue is full (in which case the caller should
+   submit and / or reap before trying again).  The sqe should be
+   prepared with one of the fd_io_uring_prep_* below before the next
+   submit. */
+
+static inline uint
+fd_io_uring_sq_free( fd_io_uring_t const * ring ) {
+  uint head = __atomic_load_n( ring->sq_khead, __ATOMIC_ACQUIRE );
+  return ring->sq_depth - (ring->sq_tail - head);
+}
+
+static inline struct io_uring_sqe *
+fd_io_uring_sqe_next( fd_io_uring_t * ring ) {
+  if( FD_UNLIKELY( !fd_io_uring_sq_free( ring ) ) ) return NULL;
+  struct io_uring_sqe * sqe = ring->sqe + (ring->sq_tail & ring->sq_mask);
+  ring->sq_tail++;
+  *sqe = (struct io_uring_sqe){0};
+  return sqe;
+}
+
+/* fd_io_uring_prep_* prepare an acquired sqe for an operation.
+   user_data is returned verbatim in the operation's cqe.  fd is a file
+   descriptor or, if fd_io_uring_sqe_fixed_file is also applied, a
+   registered file index.  For the fixed variants, buf must lie within
+   registered buffer buf_idx.  off is the file offset (-1 to use and
+   update the file's current offset).  The memory referenced by an I/O
+   should not be touched until its cqe is reaped. */
+
+static inline void
+fd_io_uring_prep_rw( struct io_uring_sqe * sqe,
+                     uint                  op,
+                     int                   fd,
+                     void const *          buf,
+                     uint                  sz,
+                     ulong                 off,
+                     ulong                 user_data ) {
+  sqe->opcode    = (uchar)op;
+  sqe->fd        = fd;
+  sqe->addr      = (ulong)buf;
+  sqe->len       = sz;
+  sqe->off       = off;
+  sqe->user_data = user_data;
+}
+
+static inline void
+fd_io_uring_prep_read( struct io_uring_sqe * sqe, int fd, void * buf, uint sz, ulong off, ulong user_data ) {
+  fd_io_uring_prep_rw( sqe, IORING_OP_READ, fd, buf, sz, off, user_data );
+}
+
+static inline void
+fd_io_uring_prep_write( struct io_uring_sqe * sqe, int fd, void const * buf, uint sz, ulong off, ulong user_data ) {
+  fd_io_uring_prep_rw( sqe, IORING_OP_WRITE, fd, buf, sz, off, user_data );
+}
+
+static inline void
+fd_io_uring_prep_read_fixed( struct io_uring_sqe * sqe, int fd, void * buf, uint sz, ulong off, ushort buf_idx, ulong user_data ) {
+  fd_io_uring_prep_rw( sqe, IORING_OP_READ_FIXED, fd, buf, sz, off, user_data );
+  sqe->buf_index = buf_idx;
+}
+
+static inline void
+fd_io_uring_prep_write_fixed( struct io_uring_sqe * sqe, int fd, void const * buf, uint sz, ulong off, ushort buf_idx, ulong user_data ) {
+  fd_io_uring_prep_rw( sqe, IORING_OP_WRITE_FIXED, fd, buf, sz, off, user_data );
+  sqe->buf_index = buf_idx;
+}
+
+/* fd_io_uring_prep_fsync syncs fd (data only if datasync).  Use
+   fd_io_uring_sqe_drain (or wait for the writes' cqes) to order it
+   after previously submitted writes. */
+
+static inline void
+fd_io_uring_prep_fsync( struct io_uring_sqe * sqe, int fd, int datasync, ulong user_data ) {
+  fd_io_uring_prep_rw( sqe, IORING_OP_FSYNC, fd, NULL, 0U, 0UL, user_data );
+  sqe->fsync_flags = datasync ? IORING_FSYNC_DATASYNC : 0U;
+}
+
+/* fd_io_uring_sqe_fixed_file indicates sqe's fd is a registered file
+   index.  fd_io_uring_sqe_drain indicates sqe should not start until
+   all previously submitted sqes complete.  fd_io_uring_sqe_link
+   indicates the next sqe should not start until sqe completes
+   successfully. */
+
+static inline void fd_io_uring_sqe_fixed_file( struct io_uring_sqe * sqe ) { sqe->flags = (uchar)(sqe->flags | IOSQE_FIXED_FILE); }
+static inline void fd_io_uring_sqe_drain     ( struct io_uring_sqe * sqe ) { sqe->flags = (uchar)(sqe->flags | IOSQE_IO_DRAIN  ); }
+static inline void fd_io_uring_sqe_link      ( struct io_uring_sqe * sqe ) { sqe->flags = (uchar)(sqe->flags | IOSQE_IO_LINK   ); }
+
+/* fd_io_uring_submit publishes all prepared sqes to the kernel and, if
+   wait_cnt is non-zero, blocks until at least wait_cnt cqes are ready
+   to reap.  This is at most one syscall for the whole batch (and none
+   if SQPOLL and the kernel poller is awake and wait_cnt is zero).
+   Returns 0 on success and a strerror compatible error code on failure
+   (EINTR, EAGAIN and EBUSY are transient: reap some completions and / or
+   try again).  On success, *_submit_cnt (if non-NULL) holds the number
+   of sqes the kernel consumed in this call (for SQPOLL, the number of
+   sqes handed to the kernel poller).  Prepared sqes the kernel didn't
+   consume stay queued and are retried by the next submit. */
+
+int
+fd_io_uring_submit( fd_io_uring_t * ring,
+                    uint            wait_cnt,
+                    uint *          _submit_cnt );
+
+/* fd_io_uring_cq_ready returns the number of cqes ready to reap.
+   fd_io_uring_reap copies up to max ready cqes into cqe (indexed
+   [0,max)), marks them as consumed and returns the number copied.  This
+   never blocks (use fd_io_uring_submit with wait_cnt to block).  For
+   each cqe, user_data is the value given at prep time and res is the
+   operation result (e.g. bytes transferred, which can be less than
+   requested, or a negative errno). */
+
+static inline uint
+fd_io_uring_cq_ready( fd_io_uring_t const * ring ) {
+  uint tail = __atomic_load_n( ring->cq_ktail, __ATOMIC_ACQUIRE );
+  return tail - *ring->cq_khead;
+}
+
+static inline ulong
+fd_io_uring_reap( fd_io_uring_t *     ring,
+                  fd_io_uring_cqe_t * cqe,
+                  ulong               max ) {
+  uint  head = *ring->cq_khead;
+  ulong cnt  = fd_ulong_min( (ulong)fd_io_uring_cq_ready( ring ), max );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    struct io_uring_cqe const * kcqe = ring->cqe + ((head+(uint)i) & ring->cq_mask);
+    cqe[i].user_data = kcqe->user_data;
+    cqe[i].res       = kcqe->res;
+    cqe[i].flags     = kcqe->flags;
+  }
+  __atomic_store_n( ring->cq_khead, head + (uint)cnt, __ATOMIC_RELEASE );
+  return cnt;
+}
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_util_io_fd_io_uring_h */
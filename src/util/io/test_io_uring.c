@@ -0,0 +1,182 @@
+#include "../fd_util.h"
+#include "fd_io_uring.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#define BLK_SZ  (16384UL)
+#define BLK_CNT (256UL)
+
+/* test_ring writes BLK_CNT random blocks to fd through ring with deep
+   queues (registered buffer / file if fixed), syncs, reads them back in
+   a random order and checks the contents. */
+
+static void
+test_ring( fd_io_uring_t * ring,
+           int             fd,
+           int             fixed,
+           uchar *         wbuf,
+           uchar *         rbuf,
+           fd_rng_t *      rng ) {
+
+  for( ulong i=0UL; i<BLK_CNT*BLK_SZ; i++ ) wbuf[i] = fd_rng_uchar( rng );
+  memset( rbuf, 0, BLK_CNT*BLK_SZ );
+
+  int file = fd;
+  if( fixed ) {
+    struct iovec iov[2] = { { .iov_base = wbuf, .iov_len = BLK_CNT*BLK_SZ },
+                            { .iov_base = rbuf, .iov_len = BLK_CNT*BLK_SZ } };
+    FD_TEST( !fd_io_uring_register_buffers( ring, iov, 2U ) );
+    FD_TEST( !fd_io_uring_register_files  ( ring, &fd, 1U ) );
+    file = 0;
+  }
+
+  fd_io_uring_cqe_t cqe[ 32 ];
+  ulong depth = fd_io_uring_depth( ring );
+
+  /* Writes (and a trailing fsync after all of them) */
+
+  ulong issued = 0UL;
+  ulong reaped = 0UL;
+  uchar seen[ BLK_CNT+1UL ]; memset( seen, 0, sizeof(seen) );
+  while( reaped<BLK_CNT+1UL ) {
+    while( issued<BLK_CNT+1UL ) {
+      struct io_uring_sqe * sqe = fd_io_uring_sqe_next( ring );
+      if( !sqe ) break;
+      if( issued<BLK_CNT ) {
+        uchar const * buf = wbuf + issued*BLK_SZ;
+        if( fixed ) fd_io_uring_prep_write_fixed( sqe, file, buf, (uint)BLK_SZ, issued*BLK_SZ, 0, issued );
+        else        fd_io_uring_prep_write      ( sqe, file, buf, (uint)BLK_SZ, issued*BLK_SZ,    issued );
+      } else {
+        fd_io_uring_prep_fsync( sqe, file, 1, issued );
+        fd_io_uring_sqe_drain( sqe );
+      }
+      if( fixed ) fd_io_uring_sqe_fixed_file( sqe );
+      issued++;
+    }
+    FD_TEST( fd_io_uring_sq_free( ring )<=depth );
+
+    int err = fd_io_uring_submit( ring, 1U, NULL );
+    FD_TEST( !err || err==EINTR || err==EAGAIN || err==EBUSY );
+
+    ulong cnt = fd_io_uring_reap( ring, cqe, 32UL );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      ulong idx = cqe[i].user_data;
+      FD_TEST( idx<=BLK_CNT && !seen[ idx ] );
+      FD_TEST( cqe[i].res==( idx<BLK_CNT ? (int)BLK_SZ : 0 ) );
+      seen[ idx ] = 1;
+    }
+    reaped += cnt;
+  }
+  FD_TEST( !fd_io_uring_cq_ready( ring ) );
+
+  /* Reads in a random order */
+
+  ulong order[ BLK_CNT ];
+  for( ulong i=0UL; i<BLK_CNT; i++ ) order[i] = i;
+  for( ulong i=BLK_CNT-1UL; i; i-- ) { ulong j = fd_rng_ulong_roll( rng, i+1UL ); fd_swap( order[i], order[j] ); }
+
+  issued = 0UL;
+  reaped = 0UL;
+  while( reaped<BLK_CNT ) {
+    while( issued<BLK_CNT ) {
+      struct io_uring_sqe * sqe = fd_io_uring_sqe_next( ring );
+      if( !sqe ) break;
+      ulong   blk = order[ issued ];
+      uchar * buf = rbuf + blk*BLK_SZ;
+      if( fixed ) { fd_io_uring_prep_read_fixed( sqe, file, buf, (uint)BLK_SZ, blk*BLK_SZ, 1, blk ); fd_io_uring_sqe_fixed_file( sqe ); }
+      else          fd_io_uring_prep_read      ( sqe, file, buf, (uint)BLK_SZ, blk*BLK_SZ,    blk );
+      issued++;
+    }
+
+    int err = fd_io_uring_submit( ring, 1U, NULL );
+    FD_TEST( !err || err==EINTR || err==EAGAIN || err==EBUSY );
+
+    ulong cnt = fd_io_uring_reap( ring, cqe, 32UL );
+    for( ulong i=0UL; i<cnt; i++ ) {
+      FD_TEST( cqe[i].user_data<BLK_CNT );
+      FD_TEST( cqe[i].res==(int)BLK_SZ );
+    }
+    reaped += cnt;
+  }
+
+  FD_TEST( !memcmp( wbuf, rbuf, BLK_CNT*BLK_SZ ) );
+
+  if( fixed ) {
+    FD_TEST( !fd_io_uring_unregister_files  ( ring ) );
+    FD_TEST( !fd_io_uring_unregister_buffers( ring ) );
+  }
+}
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  uint depth = fd_env_strip_cmdline_uint( &argc, &argv, "--depth", NULL, 64U );
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  /* Test bad args */
+
+  fd_io_uring_t ring[1];
+  FD_TEST( !fd_io_uring_init( NULL, depth, 0U ) );
+  FD_TEST( !fd_io_uring_init( ring, 0U,    0U ) );
+  FD_TEST( !fd_io_uring_init( ring, FD_IO_URING_DEPTH_MAX+1U, 0U ) );
+  FD_TEST( !fd_io_uring_init( ring, depth, ~0U ) );
+  FD_TEST( !fd_io_uring_fini( NULL ) );
+
+  if( FD_UNLIKELY( !fd_io_uring_init( ring, depth, 0U ) ) ) {
+    FD_LOG_WARNING(( "skip: io_uring not available" ));
+    fd_rng_delete( fd_rng_leave( rng ) );
+    fd_halt();
+    return 0;
+  }
+  FD_TEST( fd_io_uring_fd( ring )>=0 );
+  FD_TEST( fd_io_uring_depth( ring )>=depth && fd_ulong_is_pow2( (ulong)fd_io_uring_depth( ring ) ) );
+  FD_TEST( fd_io_uring_sq_free ( ring )==fd_io_uring_depth( ring ) );
+  FD_TEST( fd_io_uring_cq_ready( ring )==0U );
+
+  /* An empty submit is a no-op */
+
+  uint submit_cnt = 42U;
+  FD_TEST( !fd_io_uring_submit( ring, 0U, &submit_cnt ) && !submit_cnt );
+
+  char tmp_path[] = "/tmp/test_io_uring.XXXXXX";
+  int fd = mkstemp( tmp_path );
+  if( FD_UNLIKELY( fd==-1 ) ) FD_LOG_ERR(( "mkstemp failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  uchar * wbuf = aligned_alloc( 4096UL, BLK_CNT*BLK_SZ ); FD_TEST( wbuf );
+  uchar * rbuf = aligned_alloc( 4096UL, BLK_CNT*BLK_SZ ); FD_TEST( rbuf );
+
+  FD_LOG_NOTICE(( "Testing plain I/O (depth %u)", fd_io_uring_depth( ring ) ));
+  test_ring( ring, fd, 0, wbuf, rbuf, rng );
+
+  FD_LOG_NOTICE(( "Testing registered buffers and files" ));
+  test_ring( ring, fd, 1, wbuf, rbuf, rng );
+
+  FD_TEST( fd_io_uring_fini( ring )==ring );
+  FD_TEST( !fd_io_uring_fini( ring ) ); /* not initialized */
+
+  if( FD_LIKELY( fd_io_uring_init( ring, depth, FD_IO_URING_FLAG_SQPOLL ) ) ) {
+    FD_LOG_NOTICE(( "Testing SQPOLL" ));
+    test_ring( ring, fd, 1, wbuf, rbuf, rng );
+    FD_TEST( fd_io_uring_fini( ring )==ring );
+  } else {
+    FD_LOG_WARNING(( "skip: SQPOLL not available" ));
+  }
+
+  free( rbuf );
+  free( wbuf );
+
+  if( FD_UNLIKELY( close( fd ) ) ) FD_LOG_ERR(( "close failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+  if( FD_UNLIKELY( unlink( tmp_path ) ) ) FD_LOG_ERR(( "unlink failed (%i-%s)", errno, fd_io_strerror( errno ) ));
+
+  fd_rng_delete( fd_rng_leave( rng ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -1,4 +1,5 @@
-$(call add-hdrs,fd_log.h)
-$(call add-objs,fd_log,fd_util)
+$(call add-hdrs,fd_log.h fd_log_ring.h)
+$(call add-objs,fd_log fd_log_ring,fd_util)
 $(call make-unit-test,test_log,test_log,fd_util)
-
+$(call make-unit-test,test_log_ring,test_log_ring,fd_util)
+$(call run-unit-test,test_log_ring)
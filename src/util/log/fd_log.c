@@ -21,6 +21,7 @@
 #define _GNU_SOURCE
 
 #include "fd_log.h"
+#include "fd_log_ring.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -718,6 +719,26 @@ fd_log_private_hexdump_msg( char const * descr,
 # undef FD_LOG_HEXDUMP_ADD_TO_LOG_BUF
 }
 
+/* Async log ring attached to the calling thread, NULL if none */
+
+static FD_TL fd_log_ring_t * fd_log_private_ring; /* NULL on thread start */
+
+fd_log_ring_t *
+fd_log_ring_attach( fd_log_ring_t * ring ) {
+  fd_log_ring_t * old = fd_log_private_ring;
+  if( ring ) fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( ring->name ), fd_log_thread(), FD_LOG_NAME_MAX-1UL ) );
+  FD_COMPILER_MFENCE();
+  fd_log_private_ring = ring;
+  FD_COMPILER_MFENCE();
+  return old;
+}
+
+fd_log_ring_t * fd_log_ring_attached( void ) { return fd_log_private_ring; }
+
+/* Deduplication state for the calling thread's messages */
+
+static FD_TL fd_log_private_dedup_t fd_log_private_dedup_tl[1]; /* zeros on thread start */
+
 void
 fd_log_private_1( int          level,
                   long         now,
@@ -736,6 +757,38 @@ fd_log_private_1( int          level,
   char const * cpu    = fd_log_cpu();
   ulong        tid    = fd_log_tid();
 
+  /* Hand off the message to the async log ring if there is one.  ERR
+     and above come through here too but are always synchronous.  As
+     they are typically the last thing logged before the program exits,
+     write out anything still queued in the ring first so the messages
+     leading up to the error are not lost or shown after it. */
+
+  fd_log_ring_t * ring = fd_log_private_ring;
+  if( FD_UNLIKELY( ring ) ) {
+    if( FD_LIKELY( level<4 ) ) {
+      if( FD_LIKELY( fd_log_ring_publish( ring, level, now, tid, thread, cpu, file, line, func, msg ) ) ) return;
+    } else {
+      fd_log_ring_flush( ring );
+    }
+  }
+
+  fd_log_private_emit( level, now, file, line, func, msg, thread, cpu, tid, fd_log_private_dedup_tl );
+}
+
+void
+fd_log_private_emit( int                      level,
+                     long                     now,
+                     char const *             file,
+                     int                      line,
+                     char const *             func,
+                     char const *             msg,
+                     char const *             thread,
+                     char const *             cpu,
+                     ulong                    tid,
+                     fd_log_private_dedup_t * dedup ) {
+
+  if( level<fd_log_level_logfile() ) return;
+
   int log_fileno = FD_VOLATILE_CONST( fd_log_private_fileno );
   int to_logfile = (log_fileno!=-1);
   int to_stderr  = (level>=fd_log_level_stderr());
@@ -743,7 +796,7 @@ fd_log_private_1( int          level,
 
   /* Deduplicate the log if requested */
 
-  if( fd_log_private_dedup ) {
+  if( fd_log_private_dedup && dedup ) {
 
     /* Compute if this message appears to be a recent duplicate of
        a previous log message */
@@ -753,18 +806,18 @@ fd_log_private_1( int          level,
 
     static long const dedup_interval = 20000000L; /* 1/50 s */
 
-    static FD_TL int   init;      /* 0   on thread start */
-    static FD_TL ulong last_hash; /* 0UL on thread start */
-    static FD_TL long  then;      /* 0L  on thread start */
+    int   init      = dedup->init;
+    ulong last_hash = dedup->last_hash;
+    long  then      = dedup->then;
 
     int is_dup = init & (hash==last_hash) & ((now-then)<dedup_interval);
-    init = 1;
+    dedup->init = 1;
 
-    /* Update how many messages from this thread in row have been
+    /* Update how many messages from this stream in row have been
        duplicates */
 
-    static FD_TL ulong dedup_cnt;   /* 0UL on thread start */
-    static FD_TL int   in_dedup;    /* 0   on thread start */
+    ulong dedup_cnt = dedup->dedup_cnt;
+    int   in_dedup  = dedup->in_dedup;
 
     if( is_dup ) dedup_cnt++;
     else {
@@ -802,7 +855,7 @@ fd_log_private_1( int          level,
     static ulong const dedup_thresh   = 3UL;         /* let initial dedup_thresh duplicates go out the door */
     static long  const dedup_throttle = 1000000000L; /* ~1s, how often to update status on current duplication */
 
-    static FD_TL long dedup_last; /* 0L on thread start */
+    long dedup_last = dedup->dedup_last;
 
     if( dedup_cnt < dedup_thresh ) dedup_last = now;
     else {
@@ -823,8 +876,11 @@ fd_log_private_1( int          level,
       in_dedup = 1;
     }
 
-    last_hash = hash;
-    then      = now;
+    dedup->last_hash  = hash;
+    dedup->then       = now;
+    dedup->dedup_cnt  = dedup_cnt;
+    dedup->in_dedup   = in_dedup;
+    dedup->dedup_last = dedup_last;
 
     if( in_dedup ) return;
   }
@@ -617,6 +617,37 @@ fd_log_private_raw_2( char const * file,
                       char const * func,
                       char const * msg ) __attribute__((noreturn)); /* Let compiler know this will not be returning */
 
+/* fd_log_private_dedup_t is the state used to deduplicate a stream of
+   log messages (e.g. a thread's messages or an async log ring's). */
+
+struct fd_log_private_dedup {
+  int   init;       /* 0 if no messages seen yet */
+  ulong last_hash;  /* hash of the last message */
+  long  then;       /* time of the last message */
+  ulong dedup_cnt;  /* number of duplicates in a row */
+  int   in_dedup;   /* currently suppressing duplicates */
+  long  dedup_last; /* time of the last duplication status update */
+};
+
+typedef struct fd_log_private_dedup fd_log_private_dedup_t;
+
+/* fd_log_private_emit writes a message to the log file and stderr as
+   fd_log_private_1 does, attributing it to the given thread / cpu /
+   tid (which need not be the caller's).  dedup is the deduplication
+   state to use (NULL to not deduplicate). */
+
+void
+fd_log_private_emit( int                      level,
+                     long                     now,
+                     char const *             file,
+                     int                      line,
+                     char const *             func,
+                     char const *             msg,
+                     char const *             thread,
+                     char const *             cpu,
+                     ulong                    tid,
+                     fd_log_private_dedup_t * dedup );
+
 char const *
 fd_log_private_hexdump_msg( char const * tag,
                             void const * mem,
@@ -0,0 +1,286 @@
+#include "fd_log_ring.h"
+
+#include <limits.h>
+
+FD_FN_CONST ulong
+fd_log_ring_align( void ) {
+  return FD_LOG_RING_ALIGN;
+}
+
+FD_FN_CONST ulong
+fd_log_ring_footprint( ulong depth ) {
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( depth ) ) ) return 0UL;
+  if( FD_UNLIKELY( depth>(1UL<<32) ) ) return 0UL; /* avoid overflow */
+  return sizeof(fd_log_ring_t) + depth*sizeof(fd_log_ring_rec_t);
+}
+
+static inline fd_log_ring_rec_t *
+fd_log_ring_private_rec( fd_log_ring_t * ring ) {
+  return (fd_log_ring_rec_t *)(ring+1);
+}
+
+void *
+fd_log_ring_new( void * shmem,
+                 ulong  depth ) {
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_log_ring_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_log_ring_footprint( depth );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad depth %lu", depth ));
+    return NULL;
+  }
+
+  fd_log_ring_t * ring = (fd_log_ring_t *)shmem;
+  fd_memset( ring, 0, sizeof(fd_log_ring_t) );
+
+  ring->depth    = depth;
+  ring->prod_seq = 0UL;
+  ring->drop_cnt = 0UL;
+  ring->cons_seq = 0UL;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->magic ) = FD_LOG_RING_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_log_ring_t *
+fd_log_ring_join( void * shring ) {
+
+  if( FD_UNLIKELY( !shring ) ) {
+    FD_LOG_WARNING(( "NULL shring" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shring, fd_log_ring_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shring" ));
+    return NULL;
+  }
+
+  fd_log_ring_t * ring = (fd_log_ring_t *)shring;
+
+  if( FD_UNLIKELY( ring->magic!=FD_LOG_RING_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return ring;
+}
+
+void *
+fd_log_ring_leave( fd_log_ring_t * ring ) {
+
+  if( FD_UNLIKELY( !ring ) ) {
+    FD_LOG_WARNING(( "NULL ring" ));
+    return NULL;
+  }
+
+  return (void *)ring;
+}
+
+void *
+fd_log_ring_delete( void * shring ) {
+
+  if( FD_UNLIKELY( !shring ) ) {
+    FD_LOG_WARNING(( "NULL shring" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shring, fd_log_ring_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shring" ));
+    return NULL;
+  }
+
+  fd_log_ring_t * ring = (fd_log_ring_t *)shring;
+
+  if( FD_UNLIKELY( ring->magic!=FD_LOG_RING_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shring;
+}
+
+static inline void
+fd_log_ring_private_cstr_copy( char *       dst,
+                               ulong        dst_sz,
+                               char const * src ) {
+  fd_cstr_fini( fd_cstr_append_cstr_safe( fd_cstr_init( dst ), src ? src : "", dst_sz-1UL ) );
+}
+
+int
+fd_log_ring_publish( fd_log_ring_t * ring,
+                     int             level,
+                     long            now,
+                     ulong           tid,
+                     char const *    thread,
+                     char const *    cpu,
+                     char const *    file,
+                     int             line,
+                     char const *    func,
+                     char const *    msg ) {
+
+  ulong msg_len = msg ? strlen( msg ) : 0UL;
+  if( FD_UNLIKELY( msg_len>FD_LOG_RING_MSG_MAX ) ) return 0;
+
+  ulong depth = ring->depth;
+  ulong seq   = ring->prod_seq; /* Only written by us */
+  if( FD_UNLIKELY( (seq - FD_VOLATILE_CONST( ring->cons_seq ))>=depth ) ) {
+    FD_VOLATILE( ring->drop_cnt ) = ring->drop_cnt + 1UL;
+    return 1;
+  }
+
+  /* Make sure we don't overwrite the record before the consumer is
+     done reading it */
+
+  FD_COMPILER_MFENCE();
+
+  fd_log_ring_rec_t * rec = fd_log_ring_private_rec( ring ) + (seq & (depth-1UL));
+  rec->now     = now;
+  rec->tid     = tid;
+  rec->level   = level;
+  rec->line    = line;
+  rec->msg_len = msg_len;
+  fd_log_ring_private_cstr_copy( rec->thread, FD_LOG_NAME_MAX,     thread );
+  fd_log_ring_private_cstr_copy( rec->cpu,    FD_LOG_NAME_MAX,     cpu    );
+  fd_log_ring_private_cstr_copy( rec->file,   FD_LOG_RING_FILE_SZ, file   );
+  fd_log_ring_private_cstr_copy( rec->func,   FD_LOG_RING_FUNC_SZ, func   );
+  if( msg_len ) fd_memcpy( rec->msg, msg, msg_len );
+  rec->msg[ msg_len ] = '\0';
+
+  /* Record must be visible before the seq update */
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->prod_seq ) = seq+1UL;
+  FD_COMPILER_MFENCE();
+
+  return 1;
+}
+
+fd_log_ring_drain_t *
+fd_log_ring_drain_init( fd_log_ring_drain_t * drain,
+                        ulong                 rate,
+                        ulong                 burst ) {
+  fd_memset( drain, 0, sizeof(fd_log_ring_drain_t) );
+  drain->rate        = rate;
+  drain->burst       = fd_ulong_max( burst, 1UL );
+  drain->token_then  = 0L;
+  drain->token       = drain->burst;
+  drain->rate_drop   = 0UL;
+  drain->ring_drop   = 0UL;
+  drain->report_then = LONG_MIN;
+  return drain;
+}
+
+/* FD_LOG_RING_DRAIN_REPORT_INTERVAL is the min time in ns between
+   reports of dropped records for a ring. */
+
+#define FD_LOG_RING_DRAIN_REPORT_INTERVAL (1000000000L)
+
+ulong
+fd_log_ring_drain( fd_log_ring_t *       ring,
+                   fd_log_ring_drain_t * drain,
+                   long                  now,
+                   ulong                 max ) {
+
+  /* Refill the token bucket */
+
+  if( drain->rate ) {
+    long dt = now - drain->token_then;
+    if( FD_UNLIKELY( dt<0L ) ) dt = 0L;
+    ulong refill = (ulong)(((double)dt*(double)drain->rate)*1e-9);
+    if( refill ) {
+      drain->token      = fd_ulong_min( drain->token + fd_ulong_min( refill, drain->burst ), drain->burst );
+      drain->token_then = now;
+    }
+  }
+
+  /* Report drops (at most once per interval, so a drop storm doesn't
+     itself become a log storm) */
+
+  ulong ring_drop = fd_log_ring_drop_cnt( ring );
+  if( FD_UNLIKELY( (ring_drop!=drain->ring_drop) | (!!drain->rate_drop) ) &&
+      (drain->report_then==LONG_MIN || (now - drain->report_then)>=FD_LOG_RING_DRAIN_REPORT_INTERVAL) ) {
+    FD_LOG_WARNING(( "log ring for %s dropped %lu messages (ring full) and %lu messages (rate limited)",
+                     ring->name[0] ? ring->name : "(unattached)", ring_drop - drain->ring_drop, drain->rate_drop ));
+    drain->ring_drop   = ring_drop;
+    drain->rate_drop   = 0UL;
+    drain->report_then = now;
+  }
+
+  ulong depth = ring->depth;
+  ulong seq   = ring->cons_seq; /* Only written by us */
+  ulong avail = FD_VOLATILE_CONST( ring->prod_seq ) - seq;
+  ulong cnt   = fd_ulong_min( avail, max );
+
+  /* Record reads must not be hoisted above the prod_seq read */
+
+  FD_COMPILER_MFENCE();
+
+  fd_log_ring_rec_t const * rec0 = fd_log_ring_private_rec( ring );
+  for( ulong i=0UL; i<cnt; i++ ) {
+    fd_log_ring_rec_t const * rec = rec0 + ((seq+i) & (depth-1UL));
+
+    if( drain->rate ) {
+      if( FD_UNLIKELY( !drain->token ) ) { drain->rate_drop++; continue; }
+      drain->token--;
+    }
+
+    fd_log_private_emit( fd_int_min( fd_int_max( rec->level, 0 ), 3 ), rec->now, rec->file, rec->line, rec->func, rec->msg,
+                         rec->thread, rec->cpu, rec->tid, drain->dedup );
+  }
+
+  /* Release the records back to the producer */
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( ring->cons_seq ) = seq+cnt;
+  FD_COMPILER_MFENCE();
+
+  return cnt;
+}
+
+ulong
+fd_log_ring_flush( fd_log_ring_t * ring ) {
+  ulong depth = ring->depth;
+  ulong end   = ring->prod_seq; /* Only written by the caller */
+
+  /* Claim [seq,end) from the consumer before writing it out.  If the
+     consumer released some records in the meantime, retry with what is
+     left. */
+
+  ulong seq;
+  for(;;) {
+    seq = FD_VOLATILE_CONST( ring->cons_seq );
+    if( FD_UNLIKELY( (end-seq)>depth ) ) return 0UL; /* corrupt, nothing sensible to do on the way out */
+#   if FD_HAS_ATOMIC
+    if( FD_LIKELY( FD_ATOMIC_CAS( &ring->cons_seq, seq, end )==seq ) ) break;
+    FD_SPIN_PAUSE();
+#   else
+    FD_VOLATILE( ring->cons_seq ) = end;
+    break;
+#   endif
+  }
+
+  fd_log_ring_rec_t const * rec0 = fd_log_ring_private_rec( ring );
+  for( ulong s=seq; s!=end; s++ ) {
+    fd_log_ring_rec_t const * rec = rec0 + (s & (depth-1UL));
+    fd_log_private_emit( fd_int_min( fd_int_max( rec->level, 0 ), 3 ), rec->now, rec->file, rec->line, rec->func, rec->msg,
+                         rec->thread, rec->cpu, rec->tid, NULL );
+  }
+
+  return end - seq;
+}
@@ -0,0 +1,189 @@
+#ifndef HEADER_fd_src_util_log_fd_log_ring_h
+#define HEADER_fd_src_util_log_fd_log_ring_h
+
+/* fd_log_ring provides asynchronous logging.  A thread with a log ring
+   attached (fd_log_ring_attach) appends its DEBUG through WARNING log
+   messages as fixed size records to the ring instead of writing them to
+   the log file and stderr itself.  Another thread (typically in a
+   different process, e.g. a dedicated log tile) drains the ring with
+   fd_log_ring_drain, which deduplicates, rate limits and writes the
+   records out exactly as the producer would have.  This keeps a burst
+   of log messages (e.g. a WARNING storm during a network incident) from
+   turning into write / fsync system calls on a hot tile's critical
+   path.
+
+   ERR and above are unaffected: they are always written and flushed
+   synchronously by the logging thread before the program exits or
+   aborts, as documented in fd_log.h.  Messages too large for a record
+   (e.g. large hexdumps) are also written synchronously.  If the ring is
+   full, the message is dropped and counted (the drain reports the
+   number dropped), the producer never blocks.
+
+   A ring has a single producer thread and a single consumer thread.
+   The ring lives in shared memory and is position independent, so the
+   producer and consumer can be in different processes. */
+
+#include "fd_log.h"
+
+/* FD_LOG_RING_{ALIGN,MAGIC} are the shared memory alignment and magic
+   number of a log ring.  FD_LOG_RING_REC_SZ is the size of a record.
+   FD_LOG_RING_MSG_MAX is the max strlen of a message that can be
+   logged asynchronously. */
+
+#define FD_LOG_RING_ALIGN   (128UL)
+#define FD_LOG_RING_MAGIC   (0xfd1096a5c0de0000UL) /* fd log async code version 0 */
+#define FD_LOG_RING_REC_SZ  (2048UL)
+#define FD_LOG_RING_FILE_SZ (64UL)
+#define FD_LOG_RING_FUNC_SZ (64UL)
+#define FD_LOG_RING_MSG_MAX (FD_LOG_RING_REC_SZ - 32UL - 2UL*FD_LOG_NAME_MAX - FD_LOG_RING_FILE_SZ - FD_LOG_RING_FUNC_SZ - 1UL)
+
+/* fd_log_ring_rec_t is a record of a log message.  The strings are
+   copied (and truncated if necessary) from the producer. */
+
+struct fd_log_ring_rec {
+  long  now;                             /* fd_log_wallclock when logged */
+  ulong tid;                             /* fd_log_tid of the producer */
+  int   level;                           /* in [0,4) */
+  int   line;
+  ulong msg_len;                         /* strlen( msg ) */
+  char  thread[ FD_LOG_NAME_MAX     ];   /* fd_log_thread of the producer */
+  char  cpu   [ FD_LOG_NAME_MAX     ];   /* fd_log_cpu of the producer */
+  char  file  [ FD_LOG_RING_FILE_SZ ];
+  char  func  [ FD_LOG_RING_FUNC_SZ ];
+  char  msg   [ FD_LOG_RING_MSG_MAX+1UL ];
+};
+
+typedef struct fd_log_ring_rec fd_log_ring_rec_t;
+
+FD_STATIC_ASSERT( sizeof(fd_log_ring_rec_t)==FD_LOG_RING_REC_SZ, layout );
+
+/* fd_log_ring_t is the shared memory log ring.  The producer and
+   consumer sequence numbers are on separate cache lines. */
+
+struct __attribute__((aligned(FD_LOG_RING_ALIGN))) fd_log_ring_private {
+  ulong magic;                       /* ==FD_LOG_RING_MAGIC */
+  ulong depth;                       /* number of records, power of 2 */
+  char  name[ FD_LOG_NAME_MAX ];     /* fd_log_thread of the producer at attach, "" if not attached */
+
+  __attribute__((aligned(128))) ulong prod_seq; /* seq of the next record to publish, written by producer */
+  ulong                               drop_cnt; /* records dropped because the ring was full, written by producer */
+
+  __attribute__((aligned(128))) ulong cons_seq; /* seq of the next record to drain, written by consumer */
+
+  /* depth fd_log_ring_rec_t follow here */
+};
+
+typedef struct fd_log_ring_private fd_log_ring_t;
+
+/* fd_log_ring_drain_t is the consumer side state of a ring (dedup and
+   rate limiting).  This is local to the consumer and not meant to be
+   shared. */
+
+struct fd_log_ring_drain {
+  fd_log_private_dedup_t dedup[1];
+
+  ulong rate;         /* records per second allowed to be written, 0 for no rate limiting */
+  ulong burst;        /* max records that can be written in a burst */
+  long  token_then;   /* when tokens was last updated */
+  ulong token;        /* number of records that can currently be written, in [0,burst] */
+  ulong rate_drop;    /* number of records dropped by the rate limiter not yet reported */
+  ulong ring_drop;    /* ring->drop_cnt already reported */
+  long  report_then;  /* when drops were last reported, LONG_MIN if never */
+};
+
+typedef struct fd_log_ring_drain fd_log_ring_drain_t;
+
+FD_PROTOTYPES_BEGIN
+
+/* Usual shared memory object APIs.  depth is the number of records in
+   the ring and should be a power of 2 (at least 1).  A ring should not
+   be attached to a thread when left or deleted. */
+
+FD_FN_CONST ulong fd_log_ring_align    ( void );
+FD_FN_CONST ulong fd_log_ring_footprint( ulong depth ); /* 0 if depth invalid */
+
+void *          fd_log_ring_new   ( void * shmem, ulong depth );
+fd_log_ring_t * fd_log_ring_join  ( void * shring );
+void *          fd_log_ring_leave ( fd_log_ring_t * ring );
+void *          fd_log_ring_delete( void * shring );
+
+/* fd_log_ring_attach routes the DEBUG through WARNING log messages of
+   the calling thread to ring (ring==NULL restores synchronous logging
+   for the caller).  Returns the previously attached ring (NULL if
+   none).  The ring should only be attached to one thread at a time.
+   fd_log_ring_attached returns the ring attached to the calling thread
+   or NULL. */
+
+fd_log_ring_t * fd_log_ring_attach  ( fd_log_ring_t * ring );
+fd_log_ring_t * fd_log_ring_attached( void );
+
+/* fd_log_ring_publish is used by fd_log to append a message to a ring.
+   Returns 1 if the message was handled (published or dropped because
+   the ring was full) and 0 if the message must be logged synchronously
+   (e.g. too long). */
+
+int
+fd_log_ring_publish( fd_log_ring_t * ring,
+                     int             level,
+                     long            now,
+                     ulong           tid,
+                     char const *    thread,
+                     char const *    cpu,
+                     char const *    file,
+                     int             line,
+                     char const *    func,
+                     char const *    msg );
+
+/* fd_log_ring_{pending,drop_cnt} return the number of records waiting
+   to be drained and the number of records dropped because the ring was
+   full. */
+
+static inline ulong
+fd_log_ring_pending( fd_log_ring_t const * ring ) {
+  return FD_VOLATILE_CONST( ring->prod_seq ) - FD_VOLATILE_CONST( ring->cons_seq );
+}
+
+static inline ulong
+fd_log_ring_drop_cnt( fd_log_ring_t const * ring ) {
+  return FD_VOLATILE_CONST( ring->drop_cnt );
+}
+
+/* fd_log_ring_drain_init initializes the consumer state for a ring.
+   rate is the steady state number of records per second the drain will
+   write (0 means no rate limiting) and burst is the number of records
+   that can be written back-to-back above that rate.  Returns drain. */
+
+fd_log_ring_drain_t *
+fd_log_ring_drain_init( fd_log_ring_drain_t * drain,
+                        ulong                 rate,
+                        ulong                 burst );
+
+/* fd_log_ring_drain writes up to max records from ring to the log (as
+   the producer would have, subject to the calling process's log
+   levels and deduplication settings) and returns the number of records
+   consumed.  now is the current fd_log_wallclock.  Records over the
+   rate limit are dropped and periodically reported (as are records the
+   producer dropped because the ring was full) with a WARNING from the
+   caller. */
+
+ulong
+fd_log_ring_drain( fd_log_ring_t *       ring,
+                   fd_log_ring_drain_t * drain,
+                   long                  now,
+                   ulong                 max );
+
+/* fd_log_ring_flush writes the records pending in ring to the log
+   synchronously from the calling thread (without deduplication or rate
+   limiting) and returns the number written.  This is used by fd_log on
+   the producer thread before it writes an ERR or above message such
+   that messages logged just before a fatal error are not lost or shown
+   after it.  The flush claims the records from the consumer but a
+   consumer concurrently draining the same records might still write
+   some of them too (i.e. records can be duplicated but not lost). */
+
+ulong
+fd_log_ring_flush( fd_log_ring_t * ring );
+
+FD_PROTOTYPES_END
+
+#endif /* HEADER_fd_src_util_log_fd_log_ring_h */
@@ -0,0 +1,134 @@
+#include "../fd_util.h"
+#include "fd_log_ring.h"
+
+FD_STATIC_ASSERT( FD_LOG_RING_ALIGN ==128UL,  unit_test );
+FD_STATIC_ASSERT( FD_LOG_RING_REC_SZ==2048UL, unit_test );
+
+#define DEPTH (16UL)
+
+static uchar ring_mem[ sizeof(fd_log_ring_t) + DEPTH*sizeof(fd_log_ring_rec_t) ] __attribute__((aligned(FD_LOG_RING_ALIGN)));
+
+static char long_msg[ FD_LOG_RING_MSG_MAX+2UL ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  FD_TEST( fd_log_ring_align()==FD_LOG_RING_ALIGN );
+  FD_TEST( !fd_log_ring_footprint( 0UL ) );
+  FD_TEST( !fd_log_ring_footprint( 3UL ) );
+  FD_TEST( fd_log_ring_footprint( DEPTH )==sizeof(ring_mem) );
+
+  FD_TEST( !fd_log_ring_new( NULL,       DEPTH ) );
+  FD_TEST( !fd_log_ring_new( ring_mem+1, DEPTH ) );
+  FD_TEST( !fd_log_ring_new( ring_mem,   3UL   ) );
+  FD_TEST( !fd_log_ring_join( ring_mem ) ); /* bad magic */
+
+  fd_log_ring_t * ring = fd_log_ring_join( fd_log_ring_new( ring_mem, DEPTH ) ); FD_TEST( ring );
+  FD_TEST( !fd_log_ring_pending ( ring ) );
+  FD_TEST( !fd_log_ring_drop_cnt( ring ) );
+
+  /* Messages at or above the logfile level go to the ring when
+     attached */
+
+  int level_logfile = fd_log_level_logfile();
+  fd_log_level_logfile_set( 1 );
+
+  FD_TEST( !fd_log_ring_attached() );
+  FD_TEST( !fd_log_ring_attach( ring ) );
+  FD_TEST( fd_log_ring_attached()==ring );
+  FD_TEST( !strcmp( ring->name, fd_log_thread() ) );
+
+  FD_LOG_DEBUG((   "Test DEBUG   (filtered, not in ring)" ));
+  FD_LOG_INFO((    "Test INFO    (async)" ));
+  FD_LOG_NOTICE((  "Test NOTICE  (async)" ));
+  FD_LOG_WARNING(( "Test WARNING (async)" ));
+  FD_TEST( fd_log_ring_pending( ring )==3UL );
+
+  /* Messages too large for a record are logged synchronously */
+
+  memset( long_msg, 'x', FD_LOG_RING_MSG_MAX+1UL );
+  FD_LOG_NOTICE(( "%s", long_msg ));
+  FD_TEST( fd_log_ring_pending( ring )==3UL );
+  long_msg[ FD_LOG_RING_MSG_MAX ] = '\0';
+  FD_LOG_NOTICE(( "%s", long_msg ));
+  FD_TEST( fd_log_ring_pending( ring )==4UL );
+
+  fd_log_ring_rec_t const * rec = (fd_log_ring_rec_t const *)(ring+1);
+  FD_TEST( rec[0].level==1 && rec[1].level==2 && rec[2].level==3 );
+  FD_TEST( rec[0].tid==fd_log_tid() );
+  FD_TEST( !strcmp( rec[0].thread, fd_log_thread() ) );
+  FD_TEST( !strcmp( rec[0].cpu,    fd_log_cpu()    ) );
+  FD_TEST( !strcmp( rec[0].msg,    "Test INFO    (async)" ) );
+  FD_TEST( rec[3].msg_len==FD_LOG_RING_MSG_MAX );
+
+  /* Drain (the detach first so the drain's own messages are
+     synchronous) */
+
+  FD_TEST( fd_log_ring_attach( NULL )==ring );
+
+  fd_log_ring_drain_t drain[1];
+  FD_TEST( fd_log_ring_drain_init( drain, 0UL, 0UL )==drain );
+  long now = fd_log_wallclock();
+  FD_TEST( fd_log_ring_drain( ring, drain, now, 1UL )==1UL );
+  FD_TEST( fd_log_ring_pending( ring )==3UL );
+  FD_TEST( fd_log_ring_drain( ring, drain, now, ULONG_MAX )==3UL );
+  FD_TEST( !fd_log_ring_pending( ring ) );
+  FD_TEST( !fd_log_ring_drain( ring, drain, now, ULONG_MAX ) );
+
+  /* Flushing writes out pending records synchronously */
+
+  FD_TEST( !fd_log_ring_attach( ring ) );
+  for( ulong i=0UL; i<3UL; i++ ) FD_LOG_INFO(( "Test flush %lu", i ));
+  FD_TEST( fd_log_ring_pending( ring )==3UL );
+  FD_TEST( fd_log_ring_flush( ring )==3UL );
+  FD_TEST( !fd_log_ring_pending( ring ) );
+  FD_TEST( !fd_log_ring_flush( ring ) );
+  FD_TEST( fd_log_ring_attach( NULL )==ring );
+  FD_TEST( !fd_log_ring_drain( ring, drain, now, ULONG_MAX ) );
+
+  /* A full ring drops (and counts) rather than blocks */
+
+  FD_TEST( !fd_log_ring_attach( ring ) );
+  for( ulong i=0UL; i<DEPTH+5UL; i++ ) FD_LOG_INFO(( "Test fill %lu", i ));
+  FD_TEST( fd_log_ring_pending ( ring )==DEPTH );
+  FD_TEST( fd_log_ring_drop_cnt( ring )==5UL   );
+  FD_TEST( fd_log_ring_attach( NULL )==ring );
+
+  FD_TEST( fd_log_ring_drain( ring, drain, now, ULONG_MAX )==DEPTH ); /* warns about the 5 drops */
+  FD_TEST( drain->ring_drop==5UL );
+
+  /* Rate limiting: burst of 4, then 1 per 100 ms */
+
+  FD_TEST( fd_log_ring_drain_init( drain, 10UL, 4UL )==drain );
+  drain->ring_drop = fd_log_ring_drop_cnt( ring );
+
+  FD_TEST( !fd_log_ring_attach( ring ) );
+  for( ulong i=0UL; i<8UL; i++ ) FD_LOG_INFO(( "Test rate %lu", i ));
+  FD_TEST( fd_log_ring_attach( NULL )==ring );
+
+  now = fd_log_wallclock();
+  FD_TEST( fd_log_ring_drain( ring, drain, now, ULONG_MAX )==8UL );
+  FD_TEST( drain->rate_drop==4UL );
+  FD_TEST( !drain->token );
+
+  FD_TEST( !fd_log_ring_attach( ring ) );
+  for( ulong i=0UL; i<4UL; i++ ) FD_LOG_INFO(( "Test rate refill %lu", i ));
+  FD_TEST( fd_log_ring_attach( NULL )==ring );
+
+  FD_TEST( fd_log_ring_drain( ring, drain, now+200000000L, ULONG_MAX )==4UL ); /* reports the 4 rate drops, 2 tokens refilled */
+  FD_TEST( drain->rate_drop==2UL );
+
+  fd_log_level_logfile_set( level_logfile );
+
+  FD_TEST( !fd_log_ring_leave( NULL ) );
+  FD_TEST( fd_log_ring_leave( ring )==ring_mem );
+  FD_TEST( !fd_log_ring_delete( NULL ) );
+  FD_TEST( fd_log_ring_delete( ring_mem )==ring_mem );
+  FD_TEST( !fd_log_ring_join( ring_mem ) );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
@@ -309,6 +309,36 @@ fd_shmem_numa_validate( void const * mem,
                         ulong        page_cnt,
                         ulong        cpu_idx );
 
+/* fd_shmem_prefault populates the page_cnt page_sz pages pointed to by
+   mem for writing using up to thread_max threads (0 indicates to use
+   fd_shmem_prefault_thread_max()), each pinned to a different logical
+   cpu on the numa node near cpu_idx.  This is equivalent to touching
+   every page but the kernel page zeroing (which dominates the time to
+   create large regions) is done in parallel from cpus near the pages.
+   The threads inherit the caller's mempolicy so pages are placed as if
+   the caller had touched them.  Returns 0 on success and a strerror
+   friendly error code on failure (logs details).  In particular,
+   returns ENOMEM if there were not enough pages to back mem and EINVAL
+   if the kernel does not support MADV_POPULATE_WRITE (Linux 5.14+).
+   On failure, mem might be partially populated.
+
+   fd_shmem_prefault_thread_max returns the default number of threads
+   to use.  This is configured at thread group boot with
+   --shmem-prefault-thread-max / FD_SHMEM_PREFAULT_THREAD_MAX and is in
+   [1,FD_SHMEM_PREFAULT_THREAD_MAX]. */
+
+#define FD_SHMEM_PREFAULT_THREAD_MAX     (64UL)
+#define FD_SHMEM_PREFAULT_THREAD_DEFAULT (8UL)
+
+int
+fd_shmem_prefault( void * mem,
+                   ulong  page_sz,
+                   ulong  page_cnt,
+                   ulong  cpu_idx,
+                   ulong  thread_max );
+
+FD_FN_PURE ulong fd_shmem_prefault_thread_max( void );
+
 /* Creation/destruction APIs */
 
 /* fd_shmem_create_multi creates a shared memory region whose name is
@@ -327,6 +357,9 @@ fd_shmem_numa_validate( void const * mem,
    thread domain already exists), ftruncate fails (errno of ftruncate,
    e.g. no suitable memory available near cpu_idx), etc.
 
+   The pages of each subregion are populated in parallel with
+   fd_shmem_prefault from cpus near the subregion's cpu_idx.
+
    Note that each page_sz has its own namespace.  As such, names are
    unique over caller's shared memory domain for a given page_sz.  Names
    can be reused between two different page_sz (and such will correspond
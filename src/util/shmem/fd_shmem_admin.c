@@ -163,6 +163,162 @@ fd_shmem_numa_validate( void const * mem,
   return 0;
 }
 
+/* PREFAULT APIS ******************************************************/
+
+#ifndef MADV_POPULATE_WRITE /* Linux 5.14, older glibc headers might not have it */
+#define MADV_POPULATE_WRITE 23
+#endif
+
+static ulong fd_shmem_private_prefault_thread_max; /* 0UL at thread group start, initialized at boot */
+
+ulong fd_shmem_prefault_thread_max( void ) { return fd_shmem_private_prefault_thread_max; }
+
+/* fd_shmem_private_prefault_t describes a slice of a region to
+   populate.  err is set by whoever populated the slice. */
+
+struct fd_shmem_private_prefault {
+  void * mem;
+  ulong  sz;
+  int    err;
+};
+
+typedef struct fd_shmem_private_prefault fd_shmem_private_prefault_t;
+
+/* fd_shmem_private_prefault_slice populates a slice.  We use
+   MADV_POPULATE_WRITE rather than touching the pages such that a node
+   without enough free pages gives ENOMEM instead of SIGBUS (see
+   fd_shmem_create_multi for details). */
+
+static void *
+fd_shmem_private_prefault_slice( void * _slice ) {
+  fd_shmem_private_prefault_t * slice = (fd_shmem_private_prefault_t *)_slice;
+  slice->err = madvise( slice->mem, slice->sz, MADV_POPULATE_WRITE ) ? errno : 0;
+  return NULL;
+}
+
+int
+fd_shmem_prefault( void * mem,
+                   ulong  page_sz,
+                   ulong  page_cnt,
+                   ulong  cpu_idx,
+                   ulong  thread_max ) {
+
+  if( FD_UNLIKELY( !mem ) ) {
+    FD_LOG_WARNING(( "NULL mem" ));
+    return EINVAL;
+  }
+
+  if( FD_UNLIKELY( !fd_shmem_is_page_sz( page_sz ) ) ) {
+    FD_LOG_WARNING(( "bad page_sz (%lu)", page_sz ));
+    return EINVAL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)mem, page_sz ) ) ) {
+    FD_LOG_WARNING(( "misaligned mem" ));
+    return EINVAL;
+  }
+
+  if( FD_UNLIKELY( !((1UL<=page_cnt) & (page_cnt<=(((ulong)LONG_MAX)/page_sz))) ) ) {
+    FD_LOG_WARNING(( "bad page_cnt (%lu)", page_cnt ));
+    return EINVAL;
+  }
+
+  if( FD_UNLIKELY( !(cpu_idx<fd_shmem_cpu_cnt()) ) ) {
+    FD_LOG_WARNING(( "bad cpu_idx (%lu)", cpu_idx ));
+    return EINVAL;
+  }
+
+  if( !thread_max ) thread_max = fd_shmem_prefault_thread_max();
+  thread_max = fd_ulong_min( fd_ulong_min( thread_max, FD_SHMEM_PREFAULT_THREAD_MAX ), page_cnt );
+
+  /* Pick the logical cpus near cpu_idx to run the populate from.  The
+     kernel zeroes newly allocated pages from the faulting cpu so doing
+     this from cpus on the same numa node as the pages keeps the zeroing
+     traffic off the interconnect. */
+
+  ulong numa_idx = fd_shmem_numa_idx( cpu_idx );
+  ulong cpu_cnt  = fd_shmem_cpu_cnt();
+
+  ulong thread_cpu[ FD_SHMEM_PREFAULT_THREAD_MAX ];
+  ulong thread_cnt = 0UL;
+  for( ulong cpu=0UL; (cpu<cpu_cnt) & (thread_cnt<thread_max); cpu++ )
+    if( fd_shmem_numa_idx( cpu )==numa_idx ) thread_cpu[ thread_cnt++ ] = cpu;
+  thread_cnt = fd_ulong_max( thread_cnt, 1UL );
+
+  /* Partition the region into page aligned slices, one per thread */
+
+  fd_shmem_private_prefault_t slice[ FD_SHMEM_PREFAULT_THREAD_MAX ];
+  for( ulong thread_idx=0UL; thread_idx<thread_cnt; thread_idx++ ) {
+    ulong page0 = (page_cnt* thread_idx     ) / thread_cnt;
+    ulong page1 = (page_cnt*(thread_idx+1UL)) / thread_cnt;
+    slice[ thread_idx ].mem = (uchar *)mem + page0*page_sz;
+    slice[ thread_idx ].sz  = (page1-page0)*page_sz;
+    slice[ thread_idx ].err = 0;
+  }
+
+# if FD_HAS_THREADS
+
+  /* Populate slices [1,thread_cnt) from worker threads and slice 0
+     from the caller.  Workers inherit the caller's mempolicy.  If we
+     cannot pin a worker (e.g. the caller's affinity excludes the numa
+     node), we run it unpinned.  If we cannot start a worker at all, the
+     caller populates its slice after its own. */
+
+  pthread_t thread     [ FD_SHMEM_PREFAULT_THREAD_MAX ];
+  int       thread_live[ FD_SHMEM_PREFAULT_THREAD_MAX ];
+
+  for( ulong thread_idx=1UL; thread_idx<thread_cnt; thread_idx++ ) {
+    thread_live[ thread_idx ] = 0;
+
+    pthread_attr_t attr[1];
+    if( FD_LIKELY( !pthread_attr_init( attr ) ) ) {
+      cpu_set_t cpuset[1];
+      CPU_ZERO( cpuset );
+      if( FD_LIKELY( thread_cpu[ thread_idx ]<(ulong)CPU_SETSIZE ) ) CPU_SET( thread_cpu[ thread_idx ], cpuset );
+      if( FD_LIKELY( !pthread_attr_setaffinity_np( attr, sizeof(cpu_set_t), cpuset ) ) &&
+          FD_LIKELY( !pthread_create( &thread[ thread_idx ], attr, fd_shmem_private_prefault_slice, &slice[ thread_idx ] ) ) )
+        thread_live[ thread_idx ] = 1;
+      pthread_attr_destroy( attr );
+    }
+
+    if( FD_UNLIKELY( !thread_live[ thread_idx ] ) &&
+        FD_LIKELY( !pthread_create( &thread[ thread_idx ], NULL, fd_shmem_private_prefault_slice, &slice[ thread_idx ] ) ) )
+      thread_live[ thread_idx ] = 1;
+  }
+
+  fd_shmem_private_prefault_slice( &slice[ 0 ] );
+
+  for( ulong thread_idx=1UL; thread_idx<thread_cnt; thread_idx++ ) {
+    if( FD_LIKELY( thread_live[ thread_idx ] ) ) {
+      if( FD_UNLIKELY( pthread_join( thread[ thread_idx ], NULL ) ) )
+        FD_LOG_ERR(( "pthread_join failed" )); /* never returns, slice might still be in use */
+    } else {
+      fd_shmem_private_prefault_slice( &slice[ thread_idx ] );
+    }
+  }
+
+# else
+
+  for( ulong thread_idx=0UL; thread_idx<thread_cnt; thread_idx++ ) fd_shmem_private_prefault_slice( &slice[ thread_idx ] );
+
+# endif
+
+  for( ulong thread_idx=0UL; thread_idx<thread_cnt; thread_idx++ ) {
+    int err = slice[ thread_idx ].err;
+    if( FD_UNLIKELY( err==EINVAL ) ) { /* Pre Linux 5.14 or a mapping that does not support populate */
+      FD_LOG_INFO(( "madvise(%p,%lu KiB,MADV_POPULATE_WRITE) not supported", slice[ thread_idx ].mem, slice[ thread_idx ].sz>>10 ));
+      return err;
+    }
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "madvise(%p,%lu KiB,MADV_POPULATE_WRITE) failed (%i-%s)",
+                       slice[ thread_idx ].mem, slice[ thread_idx ].sz>>10, err, fd_io_strerror( err ) ));
+      return err;
+    }
+  }
+
+  return 0;
+}
+
 /* SHMEM REGION CREATION AND DESTRUCTION ******************************/
 
 static int
@@ -323,7 +479,17 @@ fd_shmem_create_multi_flags( char const *  name,
        been fully backed by pages and these pages will remain resident
        in DRAM at least until the mapping is closed.  We can then
        proceed as usual without the risk of meeting SIGBUS or its
-       friends. */
+       friends.
+
+       Before that though, we populate the subregion in parallel from
+       cpus near sub_cpu_idx.  The page zeroing done by the kernel on
+       first touch dominates the time to create large regions and a
+       single thread cannot come close to saturating a node's memory
+       bandwidth.  This is best effort; if it fails (e.g. an older
+       kernel), the mlock populates the rest and reports any shortage
+       of pages. */
+
+    fd_shmem_prefault( sub_shmem, page_sz, sub_page_cnt, sub_cpu_idx, 0UL ); /* logs details */
 
     if( FD_UNLIKELY( fd_numa_mlock( sub_shmem, sub_sz ) ) ) {
       FD_LOG_WARNING(( "sub[%lu]: fd_numa_mlock(\"%s\",%lu KiB) failed (%i-%s)",
@@ -579,6 +745,8 @@ fd_shmem_acquire_multi( ulong         page_sz,
       ERROR( unmap );
     }
 
+    fd_shmem_prefault( sub_mem, page_sz, sub_page_cnt, sub_cpu_idx, 0UL ); /* logs details */
+
     if( FD_UNLIKELY( fd_numa_mlock( sub_mem, sub_sz ) ) ) {
       FD_LOG_WARNING(( "sub[%lu]: fd_numa_mlock(anon,%lu KiB) failed (%i-%s)",
                        sub_idx, sub_sz>>10, errno, fd_io_strerror( errno ) ));
@@ -722,6 +890,12 @@ fd_shmem_private_boot( int *    pargc,
     fd_shmem_private_cpu_idx [ numa_idx ] = (ushort)cpu_idx;
   }
 
+  /* Determine how many threads to use for populating a region */
+
+  ulong prefault_thread_max = fd_env_strip_cmdline_ulong( pargc, pargv, "--shmem-prefault-thread-max", "FD_SHMEM_PREFAULT_THREAD_MAX",
+                                                          FD_SHMEM_PREFAULT_THREAD_DEFAULT );
+  fd_shmem_private_prefault_thread_max = fd_ulong_min( fd_ulong_max( prefault_thread_max, 1UL ), FD_SHMEM_PREFAULT_THREAD_MAX );
+
   /* Determine the shared memory domain for this thread group */
 
   char const * shmem_base = fd_env_strip_cmdline_cstr( pargc, pargv, "--shmem-path", "FD_SHMEM_PATH", "/mnt/.fd" );
@@ -737,6 +911,7 @@ fd_shmem_private_boot( int *    pargc,
   /* At this point, shared memory is online */
 
   FD_LOG_INFO(( "fd_shmem: --shmem-path %s", fd_shmem_private_base ));
+  FD_LOG_INFO(( "fd_shmem: --shmem-prefault-thread-max %lu", fd_shmem_private_prefault_thread_max ));
   FD_LOG_INFO(( "fd_shmem: boot success" ));
 }
 
@@ -748,6 +923,7 @@ fd_shmem_private_halt( void ) {
 
   fd_shmem_private_numa_cnt = 0;
   fd_shmem_private_cpu_cnt  = 0;
+  fd_shmem_private_prefault_thread_max = 0UL;
   fd_memset( fd_shmem_private_numa_idx, 0, FD_SHMEM_CPU_MAX );
 
   fd_shmem_private_base[0] = '\0';
@@ -771,7 +947,8 @@ fd_shmem_private_boot( int *    pargc,
   /* Strip the command line even though ignored to make environment
      parsing identical to downstream regardless of platform. */
 
-  (void)fd_env_strip_cmdline_cstr( pargc, pargv, "--shmem-path", "FD_SHMEM_PATH", "/mnt/.fd" );
+  (void)fd_env_strip_cmdline_cstr ( pargc, pargv, "--shmem-path",                "FD_SHMEM_PATH",                "/mnt/.fd" );
+  (void)fd_env_strip_cmdline_ulong( pargc, pargv, "--shmem-prefault-thread-max", "FD_SHMEM_PREFAULT_THREAD_MAX", 0UL        );
 
   FD_LOG_INFO(( "fd_shmem: --shmem-path (ignored)" ));
   FD_LOG_INFO(( "fd_shmem: boot success" ));
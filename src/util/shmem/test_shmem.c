@@ -314,6 +314,34 @@ main( int     argc,
     }
   }
 
+  /* Test prefault */
+
+  FD_TEST( fd_shmem_prefault_thread_max()>=1UL && fd_shmem_prefault_thread_max()<=FD_SHMEM_PREFAULT_THREAD_MAX );
+
+  do {
+    ulong  psz  = FD_SHMEM_NORMAL_PAGE_SZ;
+    ulong  pcnt = 1024UL;
+    void * mem  = aligned_alloc( psz, psz*pcnt );
+    FD_TEST( mem );
+    for( ulong i=0UL; i<pcnt; i++ ) ((uchar *)mem)[ i*psz ] = (uchar)i;
+
+    FD_TEST( fd_shmem_prefault( NULL,                  psz,     pcnt, 0UL,                 0UL )==EINVAL );
+    FD_TEST( fd_shmem_prefault( mem,                   1UL,     pcnt, 0UL,                 0UL )==EINVAL );
+    FD_TEST( fd_shmem_prefault( (uchar *)mem+1UL,      psz,     pcnt, 0UL,                 0UL )==EINVAL );
+    FD_TEST( fd_shmem_prefault( mem,                   psz,     0UL,  0UL,                 0UL )==EINVAL );
+    FD_TEST( fd_shmem_prefault( mem,                   psz,     pcnt, fd_shmem_cpu_cnt(), 0UL )==EINVAL );
+
+    for( ulong thread_max=0UL; thread_max<=FD_SHMEM_PREFAULT_THREAD_MAX+1UL; thread_max+=5UL ) {
+      int err = fd_shmem_prefault( mem, psz, pcnt, 0UL, thread_max );
+      if( FD_UNLIKELY( err==EINVAL ) ) { FD_LOG_NOTICE(( "skip: MADV_POPULATE_WRITE not supported" )); break; }
+      FD_TEST( !err );
+    }
+
+    for( ulong i=0UL; i<pcnt; i++ ) FD_TEST( ((uchar *)mem)[ i*psz ]==(uchar)i ); /* populate preserves contents */
+
+    free( mem );
+  } while(0);
+
   /* FIXME: DO MORE EXTENSIVE TESTS OF ACQUIRE / RELEASE */
 
   ulong test_cnt = 3UL;
@@ -32,6 +32,79 @@ fd_spad_verify( fd_spad_t const * spad ) {
   return 0;
 }
 
+void
+fd_spad_usage_reset( fd_spad_t * spad ) {
+  spad->mem_wmark = spad->mem_used;
+  spad->alloc_cnt = 0UL;
+# if FD_SPAD_TRACK_USAGE
+  spad->site_min  = 0UL;
+  for( ulong i=0UL; i<FD_SPAD_FRAME_MAX; i++ ) spad->frame_wmark[ i ] = 0UL;
+  for( ulong i=0UL; i<FD_SPAD_SITE_MAX;  i++ ) { spad->site[ i ].file = NULL; spad->site[ i ].line = 0UL; spad->site[ i ].sz = 0UL; }
+# endif
+}
+
+#if FD_SPAD_TRACK_USAGE
+
+void
+fd_spad_private_track_site( fd_spad_t *  spad,
+                            ulong        sz,
+                            char const * file,
+                            int          line ) {
+
+  /* If this site is already in the table, update it.  Otherwise,
+     replace the smallest entry (an unused entry has sz 0 and thus is
+     always the smallest). */
+
+  fd_spad_site_t * site = spad->site;
+  ulong            slot = 0UL;
+  for( ulong i=0UL; i<FD_SPAD_SITE_MAX; i++ ) {
+    if( site[ i ].file==file && site[ i ].line==(ulong)line ) { slot = i; break; }
+    if( site[ i ].sz<site[ slot ].sz ) slot = i;
+  }
+
+  site[ slot ].file = file;
+  site[ slot ].line = (ulong)line;
+  site[ slot ].sz   = fd_ulong_max( site[ slot ].sz, sz );
+
+  ulong site_min = ULONG_MAX;
+  for( ulong i=0UL; i<FD_SPAD_SITE_MAX; i++ ) site_min = fd_ulong_min( site_min, site[ i ].sz );
+  spad->site_min = site_min;
+}
+
+void
+fd_spad_private_overflow( fd_spad_t *  spad,
+                          ulong        align,
+                          ulong        sz,
+                          char const * file,
+                          int          line ) {
+  fd_spad_usage_log( spad, "overflow" );
+  FD_LOG_CRIT(( "spad overflow at %s(%i): alloc of %lu bytes (align %lu) with only %lu bytes free "
+                "(mem_used %lu, mem_max %lu, frame_used %lu)",
+                file, line, sz, align, fd_spad_alloc_max( spad, align ),
+                spad->mem_used, spad->mem_max, fd_spad_frame_used( spad ) ));
+}
+
+#endif
+
+void
+fd_spad_usage_log( fd_spad_t const * spad,
+                   char const *      name ) {
+  FD_LOG_NOTICE(( "spad %s: mem_used %lu mem_max %lu frame_used %lu", name,
+                  spad->mem_used, spad->mem_max, fd_spad_frame_used( spad ) ));
+  FD_LOG_NOTICE(( "spad %s: mem_wmark %lu (%lu%% of mem_max) alloc_cnt %lu", name, spad->mem_wmark,
+                  spad->mem_max ? (100UL*spad->mem_wmark)/spad->mem_max : 0UL, spad->alloc_cnt ));
+# if FD_SPAD_TRACK_USAGE
+  for( ulong depth=1UL; depth<=FD_SPAD_FRAME_MAX; depth++ ) {
+    ulong frame_wmark = fd_spad_frame_wmark( spad, depth );
+    if( frame_wmark ) FD_LOG_NOTICE(( "spad %s: frame depth %3lu wmark %lu", name, depth, frame_wmark ));
+  }
+  for( ulong i=0UL; i<FD_SPAD_SITE_MAX; i++ ) {
+    fd_spad_site_t const * site = fd_spad_site( spad, i );
+    if( site->file ) FD_LOG_NOTICE(( "spad %s: site %s(%lu) max alloc %lu", name, site->file, site->line, site->sz ));
+  }
+# endif
+}
+
 /* Debug fn definitions */
 #if (FD_HAS_DEEPASAN || FD_HAS_MSAN)
 #define SELECT_DEBUG_IMPL(fn) fn##_sanitizer_impl
@@ -93,6 +93,36 @@ FD_STATIC_ASSERT( FD_SPAD_ALLOC_ALIGN_DEFAULT >= FD_MSAN_ALIGN,
 
 #define FD_SPAD_MAGIC (0xf17eda2ce759ad00UL) /* FIREDANCER SPAD version 0 */
 
+/* Spads always record the high-water mark of the whole spad and the
+   number of allocations (these are cheap enough to keep on and are
+   exported as tile metrics).  FD_SPAD_TRACK_USAGE, when compiled in,
+   makes spads additionally record the high-water mark of each frame
+   depth and the sizes and call sites of the FD_SPAD_SITE_MAX largest
+   allocations made through fd_spad_alloc_tracked (below).  This is
+   meant to be used to right-size spads from measurements.  It has a
+   small cost on every allocation and is off by default. */
+
+#ifndef FD_SPAD_TRACK_USAGE
+#define FD_SPAD_TRACK_USAGE 0
+#endif
+
+#define FD_SPAD_SITE_MAX (8UL)
+
+/* A fd_spad_site_t describes an allocation call site recorded when
+   FD_SPAD_TRACK_USAGE is enabled.  file is a pointer to a cstr in the
+   address space of the process that did the allocation (NULL if the
+   entry is not in use) and should only be dereferenced by that process.
+   sz is the largest allocation done at that site (site entries are
+   unique by file,line). */
+
+struct fd_spad_site {
+  char const * file;
+  ulong        line;
+  ulong        sz;
+};
+
+typedef struct fd_spad_site fd_spad_site_t;
+
 /* spad internals */
 
 struct __attribute__((aligned(FD_SPAD_ALIGN))) fd_spad_private {
@@ -116,9 +146,22 @@ struct __attribute__((aligned(FD_SPAD_ALIGN))) fd_spad_private {
   ulong frame_free; /* number of frames free, in [0,FD_SPAD_FRAME_MAX] */
   ulong mem_max;    /* byte size of the spad memory region */
   ulong mem_used;   /* number of spad memory bytes used, in [0,mem_max] */
+  ulong mem_wmark;  /* max mem_used observed, in [0,mem_max] */
+  ulong alloc_cnt;  /* number of allocs and publishes */
 
 #if FD_SPAD_TRACK_USAGE
-  ulong mem_wmark;
+  ulong site_min;   /* smallest sz in site (0 if site has unused entries) */
+
+  /* frame_wmark[i] gives the largest number of bytes used observed by a
+     frame whose allocations start at off[i] (i.e. a frame at depth
+     FD_SPAD_FRAME_MAX-i). */
+
+  ulong frame_wmark[ FD_SPAD_FRAME_MAX ];
+
+  /* site holds the FD_SPAD_SITE_MAX largest allocation call sites
+     observed (in no particular order). */
+
+  fd_spad_site_t site[ FD_SPAD_SITE_MAX ];
 #endif
 
   /* Padding to FD_SPAD_ALIGN here */
@@ -217,8 +260,13 @@ fd_spad_new( void * shmem,
 
   fd_spad_reset( spad );
 
-#if FD_SPAD_TRACK_USAGE
   spad->mem_wmark = 0UL;
+  spad->alloc_cnt = 0UL;
+
+#if FD_SPAD_TRACK_USAGE
+  spad->site_min  = 0UL;
+  for( ulong i=0UL; i<FD_SPAD_FRAME_MAX; i++ ) spad->frame_wmark[ i ] = 0UL;
+  for( ulong i=0UL; i<FD_SPAD_SITE_MAX;  i++ ) { spad->site[ i ].file = NULL; spad->site[ i ].line = 0UL; spad->site[ i ].sz = 0UL; }
 #endif
 
   FD_COMPILER_MFENCE();
@@ -287,10 +335,52 @@ FD_FN_PURE static inline ulong fd_spad_mem_max ( fd_spad_t const * spad ) { retu
 FD_FN_PURE static inline ulong fd_spad_mem_used( fd_spad_t const * spad ) { return spad->mem_used;                 }
 FD_FN_PURE static inline ulong fd_spad_mem_free( fd_spad_t const * spad ) { return spad->mem_max - spad->mem_used; }
 
-#if FD_SPAD_TRACK_USAGE
+/* fd_spad_mem_wmark returns the largest mem_used observed since the
+   spad was created or its usage was last reset.  fd_spad_alloc_cnt
+   returns the number of allocations (including publishes) since then.
+   Assumes spad is a current local join. */
+
 FD_FN_PURE static inline ulong fd_spad_mem_wmark( fd_spad_t const * spad ) { return spad->mem_wmark; }
+FD_FN_PURE static inline ulong fd_spad_alloc_cnt( fd_spad_t const * spad ) { return spad->alloc_cnt; }
+
+/* fd_spad_usage_reset resets the usage information to reflect the
+   spad's current state.  Assumes spad is a current local join. */
+
+void
+fd_spad_usage_reset( fd_spad_t * spad );
+
+#if FD_SPAD_TRACK_USAGE
+
+/* fd_spad_frame_wmark returns the largest number of bytes observed to
+   be used by a frame at the given depth in [1,FD_SPAD_FRAME_MAX] (depth
+   1 is the outermost frame).  Out of range depths return 0.
+   fd_spad_site returns the idx-th entry of the table of largest
+   allocation call sites, idx in [0,FD_SPAD_SITE_MAX). */
+
+FD_FN_PURE static inline ulong
+fd_spad_frame_wmark( fd_spad_t const * spad,
+                     ulong             depth ) {
+  return ( (depth-1UL)<FD_SPAD_FRAME_MAX ) ? spad->frame_wmark[ FD_SPAD_FRAME_MAX-depth ] : 0UL;
+}
+
+FD_FN_PURE static inline fd_spad_site_t const *
+fd_spad_site( fd_spad_t const * spad,
+              ulong             idx ) {
+  return spad->site + idx;
+}
+
 #endif
 
+/* fd_spad_usage_log logs (at NOTICE level) a summary of the spad's
+   memory usage, high-water mark and allocation count prefixed by name.
+   When FD_SPAD_TRACK_USAGE is enabled, this includes the per frame
+   depth high-water marks and largest allocation call sites.  Assumes spad is
+   a current local join. */
+
+void
+fd_spad_usage_log( fd_spad_t const * spad,
+                   char const *      name );
+
 /* fd_spad_in_frame returns 1 if the spad is in a frame and 0 otherwise.
    Assumes spad is a current local join. */
 
@@ -533,6 +623,50 @@ fd_spad_virtual( fd_spad_t * spad ) {
 
 
 /* fn implementations */
+
+/* fd_spad_private_track updates the usage information after an
+   allocation or publish that grew mem_used. */
+
+static inline void
+fd_spad_private_track( fd_spad_t * spad ) {
+  ulong mem_used = spad->mem_used;
+  spad->alloc_cnt++;
+  spad->mem_wmark = fd_ulong_max( spad->mem_wmark, mem_used );
+#if FD_SPAD_TRACK_USAGE
+  ulong frame_free = spad->frame_free;
+  if( FD_LIKELY( frame_free<FD_SPAD_FRAME_MAX ) ) {
+    ulong frame_used = mem_used - spad->off[ frame_free ];
+    spad->frame_wmark[ frame_free ] = fd_ulong_max( spad->frame_wmark[ frame_free ], frame_used );
+  }
+#endif
+}
+
+#if FD_SPAD_TRACK_USAGE
+
+/* fd_spad_private_track_site records an allocation of sz bytes from
+   file:line in the site table.  This is out of line as it is only
+   called for allocations that are larger than smallest site recorded
+   so far.
+
+   fd_spad_private_overflow logs details about an allocation of sz
+   bytes with the given alignment from file:line that does not fit in
+   spad, including the spad's usage profile, and then FD_LOG_CRIT. */
+
+void
+fd_spad_private_track_site( fd_spad_t *  spad,
+                            ulong        sz,
+                            char const * file,
+                            int          line );
+
+void
+fd_spad_private_overflow( fd_spad_t *  spad,
+                          ulong        align,
+                          ulong        sz,
+                          char const * file,
+                          int          line );
+
+#endif
+
 static inline void
 fd_spad_reset_impl( fd_spad_t * spad ) {
   spad->frame_free = FD_SPAD_FRAME_MAX;
@@ -579,6 +713,15 @@ fd_spad_push_impl( fd_spad_t * spad ) {
 
 static inline void
 fd_spad_pop_impl( fd_spad_t * spad ) {
+#if FD_SPAD_TRACK_USAGE
+  /* Frame wmarks include nested frames, so fold the usage of the frame
+     being popped into its parent before discarding it. */
+  ulong parent = spad->frame_free + 1UL;
+  if( FD_LIKELY( parent<FD_SPAD_FRAME_MAX ) ) {
+    ulong frame_used = spad->mem_used - spad->off[ parent ];
+    spad->frame_wmark[ parent ] = fd_ulong_max( spad->frame_wmark[ parent ], frame_used );
+  }
+#endif
   spad->mem_used = spad->off[ spad->frame_free++ ];
 }
 
@@ -590,11 +733,7 @@ fd_spad_alloc_impl( fd_spad_t * spad,
   ulong   off = fd_ulong_align_up( spad->mem_used, align );
   uchar * buf = fd_spad_private_mem( spad ) + off;
   spad->mem_used = off + sz;
-#if FD_SPAD_TRACK_USAGE
-  if( FD_UNLIKELY( spad->mem_wmark < spad->mem_used ) ) {
-    spad->mem_wmark = spad->mem_used;
-  }
-#endif
+  fd_spad_private_track( spad );
 
   return buf;
 }
@@ -626,6 +765,7 @@ static inline void
 fd_spad_publish_impl( fd_spad_t * spad,
                       ulong       sz ) {
   spad->mem_used += sz;
+  fd_spad_private_track( spad );
 }
 
 /* fn definitions */
@@ -704,6 +844,33 @@ fd_spad_publish( fd_spad_t * spad,
   SELECT_IMPL(fd_spad_publish)(spad, sz);
 }
 
+/* fd_spad_alloc_tracked is fd_spad_alloc for call sites that should
+   show up in the spad's usage profile.  When FD_SPAD_TRACK_USAGE is
+   enabled, it additionally records the allocation against file:line
+   and diagnoses overflows (with the spad's usage profile) before they
+   corrupt memory.  Otherwise, it is identical to fd_spad_alloc.
+   FD_SPAD_ALLOC_TRACKED is a convenience wrapper that uses the caller's
+   location. */
+
+static inline void *
+fd_spad_alloc_tracked( fd_spad_t *  spad,
+                       ulong        align,
+                       ulong        sz,
+                       char const * file,
+                       int          line ) {
+#if FD_SPAD_TRACK_USAGE
+  if( FD_UNLIKELY( fd_spad_alloc_max( spad, align )<sz ) ) fd_spad_private_overflow( spad, align, sz, file, line );
+  void * buf = fd_spad_alloc( spad, align, sz );
+  if( FD_UNLIKELY( sz>spad->site_min ) ) fd_spad_private_track_site( spad, sz, file, line );
+  return buf;
+#else
+  (void)file; (void)line;
+  return fd_spad_alloc( spad, align, sz );
+#endif
+}
+
+#define FD_SPAD_ALLOC_TRACKED( spad, align, sz ) fd_spad_alloc_tracked( (spad), (align), (sz), __FILE__, __LINE__ )
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_util_spad_fd_spad_h */
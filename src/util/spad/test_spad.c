@@ -17,7 +17,9 @@
 
 FD_STATIC_ASSERT( FD_SPAD_LG_ALIGN      ==7,                       unit_test );
 FD_STATIC_ASSERT( FD_SPAD_ALIGN         ==(1UL<<FD_SPAD_LG_ALIGN), unit_test );
+#if !FD_SPAD_TRACK_USAGE
 FD_STATIC_ASSERT( FD_SPAD_FOOTPRINT(0UL)==1152UL,                  unit_test );
+#endif
 
 FD_STATIC_ASSERT( FD_SPAD_FRAME_MAX          ==128UL, unit_test );
 FD_STATIC_ASSERT( FD_SPAD_ALLOC_ALIGN_DEFAULT== 16UL, unit_test );
@@ -382,6 +384,71 @@ main( int     argc,
 #if FD_HAS_DEEPASAN
   test_spad_deepasan( spad );
 #endif
+
+  /* Test usage reporting */
+
+  fd_spad_reset( spad );
+  fd_spad_usage_log( spad, "test" );
+
+  fd_spad_push( spad );
+  do {
+    uchar * buf = (uchar *)FD_SPAD_ALLOC_TRACKED( spad, 64UL, 10UL );
+    FD_TEST( fd_ulong_is_aligned( (ulong)buf, 64UL ) );
+    FD_TEST( fd_spad_frame_hi( spad )==buf+10UL );
+  } while(0);
+  fd_spad_pop( spad );
+
+  fd_spad_usage_reset( spad );
+  FD_TEST( !fd_spad_mem_wmark( spad ) );
+  FD_TEST( !fd_spad_alloc_cnt( spad ) );
+
+  fd_spad_push( spad );
+  FD_TEST( fd_spad_alloc( spad, 1UL, 100UL ) );
+  fd_spad_push( spad );
+  FD_TEST( fd_spad_alloc( spad, 1UL, 50UL ) );
+  fd_spad_pop( spad );
+  FD_TEST( fd_spad_alloc( spad, 1UL, 10UL ) );
+  fd_spad_pop( spad );
+  FD_TEST( fd_spad_alloc_cnt( spad )==3UL   );
+  FD_TEST( fd_spad_mem_wmark( spad )==150UL );
+
+#if FD_SPAD_TRACK_USAGE
+  fd_spad_usage_reset( spad );
+  FD_TEST( !fd_spad_mem_wmark( spad ) );
+  FD_TEST( !fd_spad_alloc_cnt( spad ) );
+
+  fd_spad_push( spad );
+  FD_TEST( fd_spad_alloc_tracked( spad, 1UL, 100UL, "a", 1 ) );
+  fd_spad_push( spad );
+  for( ulong i=0UL; i<2UL*FD_SPAD_SITE_MAX; i++ ) FD_TEST( fd_spad_alloc_tracked( spad, 1UL, 10UL+i, "b", (int)i ) );
+  FD_TEST( fd_spad_alloc_tracked( spad, 1UL, 10UL, "b", 0 ) ); /* existing site, smaller sz */
+  fd_spad_pop( spad );
+  fd_spad_pop( spad );
+
+  ulong frame2_sz = 0UL;
+  for( ulong i=0UL; i<2UL*FD_SPAD_SITE_MAX; i++ ) frame2_sz += 10UL+i;
+  FD_TEST( fd_spad_alloc_cnt  ( spad     )==2UL*FD_SPAD_SITE_MAX+2UL );
+  FD_TEST( fd_spad_mem_wmark  ( spad     )==110UL+frame2_sz           );
+  FD_TEST( fd_spad_frame_wmark( spad, 1UL )==110UL+frame2_sz          );
+  FD_TEST( fd_spad_frame_wmark( spad, 2UL )==10UL+frame2_sz           );
+  FD_TEST( fd_spad_frame_wmark( spad, 0UL )==0UL                      );
+  FD_TEST( fd_spad_frame_wmark( spad, FD_SPAD_FRAME_MAX+1UL )==0UL    );
+
+  /* The largest allocations should be the ones kept */
+
+  ulong found = 0UL;
+  for( ulong i=0UL; i<FD_SPAD_SITE_MAX; i++ ) {
+    fd_spad_site_t const * site = fd_spad_site( spad, i );
+    FD_TEST( site->file );
+    if( !strcmp( site->file, "a" ) ) { FD_TEST( site->sz==100UL ); found++; continue; }
+    FD_TEST( site->line>=FD_SPAD_SITE_MAX+1UL );
+    FD_TEST( site->sz  ==10UL+site->line    );
+  }
+  FD_TEST( found==1UL );
+
+  fd_spad_usage_log( spad, "test" );
+#endif
+
   /* Test destructors */
 
   FD_TEST( !fd_spad_leave( NULL ) ); /* NULL spad */
@@ -151,12 +151,17 @@
 
      V3 - This is actually V2 but compressed frames will be enabled.
 
+     DELTA - the stream will only have the workspace data that changed
+          since a parent checkpt (see fd_wksp_checkpt_delta_tpool).
+          These are never produced by fd_wksp_checkpt_tpool.
+
      DEFAULT - the style to use when not specified by user.  0 indicates
      to use V3 if the target supports it and V2 if not. */
 
 #define FD_WKSP_CHECKPT_STYLE_V1      (1)
 #define FD_WKSP_CHECKPT_STYLE_V2      (2)
 #define FD_WKSP_CHECKPT_STYLE_V3      (3)
+#define FD_WKSP_CHECKPT_STYLE_DELTA   (4)
 
 #define FD_WKSP_CHECKPT_STYLE_DEFAULT (0)
 
@@ -167,6 +172,22 @@
 struct fd_wksp_private;
 typedef struct fd_wksp_private fd_wksp_t;
 
+/* FD_WKSP_DELTA_{ALIGN,PATH_MAX,SEQ_MAX,PAGE_SZ_DEFAULT} give the
+   alignment of a wksp change tracker, the maximum byte size (including
+   the terminating '\0') of a checkpt path in a delta chain, the maximum
+   number of checkpts in a delta chain (including the base) and the
+   default change tracking granularity. */
+
+#define FD_WKSP_DELTA_ALIGN           (128UL)
+#define FD_WKSP_DELTA_PATH_MAX        (4096UL)
+#define FD_WKSP_DELTA_SEQ_MAX         (64UL)
+#define FD_WKSP_DELTA_PAGE_SZ_DEFAULT (65536UL)
+
+/* A fd_wksp_delta_t * is an opaque handle of a wksp change tracker */
+
+struct fd_wksp_delta_private;
+typedef struct fd_wksp_delta_private fd_wksp_delta_t;
+
 /* A fd_wksp_usage_t is used to return workspace usage stats. */
 
 struct fd_wksp_usage {
@@ -1014,6 +1035,97 @@ fd_wksp_checkpt( fd_wksp_t *  wksp,
   return fd_wksp_checkpt_tpool( NULL, 0UL, 1UL, wksp, path, mode, style, uinfo );
 }
 
+/* fd_wksp_delta_{align,footprint,new,join,leave,delete} provide the
+   usual object lifecycle for a wksp change tracker.  A change tracker
+   remembers enough about the most recent checkpt written through it to
+   write the next checkpt as a delta against it.  data_max is the
+   largest wksp data region the tracker can be used with and page_sz is
+   the granularity at which changes are tracked (an integer power of 2
+   of at least 4096).  The tracker uses 36 bytes of memory per page_sz
+   bytes of data_max (plus a small fixed overhead).  A newly created
+   tracker has no chain.  The tracker can live in any memory (but if it
+   lives in the wksp being checkpointed, it will be a source of changes
+   every checkpt).
+
+   fd_wksp_delta_reset discards the tracker's chain such that the next
+   checkpt written through it is a full checkpt.
+
+   fd_wksp_delta_seq returns the number of checkpts in the tracker's
+   current chain (0 if none).  fd_wksp_delta_path returns the path of
+   the most recent checkpt in the chain (NULL if none).
+   fd_wksp_delta_{dirty_cnt,dirty_sz} return the number of pages and
+   bytes of allocation data written by the most recent checkpt. */
+
+FD_FN_CONST ulong
+fd_wksp_delta_align( void );
+
+FD_FN_CONST ulong
+fd_wksp_delta_footprint( ulong data_max,
+                         ulong page_sz );
+
+void *
+fd_wksp_delta_new( void * shmem,
+                   ulong  data_max,
+                   ulong  page_sz );
+
+fd_wksp_delta_t *
+fd_wksp_delta_join( void * shdelta );
+
+void *
+fd_wksp_delta_leave( fd_wksp_delta_t * delta );
+
+void *
+fd_wksp_delta_delete( void * shdelta );
+
+void
+fd_wksp_delta_reset( fd_wksp_delta_t * delta );
+
+FD_FN_PURE ulong        fd_wksp_delta_seq      ( fd_wksp_delta_t const * delta );
+FD_FN_PURE char const * fd_wksp_delta_path     ( fd_wksp_delta_t const * delta );
+FD_FN_PURE ulong        fd_wksp_delta_dirty_cnt( fd_wksp_delta_t const * delta );
+FD_FN_PURE ulong        fd_wksp_delta_dirty_sz ( fd_wksp_delta_t const * delta );
+
+/* fd_wksp_checkpt_delta_tpool is fd_wksp_checkpt_tpool for frequent
+   incremental checkpts.  If the change tracker delta has no chain (or
+   its chain already has FD_WKSP_DELTA_SEQ_MAX checkpts), this writes a
+   full checkpt of the given style (V2, V3 or 0 for the default) and
+   starts a new chain with it as the base.  Otherwise, this writes a
+   DELTA style checkpt holding the allocation metadata and only the
+   pages of allocation data that changed since the previous checkpt in
+   the chain (compressed if style is V3).  On success, the checkpt
+   becomes the most recent in delta's chain.  On failure, delta is
+   unchanged.
+
+   Restoring a delta checkpt with fd_wksp_restore_tpool will restore
+   the chain from the base up, so all checkpts in the chain must remain
+   at their original paths (as given when they were written) and
+   unmodified until no longer needed.
+
+   Changes are detected by hashing the allocated bytes of each page
+   with tpool threads [t0,t1) (kernel dirty page tracking is per
+   address space and so cannot observe writes made to a shared wksp by
+   other processes).  As such, the cost of a delta checkpt is a read of
+   the allocated wksp data plus writing only the changed data.  As with
+   fd_wksp_checkpt_tpool, the wksp should not be modified while the
+   checkpt is in progress.
+
+   Returns FD_WKSP_SUCCESS (0) on success or a FD_WKSP_ERR_* on failure
+   (logs details).  Reasons for failure are the same as for
+   fd_wksp_checkpt_tpool plus INVAL for a NULL delta, a path that is
+   too long, a wksp too large for delta or a wksp different from the
+   one delta's chain covers. */
+
+int
+fd_wksp_checkpt_delta_tpool( fd_tpool_t *      tpool,
+                             ulong             t0,
+                             ulong             t1,
+                             fd_wksp_t *       wksp,
+                             fd_wksp_delta_t * delta,
+                             char const *      path,
+                             ulong             mode,
+                             int               style,
+                             char const *      uinfo );
+
 /* fd_wksp_restore_tpool will replace all allocations in the current
    workspace with the allocations from the checkpt at path.  The
    restored workspace will use the given seed.  Tpool threads [t0,t1)
@@ -1028,7 +1140,8 @@ fd_wksp_checkpt( fd_wksp_t *  wksp,
    part_max in checkpt's [alloc_cnt,part_max] and a data_max>=checkpt's
    data_max, this is guaranteed.  Likewise, the number and range of
    threads used on restore does _not_ need to match the range used on
-   checkpt.
+   checkpt.  If path holds a DELTA style checkpt, its chain of parent
+   checkpts is restored first.
 
    Returns FD_WKSP_SUCCESS (0) on success or a FD_WKSP_ERR_* on failure
    (logs details).  Reasons for failure include INVAL (NULL wksp, NULL
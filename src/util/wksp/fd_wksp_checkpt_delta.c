@@ -0,0 +1,1249 @@
+#include "fd_wksp_private.h"
+#include "../rng/fd_rng.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+/* change tracker APIs ************************************************/
+
+ulong
+fd_wksp_delta_align( void ) {
+  return FD_WKSP_DELTA_ALIGN;
+}
+
+ulong
+fd_wksp_delta_footprint( ulong data_max,
+                         ulong page_sz ) {
+  if( FD_UNLIKELY( !data_max                                      ) ) return 0UL;
+  if( FD_UNLIKELY( !fd_ulong_is_pow2( page_sz ) | (page_sz<4096UL) ) ) return 0UL;
+  ulong page_cnt = (data_max + page_sz - 1UL) / page_sz; /* data_max is at most ~2^48 in practice */
+  if( FD_UNLIKELY( page_cnt>(ulong)UINT_MAX ) ) return 0UL;
+  return fd_ulong_align_up( sizeof(fd_wksp_delta_t) + page_cnt*(4UL*sizeof(ulong) + sizeof(uint)), FD_WKSP_DELTA_ALIGN );
+}
+
+void *
+fd_wksp_delta_new( void * shmem,
+                   ulong  data_max,
+                   ulong  page_sz ) {
+  fd_wksp_delta_t * delta = (fd_wksp_delta_t *)shmem;
+
+  if( FD_UNLIKELY( !shmem ) ) {
+    FD_LOG_WARNING(( "NULL shmem" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shmem, fd_wksp_delta_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shmem" ));
+    return NULL;
+  }
+
+  ulong footprint = fd_wksp_delta_footprint( data_max, page_sz );
+  if( FD_UNLIKELY( !footprint ) ) {
+    FD_LOG_WARNING(( "bad data_max or page_sz" ));
+    return NULL;
+  }
+
+  memset( delta, 0, sizeof(fd_wksp_delta_t) );
+
+  delta->data_max = data_max;
+  delta->page_sz  = page_sz;
+  delta->page_cnt = (data_max + page_sz - 1UL) / page_sz;
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( delta->magic ) = FD_WKSP_DELTA_MAGIC;
+  FD_COMPILER_MFENCE();
+
+  return shmem;
+}
+
+fd_wksp_delta_t *
+fd_wksp_delta_join( void * shdelta ) {
+  fd_wksp_delta_t * delta = (fd_wksp_delta_t *)shdelta;
+
+  if( FD_UNLIKELY( !shdelta ) ) {
+    FD_LOG_WARNING(( "NULL shdelta" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shdelta, fd_wksp_delta_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shdelta" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( delta->magic!=FD_WKSP_DELTA_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  return delta;
+}
+
+void *
+fd_wksp_delta_leave( fd_wksp_delta_t * delta ) {
+
+  if( FD_UNLIKELY( !delta ) ) {
+    FD_LOG_WARNING(( "NULL delta" ));
+    return NULL;
+  }
+
+  return (void *)delta;
+}
+
+void *
+fd_wksp_delta_delete( void * shdelta ) {
+  fd_wksp_delta_t * delta = (fd_wksp_delta_t *)shdelta;
+
+  if( FD_UNLIKELY( !shdelta ) ) {
+    FD_LOG_WARNING(( "NULL shdelta" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( !fd_ulong_is_aligned( (ulong)shdelta, fd_wksp_delta_align() ) ) ) {
+    FD_LOG_WARNING(( "misaligned shdelta" ));
+    return NULL;
+  }
+
+  if( FD_UNLIKELY( delta->magic!=FD_WKSP_DELTA_MAGIC ) ) {
+    FD_LOG_WARNING(( "bad magic" ));
+    return NULL;
+  }
+
+  FD_COMPILER_MFENCE();
+  FD_VOLATILE( delta->magic ) = 0UL;
+  FD_COMPILER_MFENCE();
+
+  return shdelta;
+}
+
+void
+fd_wksp_delta_reset( fd_wksp_delta_t * delta ) {
+  delta->seq       = 0UL;
+  delta->parent_sz = 0UL;
+  delta->path[0]   = '\0';
+}
+
+ulong        fd_wksp_delta_seq      ( fd_wksp_delta_t const * delta ) { return delta->seq; }
+char const * fd_wksp_delta_path     ( fd_wksp_delta_t const * delta ) { return delta->seq ? delta->path : NULL; }
+ulong        fd_wksp_delta_dirty_cnt( fd_wksp_delta_t const * delta ) { return delta->dirty_cnt; }
+ulong        fd_wksp_delta_dirty_sz ( fd_wksp_delta_t const * delta ) { return delta->dirty_sz; }
+
+/* checkpt ************************************************************/
+
+/* fd_wksp_private_delta_hash_pages hashes pages [block_i0,block_i1) of the
+   wksp data region.  The hash of a page covers the position and
+   contents of every allocated byte range in the page such that a page
+   whose hash is unchanged holds the same allocated bytes at the same
+   place (up to hash collisions).  The hash is two independently keyed
+   64-bit hashes.  _a0 is the wksp, _a1 points to the index of the
+   partition holding the first byte of each page, _a2 points to where
+   to store the page hashes (2 per page), _a3 is the page size and
+   _a4,_a5 are the keys.  Assumes the caller has the wksp lock and has
+   validated the partitioning. */
+
+static FD_FOR_ALL_BEGIN( fd_wksp_private_delta_hash_pages, 64L ) {
+  fd_wksp_t const *               wksp    = (fd_wksp_t const *)_a0;
+  uint const *                    part    = (uint const *)     _a1;
+  ulong *                         hash    = (ulong *)          _a2;
+  ulong                           page_sz =                    _a3;
+  ulong                           seed0   =                    _a4;
+  ulong                           seed1   =                    _a5;
+  fd_wksp_private_pinfo_t const * pinfo   = fd_wksp_private_pinfo_const( wksp );
+
+  ulong data_lo = wksp->gaddr_lo;
+  ulong data_hi = wksp->gaddr_hi;
+
+  for( long page_idx=block_i0; page_idx<block_i1; page_idx++ ) {
+    ulong page_lo = data_lo + ((ulong)page_idx)*page_sz;
+    ulong page_hi = fd_ulong_min( page_lo + page_sz, data_hi );
+
+    ulong h0       = seed0;
+    ulong h1       = seed1;
+    ulong part_idx = (ulong)part[ page_idx ];
+    for(;;) {
+      ulong gaddr_lo = pinfo[ part_idx ].gaddr_lo;
+      ulong gaddr_hi = pinfo[ part_idx ].gaddr_hi;
+      if( pinfo[ part_idx ].tag ) {
+        ulong        lo  = fd_ulong_max( gaddr_lo, page_lo );
+        ulong        hi  = fd_ulong_min( gaddr_hi, page_hi );
+        void const * buf = fd_wksp_laddr_fast( wksp, lo );
+        h0 = fd_hash( fd_ulong_hash( h0 ^ lo ) ^ hi, buf, hi - lo );
+        h1 = fd_hash( fd_ulong_hash( h1 ^ lo ) ^ hi, buf, hi - lo );
+      }
+      if( gaddr_hi>=page_hi ) break;
+      part_idx = fd_wksp_private_pinfo_idx( pinfo[ part_idx ].next_cidx ); /* not null as gaddr_hi<data_hi */
+    }
+
+    hash[ 2L*page_idx    ] = h0;
+    hash[ 2L*page_idx+1L ] = h1;
+  }
+} FD_FOR_ALL_END
+
+/* fd_wksp_private_delta_scan validates the wksp partitioning, records
+   for each page the partition holding its first byte and then hashes
+   all pages into the delta's scratch hash array using tpool threads
+   [t0,t1).  Assumes the caller has the wksp lock and delta can hold
+   wksp.  On success, returns SUCCESS and *_alloc_{cnt,sz} hold the
+   number and total byte size of the wksp's allocations.  On failure,
+   returns CORRUPT (logs details). */
+
+static int
+fd_wksp_private_delta_scan( fd_tpool_t *      tpool,
+                            ulong             t0,
+                            ulong             t1,
+                            fd_wksp_t *       wksp,
+                            fd_wksp_delta_t * delta,
+                            ulong *           _alloc_cnt,
+                            ulong *           _alloc_sz ) {
+
+# define WKSP_TEST( c ) do {                                                                  \
+    if( FD_UNLIKELY( !(c) ) ) {                                                               \
+      FD_LOG_WARNING(( "scan wksp \"%s\" failed due to failing test %s", wksp->name, #c ));   \
+      return FD_WKSP_ERR_CORRUPT;                                                             \
+    }                                                                                         \
+  } while(0)
+
+  fd_wksp_private_pinfo_t * pinfo = fd_wksp_private_pinfo( wksp );
+  uint *                    part  = fd_wksp_private_delta_part( delta );
+
+  ulong part_max  = wksp->part_max;
+  ulong data_lo   = wksp->gaddr_lo;
+  ulong data_hi   = wksp->gaddr_hi;
+  ulong page_sz   = delta->page_sz;
+  ulong page_cnt  = (wksp->data_max + page_sz - 1UL) / page_sz;
+  ulong cycle_tag = wksp->cycle_tag++;
+
+  WKSP_TEST( (0UL<data_lo) & (data_lo<=data_hi) ); /* Valid data region */
+
+  ulong alloc_cnt  = 0UL;
+  ulong alloc_sz   = 0UL;
+  ulong gaddr_last = data_lo;
+  ulong page_idx   = 0UL;
+
+  ulong part_idx = fd_wksp_private_pinfo_idx( wksp->part_head_cidx );
+  while( !fd_wksp_private_pinfo_idx_is_null( part_idx ) ) {
+
+    WKSP_TEST( part_idx<part_max );                      /* Valid idx */
+    WKSP_TEST( pinfo[ part_idx ].cycle_tag!=cycle_tag ); /* No cycles */
+    pinfo[ part_idx ].cycle_tag = cycle_tag;             /* Mark part_idx as visited */
+
+    ulong gaddr_lo = pinfo[ part_idx ].gaddr_lo;
+    ulong gaddr_hi = pinfo[ part_idx ].gaddr_hi;
+
+    WKSP_TEST( (gaddr_lo==gaddr_last) & (gaddr_lo<gaddr_hi) & (gaddr_hi<=data_hi) ); /* Valid partition range */
+    gaddr_last = gaddr_hi;
+
+    ulong is_alloc = (ulong)(pinfo[ part_idx ].tag>0UL);
+    alloc_cnt += is_alloc;
+    alloc_sz  += is_alloc*(gaddr_hi - gaddr_lo);
+
+    /* Record this partition for all pages that start in it */
+
+    for( ; (page_idx<page_cnt) && (data_lo + page_idx*page_sz < gaddr_hi); page_idx++ ) part[ page_idx ] = (uint)part_idx;
+
+    part_idx = fd_wksp_private_pinfo_idx( pinfo[ part_idx ].next_cidx );
+  }
+
+  WKSP_TEST( gaddr_last==data_hi  ); /* Complete partitioning */
+  WKSP_TEST( page_idx  ==page_cnt ); /* (implied by the above) */
+
+# undef WKSP_TEST
+
+  FD_FOR_ALL( fd_wksp_private_delta_hash_pages, tpool,t0,t1, 0L,(long)page_cnt,
+              wksp, part, fd_wksp_private_delta_hash_tmp( delta ), page_sz, delta->hash_seed[0], delta->hash_seed[1] );
+
+  *_alloc_cnt = alloc_cnt;
+  *_alloc_sz  = alloc_sz;
+  return FD_WKSP_SUCCESS;
+}
+
+/* fd_wksp_private_delta_commit makes the checkpt at path with byte size
+   checkpt_sz the most recent in delta's chain.  Assumes the scratch
+   hashes hold the hashes of the checkpointed wksp. */
+
+static void
+fd_wksp_private_delta_commit( fd_wksp_delta_t * delta,
+                              fd_wksp_t const * wksp,
+                              char const *      path,
+                              ulong             checkpt_sz,
+                              ulong             dirty_cnt,
+                              ulong             dirty_sz ) {
+  ulong page_cnt = (wksp->data_max + delta->page_sz - 1UL) / delta->page_sz;
+  memcpy( fd_wksp_private_delta_hash( delta ), fd_wksp_private_delta_hash_tmp( delta ), 2UL*page_cnt*sizeof(ulong) );
+
+  if( !delta->seq ) {
+    delta->wksp_part_max = wksp->part_max;
+    delta->wksp_data_max = wksp->data_max;
+    memcpy( delta->wksp_name, wksp->name, FD_SHMEM_NAME_MAX );
+  }
+
+  delta->seq++;
+  delta->parent_sz = checkpt_sz;
+  delta->dirty_cnt = dirty_cnt;
+  delta->dirty_sz  = dirty_sz;
+  strcpy( delta->path, path ); /* length checked by caller */
+}
+
+/* fd_wksp_private_checkpt_delta writes the changes to wksp since the
+   most recent checkpt in delta's chain to path.  Arguments are as
+   described in fd_wksp_checkpt_delta_tpool and have been validated. */
+
+static int
+fd_wksp_private_checkpt_delta( fd_tpool_t *      tpool,
+                               ulong             t0,
+                               ulong             t1,
+                               fd_wksp_t *       wksp,
+                               fd_wksp_delta_t * delta,
+                               char const *      path,
+                               ulong             mode,
+                               char const *      uinfo,
+                               int               frame_style_compressed ) {
+
+  int err_fail;
+
+  int            locked  =  0;
+  int            fd      = -1;
+  fd_checkpt_t * checkpt = NULL;
+
+  char const * name     = wksp->name;
+  ulong        name_len = fd_shmem_name_len( name );
+
+  /* Lock the wksp and find the changed pages */
+
+  {
+    int _err = fd_wksp_private_lock( wksp ); /* logs details */
+    if( FD_UNLIKELY( _err ) ) {
+      FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed due to being locked; attempting to continue", name, path ));
+      err_fail = _err;
+      goto fail;
+    }
+    locked = 1;
+  }
+
+  ulong alloc_cnt;
+  ulong alloc_sz;
+
+  err_fail = fd_wksp_private_delta_scan( tpool, t0, t1, wksp, delta, &alloc_cnt, &alloc_sz ); /* logs details */
+  if( FD_UNLIKELY( err_fail ) ) goto fail;
+
+  /* Create the checkpt file */
+
+  {
+    mode_t old_mask = umask( (mode_t)0 );
+    fd = open( path, O_CREAT|O_EXCL|O_WRONLY, (mode_t)mode );
+    umask( old_mask );
+    if( FD_UNLIKELY( fd==-1 ) ) {
+      FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed opening file with flags_O_CREAT|O_EXCL|O_WRONLY in mode 0%03lo "
+                      "(%i-%s); attempting to continue", name, path, mode, errno, fd_io_strerror( errno ) ));
+      err_fail = FD_WKSP_ERR_FAIL;
+      goto fail;
+    }
+  }
+
+  /* Initialize the checkpt */
+
+  ulong frame_off[ 6 ];
+  ulong frame_cnt = 0UL;
+
+  fd_checkpt_t  _checkpt[ 1 ];
+  uchar         wbuf[ FD_CHECKPT_WBUF_MIN ];
+
+  checkpt = fd_checkpt_init_stream( _checkpt, fd, wbuf, FD_CHECKPT_WBUF_MIN ); /* logs details */
+  if( FD_UNLIKELY( !checkpt ) ) {
+    FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed when initializing; attempting to continue", name, path ));
+    err_fail = FD_WKSP_ERR_FAIL;
+    goto fail;
+  }
+
+# define CHECKPT_OPEN(frame_style) do {                                                                                \
+    int _err = fd_checkpt_open_advanced( checkpt, (frame_style), &frame_off[ frame_cnt ] );                            \
+    if( FD_UNLIKELY( _err ) ) {                                                                                        \
+      FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed when opening a %s frame (%i-%s); attempting to continue", \
+                       name, path, #frame_style, _err, fd_checkpt_strerror( _err ) ));                                 \
+      err_fail = FD_WKSP_ERR_FAIL;                                                                                     \
+      goto fail;                                                                                                       \
+    }                                                                                                                  \
+  } while(0)
+
+# define CHECKPT_CLOSE() do {                                                                                       \
+    frame_cnt++;                                                                                                    \
+    int   _err = fd_checkpt_close_advanced( checkpt, &frame_off[ frame_cnt ] ); /* logs details */                  \
+    if( FD_UNLIKELY( _err ) ) {                                                                                     \
+      FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed when closing a frame (%i-%s); attempting to continue", \
+                       name, path, _err, fd_checkpt_strerror( _err ) ));                                            \
+      err_fail = FD_WKSP_ERR_FAIL;                                                                                  \
+      goto fail;                                                                                                    \
+    }                                                                                                               \
+  } while(0)
+
+  /* Note: sz must be at most FD_CHECKPT_META_MAX */
+# define CHECKPT_META( meta, sz ) do {                                                                                \
+    ulong _sz  = (sz);                                                                                                \
+    int   _err = fd_checkpt_meta( checkpt, (meta), _sz ); /* logs details */                                          \
+    if( FD_UNLIKELY( _err ) ) {                                                                                       \
+      FD_LOG_WARNING(( "checkpt to \"%s\" failed when writing %lu bytes metadata %s (%i-%s); attempting to continue", \
+                       path, _sz, #meta, _err, fd_checkpt_strerror( _err ) ));                                        \
+      err_fail = FD_WKSP_ERR_FAIL;                                                                                    \
+      goto fail;                                                                                                      \
+    }                                                                                                                 \
+  } while(0)
+
+  /* Note: data must exist and be unchanged until frame close */
+# define CHECKPT_DATA( data, sz ) do {                                                                            \
+    ulong _sz  = (sz);                                                                                            \
+    int   _err = fd_checkpt_data( checkpt, (data), _sz ); /* logs details */                                      \
+    if( FD_UNLIKELY( _err ) ) {                                                                                   \
+      FD_LOG_WARNING(( "checkpt to \"%s\" failed when writing %lu bytes data %s (%i-%s); attempting to continue", \
+                       path, _sz, #data, _err, fd_checkpt_strerror( _err ) ));                                    \
+      err_fail = FD_WKSP_ERR_FAIL;                                                                                \
+      goto fail;                                                                                                  \
+    }                                                                                                             \
+  } while(0)
+
+  /* Checkpt the header */
+
+  {
+    fd_wksp_checkpt_delta_hdr_t hdr[1];
+
+    hdr->magic                  = wksp->magic;
+    hdr->style                  = FD_WKSP_CHECKPT_STYLE_DELTA;
+    hdr->frame_style_compressed = frame_style_compressed;
+    hdr->reserved               = 0U;
+    memset( hdr->name, 0,    FD_SHMEM_NAME_MAX ); /* Make sure trailing zeros clear */
+    memcpy( hdr->name, name, name_len          );
+    hdr->seed                   = wksp->seed;
+    hdr->part_max               = wksp->part_max;
+    hdr->data_max               = wksp->data_max;
+    hdr->seq                    = delta->seq;
+    hdr->parent_sz              = delta->parent_sz;
+    hdr->page_sz                = delta->page_sz;
+
+    CHECKPT_OPEN( FD_CHECKPT_FRAME_STYLE_RAW );
+    CHECKPT_DATA( hdr, sizeof(fd_wksp_checkpt_delta_hdr_t) );
+    CHECKPT_CLOSE();
+  }
+
+  /* Checkpt the info */
+
+  {
+    fd_wksp_checkpt_delta_info_t info[1];
+
+    info->mode      = mode;
+    info->wallclock = fd_log_wallclock();
+    info->sz_parent = strlen( delta->path ) + 1UL;
+    info->sz_path   = strlen( path        ) + 1UL;
+    info->sz_uinfo  = fd_cstr_nlen( uinfo, FD_WKSP_CHECKPT_V2_UINFO_MAX-1UL ) + 1UL;
+
+    CHECKPT_OPEN( frame_style_compressed );
+    CHECKPT_META( info,        sizeof(fd_wksp_checkpt_delta_info_t) );
+    CHECKPT_DATA( delta->path, info->sz_parent                      );
+    CHECKPT_DATA( path,        info->sz_path                        );
+    CHECKPT_DATA( uinfo,       info->sz_uinfo - 1UL                 );
+    CHECKPT_DATA( "",          1UL                                  ); /* uinfo might have been truncated */
+    CHECKPT_CLOSE();
+  }
+
+  fd_wksp_private_pinfo_t * pinfo = fd_wksp_private_pinfo( wksp );
+
+  /* Checkpt the manifest */
+
+  {
+    fd_wksp_checkpt_v2_cmd_t cmd[1];
+
+    CHECKPT_OPEN( frame_style_compressed );
+
+    ulong part_idx = fd_wksp_private_pinfo_idx( wksp->part_head_cidx );
+    while( !fd_wksp_private_pinfo_idx_is_null( part_idx ) ) {
+      if( pinfo[ part_idx ].tag ) {
+        cmd->meta.tag      = pinfo[ part_idx ].tag;
+        cmd->meta.gaddr_lo = pinfo[ part_idx ].gaddr_lo;
+        cmd->meta.gaddr_hi = pinfo[ part_idx ].gaddr_hi;
+        CHECKPT_META( cmd, sizeof(fd_wksp_checkpt_v2_cmd_t) );
+      }
+      part_idx = fd_wksp_private_pinfo_idx( pinfo[ part_idx ].next_cidx );
+    }
+
+    cmd->data.tag        = 0UL;
+    cmd->data.cgroup_cnt = ULONG_MAX;
+    cmd->data.frame_off  = ULONG_MAX;
+    CHECKPT_META( cmd, sizeof(fd_wksp_checkpt_v2_cmd_t) );
+
+    CHECKPT_CLOSE();
+  }
+
+  /* Checkpt the extents.  We coalesce the allocated bytes of adjacent
+     changed pages that are in the same allocation into a single extent. */
+
+  ulong extent_cnt = 0UL;
+  ulong extent_sz  = 0UL;
+  ulong dirty_cnt  = 0UL;
+
+  {
+    ulong const * hash     = fd_wksp_private_delta_hash    ( delta );
+    ulong const * hash_tmp = fd_wksp_private_delta_hash_tmp( delta );
+    uint const *  part     = fd_wksp_private_delta_part    ( delta );
+
+    ulong data_lo  = wksp->gaddr_lo;
+    ulong data_hi  = wksp->gaddr_hi;
+    ulong page_sz  = delta->page_sz;
+    ulong page_cnt = (wksp->data_max + page_sz - 1UL) / page_sz;
+
+    fd_wksp_checkpt_v2_cmd_t cmd[1];
+
+    ulong ext_part = FD_WKSP_PRIVATE_PINFO_IDX_NULL;
+    ulong ext_lo   = 0UL;
+    ulong ext_hi   = 0UL;
+
+#   define EXTENT_FLUSH() do {                                                \
+      if( ext_hi>ext_lo ) {                                                   \
+        cmd->meta.tag      = pinfo[ ext_part ].tag;                           \
+        cmd->meta.gaddr_lo = ext_lo;                                          \
+        cmd->meta.gaddr_hi = ext_hi;                                          \
+        CHECKPT_META( cmd, sizeof(fd_wksp_checkpt_v2_cmd_t) );                \
+        CHECKPT_DATA( fd_wksp_laddr_fast( wksp, ext_lo ), ext_hi - ext_lo );  \
+        extent_cnt++;                                                         \
+        extent_sz += ext_hi - ext_lo;                                         \
+      }                                                                       \
+    } while(0)
+
+    CHECKPT_OPEN( frame_style_compressed );
+
+    for( ulong page_idx=0UL; page_idx<page_cnt; page_idx++ ) {
+      if( FD_LIKELY( (hash[ 2UL*page_idx     ]==hash_tmp[ 2UL*page_idx     ]) &
+                     (hash[ 2UL*page_idx+1UL ]==hash_tmp[ 2UL*page_idx+1UL ]) ) ) continue;
+      dirty_cnt++;
+
+      ulong page_lo  = data_lo + page_idx*page_sz;
+      ulong page_hi  = fd_ulong_min( page_lo + page_sz, data_hi );
+      ulong part_idx = (ulong)part[ page_idx ];
+      for(;;) {
+        ulong gaddr_lo = pinfo[ part_idx ].gaddr_lo;
+        ulong gaddr_hi = pinfo[ part_idx ].gaddr_hi;
+        if( pinfo[ part_idx ].tag ) {
+          ulong lo = fd_ulong_max( gaddr_lo, page_lo );
+          ulong hi = fd_ulong_min( gaddr_hi, page_hi );
+          if( (part_idx==ext_part) & (lo==ext_hi) ) ext_hi = hi;
+          else {
+            EXTENT_FLUSH();
+            ext_part = part_idx;
+            ext_lo   = lo;
+            ext_hi   = hi;
+          }
+        }
+        if( gaddr_hi>=page_hi ) break;
+        part_idx = fd_wksp_private_pinfo_idx( pinfo[ part_idx ].next_cidx );
+      }
+    }
+
+    EXTENT_FLUSH();
+
+#   undef EXTENT_FLUSH
+
+    cmd->data.tag        = 0UL;
+    cmd->data.cgroup_cnt = ULONG_MAX;
+    cmd->data.frame_off  = ULONG_MAX;
+    CHECKPT_META( cmd, sizeof(fd_wksp_checkpt_v2_cmd_t) );
+
+    CHECKPT_CLOSE();
+  }
+
+  /* Checkpt the footer */
+
+  {
+    fd_wksp_checkpt_delta_ftr_t ftr[1];
+
+    ftr->alloc_cnt              = alloc_cnt;
+    ftr->extent_cnt             = extent_cnt;
+    ftr->extent_sz              = extent_sz;
+    ftr->seq                    = delta->seq;
+    ftr->parent_sz              = delta->parent_sz;
+    ftr->checkpt_sz             = frame_off[ frame_cnt ] + sizeof(fd_wksp_checkpt_delta_ftr_t);
+    ftr->data_max               = wksp->data_max;
+    ftr->part_max               = wksp->part_max;
+    ftr->seed                   = wksp->seed;
+    memset( ftr->name, 0,    FD_SHMEM_NAME_MAX ); /* Make sure trailing zeros clear */
+    memcpy( ftr->name, name, name_len          );
+    ftr->reserved               = 0U;
+    ftr->frame_style_compressed = frame_style_compressed;
+    ftr->style                  = FD_WKSP_CHECKPT_STYLE_DELTA;
+    ftr->unmagic                = ~wksp->magic;
+
+    CHECKPT_OPEN( FD_CHECKPT_FRAME_STYLE_RAW );
+    CHECKPT_DATA( ftr, sizeof(fd_wksp_checkpt_delta_ftr_t) );
+    CHECKPT_CLOSE();
+  }
+
+# undef CHECKPT_DATA
+# undef CHECKPT_META
+# undef CHECKPT_CLOSE
+# undef CHECKPT_OPEN
+
+  /* Finalize the checkpt */
+
+  if( FD_UNLIKELY( !fd_checkpt_fini( checkpt ) ) ) { /* logs details */
+    FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed when finalizing; attempting to continue", name, path ));
+    checkpt  = NULL;
+    err_fail = FD_WKSP_ERR_FAIL;
+    goto fail;
+  }
+
+  /* Close the file */
+
+  if( FD_UNLIKELY( close( fd ) ) ) {
+    FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed when closing; attempting to continue", name, path ));
+    fd       = -1;
+    err_fail = FD_WKSP_ERR_FAIL;
+    goto fail;
+  }
+
+  /* Unlock the wksp */
+
+  fd_wksp_private_unlock( wksp );
+  locked = 0;
+
+  fd_wksp_private_delta_commit( delta, wksp, path, frame_off[ frame_cnt ], dirty_cnt, extent_sz );
+
+  return FD_WKSP_SUCCESS;
+
+fail:
+
+  /* Release resources that might be reserved */
+
+  if( FD_LIKELY( checkpt ) ) {
+    if( FD_UNLIKELY( fd_checkpt_in_frame( checkpt ) ) && FD_UNLIKELY( fd_checkpt_close( checkpt ) ) )
+      FD_LOG_WARNING(( "fd_checkpt_close failed; attempting to continue" ));
+
+    if( FD_UNLIKELY( !fd_checkpt_fini( checkpt ) ) ) /* logs details */
+      FD_LOG_WARNING(( "fd_checkpt_fini failed; attempting to continue" ));
+  }
+
+  if( FD_LIKELY( fd!=-1 ) && FD_UNLIKELY( close( fd ) ) )
+    FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", path, errno, fd_io_strerror( errno ) ));
+
+  if( FD_LIKELY( locked ) ) fd_wksp_private_unlock( wksp );
+
+  return err_fail;
+}
+
+int
+fd_wksp_checkpt_delta_tpool( fd_tpool_t *      tpool,
+                             ulong             t0,
+                             ulong             t1,
+                             fd_wksp_t *       wksp,
+                             fd_wksp_delta_t * delta,
+                             char const *      path,
+                             ulong             mode,
+                             int               style,
+                             char const *      uinfo ) {
+
+  /* Check input args */
+
+  if( FD_UNLIKELY( !wksp ) ) {
+    FD_LOG_WARNING(( "NULL wksp" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( !delta ) ) {
+    FD_LOG_WARNING(( "NULL delta" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( !path ) ) {
+    FD_LOG_WARNING(( "NULL path" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( strlen( path )>=FD_WKSP_DELTA_PATH_MAX ) ) {
+    FD_LOG_WARNING(( "path too long" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( mode!=(ulong)(mode_t)mode ) ) {
+    FD_LOG_WARNING(( "bad mode" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  style = fd_int_if( !!style, style, FD_HAS_LZ4 ? FD_WKSP_CHECKPT_STYLE_V3 : FD_WKSP_CHECKPT_STYLE_V2 );
+
+  int frame_style_compressed;
+  switch( style ) {
+  case FD_WKSP_CHECKPT_STYLE_V2: frame_style_compressed = FD_CHECKPT_FRAME_STYLE_RAW; break;
+  case FD_WKSP_CHECKPT_STYLE_V3: frame_style_compressed = FD_CHECKPT_FRAME_STYLE_LZ4; break;
+  default:
+    FD_LOG_WARNING(( "unsupported style" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( !fd_checkpt_frame_style_is_supported( frame_style_compressed ) ) ) {
+    FD_LOG_WARNING(( "compressed frames are not supported on this target" ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( !uinfo ) ) uinfo = "";
+
+  if( FD_UNLIKELY( wksp->data_max>delta->data_max ) ) {
+    FD_LOG_WARNING(( "wksp \"%s\" data_max %lu too large for delta (data_max %lu)", wksp->name, wksp->data_max, delta->data_max ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  if( FD_UNLIKELY( delta->seq && ( (delta->wksp_part_max!=wksp->part_max) | (delta->wksp_data_max!=wksp->data_max) |
+                                   (!!strncmp( delta->wksp_name, wksp->name, FD_SHMEM_NAME_MAX )) ) ) ) {
+    FD_LOG_WARNING(( "delta chain is for wksp \"%s\" and not wksp \"%s\"; reset delta to start a new chain",
+                     delta->wksp_name, wksp->name ));
+    return FD_WKSP_ERR_INVAL;
+  }
+
+  /* If there is a chain to extend, write a delta */
+
+  if( FD_LIKELY( (0UL<delta->seq) & (delta->seq<FD_WKSP_DELTA_SEQ_MAX) ) )
+    return fd_wksp_private_checkpt_delta( tpool, t0, t1, wksp, delta, path, mode, uinfo, frame_style_compressed );
+
+  /* Otherwise, write a full checkpt as the base of a new chain and
+     record what it holds.  The pages are hashed under the same lock
+     hold as the checkpt is written such that the hashes describe
+     exactly what is in the checkpt (a change between the two would
+     otherwise be silently missing from all later deltas). */
+
+  fd_wksp_delta_reset( delta );
+
+  if( FD_UNLIKELY( !fd_rng_secure( delta->hash_seed, sizeof(delta->hash_seed) ) ) ) { /* logs details */
+    FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed to generate page hash keys", wksp->name, path ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  int err = fd_wksp_private_lock( wksp ); /* logs details */
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed due to being locked; attempting to continue", wksp->name, path ));
+    return err;
+  }
+
+  ulong alloc_cnt;
+  ulong alloc_sz;
+  err = fd_wksp_private_delta_scan( tpool, t0, t1, wksp, delta, &alloc_cnt, &alloc_sz ); /* logs details */
+  if( FD_LIKELY( !err ) )
+    err = fd_wksp_private_checkpt_v2_locked( tpool, t0, t1, wksp, path, mode, uinfo, frame_style_compressed ); /* logs details */
+
+  fd_wksp_private_unlock( wksp );
+
+  if( FD_UNLIKELY( err ) ) return err;
+
+  struct stat st[1];
+  if( FD_UNLIKELY( stat( path, st ) ) ) {
+    FD_LOG_WARNING(( "stat(\"%s\") failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  fd_wksp_private_delta_commit( delta, wksp, path, (ulong)st->st_size,
+                                (wksp->data_max + delta->page_sz - 1UL) / delta->page_sz, alloc_sz );
+
+  return FD_WKSP_SUCCESS;
+}
+
+/* restore ************************************************************/
+
+/* Note: restore not in frame on entry, restore at off on exit.  Jumps
+   to fail on error (logs details). */
+
+#define RESTORE_OPEN(frame_style) do {                                                                                \
+    if( FD_UNLIKELY( fd_restore_open_advanced( restore, (frame_style), &frame_off ) ) ) goto fail; /* logs details */ \
+  } while(0)
+
+#define RESTORE_CLOSE() do {                                                                            \
+    if( FD_UNLIKELY( fd_restore_close_advanced( restore, &frame_off ) ) ) goto fail; /* logs details */ \
+  } while(0)
+
+#define RESTORE_META( meta, sz ) do {                                        \
+    ulong _sz  = (sz);                                                       \
+    int   _err = fd_restore_meta( restore, (meta), _sz ); /* logs details */ \
+    if( FD_UNLIKELY( _err ) ) {                                              \
+      FD_LOG_WARNING(( "fd_restore_meta( %s, %lu ) failed (%i-%s)",          \
+                       #meta, _sz, _err, fd_checkpt_strerror( _err ) ));     \
+      goto fail;                                                             \
+    }                                                                        \
+  } while(0)
+
+#define RESTORE_DATA( data, sz ) do {                                        \
+    ulong _sz  = (sz);                                                       \
+    int   _err = fd_restore_data( restore, (data), _sz ); /* logs details */ \
+    if( FD_UNLIKELY( _err ) ) {                                              \
+      FD_LOG_WARNING(( "fd_restore_data( %s, %lu ) failed (%i-%s)",          \
+                       #data, _sz, _err, fd_checkpt_strerror( _err ) ));     \
+      goto fail;                                                             \
+    }                                                                        \
+  } while(0)
+
+#define RESTORE_TEST( c ) do {                          \
+    if( FD_UNLIKELY( !(c) ) ) {                         \
+      FD_LOG_WARNING(( "restore test %s failed", #c )); \
+      goto fail;                                        \
+    }                                                   \
+  } while(0)
+
+/* fd_wksp_restore_delta_head restores and validates the header and info
+   frames of a delta checkpt.  Assumes restore is at the first header
+   byte.  On success, returns SUCCESS, *hdr and *info are populated,
+   info_cstr[0,1,2] point into info_buf (which has room for
+   FD_WKSP_RESTORE_DELTA_INFO_MAX bytes) at the parent path, path and
+   uinfo cstrs and restore is just after the info frame.  On failure,
+   returns FAIL and the outputs and restore state are indeterminant. */
+
+#define FD_WKSP_RESTORE_DELTA_INFO_MAX (2UL*FD_WKSP_DELTA_PATH_MAX + FD_WKSP_CHECKPT_V2_UINFO_MAX)
+
+static int
+fd_wksp_restore_delta_head( fd_restore_t *                 restore,
+                            fd_wksp_checkpt_delta_hdr_t *  hdr,
+                            fd_wksp_checkpt_delta_info_t * info,
+                            char *                         info_buf,
+                            char const *                   info_cstr[ 3 ] ) {
+  ulong frame_off;
+
+  RESTORE_OPEN( FD_CHECKPT_FRAME_STYLE_RAW );
+  RESTORE_DATA( hdr, sizeof(fd_wksp_checkpt_delta_hdr_t) );
+  RESTORE_CLOSE();
+
+  RESTORE_TEST( hdr->magic==FD_WKSP_MAGIC                                          );
+  RESTORE_TEST( hdr->style==FD_WKSP_CHECKPT_STYLE_DELTA                            );
+  RESTORE_TEST( fd_checkpt_frame_style_is_supported( hdr->frame_style_compressed ) );
+  RESTORE_TEST( hdr->reserved==0U                                                  );
+  RESTORE_TEST( fd_shmem_name_len( hdr->name )>0UL                                 );
+  RESTORE_TEST( fd_wksp_footprint( hdr->part_max, hdr->data_max )>0UL              );
+  RESTORE_TEST( (0UL<hdr->seq) & (hdr->seq<FD_WKSP_DELTA_SEQ_MAX)                  );
+  RESTORE_TEST( hdr->parent_sz>0UL                                                 );
+
+  RESTORE_OPEN( hdr->frame_style_compressed );
+  RESTORE_META( info, sizeof(fd_wksp_checkpt_delta_info_t) );
+  RESTORE_TEST( (0UL<info->sz_parent) & (info->sz_parent<=FD_WKSP_DELTA_PATH_MAX      ) );
+  RESTORE_TEST( (0UL<info->sz_path  ) & (info->sz_path  <=FD_WKSP_DELTA_PATH_MAX      ) );
+  RESTORE_TEST( (0UL<info->sz_uinfo ) & (info->sz_uinfo <=FD_WKSP_CHECKPT_V2_UINFO_MAX) );
+  RESTORE_DATA( info_buf,                                     info->sz_parent    );
+  RESTORE_DATA( info_buf + info->sz_parent,                   info->sz_path      );
+  RESTORE_DATA( info_buf + info->sz_parent + info->sz_path,   info->sz_uinfo-1UL );
+  RESTORE_DATA( info_buf + info->sz_parent + info->sz_path + info->sz_uinfo-1UL, 1UL );
+  RESTORE_CLOSE();
+
+  info_cstr[0] = info_buf;
+  info_cstr[1] = info_buf + info->sz_parent;
+  info_cstr[2] = info_buf + info->sz_parent + info->sz_path;
+
+  RESTORE_TEST( fd_cstr_nlen( info_cstr[0], info->sz_parent )==info->sz_parent-1UL );
+  RESTORE_TEST( fd_cstr_nlen( info_cstr[1], info->sz_path   )==info->sz_path  -1UL );
+  RESTORE_TEST( fd_cstr_nlen( info_cstr[2], info->sz_uinfo  )==info->sz_uinfo -1UL );
+
+  return FD_WKSP_SUCCESS;
+
+fail:
+  return FD_WKSP_ERR_FAIL;
+}
+
+/* fd_wksp_private_restore_delta_open opens the delta checkpt at path
+   for streaming restore into restore (using rbuf as the read buffer)
+   and restores its header and info.  Returns the file descriptor on
+   success and -1 on failure (logs details, nothing left open). */
+
+static int
+fd_wksp_private_restore_delta_open( char const *                   path,
+                                    fd_restore_t *                 _restore,
+                                    uchar *                        rbuf,
+                                    fd_restore_t **                _restore_out,
+                                    fd_wksp_checkpt_delta_hdr_t *  hdr,
+                                    fd_wksp_checkpt_delta_info_t * info,
+                                    char *                         info_buf,
+                                    char const *                   info_cstr[ 3 ] ) {
+  int fd = open( path, O_RDONLY, (mode_t)0 );
+  if( FD_UNLIKELY( fd==-1 ) ) {
+    FD_LOG_WARNING(( "open(\"%s\",O_RDONLY,0) failed (%i-%s)", path, errno, fd_io_strerror( errno ) ));
+    return -1;
+  }
+
+  fd_restore_t * restore = fd_restore_init_stream( _restore, fd, rbuf, FD_RESTORE_RBUF_MIN ); /* logs details */
+  if( FD_UNLIKELY( !restore ) ) goto fail;
+
+  if( FD_UNLIKELY( fd_wksp_restore_delta_head( restore, hdr, info, info_buf, info_cstr ) ) ) {
+    FD_LOG_WARNING(( "\"%s\" does not appear to be a valid delta checkpt", path ));
+    if( FD_UNLIKELY( fd_restore_in_frame( restore ) ) && FD_UNLIKELY( fd_restore_close( restore ) ) )
+      FD_LOG_WARNING(( "fd_restore_close failed; attempting to continue" ));
+    if( FD_UNLIKELY( !fd_restore_fini( restore ) ) ) /* logs details */
+      FD_LOG_WARNING(( "fd_restore_fini failed; attempting to continue" ));
+    goto fail;
+  }
+
+  *_restore_out = restore;
+  return fd;
+
+fail:
+  if( FD_UNLIKELY( close( fd ) ) )
+    FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", path, errno, fd_io_strerror( errno ) ));
+  return -1;
+}
+
+/* fd_wksp_private_restore_delta_parent validates that the checkpt at
+   parent looks like the parent of a delta checkpt with header hdr.
+   Returns SUCCESS if so and FAIL if not (logs details). */
+
+static int
+fd_wksp_private_restore_delta_parent( fd_wksp_checkpt_delta_hdr_t const * hdr,
+                                      char const *                        parent ) {
+
+  struct stat st[1];
+  if( FD_UNLIKELY( stat( parent, st ) ) ) {
+    FD_LOG_WARNING(( "stat(\"%s\") failed (%i-%s)", parent, errno, fd_io_strerror( errno ) ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  if( FD_UNLIKELY( (ulong)st->st_size!=hdr->parent_sz ) ) {
+    FD_LOG_WARNING(( "parent checkpt \"%s\" has size %lu (expected %lu); was it replaced?", parent, (ulong)st->st_size, hdr->parent_sz ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  fd_wksp_preview_t preview[1];
+  if( FD_UNLIKELY( fd_wksp_preview( parent, preview ) ) ) {
+    FD_LOG_WARNING(( "parent \"%s\" does not appear to be a supported wksp checkpt", parent ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  if( FD_UNLIKELY( (preview->part_max!=hdr->part_max) | (preview->data_max!=hdr->data_max) |
+                   (!!strncmp( preview->name, hdr->name, FD_SHMEM_NAME_MAX )) ) ) {
+    FD_LOG_WARNING(( "parent \"%s\" is a checkpt of a different wksp", parent ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  ulong parent_seq;
+  if( preview->style==FD_WKSP_CHECKPT_STYLE_DELTA ) {
+    fd_wksp_checkpt_delta_hdr_t parent_hdr[1];
+    int fd = open( parent, O_RDONLY, (mode_t)0 );
+    if( FD_UNLIKELY( fd==-1 ) ) {
+      FD_LOG_WARNING(( "open(\"%s\",O_RDONLY,0) failed (%i-%s)", parent, errno, fd_io_strerror( errno ) ));
+      return FD_WKSP_ERR_FAIL;
+    }
+    ulong rsz;
+    int   err = fd_io_read( fd, parent_hdr, sizeof(fd_wksp_checkpt_delta_hdr_t), sizeof(fd_wksp_checkpt_delta_hdr_t), &rsz );
+    if( FD_UNLIKELY( close( fd ) ) )
+      FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", parent, errno, fd_io_strerror( errno ) ));
+    if( FD_UNLIKELY( err ) ) {
+      FD_LOG_WARNING(( "read \"%s\" header failed (%i-%s)", parent, err, fd_io_strerror( err ) ));
+      return FD_WKSP_ERR_FAIL;
+    }
+    parent_seq = parent_hdr->seq;
+  } else {
+    parent_seq = 0UL;
+  }
+
+  if( FD_UNLIKELY( parent_seq+1UL!=hdr->seq ) ) {
+    FD_LOG_WARNING(( "parent \"%s\" is at chain position %lu (expected %lu)", parent, parent_seq, hdr->seq-1UL ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  return FD_WKSP_SUCCESS;
+}
+
+/* fd_wksp_private_restore_delta_apply applies the delta checkpt in
+   restore (positioned just after the info frame) to wksp.  Assumes wksp
+   holds the restored parent.  Returns SUCCESS on success and CORRUPT on
+   failure (logs details). */
+
+static int
+fd_wksp_private_restore_delta_apply( fd_wksp_t *                         wksp,
+                                     fd_restore_t *                      restore,
+                                     fd_wksp_checkpt_delta_hdr_t const * hdr,
+                                     uint                                new_seed ) {
+  ulong frame_off;
+
+  int locked = 0;
+
+  fd_wksp_private_pinfo_t * pinfo    = fd_wksp_private_pinfo( wksp );
+  ulong                     part_max = wksp->part_max;
+  ulong                     data_lo  = wksp->gaddr_lo;
+  ulong                     data_hi  = wksp->gaddr_hi;
+
+  ulong hdr_data_lo = fd_wksp_private_data_off( hdr->part_max );
+  ulong hdr_data_hi = hdr_data_lo + hdr->data_max;
+
+  FD_LOG_INFO(( "Locking wksp" ));
+
+  if( FD_UNLIKELY( fd_wksp_private_lock( wksp ) ) ) goto fail; /* logs details */
+  locked = 1;
+
+  fd_wksp_checkpt_v2_cmd_t cmd[1];
+
+  /* Restore the manifest */
+
+  FD_LOG_INFO(( "Restoring manifest" ));
+
+  ulong alloc_cnt = 0UL;
+
+  RESTORE_OPEN( hdr->frame_style_compressed );
+  for(;;) {
+    RESTORE_META( cmd, sizeof(fd_wksp_checkpt_v2_cmd_t) );
+    if( fd_wksp_checkpt_v2_cmd_is_data( cmd ) ) break;
+    RESTORE_TEST( fd_wksp_checkpt_v2_cmd_is_meta( cmd ) );
+
+    ulong tag      = cmd->meta.tag;
+    ulong gaddr_lo = cmd->meta.gaddr_lo;
+    ulong gaddr_hi = cmd->meta.gaddr_hi;
+
+    RESTORE_TEST( (hdr_data_lo<=gaddr_lo) & (gaddr_lo<gaddr_hi) & (gaddr_hi<=hdr_data_hi) );
+    RESTORE_TEST( (data_lo    <=gaddr_lo) &                       (gaddr_hi<=data_hi    ) );
+    RESTORE_TEST( alloc_cnt<part_max );
+    /* Note: disjoint [gaddr_lo,gaddr_hi) tested on rebuild */
+
+    pinfo[ alloc_cnt ].gaddr_lo = gaddr_lo;
+    pinfo[ alloc_cnt ].gaddr_hi = gaddr_hi;
+    pinfo[ alloc_cnt ].tag      = tag;
+    alloc_cnt++;
+  }
+  RESTORE_CLOSE();
+
+  /* Restore the extents */
+
+  FD_LOG_INFO(( "Restoring extents" ));
+
+  ulong extent_cnt = 0UL;
+  ulong extent_sz  = 0UL;
+
+  RESTORE_OPEN( hdr->frame_style_compressed );
+  for(;;) {
+    RESTORE_META( cmd, sizeof(fd_wksp_checkpt_v2_cmd_t) );
+    if( fd_wksp_checkpt_v2_cmd_is_data( cmd ) ) break;
+    RESTORE_TEST( fd_wksp_checkpt_v2_cmd_is_meta( cmd ) );
+
+    ulong gaddr_lo = cmd->meta.gaddr_lo;
+    ulong gaddr_hi = cmd->meta.gaddr_hi;
+
+    RESTORE_TEST( (data_lo<=gaddr_lo) & (gaddr_lo<gaddr_hi) & (gaddr_hi<=data_hi) );
+
+    RESTORE_DATA( fd_wksp_laddr_fast( wksp, gaddr_lo ), gaddr_hi - gaddr_lo );
+    extent_cnt++;
+    extent_sz += gaddr_hi - gaddr_lo;
+  }
+  RESTORE_CLOSE();
+
+  /* Restore and validate the footer */
+
+  FD_LOG_INFO(( "Restoring footer" ));
+
+  fd_wksp_checkpt_delta_ftr_t ftr[1];
+
+  ulong checkpt_sz = frame_off + sizeof(fd_wksp_checkpt_delta_ftr_t);
+
+  RESTORE_OPEN( FD_CHECKPT_FRAME_STYLE_RAW );
+  RESTORE_DATA( ftr, sizeof(fd_wksp_checkpt_delta_ftr_t) );
+  RESTORE_CLOSE();
+
+  RESTORE_TEST( ftr->alloc_cnt             ==alloc_cnt                   );
+  RESTORE_TEST( ftr->extent_cnt            ==extent_cnt                  );
+  RESTORE_TEST( ftr->extent_sz             ==extent_sz                   );
+  RESTORE_TEST( ftr->seq                   ==hdr->seq                    );
+  RESTORE_TEST( ftr->parent_sz             ==hdr->parent_sz              );
+  RESTORE_TEST( ftr->checkpt_sz            ==checkpt_sz                  );
+  RESTORE_TEST( ftr->data_max              ==hdr->data_max               );
+  RESTORE_TEST( ftr->part_max              ==hdr->part_max               );
+  RESTORE_TEST( ftr->seed                  ==hdr->seed                   );
+  RESTORE_TEST( !memcmp( ftr->name, hdr->name, FD_SHMEM_NAME_MAX )       );
+  RESTORE_TEST( ftr->reserved              ==hdr->reserved               );
+  RESTORE_TEST( ftr->frame_style_compressed==hdr->frame_style_compressed );
+  RESTORE_TEST( ftr->style                 ==hdr->style                  );
+  RESTORE_TEST( ftr->unmagic               ==~hdr->magic                 );
+
+  /* Free any remaining old allocations and rebuild the wksp */
+
+  FD_LOG_INFO(( "Rebuilding wksp" ));
+
+  for( ulong part_idx=alloc_cnt; part_idx<part_max; part_idx++ ) pinfo[ part_idx ].tag = 0UL;
+
+  if( FD_UNLIKELY( fd_wksp_rebuild( wksp, new_seed ) ) ) goto fail; /* logs details */
+
+  fd_wksp_private_unlock( wksp );
+
+  return FD_WKSP_SUCCESS;
+
+fail:
+
+  if( FD_LIKELY( locked ) ) fd_wksp_private_unlock( wksp );
+
+  return FD_WKSP_ERR_CORRUPT;
+}
+
+/* A fd_wksp_private_restore_delta_scratch_t holds the scratch used to
+   restore a delta chain.  It is too large for the stack (chain holds
+   the path of every checkpt in the chain) so it is heap allocated. */
+
+struct fd_wksp_private_restore_delta_scratch {
+  fd_restore_t                 restore[1];
+  uchar                        rbuf[ FD_RESTORE_RBUF_MIN ];
+  fd_wksp_checkpt_delta_hdr_t  hdr[ FD_WKSP_DELTA_SEQ_MAX ];
+  fd_wksp_checkpt_delta_hdr_t  hdr_chk[1];
+  fd_wksp_checkpt_delta_info_t info[1];
+  char                         info_buf[ FD_WKSP_RESTORE_DELTA_INFO_MAX ];
+  char                         chain[ FD_WKSP_DELTA_SEQ_MAX ][ FD_WKSP_DELTA_PATH_MAX ];
+};
+
+typedef struct fd_wksp_private_restore_delta_scratch fd_wksp_private_restore_delta_scratch_t;
+
+int
+fd_wksp_private_restore_delta( fd_tpool_t * tpool,
+                               ulong        t0,
+                               ulong        t1,
+                               fd_wksp_t *  wksp,
+                               char const * path,
+                               uint         new_seed ) {
+
+  FD_LOG_INFO(( "Restoring delta checkpt \"%s\" into wksp \"%s\" (seed %u)", path, wksp->name, new_seed ));
+
+  if( FD_UNLIKELY( strlen( path )>=FD_WKSP_DELTA_PATH_MAX ) ) {
+    FD_LOG_WARNING(( "path too long" ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  fd_wksp_private_restore_delta_scratch_t * scratch = (fd_wksp_private_restore_delta_scratch_t *)
+    malloc( sizeof(fd_wksp_private_restore_delta_scratch_t) );
+  if( FD_UNLIKELY( !scratch ) ) {
+    FD_LOG_WARNING(( "malloc(%lu) failed", sizeof(fd_wksp_private_restore_delta_scratch_t) ));
+    return FD_WKSP_ERR_FAIL;
+  }
+
+  char const * info_cstr[3];
+
+  /* Walk the chain from path to its base, validating each link before
+     anything is restored.  On exit, chain[i] for i in [0,depth) holds
+     the deltas (most recent first) with headers hdr[i] and chain[depth]
+     holds the base.  As the seq of each link is one less than its child
+     and in [1,FD_WKSP_DELTA_SEQ_MAX), depth<FD_WKSP_DELTA_SEQ_MAX. */
+
+  int   err   = FD_WKSP_SUCCESS;
+  ulong depth = 0UL;
+
+  strcpy( scratch->chain[0], path ); /* length checked above */
+
+  for(;;) {
+    char const *   cur = scratch->chain[ depth ];
+    fd_restore_t * restore;
+
+    int fd = fd_wksp_private_restore_delta_open( cur, scratch->restore, scratch->rbuf, &restore, scratch->hdr + depth,
+                                                 scratch->info, scratch->info_buf, info_cstr ); /* logs details */
+    if( FD_UNLIKELY( fd==-1 ) ) { err = FD_WKSP_ERR_FAIL; goto done; }
+
+    if( FD_UNLIKELY( !fd_restore_fini( restore ) ) ) /* logs details */
+      FD_LOG_WARNING(( "fd_restore_fini failed; attempting to continue" ));
+    if( FD_UNLIKELY( close( fd ) ) )
+      FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", cur, errno, fd_io_strerror( errno ) ));
+
+    if( FD_UNLIKELY( fd_wksp_private_restore_delta_parent( scratch->hdr + depth, info_cstr[0] ) ) ) { /* logs details */
+      err = FD_WKSP_ERR_FAIL;
+      goto done;
+    }
+
+    ulong seq = scratch->hdr[ depth ].seq;
+    depth++;
+    strcpy( scratch->chain[ depth ], info_cstr[0] ); /* length validated */
+    if( seq==1UL ) break; /* parent validated as the base */
+  }
+
+  /* Restore the base */
+
+  FD_LOG_INFO(( "Restoring base \"%s\" of \"%s\"", scratch->chain[ depth ], path ));
+
+  err = fd_wksp_restore_tpool( tpool, t0, t1, wksp, scratch->chain[ depth ], new_seed ); /* logs details */
+  if( FD_UNLIKELY( err ) ) goto done;
+
+  /* Apply the deltas from the base up.  From here on, failures are
+     CORRUPT as the wksp has already been replaced. */
+
+  while( depth ) {
+    depth--;
+    char const *   cur = scratch->chain[ depth ];
+    fd_restore_t * restore;
+
+    FD_LOG_INFO(( "Applying delta \"%s\"", cur ));
+
+    int fd = fd_wksp_private_restore_delta_open( cur, scratch->restore, scratch->rbuf, &restore, scratch->hdr_chk,
+                                                 scratch->info, scratch->info_buf, info_cstr ); /* logs details */
+    if( FD_UNLIKELY( fd==-1 ) ) { err = FD_WKSP_ERR_CORRUPT; goto done; }
+
+    if( FD_UNLIKELY( memcmp( scratch->hdr + depth, scratch->hdr_chk, sizeof(fd_wksp_checkpt_delta_hdr_t) ) ) ) {
+      FD_LOG_WARNING(( "\"%s\" changed during restore", cur ));
+      err = FD_WKSP_ERR_CORRUPT;
+    } else {
+      err = fd_wksp_private_restore_delta_apply( wksp, restore, scratch->hdr + depth, new_seed ); /* logs details */
+    }
+
+    if( FD_UNLIKELY( fd_restore_in_frame( restore ) ) && FD_UNLIKELY( fd_restore_close( restore ) ) )
+      FD_LOG_WARNING(( "fd_restore_close failed; attempting to continue" ));
+    if( FD_UNLIKELY( !fd_restore_fini( restore ) ) ) /* logs details */
+      FD_LOG_WARNING(( "fd_restore_fini failed; attempting to continue" ));
+    if( FD_UNLIKELY( close( fd ) ) )
+      FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", cur, errno, fd_io_strerror( errno ) ));
+
+    if( FD_UNLIKELY( err ) ) goto done;
+  }
+
+done:
+  free( scratch );
+  return err;
+}
+
+int
+fd_wksp_private_printf_delta( int          out,
+                              char const * path,
+                              int          verbose ) {
+
+  int ret = 0;
+# define TRAP(x) do { int _err = (x); if( FD_UNLIKELY( _err<0 ) ) { ret = _err; goto done; } ret += _err; } while(0)
+
+  fd_restore_t                 _restore[1];
+  uchar                        rbuf[ FD_RESTORE_RBUF_MIN ];
+  fd_restore_t *               restore = NULL;
+  fd_wksp_checkpt_delta_hdr_t  hdr[1];
+  fd_wksp_checkpt_delta_info_t info[1];
+  char                         info_buf[ FD_WKSP_RESTORE_DELTA_INFO_MAX ];
+  char const *                 info_cstr[3];
+
+  int fd = -1;
+
+  if( verbose>=1 ) {
+
+    fd = fd_wksp_private_restore_delta_open( path, _restore, rbuf, &restore, hdr, info, info_buf, info_cstr ); /* logs details */
+    if( FD_UNLIKELY( fd==-1 ) ) return ret;
+
+    char info_wallclock[ FD_LOG_WALLCLOCK_CSTR_BUF_SZ ];
+    fd_log_wallclock_cstr( info->wallclock, info_wallclock );
+
+    TRAP( dprintf( out, "\tmagic                  %016lx\n"
+                        "\twallclock              %-20li (%s)\n"
+                        "\tframe_style_compressed %-20i\n"
+                        "\tseq                    %-20lu\n"
+                        "\tpage_sz                %-20lu\n"
+                        "\tparent_sz              %-20lu\n"
+                        "\tparent\n\t\t%s\n",
+                        hdr->magic, info->wallclock, info_wallclock, hdr->frame_style_compressed,
+                        hdr->seq, hdr->page_sz, hdr->parent_sz, info_cstr[0] ) );
+
+    if( verbose>=2 )
+      TRAP( dprintf( out, "\tmode                   %03lo\n"
+                          "\tpath\n\t\t%s\n"
+                          "\tuinfo\n\t\t%s\n",
+                          info->mode, info_cstr[1], info_cstr[2] ) );
+  }
+
+done:
+
+  if( FD_LIKELY( restore ) ) {
+    if( FD_UNLIKELY( !fd_restore_fini( restore ) ) ) /* logs details */
+      FD_LOG_WARNING(( "fd_restore_fini failed; attempting to continue" ));
+  }
+
+  if( FD_LIKELY( fd!=-1 ) && FD_UNLIKELY( close( fd ) ) )
+    FD_LOG_WARNING(( "close failed (%i-%s); attempting to continue", errno, fd_io_strerror( errno ) ));
+
+# undef TRAP
+
+  return ret;
+}
+
+#undef RESTORE_TEST
+#undef RESTORE_DATA
+#undef RESTORE_META
+#undef RESTORE_CLOSE
+#undef RESTORE_OPEN
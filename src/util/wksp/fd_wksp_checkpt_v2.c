@@ -11,14 +11,14 @@
 #define FD_WKSP_CHECKPT_V2_CGROUP_MAX (1024UL)
 
 int
-fd_wksp_private_checkpt_v2( fd_tpool_t * tpool,
-                            ulong        t0,
-                            ulong        t1,
-                            fd_wksp_t *  wksp,
-                            char const * path,
-                            ulong        mode,
-                            char const * uinfo,
-                            int          frame_style_compressed ) {
+fd_wksp_private_checkpt_v2_locked( fd_tpool_t * tpool,
+                                   ulong        t0,
+                                   ulong        t1,
+                                   fd_wksp_t *  wksp,
+                                   char const * path,
+                                   ulong        mode,
+                                   char const * uinfo,
+                                   int          frame_style_compressed ) {
 
   (void)tpool; (void)t0; (void)t1; /* Thread parallelization not currently implemented */
 
@@ -31,7 +31,6 @@ fd_wksp_private_checkpt_v2( fd_tpool_t * tpool,
 
   int err_fail;
 
-  int            locked  =  0;
   int            fd      = -1;
   fd_checkpt_t * checkpt = NULL;
 
@@ -45,18 +44,6 @@ fd_wksp_private_checkpt_v2( fd_tpool_t * tpool,
     goto fail;
   }
 
-  /* Lock the wksp */
-
-  {
-    int _err = fd_wksp_private_lock( wksp ); /* logs details */
-    if( FD_UNLIKELY( _err ) ) {
-      FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed due to being locked; attempting to continue", name, path ));
-      err_fail = _err;
-      goto fail;
-    }
-    locked = 1;
-  }
-
   /* Determine a reasonable number of cgroups (note: in principle we
      could thread parallelize this but it probably isn't worth the extra
      complexity). */
@@ -562,11 +549,6 @@ fd_wksp_private_checkpt_v2( fd_tpool_t * tpool,
     goto fail;
   }
 
-  /* Unlock the wksp */
-
-  fd_wksp_private_unlock( wksp );
-  locked = 0;
-
   return FD_WKSP_SUCCESS;
 
 fail:
@@ -584,7 +566,28 @@ fail:
   if( FD_LIKELY( fd!=-1 ) && FD_UNLIKELY( close( fd ) ) )
     FD_LOG_WARNING(( "close(\"%s\") failed (%i-%s); attempting to continue", path, errno, fd_io_strerror( errno ) ));
 
-  if( FD_LIKELY( locked ) ) fd_wksp_private_unlock( wksp );
-
   return err_fail;
 }
+
+int
+fd_wksp_private_checkpt_v2( fd_tpool_t * tpool,
+                            ulong        t0,
+                            ulong        t1,
+                            fd_wksp_t *  wksp,
+                            char const * path,
+                            ulong        mode,
+                            char const * uinfo,
+                            int          frame_style_compressed ) {
+
+  int err = fd_wksp_private_lock( wksp ); /* logs details */
+  if( FD_UNLIKELY( err ) ) {
+    FD_LOG_WARNING(( "checkpt wksp \"%s\" to \"%s\" failed due to being locked; attempting to continue", wksp->name, path ));
+    return err;
+  }
+
+  err = fd_wksp_private_checkpt_v2_locked( tpool, t0, t1, wksp, path, mode, uinfo, frame_style_compressed ); /* logs details */
+
+  fd_wksp_private_unlock( wksp );
+
+  return err;
+}
@@ -44,23 +44,28 @@ fd_wksp_preview( char const *        path,
      SVW encoded ulongs at 9 bytes each followed by a worst case
      non-'\0' bytes of name at 39==FD_SHMEM_NAME_MAX-1 bytes) and an
      arbitrarily corrupted V2 header (a 80 byte struct stored
-     uncompressed). */
+     uncompressed) or DELTA header (a 104 byte struct stored
+     uncompressed with the same leading layout as V2). */
 
   uchar buf[ 165 ];
   ulong buf_sz;
   int   err = fd_wksp_private_checkpt_read( path, buf, 165UL, &buf_sz );
   if( FD_UNLIKELY( err ) ) return FD_WKSP_ERR_FAIL;
 
-  /* If we read a supported valid V2 header, return the requested
-     preview info */
+  /* If we read a supported valid V2 or DELTA header, return the
+     requested preview info */
 
   fd_wksp_checkpt_v2_hdr_t * v2 = (fd_wksp_checkpt_v2_hdr_t *)buf;
 
   ulong name_len = fd_shmem_name_len( v2->name ); /* tail reading safe */
 
-  if( FD_LIKELY( (sizeof(fd_wksp_checkpt_v2_hdr_t)<=buf_sz                         ) &     /* header not truncated */
+  ulong hdr_sz = fd_ulong_if( v2->style==FD_WKSP_CHECKPT_STYLE_DELTA, sizeof(fd_wksp_checkpt_delta_hdr_t),
+                                                                      sizeof(fd_wksp_checkpt_v2_hdr_t   ) );
+
+  if( FD_LIKELY( (hdr_sz<=buf_sz                                                   ) &     /* header not truncated */
                  (v2->magic==FD_WKSP_MAGIC                                         ) &     /* with valid magic */
-                 (v2->style==FD_WKSP_CHECKPT_STYLE_V2                              ) &     /* with valid style */
+                 ((v2->style==FD_WKSP_CHECKPT_STYLE_V2) |
+                  (v2->style==FD_WKSP_CHECKPT_STYLE_DELTA)                         ) &     /* with valid style */
                  (fd_checkpt_frame_style_is_supported( v2->frame_style_compressed )) &     /* with supported compression */
                  (v2->reserved==0U                                                 ) &     /* with expected reserved */
                  (name_len>0UL                                                     ) &     /* with valid name */
@@ -212,6 +217,7 @@ fd_wksp_restore_tpool( fd_tpool_t * tpool,
   case FD_WKSP_CHECKPT_STYLE_V1: return fd_wksp_private_restore_v1( tpool, t0, t1, wksp, path, new_seed );
   case FD_WKSP_CHECKPT_STYLE_V2: return fd_wksp_private_restore_v2( tpool, t0, t1, wksp, path, new_seed );
   /* note: v3 is really v2 with compressed frames */
+  case FD_WKSP_CHECKPT_STYLE_DELTA: return fd_wksp_private_restore_delta( tpool, t0, t1, wksp, path, new_seed );
   default: break; /* never get here (preview already checked) */
   }
 
@@ -249,6 +255,7 @@ fd_wksp_printf( int          fd,
   case FD_WKSP_CHECKPT_STYLE_V1: TRAP( fd_wksp_private_printf_v1( fd, path, verbose ) ); break;
   case FD_WKSP_CHECKPT_STYLE_V2: TRAP( fd_wksp_private_printf_v2( fd, path, verbose ) ); break;
   /* note: v3 is really v2 with compressed frames */
+  case FD_WKSP_CHECKPT_STYLE_DELTA: TRAP( fd_wksp_private_printf_delta( fd, path, verbose ) ); break;
   default: /* never get here (preview already checked) */
     TRAP( dprintf( fd, "unsupported style" ) );
     break;
@@ -633,6 +633,108 @@ struct fd_wksp_checkpt_v2_ftr {
 
 typedef struct fd_wksp_checkpt_v2_ftr fd_wksp_checkpt_v2_ftr_t;
 
+/* A wksp delta checkpt holds the allocations of a wksp relative to a
+   parent checkpt (either a v2 checkpt or another delta checkpt).  It
+   uses the same frame machinery and commands as v2.  Frame 0 is an
+   uncompressed fd_wksp_checkpt_delta_hdr_t (whose leading fields have
+   the same layout as fd_wksp_checkpt_v2_hdr_t such that previewing is
+   the same for both).  Frame 1 is a compressed info frame holding a
+   fd_wksp_checkpt_delta_info_t followed compactly by the parent path,
+   path and uinfo cstrs.  Frame 2 is a compressed manifest frame holding
+   a meta command for every allocation in the wksp followed by a data
+   command.  Frame 3 is a compressed extent frame holding, for every
+   changed range of allocated bytes, a meta command (the tag of the
+   allocation containing the range and the range) immediately followed
+   by the range's data.  The extents are terminated by a data command.
+   Frame 4 is an uncompressed fd_wksp_checkpt_delta_ftr_t.
+
+   Restoring a delta restores its parent and then replaces the wksp
+   allocation metadata with the manifest and overwrites the extents.
+   Bytes in allocations not covered by an extent are unchanged from
+   the parent. */
+
+struct fd_wksp_checkpt_delta_hdr {
+  ulong magic;                     /* Must be first, ==FD_WKSP_MAGIC */
+  int   style;                     /* Must be second, ==FD_WKSP_CHECKPT_STYLE_DELTA */
+  int   frame_style_compressed;    /* frame style used for compressed frames */
+  uint  reserved;                  /* header padding */
+  char  name[ FD_SHMEM_NAME_MAX ]; /* cstr holding the original wksp name */
+  uint  seed;                      /* wksp seed when checkpointed */
+  ulong part_max;                  /* part_max used to construct the wksp */
+  ulong data_max;                  /* data_max used to construct the wksp */
+  ulong seq;                       /* position in the chain, in [1,FD_WKSP_DELTA_SEQ_MAX) (the base is 0) */
+  ulong parent_sz;                 /* byte size of the parent checkpt */
+  ulong page_sz;                   /* change tracking granularity used when written */
+};
+
+typedef struct fd_wksp_checkpt_delta_hdr fd_wksp_checkpt_delta_hdr_t;
+
+struct fd_wksp_checkpt_delta_info {
+  ulong mode;
+  long  wallclock;
+  ulong sz_parent; /* in [1,FD_WKSP_DELTA_PATH_MAX] */
+  ulong sz_path;   /* in [1,FD_WKSP_DELTA_PATH_MAX] */
+  ulong sz_uinfo;  /* in [1,FD_WKSP_CHECKPT_V2_UINFO_MAX] */
+};
+
+typedef struct fd_wksp_checkpt_delta_info fd_wksp_checkpt_delta_info_t;
+
+struct fd_wksp_checkpt_delta_ftr {
+  ulong alloc_cnt;                 /* number of allocations in the manifest */
+  ulong extent_cnt;                /* number of extents */
+  ulong extent_sz;                 /* total bytes of extent data */
+  ulong seq;                       /* should match header */
+  ulong parent_sz;                 /* " */
+  ulong checkpt_sz;                /* checkpt byte size, from header initial byte to the footer final byte inclusive */
+  ulong data_max;                  /* should match header */
+  ulong part_max;                  /* " */
+  uint  seed;                      /* " */
+  char  name[ FD_SHMEM_NAME_MAX ]; /* " */
+  uint  reserved;                  /* " */
+  int   frame_style_compressed;    /* " */
+  int   style;                     /* " */
+  ulong unmagic;                   /* ==~FD_WKSP_MAGIC */
+};
+
+typedef struct fd_wksp_checkpt_delta_ftr fd_wksp_checkpt_delta_ftr_t;
+
+FD_STATIC_ASSERT( __builtin_offsetof( fd_wksp_checkpt_delta_hdr_t, data_max )==__builtin_offsetof( fd_wksp_checkpt_v2_hdr_t, data_max ), layout );
+
+/* A fd_wksp_delta_private is the local state of a wksp change tracker.
+   hash[2*page_idx+{0,1}] is a 128-bit hash of the allocated bytes (and
+   their position) in the page_idx-th page_sz region of the wksp data
+   region as of the most recent checkpt in the chain.  The hash is keyed
+   by hash_seed, which is drawn from a secure rng when a chain is
+   started, such that a change colliding with the page's previous hash
+   (and thus silently missing from the delta) is neither likely nor
+   something a writer to the wksp can arrange.  The scratch arrays are
+   used while writing a checkpt. */
+
+#define FD_WKSP_DELTA_MAGIC (0xf17eda2c3de17a00UL) /* firedancer wksp delta version 0 */
+
+struct __attribute__((aligned(FD_WKSP_DELTA_ALIGN))) fd_wksp_delta_private {
+  ulong magic;                           /* ==FD_WKSP_DELTA_MAGIC */
+  ulong data_max;                        /* largest wksp data region supported */
+  ulong page_sz;                         /* change tracking granularity */
+  ulong page_cnt;                        /* ==ceil( data_max / page_sz ) */
+  ulong seq;                             /* number of checkpts in the current chain, 0 if no chain */
+  ulong parent_sz;                       /* byte size of the most recent checkpt in the chain */
+  ulong wksp_part_max;                   /* part_max of the wksp the chain covers */
+  ulong wksp_data_max;                   /* data_max of the wksp the chain covers */
+  char  wksp_name[ FD_SHMEM_NAME_MAX ];  /* name of the wksp the chain covers */
+  ulong dirty_cnt;                       /* number of pages written by the most recent checkpt */
+  ulong dirty_sz;                        /* number of data bytes written by the most recent checkpt */
+  char  path[ FD_WKSP_DELTA_PATH_MAX ];  /* path of the most recent checkpt in the chain */
+  ulong hash_seed[ 2 ];                  /* page hash keys of the current chain */
+  /* 2*page_cnt ulong hash here */
+  /* 2*page_cnt ulong hash scratch here */
+  /*   page_cnt uint  partition scratch here */
+};
+
+FD_FN_CONST static inline ulong * fd_wksp_private_delta_hash    ( fd_wksp_delta_t * d ) { return (ulong *)(d+1); }
+FD_FN_PURE  static inline ulong * fd_wksp_private_delta_hash_tmp( fd_wksp_delta_t * d ) { return (ulong *)(d+1) + 2UL*d->page_cnt; }
+FD_FN_PURE  static inline uint  * fd_wksp_private_delta_part    ( fd_wksp_delta_t * d ) { return (uint *)((ulong *)(d+1) + 4UL*d->page_cnt); }
+
 /* fd_wksp_private_{checkpt,restore,printf}_v1 provide the v1
    implementations of {checkpt,restore,printf}.  That is, checkpt_v1
    will only write a v1 style checkpt while the {restore,printt}_v1 can
@@ -680,6 +782,21 @@ fd_wksp_private_checkpt_v2( fd_tpool_t * tpool,
                             char const * uinfo,
                             int          frame_style_compresed );
 
+/* fd_wksp_private_checkpt_v2_locked is fd_wksp_private_checkpt_v2 for
+   a caller that already holds the wksp lock (e.g. to do other work on
+   the wksp atomically with the checkpt).  The lock is still held on
+   return. */
+
+int
+fd_wksp_private_checkpt_v2_locked( fd_tpool_t * tpool,
+                                   ulong        t0,
+                                   ulong        t1,
+                                   fd_wksp_t *  wksp,
+                                   char const * path,
+                                   ulong        mode,
+                                   char const * uinfo,
+                                   int          frame_style_compresed );
+
 int
 fd_wksp_private_restore_v2( fd_tpool_t * tpool,
                             ulong        t0,
@@ -693,6 +810,22 @@ fd_wksp_private_printf_v2( int          fd,
                            char const * path,
                            int          verbose );
 
+/* Similarly for delta checkpts.  Restore will restore the chain of
+   parents first. */
+
+int
+fd_wksp_private_restore_delta( fd_tpool_t * tpool,
+                               ulong        t0,
+                               ulong        t1,
+                               fd_wksp_t *  wksp,
+                               char const * path,
+                               uint         new_seed );
+
+int
+fd_wksp_private_printf_delta( int          fd,
+                              char const * path,
+                              int          verbose );
+
 FD_PROTOTYPES_END
 
 #endif /* HEADER_fd_src_util_wksp_fd_wksp_private_h */
@@ -0,0 +1,308 @@
+#include "../fd_util.h"
+
+#if FD_HAS_HOSTED
+
+#include <errno.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+typedef struct {
+  ulong gaddr0; /* 0 if freed */
+  ulong sz;
+  ulong tag;
+  int   c;
+} alloc_info_t;
+
+static FD_FOR_ALL_BEGIN( alloc_fill, 1L ) {
+  fd_wksp_t *          wksp = (fd_wksp_t *)         _a0;
+  alloc_info_t const * info = (alloc_info_t const *)_a1;
+
+  for( long idx=block_i0; idx<block_i1; idx++ ) {
+    if( !info[ idx ].gaddr0 ) continue;
+    memset( fd_wksp_laddr_fast( wksp, info[ idx ].gaddr0 ), info[ idx ].c, info[ idx ].sz );
+  }
+} FD_FOR_ALL_END
+
+static FD_FOR_ALL_BEGIN( alloc_zero, 1L ) {
+  fd_wksp_t *          wksp = (fd_wksp_t *)         _a0;
+  alloc_info_t const * info = (alloc_info_t const *)_a1;
+
+  for( long idx=block_i0; idx<block_i1; idx++ ) {
+    if( !info[ idx ].gaddr0 ) continue;
+    memset( fd_wksp_laddr_fast( wksp, info[ idx ].gaddr0 ), 0, info[ idx ].sz );
+  }
+} FD_FOR_ALL_END
+
+static FD_FOR_ALL_BEGIN( alloc_test, 1L ) {
+  fd_wksp_t *          wksp = (fd_wksp_t *)         _a0;
+  alloc_info_t const * info = (alloc_info_t const *)_a1;
+
+  for( long idx=block_i0; idx<block_i1; idx++ ) {
+    ulong gaddr0 = info[ idx ].gaddr0;
+    if( !gaddr0 ) continue;
+    ulong sz     = info[ idx ].sz;
+    FD_TEST( fd_wksp_tag( wksp, gaddr0             )==info[ idx ].tag );
+    FD_TEST( fd_wksp_tag( wksp, gaddr0 + sz - 1UL  )==info[ idx ].tag );
+    uchar const * laddr0 = (uchar const *)fd_wksp_laddr_fast( wksp, gaddr0 );
+    for( ulong off=0UL; off<sz; off++ ) FD_TEST( ((int)laddr0[off])==info[ idx ].c );
+  }
+} FD_FOR_ALL_END
+
+static ulong
+file_sz( char const * path ) {
+  struct stat st[1];
+  FD_TEST( !stat( path, st ) );
+  return (ulong)st->st_size;
+}
+
+#define ALLOC_MAX (4096L)
+static alloc_info_t info[ ALLOC_MAX ];
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+
+  char const * _mode      = fd_env_strip_cmdline_cstr ( &argc, &argv, "--mode",       NULL,          "0600" );
+  ulong        worker_cnt = fd_env_strip_cmdline_ulong( &argc, &argv, "--worker-cnt", NULL,   fd_tile_cnt() );
+  char const * _page_sz   = fd_env_strip_cmdline_cstr ( &argc, &argv, "--page-sz",    NULL,      "gigantic" );
+  ulong        page_cnt   = fd_env_strip_cmdline_ulong( &argc, &argv, "--page-cnt",   NULL,             1UL );
+  ulong        near_cpu   = fd_env_strip_cmdline_ulong( &argc, &argv, "--near-cpu",   NULL, fd_log_cpu_id() );
+  ulong        delta_pg   = fd_env_strip_cmdline_ulong( &argc, &argv, "--delta-pg",   NULL, FD_WKSP_DELTA_PAGE_SZ_DEFAULT );
+  ulong        iter_max   = fd_env_strip_cmdline_ulong( &argc, &argv, "--iter-max",   NULL,             4UL );
+
+  ulong mode = fd_cstr_to_ulong_octal( _mode );
+
+  FD_LOG_NOTICE(( "Creating thread pool (--worker-cnt %lu)", worker_cnt ));
+  static uchar _tpool[ FD_TPOOL_FOOTPRINT(FD_TILE_MAX) ] __attribute__((aligned(FD_TPOOL_ALIGN)));
+  fd_tpool_t * tpool = fd_tpool_init( _tpool, worker_cnt ); /* logs details */
+  if( FD_UNLIKELY( !tpool ) ) FD_LOG_ERR(( "fd_tpool_init failed" ));
+  for( ulong worker_idx=1UL; worker_idx<worker_cnt; worker_idx++ )
+    if( FD_UNLIKELY( !fd_tpool_worker_push( tpool, worker_idx, NULL, 0UL ) ) ) FD_LOG_ERR(( "fd_tpool_worker_push failed" ));
+
+  fd_rng_t _rng[1]; fd_rng_t * rng = fd_rng_join( fd_rng_new( _rng, 0U, 0UL ) );
+
+  FD_LOG_NOTICE(( "Creating anonymous wksp (--page-sz %s --page-cnt %lu --near-cpu %lu)", _page_sz, page_cnt, near_cpu ));
+  fd_wksp_t * wksp = fd_wksp_new_anonymous( fd_cstr_to_shmem_page_sz( _page_sz ), page_cnt, near_cpu, "wksp", 0UL );
+  FD_TEST( wksp );
+
+  fd_wksp_usage_t usage[1];
+  FD_TEST( fd_wksp_usage( wksp, NULL, 0UL, usage )==usage );
+  ulong data_max = usage->total_sz;
+
+  /* Test tracker construction */
+
+  FD_TEST( fd_wksp_delta_align()==FD_WKSP_DELTA_ALIGN );
+  FD_TEST( !fd_wksp_delta_footprint( 0UL,      delta_pg ) );
+  FD_TEST( !fd_wksp_delta_footprint( data_max, 0UL      ) );
+  FD_TEST( !fd_wksp_delta_footprint( data_max, 2048UL   ) );
+  FD_TEST( !fd_wksp_delta_footprint( data_max, 65537UL  ) );
+
+  ulong footprint = fd_wksp_delta_footprint( data_max, delta_pg );
+  FD_TEST( footprint );
+  FD_TEST( fd_ulong_is_aligned( footprint, FD_WKSP_DELTA_ALIGN ) );
+
+  void * mem = aligned_alloc( FD_WKSP_DELTA_ALIGN, footprint ); FD_TEST( mem );
+
+  FD_TEST( !fd_wksp_delta_new( NULL,          data_max, delta_pg ) );
+  FD_TEST( !fd_wksp_delta_new( (uchar *)mem+1, data_max, delta_pg ) );
+  FD_TEST( !fd_wksp_delta_new( mem,           0UL,      delta_pg ) );
+  FD_TEST( !fd_wksp_delta_new( mem,           data_max, 3000UL   ) );
+  void * shdelta = fd_wksp_delta_new( mem, data_max, delta_pg ); FD_TEST( shdelta==mem );
+
+  FD_TEST( !fd_wksp_delta_join( NULL ) );
+  fd_wksp_delta_t * delta = fd_wksp_delta_join( shdelta ); FD_TEST( delta );
+
+  FD_TEST( fd_wksp_delta_seq ( delta )==0UL );
+  FD_TEST( !fd_wksp_delta_path( delta )     );
+
+  char path[ FD_WKSP_DELTA_SEQ_MAX+1UL ][ 128 ];
+  for( ulong seq=0UL; seq<=FD_WKSP_DELTA_SEQ_MAX; seq++ )
+    fd_cstr_printf( path[ seq ], 128UL, NULL, "/tmp/test_wksp_delta.%lu.%li.%lu", fd_log_group_id(), fd_log_wallclock(), seq );
+
+  /* Test bad args */
+
+  FD_TEST( fd_wksp_checkpt_delta_tpool( tpool,0UL,1UL, NULL, delta, path[0], mode, 0, "" )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_delta_tpool( tpool,0UL,1UL, wksp, NULL,  path[0], mode, 0, "" )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_delta_tpool( tpool,0UL,1UL, wksp, delta, NULL,    mode, 0, "" )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_delta_tpool( tpool,0UL,1UL, wksp, delta, path[0], mode, FD_WKSP_CHECKPT_STYLE_RAW,   "" )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_checkpt_delta_tpool( tpool,0UL,1UL, wksp, delta, path[0], mode, FD_WKSP_CHECKPT_STYLE_DELTA, "" )==FD_WKSP_ERR_INVAL );
+  FD_TEST( fd_wksp_delta_seq( delta )==0UL );
+
+  for( ulong iter=0UL; iter<iter_max; iter++ ) {
+    FD_LOG_NOTICE(( "iter %lu", iter ));
+
+    fd_wksp_reset( wksp, fd_rng_uint( rng ) );
+    fd_wksp_delta_reset( delta );
+
+    /* Fill the wksp with randomly sized allocations */
+
+    long alloc_cnt;
+    for( alloc_cnt=0L; alloc_cnt<ALLOC_MAX/2L; alloc_cnt++ ) {
+      ulong sz     = 1UL + (ulong)fd_rng_uint_roll( rng, 32768U );
+      ulong tag    = (ulong)(alloc_cnt+1L);
+      ulong gaddr0 = fd_wksp_alloc( wksp, 1UL << fd_rng_uint_roll( rng, 7U ), sz, tag );
+      if( FD_UNLIKELY( !gaddr0 ) ) break;
+      info[ alloc_cnt ].gaddr0 = gaddr0;
+      info[ alloc_cnt ].sz     = sz;
+      info[ alloc_cnt ].tag    = tag;
+      info[ alloc_cnt ].c      = 1 + (int)fd_rng_uint_roll( rng, 255U );
+    }
+    FD_FOR_ALL( alloc_fill, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+
+    int style = iter & 1UL ? FD_WKSP_CHECKPT_STYLE_V2 : 0;
+
+    /* The first checkpt of a chain is a full checkpt */
+
+    for( ulong seq=0UL; seq<=FD_WKSP_DELTA_SEQ_MAX; seq++ ) unlink( path[ seq ] );
+
+    FD_TEST( !fd_wksp_checkpt_delta_tpool( tpool,0UL,worker_cnt, wksp, delta, path[0], mode, style, "test_wksp_delta" ) );
+    FD_TEST( fd_wksp_delta_seq( delta )==1UL );
+    FD_TEST( !strcmp( fd_wksp_delta_path( delta ), path[0] ) );
+    ulong base_sz = file_sz( path[0] );
+
+    fd_wksp_preview_t preview[1];
+    FD_TEST( !fd_wksp_preview( path[0], preview ) );
+    FD_TEST( preview->style==FD_WKSP_CHECKPT_STYLE_V2 );
+
+    /* Change a few allocations: rewrite some, free some and make some
+       new ones */
+
+    long change_cnt = fd_long_max( alloc_cnt/32L, 1L );
+    for( long rem=change_cnt; rem; rem-- ) {
+      long idx = (long)fd_rng_ulong_roll( rng, (ulong)alloc_cnt );
+      switch( fd_rng_uint_roll( rng, 3U ) ) {
+      case 0U:
+        info[ idx ].c = 1 + (int)fd_rng_uint_roll( rng, 255U );
+        break;
+      case 1U:
+        if( info[ idx ].gaddr0 ) fd_wksp_free( wksp, info[ idx ].gaddr0 );
+        info[ idx ].gaddr0 = 0UL;
+        break;
+      default:
+        if( alloc_cnt<ALLOC_MAX ) {
+          ulong sz     = 1UL + (ulong)fd_rng_uint_roll( rng, 4096U );
+          ulong tag    = (ulong)(alloc_cnt+1L);
+          ulong gaddr0 = fd_wksp_alloc( wksp, 1UL, sz, tag );
+          info[ alloc_cnt ].gaddr0 = gaddr0;
+          info[ alloc_cnt ].sz     = sz;
+          info[ alloc_cnt ].tag    = tag;
+          info[ alloc_cnt ].c      = 1 + (int)fd_rng_uint_roll( rng, 255U );
+          alloc_cnt++;
+        }
+        break;
+      }
+    }
+    FD_FOR_ALL( alloc_fill, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+
+    /* Subsequent checkpts are deltas holding only the changes */
+
+    FD_TEST( !fd_wksp_checkpt_delta_tpool( tpool,0UL,worker_cnt, wksp, delta, path[1], mode, style, "test_wksp_delta" ) );
+    FD_TEST( fd_wksp_delta_seq      ( delta )==2UL );
+    FD_TEST( fd_wksp_delta_dirty_cnt( delta )> 0UL );
+    FD_TEST( fd_wksp_delta_dirty_sz ( delta )> 0UL );
+    ulong delta_sz = file_sz( path[1] );
+    FD_LOG_NOTICE(( "base %lu bytes, delta %lu bytes (%lu pages, %lu data bytes)",
+                    base_sz, delta_sz, fd_wksp_delta_dirty_cnt( delta ), fd_wksp_delta_dirty_sz( delta ) ));
+    FD_TEST( delta_sz<base_sz );
+
+    FD_TEST( !fd_wksp_preview( path[1], preview ) );
+    FD_TEST( preview->style==FD_WKSP_CHECKPT_STYLE_DELTA );
+    FD_TEST( !strcmp( preview->name, fd_wksp_name( wksp ) ) );
+
+    /* A delta without changes holds no data */
+
+    FD_TEST( !fd_wksp_checkpt_delta_tpool( tpool,0UL,worker_cnt, wksp, delta, path[2], mode, style, "test_wksp_delta" ) );
+    FD_TEST( fd_wksp_delta_seq      ( delta )==3UL );
+    FD_TEST( fd_wksp_delta_dirty_cnt( delta )==0UL );
+    FD_TEST( fd_wksp_delta_dirty_sz ( delta )==0UL );
+    FD_TEST( file_sz( path[2] )<=delta_sz );
+
+    /* An existing path is not overwritten and the chain is unchanged */
+
+    FD_TEST( fd_wksp_checkpt_delta_tpool( tpool,0UL,worker_cnt, wksp, delta, path[2], mode, style, "" )==FD_WKSP_ERR_FAIL );
+    FD_TEST( fd_wksp_delta_seq( delta )==3UL );
+    FD_TEST( !strcmp( fd_wksp_delta_path( delta ), path[2] ) );
+
+    if( !iter ) FD_TEST( fd_wksp_printf( STDOUT_FILENO, path[2], 2 )>0 );
+
+    /* Restore the chain over a scrambled wksp */
+
+    FD_FOR_ALL( alloc_zero, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+    fd_wksp_reset( wksp, fd_rng_uint( rng ) );
+    FD_TEST( !fd_wksp_restore_tpool( tpool,0UL,worker_cnt, wksp, path[2], fd_rng_uint( rng ) ) );
+    FD_TEST( !fd_wksp_verify( wksp ) );
+    FD_FOR_ALL( alloc_test, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+
+    ulong live_cnt = 0UL;
+    for( long idx=0L; idx<alloc_cnt; idx++ ) live_cnt += (ulong)!!info[ idx ].gaddr0;
+    FD_TEST( fd_wksp_usage( wksp, NULL, 0UL, usage )==usage );
+    FD_TEST( usage->total_cnt-usage->free_cnt==live_cnt );
+
+    /* Breaking the chain makes restore fail without touching the wksp */
+
+    FD_TEST( !unlink( path[1] ) );
+    FD_TEST( fd_wksp_restore_tpool( tpool,0UL,worker_cnt, wksp, path[2], 0U )==FD_WKSP_ERR_FAIL );
+    FD_FOR_ALL( alloc_test, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+
+    /* The longest chain restores (with a change in every delta) and
+       longer chains are rebased */
+
+    if( !iter ) {
+      fd_wksp_delta_reset( delta );
+      for( ulong seq=0UL; seq<FD_WKSP_DELTA_SEQ_MAX; seq++ ) {
+        long idx = (long)fd_rng_ulong_roll( rng, (ulong)alloc_cnt );
+        if( info[ idx ].gaddr0 ) {
+          info[ idx ].c = 1 + (int)fd_rng_uint_roll( rng, 255U );
+          memset( fd_wksp_laddr_fast( wksp, info[ idx ].gaddr0 ), info[ idx ].c, info[ idx ].sz );
+        }
+        unlink( path[ seq ] );
+        FD_TEST( !fd_wksp_checkpt_delta_tpool( tpool,0UL,worker_cnt, wksp, delta, path[seq], mode, style, "" ) );
+        FD_TEST( fd_wksp_delta_seq( delta )==seq+1UL );
+      }
+
+      FD_FOR_ALL( alloc_zero, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+      fd_wksp_reset( wksp, fd_rng_uint( rng ) );
+      FD_TEST( !fd_wksp_restore_tpool( tpool,0UL,worker_cnt, wksp, path[ FD_WKSP_DELTA_SEQ_MAX-1UL ], fd_rng_uint( rng ) ) );
+      FD_TEST( !fd_wksp_verify( wksp ) );
+      FD_FOR_ALL( alloc_test, tpool,0UL,worker_cnt, 0L,alloc_cnt, wksp, info );
+
+      FD_TEST( !fd_wksp_checkpt_delta_tpool( tpool,0UL,worker_cnt, wksp, delta, path[ FD_WKSP_DELTA_SEQ_MAX ], mode, style, "" ) );
+      FD_TEST( fd_wksp_delta_seq( delta )==1UL );
+      FD_TEST( !fd_wksp_preview( path[ FD_WKSP_DELTA_SEQ_MAX ], preview ) );
+      FD_TEST( preview->style==FD_WKSP_CHECKPT_STYLE_V2 );
+    }
+  }
+
+  FD_LOG_NOTICE(( "Cleaning up" ));
+
+  for( ulong seq=0UL; seq<=FD_WKSP_DELTA_SEQ_MAX; seq++ ) unlink( path[ seq ] );
+
+  FD_TEST( !fd_wksp_delta_leave( NULL ) );
+  FD_TEST( fd_wksp_delta_leave( delta )==shdelta );
+  FD_TEST( !fd_wksp_delta_delete( NULL ) );
+  FD_TEST( fd_wksp_delta_delete( shdelta )==mem );
+  FD_TEST( !fd_wksp_delta_join( shdelta ) );
+  free( mem );
+
+  fd_wksp_delete_anonymous( wksp );
+  fd_rng_delete( fd_rng_leave( rng ) );
+  fd_tpool_fini( tpool );
+
+  FD_LOG_NOTICE(( "pass" ));
+  fd_halt();
+  return 0;
+}
+
+#else
+
+int
+main( int     argc,
+      char ** argv ) {
+  fd_boot( &argc, &argv );
+  FD_LOG_WARNING(( "skip: unit test requires FD_HAS_HOSTED capabilities" ));
+  fd_halt();
+  return 0;
+}
+
+#endif